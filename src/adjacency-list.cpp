@@ -22,23 +22,151 @@
 #include "adjacency-list.hpp"
 #include "logger.hpp"
 
-#include <algorithm>
+#include <set>
 
 namespace nlsr {
 
 INIT_LOGGER(AdjacencyList);
 
+AdjacencyList::AdjacencyList(const AdjacencyList& other)
+  : m_adjList(other.m_adjList)
+{
+  rebuildIndex();
+}
+
+AdjacencyList::AdjacencyList(AdjacencyList&& other)
+  : m_adjList(std::move(other.m_adjList))
+{
+  rebuildIndex();
+  other.reset();
+}
+
+AdjacencyList&
+AdjacencyList::operator=(const AdjacencyList& other)
+{
+  if (this != &other) {
+    m_adjList = other.m_adjList;
+    rebuildIndex();
+  }
+  return *this;
+}
+
+AdjacencyList&
+AdjacencyList::operator=(AdjacencyList&& other)
+{
+  if (this != &other) {
+    m_adjList = std::move(other.m_adjList);
+    rebuildIndex();
+    other.reset();
+  }
+  return *this;
+}
+
+void
+AdjacencyList::rebuildIndex()
+{
+  m_byId.clear();
+  m_ids.clear();
+  m_byFaceId.clear();
+  m_byFaceUri.clear();
+  m_nActive = 0;
+  m_nTimedOut.clear();
+  m_controlTraffic.clear();
+  for (auto it = m_adjList.begin(); it != m_adjList.end(); ++it) {
+    addToIndex(it);
+  }
+}
+
+void
+AdjacencyList::addToIndex(iterator it)
+{
+  auto id = static_cast<NeighborId>(m_byId.size());
+  m_ids.emplace(it->getName(), id);
+  updateCounters(*it, 1);
+  if (it->getFaceId() != 0) {
+    m_byFaceId.emplace(it->getFaceId(), id);
+  }
+  m_byFaceUri.emplace(it->getFaceUri().toString(), id);
+  m_byId.push_back(it);
+}
+
+void
+AdjacencyList::updateCounters(const Adjacent& adjacent, int delta)
+{
+  if (adjacent.getStatus() == Adjacent::STATUS_ACTIVE) {
+    m_nActive += delta;
+    return;
+  }
+
+  auto& n = m_nTimedOut[adjacent.getInterestTimedOutNo()];
+  n += delta;
+  if (n == 0) {
+    m_nTimedOut.erase(adjacent.getInterestTimedOutNo());
+  }
+}
+
 bool
 AdjacencyList::insert(const Adjacent& adjacent)
 {
-  auto it = find(adjacent.getName());
-  if (it != m_adjList.end()) {
+  if (m_ids.count(adjacent.getName()) > 0) {
+    return false;
+  }
+  addToIndex(m_adjList.insert(m_adjList.end(), adjacent));
+  return true;
+}
+
+bool
+AdjacencyList::erase(const ndn::Name& adjName)
+{
+  auto id = getNeighborId(adjName);
+  if (!id) {
     return false;
   }
-  m_adjList.push_back(adjacent);
+  auto adjacent = m_byId[*id];
+  uint64_t faceId = adjacent->getFaceId();
+  std::string faceUri = adjacent->getFaceUri().toString();
+  updateCounters(*adjacent, -1);
+  m_ids.erase(adjName);
+  m_adjList.erase(adjacent);
+  // the ID is not reused, so that state kept by ID elsewhere cannot be inherited
+  m_byId[*id] = m_adjList.end();
+
+  // another neighbor may have had the same Face ID or FaceUri; rare enough to scan for
+  auto reindex = [this, id] (auto& index, const auto& key, auto&& matches) {
+    auto it = index.find(key);
+    if (it == index.end() || it->second != *id) {
+      return;
+    }
+    index.erase(it);
+    for (NeighborId other = 0; other < m_byId.size(); ++other) {
+      if (m_byId[other] != m_adjList.end() && matches(*m_byId[other])) {
+        index.emplace(key, other);
+        break;
+      }
+    }
+  };
+  reindex(m_byFaceId, faceId, [faceId] (const Adjacent& a) { return a.getFaceId() == faceId; });
+  reindex(m_byFaceUri, faceUri,
+          [&faceUri] (const Adjacent& a) { return a.getFaceUri().toString() == faceUri; });
   return true;
 }
 
+std::optional<NeighborId>
+AdjacencyList::getNeighborId(const ndn::Name& adjName) const
+{
+  auto it = m_ids.find(adjName);
+  if (it == m_ids.end()) {
+    return std::nullopt;
+  }
+  return it->second;
+}
+
+AdjacencyList::iterator
+AdjacencyList::findById(NeighborId id)
+{
+  return id < m_byId.size() ? m_byId[id] : m_adjList.end();
+}
+
 Adjacent
 AdjacencyList::getAdjacent(const ndn::Name& adjName) const
 {
@@ -74,7 +202,9 @@ AdjacencyList::incrementTimedOutInterestCount(const ndn::Name& neighbor)
 {
   auto it = find(neighbor);
   if (it != m_adjList.end()) {
+    updateCounters(*it, -1);
     it->setInterestTimedOutNo(it->getInterestTimedOutNo() + 1);
+    updateCounters(*it, 1);
   }
 }
 
@@ -83,7 +213,9 @@ AdjacencyList::setTimedOutInterestCount(const ndn::Name& neighbor, uint32_t coun
 {
   auto it = find(neighbor);
   if (it != m_adjList.end()) {
+    updateCounters(*it, -1);
     it->setInterestTimedOutNo(count);
+    updateCounters(*it, 1);
   }
 }
 
@@ -113,8 +245,47 @@ void
 AdjacencyList::setStatusOfNeighbor(const ndn::Name& neighbor, Adjacent::Status status)
 {
   auto it = find(neighbor);
-  if (it != m_adjList.end()) {
-    it->setStatus(status);
+  if (it == m_adjList.end() || it->getStatus() == status) {
+    return;
+  }
+
+  auto oldStatus = it->getStatus();
+  updateCounters(*it, -1);
+  it->setStatus(status);
+  updateCounters(*it, 1);
+  onStatusChanged(*it, oldStatus);
+}
+
+void
+AdjacencyList::setFaceId(const ndn::Name& neighbor, uint64_t faceId)
+{
+  auto id = getNeighborId(neighbor);
+  if (!id) {
+    return;
+  }
+  auto adjacent = m_byId[*id];
+  uint64_t oldFaceId = adjacent->getFaceId();
+  if (oldFaceId == faceId) {
+    return;
+  }
+  adjacent->setFaceId(faceId);
+
+  auto old = m_byFaceId.find(oldFaceId);
+  if (old != m_byFaceId.end() && old->second == *id) {
+    m_byFaceId.erase(old);
+    // another neighbor may have had the same Face ID; rare enough to scan for
+    for (NeighborId other = 0; other < m_byId.size(); ++other) {
+      if (m_byId[other] != m_adjList.end() && m_byId[other]->getFaceId() == oldFaceId) {
+        m_byFaceId.emplace(oldFaceId, other);
+        break;
+      }
+    }
+  }
+  if (faceId != 0) {
+    auto [it, isNew] = m_byFaceId.emplace(faceId, *id);
+    if (!isNew && it->second > *id) {
+      it->second = *id;
+    }
   }
 }
 
@@ -133,85 +304,90 @@ AdjacencyList::getAdjList() const
 bool
 AdjacencyList::isAdjLsaBuildable(const uint32_t interestRetryNo) const
 {
-  uint32_t nTimedOutNeighbors = 0;
-  NLSR_LOG_DEBUG("=== Checking isAdjLsaBuildable ===");
-  NLSR_LOG_DEBUG("Interest retry threshold: " << interestRetryNo);
-
-  for (const auto& adjacency : m_adjList) {
-    if (adjacency.getStatus() == Adjacent::STATUS_ACTIVE) {
-      NLSR_LOG_DEBUG("*** Found ACTIVE neighbor, returning true ***");
-      return true;
-    }
-    else if (adjacency.getInterestTimedOutNo() >= interestRetryNo) {
-      nTimedOutNeighbors++;
-    }
+  if (m_nActive > 0) {
+    return true;
   }
-  /******新增调试部分9.17*****/
-  bool result = (nTimedOutNeighbors == m_adjList.size());
-  NLSR_LOG_DEBUG("TimedOut neighbors: " << nTimedOutNeighbors 
-                << "/" << m_adjList.size() << ", Result: " << result);
-  /***/
-  return result;
-}
 
-int32_t
-AdjacencyList::getNumOfActiveNeighbor() const
-{
-  int32_t actNbrCount = 0;
-  for (const auto& adjacent: m_adjList) {
-    if (adjacent.getStatus() == Adjacent::STATUS_ACTIVE) {
-      actNbrCount++;
-    }
+  // only a few distinct numbers of timeouts are ever counted
+  size_t nTimedOutNeighbors = 0;
+  for (auto it = m_nTimedOut.lower_bound(interestRetryNo); it != m_nTimedOut.end(); ++it) {
+    nTimedOutNeighbors += it->second;
   }
-  return actNbrCount;
+  NLSR_LOG_DEBUG("TimedOut neighbors: " << nTimedOutNeighbors << "/" << m_adjList.size());
+  return nTimedOutNeighbors == m_adjList.size();
 }
 
 std::list<Adjacent>::iterator
 AdjacencyList::find(const ndn::Name& adjName)
 {
-  return std::find_if(m_adjList.begin(), m_adjList.end(),
-                      std::bind(&Adjacent::compare, _1, std::cref(adjName)));
+  auto it = m_ids.find(adjName);
+  return it == m_ids.end() ? m_adjList.end() : m_byId[it->second];
 }
 
 std::list<Adjacent>::const_iterator
 AdjacencyList::find(const ndn::Name& adjName) const
 {
-  return std::find_if(m_adjList.cbegin(), m_adjList.cend(),
-                      std::bind(&Adjacent::compare, _1, std::cref(adjName)));
+  auto it = m_ids.find(adjName);
+  return it == m_ids.end() ? m_adjList.cend() : std::list<Adjacent>::const_iterator(m_byId[it->second]);
 }
 
 AdjacencyList::iterator
 AdjacencyList::findAdjacent(const ndn::Name& adjName)
 {
-  return std::find_if(m_adjList.begin(), m_adjList.end(),
-                      std::bind(&Adjacent::compare, _1, std::cref(adjName)));
+  return find(adjName);
 }
 
 AdjacencyList::iterator
 AdjacencyList::findAdjacent(uint64_t faceId)
 {
-  return std::find_if(m_adjList.begin(), m_adjList.end(),
-                      std::bind(&Adjacent::compareFaceId, _1, faceId));
+  auto it = m_byFaceId.find(faceId);
+  return it == m_byFaceId.end() ? m_adjList.end() : m_byId[it->second];
 }
 
 AdjacencyList::iterator
 AdjacencyList::findAdjacent(const ndn::FaceUri& faceUri)
 {
-  return std::find_if(m_adjList.begin(), m_adjList.end(),
-                      std::bind(&Adjacent::compareFaceUri, _1, faceUri));
+  auto it = m_byFaceUri.find(faceUri.toString());
+  return it == m_byFaceUri.end() ? m_adjList.end() : m_byId[it->second];
 }
 
 uint64_t
 AdjacencyList::getFaceId(const ndn::FaceUri& faceUri)
 {
-  auto it = std::find_if(m_adjList.begin(), m_adjList.end(),
-                         std::bind(&Adjacent::compareFaceUri, _1, faceUri));
+  auto it = findAdjacent(faceUri);
   return it != m_adjList.end() ? it->getFaceId() : 0;
 }
 
+ControlTraffic*
+AdjacencyList::getOrCreateControlTraffic(NeighborId id)
+{
+  if (id >= m_controlTraffic.size()) {
+    m_controlTraffic.resize(id + 1);
+  }
+  return &m_controlTraffic[id];
+}
+
+ControlTraffic*
+AdjacencyList::findControlTraffic(const ndn::Name& neighbor)
+{
+  auto id = getNeighborId(neighbor);
+  return id ? getOrCreateControlTraffic(*id) : nullptr;
+}
+
+ControlTraffic*
+AdjacencyList::findControlTraffic(uint64_t faceId)
+{
+  auto it = faceId == 0 ? m_byFaceId.end() : m_byFaceId.find(faceId);
+  return it == m_byFaceId.end() ? nullptr : getOrCreateControlTraffic(it->second);
+}
+
 void
 AdjacencyList::writeLog()
 {
+  if (!NLSR_LOG_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("-------Adjacency List--------");
   for (const auto& adjacent : m_adjList) {
     NLSR_LOG_DEBUG(adjacent);
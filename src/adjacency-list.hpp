@@ -24,20 +24,55 @@
 
 #include "adjacent.hpp"
 #include "common.hpp"
+#include "control-traffic.hpp"
+
+#include <ndn-cxx/util/signal.hpp>
 
 #include <list>
+#include <map>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace nlsr {
 
+/*! \brief Dense index of a neighbor in its AdjacencyList.
+ *
+ * IDs are assigned from 0 in insertion order and stay valid until the list is reset, so that
+ * per-neighbor state can be kept in arrays indexed by ID instead of maps keyed by Name. The ID
+ * of an erased neighbor is not reused until the list is copied or reset.
+ */
+using NeighborId = uint32_t;
+
 class AdjacencyList
 {
 public:
   using const_iterator = std::list<Adjacent>::const_iterator;
   using iterator = std::list<Adjacent>::iterator;
 
+  AdjacencyList() = default;
+
+  AdjacencyList(const AdjacencyList& other);
+
+  AdjacencyList(AdjacencyList&& other);
+
+  AdjacencyList&
+  operator=(const AdjacencyList& other);
+
+  AdjacencyList&
+  operator=(AdjacencyList&& other);
+
   bool
   insert(const Adjacent& adjacent);
 
+  /*! \brief Remove the neighbor \p adjName ; findById then returns end() for its ID.
+   *
+   * \return false if there is no such neighbor
+   */
+  bool
+  erase(const ndn::Name& adjName);
+
   std::list<Adjacent>&
   getAdjList();
 
@@ -47,6 +82,16 @@ public:
   bool
   isNeighbor(const ndn::Name& adjName) const;
 
+  /*! \brief Return the ID assigned to \p adjName when it was inserted.
+   */
+  std::optional<NeighborId>
+  getNeighborId(const ndn::Name& adjName) const;
+
+  /*! \brief Return the neighbor with ID \p id, or end() if there is none.
+   */
+  iterator
+  findById(NeighborId id);
+
   void
   incrementTimedOutInterestCount(const ndn::Name& neighbor);
 
@@ -62,6 +107,14 @@ public:
   void
   setTimedOutInterestCount(const ndn::Name& neighbor, uint32_t count);
 
+  /*! \brief Sets the Face ID of a neighbor and updates the index used by findAdjacent(faceId).
+   *
+   * Face IDs of neighbors in the list must be changed through this function rather than
+   * Adjacent::setFaceId, or findAdjacent(uint64_t) will not see the change.
+   */
+  void
+  setFaceId(const ndn::Name& neighbor, uint64_t faceId);
+
   /*! \brief Determines whether this list can be used to build an adj. LSA.
     \param interestRetryNo The maximum number of hello-interest
       retries to contact a neighbor.
@@ -81,7 +134,10 @@ public:
   isAdjLsaBuildable(const uint32_t interestRetryNo) const;
 
   int32_t
-  getNumOfActiveNeighbor() const;
+  getNumOfActiveNeighbor() const
+  {
+    return static_cast<int32_t>(m_nActive);
+  }
 
   Adjacent
   getAdjacent(const ndn::Name& adjName) const;
@@ -99,6 +155,13 @@ public:
   reset()
   {
     m_adjList.clear();
+    m_byId.clear();
+    m_ids.clear();
+    m_byFaceId.clear();
+    m_byFaceUri.clear();
+    m_nActive = 0;
+    m_nTimedOut.clear();
+    m_controlTraffic.clear();
   }
 
   AdjacencyList::iterator
@@ -113,6 +176,27 @@ public:
   uint64_t
   getFaceId(const ndn::FaceUri& faceUri);
 
+  /*! \brief Return the control traffic exchanged with \p neighbor , or nullptr if it is not a
+   *         neighbor.
+   */
+  ControlTraffic*
+  findControlTraffic(const ndn::Name& neighbor);
+
+  /*! \brief Return the control traffic exchanged with the neighbor on Face \p faceId , or
+   *         nullptr if there is none.
+   */
+  ControlTraffic*
+  findControlTraffic(uint64_t faceId);
+
+  /*! \brief Return the control traffic exchanged with the neighbor with ID \p id , or nullptr
+   *         if none was counted.
+   */
+  const ControlTraffic*
+  getControlTraffic(NeighborId id) const
+  {
+    return id < m_controlTraffic.size() ? &m_controlTraffic[id] : nullptr;
+  }
+
   void
   writeLog();
 
@@ -129,6 +213,12 @@ public:
     return m_adjList.end();
   }
 
+  /*! \brief Emitted when the status of a neighbor changes, with its previous status.
+   *
+   * A copy of the list does not copy the connections, nor the control traffic counters.
+   */
+  ndn::signal::Signal<AdjacencyList, const Adjacent&, Adjacent::Status> onStatusChanged;
+
 private:
   iterator
   find(const ndn::Name& adjName);
@@ -136,8 +226,32 @@ private:
   const_iterator
   find(const ndn::Name& adjName) const;
 
+  void
+  rebuildIndex();
+
+  void
+  addToIndex(iterator it);
+
+  void
+  updateCounters(const Adjacent& adjacent, int delta);
+
+  ControlTraffic*
+  getOrCreateControlTraffic(NeighborId id);
+
 private:
   std::list<Adjacent> m_adjList;
+  std::vector<iterator> m_byId;
+  // Hashed indexes over the list; a Face ID or FaceUri shared by several neighbors maps to the
+  // first one inserted, as a scan of the list would find
+  std::unordered_map<ndn::Name, NeighborId> m_ids;
+  std::unordered_map<uint64_t, NeighborId> m_byFaceId;
+  std::unordered_map<std::string, NeighborId> m_byFaceUri;
+  // Status counters, kept up to date by the setters so that isAdjLsaBuildable does not scan
+  size_t m_nActive = 0;
+  // number of neighbors that are not ACTIVE, by number of timed out Hello Interests
+  std::map<uint32_t, size_t> m_nTimedOut;
+  // indexed by NeighborId, grown on first count
+  std::vector<ControlTraffic> m_controlTraffic;
 };
 
 } // namespace nlsr
@@ -28,8 +28,7 @@ namespace nlsr {
 INIT_LOGGER(Adjacent);
 
 Adjacent::Adjacent()
-  : m_name()
-  , m_faceUri()
+  : m_faceUri()
   , m_linkCost(DEFAULT_LINK_COST)
   , m_originalLinkCost(DEFAULT_LINK_COST)
   , m_status(STATUS_INACTIVE)
@@ -91,7 +90,7 @@ Adjacent::wireEncode(ndn::EncodingImpl<TAG>& encoder) const
 
   totalLength += prependStringBlock(encoder, nlsr::tlv::Uri, m_faceUri.toString());
 
-  totalLength += m_name.wireEncode(encoder);
+  totalLength += m_name.getName().wireEncode(encoder);
 
   totalLength += encoder.prependVarNumber(totalLength);
   totalLength += encoder.prependVarNumber(nlsr::tlv::Adjacency);
@@ -120,7 +119,7 @@ Adjacent::wireEncode() const
 void
 Adjacent::wireDecode(const ndn::Block& wire)
 {
-  m_name.clear();
+  m_name = InternedName();
   m_faceUri = ndn::FaceUri();
   m_linkCost = 0;
   m_originalLinkCost = 0;
@@ -136,7 +135,7 @@ Adjacent::wireDecode(const ndn::Block& wire)
   auto val = m_wire.elements_begin();
 
   if (val != m_wire.elements_end() && val->type() == ndn::tlv::Name) {
-    m_name.wireDecode(*val);
+    m_name = ndn::Name(*val);
     ++val;
   }
   else {
@@ -164,7 +163,7 @@ Adjacent::wireDecode(const ndn::Block& wire)
 bool
 Adjacent::operator==(const Adjacent& adjacent) const
 {
-  return m_name == adjacent.getName() &&
+  return m_name == adjacent.m_name &&
          m_faceUri == adjacent.getFaceUri() &&
          util::diffInEpsilon(m_linkCost, adjacent.getLinkCost());
 }
@@ -173,7 +172,7 @@ bool
 Adjacent::operator<(const Adjacent& adjacent) const
 {
   auto linkCost = adjacent.getLinkCost();
-  return std::tie(m_name, m_linkCost) <
+  return std::tie(m_name.getName(), m_linkCost) <
          std::tie(adjacent.getName(), linkCost);
 }
 
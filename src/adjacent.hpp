@@ -22,6 +22,8 @@
 #ifndef NLSR_ADJACENT_HPP
 #define NLSR_ADJACENT_HPP
 
+#include "name-interner.hpp"
+
 #include <cmath>
 #include <string>
 
@@ -71,7 +73,7 @@ public:
   const ndn::Name&
   getName() const
   {
-    return m_name;
+    return m_name.getName();
   }
 
   void
@@ -110,6 +112,14 @@ public:
     return m_originalLinkCost;
   }
 
+  /*! \brief Change the configured cost, when the configuration is reloaded.
+   */
+  void
+  setOriginalLinkCost(double lc)
+  {
+    m_originalLinkCost = lc;
+  }
+
   Status
   getStatus() const
   {
@@ -164,7 +174,7 @@ public:
   inline bool
   compare(const ndn::Name& adjacencyName) const
   {
-    return m_name == adjacencyName;
+    return m_name.getName() == adjacencyName;
   }
 
   inline bool
@@ -194,8 +204,9 @@ public:
   static constexpr double NON_ADJACENT_COST = -12345.0;
 
 private:
-  /*! m_name The NLSR-configured router name of the neighbor */
-  ndn::Name m_name;
+  /*! m_name The NLSR-configured router name of the neighbor, interned as the same router
+      appears in the Adjacency LSAs of all of its neighbors */
+  InternedName m_name;
   /*! m_faceUri The NFD-level specification of the Face*/
   ndn::FaceUri m_faceUri;
   /*! m_linkCost The semi-arbitrary cost to traverse the link. */
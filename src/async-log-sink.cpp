@@ -0,0 +1,111 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "async-log-sink.hpp"
+
+#include <ndn-cxx/util/logger.hpp>
+#include <ndn-cxx/util/logging.hpp>
+
+#include <boost/core/null_deleter.hpp>
+#include <boost/log/expressions.hpp>
+#include <boost/log/sinks/async_frontend.hpp>
+#include <boost/log/sinks/bounded_fifo_queue.hpp>
+#include <boost/log/sinks/text_ostream_backend.hpp>
+#include <boost/make_shared.hpp>
+
+#include <atomic>
+#include <iomanip>
+
+namespace nlsr {
+
+namespace {
+
+std::atomic<uint64_t> g_droppedRecords{0};
+
+/*! \brief Overflow strategy of the queue that drops and counts the records that do not fit.
+ */
+class CountAndDrop
+{
+public:
+  template<typename LockT>
+  bool
+  on_overflow(const boost::log::record_view&, LockT&)
+  {
+    g_droppedRecords.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  void
+  on_queue_space_available()
+  {
+  }
+
+  void
+  interrupt()
+  {
+  }
+
+  void
+  reset()
+  {
+  }
+};
+
+using Backend = boost::log::sinks::text_ostream_backend;
+using Sink = boost::log::sinks::asynchronous_sink<
+  Backend, boost::log::sinks::bounded_fifo_queue<AsyncLogSink::QUEUE_SIZE, CountAndDrop>>;
+
+} // namespace
+
+AsyncLogSink::AsyncLogSink(std::ostream& os)
+{
+  auto backend = boost::make_shared<Backend>();
+  backend->add_stream(boost::shared_ptr<std::ostream>(&os, boost::null_deleter()));
+  // flushed on the background thread, so that a crash loses no more than the queue
+  backend->auto_flush(true);
+
+  auto sink = boost::make_shared<Sink>(backend);
+  // the same format as ndn-cxx's default destination
+  namespace expr = boost::log::expressions;
+  namespace log = ndn::util::log;
+  sink->set_formatter(expr::stream
+                      << expr::attr<std::string>(log::timestamp.get_name())
+                      << " " << std::setw(5) << log::severity << ": "
+                      << "[" << log::module << "] " << expr::smessage);
+  m_sink = sink;
+  ndn::util::Logging::setDestination(m_sink);
+}
+
+AsyncLogSink::~AsyncLogSink()
+{
+  ndn::util::Logging::setDestination(std::clog, true);
+  auto sink = boost::static_pointer_cast<Sink>(m_sink);
+  sink->stop();
+  sink->flush();
+}
+
+uint64_t
+AsyncLogSink::getDroppedRecords()
+{
+  return g_droppedRecords.load(std::memory_order_relaxed);
+}
+
+} // namespace nlsr
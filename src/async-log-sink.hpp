@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ASYNC_LOG_SINK_HPP
+#define NLSR_ASYNC_LOG_SINK_HPP
+
+#include <boost/log/sinks/sink.hpp>
+#include <boost/noncopyable.hpp>
+#include <boost/smart_ptr/shared_ptr.hpp>
+
+#include <cstdint>
+#include <ostream>
+
+namespace nlsr {
+
+/*! \brief Writes the log records of all the loggers from a bounded queue, on a thread of its own.
+ *
+ * The NLSR_LOG_* macros still build the message where they are called, but the formatting of
+ * the record, the write and the flush are done by the background thread. When the queue is
+ * full, records are dropped instead of blocking the caller, and counted.
+ *
+ * \sa nlsr::ConfParameter::getAsyncLogging
+ */
+class AsyncLogSink : boost::noncopyable
+{
+public:
+  /*! \brief Sends the log records to \p os until destroyed.
+   */
+  explicit
+  AsyncLogSink(std::ostream& os);
+
+  /*! \brief Writes the queued records, and sends the log records to std::clog again.
+   */
+  ~AsyncLogSink();
+
+  /*! \brief Returns the number of records dropped because the queue was full.
+   */
+  static uint64_t
+  getDroppedRecords();
+
+public:
+  static constexpr size_t QUEUE_SIZE = 65536;
+
+private:
+  boost::shared_ptr<boost::log::sinks::sink> m_sink;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ASYNC_LOG_SINK_HPP
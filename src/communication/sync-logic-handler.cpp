@@ -24,11 +24,25 @@
 #include "logger.hpp"
 #include "utility/name-helper.hpp"
 
+#include <algorithm>
+#include <map>
+
 namespace nlsr {
 
 INIT_LOGGER(SyncLogicHandler);
 
-const std::string LSA_COMPONENT{"LSA"};
+namespace {
+
+/*! \brief Returns the number of LSA types, i.e. sync user nodes, that each router publishes.
+ */
+size_t
+getUserNodesPerRouter(HyperbolicState hyperbolicState)
+{
+  // a Name LSA, and an Adjacency LSA and/or a Coordinate LSA
+  return 1 + (hyperbolicState != HYPERBOLIC_STATE_ON) + (hyperbolicState != HYPERBOLIC_STATE_OFF);
+}
+
+} // namespace
 
 SyncLogicHandler::SyncLogicHandler(ndn::Face& face, ndn::KeyChain& keyChain,
                                    IsLsaNew isLsaNew, const SyncLogicOptions& opts)
@@ -40,36 +54,123 @@ SyncLogicHandler::SyncLogicHandler(ndn::Face& face, ndn::KeyChain& keyChain,
   , m_coorLsaUserPrefix(makeLsaUserPrefix(opts.userPrefix, Lsa::Type::COORDINATE))
   , m_syncLogic(face, keyChain, opts.syncProtocol, opts.syncPrefix,
                 m_nameLsaUserPrefix, opts.syncInterestLifetime,
-                std::bind(&SyncLogicHandler::processUpdate, this, _1, _2, _3))
+                std::bind(&SyncLogicHandler::processUpdates, this, _1),
+                opts.expectedRouters * getUserNodesPerRouter(opts.hyperbolicState))
+  , m_scheduler(face.getIoContext())
+  , m_publishHoldDown(opts.publishHoldDown)
+{
+  for (const auto& syncPrefix : opts.borderSyncPrefixes) {
+    NLSR_LOG_INFO("Joining the sync group of a neighboring area: " << syncPrefix);
+    m_borderSyncLogics.push_back(std::make_unique<SyncProtocolAdapter>(face, keyChain,
+      opts.syncProtocol, syncPrefix, m_nameLsaUserPrefix, opts.syncInterestLifetime,
+      std::bind(&SyncLogicHandler::processUpdates, this, _1),
+      opts.expectedRouters * getUserNodesPerRouter(opts.hyperbolicState)));
+  }
+
+  for (auto* syncLogic : getSyncLogics()) {
+    if (m_hyperbolicState != HYPERBOLIC_STATE_ON) {
+      syncLogic->addUserNode(m_adjLsaUserPrefix);
+    }
+
+    if (m_hyperbolicState != HYPERBOLIC_STATE_OFF) {
+      syncLogic->addUserNode(m_coorLsaUserPrefix);
+    }
+  }
+}
+
+void
+SyncLogicHandler::setExpectedRouters(size_t nRouters)
 {
-  if (m_hyperbolicState != HYPERBOLIC_STATE_ON) {
-    m_syncLogic.addUserNode(m_adjLsaUserPrefix);
+  for (auto* syncLogic : getSyncLogics()) {
+    syncLogic->setExpectedUserNodes(nRouters * getUserNodesPerRouter(m_hyperbolicState));
   }
+}
 
-  if (m_hyperbolicState != HYPERBOLIC_STATE_OFF) {
-    m_syncLogic.addUserNode(m_coorLsaUserPrefix);
+uint64_t
+SyncLogicHandler::getIbfResizeCount() const
+{
+  uint64_t nResizes = m_syncLogic.getIbfResizeCount();
+  for (const auto& syncLogic : m_borderSyncLogics) {
+    nResizes += syncLogic->getIbfResizeCount();
   }
+  return nResizes;
+}
+
+std::vector<SyncProtocolAdapter*>
+SyncLogicHandler::getSyncLogics()
+{
+  std::vector<SyncProtocolAdapter*> syncLogics{&m_syncLogic};
+  for (auto& syncLogic : m_borderSyncLogics) {
+    syncLogics.push_back(syncLogic.get());
+  }
+  return syncLogics;
 }
 
 void
-SyncLogicHandler::processUpdate(const ndn::Name& updateName, uint64_t highSeq, uint64_t incomingFaceId)
+SyncLogicHandler::processUpdates(const std::vector<SyncUpdate>& updates)
 {
-  NLSR_LOG_DEBUG("Update Name: " << updateName << " Seq no: " << highSeq);
+  struct Candidate
+  {
+    const SyncUpdate* update;
+    ndn::Name originRouter;
+    bool isRoutingLsa;
+  };
+  std::vector<Candidate> candidates;
+  std::map<ndn::Name, size_t> byUpdateName;
+
+  for (const auto& update : updates) {
+    NLSR_LOG_DEBUG("Update Name: " << update.updateName << " Seq no: " << update.seqNo);
+
+    auto [it, isNew] = byUpdateName.try_emplace(update.updateName, candidates.size());
+    if (!isNew) {
+      auto& candidate = candidates[it->second];
+      if (update.seqNo > candidate.update->seqNo) {
+        NLSR_LOG_TRACE("Superseded in the same batch: " << candidate.update->seqNo);
+        candidate.update = &update;
+      }
+      continue;
+    }
+
+    ndn::Name originRouter = getOriginRouter(update.updateName);
+    if (originRouter.empty()) {
+      NLSR_LOG_WARN("Received malformed sync update");
+      byUpdateName.erase(it);
+      continue;
+    }
+    auto lsaType = parseLsaType(update.updateName[-1]);
+    candidates.push_back({&update, std::move(originRouter),
+                          lsaType == Lsa::Type::ADJACENCY || lsaType == Lsa::Type::COORDINATE});
+  }
 
-  int32_t nlsrPosition = util::getNameComponentPosition(updateName, HelloProtocol::NLSR_COMPONENT);
-  int32_t lsaPosition = util::getNameComponentPosition(updateName, LSA_COMPONENT);
+  std::stable_sort(candidates.begin(), candidates.end(), [] (const auto& lhs, const auto& rhs) {
+    if (lhs.isRoutingLsa != rhs.isRoutingLsa) {
+      return lhs.isRoutingLsa;
+    }
+    return lhs.originRouter < rhs.originRouter;
+  });
+
+  for (const auto& candidate : candidates) {
+    processUpdateFromSync(candidate.originRouter, candidate.update->updateName,
+                          candidate.update->seqNo, candidate.update->incomingFaceId);
+  }
+}
+
+ndn::Name
+SyncLogicHandler::getOriginRouter(const ndn::Name& updateName) const
+{
+  int32_t nlsrPosition = util::getNameComponentPosition(updateName,
+                                                        HelloProtocol::NLSR_NAME_COMPONENT);
+  int32_t lsaPosition = util::getNameComponentPosition(updateName, util::LSA_COMPONENT);
 
   if (nlsrPosition < 0 || lsaPosition < 0) {
-    NLSR_LOG_WARN("Received malformed sync update");
-    return;
+    return {};
   }
 
   ndn::Name networkName = updateName.getSubName(1, nlsrPosition - 1);
   ndn::Name routerName = updateName.getSubName(lsaPosition + 1).getPrefix(-1);
   ndn::Name originRouter = networkName;
   originRouter.append(routerName);
-
-  processUpdateFromSync(originRouter, updateName, highSeq, incomingFaceId);
+  return originRouter;
 }
 
 void
@@ -110,19 +211,53 @@ SyncLogicHandler::processUpdateFromSync(const ndn::Name& originRouter,
 void
 SyncLogicHandler::publishRoutingUpdate(Lsa::Type type, uint64_t seqNo)
 {
+  if (type == Lsa::Type::BASE) {
+    return;
+  }
+
+  auto& state = m_publishStates[static_cast<size_t>(type)];
+  state.seqNo = seqNo;
+  if (state.event) {
+    NLSR_LOG_DEBUG("Coalescing " << type << " publication of sequence number " << seqNo);
+    return;
+  }
+
+  auto nextPublication = state.lastPublication + m_publishHoldDown;
+  auto now = ndn::time::steady_clock::now();
+  if (m_publishHoldDown <= ndn::time::milliseconds::zero() || nextPublication <= now) {
+    publishNow(type);
+  }
+  else {
+    state.event = m_scheduler.schedule(nextPublication - now, [this, type] { publishNow(type); });
+  }
+}
+
+void
+SyncLogicHandler::publishNow(Lsa::Type type)
+{
+  auto& state = m_publishStates[static_cast<size_t>(type)];
+  state.event.cancel();
+  state.lastPublication = ndn::time::steady_clock::now();
+  state.publishedSeqNo = state.seqNo;
+
+  const ndn::Name* userPrefix = nullptr;
   switch (type) {
   case Lsa::Type::ADJACENCY:
-    m_syncLogic.publishUpdate(m_adjLsaUserPrefix, seqNo);
+    userPrefix = &m_adjLsaUserPrefix;
     break;
   case Lsa::Type::COORDINATE:
-    m_syncLogic.publishUpdate(m_coorLsaUserPrefix, seqNo);
+    userPrefix = &m_coorLsaUserPrefix;
     break;
   case Lsa::Type::NAME:
-    m_syncLogic.publishUpdate(m_nameLsaUserPrefix, seqNo);
+    userPrefix = &m_nameLsaUserPrefix;
     break;
   default:
-    break;
+    return;
+  }
+  for (auto* syncLogic : getSyncLogics()) {
+    syncLogic->publishUpdate(*userPrefix, state.seqNo);
   }
+  afterPublish(ndn::Name(*userPrefix).appendNumber(state.seqNo));
 }
 
 } // namespace nlsr
@@ -28,8 +28,14 @@
 #include "sync-protocol-adapter.hpp"
 #include "test-access-control.hpp"
 
+#include <ndn-cxx/util/scheduler.hpp>
+
 #include <boost/lexical_cast.hpp>
 
+#include <array>
+#include <memory>
+#include <vector>
+
 namespace nlsr {
 
 struct SyncLogicOptions
@@ -40,6 +46,12 @@ struct SyncLogicOptions
   ndn::time::milliseconds syncInterestLifetime;
   ndn::Name routerPrefix;
   HyperbolicState hyperbolicState;
+  /// Minimum interval between two publications of the same LSA type, 0 to publish right away
+  ndn::time::milliseconds publishHoldDown = ndn::time::milliseconds::zero();
+  /// Sync prefixes of the other areas of an area border router, whose groups it also joins
+  std::vector<ndn::Name> borderSyncPrefixes;
+  /// Number of routers the sync groups are sized for, 0 for the default size
+  size_t expectedRouters = 0;
 };
 
 inline ndn::Name
@@ -76,20 +88,68 @@ public:
    * this is called. Since each ChronoSync instance maintains its own
    * PIT, doing this satisfies those interests so that other routers
    * know a sync update is available.
+   *
+   * With a publish hold-down, an update that follows the previous publication of the same LSA
+   * type within the hold-down is delayed until the hold-down ends. Updates delayed together
+   * are coalesced into a single publication of the newest sequence number, so that other
+   * routers do not fetch LSAs that are about to be superseded.
    * \sa publishSyncUpdate
    */
   void
   publishRoutingUpdate(Lsa::Type type, uint64_t seqNo);
 
+  /*! \brief Carry small LSAs along with the sync state, where the sync protocol supports it.
+   *
+   * \param getInlineLsas returns the signed LSA segments to send with our sync Interests
+   * \param onInlineLsa receives, unvalidated, each LSA segment sent by another router
+   * \sa SyncProtocolAdapter::setInlineDataCallbacks
+   */
+  void
+  setInlineLsaCallbacks(GetInlineDataCallback getInlineLsas, InlineDataCallback onInlineLsa)
+  {
+    for (auto& syncLogic : m_borderSyncLogics) {
+      syncLogic->setInlineDataCallbacks(getInlineLsas, onInlineLsa);
+    }
+    m_syncLogic.setInlineDataCallbacks(std::move(getInlineLsas), std::move(onInlineLsa));
+  }
+
+  /*! \brief Size the sync groups for \p nRouters routers.
+   *
+   * \p nRouters must be the same on every router of the sync groups, hence it comes from the
+   * configuration, and never from the local LSDB.
+   * \sa SyncProtocolAdapter::setExpectedUserNodes
+   */
+  void
+  setExpectedRouters(size_t nRouters);
+
+  /*! \brief Returns the number of cells of the PSync IBF of our area's sync group.
+   */
+  size_t
+  getIbfCount() const
+  {
+    return m_syncLogic.getIbfCount();
+  }
+
+  /*! \brief Returns how many times the PSync IBFs of all our sync groups were resized.
+   */
+  uint64_t
+  getIbfResizeCount() const;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /*! \brief Callback from Sync protocol
    *
-   * In a typical situation this only needs to be called once, when NLSR starts.
-   * \param updateName The prefix for which sync reports an update
-   * \param highSeq The latest sequence number of the update
+   * The updates of a sync event are processed together: an update superseded by a higher
+   * sequence number of the same LSA in the batch is dropped, and the rest are grouped by
+   * origin router with the Adjacency and Coordinate LSAs first, so that the LSAs needed by
+   * the routing calculation are fetched ahead of the Name LSAs.
    */
   void
-  processUpdate(const ndn::Name& updateName, uint64_t highSeq, uint64_t incomingFaceId);
+  processUpdates(const std::vector<SyncUpdate>& updates);
+
+  /*! \brief Returns the origin router of an update, or an empty name if it is malformed.
+   */
+  ndn::Name
+  getOriginRouter(const ndn::Name& updateName) const;
 
   /*! \brief Determine which kind of LSA was updated and fetch it.
    *
@@ -103,8 +163,20 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   processUpdateFromSync(const ndn::Name& originRouter,
                         const ndn::Name& updateName, uint64_t seqNo, uint64_t incomingFaceId);
 
+  void
+  publishNow(Lsa::Type type);
+
+  /*! \brief Returns the sync group of our area, followed by those of the other areas.
+   */
+  std::vector<SyncProtocolAdapter*>
+  getSyncLogics();
+
 public:
   OnNewLsa onNewLsa;
+  /*! \brief Emitted with the name of an LSA, i.e. its sync prefix and sequence number, when its
+   *         update is handed to the sync protocol.
+   */
+  ndn::signal::Signal<SyncLogicHandler, ndn::Name> afterPublish;
 
 private:
   IsLsaNew m_isLsaNew;
@@ -117,6 +189,20 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::Name m_coorLsaUserPrefix;
 
   SyncProtocolAdapter m_syncLogic;
+  /// the groups of the other areas of an area border router, which it publishes to as well
+  std::vector<std::unique_ptr<SyncProtocolAdapter>> m_borderSyncLogics;
+
+  struct PublishState
+  {
+    uint64_t seqNo = 0;
+    uint64_t publishedSeqNo = 0;
+    ndn::time::steady_clock::time_point lastPublication;
+    ndn::scheduler::ScopedEventId event;
+  };
+
+  ndn::Scheduler m_scheduler;
+  ndn::time::milliseconds m_publishHoldDown;
+  std::array<PublishState, static_cast<size_t>(Lsa::Type::BASE)> m_publishStates;
 };
 
 } // namespace nlsr
@@ -21,6 +21,9 @@
 
 #include "sync-protocol-adapter.hpp"
 #include "logger.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <algorithm>
 
 namespace nlsr {
 
@@ -36,7 +39,8 @@ SyncProtocolAdapter::SyncProtocolAdapter(ndn::Face& face,
                                          const ndn::Name& syncPrefix,
                                          const ndn::Name& userPrefix,
                                          ndn::time::milliseconds syncInterestLifetime,
-                                         SyncUpdateCallback syncUpdateCallback)
+                                         SyncUpdateCallback syncUpdateCallback,
+                                         size_t expectedUserNodes)
   : m_syncProtocol(syncProtocol)
   , m_syncUpdateCallback(std::move(syncUpdateCallback))
 {
@@ -62,11 +66,20 @@ SyncProtocolAdapter::SyncProtocolAdapter(ndn::Face& face,
 #ifdef HAVE_PSYNC
     case SyncProtocol::PSYNC: {
       NDN_LOG_DEBUG("Using PSync");
-      psync::FullProducer::Options opts;
-      opts.onUpdate = [this] (auto&&... args) { onPSyncUpdate(std::forward<decltype(args)>(args)...); };
-      opts.syncInterestLifetime = syncInterestLifetime;
-      m_psyncLogic = std::make_shared<psync::FullProducer>(face, keyChain, syncPrefix, opts);
+      m_face = &face;
+      m_keyChain = &keyChain;
+      m_syncPrefix = syncPrefix;
+      m_psyncOptions.onUpdate = [this] (auto&&... args) {
+        onPSyncUpdate(std::forward<decltype(args)>(args)...);
+      };
+      m_psyncOptions.syncInterestLifetime = syncInterestLifetime;
+      m_defaultIbfCount = m_psyncOptions.ibfCount;
+      m_psyncOptions.ibfCount = computeIbfCount(expectedUserNodes, m_defaultIbfCount);
+      NLSR_LOG_DEBUG("PSync IBF size: " << m_psyncOptions.ibfCount);
+      m_psyncLogic = std::make_shared<psync::FullProducer>(face, keyChain, syncPrefix,
+                                                           m_psyncOptions);
       m_psyncLogic->addUserNode(userPrefix);
+      m_userNodes.push_back(userPrefix);
       break;
     }
 #endif // HAVE_PSYNC
@@ -95,6 +108,7 @@ SyncProtocolAdapter::addUserNode(const ndn::Name& userPrefix)
 #ifdef HAVE_PSYNC
   case SyncProtocol::PSYNC:
     m_psyncLogic->addUserNode(userPrefix);
+    m_userNodes.push_back(userPrefix);
     break;
 #endif // HAVE_PSYNC
 #ifdef HAVE_SVS
@@ -118,6 +132,7 @@ SyncProtocolAdapter::publishUpdate(const ndn::Name& userPrefix, uint64_t seq)
 #ifdef HAVE_PSYNC
   case SyncProtocol::PSYNC:
     m_psyncLogic->publishName(userPrefix, seq);
+    m_publishedSeqNos[userPrefix] = seq;
     break;
 #endif // HAVE_PSYNC
 #ifdef HAVE_SVS
@@ -130,16 +145,146 @@ SyncProtocolAdapter::publishUpdate(const ndn::Name& userPrefix, uint64_t seq)
   }
 }
 
+void
+SyncProtocolAdapter::setInlineDataCallbacks(GetInlineDataCallback getInlineData,
+                                            InlineDataCallback onInlineData)
+{
+  m_getInlineData = std::move(getInlineData);
+  m_onInlineData = std::move(onInlineData);
+
+  switch (m_syncProtocol) {
+#ifdef HAVE_CHRONOSYNC
+  case SyncProtocol::CHRONOSYNC:
+    NLSR_LOG_DEBUG("ChronoSync does not carry inline data");
+    break;
+#endif // HAVE_CHRONOSYNC
+#ifdef HAVE_PSYNC
+  case SyncProtocol::PSYNC:
+    NLSR_LOG_DEBUG("PSync does not carry inline data");
+    break;
+#endif // HAVE_PSYNC
+#ifdef HAVE_SVS
+  case SyncProtocol::SVS:
+    m_svsCore->setGetExtraBlockCallback([this] (const auto&) { return encodeInlineData(); });
+    m_svsCore->setRecvExtraBlockCallback([this] (const ndn::Block& block, const auto&) {
+      decodeInlineData(block);
+    });
+    break;
+#endif // HAVE_SVS
+  default:
+    NDN_CXX_UNREACHABLE;
+  }
+}
+
+void
+SyncProtocolAdapter::setExpectedUserNodes(size_t nUserNodes)
+{
+#ifdef HAVE_PSYNC
+  if (m_syncProtocol == SyncProtocol::PSYNC) {
+    auto ibfCount = computeIbfCount(nUserNodes, m_defaultIbfCount);
+    if (ibfCount != m_psyncOptions.ibfCount) {
+      resizePSync(ibfCount);
+    }
+  }
+#endif // HAVE_PSYNC
+}
+
+size_t
+SyncProtocolAdapter::getIbfCount() const
+{
+#ifdef HAVE_PSYNC
+  if (m_syncProtocol == SyncProtocol::PSYNC) {
+    return m_psyncOptions.ibfCount;
+  }
+#endif // HAVE_PSYNC
+  return 0;
+}
+
+size_t
+SyncProtocolAdapter::computeIbfCount(size_t nUserNodes, size_t defaultCount)
+{
+  if (nUserNodes == 0) {
+    return defaultCount;
+  }
+  size_t needed = nUserNodes + (nUserNodes + 1) / 2;
+  if (needed > MAX_IBF_COUNT) {
+    NLSR_LOG_WARN("An IBF of " << MAX_IBF_COUNT << " cells may not decode the differences "
+                  "between " << nUserNodes << " user nodes");
+  }
+  return std::min(needed, MAX_IBF_COUNT);
+}
+
+#ifdef HAVE_PSYNC
+void
+SyncProtocolAdapter::resizePSync(size_t ibfCount)
+{
+  NLSR_LOG_INFO("Resizing the PSync IBF of " << m_syncPrefix << " from "
+                << m_psyncOptions.ibfCount << " to " << ibfCount << " cells");
+  m_psyncOptions.ibfCount = ibfCount;
+
+  // the old producer gives up the sync prefix before the new one takes it
+  m_psyncLogic.reset();
+  m_psyncLogic = std::make_shared<psync::FullProducer>(*m_face, *m_keyChain, m_syncPrefix,
+                                                       m_psyncOptions);
+  for (const auto& userNode : m_userNodes) {
+    m_psyncLogic->addUserNode(userNode);
+  }
+  for (const auto& [userNode, seq] : m_publishedSeqNos) {
+    m_psyncLogic->publishName(userNode, seq);
+  }
+  ++m_nIbfResizes;
+}
+#endif // HAVE_PSYNC
+
+ndn::Block
+SyncProtocolAdapter::encodeInlineData() const
+{
+  auto inlineData = m_getInlineData();
+  if (inlineData.empty()) {
+    return {};
+  }
+
+  ndn::Block block(tlv::InlineData);
+  for (const auto& data : inlineData) {
+    block.push_back(data->wireEncode());
+  }
+  block.encode();
+  return block;
+}
+
+void
+SyncProtocolAdapter::decodeInlineData(const ndn::Block& block) const
+{
+  if (block.type() != tlv::InlineData) {
+    return;
+  }
+
+  try {
+    block.parse();
+    for (const auto& element : block.elements()) {
+      if (element.type() == ndn::tlv::Data) {
+        m_onInlineData(ndn::Data(element));
+      }
+    }
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_WARN("Malformed inline data: " << e.what());
+  }
+}
+
 #ifdef HAVE_CHRONOSYNC
 void
 SyncProtocolAdapter::onChronoSyncUpdate(const std::vector<chronosync::MissingDataInfo>& updates)
 {
   NLSR_LOG_TRACE("Received ChronoSync update event");
 
+  std::vector<SyncUpdate> syncUpdates;
+  syncUpdates.reserve(updates.size());
   for (const auto& update : updates) {
     // Remove FIXED_SESSION
-    m_syncUpdateCallback(update.session.getPrefix(-1), update.high, 0);
+    syncUpdates.push_back({update.session.getPrefix(-1), update.high, 0});
   }
+  m_syncUpdateCallback(syncUpdates);
 }
 #endif // HAVE_CHRONOSYNC
 
@@ -149,9 +294,12 @@ SyncProtocolAdapter::onPSyncUpdate(const std::vector<psync::MissingDataInfo>& up
 {
   NLSR_LOG_TRACE("Received PSync update event");
 
+  std::vector<SyncUpdate> syncUpdates;
+  syncUpdates.reserve(updates.size());
   for (const auto& update : updates) {
-    m_syncUpdateCallback(update.prefix, update.highSeq, update.incomingFace);
+    syncUpdates.push_back({update.prefix, update.highSeq, update.incomingFace});
   }
+  m_syncUpdateCallback(syncUpdates);
 }
 #endif // HAVE_PSYNC
 
@@ -161,9 +309,12 @@ SyncProtocolAdapter::onSvsUpdate(const std::vector<ndn::svs::MissingDataInfo>& u
 {
   NLSR_LOG_TRACE("Received SVS update event");
 
+  std::vector<SyncUpdate> syncUpdates;
+  syncUpdates.reserve(updates.size());
   for (const auto& update : updates) {
-    m_syncUpdateCallback(update.nodeId, update.high, update.incomingFace);
+    syncUpdates.push_back({update.nodeId, update.high, update.incomingFace});
   }
+  m_syncUpdateCallback(syncUpdates);
 }
 #endif // HAVE_SVS
 
@@ -32,6 +32,8 @@
 #endif
 #ifdef HAVE_PSYNC
 #include <PSync/full-producer.hpp>
+
+#include <map>
 #endif
 #ifdef HAVE_SVS
 #include <ndn-svs/core.hpp>
@@ -39,19 +41,42 @@
 
 namespace nlsr {
 
-using SyncUpdateCallback = std::function<void(const ndn::Name& updateName,
-                                              uint64_t seqNo, uint64_t incomingFaceId)>;
+struct SyncUpdate
+{
+  ndn::Name updateName;
+  uint64_t seqNo;
+  uint64_t incomingFaceId;
+};
+
+/*! \brief Callback invoked once with all the updates of a sync event.
+ */
+using SyncUpdateCallback = std::function<void(const std::vector<SyncUpdate>& updates)>;
+
+/*! \brief Callback returning the Data packets to carry along with the sync state.
+ */
+using GetInlineDataCallback = std::function<std::vector<std::shared_ptr<const ndn::Data>>()>;
+
+/*! \brief Callback invoked for each Data packet carried along with the sync state.
+ */
+using InlineDataCallback = std::function<void(const ndn::Data& data)>;
 
 class SyncProtocolAdapter
 {
 public:
+  /*! \brief Join the sync group.
+   *
+   * \param expectedUserNodes the number of user nodes of the sync group, which its data
+   *        structures are sized for; 0 for the default size
+   * \sa setExpectedUserNodes
+   */
   SyncProtocolAdapter(ndn::Face& face,
                       ndn::KeyChain& keyChain,
                       SyncProtocol syncProtocol,
                       const ndn::Name& syncPrefix,
                       const ndn::Name& userPrefix,
                       ndn::time::milliseconds syncInterestLifetime,
-                      SyncUpdateCallback syncUpdateCallback);
+                      SyncUpdateCallback syncUpdateCallback,
+                      size_t expectedUserNodes = 0);
 
   /*! \brief Add user node to Sync
    *
@@ -71,12 +96,59 @@ public:
   void
   publishUpdate(const ndn::Name& userPrefix, uint64_t seq);
 
+  /*! \brief Carry Data packets along with the sync state
+   *
+   * Only SVS supports this: the Data returned by \p getInlineData are appended to each
+   * sync Interest, and the Data found in the sync Interests of other routers are passed
+   * to \p onInlineData, unvalidated. With other sync protocols, this does nothing.
+   */
+  void
+  setInlineDataCallbacks(GetInlineDataCallback getInlineData, InlineDataCallback onInlineData);
+
+  /*! \brief Size the sync data structures for \p nUserNodes user nodes in the sync group.
+   *
+   * Only PSync is sized. Its IBF must decode the differences between the sync states of two
+   * routers, or else the whole state is sent instead. PSync also drops the sync Interests whose
+   * IBF has another size than its own, so every router of the sync group must be given the
+   * same \p nUserNodes. The size thus depends on \p nUserNodes only, and never on the sizes
+   * set before. When it changes, the PSync producer is recreated with the new IBF, and our
+   * user nodes and their sequence numbers are carried over. With other sync protocols, this
+   * does nothing.
+   */
+  void
+  setExpectedUserNodes(size_t nUserNodes);
+
+  /*! \brief Returns the number of cells of the PSync IBF, or 0 with other sync protocols.
+   */
+  size_t
+  getIbfCount() const;
+
+  /*! \brief Returns how many times the PSync IBF was resized.
+   */
+  uint64_t
+  getIbfResizeCount() const
+  {
+    return m_nIbfResizes;
+  }
+
+  /*! \brief Returns the IBF size for \p nUserNodes user nodes; \p defaultCount for 0.
+   *
+   * An IBF decodes about 1/1.5 as many differences as it has cells. It is capped so that the
+   * IBF still fits in a sync Interest.
+   */
+  static size_t
+  computeIbfCount(size_t nUserNodes, size_t defaultCount);
+
+public:
+  /// 12-byte cells; the IBF is carried in the name of the sync Interests
+  static constexpr size_t MAX_IBF_COUNT = 640;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 #ifdef HAVE_CHRONOSYNC
    /*! \brief Hook function to call whenever ChronoSync detects new data.
    *
    * This function packages the sync information into discrete updates
-   * and passes those off to another function, m_syncUpdateCallback.
+   * and passes them off together to another function, m_syncUpdateCallback.
    *
    * \param updates A container with the new information sync has received
    */
@@ -88,19 +160,24 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
    /*! \brief Hook function to call whenever PSync detects new data.
    *
    * This function packages the sync information into discrete updates
-   * and passes those off to another function, m_syncUpdateCallback.
+   * and passes them off together to another function, m_syncUpdateCallback.
    *
    * \param updates A container with the new information sync has received
    */
   void
   onPSyncUpdate(const std::vector<psync::MissingDataInfo>& updates);
+
+  /*! \brief Replaces the PSync producer with one whose IBF has \p ibfCount cells.
+   */
+  void
+  resizePSync(size_t ibfCount);
 #endif // HAVE_PSYNC
 
 #ifdef HAVE_SVS
   /*! \brief Hook function to call whenever SVS detects new data.
    *
    * This function packages the sync information into discrete updates
-   * and passes those off to another function, m_syncUpdateCallback.
+   * and passes them off together to another function, m_syncUpdateCallback.
    *
    * \param updates A container with the new information sync has received
    */
@@ -108,15 +185,36 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   onSvsUpdate(const std::vector<ndn::svs::MissingDataInfo>& updates);
 #endif // HAVE_SVS
 
+  /*! \brief Encodes the Data returned by m_getInlineData, or returns an invalid block if none.
+   */
+  ndn::Block
+  encodeInlineData() const;
+
+  /*! \brief Passes each Data of an encoded block to m_onInlineData.
+   */
+  void
+  decodeInlineData(const ndn::Block& block) const;
+
 private:
   SyncProtocol m_syncProtocol;
   SyncUpdateCallback m_syncUpdateCallback;
+  GetInlineDataCallback m_getInlineData;
+  InlineDataCallback m_onInlineData;
+  uint64_t m_nIbfResizes = 0;
 
 #ifdef HAVE_CHRONOSYNC
   std::shared_ptr<chronosync::Logic> m_chronoSyncLogic;
 #endif
 #ifdef HAVE_PSYNC
   std::shared_ptr<psync::FullProducer> m_psyncLogic;
+  // kept to recreate the producer with another IBF size
+  ndn::Face* m_face = nullptr;
+  ndn::KeyChain* m_keyChain = nullptr;
+  ndn::Name m_syncPrefix;
+  psync::FullProducer::Options m_psyncOptions;
+  size_t m_defaultIbfCount = 0;
+  std::vector<ndn::Name> m_userNodes;
+  std::map<ndn::Name, uint64_t> m_publishedSeqNos;
 #endif
 #ifdef HAVE_SVS
   std::shared_ptr<ndn::svs::SVSyncCore> m_svsCore;
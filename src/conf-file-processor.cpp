@@ -161,6 +161,24 @@ ConfFileProcessor::processConfFile()
   return true;
 }
 
+bool
+ConfFileProcessor::reloadConfFile()
+{
+  m_isReload = true;
+  std::ifstream inputFile(m_confFileName);
+  if (!inputFile.is_open()) {
+    std::cerr << "Failed to read configuration file: " << m_confFileName << std::endl;
+    return false;
+  }
+
+  if (!load(inputFile)) {
+    return false;
+  }
+
+  m_confParam.buildRouterAndSyncUserPrefix();
+  return true;
+}
+
 bool
 ConfFileProcessor::load(std::istream& input)
 {
@@ -279,6 +297,32 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     return false;
   }
 
+  // area-depth
+  uint32_t areaDepth = section.get<uint32_t>("area-depth", 0);
+  if (areaDepth > m_confParam.getSiteName().size()) {
+    std::cerr << "Value of area-depth cannot exceed the number of components of the site"
+              << std::endl;
+    return false;
+  }
+  m_confParam.setAreaDepth(areaDepth);
+
+  // backbone-area
+  try {
+    ndn::Name backboneArea(section.get<std::string>("backbone-area", ""));
+    if (!backboneArea.empty() &&
+        (areaDepth == 0 || backboneArea.size() != m_confParam.getNetwork().size() + areaDepth ||
+         !m_confParam.getNetwork().isPrefixOf(backboneArea))) {
+      std::cerr << "backbone-area must be the network name followed by area-depth components"
+                << std::endl;
+      return false;
+    }
+    m_confParam.setBackboneArea(backboneArea);
+  }
+  catch (const std::exception& ex) {
+    std::cerr << ex.what() << std::endl;
+    return false;
+  }
+
   // lsa-refresh-time
   uint32_t lsaRefreshTime = section.get<uint32_t>("lsa-refresh-time", LSA_REFRESH_TIME_DEFAULT);
 
@@ -349,7 +393,9 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
 
         m_confParam.setConfFileNameDynamic(conFileDynamic.string());
         try {
-          fs::copy_file(m_confFileName, conFileDynamic, fs::copy_options::overwrite_existing);
+          if (!m_isReload) {
+            fs::copy_file(m_confFileName, conFileDynamic, fs::copy_options::overwrite_existing);
+          }
         }
         catch (const fs::filesystem_error& e) {
           std::cerr << "Error copying conf file to state-dir: " << e.what() << std::endl;
@@ -426,6 +472,280 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     m_confParam.setMLAdaptiveRouting(false);
   }
 
+  // ml-weekly-patterns
+  std::string mlWeeklyPatterns = section.get<std::string>("ml-weekly-patterns", "off");
+  if (boost::iequals(mlWeeklyPatterns, "on")) {
+    m_confParam.setMLWeeklyPatterns(true);
+  }
+  else if (boost::iequals(mlWeeklyPatterns, "off")) {
+    m_confParam.setMLWeeklyPatterns(false);
+  }
+  else {
+    std::cerr << "Invalid value for ml-weekly-patterns: " << mlWeeklyPatterns << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // ml-route-precompute
+  std::string mlRoutePrecompute = section.get<std::string>("ml-route-precompute", "off");
+  if (boost::iequals(mlRoutePrecompute, "on")) {
+    m_confParam.setMLRoutePrecompute(true);
+  }
+  else if (boost::iequals(mlRoutePrecompute, "off")) {
+    m_confParam.setMLRoutePrecompute(false);
+  }
+  else {
+    std::cerr << "Invalid value for ml-route-precompute: " << mlRoutePrecompute << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // lsa-fetch-window
+  ConfigurationVariable<uint32_t> lsaFetchWindow(
+    "lsa-fetch-window", std::bind(&ConfParameter::setLsaFetchWindow, &m_confParam, _1));
+  lsaFetchWindow.setMinAndMaxValue(LSA_FETCH_WINDOW_MIN, LSA_FETCH_WINDOW_MAX);
+  lsaFetchWindow.setOptional(LSA_FETCH_WINDOW_DEFAULT);
+
+  if (!lsaFetchWindow.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsa-fetch-rate
+  ConfigurationVariable<uint32_t> lsaFetchRate(
+    "lsa-fetch-rate", std::bind(&ConfParameter::setLsaFetchRate, &m_confParam, _1));
+  lsaFetchRate.setMinAndMaxValue(LSA_FETCH_RATE_MIN, LSA_FETCH_RATE_MAX);
+  lsaFetchRate.setOptional(LSA_FETCH_RATE_DEFAULT);
+
+  if (!lsaFetchRate.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // adj-lsa-delta
+  std::string adjLsaDelta = section.get<std::string>("adj-lsa-delta", "off");
+  if (boost::iequals(adjLsaDelta, "on")) {
+    m_confParam.setAdjLsaDelta(true);
+  }
+  else if (boost::iequals(adjLsaDelta, "off")) {
+    m_confParam.setAdjLsaDelta(false);
+  }
+  else {
+    std::cerr << "Invalid value for adj-lsa-delta: " << adjLsaDelta << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // name-lsa-compression
+  std::string nameLsaCompression = section.get<std::string>("name-lsa-compression", "off");
+  if (boost::iequals(nameLsaCompression, "on")) {
+    m_confParam.setNameLsaCompression(true);
+  }
+  else if (boost::iequals(nameLsaCompression, "off")) {
+    m_confParam.setNameLsaCompression(false);
+  }
+  else {
+    std::cerr << "Invalid value for name-lsa-compression: " << nameLsaCompression << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // management-thread
+  std::string managementThread = section.get<std::string>("management-thread", "off");
+  if (boost::iequals(managementThread, "on")) {
+    m_confParam.setManagementThread(true);
+  }
+  else if (boost::iequals(managementThread, "off")) {
+    m_confParam.setManagementThread(false);
+  }
+  else {
+    std::cerr << "Invalid value for management-thread: " << managementThread << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // async-logging
+  std::string asyncLogging = section.get<std::string>("async-logging", "off");
+  if (boost::iequals(asyncLogging, "on")) {
+    m_confParam.setAsyncLogging(true);
+  }
+  else if (boost::iequals(asyncLogging, "off")) {
+    m_confParam.setAsyncLogging(false);
+  }
+  else {
+    std::cerr << "Invalid value for async-logging: " << asyncLogging << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // lsa-segment-storage-limit
+  ConfigurationVariable<uint32_t> lsaSegmentStorageLimit(
+    "lsa-segment-storage-limit",
+    std::bind(&ConfParameter::setLsaSegmentStorageLimit, &m_confParam, _1));
+  lsaSegmentStorageLimit.setMinAndMaxValue(LSA_SEGMENT_STORAGE_LIMIT_MIN,
+                                           LSA_SEGMENT_STORAGE_LIMIT_MAX);
+  lsaSegmentStorageLimit.setOptional(LSA_SEGMENT_STORAGE_LIMIT_DEFAULT);
+
+  if (!lsaSegmentStorageLimit.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // name-lsa-build-interval
+  ConfigurationVariable<uint32_t> nameLsaBuildInterval(
+    "name-lsa-build-interval", std::bind(&ConfParameter::setNameLsaBuildInterval, &m_confParam, _1));
+  nameLsaBuildInterval.setMinAndMaxValue(NAME_LSA_BUILD_INTERVAL_MIN, NAME_LSA_BUILD_INTERVAL_MAX);
+  nameLsaBuildInterval.setOptional(NAME_LSA_BUILD_INTERVAL_DEFAULT);
+
+  if (!nameLsaBuildInterval.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // sync-publish-hold-down
+  ConfigurationVariable<uint32_t> syncPublishHoldDown(
+    "sync-publish-hold-down", std::bind(&ConfParameter::setSyncPublishHoldDown, &m_confParam, _1));
+  syncPublishHoldDown.setMinAndMaxValue(SYNC_PUBLISH_HOLD_DOWN_MIN, SYNC_PUBLISH_HOLD_DOWN_MAX);
+  syncPublishHoldDown.setOptional(SYNC_PUBLISH_HOLD_DOWN_DEFAULT);
+
+  if (!syncPublishHoldDown.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // sync-inline-lsa-size
+  ConfigurationVariable<uint32_t> syncInlineLsaSize(
+    "sync-inline-lsa-size", std::bind(&ConfParameter::setSyncInlineLsaSize, &m_confParam, _1));
+  syncInlineLsaSize.setMinAndMaxValue(SYNC_INLINE_LSA_SIZE_MIN, SYNC_INLINE_LSA_SIZE_MAX);
+  syncInlineLsaSize.setOptional(SYNC_INLINE_LSA_SIZE_DEFAULT);
+
+  if (!syncInlineLsaSize.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // sync-expected-routers
+  ConfigurationVariable<uint32_t> syncExpectedRouters(
+    "sync-expected-routers", std::bind(&ConfParameter::setSyncExpectedRouters, &m_confParam, _1));
+  syncExpectedRouters.setMinAndMaxValue(SYNC_EXPECTED_ROUTERS_MIN, SYNC_EXPECTED_ROUTERS_MAX);
+  syncExpectedRouters.setOptional(SYNC_EXPECTED_ROUTERS_DEFAULT);
+
+  if (!syncExpectedRouters.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsa-min-arrival
+  ConfigurationVariable<uint32_t> lsaMinArrival(
+    "lsa-min-arrival", std::bind(&ConfParameter::setLsaMinArrival, &m_confParam, _1));
+  lsaMinArrival.setMinAndMaxValue(LSA_MIN_ARRIVAL_MIN, LSA_MIN_ARRIVAL_MAX);
+  lsaMinArrival.setOptional(LSA_MIN_ARRIVAL_DEFAULT);
+
+  if (!lsaMinArrival.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsa-max-name-prefixes
+  ConfigurationVariable<uint32_t> lsaMaxNamePrefixes(
+    "lsa-max-name-prefixes", std::bind(&ConfParameter::setLsaMaxNamePrefixes, &m_confParam, _1));
+  lsaMaxNamePrefixes.setMinAndMaxValue(LSA_MAX_ENTRIES_MIN, LSA_MAX_ENTRIES_MAX);
+  lsaMaxNamePrefixes.setOptional(LSA_MAX_ENTRIES_DEFAULT);
+
+  if (!lsaMaxNamePrefixes.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsa-max-adjacencies
+  ConfigurationVariable<uint32_t> lsaMaxAdjacencies(
+    "lsa-max-adjacencies", std::bind(&ConfParameter::setLsaMaxAdjacencies, &m_confParam, _1));
+  lsaMaxAdjacencies.setMinAndMaxValue(LSA_MAX_ENTRIES_MIN, LSA_MAX_ENTRIES_MAX);
+  lsaMaxAdjacencies.setOptional(LSA_MAX_ENTRIES_DEFAULT);
+
+  if (!lsaMaxAdjacencies.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsdb-snapshot-interval
+  ConfigurationVariable<uint32_t> lsdbSnapshotInterval(
+    "lsdb-snapshot-interval", std::bind(&ConfParameter::setLsdbSnapshotInterval, &m_confParam, _1));
+  lsdbSnapshotInterval.setMinAndMaxValue(LSDB_SNAPSHOT_INTERVAL_MIN, LSDB_SNAPSHOT_INTERVAL_MAX);
+  lsdbSnapshotInterval.setOptional(LSDB_SNAPSHOT_INTERVAL_DEFAULT);
+
+  if (!lsdbSnapshotInterval.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // lsa-segment-size
+  ConfigurationVariable<uint32_t> lsaSegmentSize(
+    "lsa-segment-size", std::bind(&ConfParameter::setLsaSegmentSize, &m_confParam, _1));
+  lsaSegmentSize.setMinAndMaxValue(LSA_SEGMENT_SIZE_MIN, LSA_SEGMENT_SIZE_MAX);
+  lsaSegmentSize.setOptional(LSA_SEGMENT_SIZE_DEFAULT);
+
+  if (!lsaSegmentSize.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // verification-threads
+  ConfigurationVariable<uint32_t> verificationThreads(
+    "verification-threads", std::bind(&ConfParameter::setVerificationThreads, &m_confParam, _1));
+  verificationThreads.setMinAndMaxValue(VERIFICATION_THREADS_MIN, VERIFICATION_THREADS_MAX);
+  verificationThreads.setOptional(VERIFICATION_THREADS_DEFAULT);
+
+  if (!verificationThreads.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // signing-key-type
+  std::string signingKeyType = section.get<std::string>("signing-key-type", "ecdsa");
+  if (boost::iequals(signingKeyType, "ecdsa")) {
+    m_confParam.setSigningKeyType(SigningKeyType::ECDSA);
+  }
+  else if (boost::iequals(signingKeyType, "rsa")) {
+    m_confParam.setSigningKeyType(SigningKeyType::RSA);
+  }
+  else {
+    std::cerr << "Invalid value for signing-key-type: " << signingKeyType << "\n"
+              << "Valid values are: ecdsa, rsa" << std::endl;
+    return false;
+  }
+
+  // metrics-export-socket
+  m_confParam.setMetricsExportSocketPath(section.get<std::string>("metrics-export-socket", ""));
+
+  // metrics-export-port
+  ConfigurationVariable<uint32_t> metricsExportPort(
+    "metrics-export-port", std::bind(&ConfParameter::setMetricsExportPort, &m_confParam, _1));
+  metricsExportPort.setMinAndMaxValue(METRICS_EXPORT_PORT_MIN, METRICS_EXPORT_PORT_MAX);
+  metricsExportPort.setOptional(METRICS_EXPORT_PORT_DEFAULT);
+
+  if (!metricsExportPort.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // event-stream-socket
+  m_confParam.setEventStreamSocketPath(section.get<std::string>("event-stream-socket", ""));
+
+  // shared-state-export
+  std::string sharedStateExport = section.get<std::string>("shared-state-export", "off");
+  if (boost::iequals(sharedStateExport, "on")) {
+    m_confParam.setSharedStateExport(true);
+  }
+  else if (boost::iequals(sharedStateExport, "off")) {
+    m_confParam.setSharedStateExport(false);
+  }
+  else {
+    std::cerr << "Invalid value for shared-state-export: " << sharedStateExport << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // cert-prefetch
+  std::string certPrefetch = section.get<std::string>("cert-prefetch", "off");
+  if (boost::iequals(certPrefetch, "on")) {
+    m_confParam.setCertPrefetch(true);
+  }
+  else if (boost::iequals(certPrefetch, "off")) {
+    m_confParam.setCertPrefetch(false);
+  }
+  else {
+    std::cerr << "Invalid value for cert-prefetch: " << certPrefetch << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
   return true;
 }
 
@@ -468,6 +788,236 @@ ConfFileProcessor::processConfSectionNeighbors(const ConfigSection& section)
     return false;
   }
 
+  // hello-interval-cap
+  uint32_t intervalCap = section.get<uint32_t>("hello-interval-cap", HELLO_INTERVAL_CAP_DEFAULT);
+
+  if (intervalCap == 0 || (intervalCap >= interval && intervalCap <= HELLO_INTERVAL_CAP_MAX)) {
+    m_confParam.setHelloIntervalCap(intervalCap);
+  }
+  else {
+    std::cerr << "Invalid value for hello-interval-cap. "
+              << "Allowed values: 0 or " << interval << "-" << HELLO_INTERVAL_CAP_MAX << std::endl;
+    return false;
+  }
+
+  // hello-signature-reuse
+  ConfigurationVariable<uint32_t> helloSignatureReuse("hello-signature-reuse",
+                                                      std::bind(&ConfParameter::setHelloSignatureReuse,
+                                                                &m_confParam, _1));
+  helloSignatureReuse.setMinAndMaxValue(HELLO_SIGNATURE_REUSE_MIN, HELLO_SIGNATURE_REUSE_MAX);
+  helloSignatureReuse.setOptional(HELLO_SIGNATURE_REUSE_DEFAULT);
+
+  if (!helloSignatureReuse.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // liveness-interval, liveness-multiplier
+  uint32_t livenessInterval = section.get<uint32_t>("liveness-interval", LIVENESS_INTERVAL_DEFAULT);
+  if (livenessInterval == 0 ||
+      (livenessInterval >= LIVENESS_INTERVAL_MIN && livenessInterval <= LIVENESS_INTERVAL_MAX)) {
+    m_confParam.setLivenessInterval(livenessInterval);
+  }
+  else {
+    std::cerr << "Invalid value for liveness-interval. "
+              << "Allowed values: 0 or " << LIVENESS_INTERVAL_MIN << "-" << LIVENESS_INTERVAL_MAX
+              << std::endl;
+    return false;
+  }
+
+  ConfigurationVariable<uint32_t> livenessMultiplier("liveness-multiplier",
+                                                     std::bind(&ConfParameter::setLivenessMultiplier,
+                                                               &m_confParam, _1));
+  livenessMultiplier.setMinAndMaxValue(LIVENESS_MULTIPLIER_MIN, LIVENESS_MULTIPLIER_MAX);
+  livenessMultiplier.setOptional(LIVENESS_MULTIPLIER_DEFAULT);
+
+  if (!livenessMultiplier.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // rtt-source
+  std::string rttSource = section.get<std::string>("rtt-source", "probe");
+  if (boost::iequals(rttSource, "probe")) {
+    m_confParam.setRttSource(RttSource::PROBE);
+  }
+  else if (boost::iequals(rttSource, "hello")) {
+    m_confParam.setRttSource(RttSource::HELLO);
+  }
+  else if (boost::iequals(rttSource, "hybrid")) {
+    m_confParam.setRttSource(RttSource::HYBRID);
+  }
+  else {
+    std::cerr << "Invalid value for rtt-source: " << rttSource << "\n"
+              << "Valid values are: probe, hello, hybrid" << std::endl;
+    return false;
+  }
+
+  // rtt-probe-interval-min, rtt-probe-interval-max
+  ConfigurationVariable<uint32_t> rttProbeIntervalMin("rtt-probe-interval-min",
+                                                      std::bind(&ConfParameter::setRttProbeIntervalMin,
+                                                                &m_confParam, _1));
+  rttProbeIntervalMin.setMinAndMaxValue(RTT_PROBE_INTERVAL_MIN, RTT_PROBE_INTERVAL_MAX);
+  rttProbeIntervalMin.setOptional(RTT_PROBE_INTERVAL_MIN_DEFAULT);
+
+  ConfigurationVariable<uint32_t> rttProbeIntervalMax("rtt-probe-interval-max",
+                                                      std::bind(&ConfParameter::setRttProbeIntervalMax,
+                                                                &m_confParam, _1));
+  rttProbeIntervalMax.setMinAndMaxValue(RTT_PROBE_INTERVAL_MIN, RTT_PROBE_INTERVAL_MAX);
+  rttProbeIntervalMax.setOptional(RTT_PROBE_INTERVAL_MAX_DEFAULT);
+
+  if (!rttProbeIntervalMin.parseFromConfigSection(section) ||
+      !rttProbeIntervalMax.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  if (m_confParam.getRttProbeIntervalMin() > m_confParam.getRttProbeIntervalMax()) {
+    std::cerr << "Value of rtt-probe-interval-min must not be larger than rtt-probe-interval-max"
+              << std::endl;
+    return false;
+  }
+
+  // cost-update-window
+  ConfigurationVariable<uint32_t> costUpdateWindow("cost-update-window",
+                                                   std::bind(&ConfParameter::setCostUpdateWindow,
+                                                             &m_confParam, _1));
+  costUpdateWindow.setMinAndMaxValue(COST_UPDATE_WINDOW_MIN, COST_UPDATE_WINDOW_MAX);
+  costUpdateWindow.setOptional(COST_UPDATE_WINDOW_DEFAULT);
+
+  if (!costUpdateWindow.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // cost-damping
+  std::string costDamping = section.get<std::string>("cost-damping", "off");
+  if (boost::iequals(costDamping, "on")) {
+    m_confParam.setCostDamping(true);
+  }
+  else if (boost::iequals(costDamping, "off")) {
+    m_confParam.setCostDamping(false);
+  }
+  else {
+    std::cerr << "Invalid value for cost-damping: " << costDamping << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  ConfigurationVariable<uint32_t> costDampingHalfLife("cost-damping-half-life",
+                                                      std::bind(&ConfParameter::setCostDampingHalfLife,
+                                                                &m_confParam, _1));
+  costDampingHalfLife.setMinAndMaxValue(COST_DAMPING_HALF_LIFE_MIN, COST_DAMPING_HALF_LIFE_MAX);
+  costDampingHalfLife.setOptional(COST_DAMPING_HALF_LIFE_DEFAULT);
+
+  ConfigurationVariable<uint32_t> costDampingSuppress("cost-damping-suppress",
+                                                      std::bind(&ConfParameter::setCostDampingSuppress,
+                                                                &m_confParam, _1));
+  costDampingSuppress.setMinAndMaxValue(COST_DAMPING_SUPPRESS_MIN, COST_DAMPING_SUPPRESS_MAX);
+  costDampingSuppress.setOptional(COST_DAMPING_SUPPRESS_DEFAULT);
+
+  ConfigurationVariable<uint32_t> costDampingReuse("cost-damping-reuse",
+                                                   std::bind(&ConfParameter::setCostDampingReuse,
+                                                             &m_confParam, _1));
+  costDampingReuse.setMinAndMaxValue(COST_DAMPING_REUSE_MIN, COST_DAMPING_REUSE_MAX);
+  costDampingReuse.setOptional(COST_DAMPING_REUSE_DEFAULT);
+
+  if (!costDampingHalfLife.parseFromConfigSection(section) ||
+      !costDampingSuppress.parseFromConfigSection(section) ||
+      !costDampingReuse.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  if (m_confParam.getCostDampingReuse() >= m_confParam.getCostDampingSuppress()) {
+    std::cerr << "Value of cost-damping-reuse must be smaller than cost-damping-suppress"
+              << std::endl;
+    return false;
+  }
+
+  // rtt-spike-filter
+  ConfigurationVariable<uint32_t> rttSpikeFilter("rtt-spike-filter",
+                                                 std::bind(&ConfParameter::setRttSpikeFilter,
+                                                           &m_confParam, _1));
+  rttSpikeFilter.setMinAndMaxValue(RTT_SPIKE_FILTER_MIN, RTT_SPIKE_FILTER_MAX);
+  rttSpikeFilter.setOptional(RTT_SPIKE_FILTER_DEFAULT);
+
+  if (!rttSpikeFilter.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  if (m_confParam.getRttSpikeFilter() == 1) {
+    std::cerr << "Value of rtt-spike-filter must be 0 or at least 2" << std::endl;
+    return false;
+  }
+
+  // cost-buckets
+  ConfigurationVariable<uint32_t> costBuckets("cost-buckets",
+                                              std::bind(&ConfParameter::setCostBuckets,
+                                                        &m_confParam, _1));
+  costBuckets.setMinAndMaxValue(COST_BUCKETS_MIN, COST_BUCKETS_MAX);
+  costBuckets.setOptional(COST_BUCKETS_DEFAULT);
+
+  if (!costBuckets.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  if (m_confParam.getCostBuckets() == 1) {
+    std::cerr << "Value of cost-buckets must be 0 or at least 2" << std::endl;
+    return false;
+  }
+
+  // cost-advertise-threshold, cost-advertise-hold
+  ConfigurationVariable<uint32_t> costAdvertiseThreshold("cost-advertise-threshold",
+                                                         std::bind(&ConfParameter::setCostAdvertiseThreshold,
+                                                                   &m_confParam, _1));
+  costAdvertiseThreshold.setMinAndMaxValue(COST_ADVERTISE_THRESHOLD_MIN, COST_ADVERTISE_THRESHOLD_MAX);
+  costAdvertiseThreshold.setOptional(COST_ADVERTISE_THRESHOLD_DEFAULT);
+
+  ConfigurationVariable<uint32_t> costAdvertiseHold("cost-advertise-hold",
+                                                    std::bind(&ConfParameter::setCostAdvertiseHold,
+                                                              &m_confParam, _1));
+  costAdvertiseHold.setMinAndMaxValue(COST_ADVERTISE_HOLD_MIN, COST_ADVERTISE_HOLD_MAX);
+  costAdvertiseHold.setOptional(COST_ADVERTISE_HOLD_DEFAULT);
+
+  if (!costAdvertiseThreshold.parseFromConfigSection(section) ||
+      !costAdvertiseHold.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // cost-metric
+  std::string costMetric = section.get<std::string>("cost-metric", "rtt");
+  if (boost::iequals(costMetric, "rtt")) {
+    m_confParam.setCostMetric(CostMetric::RTT);
+  }
+  else if (boost::iequals(costMetric, "multi-dimensional")) {
+    m_confParam.setCostMetric(CostMetric::MULTI_DIMENSIONAL);
+  }
+  else {
+    std::cerr << "Invalid value for cost-metric: " << costMetric << "\n"
+              << "Valid values are: rtt, multi-dimensional" << std::endl;
+    return false;
+  }
+
+  // metrics-socket
+  m_confParam.setMetricsSocketPath(section.get<std::string>("metrics-socket", ""));
+
+  // link-sample-trace
+  m_confParam.setLinkSampleTracePath(section.get<std::string>("link-sample-trace", ""));
+
+  // face-counter-interval, link-bandwidth
+  ConfigurationVariable<uint32_t> faceCounterInterval("face-counter-interval",
+                                                      std::bind(&ConfParameter::setFaceCounterInterval,
+                                                                &m_confParam, _1));
+  faceCounterInterval.setMinAndMaxValue(FACE_COUNTER_INTERVAL_MIN, FACE_COUNTER_INTERVAL_MAX);
+  faceCounterInterval.setOptional(FACE_COUNTER_INTERVAL_DEFAULT);
+
+  ConfigurationVariable<uint32_t> linkBandwidth("link-bandwidth",
+                                                std::bind(&ConfParameter::setLinkBandwidth,
+                                                          &m_confParam, _1));
+  linkBandwidth.setMinAndMaxValue(LINK_BANDWIDTH_MIN, LINK_BANDWIDTH_MAX);
+  linkBandwidth.setOptional(LINK_BANDWIDTH_DEFAULT);
+
+  if (!faceCounterInterval.parseFromConfigSection(section) ||
+      !linkBandwidth.parseFromConfigSection(section)) {
+    return false;
+  }
+
   // Event intervals
   // adj-lsa-build-interval
   ConfigurationVariable<uint32_t> adjLsaBuildInterval("adj-lsa-build-interval",
@@ -640,6 +1190,153 @@ ConfFileProcessor::processConfSectionFib(const ConfigSection& section)
     return false;
   }
 
+  // routing-calc-throttle
+  std::string routingCalcThrottle = section.get<std::string>("routing-calc-throttle", "off");
+  if (boost::iequals(routingCalcThrottle, "on")) {
+    m_confParam.setRoutingCalcThrottle(true);
+  }
+  else if (boost::iequals(routingCalcThrottle, "off")) {
+    m_confParam.setRoutingCalcThrottle(false);
+  }
+  else {
+    std::cerr << "Invalid value for routing-calc-throttle: " << routingCalcThrottle << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // routing-calc-initial-delay
+  ConfigurationVariable<uint32_t> routingCalcInitialDelay("routing-calc-initial-delay",
+                                                          std::bind(&ConfParameter::setRoutingCalcInitialDelay,
+                                                          &m_confParam, _1));
+  routingCalcInitialDelay.setMinAndMaxValue(ROUTING_CALC_INITIAL_DELAY_MIN,
+                                            ROUTING_CALC_INITIAL_DELAY_MAX);
+  routingCalcInitialDelay.setOptional(ROUTING_CALC_INITIAL_DELAY_DEFAULT);
+
+  if (!routingCalcInitialDelay.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-hold-time
+  ConfigurationVariable<uint32_t> routingCalcHoldTime("routing-calc-hold-time",
+                                                      std::bind(&ConfParameter::setRoutingCalcHoldTime,
+                                                      &m_confParam, _1));
+  routingCalcHoldTime.setMinAndMaxValue(ROUTING_CALC_HOLD_TIME_MIN, ROUTING_CALC_HOLD_TIME_MAX);
+  routingCalcHoldTime.setOptional(ROUTING_CALC_HOLD_TIME_DEFAULT);
+
+  if (!routingCalcHoldTime.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-neighbor-down
+  std::string routingCalcNeighborDown = section.get<std::string>("routing-calc-neighbor-down",
+                                                                 "off");
+  if (boost::iequals(routingCalcNeighborDown, "on")) {
+    m_confParam.setRoutingCalcNeighborDown(true);
+  }
+  else if (boost::iequals(routingCalcNeighborDown, "off")) {
+    m_confParam.setRoutingCalcNeighborDown(false);
+  }
+  else {
+    std::cerr << "Invalid value for routing-calc-neighbor-down: " << routingCalcNeighborDown
+              << "\nValid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // routing-calc-threads
+  ConfigurationVariable<uint32_t> routingCalcThreads("routing-calc-threads",
+                                                     std::bind(&ConfParameter::setRoutingCalcThreads,
+                                                     &m_confParam, _1));
+  routingCalcThreads.setMinAndMaxValue(ROUTING_CALC_THREADS_MIN, ROUTING_CALC_THREADS_MAX);
+  routingCalcThreads.setOptional(ROUTING_CALC_THREADS_DEFAULT);
+
+  if (!routingCalcThreads.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-async
+  std::string routingCalcAsync = section.get<std::string>("routing-calc-async", "off");
+  if (boost::iequals(routingCalcAsync, "on")) {
+    m_confParam.setRoutingCalcAsync(true);
+  }
+  else if (boost::iequals(routingCalcAsync, "off")) {
+    m_confParam.setRoutingCalcAsync(false);
+  }
+  else {
+    std::cerr << "Invalid value for routing-calc-async: " << routingCalcAsync << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // routing-calc-shadow
+  std::string routingCalcShadow = section.get<std::string>("routing-calc-shadow", "off");
+  if (boost::iequals(routingCalcShadow, "on")) {
+    m_confParam.setRoutingCalcShadow(true);
+  }
+  else if (boost::iequals(routingCalcShadow, "off")) {
+    m_confParam.setRoutingCalcShadow(false);
+  }
+  else {
+    std::cerr << "Invalid value for routing-calc-shadow: " << routingCalcShadow << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // loop-free-alternates
+  std::string loopFreeAlternates = section.get<std::string>("loop-free-alternates", "off");
+  if (boost::iequals(loopFreeAlternates, "on")) {
+    m_confParam.setLoopFreeAlternates(true);
+  }
+  else if (boost::iequals(loopFreeAlternates, "off")) {
+    m_confParam.setLoopFreeAlternates(false);
+  }
+  else {
+    std::cerr << "Invalid value for loop-free-alternates: " << loopFreeAlternates << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // disjoint-multipath
+  std::string disjointMultipath = section.get<std::string>("disjoint-multipath", "off");
+  if (boost::iequals(disjointMultipath, "off")) {
+    m_confParam.setDisjointPaths(DisjointPaths::NONE);
+  }
+  else if (boost::iequals(disjointMultipath, "link")) {
+    m_confParam.setDisjointPaths(DisjointPaths::LINK);
+  }
+  else if (boost::iequals(disjointMultipath, "node")) {
+    m_confParam.setDisjointPaths(DisjointPaths::NODE);
+  }
+  else {
+    std::cerr << "Invalid value for disjoint-multipath: " << disjointMultipath << "\n"
+              << "Valid values are: off, link, node" << std::endl;
+    return false;
+  }
+
+  // weighted-multipath
+  std::string weightedMultipath = section.get<std::string>("weighted-multipath", "off");
+  if (boost::iequals(weightedMultipath, "on")) {
+    m_confParam.setWeightedMultipath(true);
+  }
+  else if (boost::iequals(weightedMultipath, "off")) {
+    m_confParam.setWeightedMultipath(false);
+  }
+  else {
+    std::cerr << "Invalid value for weighted-multipath: " << weightedMultipath << "\n"
+              << "Valid values are: on, off" << std::endl;
+    return false;
+  }
+
+  // fib-command-window
+  ConfigurationVariable<uint32_t> fibCommandWindow("fib-command-window",
+                                                   std::bind(&ConfParameter::setFibCommandWindow,
+                                                   &m_confParam, _1));
+  fibCommandWindow.setMinAndMaxValue(FIB_COMMAND_WINDOW_MIN, FIB_COMMAND_WINDOW_MAX);
+  fibCommandWindow.setOptional(FIB_COMMAND_WINDOW_DEFAULT);
+
+  if (!fibCommandWindow.parseFromConfigSection(section)) {
+    return false;
+  }
+
   return true;
 }
 
@@ -663,6 +1360,20 @@ ConfFileProcessor::processConfSectionAdvertising(const ConfigSection& section)
        return false;
      }
     }
+    else if (tn.first == "aggregate") {
+      try {
+        ndn::Name aggregate(tn.second.data());
+        if (aggregate.empty()) {
+          std::cerr << "Wrong command format ! [aggregate /name/prefix] or bad URI" << std::endl;
+          return false;
+        }
+        m_confParam.addAggregatePrefix(aggregate);
+      }
+      catch (const std::exception& ex) {
+        std::cerr << ex.what() << std::endl;
+        return false;
+      }
+    }
   }
   return true;
 }
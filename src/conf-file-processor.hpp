@@ -55,6 +55,16 @@ public:
   bool
   processConfFile();
 
+  /*! \brief Parse the configuration file again, for a reload of a running NLSR.
+   *
+   * Unlike processConfFile, the file is not copied into the state-dir, where the dynamic file
+   * keeps the prefixes advertised at run time.
+   *
+   * \return A boolean for whether configuration was successful.
+   */
+  bool
+  reloadConfFile();
+
 private:
   /*! \brief Parse the configuration file into a tree and process the nodes.
    *
@@ -118,6 +128,8 @@ private:
   std::string m_confFileName;
   /*! m_confParam The ConfFileProcessor object to configure as parsing is done. */
   ConfParameter& m_confParam;
+  /*! m_isReload Whether the file is parsed for a reload. */
+  bool m_isReload = false;
   /*! m_io For canonization of FaceUri. */
   boost::asio::io_context m_io;
 };
@@ -21,12 +21,19 @@
 #include "conf-parameter.hpp"
 #include "logger.hpp"
 
+#include <ndn-cxx/security/key-params.hpp>
 #include <ndn-cxx/security/signing-helpers.hpp>
 
+#include <algorithm>
+
 namespace nlsr {
 
 INIT_LOGGER(ConfParameter);
 
+// leading component of the router names configured as /%C1.Router/<...>
+static const ndn::name::Component ROUTER_TAG_COMPONENT =
+  ndn::name::Component::fromEscapedString("%C1.Router");
+
 static std::unique_ptr<ndn::security::CertificateFetcherDirectFetch>
 makeCertificateFetcher(ndn::Face& face)
 {
@@ -35,12 +42,27 @@ makeCertificateFetcher(ndn::Face& face)
   return fetcher;
 }
 
+std::ostream&
+operator<<(std::ostream& os, DisjointPaths disjointPaths)
+{
+  switch (disjointPaths) {
+    case DisjointPaths::NONE:
+      return os << "off";
+    case DisjointPaths::LINK:
+      return os << "link";
+    case DisjointPaths::NODE:
+      return os << "node";
+  }
+  return os << static_cast<int>(disjointPaths);
+}
+
 ConfParameter::ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
                              const std::string& confFileName)
   : m_confFileName(confFileName)
   , m_lsaRefreshTime(LSA_REFRESH_TIME_DEFAULT)
   , m_adjLsaBuildInterval(ADJ_LSA_BUILD_INTERVAL_DEFAULT)
   , m_routingCalcInterval(ROUTING_CALC_INTERVAL_DEFAULT)
+  , m_routingCalcThreads(ROUTING_CALC_THREADS_DEFAULT)
   , m_faceDatasetFetchInterval(ndn::time::seconds(static_cast<int>(FACE_DATASET_FETCH_INTERVAL_DEFAULT)))
   , m_lsaInterestLifetime(ndn::time::seconds(static_cast<int>(LSA_INTEREST_LIFETIME_DEFAULT)))
   , m_routerDeadInterval(2 * LSA_REFRESH_TIME_DEFAULT)
@@ -53,7 +75,7 @@ ConfParameter::ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
   , m_syncInterestLifetime(ndn::time::milliseconds(SYNC_INTEREST_LIFETIME_DEFAULT))
   , m_adjl()
   , m_npl()
-  , m_validator(makeCertificateFetcher(face))
+  , m_validator(makeCertificateFetcher(face), face.getIoContext())
   , m_prefixUpdateValidator(std::make_unique<ndn::security::CertificateFetcherDirectFetch>(face))
   , m_keyChain(keyChain)
 {
@@ -68,9 +90,44 @@ ConfParameter::writeLog()
   NLSR_LOG_INFO("Router Prefix: " << m_routerPrefix);
   NLSR_LOG_INFO("Sync Prefix: " << m_syncPrefix);
   NLSR_LOG_INFO("Sync LSA prefix: " << m_lsaPrefix);
+  if (m_areaDepth > 0) {
+    NLSR_LOG_INFO("Area: " << getArea() << ", depth " << m_areaDepth);
+    if (!m_backboneArea.empty()) {
+      NLSR_LOG_INFO("Backbone area: " << m_backboneArea);
+    }
+  }
   NLSR_LOG_INFO("Hello Interest retry number: " << m_interestRetryNumber);
   NLSR_LOG_INFO("Hello Interest resend second: " << m_interestResendTime);
   NLSR_LOG_INFO("Info Interest interval: " << m_infoInterestInterval);
+  NLSR_LOG_INFO("Hello interval cap: " << m_helloIntervalCap);
+  NLSR_LOG_INFO("Hello signature reuse: " << m_helloSignatureReuse);
+  NLSR_LOG_INFO("Liveness interval: " << m_livenessInterval << ", multiplier: "
+                << m_livenessMultiplier);
+  NLSR_LOG_INFO("RTT source: " << (m_rttSource == RttSource::PROBE ? "probe" :
+                                   m_rttSource == RttSource::HELLO ? "hello" : "hybrid"));
+  NLSR_LOG_INFO("RTT probe interval (ms): " << m_rttProbeIntervalMin << "-" << m_rttProbeIntervalMax);
+  NLSR_LOG_INFO("Cost metric: " << (m_costMetric == CostMetric::RTT ? "rtt" : "multi-dimensional"));
+  NLSR_LOG_INFO("Cost update window (ms): " << m_costUpdateWindow);
+  NLSR_LOG_INFO("Cost damping: " << (m_costDamping ? "on" : "off"));
+  if (m_costDamping) {
+    NLSR_LOG_INFO("Cost damping half-life (s): " << m_costDampingHalfLife);
+    NLSR_LOG_INFO("Cost damping suppress/reuse thresholds: " << m_costDampingSuppress
+                  << "/" << m_costDampingReuse);
+  }
+  NLSR_LOG_INFO("RTT spike filter: " << m_rttSpikeFilter);
+  NLSR_LOG_INFO("Cost buckets: " << m_costBuckets);
+  NLSR_LOG_INFO("Cost advertise threshold (%): " << m_costAdvertiseThreshold);
+  NLSR_LOG_INFO("Cost advertise hold (s): " << m_costAdvertiseHold);
+  if (!m_metricsSocketPath.empty()) {
+    NLSR_LOG_INFO("External metrics socket: " << m_metricsSocketPath);
+  }
+  if (!m_linkSampleTracePath.empty()) {
+    NLSR_LOG_INFO("Link sample trace: " << m_linkSampleTracePath);
+  }
+  if (m_faceCounterInterval > 0) {
+    NLSR_LOG_INFO("Face counter interval (s): " << m_faceCounterInterval);
+    NLSR_LOG_INFO("Link bandwidth (Mbps): " << m_linkBandwidth);
+  }
   NLSR_LOG_INFO("LSA refresh time: " << m_lsaRefreshTime);
   NLSR_LOG_INFO("FIB Entry refresh time: " << m_lsaRefreshTime * 2);
   NLSR_LOG_INFO("LSA Interest lifetime: " << getLsaInterestLifetime());
@@ -85,15 +142,46 @@ ConfParameter::writeLog()
     }
   }
   NLSR_LOG_INFO("State Directory: " << m_stateFileDir);
+  NLSR_LOG_INFO("LSA fetch window: " << m_lsaFetchWindow);
+  NLSR_LOG_INFO("LSA fetch rate (per second): " << m_lsaFetchRate);
+  NLSR_LOG_INFO("Adjacency LSA deltas: " << (m_adjLsaDelta ? "on" : "off"));
+  NLSR_LOG_INFO("Name LSA compression: " << (m_nameLsaCompression ? "on" : "off"));
+  NLSR_LOG_INFO("LSA segment storage limit: " << m_lsaSegmentStorageLimit << " KB");
+  NLSR_LOG_INFO("Name LSA build interval: " << m_nameLsaBuildInterval);
+  NLSR_LOG_INFO("Sync publish hold-down: " << m_syncPublishHoldDown);
+  NLSR_LOG_INFO("Sync inline LSA size: " << m_syncInlineLsaSize << " bytes");
+  NLSR_LOG_INFO("Sync expected routers: " << m_syncExpectedRouters);
+  NLSR_LOG_INFO("LSDB snapshot interval: " << m_lsdbSnapshotInterval);
+  NLSR_LOG_INFO("Signature verification threads: " << m_verificationThreads);
+  NLSR_LOG_INFO("Signing key type: " <<
+                (m_signingKeyType == SigningKeyType::ECDSA ? "ecdsa" : "rsa"));
+  if (!m_metricsExportSocketPath.empty()) {
+    NLSR_LOG_INFO("Metrics export socket: " << m_metricsExportSocketPath);
+  }
+  if (m_metricsExportPort != 0) {
+    NLSR_LOG_INFO("Metrics export port: " << m_metricsExportPort);
+  }
 
   // Event Intervals
   NLSR_LOG_INFO("Adjacency LSA build interval:  " << m_adjLsaBuildInterval);
   NLSR_LOG_INFO("Routing calculation interval:  " << m_routingCalcInterval);
+  if (m_routingCalcThrottle) {
+    NLSR_LOG_INFO("Routing calculation initial delay (ms):  " << m_routingCalcInitialDelay);
+    NLSR_LOG_INFO("Routing calculation hold time (ms):  " << m_routingCalcHoldTime);
+  }
+  NLSR_LOG_INFO("Routing calculation threads:  " << m_routingCalcThreads);
+  NLSR_LOG_INFO("Asynchronous routing calculation:  " << (m_routingCalcAsync ? "on" : "off"));
+  NLSR_LOG_INFO("Loop-free alternates:  " << (m_loopFreeAlternates ? "on" : "off"));
+  NLSR_LOG_INFO("Disjoint multipath:  " << m_disjointPaths);
+  NLSR_LOG_INFO("Weighted multipath:  " << (m_weightedMultipath ? "on" : "off"));
+  NLSR_LOG_INFO("FIB command window: " << m_fibCommandWindow);
 
   // ✅ 添加这一行：
   NLSR_LOG_INFO("Load-aware routing: " << (m_loadAwareRouting ? "enabled" : "disabled"));
   // ✅ 添加这一行：关于机器学习负载
   NLSR_LOG_INFO("ML-adaptive routing: " << (m_mlAdaptiveRouting ? "enabled" : "disabled"));
+  NLSR_LOG_INFO("ML weekly patterns: " << (m_mlWeeklyPatterns ? "on" : "off"));
+  NLSR_LOG_INFO("ML route precomputation: " << (m_mlRoutePrecompute ? "on" : "off"));
 }
 
 void
@@ -115,6 +203,42 @@ ConfParameter::setNetwork(const ndn::Name& networkName)
   m_lsaPrefix.append("LSA");
 }
 
+ndn::Name
+ConfParameter::getAreaOf(const ndn::Name& router) const
+{
+  if (m_areaDepth == 0) {
+    return {};
+  }
+  // the site of a router name ends where its router name begins
+  size_t areaSize = m_network.size() + m_areaDepth;
+  for (size_t i = m_network.size(); i < router.size() && i < areaSize; ++i) {
+    if (router[i] == ROUTER_TAG_COMPONENT) {
+      areaSize = i;
+    }
+  }
+  return router.getPrefix(std::min(areaSize, router.size()));
+}
+
+std::set<ndn::Name>
+ConfParameter::getAreas() const
+{
+  std::set<ndn::Name> areas;
+  if (m_areaDepth == 0) {
+    return areas;
+  }
+  areas.insert(getArea());
+  for (const auto& adjacent : m_adjl.getAdjList()) {
+    areas.insert(getAreaOf(adjacent.getName()));
+  }
+  return areas;
+}
+
+ndn::Name
+ConfParameter::getAreaSyncPrefix(const ndn::Name& area) const
+{
+  return ndn::Name(m_syncPrefix).append(area.getSubName(m_network.size()));
+}
+
 void
 ConfParameter::loadCertToValidator(const ndn::security::Certificate& cert)
 {
@@ -162,7 +286,15 @@ ConfParameter::initializeKey()
     return std::nullopt;
   }
 
-  auto key = m_keyChain.createIdentity(instanceName).getDefaultKey();
+  // not left to the KeyChain default, as the instance key signs every LSA segment
+  std::unique_ptr<KeyParams> keyParams;
+  if (m_signingKeyType == SigningKeyType::ECDSA) {
+    keyParams = std::make_unique<EcKeyParams>();
+  }
+  else {
+    keyParams = std::make_unique<RsaKeyParams>();
+  }
+  auto key = m_keyChain.createIdentity(instanceName, *keyParams).getDefaultKey();
   auto cert = m_keyChain.makeCertificate(key, signingByIdentity(routerIdentity));
   m_keyChain.setDefaultCertificate(key, cert);
 
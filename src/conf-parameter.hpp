@@ -26,12 +26,15 @@
 #include "test-access-control.hpp"
 #include "adjacency-list.hpp"
 #include "name-prefix-list.hpp"
+#include "security/caching-validator.hpp"
 
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/security/validator-config.hpp>
 #include <ndn-cxx/security/certificate-fetcher-direct-fetch.hpp>
 
 #include <optional>
+#include <set>
+#include <vector>
 //nlsr.conf默认参数值配置
 namespace nlsr {
 
@@ -41,6 +44,39 @@ enum class SyncProtocol {
   SVS,
 };
 
+/*! \brief Source of the RTT samples used for dynamic link costs.
+ */
+enum class RttSource {
+  PROBE,  ///< dedicated RTT probes only
+  HELLO,  ///< Hello Interest/Data round trips only
+  HYBRID, ///< Hello round trips, plus probes when no recent sample exists
+};
+
+/*! \brief Metric from which dynamic link costs are computed.
+ */
+enum class CostMetric {
+  RTT,               ///< smoothed RTT only
+  MULTI_DIMENSIONAL, ///< weighted RTT, bandwidth utilization, packet loss and spectrum strength
+};
+
+/*! \brief What the multipath next hops of a destination may not share.
+ */
+enum class DisjointPaths {
+  NONE, ///< every neighbor with a path is a next hop
+  LINK, ///< next hops whose paths share a link are left as alternates
+  NODE, ///< next hops whose paths share a router other than the destination are left as alternates
+};
+
+std::ostream&
+operator<<(std::ostream& os, DisjointPaths disjointPaths);
+
+/*! \brief Type of the instance key that signs our LSAs, hello replies and other routing data.
+ */
+enum class SigningKeyType {
+  ECDSA, ///< ECDSA with the P-256 curve
+  RSA,   ///< 2048-bit RSA, several times slower to sign with
+};
+
 enum {
   LSA_REFRESH_TIME_MIN = 240,
   LSA_REFRESH_TIME_DEFAULT = 1800,
@@ -65,6 +101,30 @@ enum {
   ROUTING_CALC_INTERVAL_MAX = 15
 };
 
+enum {
+  ROUTING_CALC_INITIAL_DELAY_MIN = 0,
+  ROUTING_CALC_INITIAL_DELAY_DEFAULT = 50,
+  ROUTING_CALC_INITIAL_DELAY_MAX = 15000
+};
+
+enum {
+  ROUTING_CALC_HOLD_TIME_MIN = 0,
+  ROUTING_CALC_HOLD_TIME_DEFAULT = 200,
+  ROUTING_CALC_HOLD_TIME_MAX = 15000
+};
+
+enum {
+  FIB_COMMAND_WINDOW_MIN = 0,
+  FIB_COMMAND_WINDOW_DEFAULT = 0,
+  FIB_COMMAND_WINDOW_MAX = 10000
+};
+
+enum {
+  ROUTING_CALC_THREADS_MIN = 1,
+  ROUTING_CALC_THREADS_DEFAULT = 1,
+  ROUTING_CALC_THREADS_MAX = 64
+};
+
 
 enum {
   FACE_DATASET_FETCH_TRIES_MIN = 1,
@@ -96,6 +156,97 @@ enum {
   HELLO_INTERVAL_MAX =90
 };
 
+enum {
+  HELLO_INTERVAL_CAP_MIN = 0,
+  HELLO_INTERVAL_CAP_DEFAULT = 0,
+  HELLO_INTERVAL_CAP_MAX = 3600
+};
+
+enum {
+  HELLO_SIGNATURE_REUSE_MIN = 0,
+  HELLO_SIGNATURE_REUSE_DEFAULT = 0,
+  HELLO_SIGNATURE_REUSE_MAX = 3600
+};
+
+enum {
+  LIVENESS_INTERVAL_MIN = 50,
+  LIVENESS_INTERVAL_DEFAULT = 0,
+  LIVENESS_INTERVAL_MAX = 10000
+};
+
+enum {
+  LIVENESS_MULTIPLIER_MIN = 2,
+  LIVENESS_MULTIPLIER_DEFAULT = 3,
+  LIVENESS_MULTIPLIER_MAX = 20
+};
+
+enum {
+  RTT_PROBE_INTERVAL_MIN = 100,
+  RTT_PROBE_INTERVAL_MIN_DEFAULT = 500,
+  RTT_PROBE_INTERVAL_MAX_DEFAULT = 30000,
+  RTT_PROBE_INTERVAL_MAX = 300000
+};
+
+enum {
+  COST_UPDATE_WINDOW_MIN = 0,
+  COST_UPDATE_WINDOW_DEFAULT = 1000,
+  COST_UPDATE_WINDOW_MAX = 60000
+};
+
+enum {
+  COST_DAMPING_HALF_LIFE_MIN = 1,
+  COST_DAMPING_HALF_LIFE_DEFAULT = 60,
+  COST_DAMPING_HALF_LIFE_MAX = 3600
+};
+
+enum {
+  COST_DAMPING_SUPPRESS_MIN = 1000,
+  COST_DAMPING_SUPPRESS_DEFAULT = 3000,
+  COST_DAMPING_SUPPRESS_MAX = 20000
+};
+
+enum {
+  COST_DAMPING_REUSE_MIN = 100,
+  COST_DAMPING_REUSE_DEFAULT = 750,
+  COST_DAMPING_REUSE_MAX = 20000
+};
+
+enum {
+  RTT_SPIKE_FILTER_MIN = 0,
+  RTT_SPIKE_FILTER_DEFAULT = 0,
+  RTT_SPIKE_FILTER_MAX = 8
+};
+
+enum {
+  COST_BUCKETS_MIN = 0,
+  COST_BUCKETS_DEFAULT = 0,
+  COST_BUCKETS_MAX = 64
+};
+
+enum {
+  COST_ADVERTISE_THRESHOLD_MIN = 0,
+  COST_ADVERTISE_THRESHOLD_DEFAULT = 0,
+  COST_ADVERTISE_THRESHOLD_MAX = 1000
+};
+
+enum {
+  COST_ADVERTISE_HOLD_MIN = 0,
+  COST_ADVERTISE_HOLD_DEFAULT = 30,
+  COST_ADVERTISE_HOLD_MAX = 3600
+};
+
+enum {
+  FACE_COUNTER_INTERVAL_MIN = 0,
+  FACE_COUNTER_INTERVAL_DEFAULT = 0,
+  FACE_COUNTER_INTERVAL_MAX = 3600
+};
+
+enum {
+  LINK_BANDWIDTH_MIN = 0,
+  LINK_BANDWIDTH_DEFAULT = 0,
+  LINK_BANDWIDTH_MAX = 1000000
+};
+
 enum {
   MAX_FACES_PER_PREFIX_MIN = 0,
   MAX_FACES_PER_PREFIX_DEFAULT = 0,
@@ -115,6 +266,86 @@ enum {
   SYNC_INTEREST_LIFETIME_MAX = 120000,
 };
 
+enum {
+  LSA_FETCH_WINDOW_MIN = 0,
+  LSA_FETCH_WINDOW_DEFAULT = 16,
+  LSA_FETCH_WINDOW_MAX = 1024
+};
+
+enum {
+  LSA_FETCH_RATE_MIN = 0,
+  LSA_FETCH_RATE_DEFAULT = 0,
+  LSA_FETCH_RATE_MAX = 10000
+};
+
+enum {
+  LSA_SEGMENT_STORAGE_LIMIT_MIN = 0,
+  LSA_SEGMENT_STORAGE_LIMIT_DEFAULT = 16384,
+  LSA_SEGMENT_STORAGE_LIMIT_MAX = 4194304
+};
+
+enum {
+  NAME_LSA_BUILD_INTERVAL_MIN = 0,
+  NAME_LSA_BUILD_INTERVAL_DEFAULT = 50,
+  NAME_LSA_BUILD_INTERVAL_MAX = 10000
+};
+
+enum {
+  SYNC_PUBLISH_HOLD_DOWN_MIN = 0,
+  SYNC_PUBLISH_HOLD_DOWN_DEFAULT = 0,
+  SYNC_PUBLISH_HOLD_DOWN_MAX = 10000
+};
+
+enum {
+  SYNC_INLINE_LSA_SIZE_MIN = 0,
+  SYNC_INLINE_LSA_SIZE_DEFAULT = 0,
+  SYNC_INLINE_LSA_SIZE_MAX = 4096
+};
+
+enum {
+  SYNC_EXPECTED_ROUTERS_MIN = 0,
+  SYNC_EXPECTED_ROUTERS_DEFAULT = 0,
+  SYNC_EXPECTED_ROUTERS_MAX = 100000
+};
+
+enum {
+  LSA_MIN_ARRIVAL_MIN = 0,
+  LSA_MIN_ARRIVAL_DEFAULT = 0,
+  LSA_MIN_ARRIVAL_MAX = 60000
+};
+
+enum {
+  LSA_MAX_ENTRIES_MIN = 0,
+  LSA_MAX_ENTRIES_DEFAULT = 0,
+  LSA_MAX_ENTRIES_MAX = 1000000
+};
+
+enum {
+  LSDB_SNAPSHOT_INTERVAL_MIN = 0,
+  LSDB_SNAPSHOT_INTERVAL_DEFAULT = 0,
+  LSDB_SNAPSHOT_INTERVAL_MAX = 86400
+};
+
+enum {
+  LSA_SEGMENT_SIZE_MIN = 1000,
+  // half of ndn::MAX_NDN_PACKET_SIZE
+  LSA_SEGMENT_SIZE_DEFAULT = 4400,
+  // leaves room for the name and the signature of the segment
+  LSA_SEGMENT_SIZE_MAX = 8000
+};
+
+enum {
+  VERIFICATION_THREADS_MIN = 0,
+  VERIFICATION_THREADS_DEFAULT = 0,
+  VERIFICATION_THREADS_MAX = 64
+};
+
+enum {
+  METRICS_EXPORT_PORT_MIN = 0,
+  METRICS_EXPORT_PORT_DEFAULT = 0,
+  METRICS_EXPORT_PORT_MAX = 65535
+};
+
 /*! \brief A class to house all the configuration parameters for NLSR.
  *
  * This class is conceptually a singleton (but not mechanically) which
@@ -207,6 +438,63 @@ public:
     return m_lsaPrefix;
   }
 
+  /*! \brief Set the number of leading components of the site names that name the routing areas;
+   *         0 to route over a single area.
+   *
+   * The area of a router is the network name followed by that many components of its site,
+   * e.g. /ndn/edu for the router /ndn/edu/memphis/%C1.Router/cs/pollux at depth 1. A router
+   * with neighbors in other areas is an area border router.
+   */
+  void
+  setAreaDepth(uint32_t depth)
+  {
+    m_areaDepth = depth;
+  }
+
+  uint32_t
+  getAreaDepth() const
+  {
+    return m_areaDepth;
+  }
+
+  /*! \brief Set the area through which the area border routers pass on the routes between the
+   *         other areas; empty for none.
+   */
+  void
+  setBackboneArea(const ndn::Name& area)
+  {
+    m_backboneArea = area;
+  }
+
+  const ndn::Name&
+  getBackboneArea() const
+  {
+    return m_backboneArea;
+  }
+
+  /*! \brief Return the area of \p router , or an empty name when areas are not used.
+   */
+  ndn::Name
+  getAreaOf(const ndn::Name& router) const;
+
+  /*! \brief Return the area of this router, or an empty name when areas are not used.
+   */
+  ndn::Name
+  getArea() const
+  {
+    return getAreaOf(m_routerPrefix);
+  }
+
+  /*! \brief Return the areas this router belongs to: its own and those of its neighbors.
+   */
+  std::set<ndn::Name>
+  getAreas() const;
+
+  /*! \brief Return the prefix of the sync group of \p area ; the sync prefix for no area.
+   */
+  ndn::Name
+  getAreaSyncPrefix(const ndn::Name& area) const;
+
   void
   setLsaRefreshTime(uint32_t lrt)
   {
@@ -268,191 +556,604 @@ public:
   }
 
   void
-  setRouterDeadInterval(uint32_t rdt)
+  setRoutingCalcThrottle(bool enable)
   {
-    m_routerDeadInterval = rdt;
+    m_routingCalcThrottle = enable;
   }
 
-  uint32_t
-  getRouterDeadInterval() const
+  bool
+  getRoutingCalcThrottle() const
   {
-    return m_routerDeadInterval;
+    return m_routingCalcThrottle;
   }
 
   void
-  setFaceDatasetFetchTries(uint32_t count)
+  setRoutingCalcInitialDelay(uint32_t delay)
   {
-    m_faceDatasetFetchTries = count;
+    m_routingCalcInitialDelay = delay;
   }
 
   uint32_t
-  getFaceDatasetFetchTries() const
+  getRoutingCalcInitialDelay() const
   {
-    return m_faceDatasetFetchTries;
+    return m_routingCalcInitialDelay;
   }
 
   void
-  setFaceDatasetFetchInterval(uint32_t interval)
+  setRoutingCalcHoldTime(uint32_t holdTime)
   {
-    m_faceDatasetFetchInterval = ndn::time::seconds(interval);
+    m_routingCalcHoldTime = holdTime;
   }
 
-  const ndn::time::seconds
-  getFaceDatasetFetchInterval() const
+  uint32_t
+  getRoutingCalcHoldTime() const
   {
-    return m_faceDatasetFetchInterval;
+    return m_routingCalcHoldTime;
   }
 
+  /*! \brief Set whether the routes are recalculated at once without the links to a neighbor
+   *         declared INACTIVE, before our new Adjacency LSA is built.
+   */
   void
-  setInterestRetryNumber(uint32_t irn)
+  setRoutingCalcNeighborDown(bool enable)
   {
-    m_interestRetryNumber = irn;
+    m_routingCalcNeighborDown = enable;
   }
 
-  uint32_t
-  getInterestRetryNumber() const
+  bool
+  getRoutingCalcNeighborDown() const
   {
-    return m_interestRetryNumber;
+    return m_routingCalcNeighborDown;
   }
 
   void
-  setInterestResendTime(uint32_t irt)
+  setFibCommandWindow(uint32_t window)
   {
-    m_interestResendTime = irt;
+    m_fibCommandWindow = window;
   }
 
   uint32_t
-  getInterestResendTime() const
+  getFibCommandWindow() const
   {
-    return m_interestResendTime;
+    return m_fibCommandWindow;
   }
 
-  uint32_t
-  getInfoInterestInterval() const
+  void
+  setRoutingCalcAsync(bool enable)
   {
-    return m_infoInterestInterval;
+    m_routingCalcAsync = enable;
   }
 
-  void
-  setInfoInterestInterval(uint32_t iii)
+  bool
+  getRoutingCalcAsync() const
   {
-    m_infoInterestInterval = iii;
+    return m_routingCalcAsync;
   }
 
+  /*! \brief Set whether the routes of the calculators not in use are calculated after each
+   *         calculation, to be compared with the live routes.
+   */
   void
-  setHyperbolicState(HyperbolicState ihc)
+  setRoutingCalcShadow(bool enable)
   {
-    m_hyperbolicState = ihc;
+    m_routingCalcShadow = enable;
   }
 
-  HyperbolicState
-  getHyperbolicState() const
+  bool
+  getRoutingCalcShadow() const
   {
-    return m_hyperbolicState;
+    return m_routingCalcShadow;
   }
 
-  bool
-  setCorR(double cr)
+  void
+  setRoutingCalcThreads(uint32_t nThreads)
   {
-    if ( cr >= 0 ) {
-     m_corR = cr;
-     return true;
-    }
-    return false;
+    m_routingCalcThreads = nThreads;
   }
 
-  double
-  getCorR() const
+  uint32_t
+  getRoutingCalcThreads() const
   {
-    return m_corR;
+    return m_routingCalcThreads;
   }
 
   void
-  setCorTheta(const std::vector<double>& ct)
+  setLoopFreeAlternates(bool enable)
   {
-    m_corTheta = ct;
+    m_loopFreeAlternates = enable;
   }
 
-  std::vector<double>
-  getCorTheta() const
+  bool
+  getLoopFreeAlternates() const
   {
-    return m_corTheta;
+    return m_loopFreeAlternates;
   }
 
   void
-  setMaxFacesPerPrefix(uint32_t mfpp)
+  setDisjointPaths(DisjointPaths disjointPaths)
   {
-    m_maxFacesPerPrefix = mfpp;
+    m_disjointPaths = disjointPaths;
   }
 
-  uint32_t
-  getMaxFacesPerPrefix() const
+  DisjointPaths
+  getDisjointPaths() const
   {
-    return m_maxFacesPerPrefix;
+    return m_disjointPaths;
   }
 
   void
-  setStateFileDir(const std::string& ssfd)
+  setWeightedMultipath(bool enable)
   {
-    m_stateFileDir = ssfd;
+    m_weightedMultipath = enable;
   }
 
-  const std::string&
-  getStateFileDir() const
+  bool
+  getWeightedMultipath() const
   {
-    return m_stateFileDir;
+    return m_weightedMultipath;
   }
 
   void
-  setConfFileNameDynamic(const std::string& confFileDynamic)
+  setRouterDeadInterval(uint32_t rdt)
   {
-    m_confFileNameDynamic = confFileDynamic;
+    m_routerDeadInterval = rdt;
   }
 
-  const std::string&
-  getConfFileNameDynamic() const
+  uint32_t
+  getRouterDeadInterval() const
   {
-    return m_confFileNameDynamic;
+    return m_routerDeadInterval;
   }
 
   void
-  setSyncInterestLifetime(uint32_t syncInterestLifetime)
+  setFaceDatasetFetchTries(uint32_t count)
   {
-    m_syncInterestLifetime = ndn::time::milliseconds(syncInterestLifetime);
+    m_faceDatasetFetchTries = count;
   }
 
-  const ndn::time::milliseconds&
-  getSyncInterestLifetime() const
+  uint32_t
+  getFaceDatasetFetchTries() const
   {
-    return m_syncInterestLifetime;
+    return m_faceDatasetFetchTries;
   }
 
-  AdjacencyList&
-  getAdjacencyList()
+  void
+  setFaceDatasetFetchInterval(uint32_t interval)
   {
-    return m_adjl;
+    m_faceDatasetFetchInterval = ndn::time::seconds(interval);
   }
 
-  NamePrefixList&
-  getNamePrefixList()
+  const ndn::time::seconds
+  getFaceDatasetFetchInterval() const
   {
-    return m_npl;
+    return m_faceDatasetFetchInterval;
   }
 
-  ndn::security::ValidatorConfig&
-  getValidator()
+  void
+  setInterestRetryNumber(uint32_t irn)
   {
-    return m_validator;
+    m_interestRetryNumber = irn;
   }
 
-  ndn::security::ValidatorConfig&
-  getPrefixUpdateValidator()
+  uint32_t
+  getInterestRetryNumber() const
   {
-    return m_prefixUpdateValidator;
+    return m_interestRetryNumber;
   }
 
-  const ndn::security::SigningInfo&
-  getSigningInfo() const
+  void
+  setInterestResendTime(uint32_t irt)
+  {
+    m_interestResendTime = irt;
+  }
+
+  uint32_t
+  getInterestResendTime() const
+  {
+    return m_interestResendTime;
+  }
+
+  uint32_t
+  getInfoInterestInterval() const
+  {
+    return m_infoInterestInterval;
+  }
+
+  void
+  setInfoInterestInterval(uint32_t iii)
+  {
+    m_infoInterestInterval = iii;
+  }
+
+  /*! \brief Sets the longest Hello interval that stable adjacencies back off to.
+   *
+   * 0 keeps every adjacency at hello-interval.
+   */
+  void
+  setHelloIntervalCap(uint32_t cap)
+  {
+    m_helloIntervalCap = cap;
+  }
+
+  uint32_t
+  getHelloIntervalCap() const
+  {
+    return m_helloIntervalCap;
+  }
+
+  void
+  setRttSource(RttSource source)
+  {
+    m_rttSource = source;
+  }
+
+  RttSource
+  getRttSource() const
+  {
+    return m_rttSource;
+  }
+
+  void
+  setCostMetric(CostMetric metric)
+  {
+    m_costMetric = metric;
+  }
+
+  CostMetric
+  getCostMetric() const
+  {
+    return m_costMetric;
+  }
+
+  void
+  setHelloSignatureReuse(uint32_t reuse)
+  {
+    m_helloSignatureReuse = ndn::time::seconds(reuse);
+  }
+
+  const ndn::time::seconds&
+  getHelloSignatureReuse() const
+  {
+    return m_helloSignatureReuse;
+  }
+
+  void
+  setLivenessInterval(uint32_t interval)
+  {
+    m_livenessInterval = ndn::time::milliseconds(interval);
+  }
+
+  const ndn::time::milliseconds&
+  getLivenessInterval() const
+  {
+    return m_livenessInterval;
+  }
+
+  void
+  setLivenessMultiplier(uint32_t multiplier)
+  {
+    m_livenessMultiplier = multiplier;
+  }
+
+  uint32_t
+  getLivenessMultiplier() const
+  {
+    return m_livenessMultiplier;
+  }
+
+  void
+  setRttProbeIntervalMin(uint32_t interval)
+  {
+    m_rttProbeIntervalMin = interval;
+  }
+
+  uint32_t
+  getRttProbeIntervalMin() const
+  {
+    return m_rttProbeIntervalMin;
+  }
+
+  void
+  setRttProbeIntervalMax(uint32_t interval)
+  {
+    m_rttProbeIntervalMax = interval;
+  }
+
+  uint32_t
+  getRttProbeIntervalMax() const
+  {
+    return m_rttProbeIntervalMax;
+  }
+
+  void
+  setCostUpdateWindow(uint32_t window)
+  {
+    m_costUpdateWindow = window;
+  }
+
+  uint32_t
+  getCostUpdateWindow() const
+  {
+    return m_costUpdateWindow;
+  }
+
+  void
+  setCostDamping(bool enable)
+  {
+    m_costDamping = enable;
+  }
+
+  bool
+  getCostDamping() const
+  {
+    return m_costDamping;
+  }
+
+  void
+  setCostDampingHalfLife(uint32_t halfLife)
+  {
+    m_costDampingHalfLife = halfLife;
+  }
+
+  uint32_t
+  getCostDampingHalfLife() const
+  {
+    return m_costDampingHalfLife;
+  }
+
+  void
+  setCostDampingSuppress(uint32_t threshold)
+  {
+    m_costDampingSuppress = threshold;
+  }
+
+  uint32_t
+  getCostDampingSuppress() const
+  {
+    return m_costDampingSuppress;
+  }
+
+  void
+  setCostDampingReuse(uint32_t threshold)
+  {
+    m_costDampingReuse = threshold;
+  }
+
+  uint32_t
+  getCostDampingReuse() const
+  {
+    return m_costDampingReuse;
+  }
+
+  void
+  setRttSpikeFilter(uint32_t shiftSamples)
+  {
+    m_rttSpikeFilter = shiftSamples;
+  }
+
+  uint32_t
+  getRttSpikeFilter() const
+  {
+    return m_rttSpikeFilter;
+  }
+
+  void
+  setCostBuckets(uint32_t nBuckets)
+  {
+    m_costBuckets = nBuckets;
+  }
+
+  uint32_t
+  getCostBuckets() const
+  {
+    return m_costBuckets;
+  }
+
+  void
+  setCostAdvertiseThreshold(uint32_t percent)
+  {
+    m_costAdvertiseThreshold = percent;
+  }
+
+  uint32_t
+  getCostAdvertiseThreshold() const
+  {
+    return m_costAdvertiseThreshold;
+  }
+
+  void
+  setCostAdvertiseHold(uint32_t seconds)
+  {
+    m_costAdvertiseHold = seconds;
+  }
+
+  uint32_t
+  getCostAdvertiseHold() const
+  {
+    return m_costAdvertiseHold;
+  }
+
+  void
+  setMetricsSocketPath(const std::string& path)
+  {
+    m_metricsSocketPath = path;
+  }
+
+  const std::string&
+  getMetricsSocketPath() const
+  {
+    return m_metricsSocketPath;
+  }
+
+  void
+  setLinkSampleTracePath(const std::string& path)
+  {
+    m_linkSampleTracePath = path;
+  }
+
+  const std::string&
+  getLinkSampleTracePath() const
+  {
+    return m_linkSampleTracePath;
+  }
+
+  void
+  setFaceCounterInterval(uint32_t seconds)
+  {
+    m_faceCounterInterval = seconds;
+  }
+
+  uint32_t
+  getFaceCounterInterval() const
+  {
+    return m_faceCounterInterval;
+  }
+
+  void
+  setLinkBandwidth(uint32_t mbps)
+  {
+    m_linkBandwidth = mbps;
+  }
+
+  uint32_t
+  getLinkBandwidth() const
+  {
+    return m_linkBandwidth;
+  }
+
+  void
+  setHyperbolicState(HyperbolicState ihc)
+  {
+    m_hyperbolicState = ihc;
+  }
+
+  HyperbolicState
+  getHyperbolicState() const
+  {
+    return m_hyperbolicState;
+  }
+
+  bool
+  setCorR(double cr)
+  {
+    if ( cr >= 0 ) {
+     m_corR = cr;
+     return true;
+    }
+    return false;
+  }
+
+  double
+  getCorR() const
+  {
+    return m_corR;
+  }
+
+  void
+  setCorTheta(const std::vector<double>& ct)
+  {
+    m_corTheta = ct;
+  }
+
+  std::vector<double>
+  getCorTheta() const
+  {
+    return m_corTheta;
+  }
+
+  void
+  setMaxFacesPerPrefix(uint32_t mfpp)
+  {
+    m_maxFacesPerPrefix = mfpp;
+  }
+
+  uint32_t
+  getMaxFacesPerPrefix() const
+  {
+    return m_maxFacesPerPrefix;
+  }
+
+  void
+  setStateFileDir(const std::string& ssfd)
+  {
+    m_stateFileDir = ssfd;
+  }
+
+  const std::string&
+  getStateFileDir() const
+  {
+    return m_stateFileDir;
+  }
+
+  void
+  setConfFileNameDynamic(const std::string& confFileDynamic)
+  {
+    m_confFileNameDynamic = confFileDynamic;
+  }
+
+  const std::string&
+  getConfFileNameDynamic() const
+  {
+    return m_confFileNameDynamic;
+  }
+
+  void
+  setSyncInterestLifetime(uint32_t syncInterestLifetime)
+  {
+    m_syncInterestLifetime = ndn::time::milliseconds(syncInterestLifetime);
+  }
+
+  const ndn::time::milliseconds&
+  getSyncInterestLifetime() const
+  {
+    return m_syncInterestLifetime;
+  }
+
+  AdjacencyList&
+  getAdjacencyList()
+  {
+    return m_adjl;
+  }
+
+  NamePrefixList&
+  getNamePrefixList()
+  {
+    return m_npl;
+  }
+
+  /*! \brief Add a covering prefix under which the advertised name prefixes are aggregated.
+   *
+   * The name prefixes strictly under an aggregate are advertised in our Name LSA as the
+   * aggregate alone, at the lowest of their costs. A prefix stays listed when another router
+   * originates it, or one of its prefixes under the aggregate, so that longest prefix match
+   * still reaches this router for it.
+   */
+  void
+  addAggregatePrefix(const ndn::Name& prefix)
+  {
+    m_aggregatePrefixes.push_back(prefix);
+  }
+
+  const std::vector<ndn::Name>&
+  getAggregatePrefixes() const
+  {
+    return m_aggregatePrefixes;
+  }
+
+  security::CachingValidator&
+  getValidator()
+  {
+    return m_validator;
+  }
+
+  ndn::security::ValidatorConfig&
+  getPrefixUpdateValidator()
+  {
+    return m_prefixUpdateValidator;
+  }
+
+  const ndn::security::SigningInfo&
+  getSigningInfo() const
   {
     return m_signingInfo;
   }
@@ -505,6 +1206,359 @@ public:
     m_mlAdaptiveRouting = enable;
   }
 
+  void
+  setMLWeeklyPatterns(bool enable)
+  {
+    m_mlWeeklyPatterns = enable;
+  }
+
+  bool
+  getMLWeeklyPatterns() const
+  {
+    return m_mlWeeklyPatterns;
+  }
+
+  void
+  setMLRoutePrecompute(bool enable)
+  {
+    m_mlRoutePrecompute = enable;
+  }
+
+  bool
+  getMLRoutePrecompute() const
+  {
+    return m_mlRoutePrecompute;
+  }
+
+  void
+  setLsaFetchWindow(uint32_t window)
+  {
+    m_lsaFetchWindow = window;
+  }
+
+  uint32_t
+  getLsaFetchWindow() const
+  {
+    return m_lsaFetchWindow;
+  }
+
+  void
+  setLsaFetchRate(uint32_t rate)
+  {
+    m_lsaFetchRate = rate;
+  }
+
+  uint32_t
+  getLsaFetchRate() const
+  {
+    return m_lsaFetchRate;
+  }
+
+  void
+  setAdjLsaDelta(bool enable)
+  {
+    m_adjLsaDelta = enable;
+  }
+
+  bool
+  getAdjLsaDelta() const
+  {
+    return m_adjLsaDelta;
+  }
+
+  void
+  setNameLsaCompression(bool enable)
+  {
+    m_nameLsaCompression = enable;
+  }
+
+  bool
+  getNameLsaCompression() const
+  {
+    return m_nameLsaCompression;
+  }
+
+  /*! \brief Set whether management commands hand their blocking work, such as saving
+   *  prefixes to the configuration file, to a thread of their own.
+   */
+  void
+  setManagementThread(bool enable)
+  {
+    m_managementThread = enable;
+  }
+
+  bool
+  getManagementThread() const
+  {
+    return m_managementThread;
+  }
+
+  /*! \brief Set whether the log records are written by a background thread from a bounded
+   *         queue, dropping those that do not fit.
+   */
+  void
+  setAsyncLogging(bool enable)
+  {
+    m_asyncLogging = enable;
+  }
+
+  bool
+  getAsyncLogging() const
+  {
+    return m_asyncLogging;
+  }
+
+  /*! \brief Set the limit, in kilobytes, of the segments of other routers' LSAs kept to
+   *  serve other routers; 0 for no limit.
+   */
+  void
+  setLsaSegmentStorageLimit(uint32_t limit)
+  {
+    m_lsaSegmentStorageLimit = limit;
+  }
+
+  uint32_t
+  getLsaSegmentStorageLimit() const
+  {
+    return m_lsaSegmentStorageLimit;
+  }
+
+  /*! \brief Set the time, in milliseconds, during which changes of the advertised name
+   *  prefixes are coalesced into a single new Name LSA; 0 to build it at each change.
+   */
+  void
+  setNameLsaBuildInterval(uint32_t interval)
+  {
+    m_nameLsaBuildInterval = ndn::time::milliseconds(interval);
+  }
+
+  const ndn::time::milliseconds&
+  getNameLsaBuildInterval() const
+  {
+    return m_nameLsaBuildInterval;
+  }
+
+  void
+  setSyncPublishHoldDown(uint32_t holdDown)
+  {
+    m_syncPublishHoldDown = ndn::time::milliseconds(holdDown);
+  }
+
+  const ndn::time::milliseconds&
+  getSyncPublishHoldDown() const
+  {
+    return m_syncPublishHoldDown;
+  }
+
+  void
+  setSyncInlineLsaSize(uint32_t size)
+  {
+    m_syncInlineLsaSize = size;
+  }
+
+  uint32_t
+  getSyncInlineLsaSize() const
+  {
+    return m_syncInlineLsaSize;
+  }
+
+  /*! \brief Set the number of routers the sync data structures are sized for; 0 for the
+   *         default size.
+   *
+   * It must be the same on all the routers of a sync group, whose PSync IBFs are then of the
+   * same size.
+   */
+  void
+  setSyncExpectedRouters(uint32_t nRouters)
+  {
+    m_syncExpectedRouters = nRouters;
+  }
+
+  uint32_t
+  getSyncExpectedRouters() const
+  {
+    return m_syncExpectedRouters;
+  }
+
+  /*! \brief Set the minimum time in milliseconds between two accepted versions of the LSA of
+   *         one origin router and type; 0 for none.
+   *
+   * A newer version announced sooner is fetched when that time has passed, skipping the
+   * versions announced meanwhile.
+   */
+  void
+  setLsaMinArrival(uint32_t minArrival)
+  {
+    m_lsaMinArrival = ndn::time::milliseconds(minArrival);
+  }
+
+  const ndn::time::milliseconds&
+  getLsaMinArrival() const
+  {
+    return m_lsaMinArrival;
+  }
+
+  /*! \brief Set the largest number of name prefixes, including the area summaries, accepted in
+   *         the Name LSA of another router; 0 for no limit.
+   */
+  void
+  setLsaMaxNamePrefixes(uint32_t maxPrefixes)
+  {
+    m_lsaMaxNamePrefixes = maxPrefixes;
+  }
+
+  uint32_t
+  getLsaMaxNamePrefixes() const
+  {
+    return m_lsaMaxNamePrefixes;
+  }
+
+  /*! \brief Set the largest number of adjacencies accepted in the Adjacency LSA of another
+   *         router; 0 for no limit.
+   */
+  void
+  setLsaMaxAdjacencies(uint32_t maxAdjacencies)
+  {
+    m_lsaMaxAdjacencies = maxAdjacencies;
+  }
+
+  uint32_t
+  getLsaMaxAdjacencies() const
+  {
+    return m_lsaMaxAdjacencies;
+  }
+
+  void
+  setLsdbSnapshotInterval(uint32_t interval)
+  {
+    m_lsdbSnapshotInterval = interval;
+  }
+
+  uint32_t
+  getLsdbSnapshotInterval() const
+  {
+    return m_lsdbSnapshotInterval;
+  }
+
+  /*! \brief Set the largest number of bytes of an LSA carried in each of its segments.
+   */
+  void
+  setLsaSegmentSize(uint32_t size)
+  {
+    m_lsaSegmentSize = size;
+  }
+
+  uint32_t
+  getLsaSegmentSize() const
+  {
+    return m_lsaSegmentSize;
+  }
+
+  /*! \brief Set the number of threads verifying the signatures of LSA segments and hellos;
+   *  0 to verify them on the io thread.
+   */
+  void
+  setVerificationThreads(uint32_t nThreads)
+  {
+    m_verificationThreads = nThreads;
+    m_validator.setVerificationThreads(nThreads);
+  }
+
+  uint32_t
+  getVerificationThreads() const
+  {
+    return m_verificationThreads;
+  }
+
+  void
+  setSigningKeyType(SigningKeyType type)
+  {
+    m_signingKeyType = type;
+  }
+
+  SigningKeyType
+  getSigningKeyType() const
+  {
+    return m_signingKeyType;
+  }
+
+  /*! \brief Set the path of the Unix socket serving the OpenMetrics text; empty to not serve it.
+   */
+  void
+  setMetricsExportSocketPath(const std::string& path)
+  {
+    m_metricsExportSocketPath = path;
+  }
+
+  const std::string&
+  getMetricsExportSocketPath() const
+  {
+    return m_metricsExportSocketPath;
+  }
+
+  /*! \brief Set the TCP port on 127.0.0.1 serving the OpenMetrics text; 0 to not serve it.
+   */
+  void
+  setMetricsExportPort(uint32_t port)
+  {
+    m_metricsExportPort = static_cast<uint16_t>(port);
+  }
+
+  uint16_t
+  getMetricsExportPort() const
+  {
+    return m_metricsExportPort;
+  }
+
+  /*! \brief Set the path of the Unix socket streaming routing state events; empty to not
+   *         stream them.
+   */
+  void
+  setEventStreamSocketPath(const std::string& path)
+  {
+    m_eventStreamSocketPath = path;
+  }
+
+  const std::string&
+  getEventStreamSocketPath() const
+  {
+    return m_eventStreamSocketPath;
+  }
+
+  /*! \brief Set whether the topology, routing table and link metrics are published in a
+   *         shared memory region, state-dir/routing-state.shm.
+   *
+   * \sa nlsr::SharedStateExporter
+   */
+  void
+  setSharedStateExport(bool enable)
+  {
+    m_sharedStateExport = enable;
+  }
+
+  bool
+  getSharedStateExport() const
+  {
+    return m_sharedStateExport;
+  }
+
+  /*! \brief Set whether the certificates of each origin router are fetched as soon as sync
+   *         reports it, and kept in state-dir/cert-cache across restarts.
+   *
+   * \sa nlsr::security::CertificateStore::prefetchCertificates
+   */
+  void
+  setCertPrefetch(bool enable)
+  {
+    m_certPrefetch = enable;
+  }
+
+  bool
+  getCertPrefetch() const
+  {
+    return m_certPrefetch;
+  }
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::string m_confFileName;
   std::string m_confFileNameDynamic;
@@ -520,10 +1574,24 @@ private:
   ndn::Name m_syncPrefix;
   ndn::Name m_lsaPrefix;
 
+  uint32_t m_areaDepth = 0;
+  ndn::Name m_backboneArea;
+
   uint32_t  m_lsaRefreshTime;
 
   uint32_t m_adjLsaBuildInterval;
   uint32_t m_routingCalcInterval;
+  bool m_routingCalcThrottle = false;
+  uint32_t m_routingCalcInitialDelay = ROUTING_CALC_INITIAL_DELAY_DEFAULT;
+  uint32_t m_routingCalcHoldTime = ROUTING_CALC_HOLD_TIME_DEFAULT;
+  bool m_routingCalcNeighborDown = false;
+  uint32_t m_fibCommandWindow = FIB_COMMAND_WINDOW_DEFAULT;
+  bool m_routingCalcAsync = false;
+  bool m_routingCalcShadow = false;
+  uint32_t m_routingCalcThreads;
+  bool m_loopFreeAlternates = false;
+  DisjointPaths m_disjointPaths = DisjointPaths::NONE;
+  bool m_weightedMultipath = false;
 
   uint32_t m_faceDatasetFetchTries;
   ndn::time::seconds m_faceDatasetFetchInterval;
@@ -535,6 +1603,27 @@ private:
   uint32_t m_interestResendTime;
 
   uint32_t m_infoInterestInterval;
+  RttSource m_rttSource = RttSource::PROBE;
+  CostMetric m_costMetric = CostMetric::RTT;
+  uint32_t m_helloIntervalCap = HELLO_INTERVAL_CAP_DEFAULT;
+  ndn::time::seconds m_helloSignatureReuse{HELLO_SIGNATURE_REUSE_DEFAULT};
+  ndn::time::milliseconds m_livenessInterval{LIVENESS_INTERVAL_DEFAULT};
+  uint32_t m_livenessMultiplier = LIVENESS_MULTIPLIER_DEFAULT;
+  uint32_t m_rttProbeIntervalMin = RTT_PROBE_INTERVAL_MIN_DEFAULT;
+  uint32_t m_rttProbeIntervalMax = RTT_PROBE_INTERVAL_MAX_DEFAULT;
+  uint32_t m_costUpdateWindow = COST_UPDATE_WINDOW_DEFAULT;
+  bool m_costDamping = false;
+  uint32_t m_costDampingHalfLife = COST_DAMPING_HALF_LIFE_DEFAULT;
+  uint32_t m_costDampingSuppress = COST_DAMPING_SUPPRESS_DEFAULT;
+  uint32_t m_costDampingReuse = COST_DAMPING_REUSE_DEFAULT;
+  uint32_t m_rttSpikeFilter = RTT_SPIKE_FILTER_DEFAULT;
+  uint32_t m_costBuckets = COST_BUCKETS_DEFAULT;
+  uint32_t m_costAdvertiseThreshold = COST_ADVERTISE_THRESHOLD_DEFAULT;
+  uint32_t m_costAdvertiseHold = COST_ADVERTISE_HOLD_DEFAULT;
+  std::string m_metricsSocketPath;
+  std::string m_linkSampleTracePath;
+  uint32_t m_faceCounterInterval = FACE_COUNTER_INTERVAL_DEFAULT;
+  uint32_t m_linkBandwidth = LINK_BANDWIDTH_DEFAULT;
 
   HyperbolicState m_hyperbolicState;
   double m_corR;
@@ -552,6 +1641,31 @@ private:
   bool m_loadAwareRouting = false;  // 默认关闭
   //新增机器学习部分
   bool m_mlAdaptiveRouting = false;  // 默认关闭
+  bool m_mlWeeklyPatterns = false;
+  bool m_mlRoutePrecompute = false;
+  uint32_t m_lsaFetchWindow = LSA_FETCH_WINDOW_DEFAULT;
+  uint32_t m_lsaFetchRate = LSA_FETCH_RATE_DEFAULT;
+  bool m_adjLsaDelta = false;
+  bool m_nameLsaCompression = false;
+  bool m_managementThread = false;
+  bool m_asyncLogging = false;
+  uint32_t m_lsaSegmentStorageLimit = LSA_SEGMENT_STORAGE_LIMIT_DEFAULT;
+  ndn::time::milliseconds m_nameLsaBuildInterval{NAME_LSA_BUILD_INTERVAL_DEFAULT};
+  ndn::time::milliseconds m_syncPublishHoldDown{SYNC_PUBLISH_HOLD_DOWN_DEFAULT};
+  uint32_t m_syncInlineLsaSize = SYNC_INLINE_LSA_SIZE_DEFAULT;
+  uint32_t m_syncExpectedRouters = SYNC_EXPECTED_ROUTERS_DEFAULT;
+  ndn::time::milliseconds m_lsaMinArrival{LSA_MIN_ARRIVAL_DEFAULT};
+  uint32_t m_lsaMaxNamePrefixes = LSA_MAX_ENTRIES_DEFAULT;
+  uint32_t m_lsaMaxAdjacencies = LSA_MAX_ENTRIES_DEFAULT;
+  uint32_t m_lsdbSnapshotInterval = LSDB_SNAPSHOT_INTERVAL_DEFAULT;
+  uint32_t m_lsaSegmentSize = LSA_SEGMENT_SIZE_DEFAULT;
+  uint32_t m_verificationThreads = VERIFICATION_THREADS_DEFAULT;
+  SigningKeyType m_signingKeyType = SigningKeyType::ECDSA;
+  std::string m_metricsExportSocketPath;
+  uint16_t m_metricsExportPort = METRICS_EXPORT_PORT_DEFAULT;
+  std::string m_eventStreamSocketPath;
+  bool m_sharedStateExport = false;
+  bool m_certPrefetch = false;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   // must be incremented when breaking changes are made to sync
@@ -559,7 +1673,8 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   AdjacencyList m_adjl;
   NamePrefixList m_npl;
-  ndn::security::ValidatorConfig m_validator;
+  std::vector<ndn::Name> m_aggregatePrefixes;
+  security::CachingValidator m_validator;
   ndn::security::ValidatorConfig m_prefixUpdateValidator;
   ndn::security::SigningInfo m_signingInfo;
   std::unordered_set<std::string> m_certs;
@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_CONTROL_TRAFFIC_HPP
+#define NLSR_CONTROL_TRAFFIC_HPP
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/lp/tags.hpp>
+
+#include <array>
+#include <cstdint>
+#include <iosfwd>
+
+namespace nlsr {
+
+/*! \brief Control-plane packets exchanged with one neighbor, by message class.
+ *
+ * Kept by the AdjacencyList for each neighbor and counted on the io thread. Sync packets are
+ * sent and received by the sync library, and are not seen by NLSR.
+ */
+class ControlTraffic
+{
+public:
+  enum class MessageClass {
+    HELLO,
+    /// RTT and liveness probes
+    PROBE,
+    /// LSA Interests and segments fetched from or served to the neighbor
+    LSA_FETCH,
+    /// LSA fetches retried after the previous fetch failed
+    LSA_RETRANSMISSION
+  };
+
+  static constexpr size_t N_MESSAGE_CLASSES =
+    static_cast<size_t>(MessageClass::LSA_RETRANSMISSION) + 1;
+
+  struct Counters
+  {
+    uint64_t nInterestsSent = 0;
+    uint64_t nInterestsReceived = 0;
+    uint64_t nDataSent = 0;
+    uint64_t nDataReceived = 0;
+    uint64_t nBytesSent = 0;
+    uint64_t nBytesReceived = 0;
+
+    bool
+    empty() const
+    {
+      return nInterestsSent == 0 && nInterestsReceived == 0 && nDataSent == 0 &&
+             nDataReceived == 0;
+    }
+  };
+
+  const Counters&
+  get(MessageClass messageClass) const
+  {
+    return m_counters[static_cast<size_t>(messageClass)];
+  }
+
+  /*! \brief Replace the counters of \p messageClass , as decoded from a dataset.
+   */
+  void
+  set(MessageClass messageClass, const Counters& counters)
+  {
+    m_counters[static_cast<size_t>(messageClass)] = counters;
+  }
+
+  void
+  countInterestSent(MessageClass messageClass, const ndn::Interest& interest)
+  {
+    auto& counters = m_counters[static_cast<size_t>(messageClass)];
+    ++counters.nInterestsSent;
+    counters.nBytesSent += interest.wireEncode().size();
+  }
+
+  void
+  countInterestReceived(MessageClass messageClass, const ndn::Interest& interest)
+  {
+    auto& counters = m_counters[static_cast<size_t>(messageClass)];
+    ++counters.nInterestsReceived;
+    counters.nBytesReceived += interest.wireEncode().size();
+  }
+
+  /*! \pre \p data is signed
+   */
+  void
+  countDataSent(MessageClass messageClass, const ndn::Data& data)
+  {
+    auto& counters = m_counters[static_cast<size_t>(messageClass)];
+    ++counters.nDataSent;
+    counters.nBytesSent += data.wireEncode().size();
+  }
+
+  void
+  countDataReceived(MessageClass messageClass, const ndn::Data& data)
+  {
+    auto& counters = m_counters[static_cast<size_t>(messageClass)];
+    ++counters.nDataReceived;
+    counters.nBytesReceived += data.wireEncode().size();
+  }
+
+private:
+  std::array<Counters, N_MESSAGE_CLASSES> m_counters{};
+};
+
+std::ostream&
+operator<<(std::ostream& os, ControlTraffic::MessageClass messageClass);
+
+/*! \brief Return the ID of the Face that delivered \p packet , or 0 if it is not known.
+ */
+template<typename Packet>
+uint64_t
+getIncomingFaceId(const Packet& packet)
+{
+  auto tag = packet.template getTag<ndn::lp::IncomingFaceIdTag>();
+  return tag == nullptr ? 0 : tag->get();
+}
+
+} // namespace nlsr
+
+#endif // NLSR_CONTROL_TRAFFIC_HPP
@@ -0,0 +1,329 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "convergence-tracer.hpp"
+#include "logger.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <algorithm>
+#include <map>
+
+namespace nlsr {
+
+INIT_LOGGER(ConvergenceTracer);
+
+const char*
+getStageName(ConvergenceStage stage)
+{
+  switch (stage) {
+    case ConvergenceStage::HELLO_TIMEOUT:
+      return "hello-timeout";
+    case ConvergenceStage::COST_CHANGE:
+      return "cost-change";
+    case ConvergenceStage::LSA_RECEIVED:
+      return "lsa-received";
+    case ConvergenceStage::PREFIX_COMMAND:
+      return "prefix-command";
+    case ConvergenceStage::ADJ_LSA_BUILD:
+      return "adj-lsa-build";
+    case ConvergenceStage::NAME_LSA_BUILD:
+      return "name-lsa-build";
+    case ConvergenceStage::SYNC_PUBLISH:
+      return "sync-publish";
+    case ConvergenceStage::LSA_INSTALL:
+      return "lsa-install";
+    case ConvergenceStage::CALCULATION:
+      return "calculation";
+    case ConvergenceStage::NPT_UPDATE:
+      return "npt-update";
+    case ConvergenceStage::FIB_INSTALL:
+      return "fib-install";
+  }
+  return "unknown";
+}
+
+std::ostream&
+operator<<(std::ostream& os, ConvergenceStage stage)
+{
+  return os << getStageName(stage);
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+ConvergenceTraceEvent::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  if (!subject.empty()) {
+    totalLength += subject.wireEncode(block);
+  }
+
+  auto sinceEpoch = ndn::time::duration_cast<ndn::time::microseconds>(time.time_since_epoch());
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::Timestamp,
+                                                static_cast<uint64_t>(sinceEpoch.count()));
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::TraceStage,
+                                                static_cast<uint64_t>(stage));
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::TraceId, traceId);
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::ConvergenceTraceEvent);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(ConvergenceTraceEvent);
+
+ndn::Block
+ConvergenceTraceEvent::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  return buffer.block();
+}
+
+void
+ConvergenceTraceEvent::wireDecode(const ndn::Block& wire)
+{
+  if (wire.type() != nlsr::tlv::ConvergenceTraceEvent) {
+    NDN_THROW(Error("ConvergenceTraceEvent", wire.type()));
+  }
+
+  wire.parse();
+  const auto& fields = wire.elements();
+  if (fields.size() < 3 || fields.size() > 4 ||
+      fields[0].type() != nlsr::tlv::TraceId ||
+      fields[1].type() != nlsr::tlv::TraceStage ||
+      fields[2].type() != nlsr::tlv::Timestamp ||
+      (fields.size() == 4 && fields[3].type() != ndn::tlv::Name)) {
+    NDN_THROW(Error("Malformed ConvergenceTraceEvent"));
+  }
+
+  using ndn::encoding::readNonNegativeInteger;
+  traceId = readNonNegativeInteger(fields[0]);
+  auto stageValue = readNonNegativeInteger(fields[1]);
+  if (stageValue >= N_CONVERGENCE_STAGES) {
+    NDN_THROW(Error("Unknown TraceStage " + ndn::to_string(stageValue)));
+  }
+  stage = static_cast<ConvergenceStage>(stageValue);
+  time = ndn::time::system_clock::time_point(
+    ndn::time::microseconds(readNonNegativeInteger(fields[2])));
+  subject = fields.size() == 4 ? ndn::Name(fields[3]) : ndn::Name();
+}
+
+std::ostream&
+operator<<(std::ostream& os, const ConvergenceTraceEvent& event)
+{
+  os << "trace=" << event.traceId << " " << event.stage << " "
+     << ndn::time::toIsoString(event.time);
+  if (!event.subject.empty()) {
+    os << " " << event.subject;
+  }
+  return os;
+}
+
+/*! \brief The FIB_INSTALL of the traces of one NPT update, recorded when the last RIB command
+ *         that it issued is answered.
+ */
+class ConvergenceTracer::FibInstall : boost::noncopyable
+{
+public:
+  explicit
+  FibInstall(ConvergenceTracer& tracer)
+    : m_tracer(tracer)
+    , m_tracerToken(tracer.m_lifetimeToken)
+  {
+  }
+
+  ~FibInstall()
+  {
+    if (m_tracerToken.expired()) {
+      return;
+    }
+    for (auto traceId : traceIds) {
+      m_tracer.append(traceId, Stage::FIB_INSTALL, {});
+    }
+  }
+
+public:
+  std::vector<uint64_t> traceIds;
+
+private:
+  ConvergenceTracer& m_tracer;
+  std::weak_ptr<int> m_tracerToken;
+};
+
+ConvergenceTracer::NptUpdateScope::NptUpdateScope(ConvergenceTracer* tracer)
+  : m_tracer(tracer)
+{
+  if (m_tracer != nullptr) {
+    m_tracer->record(Stage::NPT_UPDATE);
+    m_fibInstall = m_tracer->beginFibInstall();
+  }
+}
+
+ConvergenceTracer::NptUpdateScope::~NptUpdateScope()
+{
+  if (m_tracer != nullptr) {
+    // commands issued later, e.g. by refreshes, are not part of this update
+    m_tracer->m_currentFibInstall.reset();
+  }
+}
+
+uint64_t
+ConvergenceTracer::begin(Stage trigger, const ndn::Name& subject, Path path)
+{
+  expireOpenTraces();
+
+  uint64_t traceId = m_nextTraceId++;
+  append(traceId, trigger, subject);
+  if (path != 0) {
+    m_openTraces.push_back({traceId, ndn::time::steady_clock::now(), path});
+  }
+  NLSR_LOG_TRACE("Trace " << traceId << " begins at " << trigger << " " << subject);
+  return traceId;
+}
+
+void
+ConvergenceTracer::reroute(uint64_t traceId, Path path)
+{
+  auto it = std::find_if(m_openTraces.begin(), m_openTraces.end(),
+                         [traceId] (const auto& trace) { return trace.id == traceId; });
+  if (it == m_openTraces.end()) {
+    return;
+  }
+  if (path == 0) {
+    m_openTraces.erase(it);
+  }
+  else {
+    it->path = path;
+  }
+}
+
+void
+ConvergenceTracer::record(Stage stage, const ndn::Name& subject)
+{
+  expireOpenTraces();
+
+  auto bit = makeConvergencePath({stage});
+  for (auto it = m_openTraces.begin(); it != m_openTraces.end();) {
+    // the stage is the next one of the trace if no stage before it remains
+    if ((it->path & (bit | (bit - 1))) != bit) {
+      ++it;
+      continue;
+    }
+    append(it->id, stage, subject);
+    it->path &= ~bit;
+    if (it->path == 0) {
+      it = m_openTraces.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+std::shared_ptr<void>
+ConvergenceTracer::beginFibInstall()
+{
+  auto fibInstall = m_currentFibInstall.lock();
+
+  auto bit = makeConvergencePath({Stage::FIB_INSTALL});
+  for (auto it = m_openTraces.begin(); it != m_openTraces.end();) {
+    if (it->path != bit) {
+      ++it;
+      continue;
+    }
+    if (fibInstall == nullptr) {
+      fibInstall = std::make_shared<FibInstall>(*this);
+    }
+    fibInstall->traceIds.push_back(it->id);
+    it = m_openTraces.erase(it);
+  }
+
+  m_currentFibInstall = fibInstall;
+  return fibInstall;
+}
+
+void
+ConvergenceTracer::append(uint64_t traceId, Stage stage, const ndn::Name& subject)
+{
+  if (m_events.size() == MAX_EVENTS) {
+    m_events.pop_front();
+  }
+  m_events.emplace_back(traceId, stage, ndn::time::system_clock::now(), subject);
+}
+
+void
+ConvergenceTracer::expireOpenTraces()
+{
+  auto now = ndn::time::steady_clock::now();
+  while (!m_openTraces.empty() &&
+         (m_openTraces.size() > MAX_OPEN_TRACES ||
+          now - m_openTraces.front().begin > TRACE_TIMEOUT)) {
+    NLSR_LOG_DEBUG("Trace " << m_openTraces.front().id << " did not complete");
+    m_openTraces.pop_front();
+  }
+}
+
+void
+ConvergenceTracer::writeChromeTrace(std::ostream& os,
+                                    const std::vector<ConvergenceTraceEvent>& events)
+{
+  // time of the previous event of each trace
+  std::map<uint64_t, int64_t> previous;
+
+  os << "{\"traceEvents\":[";
+  bool isFirst = true;
+  for (const auto& event : events) {
+    auto ts = ndn::time::duration_cast<ndn::time::microseconds>(
+                event.time.time_since_epoch()).count();
+
+    os << (isFirst ? "\n" : ",\n") << "{\"name\":\"" << getStageName(event.stage) << "\"";
+    isFirst = false;
+
+    auto prev = previous.find(event.traceId);
+    if (prev == previous.end()) {
+      // the trigger, or a stage whose trigger has left the ring
+      os << ",\"ph\":\"i\",\"s\":\"t\",\"ts\":" << ts;
+    }
+    else {
+      os << ",\"ph\":\"X\",\"ts\":" << prev->second
+         << ",\"dur\":" << std::max<int64_t>(ts - prev->second, 0);
+    }
+    previous[event.traceId] = ts;
+
+    os << ",\"pid\":1,\"tid\":" << event.traceId;
+    if (!event.subject.empty()) {
+      // a name URI has no characters to escape in JSON
+      os << ",\"args\":{\"subject\":\"" << event.subject.toUri() << "\"}";
+    }
+    os << "}";
+  }
+  os << "\n]}\n";
+}
+
+} // namespace nlsr
@@ -0,0 +1,274 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_CONVERGENCE_TRACER_HPP
+#define NLSR_CONVERGENCE_TRACER_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief What a convergence trace records: the trigger that begins it, then the stages it
+ *         reaches, in this order.
+ */
+enum class ConvergenceStage : uint8_t {
+  HELLO_TIMEOUT,
+  COST_CHANGE,
+  LSA_RECEIVED,
+  PREFIX_COMMAND,
+  ADJ_LSA_BUILD,
+  NAME_LSA_BUILD,
+  SYNC_PUBLISH,
+  LSA_INSTALL,
+  CALCULATION,
+  NPT_UPDATE,
+  FIB_INSTALL,
+};
+
+constexpr size_t N_CONVERGENCE_STAGES = static_cast<size_t>(ConvergenceStage::FIB_INSTALL) + 1;
+
+const char*
+getStageName(ConvergenceStage stage);
+
+std::ostream&
+operator<<(std::ostream& os, ConvergenceStage stage);
+
+/// A set of stages, as bits indexed by ConvergenceStage
+using ConvergencePath = uint32_t;
+
+constexpr ConvergencePath
+makeConvergencePath(std::initializer_list<ConvergenceStage> stages)
+{
+  ConvergencePath path = 0;
+  for (auto stage : stages) {
+    path |= ConvergencePath{1} << static_cast<size_t>(stage);
+  }
+  return path;
+}
+
+/**
+ * @brief A stage reached by a convergence trace, as served by the convergence-trace dataset.
+ *
+ *     ConvergenceTraceEvent = CONVERGENCE-TRACE-EVENT-TYPE TLV-LENGTH
+ *                               TraceId    ; NonNegativeInteger
+ *                               TraceStage ; NonNegativeInteger, ConvergenceStage
+ *                               Timestamp  ; microseconds since the Unix epoch
+ *                               [Name]     ; what the stage is about, e.g. a neighbor or an LSA
+ *
+ * The timestamps come from the system clock, so that the traces of several routers can be
+ * merged; an LSA is named /<LSA prefix>/<type>/<seqNo> on both its origin and the routers that
+ * fetch it, which relates the publication of a change to its installation elsewhere.
+ */
+class ConvergenceTraceEvent
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  ConvergenceTraceEvent() = default;
+
+  ConvergenceTraceEvent(uint64_t traceId, ConvergenceStage stage,
+                        ndn::time::system_clock::time_point time, ndn::Name subject)
+    : traceId(traceId)
+    , stage(stage)
+    , time(time)
+    , subject(std::move(subject))
+  {
+  }
+
+  explicit
+  ConvergenceTraceEvent(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+public:
+  uint64_t traceId = 0;
+  ConvergenceStage stage = ConvergenceStage::HELLO_TIMEOUT;
+  ndn::time::system_clock::time_point time;
+  ndn::Name subject;
+};
+
+NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(ConvergenceTraceEvent);
+
+std::ostream&
+operator<<(std::ostream& os, const ConvergenceTraceEvent& event);
+
+/**
+ * @brief Follows routing changes from the event that triggers them to their installation in NFD.
+ *
+ * A trace begins at a trigger with the path of stages it is expected to reach. Each stage,
+ * when reached, is recorded once for every open trace whose next stage it is, so that a trace
+ * waits for the first Adj LSA build, calculation, etc. that follows its previous stage. The
+ * RIB commands issued by an NPT update hold the FIB_INSTALL of the traces that reached that
+ * update, which is recorded when the last of them is answered, or at the end of the update if
+ * it issued none.
+ *
+ * Events are kept in a ring of the last MAX_EVENTS. A trace that does not complete within
+ * TRACE_TIMEOUT, e.g. because its Adj LSA turned out not to change, is closed without further
+ * events.
+ */
+class ConvergenceTracer : boost::noncopyable
+{
+public:
+  using Stage = ConvergenceStage;
+  using Path = ConvergencePath;
+
+  /// Our adjacencies changed: the Adj LSA is rebuilt and published, and routes recalculated.
+  static constexpr Path LOCAL_ADJACENCY_PATH = makeConvergencePath({
+    Stage::ADJ_LSA_BUILD, Stage::SYNC_PUBLISH, Stage::CALCULATION, Stage::NPT_UPDATE,
+    Stage::FIB_INSTALL});
+  /// A link cost changed only in the local cost overlay, or under hyperbolic routing.
+  static constexpr Path LOCAL_ROUTING_PATH = makeConvergencePath({
+    Stage::CALCULATION, Stage::NPT_UPDATE, Stage::FIB_INSTALL});
+  /// Our name prefixes changed: the Name LSA is rebuilt and published.
+  static constexpr Path LOCAL_PREFIX_PATH = makeConvergencePath({
+    Stage::NAME_LSA_BUILD, Stage::SYNC_PUBLISH});
+  /// The Adjacency or Coordinate LSA of another router changed.
+  static constexpr Path REMOTE_TOPOLOGY_PATH = makeConvergencePath({
+    Stage::LSA_INSTALL, Stage::CALCULATION, Stage::NPT_UPDATE, Stage::FIB_INSTALL});
+  /// The Name LSA of another router changed.
+  static constexpr Path REMOTE_PREFIX_PATH = makeConvergencePath({
+    Stage::LSA_INSTALL, Stage::NPT_UPDATE, Stage::FIB_INSTALL});
+
+  static constexpr size_t MAX_EVENTS = 4096;
+  static constexpr size_t MAX_OPEN_TRACES = 256;
+  static constexpr ndn::time::seconds TRACE_TIMEOUT{120};
+
+  /**
+   * @brief Records NPT_UPDATE on construction. The RIB commands issued until destruction hold
+   *        the FIB_INSTALL of the traces that reached that NPT_UPDATE.
+   *
+   * Does nothing if the tracer is nullptr.
+   */
+  class NptUpdateScope : boost::noncopyable
+  {
+  public:
+    explicit
+    NptUpdateScope(ConvergenceTracer* tracer);
+
+    ~NptUpdateScope();
+
+  private:
+    ConvergenceTracer* m_tracer;
+    std::shared_ptr<void> m_fibInstall;
+  };
+
+  /*! \brief Begin a trace at \p trigger , expecting it to reach the stages of \p path .
+   *  \return the ID of the trace
+   */
+  uint64_t
+  begin(Stage trigger, const ndn::Name& subject, Path path);
+
+  /*! \brief Replace the stages that a trace still expects, e.g. when a change turns out to be
+   *         handled differently than expected. An empty \p path closes the trace.
+   */
+  void
+  reroute(uint64_t traceId, Path path);
+
+  /*! \brief Record \p stage for the open traces that expect it next.
+   */
+  void
+  record(Stage stage, const ndn::Name& subject = {});
+
+  /*! \brief Returns a handle that delays the FIB_INSTALL of the traces of the NPT update in
+   *         progress for as long as it is held, or nullptr outside an NPT update.
+   */
+  std::shared_ptr<void>
+  getFibInstall() const
+  {
+    return m_currentFibInstall.lock();
+  }
+
+  const std::deque<ConvergenceTraceEvent>&
+  getEvents() const
+  {
+    return m_events;
+  }
+
+  size_t
+  getOpenTraceCount() const
+  {
+    return m_openTraces.size();
+  }
+
+  /*! \brief Write \p events in the Chrome trace event format, one track per trace.
+   *
+   * Each stage is a slice that spans the time since the previous stage of its trace, so that
+   * chrome://tracing or Perfetto shows where the convergence time went.
+   */
+  static void
+  writeChromeTrace(std::ostream& os, const std::vector<ConvergenceTraceEvent>& events);
+
+private:
+  struct OpenTrace
+  {
+    uint64_t id;
+    ndn::time::steady_clock::time_point begin;
+    /// stages still expected
+    Path path;
+  };
+
+  class FibInstall;
+
+  void
+  append(uint64_t traceId, Stage stage, const ndn::Name& subject);
+
+  /*! \brief Close the traces that timed out, and the oldest ones beyond MAX_OPEN_TRACES.
+   */
+  void
+  expireOpenTraces();
+
+  std::shared_ptr<void>
+  beginFibInstall();
+
+private:
+  std::deque<ConvergenceTraceEvent> m_events;
+  // in the order they began
+  std::deque<OpenTrace> m_openTraces;
+  uint64_t m_nextTraceId = 1;
+  std::weak_ptr<FibInstall> m_currentFibInstall;
+  std::shared_ptr<int> m_lifetimeToken = std::make_shared<int>();
+};
+
+} // namespace nlsr
+
+#endif // NLSR_CONVERGENCE_TRACER_HPP
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cost-flap-damping.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nlsr {
+
+CostFlapDamping::CostFlapDamping(ndn::time::seconds halfLife,
+                                 double suppressThreshold, double reuseThreshold)
+  : m_halfLife(halfLife)
+  , m_suppressThreshold(suppressThreshold)
+  , m_reuseThreshold(reuseThreshold)
+  , m_maxPenalty(std::ldexp(reuseThreshold, MAX_SUPPRESS_HALF_LIVES))
+{
+}
+
+double
+CostFlapDamping::decay(const State& state, TimePoint now) const
+{
+  if (state.penalty == 0.0) {
+    return 0.0;
+  }
+  double elapsed = ndn::time::duration_cast<ndn::time::milliseconds>(now - state.lastUpdate).count();
+  double halfLife = ndn::time::duration_cast<ndn::time::milliseconds>(m_halfLife).count();
+  return state.penalty * std::exp2(-elapsed / halfLife);
+}
+
+bool
+CostFlapDamping::recordChange(State& state, TimePoint now) const
+{
+  state.penalty = std::min(decay(state, now) + PENALTY_PER_CHANGE,
+                           std::max(m_maxPenalty, m_suppressThreshold));
+  state.lastUpdate = now;
+  if (state.penalty >= m_suppressThreshold) {
+    state.isSuppressed = true;
+  }
+  return state.isSuppressed;
+}
+
+bool
+CostFlapDamping::update(State& state, TimePoint now) const
+{
+  state.penalty = decay(state, now);
+  state.lastUpdate = now;
+  if (state.isSuppressed && state.penalty < m_reuseThreshold) {
+    state.isSuppressed = false;
+  }
+  return state.isSuppressed;
+}
+
+} // namespace nlsr
@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_COST_FLAP_DAMPING_HPP
+#define NLSR_COST_FLAP_DAMPING_HPP
+
+#include <ndn-cxx/util/time.hpp>
+
+namespace nlsr {
+
+/*! \brief Flap damping of dynamic link costs, after BGP route flap damping (RFC 2439).
+ *
+ * Every significant change of a link's computed cost adds a fixed penalty, which decays
+ * exponentially with the configured half-life. A link whose penalty exceeds the suppress
+ * threshold is suppressed until its penalty decays below the reuse threshold. While it is
+ * suppressed its cost is pinned, so that its jitter does not cause LSA floods and remote
+ * routing calculations. The penalty is capped at 2^MAX_SUPPRESS_HALF_LIVES times the reuse
+ * threshold (but not below the suppress threshold), which bounds how long a link that has
+ * settled stays suppressed.
+ */
+class CostFlapDamping
+{
+public:
+  using TimePoint = ndn::time::steady_clock::time_point;
+
+  static constexpr double PENALTY_PER_CHANGE = 1000.0;
+  static constexpr int MAX_SUPPRESS_HALF_LIVES = 4;
+
+  /*! \brief Damping state of one link.
+   */
+  struct State
+  {
+    double penalty = 0.0;
+    TimePoint lastUpdate;
+    bool isSuppressed = false;
+  };
+
+  CostFlapDamping(ndn::time::seconds halfLife, double suppressThreshold, double reuseThreshold);
+
+  /*! \brief Record a change of the computed cost of a link.
+   * \return whether the link is suppressed after the change
+   */
+  bool
+  recordChange(State& state, TimePoint now) const;
+
+  /*! \brief Decay the penalty of a link and release it if it fell below the reuse threshold.
+   * \return whether the link is still suppressed
+   */
+  bool
+  update(State& state, TimePoint now) const;
+
+private:
+  double
+  decay(const State& state, TimePoint now) const;
+
+private:
+  ndn::time::seconds m_halfLife;
+  double m_suppressThreshold;
+  double m_reuseThreshold;
+  double m_maxPenalty;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_COST_FLAP_DAMPING_HPP
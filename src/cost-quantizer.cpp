@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cost-quantizer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nlsr {
+
+CostQuantizer::CostQuantizer(size_t nLevels, double maxMultiplier)
+  : m_nLevels(std::max<size_t>(nLevels, 2))
+  , m_logMaxMultiplier(std::log(std::max(maxMultiplier, 1.0)))
+{
+}
+
+size_t
+CostQuantizer::getLevel(double originalCost, double cost, std::optional<size_t> currentLevel) const
+{
+  if (originalCost <= 0 || cost <= originalCost || m_logMaxMultiplier == 0) {
+    return 0;
+  }
+
+  // position of the cost on the level scale, e.g. 2.4 lies between levels 2 and 3
+  double position = std::log(cost / originalCost) / m_logMaxMultiplier * (m_nLevels - 1);
+  position = std::min(position, static_cast<double>(m_nLevels - 1));
+
+  if (currentLevel && std::abs(position - *currentLevel) <= 0.5 + HYSTERESIS) {
+    return *currentLevel;
+  }
+  return static_cast<size_t>(std::lround(position));
+}
+
+double
+CostQuantizer::getCost(double originalCost, size_t level) const
+{
+  level = std::min(level, m_nLevels - 1);
+  return std::round(originalCost * std::exp(m_logMaxMultiplier * level / (m_nLevels - 1)));
+}
+
+} // namespace nlsr
@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_COST_QUANTIZER_HPP
+#define NLSR_COST_QUANTIZER_HPP
+
+#include <cstddef>
+#include <optional>
+
+namespace nlsr {
+
+/*! \brief Maps dynamic link costs onto a small set of logarithmically spaced levels.
+ *
+ * Level 0 is the configured cost of the link and the last level is the configured cost times
+ * the maximum cost multiplier. Levels are spaced by a constant ratio, so that the relative
+ * change needed to advertise a new cost is the same across the range. A link leaves its
+ * current level only when the cost moves HYSTERESIS of a level beyond the midpoint to the
+ * next one, so that a cost hovering around a boundary does not alternate between two levels.
+ */
+class CostQuantizer
+{
+public:
+  static constexpr double HYSTERESIS = 0.25;
+
+  /*! \param nLevels number of levels, at least 2
+   *  \param maxMultiplier ratio between the costs of the last and first levels
+   */
+  CostQuantizer(size_t nLevels, double maxMultiplier);
+
+  /*! \brief Return the level of @p cost for a link whose configured cost is @p originalCost .
+   *  \param currentLevel level currently advertised for the link, if any
+   */
+  size_t
+  getLevel(double originalCost, double cost, std::optional<size_t> currentLevel) const;
+
+  /*! \brief Return the cost advertised at @p level .
+   */
+  double
+  getCost(double originalCost, size_t level) const;
+
+private:
+  size_t m_nLevels;
+  double m_logMaxMultiplier;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_COST_QUANTIZER_HPP
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face-counter-collector.hpp"
+#include "logger.hpp"
+
+#include <ndn-cxx/mgmt/nfd/status-dataset.hpp>
+
+#include <algorithm>
+
+namespace nlsr {
+
+INIT_LOGGER(FaceCounterCollector);
+
+FaceCounterCollector::FaceCounterCollector(ndn::Face& face, ndn::KeyChain& keyChain,
+                                           ndn::time::seconds interval,
+                                           IsMonitored isMonitored, LoadCallback onLoad)
+  : m_controller(face, keyChain)
+  , m_scheduler(face.getIoContext())
+  , m_interval(interval)
+  , m_isMonitored(std::move(isMonitored))
+  , m_onLoad(std::move(onLoad))
+{
+}
+
+void
+FaceCounterCollector::start()
+{
+  if (m_isRunning) {
+    return;
+  }
+  m_isRunning = true;
+  fetch();
+}
+
+void
+FaceCounterCollector::stop()
+{
+  m_isRunning = false;
+  m_fetchEvent.cancel();
+  m_counters.clear();
+}
+
+void
+FaceCounterCollector::scheduleFetch()
+{
+  if (m_isRunning) {
+    m_fetchEvent = m_scheduler.schedule(m_interval, [this] { fetch(); });
+  }
+}
+
+void
+FaceCounterCollector::fetch()
+{
+  m_controller.fetch<ndn::nfd::FaceDataset>(
+    [this] (const std::vector<ndn::nfd::FaceStatus>& faces) {
+      if (!m_isRunning) {
+        return;
+      }
+      auto loads = processDataset(faces, ndn::time::steady_clock::now());
+      if (!loads.empty()) {
+        m_onLoad(loads);
+      }
+      scheduleFetch();
+    },
+    [this] (uint32_t code, const std::string& reason) {
+      NLSR_LOG_DEBUG("Cannot fetch face counters: " << reason << " (" << code << ")");
+      scheduleFetch();
+    });
+}
+
+std::vector<FaceCounterCollector::FaceLoad>
+FaceCounterCollector::processDataset(const std::vector<ndn::nfd::FaceStatus>& faces,
+                                     TimePoint now)
+{
+  std::vector<FaceLoad> loads;
+  std::unordered_map<uint64_t, Counters> counters;
+  for (const auto& status : faces) {
+    if (!m_isMonitored(status.getFaceId())) {
+      continue;
+    }
+    Counters current{now, status.getNOutBytes(), status.getNOutInterests(), status.getNInData()};
+    counters.emplace(status.getFaceId(), current);
+
+    auto previous = m_counters.find(status.getFaceId());
+    if (previous == m_counters.end()) {
+      continue;
+    }
+    const auto& last = previous->second;
+    double seconds = ndn::time::duration_cast<ndn::time::microseconds>(now - last.time).count() / 1e6;
+    if (seconds <= 0.0 || current.nOutBytes < last.nOutBytes ||
+        current.nOutInterests < last.nOutInterests || current.nInData < last.nInData) {
+      NLSR_LOG_DEBUG("Counters of face " << status.getFaceId() << " were reset");
+      continue;
+    }
+
+    FaceLoad load{status.getFaceId(), (current.nOutBytes - last.nOutBytes) * 8 / seconds,
+                  std::nullopt};
+    uint64_t nInterests = current.nOutInterests - last.nOutInterests;
+    if (nInterests >= MIN_INTERESTS_FOR_LOSS) {
+      uint64_t nData = current.nInData - last.nInData;
+      load.lossRate = nData >= nInterests ? 0.0 : static_cast<double>(nInterests - nData) / nInterests;
+    }
+    NLSR_LOG_TRACE("Face " << load.faceId << ": " << load.outBitRate << " bit/s"
+                   << (load.lossRate ? ", loss " + std::to_string(*load.lossRate) : ""));
+    loads.push_back(load);
+  }
+  m_counters = std::move(counters);
+  return loads;
+}
+
+} // namespace nlsr
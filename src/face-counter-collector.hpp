@@ -0,0 +1,113 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_FACE_COUNTER_COLLECTOR_HPP
+#define NLSR_FACE_COUNTER_COLLECTOR_HPP
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/mgmt/nfd/controller.hpp>
+#include <ndn-cxx/mgmt/nfd/face-status.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Derives the load of faces from the counters in the NFD face dataset.
+ *
+ * The face dataset is fetched periodically, and the out byte rate and the share of
+ * unsatisfied Interests (timed out or Nacked) of each monitored face are computed from the
+ * difference of its counters to the previous fetch. This lets NLSR measure link utilization and
+ * loss without an external agent.
+ */
+class FaceCounterCollector : boost::noncopyable
+{
+public:
+  using TimePoint = ndn::time::steady_clock::time_point;
+
+  /*! \brief Fewest Interests sent during an interval for its loss rate to be reported.
+   */
+  static constexpr uint64_t MIN_INTERESTS_FOR_LOSS = 10;
+
+  struct FaceLoad
+  {
+    uint64_t faceId;
+    /// bits per second sent on the face
+    double outBitRate;
+    /// share of the Interests sent on the face that brought no Data, in [0, 1]
+    std::optional<double> lossRate;
+  };
+
+  using IsMonitored = std::function<bool(uint64_t faceId)>;
+  using LoadCallback = std::function<void(const std::vector<FaceLoad>&)>;
+
+  FaceCounterCollector(ndn::Face& face, ndn::KeyChain& keyChain, ndn::time::seconds interval,
+                       IsMonitored isMonitored, LoadCallback onLoad);
+
+  void
+  start();
+
+  void
+  stop();
+
+  /*! \brief Compute the load of the monitored faces in \p faces since the previous dataset.
+   *
+   * A face seen for the first time, or whose counters went backwards, only sets the baseline.
+   * Faces that are no longer monitored or no longer in the dataset are forgotten.
+   */
+  std::vector<FaceLoad>
+  processDataset(const std::vector<ndn::nfd::FaceStatus>& faces, TimePoint now);
+
+private:
+  void
+  scheduleFetch();
+
+  void
+  fetch();
+
+private:
+  struct Counters
+  {
+    TimePoint time;
+    uint64_t nOutBytes;
+    uint64_t nOutInterests;
+    uint64_t nInData;
+  };
+
+  ndn::nfd::Controller m_controller;
+  ndn::Scheduler m_scheduler;
+  ndn::time::seconds m_interval;
+  IsMonitored m_isMonitored;
+  LoadCallback m_onLoad;
+  std::unordered_map<uint64_t, Counters> m_counters;
+  ndn::scheduler::ScopedEventId m_fetchEvent;
+  bool m_isRunning = false;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_FACE_COUNTER_COLLECTOR_HPP
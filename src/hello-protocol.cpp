@@ -25,6 +25,9 @@
  #include "utility/name-helper.hpp"
  
  #include <ndn-cxx/encoding/nfd-constants.hpp>
+ #include <ndn-cxx/util/random.hpp>
+
+ #include <algorithm>
  
  namespace nlsr {
  
@@ -35,6 +38,8 @@
                               Lsdb& lsdb, Nlsr& nlsr)
    : m_face(face)
    , m_scheduler(m_face.getIoContext())
+   , m_helloWheel(m_scheduler, HELLO_TIMER_TICK, HELLO_TIMER_SLOTS,
+                  [this] (NeighborId id) { sendHelloInterest(id); })
    , m_keyChain(keyChain)
    , m_signingInfo(confParam.getSigningInfo())
    , m_confParam(confParam)
@@ -42,7 +47,12 @@
    , m_lsdb(lsdb)
    , m_adjacencyList(m_confParam.getAdjacencyList())
    , m_nlsr(nlsr)
+   , m_livenessDetector(face, keyChain, confParam)
  {
+   m_livenessDetector.onNeighborDown.connect([this] (const auto& neighbor) {
+     onLivenessLost(neighbor);
+   });
+
    ndn::Name name(m_confParam.getRouterPrefix());
    name.append(NLSR_COMPONENT);
    name.append(INFO_COMPONENT);
@@ -75,11 +85,18 @@
    // Emit signal for LinkCostManager integration (Option A)
   ndn::Name neighbor = interestName.getPrefix(-3);
   onInterestSent(neighbor);
+  if (auto* traffic = m_adjacencyList.findControlTraffic(neighbor); traffic != nullptr) {
+    traffic->countInterestSent(ControlTraffic::MessageClass::HELLO, interest);
+  }
  
+   auto sendTime = ndn::time::steady_clock::now();
    m_face.expressInterest(interest,
-     std::bind(&HelloProtocol::onContent, this, _1, _2),
-     [this, seconds] (const auto& interest, const auto& nack) {
+     [this, sendTime] (const auto& interest, const auto& data) {
+       onContent(interest, data, ndn::time::steady_clock::now() - sendTime);
+     },
+     [this, seconds, neighbor] (const auto& interest, const auto& nack) {
        NDN_LOG_TRACE("Received Nack with reason: " << nack.getReason());
+       resetHelloInterval(neighbor);
        NDN_LOG_TRACE("Will treat as timeout in " << 2 * seconds << " seconds");
        m_scheduler.schedule(ndn::time::seconds(2 * seconds),
          [this, interest] { processInterestTimedOut(interest); });
@@ -87,30 +104,106 @@
      std::bind(&HelloProtocol::processInterestTimedOut, this, _1));
  
    // increment SENT_HELLO_INTEREST
-   hpIncrementSignal(Statistics::PacketType::SENT_HELLO_INTEREST);
+   countPacket(Statistics::PacketType::SENT_HELLO_INTEREST);
  }
  
  void
  HelloProtocol::sendHelloInterest(const ndn::Name& neighbor)
  {
-   auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+   auto id = m_adjacencyList.getNeighborId(neighbor);
+   if (id) {
+     sendHelloInterest(*id);
+   }
+ }
+
+ void
+ HelloProtocol::sendHelloInterest(NeighborId id)
+ {
+   auto adjacent = m_adjacencyList.findById(id);
    if (adjacent == m_adjacencyList.end()) {
      return;
    }
  
    // If this adjacency has a Face, just proceed as usual.
    if(adjacent->getFaceId() != 0) {
+     const auto& interestName = getHelloInterestName(id, adjacent->getName());
+     expressInterest(interestName, m_confParam.getInterestResendTime());
+     NLSR_LOG_DEBUG("Sending HELLO interest: " << interestName);
+   }
+ 
+   // replaces a pending Hello timer of the neighbor, so that there is one Hello chain per neighbor
+   m_helloWheel.schedule(id, getJitteredHelloInterval(id));
+ }
+
+ const ndn::Name&
+ HelloProtocol::getHelloInterestName(NeighborId id, const ndn::Name& neighbor)
+ {
+   if (id >= m_helloInterestNames.size()) {
+     m_helloInterestNames.resize(id + 1);
+   }
+
+   // IDs are reassigned when the adjacency list is reset
+   auto& interestName = m_helloInterestNames[id];
+   if (interestName.size() != neighbor.size() + 3 || !neighbor.isPrefixOf(interestName)) {
      // interest name: /<neighbor>/NLSR/INFO/<router>
-     ndn::Name interestName = adjacent->getName() ;
+     interestName = neighbor;
      interestName.append(NLSR_COMPONENT);
      interestName.append(INFO_COMPONENT);
      interestName.append(ndn::tlv::GenericNameComponent, m_confParam.getRouterPrefix().wireEncode());
-     expressInterest(interestName, m_confParam.getInterestResendTime());
-     NLSR_LOG_DEBUG("Sending HELLO interest: " << interestName);
+     // Interests copy the cached encoding
+     interestName.wireEncode();
    }
- 
-   m_scheduler.schedule(ndn::time::seconds(m_confParam.getInfoInterestInterval()),
-                        [this, neighbor] { sendHelloInterest(neighbor); });
+   return interestName;
+ }
+
+ ndn::time::seconds
+ HelloProtocol::getHelloInterval(NeighborId id)
+ {
+   if (id >= m_helloPacing.size()) {
+     m_helloPacing.resize(id + 1);
+   }
+   auto interval = m_helloPacing[id].interval;
+   return interval > 0_s ? interval : ndn::time::seconds(m_confParam.getInfoInterestInterval());
+ }
+
+ ndn::time::milliseconds
+ HelloProtocol::getJitteredHelloInterval(NeighborId id)
+ {
+   // Up to 10% either way, so that the Hellos to neighbors added together drift apart
+   ndn::time::milliseconds interval = getHelloInterval(id);
+   auto maxJitter = interval / 10;
+   auto jitter = ndn::random::generateWord64() % (2 * static_cast<uint64_t>(maxJitter.count()) + 1);
+   return interval - maxJitter + ndn::time::milliseconds(jitter);
+ }
+
+ void
+ HelloProtocol::backOffHelloInterval(const ndn::Name& neighbor)
+ {
+   auto cap = ndn::time::seconds(m_confParam.getHelloIntervalCap());
+   auto id = m_adjacencyList.getNeighborId(neighbor);
+   if (cap <= 0_s || !id) {
+     return;
+   }
+
+   auto interval = std::min(2 * getHelloInterval(*id), cap);
+   if (interval != m_helloPacing[*id].interval) {
+     m_helloPacing[*id].interval = interval;
+     NLSR_LOG_DEBUG("Hello interval of " << neighbor << " backed off to " << interval);
+   }
+ }
+
+ void
+ HelloProtocol::resetHelloInterval(const ndn::Name& neighbor)
+ {
+   auto id = m_adjacencyList.getNeighborId(neighbor);
+   if (!id || *id >= m_helloPacing.size() || m_helloPacing[*id].interval <= 0_s) {
+     return;
+   }
+
+   m_helloPacing[*id].interval = 0_s;
+   NLSR_LOG_DEBUG("Hello interval of " << neighbor << " reset to hello-interval");
+   // the pending Hello may be up to the cap away
+   m_helloWheel.schedule(*id, getJitteredHelloInterval(*id));
  }
  //处理收到的hello interest
  void
@@ -118,13 +211,13 @@
                                 const ndn::Interest& interest)
  {
    // interest name: /<neighbor>/NLSR/INFO/<router>
-   const ndn::Name interestName = interest.getName();
+   const ndn::Name& interestName = interest.getName();
  
    // increment RCV_HELLO_INTEREST
-   hpIncrementSignal(Statistics::PacketType::RCV_HELLO_INTEREST);
+   countPacket(Statistics::PacketType::RCV_HELLO_INTEREST);
  
    NLSR_LOG_DEBUG("Interest received for Name: " << interestName);
-   if (interestName.get(-2).toUri() != INFO_COMPONENT) {
+   if (interestName.get(-2) != INFO_NAME_COMPONENT) {
      NLSR_LOG_DEBUG("INFO_COMPONENT not found or Interest Name " << interestName
                     << " does not match expression");
      return;
@@ -132,22 +225,14 @@
  
    ndn::Name neighbor(interestName.get(-1).blockFromValue());
    NLSR_LOG_DEBUG("Neighbor: " << neighbor);
-   if (m_adjacencyList.isNeighbor(neighbor)) {
-     auto data = std::make_shared<ndn::Data>();
-     data->setName(ndn::Name(interest.getName()).appendVersion());
-     // A Hello reply being cached longer than is needed to fufill an Interest
-     // can cause counterintuitive behavior. Consequently, we use the default
-     // minimum of 0 ms.
-     data->setFreshnessPeriod(0_ms);
-     data->setContent(ndn::make_span(reinterpret_cast<const uint8_t*>(INFO_COMPONENT.data()),
-                                     INFO_COMPONENT.size()));
-        
-     m_keyChain.sign(*data, m_signingInfo);
- 
+   if (auto* traffic = m_adjacencyList.findControlTraffic(neighbor); traffic != nullptr) {
      NLSR_LOG_DEBUG("Sending out data for name: " << interest.getName());
-     m_face.put(*data);
+     auto reply = makeHelloReply(interestName, neighbor);
+     m_face.put(*reply);
+     traffic->countInterestReceived(ControlTraffic::MessageClass::HELLO, interest);
+     traffic->countDataSent(ControlTraffic::MessageClass::HELLO, *reply);
      // increment SENT_HELLO_DATA
-     hpIncrementSignal(Statistics::PacketType::SENT_HELLO_DATA);
+     countPacket(Statistics::PacketType::SENT_HELLO_DATA);
    
      auto adjacent = m_adjacencyList.findAdjacent(neighbor);
      // If this neighbor was previously inactive, send our own hello interest, too
@@ -156,16 +241,43 @@
        restoreRouteForHelloRecovery(neighbor);
        // We can only do that if the neighbor currently has a face.
        if (adjacent->getFaceId() != 0) {
-         // interest name: /<neighbor>/NLSR/INFO/<router>
-         ndn::Name interestName(neighbor);
-         interestName.append(NLSR_COMPONENT);
-         interestName.append(INFO_COMPONENT);
-         interestName.append(ndn::tlv::GenericNameComponent, m_confParam.getRouterPrefix().wireEncode());
-         expressInterest(interestName, m_confParam.getInterestResendTime());
+         expressInterest(getHelloInterestName(*m_adjacencyList.getNeighborId(neighbor), neighbor),
+                         m_confParam.getInterestResendTime());
        }
      }
    }
  }
+ std::shared_ptr<const ndn::Data>
+ HelloProtocol::makeHelloReply(const ndn::Name& interestName, const ndn::Name& neighbor)
+ {
+   auto now = ndn::time::steady_clock::now();
+   auto id = m_adjacencyList.getNeighborId(neighbor);
+   auto reuse = m_confParam.getHelloSignatureReuse();
+   if (id && reuse > 0_s) {
+     auto it = m_helloReplies.find(*id);
+     if (it != m_helloReplies.end() && now < it->second.signedAt + reuse &&
+         it->second.data->getName().getPrefix(-1) == interestName) {
+       NLSR_LOG_TRACE("Reusing Hello reply signed for " << neighbor);
+       return it->second.data;
+     }
+   }
+
+   auto data = std::make_shared<ndn::Data>();
+   data->setName(ndn::Name(interestName).appendVersion());
+   // A Hello reply being cached longer than is needed to fufill an Interest
+   // can cause counterintuitive behavior. Consequently, we use the default
+   // minimum of 0 ms.
+   data->setFreshnessPeriod(0_ms);
+   data->setContent(ndn::make_span(reinterpret_cast<const uint8_t*>(INFO_COMPONENT.data()),
+                                   INFO_COMPONENT.size()));
+   m_keyChain.sign(*data, m_signingInfo);
+
+   if (id && reuse > 0_s) {
+     m_helloReplies[*id] = {data, now};
+   }
+   return data;
+ }
+
  //2025.09.22 新增处理hello interest超时后的路由恢复机制
  void
  HelloProtocol::restoreRouteForHelloRecovery(const ndn::Name& neighbor)
@@ -189,19 +301,20 @@
     return;
   }
 
+  resetHelloInterval(neighbor);
+
   // Rate limiting check
-  static std::map<ndn::Name, ndn::time::steady_clock::time_point> s_lastRestoreTime;
+  auto id = *m_adjacencyList.getNeighborId(neighbor);
+  if (id >= m_helloPacing.size()) {
+    m_helloPacing.resize(id + 1);
+  }
+  auto& lastRestore = m_helloPacing[id].lastRestore;
   auto now = ndn::time::steady_clock::now();
-  
-  auto it = s_lastRestoreTime.find(neighbor);
-  if (it != s_lastRestoreTime.end()) {
-    auto timeSince = now - it->second;
-    if (timeSince < ndn::time::seconds(5)) {
-      NLSR_LOG_DEBUG("HELLO_RECOVERY: Rate limiting - ignoring rapid recovery for " << neighbor);
-      return;
-    }
+  if (now - lastRestore < ndn::time::seconds(5)) {
+    NLSR_LOG_DEBUG("HELLO_RECOVERY: Rate limiting - ignoring rapid recovery for " << neighbor);
+    return;
   }
-  s_lastRestoreTime[neighbor] = now;
+  lastRestore = now;
 
   try {
     // Create temporary nexthop list with only this neighbor
@@ -229,9 +342,9 @@
  HelloProtocol::processInterestTimedOut(const ndn::Interest& interest)
  {
    // interest name: /<neighbor>/NLSR/INFO/<router>
-   const ndn::Name interestName(interest.getName());
+   const ndn::Name& interestName = interest.getName();
    NLSR_LOG_DEBUG("Interest timed out for Name: " << interestName);
-   if (interestName.get(-2).toUri() != INFO_COMPONENT) {
+   if (interestName.get(-2) != INFO_NAME_COMPONENT) {
      return;
    }
    ndn::Name neighbor = interestName.getPrefix(-3);
@@ -246,14 +359,13 @@
  
    // Emit signal for Hello timeout (Option A) 发送事件信号告诉LCM,这个时候LCM会怎么处理
    onTimeout(neighbor, infoIntTimedOutCount);
+   resetHelloInterval(neighbor);
    if (infoIntTimedOutCount < m_confParam.getInterestRetryNumber()) {
-     // interest name: /<neighbor>/NLSR/INFO/<router>
-     ndn::Name interestName(neighbor);
-     interestName.append(NLSR_COMPONENT);
-     interestName.append(INFO_COMPONENT);
-     interestName.append(ndn::tlv::GenericNameComponent, m_confParam.getRouterPrefix().wireEncode());
-     NLSR_LOG_DEBUG("Resending interest: " << interestName);
-     expressInterest(interestName, m_confParam.getInterestResendTime());
+     if (auto id = m_adjacencyList.getNeighborId(neighbor); id) {
+       const auto& interestName = getHelloInterestName(*id, neighbor);
+       NLSR_LOG_DEBUG("Resending interest: " << interestName);
+       expressInterest(interestName, m_confParam.getInterestResendTime());
+     }
    }
    else if (status == Adjacent::STATUS_ACTIVE) {
      m_adjacencyList.setStatusOfNeighbor(neighbor, Adjacent::STATUS_INACTIVE);//设定此时的状态为INACTIVE
@@ -263,6 +375,13 @@
      // Emit signal for neighbor status change to INACTIVE (Option A)
     onNeighborStatusChanged(neighbor, Adjacent::STATUS_INACTIVE);
  
+     if (m_tracer != nullptr) {
+       m_tracer->begin(ConvergenceStage::HELLO_TIMEOUT, neighbor,
+                       m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON ?
+                       ConvergenceTracer::LOCAL_ROUTING_PATH :
+                       ConvergenceTracer::LOCAL_ADJACENCY_PATH);
+     }
+
      if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
        m_routingTable.scheduleRoutingTableCalculation();//触发路由表计算
      }
@@ -272,31 +391,118 @@
    }
  }
  
+ void
+ HelloProtocol::onLivenessLost(const ndn::Name& neighbor)
+ {
+   if (m_adjacencyList.getStatusOfNeighbor(neighbor) != Adjacent::STATUS_ACTIVE) {
+     return;
+   }
+
+   m_adjacencyList.setStatusOfNeighbor(neighbor, Adjacent::STATUS_INACTIVE);
+   // as if all Hello retries had timed out, so that the next Hello timeout keeps it INACTIVE
+   m_adjacencyList.setTimedOutInterestCount(neighbor, m_confParam.getInterestRetryNumber());
+   NLSR_LOG_INFO("Neighbor: " << neighbor << " status changed to INACTIVE by liveness probes");
+
+   onNeighborStatusChanged(neighbor, Adjacent::STATUS_INACTIVE);
+   resetHelloInterval(neighbor);
+
+   if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
+     m_routingTable.scheduleRoutingTableCalculation();
+   }
+   else {
+     m_lsdb.scheduleAdjLsaBuild();
+   }
+ }
+
  // This is the first function that incoming Hello data will
  // see. This checks if the data appears to be signed, and passes it
  // on to validate the content of the data.
  void
- HelloProtocol::onContent(const ndn::Interest& interest, const ndn::Data& data)
+ HelloProtocol::onContent(const ndn::Interest& interest, const ndn::Data& data,
+                          ndn::time::steady_clock::duration rtt)
  {
    NLSR_LOG_DEBUG("Received data for INFO(name): " << data.getName());
+   // interest name: /<neighbor>/NLSR/INFO/<router>
+   auto* traffic = m_adjacencyList.findControlTraffic(interest.getName().getPrefix(-3));
+   if (traffic != nullptr) {
+     traffic->countDataReceived(ControlTraffic::MessageClass::HELLO, data);
+   }
    auto kl = data.getKeyLocator();
    if (kl && kl->getType() == ndn::tlv::Name) {
      NLSR_LOG_DEBUG("Data signed with: " << kl->getName());
    }
+   // The round trip is measured on arrival, so that validation time is not counted.
+   auto afterValidation = [this, rtt] (const ndn::Data& data) {
+     onContentValidated(data);
+     if (data.getName().get(-3) == INFO_NAME_COMPONENT) {
+       onRttMeasured(data.getName().getPrefix(-4), rtt);
+       onCongestionSample(data.getName().getPrefix(-4), data.getCongestionMark() > 0);
+     }
+   };
+
+   if (isReusedHelloReply(data)) {
+     NLSR_LOG_TRACE("Hello reply already validated: " << data.getName());
+     afterValidation(data);
+     return;
+   }
+
    m_confParam.getValidator().validate(data,
-                                       std::bind(&HelloProtocol::onContentValidated, this, _1),
+                                       [this, afterValidation] (const ndn::Data& data) {
+                                         rememberValidatedHelloReply(data);
+                                         afterValidation(data);
+                                       },
                                        std::bind(&HelloProtocol::onContentValidationFailed,
                                                  this, _1, _2));
  }
+
+ bool
+ HelloProtocol::isReusedHelloReply(const ndn::Data& data) const
+ {
+   // data name: /<neighbor>/NLSR/INFO/<router>/<version>
+   const auto& dataName = data.getName();
+   auto reuse = m_confParam.getHelloSignatureReuse();
+   if (reuse <= 0_s || dataName.size() < 4 || !dataName[-1].isVersion() ||
+       dataName[-3] != INFO_NAME_COMPONENT) {
+     return false;
+   }
+
+   auto id = m_adjacencyList.getNeighborId(dataName.getPrefix(-4));
+   if (!id) {
+     return false;
+   }
+   auto it = m_validatedHelloReplies.find(*id);
+   if (it == m_validatedHelloReplies.end() || it->second != data.wireEncode()) {
+     return false;
+   }
+
+   // A replayed reply is accepted no longer than the signer would have sent it
+   auto signedAt = ndn::time::fromUnixTimestamp(ndn::time::milliseconds(dataName[-1].toVersion()));
+   return ndn::time::system_clock::now() <= signedAt + reuse;
+ }
+
+ void
+ HelloProtocol::rememberValidatedHelloReply(const ndn::Data& data)
+ {
+   const auto& dataName = data.getName();
+   if (m_confParam.getHelloSignatureReuse() <= 0_s || dataName.size() < 4 ||
+       dataName[-3] != INFO_NAME_COMPONENT) {
+     return;
+   }
+
+   auto id = m_adjacencyList.getNeighborId(dataName.getPrefix(-4));
+   if (id) {
+     m_validatedHelloReplies[*id] = data.wireEncode();
+   }
+ }
  
  void
  HelloProtocol::onContentValidated(const ndn::Data& data)
  {
    // data name: /<neighbor>/NLSR/INFO/<router>/<version>
-   ndn::Name dataName = data.getName();
+   const ndn::Name& dataName = data.getName();
    NLSR_LOG_DEBUG("Data validation successful for INFO(name): " << dataName);
  
-   if (dataName.get(-3).toUri() == INFO_COMPONENT) {
+   if (dataName.get(-3) == INFO_NAME_COMPONENT) {
      ndn::Name neighbor = dataName.getPrefix(-4);
  
      Adjacent::Status oldStatus = m_adjacencyList.getStatusOfNeighbor(neighbor);
@@ -309,6 +515,10 @@
  
      // Emit signal for Hello Data received (Option A)
     onDataReceived(neighbor);
+
+     if (oldStatus == Adjacent::STATUS_ACTIVE) {
+       backOffHelloInterval(neighbor);
+     }
  
      // change in Adjacency list
      if ((oldStatus - newStatus) != 0) {
@@ -328,7 +538,7 @@
      }
    }
    // increment RCV_HELLO_DATA
-   hpIncrementSignal(Statistics::PacketType::RCV_HELLO_DATA);
+   countPacket(Statistics::PacketType::RCV_HELLO_DATA);
  }
  
  void
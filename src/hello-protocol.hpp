@@ -23,15 +23,20 @@
  #define NLSR_HELLO_PROTOCOL_HPP
  
  #include "conf-parameter.hpp"
+ #include "convergence-tracer.hpp"
+ #include "liveness-detector.hpp"
  #include "lsdb.hpp"
  #include "route/routing-table.hpp"
  #include "statistics.hpp"
  #include "test-access-control.hpp"
+ #include "timer-wheel.hpp"
  
  #include <ndn-cxx/face.hpp>
  #include <ndn-cxx/security/validation-error.hpp>
  #include <ndn-cxx/util/scheduler.hpp>
  #include <ndn-cxx/util/signal.hpp>
+
+ #include <unordered_map>
  
  namespace nlsr {
  
@@ -68,6 +73,9 @@
     */
    void
    sendHelloInterest(const ndn::Name& neighbor);
+
+   void
+   sendHelloInterest(NeighborId id);
  
    /*! \brief Processes a Hello Interest from a neighbor.
     *
@@ -86,13 +94,34 @@
    void
    processInterest(const ndn::Name& name, const ndn::Interest& interest);
  
-   ndn::signal::Signal<HelloProtocol, Statistics::PacketType> hpIncrementSignal;
+   /*! \brief Count the Hello packets in \p stats; nullptr to stop counting them.
+    */
+   void
+   setStatistics(Statistics* stats)
+   {
+     m_stats = stats;
+   }
+
+   /*! \brief Begin a convergence trace when a neighbor is declared INACTIVE after its Hello
+    *         Interests time out; nullptr to stop tracing.
+    */
+   void
+   setConvergenceTracer(ConvergenceTracer* tracer)
+   {
+     m_tracer = tracer;
+   }
 
   // Signals for LinkCostManager integration (Option A)
   ndn::signal::Signal<HelloProtocol, const ndn::Name&> onInterestSent;
   ndn::signal::Signal<HelloProtocol, const ndn::Name&> onDataReceived;
   ndn::signal::Signal<HelloProtocol, const ndn::Name&, uint32_t> onTimeout;
   ndn::signal::Signal<HelloProtocol, const ndn::Name&, Adjacent::Status> onNeighborStatusChanged;
+  /*! \brief Emitted with the round-trip time of each validated Hello exchange.
+   */
+  ndn::signal::Signal<HelloProtocol, const ndn::Name&, ndn::time::steady_clock::duration> onRttMeasured;
+  /*! \brief Emitted for each validated Hello Data, with whether NFD marked it as congested.
+   */
+  ndn::signal::Signal<HelloProtocol, const ndn::Name&, bool> onCongestionSample;
 
 private:
    /*! \brief Try to contact a neighbor via Hello protocol again
@@ -110,7 +139,46 @@ private:
    /*! \brief Verify signatures and validate incoming Hello data.
     */
    void
-   onContent(const ndn::Interest& interest, const ndn::Data& data);
+   onContent(const ndn::Interest& interest, const ndn::Data& data,
+             ndn::time::steady_clock::duration rtt);
+
+   /*! \brief Returns the current Hello interval of a neighbor with up to 10% of random jitter.
+    */
+   ndn::time::milliseconds
+   getJitteredHelloInterval(NeighborId id);
+
+   /*! \brief Doubles the Hello interval of a neighbor that stayed ACTIVE, up to the cap.
+    *
+    * \sa nlsr::ConfParameter::getHelloIntervalCap
+    */
+   void
+   backOffHelloInterval(const ndn::Name& neighbor);
+
+   /*! \brief Brings the Hello interval of a neighbor back to hello-interval.
+    *
+    * Called on Hello timeouts, Nacks and recoveries, so that the neighbor is probed at the
+    * fast rate until it is stable again.
+    */
+   void
+   resetHelloInterval(const ndn::Name& neighbor);
+
+   /*! \brief Returns whether a Hello reply is identical to the last one validated from its
+    *         neighbor and recent enough to skip validating it again.
+    *
+    * \sa nlsr::ConfParameter::getHelloSignatureReuse
+    */
+   bool
+   isReusedHelloReply(const ndn::Data& data) const;
+
+   void
+   rememberValidatedHelloReply(const ndn::Data& data);
+
+   /*! \brief Marks an active neighbor INACTIVE when its liveness probes go unanswered.
+    *
+    * The neighbor becomes ACTIVE again through its Hellos, as after Hello timeouts.
+    */
+   void
+   onLivenessLost(const ndn::Name& neighbor);
 
    //2025.09.22 新增处理
    void
@@ -118,7 +186,24 @@ private:
 
 
  PUBLIC_WITH_TESTS_ELSE_PRIVATE:
- 
+   /*! \brief Returns the current Hello interval of a neighbor.
+    */
+   ndn::time::seconds
+   getHelloInterval(NeighborId id);
+
+   /*! \brief Returns the name of the Hello Interests to a neighbor, built and encoded once.
+    */
+   const ndn::Name&
+   getHelloInterestName(NeighborId id, const ndn::Name& neighbor);
+
+   /*! \brief Returns the signed reply to a Hello Interest from a neighbor.
+    *
+    * With hello-signature-reuse, the reply signed for the neighbor is sent again until it is
+    * that old, instead of signing a new one for each Hello.
+    */
+   std::shared_ptr<const ndn::Data>
+   makeHelloReply(const ndn::Name& interestName, const ndn::Name& neighbor);
+
    /*! \brief Change a neighbor's status
     *
     * Whenever incoming Hello data is verified and validated, change
@@ -135,16 +220,32 @@ private:
    void
    onContentValidationFailed(const ndn::Data& data,
                              const ndn::security::ValidationError& ve);
+
+   void
+   countPacket(Statistics::PacketType type)
+   {
+     if (m_stats != nullptr) {
+       m_stats->increment(type);
+     }
+   }
  
  public:
    static inline const std::string INFO_COMPONENT{"INFO"};
    static inline const std::string NLSR_COMPONENT{"nlsr"};
+   // encoded once, to be compared with the components of received names
+   static inline const ndn::name::Component INFO_NAME_COMPONENT{"INFO"};
+   static inline const ndn::name::Component NLSR_NAME_COMPONENT{"nlsr"};
+   // Hello intervals are whole seconds
+   static constexpr ndn::time::milliseconds HELLO_TIMER_TICK{1000};
+   static constexpr size_t HELLO_TIMER_SLOTS = 64;
  
    ndn::signal::Signal<HelloProtocol, const ndn::Name&> onInitialHelloDataValidated;
  
  private:
    ndn::Face& m_face;
    ndn::Scheduler m_scheduler;
+   // Periodic Hello timers, keyed by NeighborId
+   TimerWheel m_helloWheel;
    ndn::security::KeyChain& m_keyChain;
    const ndn::security::SigningInfo& m_signingInfo;
    ConfParameter& m_confParam;
@@ -152,6 +253,30 @@ private:
    Lsdb& m_lsdb;
    AdjacencyList& m_adjacencyList;
    Nlsr& m_nlsr;  // Added for LinkCostManager integration
+   Statistics* m_stats = nullptr;
+   ConvergenceTracer* m_tracer = nullptr;
+
+   struct SignedHelloReply
+   {
+     std::shared_ptr<const ndn::Data> data;
+     ndn::time::steady_clock::time_point signedAt;
+   };
+   // The Hello replies signed for each neighbor and the last ones validated from each
+   // neighbor, keyed by NeighborId, when hello-signature-reuse is enabled
+   std::unordered_map<NeighborId, SignedHelloReply> m_helloReplies;
+   std::unordered_map<NeighborId, ndn::Block> m_validatedHelloReplies;
+   // Hello Interest names, indexed by NeighborId
+   std::vector<ndn::Name> m_helloInterestNames;
+
+   struct HelloPacing
+   {
+     /// 0 until the neighbor backs off from hello-interval
+     ndn::time::seconds interval{0};
+     ndn::time::steady_clock::time_point lastRestore;
+   };
+   // indexed by NeighborId
+   std::vector<HelloPacing> m_helloPacing;
+   LivenessDetector m_livenessDetector;
  };
  
  } // namespace nlsr
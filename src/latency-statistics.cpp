@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "latency-statistics.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nlsr {
+
+template<ndn::encoding::Tag TAG>
+size_t
+LatencyStatus::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto it = m_stages.rbegin(); it != m_stages.rend(); ++it) {
+    size_t stageLength = 0;
+    stageLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::MaxDuration, it->max.count());
+    stageLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::P99Duration, it->p99.count());
+    stageLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::P90Duration, it->p90.count());
+    stageLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::MedianDuration,
+                                                  it->median.count());
+    stageLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::SampleCount, it->count);
+    stageLength += prependStringBlock(block, nlsr::tlv::PhaseName, it->stage);
+    stageLength += block.prependVarNumber(stageLength);
+    stageLength += block.prependVarNumber(nlsr::tlv::StageLatency);
+    totalLength += stageLength;
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::LatencyStatistics);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(LatencyStatus);
+
+ndn::Block
+LatencyStatus::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  return buffer.block();
+}
+
+void
+LatencyStatus::wireDecode(const ndn::Block& wire)
+{
+  m_stages.clear();
+
+  if (wire.type() != nlsr::tlv::LatencyStatistics) {
+    NDN_THROW(Error("LatencyStatistics", wire.type()));
+  }
+
+  wire.parse();
+  for (const auto& element : wire.elements()) {
+    if (element.type() != nlsr::tlv::StageLatency) {
+      NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(element.type()) +
+                      " in LatencyStatistics"));
+    }
+
+    element.parse();
+    const auto& fields = element.elements();
+    if (fields.size() != 6 ||
+        fields[0].type() != nlsr::tlv::PhaseName ||
+        fields[1].type() != nlsr::tlv::SampleCount ||
+        fields[2].type() != nlsr::tlv::MedianDuration ||
+        fields[3].type() != nlsr::tlv::P90Duration ||
+        fields[4].type() != nlsr::tlv::P99Duration ||
+        fields[5].type() != nlsr::tlv::MaxDuration) {
+      NDN_THROW(Error("Malformed StageLatency"));
+    }
+
+    using ndn::encoding::readNonNegativeInteger;
+    StageLatency latency;
+    latency.stage = readString(fields[0]);
+    latency.count = readNonNegativeInteger(fields[1]);
+    latency.median = ndn::time::microseconds(readNonNegativeInteger(fields[2]));
+    latency.p90 = ndn::time::microseconds(readNonNegativeInteger(fields[3]));
+    latency.p99 = ndn::time::microseconds(readNonNegativeInteger(fields[4]));
+    latency.max = ndn::time::microseconds(readNonNegativeInteger(fields[5]));
+    m_stages.push_back(std::move(latency));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LatencyStatus& status)
+{
+  os << "Latency (microseconds):\n";
+  if (status.getStages().empty()) {
+    os << "  no samples\n";
+  }
+  for (const auto& latency : status.getStages()) {
+    os << "  " << latency.stage << ": count=" << latency.count
+       << " median=" << latency.median.count() << " p90=" << latency.p90.count()
+       << " p99=" << latency.p99.count() << " max=" << latency.max.count() << "\n";
+  }
+  return os;
+}
+
+const char*
+LatencyStatistics::getStageName(Stage stage)
+{
+  switch (stage) {
+    case STAGE_FETCH_NAME_LSA:
+      return "fetch-name-lsa";
+    case STAGE_FETCH_ADJACENCY_LSA:
+      return "fetch-adjacency-lsa";
+    case STAGE_FETCH_COORDINATE_LSA:
+      return "fetch-coordinate-lsa";
+    case STAGE_VALIDATE_SEGMENT:
+      return "validate-segment";
+    case STAGE_SYNC_TO_INSTALL:
+      return "sync-to-install";
+    case STAGE_RIB_REGISTER:
+      return "rib-register";
+    case STAGE_RIB_UNREGISTER:
+      return "rib-unregister";
+    case N_STAGES:
+      break;
+  }
+  return "unknown";
+}
+
+void
+LatencyStatistics::resetAll()
+{
+  for (auto& histogram : m_histograms) {
+    histogram.reset();
+  }
+}
+
+LatencyStatus
+LatencyStatistics::getStatus() const
+{
+  LatencyStatus status;
+  for (size_t stage = 0; stage < N_STAGES; ++stage) {
+    const auto& histogram = m_histograms[stage];
+    if (histogram.getCount() == 0) {
+      continue;
+    }
+
+    LatencyStatus::StageLatency latency;
+    latency.stage = getStageName(static_cast<Stage>(stage));
+    latency.count = histogram.getCount();
+    latency.median = histogram.getQuantile(0.5);
+    latency.p90 = histogram.getQuantile(0.9);
+    latency.p99 = histogram.getQuantile(0.99);
+    latency.max = histogram.getMax();
+    status.addStage(std::move(latency));
+  }
+  return status;
+}
+
+} // namespace nlsr
@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LATENCY_STATISTICS_HPP
+#define NLSR_LATENCY_STATISTICS_HPP
+
+#include "rtt-histogram.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <string>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Latency percentiles of the stages of LSA retrieval and route installation, as
+ *         served by the latency/list dataset.
+ *
+ *     LatencyStatistics = LATENCY-STATISTICS-TYPE TLV-LENGTH
+ *                           *StageLatency
+ *
+ *     StageLatency = STAGE-LATENCY-TYPE TLV-LENGTH
+ *                      PhaseName      ; name of the stage
+ *                      SampleCount    ; samples since the last reset, NonNegativeInteger
+ *                      MedianDuration ; microseconds, NonNegativeInteger
+ *                      P90Duration    ; microseconds, NonNegativeInteger
+ *                      P99Duration    ; microseconds, NonNegativeInteger
+ *                      MaxDuration    ; microseconds, NonNegativeInteger
+ */
+class LatencyStatus
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  struct StageLatency
+  {
+    std::string stage;
+    uint64_t count = 0;
+    ndn::time::microseconds median{0};
+    ndn::time::microseconds p90{0};
+    ndn::time::microseconds p99{0};
+    ndn::time::microseconds max{0};
+  };
+
+  LatencyStatus() = default;
+
+  explicit
+  LatencyStatus(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  const std::vector<StageLatency>&
+  getStages() const
+  {
+    return m_stages;
+  }
+
+  void
+  addStage(StageLatency latency)
+  {
+    m_stages.push_back(std::move(latency));
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+private:
+  std::vector<StageLatency> m_stages;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LatencyStatus& status);
+
+/*! \brief Histograms of the latencies of LSA retrieval and route installation.
+ *
+ * They tell whether slow convergence is spent in the network, fetching LSAs, in validating
+ * their segments, or in NFD, installing the routes. Each stage has a fixed-memory log-linear
+ * histogram, which counts samples until reset. Samples are recorded and read on the io thread.
+ */
+class LatencyStatistics : boost::noncopyable
+{
+public:
+  enum Stage : size_t {
+    /// from the first Interest to the last segment of a Name LSA
+    STAGE_FETCH_NAME_LSA,
+    STAGE_FETCH_ADJACENCY_LSA,
+    STAGE_FETCH_COORDINATE_LSA,
+    /// from the arrival of an LSA segment to the end of its validation
+    STAGE_VALIDATE_SEGMENT,
+    /// from the Sync notification of a new LSA to its installation in the LSDB
+    STAGE_SYNC_TO_INSTALL,
+    /// from a rib/register or rib/unregister command to the response of NFD
+    STAGE_RIB_REGISTER,
+    STAGE_RIB_UNREGISTER,
+    N_STAGES
+  };
+
+  void
+  record(Stage stage, ndn::time::nanoseconds duration)
+  {
+    m_histograms[stage].add(duration);
+  }
+
+  const RttHistogram&
+  get(Stage stage) const
+  {
+    return m_histograms[stage];
+  }
+
+  void
+  resetAll();
+
+  LatencyStatus
+  getStatus() const;
+
+  static const char*
+  getStageName(Stage stage);
+
+private:
+  std::array<RttHistogram, N_STAGES> m_histograms;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LATENCY_STATISTICS_HPP
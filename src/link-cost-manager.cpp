@@ -1,7 +1,12 @@
 #include "link-cost-manager.hpp"
 #include "logger.hpp"
+#include "route/load-aware-routing-calculator.hpp"
+#include "route/ml-adaptive-calculator.hpp"
 
+#include <ndn-cxx/mgmt/control-response.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
 #include <ndn-cxx/util/random.hpp>
+#include <algorithm>
 #include <cmath>
 
 #include <iomanip>  // 用于std::setprecision
@@ -23,6 +28,8 @@ LinkCostManager::LinkCostManager(ndn::Face& face, ndn::KeyChain& keyChain,
   , m_routingTable(routingTable)  //初始化RoutingTable
   , m_fib(fib)
   , m_scheduler(face.getIoContext())  // 正确：使用getIoContext()
+  , m_measurementWheel(m_scheduler, MEASUREMENT_TIMER_TICK, MEASUREMENT_TIMER_SLOTS,
+                       [this] (NeighborId id) { onMeasurementTimer(id); })
   , m_isActive(false)
   , m_nextSequenceNumber(1)
 {
@@ -31,14 +38,14 @@ LinkCostManager::LinkCostManager(ndn::Face& face, ndn::KeyChain& keyChain,
  
  NLSR_LOG_DEBUG("Registering RTT probe prefix: " << rttPrefix);
  
+ // Probe replies only carry the name back, so they are prepared once and
+ // protected with a DigestSha256 instead of a full signature.
+ m_rttProbeReply.setContent(ndn::encoding::makeStringBlock(ndn::tlv::Content, "rtt-response"));
+ m_rttProbeReply.setFreshnessPeriod(ndn::time::milliseconds(1000));
+
  m_face.setInterestFilter(rttPrefix,
    [this](const auto& name, const auto& interest) {
-     auto data = std::make_shared<ndn::Data>(interest.getName());
-     data->setContent(ndn::encoding::makeStringBlock(ndn::tlv::Content, "rtt-response"));
-     data->setFreshnessPeriod(ndn::time::milliseconds(1000));
-     m_keyChain.sign(*data, m_confParam.getSigningInfo());
-     m_face.put(*data);
-     NLSR_LOG_TRACE("RTT response sent for: " << interest.getName());
+     processRttProbe(interest);
    },
    [](const auto& name) {
      NLSR_LOG_DEBUG("RTT probe prefix registered: " << name);
@@ -91,23 +98,103 @@ void
 LinkCostManager::initialize()
 {
   NLSR_LOG_INFO("Initializing Link Cost Manager");
-  
+
+  m_outgoingLinks.clear();
+  m_outgoingLinks.reserve(m_adjacencyList.size());
+  addNewNeighbors();
+
+  if (m_confParam.getCostDamping()) {
+    m_costDamping.emplace(ndn::time::seconds(m_confParam.getCostDampingHalfLife()),
+                          m_confParam.getCostDampingSuppress(), m_confParam.getCostDampingReuse());
+  }
+  if (m_confParam.getCostBuckets() > 0) {
+    m_costQuantizer.emplace(m_confParam.getCostBuckets(), m_maxCostMultiplier);
+  }
+  if (m_confParam.getRttSpikeFilter() > 0) {
+    m_spikeFilter.emplace(m_confParam.getRttSpikeFilter());
+  }
+
+  if (!m_confParam.getMetricsSocketPath().empty() && m_metricsIngestor == nullptr) {
+    m_metricsIngestor = std::make_unique<MetricsIngestor>(m_face.getIoContext(),
+      [this] (const auto& entries) { applyExternalMetrics(entries); });
+    try {
+      m_metricsIngestor->listen(m_confParam.getMetricsSocketPath());
+    }
+    catch (const boost::system::system_error& e) {
+      NLSR_LOG_ERROR("Cannot listen for external metrics on "
+                     << m_confParam.getMetricsSocketPath() << ": " << e.what());
+      m_metricsIngestor.reset();
+    }
+  }
+
+  if (!m_confParam.getLinkSampleTracePath().empty() && m_sampleRecorder == nullptr) {
+    try {
+      m_sampleRecorder = std::make_unique<LinkSampleRecorder>(m_confParam.getLinkSampleTracePath());
+    }
+    catch (const std::runtime_error& e) {
+      NLSR_LOG_ERROR(e.what());
+    }
+  }
+
+  if (m_confParam.getFaceCounterInterval() > 0 && m_faceCounterCollector == nullptr) {
+    m_faceCounterCollector = std::make_unique<FaceCounterCollector>(m_face, m_keyChain,
+      ndn::time::seconds(m_confParam.getFaceCounterInterval()),
+      [this] (uint64_t faceId) { return m_adjacencyList.findAdjacent(faceId) != m_adjacencyList.end(); },
+      [this] (const auto& loads) { applyFaceLoads(loads); });
+  }
+
+  NLSR_LOG_INFO("Link Cost Manager initialized with " << m_outgoingLinks.size() << " neighbors");
+}
+
+void
+LinkCostManager::updateNeighbors()
+{
+  for (auto& linkState : m_outgoingLinks) {
+    auto adjacent = m_adjacencyList.findById(linkState.neighborId);
+    if (adjacent == m_adjacencyList.end()) {
+      // removed by a reload; its ID is not reused
+      linkState.status = Adjacent::STATUS_INACTIVE;
+    }
+    else {
+      linkState.originalCost = adjacent->getOriginalLinkCost();
+    }
+  }
+  addNewNeighbors();
+}
+
+void
+LinkCostManager::addNewNeighbors()
+{
+  // the adjacency list is iterated in insertion order, i.e. by increasing NeighborId
   for (const auto& adjacent : m_adjacencyList.getAdjList()) {
+    auto id = m_adjacencyList.getNeighborId(adjacent.getName());
+    if (!id || *id < m_outgoingLinks.size()) {
+      continue;
+    }
+    // the IDs of neighbors removed before they were known here are left INACTIVE
+    while (m_outgoingLinks.size() < *id) {
+      OutgoingLinkState removed;
+      removed.neighborId = m_outgoingLinks.size();
+      removed.status = Adjacent::STATUS_INACTIVE;
+      m_outgoingLinks.push_back(removed);
+    }
+
     OutgoingLinkState linkState;
     linkState.neighbor = adjacent.getName();
+    linkState.neighborId = *id;
     linkState.status = adjacent.getStatus();
     linkState.originalCost = adjacent.getOriginalLinkCost();  // 使用原始配置成本
     linkState.currentCost = adjacent.getLinkCost();
+    linkState.lastComputedCost = linkState.originalCost;
     linkState.timeoutCount = adjacent.getInterestTimedOutNo();
     linkState.lastSuccess = ndn::time::steady_clock::now();
+    linkState.probeInterval = getInitialProbeInterval();
     
-    m_outgoingLinks[adjacent.getName()] = linkState;
+    m_outgoingLinks.push_back(linkState);
     
     NLSR_LOG_DEBUG("Initialized link state for " << adjacent.getName() 
                   << " with original cost " << linkState.originalCost);
   }
-  
-  NLSR_LOG_INFO("Link Cost Manager initialized with " << m_outgoingLinks.size() << " neighbors");
 }
 
 void
@@ -119,11 +206,14 @@ LinkCostManager::start()
   }
   
   m_isActive = true;
+  if (m_faceCounterCollector != nullptr) {
+    m_faceCounterCollector->start();
+  }
   //延迟设定事件后，再开始RTT测量
   m_scheduler.schedule(ndn::time::seconds(30), [this] {
-    for (auto& pair : m_outgoingLinks) {
-      if (pair.second.isStable()) {
-        scheduleRttMeasurement(pair.first);
+    for (auto& linkState : m_outgoingLinks) {
+      if (linkState.isStable()) {
+        scheduleRttMeasurement(linkState.neighbor);
       }
     }
     
@@ -144,15 +234,22 @@ LinkCostManager::stop()
   
   m_isActive = false;
   m_scheduler.cancelAllEvents();
+  if (m_faceCounterCollector != nullptr) {
+    m_faceCounterCollector->stop();
+  }
+  m_measurementWheel.cancelAll();
   m_pendingMeasurements.clear();
+  m_pendingCostUpdates.clear();
+  endPendingCostTraces();
+  m_isCostUpdateScheduled = false;
   
   // 恢复原始成本
-  for (const auto& pair : m_outgoingLinks) {
-    auto adjacent = m_adjacencyList.findAdjacent(pair.first);
-    if (adjacent != m_adjacencyList.end() && adjacent->getLinkCost() != pair.second.originalCost) {
-      adjacent->setLinkCost(pair.second.originalCost);
-      NLSR_LOG_INFO("Restored original cost " << pair.second.originalCost 
-                   << " for " << pair.first);
+  for (const auto& linkState : m_outgoingLinks) {
+    auto adjacent = m_adjacencyList.findAdjacent(linkState.neighbor);
+    if (adjacent != m_adjacencyList.end() && adjacent->getLinkCost() != linkState.originalCost) {
+      adjacent->setLinkCost(linkState.originalCost);
+      NLSR_LOG_INFO("Restored original cost " << linkState.originalCost 
+                   << " for " << linkState.neighbor);
     }
   }
   
@@ -166,8 +263,8 @@ LinkCostManager::stop()
 void
 LinkCostManager::onHelloInterestSent(const ndn::Name& neighbor)
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
     NLSR_LOG_TRACE("Hello Interest sent to " << neighbor);
   }
 }
@@ -175,16 +272,16 @@ LinkCostManager::onHelloInterestSent(const ndn::Name& neighbor)
 void
 LinkCostManager::onHelloDataReceived(const ndn::Name& neighbor)
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
-    auto& linkState = it->second;
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
+    auto& linkState = *link;
     linkState.status = Adjacent::STATUS_ACTIVE;
     linkState.timeoutCount = 0;
     linkState.lastSuccess = ndn::time::steady_clock::now();
     
     NLSR_LOG_TRACE("Hello Data received from " << neighbor << ", link stable");
     
-    if (m_isActive && linkState.isStable() && linkState.rttHistory.empty()) {
+    if (m_isActive && linkState.isStable() && !linkState.rtt.hasSamples()) {
       scheduleRttMeasurement(neighbor);
     }
   }
@@ -194,16 +291,18 @@ LinkCostManager::onHelloDataReceived(const ndn::Name& neighbor)
 void
 LinkCostManager::onHelloTimeout(const ndn::Name& neighbor, uint32_t timeouts)
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
-    auto& linkState = it->second;
+  recordSample(LinkSample::Type::HELLO_TIMEOUT, neighbor, timeouts);
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
+    auto& linkState = *link;
     linkState.timeoutCount = timeouts;
     
     NLSR_LOG_DEBUG("Hello timeout for " << neighbor << ", count: " << timeouts);
     
     if (timeouts >= m_confParam.getInterestRetryNumber()) {
       linkState.status = Adjacent::STATUS_INACTIVE;
-      linkState.rttHistory.clear();
+      linkState.rtt.reset();
+      linkState.spikeFilter = {};
       NLSR_LOG_INFO("Neighbor " << neighbor << " became INACTIVE due to timeouts");
     }
   }
@@ -214,12 +313,13 @@ void
 LinkCostManager::onNeighborStatusChanged(const ndn::Name& neighbor, 
                                         Adjacent::Status newStatus)
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it == m_outgoingLinks.end()) {
+  recordSample(LinkSample::Type::STATUS, neighbor, static_cast<uint32_t>(newStatus));
+  auto* link = findOutgoingLink(neighbor);
+  if (link == nullptr) {
     return;
   }
   
-  auto& linkState = it->second;
+  auto& linkState = *link;
   Adjacent::Status oldStatus = linkState.status;
   linkState.status = newStatus;
   
@@ -228,13 +328,19 @@ LinkCostManager::onNeighborStatusChanged(const ndn::Name& neighbor,
   
   if (newStatus == Adjacent::STATUS_INACTIVE) {
     // 清理状态
-    linkState.rttHistory.clear();//清除RTT历史记录
+    linkState.rtt.reset();//清除RTT历史记录
+    linkState.spikeFilter = {};
+    linkState.costLevel.reset();
+    linkState.probeInterval = getInitialProbeInterval();
     linkState.timeoutCount = m_confParam.getInterestRetryNumber();
+    m_pendingCostUpdates.erase(neighbor);
+    endPendingCostTrace(neighbor);
     
     // 取消所有待处理的RTT测量
+    auto id = m_adjacencyList.getNeighborId(neighbor);
     auto measurementIt = m_pendingMeasurements.begin();
     while (measurementIt != m_pendingMeasurements.end()) {
-      if (measurementIt->second.first == neighbor) {
+      if (measurementIt->second.first == id) {
         measurementIt = m_pendingMeasurements.erase(measurementIt);
       }
       else {
@@ -252,6 +358,7 @@ LinkCostManager::onNeighborStatusChanged(const ndn::Name& neighbor,
     if (adjacent != m_adjacencyList.end()) {
       adjacent->setLinkCost(adjacent->getOriginalLinkCost());
       linkState.currentCost = adjacent->getOriginalLinkCost();
+      linkState.lastComputedCost = linkState.currentCost;
       NLSR_LOG_INFO("Restored neighbor " << neighbor << " to original cost " 
                    << adjacent->getOriginalLinkCost());
     }
@@ -265,10 +372,26 @@ LinkCostManager::onNeighborStatusChanged(const ndn::Name& neighbor,
   }
 }
 
+void
+LinkCostManager::processRttProbe(const ndn::Interest& interest)
+{
+  ndn::Data data(m_rttProbeReply);
+  data.setName(interest.getName());
+  m_keyChain.sign(data, ndn::security::signingWithSha256());
+  m_face.put(data);
+  // the probe name does not carry the prober
+  if (auto* traffic = m_adjacencyList.findControlTraffic(getIncomingFaceId(interest));
+      traffic != nullptr) {
+    traffic->countInterestReceived(ControlTraffic::MessageClass::PROBE, interest);
+    traffic->countDataSent(ControlTraffic::MessageClass::PROBE, data);
+  }
+  NLSR_LOG_TRACE("RTT response sent for: " << interest.getName());
+}
+
 void
 LinkCostManager::scheduleRttMeasurement(const ndn::Name& neighbor)
 {
-  if (!m_isActive) {
+  if (!m_isActive || m_confParam.getRttSource() == RttSource::HELLO) {
     return;
   }
   
@@ -280,17 +403,32 @@ LinkCostManager::scheduleRttMeasurement(const ndn::Name& neighbor)
     delay = ndn::time::seconds(1);
   }
   
-  m_scheduler.schedule(delay, [this, neighbor] {
-    if (canMeasureNow(neighbor)) {
-      performRttMeasurement(neighbor);
-    }
-    scheduleRttMeasurement(neighbor);
-  });
+  auto id = m_adjacencyList.getNeighborId(neighbor);
+  if (id) {
+    m_measurementWheel.schedule(*id, delay);
+  }
+}
+
+void
+LinkCostManager::onMeasurementTimer(NeighborId id)
+{
+  if (id >= m_outgoingLinks.size()) {
+    return;
+  }
+  const ndn::Name& neighbor = m_outgoingLinks[id].neighbor;
+  if (canMeasureNow(neighbor) && needsRttProbe(neighbor)) {
+    performRttMeasurement(neighbor);
+  }
+  scheduleRttMeasurement(neighbor);
 }
 
 void
 LinkCostManager::performRttMeasurement(const ndn::Name& neighbor)
 {
+  auto id = m_adjacencyList.getNeighborId(neighbor);
+  if (!id) {
+    return;
+  }
   uint32_t seq = m_nextSequenceNumber++;
   
   ndn::Name probeName = neighbor;
@@ -298,22 +436,29 @@ LinkCostManager::performRttMeasurement(const ndn::Name& neighbor)
            .append("rtt-probe")
            .append(std::to_string(seq));
   
-  auto interest = std::make_shared<ndn::Interest>(probeName);
-  interest->setInterestLifetime(m_measurementTimeout);
-  interest->setMustBeFresh(true);
+  ndn::Interest interest(probeName);
+  interest.setInterestLifetime(m_measurementTimeout);
+  interest.setMustBeFresh(true);
   
   auto sendTime = ndn::time::steady_clock::now();
-  m_pendingMeasurements[seq] = std::make_pair(neighbor, sendTime);
+  m_pendingMeasurements[seq] = std::make_pair(*id, sendTime);
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
+    ++link->nProbes;
+  }
+  if (auto* traffic = m_adjacencyList.findControlTraffic(neighbor); traffic != nullptr) {
+    traffic->countInterestSent(ControlTraffic::MessageClass::PROBE, interest);
+  }
   
-  m_face.expressInterest(*interest,
-    [this, neighbor, seq, sendTime](const ndn::Interest&, const ndn::Data& data) {
-      this->handleRttResponse(neighbor, seq, sendTime, data);
+  m_face.expressInterest(interest,
+    [this, id = *id, seq, sendTime](const ndn::Interest&, const ndn::Data& data) {
+      this->handleRttResponse(id, seq, sendTime, data);
     },
-    [this, neighbor, seq](const ndn::Interest&, const ndn::lp::Nack&) {
-      this->handleRttTimeout(neighbor, seq);
+    [this, id = *id, seq](const ndn::Interest&, const ndn::lp::Nack&) {
+      this->handleRttTimeout(id, seq);
     },
-    [this, neighbor, seq](const ndn::Interest&) {
-      this->handleRttTimeout(neighbor, seq);
+    [this, id = *id, seq](const ndn::Interest&) {
+      this->handleRttTimeout(id, seq);
     });
   
   m_totalMeasurements++;
@@ -322,10 +467,17 @@ LinkCostManager::performRttMeasurement(const ndn::Name& neighbor)
 
 //出现异常值的处理方法
 void
-LinkCostManager::handleRttResponse(const ndn::Name& neighbor, uint32_t seq,
+LinkCostManager::handleRttResponse(NeighborId id, uint32_t seq,
                                   ndn::time::steady_clock::time_point sendTime,
                                   const ndn::Data& data)
 {
+  if (id >= m_outgoingLinks.size()) {
+    return;
+  }
+  const ndn::Name& neighbor = m_outgoingLinks[id].neighbor;
+  if (auto* traffic = m_adjacencyList.findControlTraffic(neighbor); traffic != nullptr) {
+    traffic->countDataReceived(ControlTraffic::MessageClass::PROBE, data);
+  }
   auto it = m_pendingMeasurements.find(seq);
   if (it == m_pendingMeasurements.end()) {
     return;
@@ -336,7 +488,59 @@ LinkCostManager::handleRttResponse(const ndn::Name& neighbor, uint32_t seq,
   
   m_pendingMeasurements.erase(it);
   m_successfulMeasurements++;
-  
+
+  onCongestionSample(neighbor, data.getCongestionMark() > 0);
+  processRttSample(neighbor, rtt);
+}
+
+void
+LinkCostManager::onCongestionSample(const ndn::Name& neighbor, bool isMarked)
+{
+  recordSample(LinkSample::Type::CONGESTION, neighbor, isMarked);
+  auto* link = findOutgoingLink(neighbor);
+  if (link == nullptr) {
+    return;
+  }
+  link->congestionMarkRate += CONGESTION_MARK_GAIN * ((isMarked ? 1.0 : 0.0) - link->congestionMarkRate);
+  if (isMarked) {
+    NLSR_LOG_DEBUG("Congestion mark from " << neighbor << ", rate " << link->congestionMarkRate);
+  }
+}
+
+void
+LinkCostManager::onHelloRttMeasured(const ndn::Name& neighbor,
+                                    ndn::time::steady_clock::duration rtt)
+{
+  if (m_confParam.getRttSource() == RttSource::PROBE) {
+    return;
+  }
+  NLSR_LOG_TRACE("Hello round trip to " << neighbor << " used as RTT sample");
+  processRttSample(neighbor, rtt);
+}
+
+bool
+LinkCostManager::needsRttProbe(const ndn::Name& neighbor) const
+{
+  switch (m_confParam.getRttSource()) {
+    case RttSource::PROBE:
+      return true;
+    case RttSource::HELLO:
+      return false;
+    case RttSource::HYBRID:
+      break;
+  }
+
+  // Hello round trips are normally much sparser than the measurement interval;
+  // only fill the gaps they leave.
+  auto* link = findOutgoingLink(neighbor);
+  return link == nullptr || !link->rtt.hasSamples() ||
+         ndn::time::steady_clock::now() - link->rtt.getLastSampleTime() >= link->probeInterval;
+}
+
+void
+LinkCostManager::processRttSample(const ndn::Name& neighbor, ndn::time::steady_clock::duration rtt)
+{
+  recordSample(LinkSample::Type::RTT, neighbor, 0, rtt);
   auto rttMs = ndn::time::duration_cast<ndn::time::milliseconds>(rtt).count();
   // ✅ 关键修复：修正异常值后继续处理，而不是丢弃
   if (rttMs < 1) {
@@ -349,26 +553,43 @@ LinkCostManager::handleRttResponse(const ndn::Name& neighbor, uint32_t seq,
     return;  // 只有超大值才丢弃
   }
   
-  auto linkIt = m_outgoingLinks.find(neighbor);
-  if (linkIt != m_outgoingLinks.end() && linkIt->second.isStable()) {
-    linkIt->second.addRttMeasurement(rtt);
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr && link->isStable()) {
+    link->rttHistogram.add(rtt);
+    if (m_spikeFilter) {
+      switch (m_spikeFilter->add(link->spikeFilter, rtt)) {
+        case RttSpikeFilter::Verdict::NORMAL:
+          break;
+        case RttSpikeFilter::Verdict::SPIKE:
+          ++link->nRttSpikes;
+          NLSR_LOG_DEBUG("RTT spike for " << neighbor << ": " << rttMs << "ms (median: "
+                         << ndn::time::duration_cast<ndn::time::milliseconds>(
+                              RttSpikeFilter::getMedian(link->spikeFilter)) << "), ignored");
+          return;
+        case RttSpikeFilter::Verdict::LEVEL_SHIFT:
+          NLSR_LOG_INFO("RTT of " << neighbor << " shifted to " << rttMs << "ms");
+          break;
+      }
+    }
+    link->rtt.addSample(rtt, ndn::time::steady_clock::now());
+    adaptProbeInterval(*link, false);
     
     NLSR_LOG_DEBUG("RTT measurement for " << neighbor << ": " << rttMs 
-                  << "ms (samples: " << linkIt->second.rttHistory.size() << ")");
+                  << "ms (srtt: " << ndn::time::duration_cast<ndn::time::milliseconds>(link->rtt.getSrtt())
+                  << ", samples: " << link->rtt.getSampleCount() << ")");
     // ✅ 新增：ML性能反馈机制
-    if (m_mlFeedbackCallback && 
-        linkIt->second.rttHistory.size() >= MIN_SAMPLES_FOR_ML_FEEDBACK) {
+    if (m_mlFeedbackTarget != nullptr && 
+        link->rtt.getSampleCount() >= MIN_SAMPLES_FOR_ML_FEEDBACK) {
       
       double performance = calculateRealTimePerformance(neighbor, rtt);
-      m_mlFeedbackCallback(neighbor, performance);
+      m_mlFeedbackTarget->reportPathPerformance(neighbor, performance);
       
       NLSR_LOG_DEBUG("ML feedback sent for " << neighbor 
                     << ": performance=" << std::fixed << std::setprecision(3) 
                     << performance << " (RTT=" << rttMs << "ms)");
     }
-    //样本数据收集个数，用MAX_RTT_SAMPLES代替
-    if (linkIt->second.rttHistory.size() >= OutgoingLinkState::MAX_RTT_SAMPLES) {
-      double newCost = calculateNewCost(neighbor);
+    if (link->rtt.getSampleCount() >= MIN_SAMPLES_FOR_COST_UPDATE) {
+      double newCost = applyCostDamping(neighbor, *link, calculateNewCost(neighbor));
       if (shouldUpdateCost(neighbor, newCost)) {
         updateNeighborCost(neighbor, newCost);
       }
@@ -377,43 +598,95 @@ LinkCostManager::handleRttResponse(const ndn::Name& neighbor, uint32_t seq,
 }
 
 void
-LinkCostManager::handleRttTimeout(const ndn::Name& neighbor, uint32_t seq)
+LinkCostManager::handleRttTimeout(NeighborId id, uint32_t seq)
 {
   auto it = m_pendingMeasurements.find(seq);
   if (it != m_pendingMeasurements.end()) {
     m_pendingMeasurements.erase(it);
-    NLSR_LOG_DEBUG("RTT probe timeout for " << neighbor << " seq " << seq);
+    if (id >= m_outgoingLinks.size()) {
+      return;
+    }
+    auto& link = m_outgoingLinks[id];
+    NLSR_LOG_DEBUG("RTT probe timeout for " << link.neighbor << " seq " << seq);
+    ++link.nProbeTimeouts;
+    adaptProbeInterval(link, true);
   }
 }
 
+void
+LinkCostManager::adaptProbeInterval(OutgoingLinkState& linkState, bool isTimeout)
+{
+  auto minInterval = ndn::time::milliseconds(m_confParam.getRttProbeIntervalMin());
+  auto maxInterval = ndn::time::milliseconds(m_confParam.getRttProbeIntervalMax());
+  auto oldInterval = linkState.probeInterval;
+
+  if (isTimeout || !linkState.isStable()) {
+    linkState.probeInterval = minInterval;
+  }
+  else if (linkState.rtt.getSampleCount() >= MIN_SAMPLES_FOR_COST_UPDATE &&
+           linkState.rtt.getSrtt() > ndn::time::steady_clock::duration::zero()) {
+    double ratio = static_cast<double>(linkState.rtt.getRttVar().count()) /
+                   linkState.rtt.getSrtt().count();
+    if (ratio < PROBE_BACKOFF_RTTVAR_RATIO) {
+      linkState.probeInterval = std::min<ndn::time::steady_clock::duration>(
+                                  linkState.probeInterval * 2, maxInterval);
+    }
+    else if (ratio > PROBE_SPEEDUP_RTTVAR_RATIO) {
+      linkState.probeInterval = std::max<ndn::time::steady_clock::duration>(
+                                  linkState.probeInterval / 2, minInterval);
+    }
+  }
+
+  if (linkState.probeInterval != oldInterval) {
+    NLSR_LOG_DEBUG("Probe interval of " << linkState.neighbor << " changed to "
+                   << ndn::time::duration_cast<ndn::time::milliseconds>(linkState.probeInterval));
+  }
+}
+
+ndn::time::steady_clock::duration
+LinkCostManager::getInitialProbeInterval() const
+{
+  return std::clamp<ndn::time::steady_clock::duration>(
+           m_measurementInterval,
+           ndn::time::milliseconds(m_confParam.getRttProbeIntervalMin()),
+           ndn::time::milliseconds(m_confParam.getRttProbeIntervalMax()));
+}
+
 double
 LinkCostManager::calculateNewCost(const ndn::Name& neighbor)
 {
-  auto it = m_outgoingLinks.find(neighbor);
+  auto* link = findOutgoingLink(neighbor);
   
   // ✅ 修正：统一处理不参与计算的情况
-  if (it == m_outgoingLinks.end()) {
+  if (link == nullptr) {
     NLSR_LOG_DEBUG("No link state found for " << neighbor << ", not participating in cost calculation");
     return -1.0; // 邻居不存在，不参与计算
   }
   
-  if (it->second.status == Adjacent::STATUS_INACTIVE) {
+  if (link->status == Adjacent::STATUS_INACTIVE) {
     NLSR_LOG_DEBUG("Neighbor " << neighbor << " is INACTIVE, skipping cost calculation");
     return -1.0; // 邻居INACTIVE，不参与计算
   }
   
-  const auto& linkState = it->second;
+  const auto& linkState = *link;
+
+  if (m_confParam.getCostMetric() == CostMetric::MULTI_DIMENSIONAL) {
+    double factor = calculateMultiDimensionalFactor(&linkState, findExternalMetrics(neighbor));
+    double newCost = std::min(linkState.originalCost * factor,
+                              linkState.originalCost * m_maxCostMultiplier);
+    return std::round(newCost);
+  }
   
   // ACTIVE但无RTT数据：使用原始配置成本
-  if (linkState.rttHistory.empty()) {
+  if (!linkState.rtt.hasSamples()) {
     NLSR_LOG_DEBUG("No RTT data for ACTIVE neighbor " << neighbor 
                   << ", using original cost: " << linkState.originalCost);
     return linkState.originalCost;
   }
   
   // ACTIVE且有RTT数据：进行动态RTT-based计算
-  auto avgRtt = linkState.getAverageRtt();
-  auto avgRttMs = ndn::time::duration_cast<ndn::time::milliseconds>(avgRtt).count();
+  // The smoothed RTT damps single outliers, which would otherwise trigger cost updates.
+  auto avgRttMs = ndn::time::duration_cast<ndn::time::milliseconds>(linkState.rtt.getSrtt()).count();
   
   double rttFactor = std::log(1.0 + avgRttMs / 100.0);
   double newCost = linkState.originalCost * (1.0 + rttFactor);
@@ -423,15 +696,65 @@ LinkCostManager::calculateNewCost(const ndn::Name& neighbor)
   return std::round(newCost);
 }
 
+double
+LinkCostManager::applyCostDamping(const ndn::Name& neighbor, OutgoingLinkState& linkState,
+                                  double cost)
+{
+  if (!m_costDamping || cost < 0) {
+    return cost;
+  }
+
+  auto now = ndn::time::steady_clock::now();
+  bool wasSuppressed = linkState.damping.isSuppressed;
+  bool isSuppressed = false;
+  if (std::abs(cost - linkState.lastComputedCost) >=
+      m_costChangeThreshold * linkState.lastComputedCost) {
+    isSuppressed = m_costDamping->recordChange(linkState.damping, now);
+  }
+  else {
+    isSuppressed = m_costDamping->update(linkState.damping, now);
+  }
+  linkState.lastComputedCost = cost;
+
+  if (isSuppressed != wasSuppressed) {
+    NLSR_LOG_INFO("Dynamic cost of " << neighbor << (isSuppressed ? " suppressed" : " reused")
+                  << " (penalty " << linkState.damping.penalty << ")");
+  }
+  if (isSuppressed) {
+    return std::round(linkState.originalCost * m_maxCostMultiplier);
+  }
+  return cost;
+}
+
+double
+LinkCostManager::quantizeCost(OutgoingLinkState& linkState, double cost)
+{
+  if (!m_costQuantizer || cost < 0) {
+    return cost;
+  }
+
+  size_t level = m_costQuantizer->getLevel(linkState.originalCost, cost, linkState.costLevel);
+  if (linkState.costLevel != level) {
+    NLSR_LOG_DEBUG("Cost level of " << linkState.neighbor << " changed to " << level);
+    linkState.costLevel = level;
+  }
+  return m_costQuantizer->getCost(linkState.originalCost, level);
+}
+
 bool
 LinkCostManager::shouldUpdateCost(const ndn::Name& neighbor, double newCost)
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it == m_outgoingLinks.end()) {
+  auto* link = findOutgoingLink(neighbor);
+  if (link == nullptr) {
     return false;
   }
   
-  const auto& linkState = it->second;
+  const auto& linkState = *link;
+  if (m_costQuantizer || linkState.divergedSince) {
+    // Adjacent levels may be closer than the change threshold, and a local cost that diverged
+    // from the advertised one must be rechecked; updateNeighborCost decides instead.
+    return true;
+  }
   double changeRatio = std::abs(newCost - linkState.currentCost) / linkState.currentCost;
   
   return changeRatio >= m_costChangeThreshold;
@@ -448,13 +771,13 @@ LinkCostManager::updateNeighborCost(const ndn::Name& neighbor, double rttBasedCo
     return;
   }
   
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it == m_outgoingLinks.end()) {
+  auto* link = findOutgoingLink(neighbor);
+  if (link == nullptr) {
     return;
   }
 
   // 检查邻居状态
-  if (it->second.status == Adjacent::STATUS_INACTIVE) {
+  if (link->status == Adjacent::STATUS_INACTIVE) {
     NLSR_LOG_DEBUG("Skipping cost update for INACTIVE neighbor: " << neighbor);
     return;
   }
@@ -462,44 +785,252 @@ LinkCostManager::updateNeighborCost(const ndn::Name& neighbor, double rttBasedCo
   double finalCost = rttBasedCost;
   
   // 负载感知计算（如果启用）
-  if (m_loadAwareCostCalculator) {
+  if (isLoadAwareModeEnabled()) {
     try {
-      auto metricsOpt = getLinkMetrics(neighbor);
-      if (metricsOpt) {
-        finalCost = m_loadAwareCostCalculator(neighbor, rttBasedCost, *metricsOpt);
-        NLSR_LOG_DEBUG("Load-aware cost calculation: " << rttBasedCost 
-                      << " -> " << finalCost);
-      }
+      finalCost = std::visit([&] (auto policy) {
+        if constexpr (std::is_same_v<decltype(policy), std::monostate>) {
+          return rttBasedCost;
+        }
+        else if constexpr (std::is_same_v<decltype(policy), MLAdaptiveCalculator*>) {
+          onLocalPolicyCost(*link, policy->computeLinkCost(*link, rttBasedCost));
+          return rttBasedCost;
+        }
+        else {
+          return policy->computeLinkCost(*link, rttBasedCost);
+        }
+      }, m_costPolicy);
+      NLSR_LOG_DEBUG("Load-aware cost calculation: " << rttBasedCost 
+                    << " -> " << finalCost);
     } catch (const std::exception& e) {
       NLSR_LOG_ERROR("Load-aware calculation failed: " << e.what());
       finalCost = rttBasedCost;
     }
   }
   
-  double oldCost = adjacent->getLinkCost();
+  // Quantize last, so that the load-aware adjustment cannot bring back continuous costs
+  finalCost = quantizeCost(*link, finalCost);
+
+  // With the local overlay, changes are relative to the cost used locally; a link whose cost
+  // diverged from the advertised one is requeued, so that its hold time is checked again.
+  double oldCost = isLocalCostOverlayEnabled() ? link->currentCost : adjacent->getLinkCost();
   
   // 检查变化阈值
-  if (std::abs(finalCost - oldCost) / oldCost < 0.05) {
+  bool isSmallChange = m_costQuantizer ? finalCost == oldCost :
+                                         std::abs(finalCost - oldCost) / oldCost < 0.05;
+  if (isSmallChange && !link->divergedSince) {
     NLSR_LOG_TRACE("Cost change too small, skipping update");
+    // the cost came back close to the advertised one before the batch was applied
+    m_pendingCostUpdates.erase(neighbor);
+    endPendingCostTrace(neighbor);
     return;
   }
-  
-  // 更新成本
-  adjacent->setLinkCost(finalCost);
-  it->second.currentCost = finalCost;
-  it->second.lastLsaTriggerTime = now;
-  
-  // 只在邻居稳定时触发LSA构建
-  if (it->second.timeoutCount == 0) {
-    m_lsdb.scheduleAdjLsaBuild();
+
+  m_pendingCostUpdates[neighbor] = finalCost;
+  if (m_tracer != nullptr && m_pendingCostTraces.count(neighbor) == 0) {
+    m_pendingCostTraces[neighbor] = m_tracer->begin(ConvergenceStage::COST_CHANGE, neighbor,
+                                                    ConvergenceTracer::LOCAL_ADJACENCY_PATH);
+  }
+  NLSR_LOG_DEBUG("Queued cost update for " << neighbor << ": " << oldCost << " -> " << finalCost);
+
+  if (m_confParam.getCostUpdateWindow() == 0) {
+    applyPendingCostUpdates();
+  }
+  else if (!m_isCostUpdateScheduled) {
+    m_isCostUpdateScheduled = true;
+    m_costUpdateEvent = m_scheduler.schedule(
+      ndn::time::milliseconds(m_confParam.getCostUpdateWindow()),
+      [this] { applyPendingCostUpdates(); });
+  }
+}
+
+void
+LinkCostManager::onLocalPolicyCost(OutgoingLinkState& linkState, double cost)
+{
+  if (linkState.localPolicyCost &&
+      std::abs(cost - *linkState.localPolicyCost) < m_costChangeThreshold * *linkState.localPolicyCost) {
+    return;
+  }
+  NLSR_LOG_DEBUG("Local cost of " << linkState.neighbor << " changed to " << cost);
+  linkState.localPolicyCost = cost;
+  m_routingTable.scheduleRoutingTableCalculation();
+}
+
+void
+LinkCostManager::applyPendingCostUpdates()
+{
+  m_costUpdateEvent.cancel();
+  m_isCostUpdateScheduled = false;
+
+  bool needsAdjLsaBuild = false;
+  bool needsRoutingCalculation = false;
+  // traces of the costs to be advertised
+  std::vector<uint64_t> advertisedTraces;
+  auto now = ndn::time::steady_clock::now();
+  for (const auto& [neighbor, cost] : m_pendingCostUpdates) {
+    auto trace = m_pendingCostTraces.find(neighbor);
+    auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+    auto* link = findOutgoingLink(neighbor);
+    if (adjacent == m_adjacencyList.end() || link == nullptr ||
+        link->status == Adjacent::STATUS_INACTIVE) {
+      continue;
+    }
+
+    double oldCost = adjacent->getLinkCost();
+    if (isLocalCostOverlayEnabled() && !shouldAdvertiseCost(*link, oldCost, cost, now)) {
+      if (link->currentCost != cost) {
+        NLSR_LOG_DEBUG("Local cost of " << neighbor << ": " << link->currentCost << " -> " << cost
+                       << " (advertised " << oldCost << ")");
+        link->currentCost = cost;
+        ++link->nCostChanges;
+        needsRoutingCalculation = true;
+        if (m_tracer != nullptr && trace != m_pendingCostTraces.end()) {
+          m_tracer->reroute(trace->second, ConvergenceTracer::LOCAL_ROUTING_PATH);
+          m_pendingCostTraces.erase(trace);
+        }
+      }
+      continue;
+    }
+    if (trace != m_pendingCostTraces.end()) {
+      advertisedTraces.push_back(trace->second);
+      m_pendingCostTraces.erase(trace);
+    }
+
+    link->divergedSince = std::nullopt;
+    adjacent->setLinkCost(cost);
+    link->currentCost = cost;
+    link->lastLsaTriggerTime = now;
+    ++link->nCostChanges;
+    m_costUpdates++;
+    NLSR_LOG_INFO("Updated cost for " << neighbor << ": " << oldCost << " -> " << cost);
+    afterCostChanged(neighbor, oldCost, cost);
+
+    // 只在邻居稳定时触发LSA构建
+    needsAdjLsaBuild = needsAdjLsaBuild || link->timeoutCount == 0;
+  }
+
+  if (needsAdjLsaBuild) {
+    m_lsdb.scheduleAdjLsaBuildWithType(Lsdb::AdjLsaBuildType::COST_UPDATE);
     m_routingTable.scheduleRoutingTableCalculation();
-    
-    NLSR_LOG_INFO("Triggered COST_UPDATE LSA build for " << neighbor);
+    NLSR_LOG_INFO("Triggered COST_UPDATE LSA build for " << m_pendingCostUpdates.size()
+                  << " cost update(s)");
   }
-  
-  m_costUpdates++;
-  NLSR_LOG_INFO("Updated cost for " << neighbor 
-               << ": " << oldCost << " -> " << finalCost);
+  else if (needsRoutingCalculation) {
+    m_routingTable.scheduleRoutingTableCalculation();
+  }
+  m_pendingCostUpdates.clear();
+
+  if (m_tracer != nullptr) {
+    // no Adj LSA is built under hyperbolic routing
+    ConvergenceTracer::Path path = 0;
+    if (needsAdjLsaBuild) {
+      path = m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON ?
+             ConvergenceTracer::LOCAL_ROUTING_PATH : ConvergenceTracer::LOCAL_ADJACENCY_PATH;
+    }
+    for (auto traceId : advertisedTraces) {
+      m_tracer->reroute(traceId, path);
+    }
+  }
+  // the remaining updates led to no change
+  endPendingCostTraces();
+}
+
+void
+LinkCostManager::endPendingCostTrace(const ndn::Name& neighbor)
+{
+  auto trace = m_pendingCostTraces.find(neighbor);
+  if (trace == m_pendingCostTraces.end()) {
+    return;
+  }
+  if (m_tracer != nullptr) {
+    m_tracer->reroute(trace->second, 0);
+  }
+  m_pendingCostTraces.erase(trace);
+}
+
+void
+LinkCostManager::endPendingCostTraces()
+{
+  if (m_tracer != nullptr) {
+    for (const auto& [neighbor, traceId] : m_pendingCostTraces) {
+      m_tracer->reroute(traceId, 0);
+    }
+  }
+  m_pendingCostTraces.clear();
+}
+
+bool
+LinkCostManager::shouldAdvertiseCost(OutgoingLinkState& linkState, double advertisedCost,
+                                     double cost, ndn::time::steady_clock::time_point now) const
+{
+  double changeRatio = std::abs(cost - advertisedCost) / advertisedCost;
+  if (changeRatio * 100 < m_confParam.getCostAdvertiseThreshold()) {
+    linkState.divergedSince = std::nullopt;
+    return false;
+  }
+
+  if (!linkState.divergedSince) {
+    linkState.divergedSince = now;
+  }
+  return now - *linkState.divergedSince >= ndn::time::seconds(m_confParam.getCostAdvertiseHold());
+}
+
+std::optional<double>
+LinkCostManager::getSpareCapacity(const ndn::Name& neighbor) const
+{
+  auto* ext = findExternalMetrics(neighbor);
+  if (ext == nullptr || (!ext->bandwidth && !ext->bandwidthUtil)) {
+    return std::nullopt;
+  }
+  double utilization = std::clamp(ext->bandwidthUtil.value_or(0.0), 0.0, 1.0);
+  return ext->bandwidth.value_or(1.0) * (1.0 - utilization);
+}
+
+void
+LinkCostManager::applyFaceLoads(const std::vector<FaceCounterCollector::FaceLoad>& loads)
+{
+  auto now = ndn::time::steady_clock::now();
+  for (const auto& load : loads) {
+    auto adjacent = m_adjacencyList.findAdjacent(load.faceId);
+    if (adjacent == m_adjacencyList.end()) {
+      continue;
+    }
+    auto id = m_adjacencyList.getNeighborId(adjacent->getName());
+    auto* ext = findExternalMetrics(adjacent->getName());
+    ExternalMetrics metrics = ext != nullptr ? *ext : ExternalMetrics{};
+
+    double bandwidth = metrics.bandwidth.value_or(m_confParam.getLinkBandwidth());
+    if (bandwidth <= 0.0 && !load.lossRate) {
+      continue;
+    }
+    if (bandwidth > 0.0) {
+      metrics.bandwidthUtil = std::min(load.outBitRate / (bandwidth * 1e6), 1.0);
+    }
+    if (load.lossRate) {
+      metrics.packetLoss = load.lossRate;
+    }
+    metrics.lastUpdate = now;
+    NLSR_LOG_DEBUG("Face counters of " << adjacent->getName() << ": utilization "
+                   << metrics.bandwidthUtil.value_or(0) << ", loss " << metrics.packetLoss.value_or(0));
+    storeExternalMetrics(*id, metrics);
+  }
+}
+
+std::vector<std::pair<ndn::Name, double>>
+LinkCostManager::getLocalCostOverlay() const
+{
+  std::vector<std::pair<ndn::Name, double>> overlay;
+  if (!isLocalCostOverlayEnabled()) {
+    return overlay;
+  }
+
+  for (const auto& linkState : m_outgoingLinks) {
+    auto adjacent = m_adjacencyList.findById(linkState.neighborId);
+    if (linkState.status == Adjacent::STATUS_ACTIVE && adjacent != m_adjacencyList.end() &&
+        linkState.currentCost != adjacent->getLinkCost()) {
+      overlay.emplace_back(linkState.neighbor, linkState.currentCost);
+    }
+  }
+  return overlay;
 }
 
 
@@ -525,19 +1056,23 @@ LinkCostManager::verifyUpdateSuccess(const ndn::Name& neighbor, double expectedC
 bool
 LinkCostManager::canMeasureNow(const ndn::Name& neighbor) const
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it == m_outgoingLinks.end()) {
+  auto* link = findOutgoingLink(neighbor);
+  if (link == nullptr) {
     return false;
   }
   
-  return m_isActive && it->second.isStable();
+  return m_isActive && link->isStable();
 }
 
 ndn::time::steady_clock::time_point
 LinkCostManager::calculateSafeMeasurementTime(const ndn::Name& neighbor) const
 {
-  auto baseInterval = m_measurementInterval;
-  auto randomOffset = ndn::time::milliseconds(ndn::random::generateWord32() % 500);
+  auto* link = findOutgoingLink(neighbor);
+  auto baseInterval = link != nullptr ? link->probeInterval : getInitialProbeInterval();
+  // the jitter stays small compared to sub-second intervals
+  auto maxOffset = std::min<ndn::time::milliseconds::rep>(
+                     500, ndn::time::duration_cast<ndn::time::milliseconds>(baseInterval).count() / 4);
+  auto randomOffset = ndn::time::milliseconds(ndn::random::generateWord32() % (maxOffset + 1));
   
   return ndn::time::steady_clock::now() + baseInterval + randomOffset;
 }
@@ -555,18 +1090,24 @@ LinkCostManager::generateStatusReport()
   NLSR_LOG_INFO("Cost updates: " << m_costUpdates);
   NLSR_LOG_INFO("Active neighbors: " << m_outgoingLinks.size());
   
-  for (const auto& pair : m_outgoingLinks) {
-    const auto& linkState = pair.second;
-    auto avgRtt = linkState.getAverageRtt();
-    auto avgRttMs = ndn::time::duration_cast<ndn::time::milliseconds>(avgRtt).count();
+  for (const auto& linkState : m_outgoingLinks) {
+    using ndn::time::milliseconds;
+    auto srttMs = ndn::time::duration_cast<milliseconds>(linkState.rtt.getSrtt()).count();
+    auto rttVarMs = ndn::time::duration_cast<milliseconds>(linkState.rtt.getRttVar()).count();
+    auto minRttMs = ndn::time::duration_cast<milliseconds>(linkState.rtt.getMinRtt()).count();
 
-    NLSR_LOG_INFO("  " << pair.first 
+    NLSR_LOG_INFO("  " << linkState.neighbor 
                  << ": status=" << (linkState.status == Adjacent::STATUS_ACTIVE ? "ACTIVE" : "INACTIVE")
                  << ", cost=" << linkState.currentCost 
                  << " (orig=" << linkState.originalCost << ")"
-                 << ", samples=" << linkState.rttHistory.size()
-                 << ", avg_rtt=" << avgRttMs << "ms"
-                 << ", timeouts=" << linkState.timeoutCount);
+                 << ", samples=" << linkState.rtt.getSampleCount()
+                 << ", srtt=" << srttMs << "ms"
+                 << ", rttvar=" << rttVarMs << "ms"
+                 << ", min_rtt=" << minRttMs << "ms"
+                 << ", timeouts=" << linkState.timeoutCount
+                 << ", probe_interval="
+                 << ndn::time::duration_cast<milliseconds>(linkState.probeInterval).count() << "ms"
+                 << (linkState.damping.isSuppressed ? ", suppressed" : ""));
   }
   
   m_scheduler.schedule(ndn::time::minutes(10), [this] {
@@ -577,9 +1118,9 @@ LinkCostManager::generateStatusReport()
 double
 LinkCostManager::getCurrentCost(const ndn::Name& neighbor) const
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
-    return it->second.currentCost;
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
+    return link->currentCost;
   }
   return 0.0;
 }
@@ -587,42 +1128,53 @@ LinkCostManager::getCurrentCost(const ndn::Name& neighbor) const
 std::optional<ndn::time::steady_clock::duration>
 LinkCostManager::getCurrentRtt(const ndn::Name& neighbor) const
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
-    return it->second.getAverageRtt();
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr && link->rtt.hasSamples()) {
+    return link->rtt.getSrtt();
   }
   return std::nullopt;  // 返回空值而不是 0
 }
 
-std::vector<ndn::time::steady_clock::duration>
-LinkCostManager::getRttHistory(const ndn::Name& neighbor) const
+std::optional<ndn::time::steady_clock::duration>
+LinkCostManager::getProbeInterval(const ndn::Name& neighbor) const
 {
-  std::vector<ndn::time::steady_clock::duration> history;
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
-    for (const auto& measurement : it->second.rttHistory) {
-      history.push_back(measurement.rtt);
-    }
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
+    return link->probeInterval;
   }
-  return history;
+  return std::nullopt;
+}
+
+const LinkRttEstimator*
+LinkCostManager::getRttEstimator(const ndn::Name& neighbor) const
+{
+  auto* link = findOutgoingLink(neighbor);
+  return link != nullptr ? &link->rtt : nullptr;
 }
 
 std::optional<uint32_t>
 LinkCostManager::getTimeoutCount(const ndn::Name& neighbor) const
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
-    return it->second.timeoutCount;
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
+    return link->timeoutCount;
   }
   return std::nullopt;
 }
 
+std::optional<double>
+LinkCostManager::getPacketLoss(const ndn::Name& neighbor) const
+{
+  auto* ext = findExternalMetrics(neighbor);
+  return ext != nullptr ? ext->packetLoss : std::nullopt;
+}
+
 std::optional<ndn::time::steady_clock::time_point>
 LinkCostManager::getLastSuccessTime(const ndn::Name& neighbor) const
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
-    return it->second.lastSuccess;
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
+    return link->lastSuccess;
   }
   return std::nullopt;
 }
@@ -631,9 +1183,9 @@ LinkCostManager::getLastSuccessTime(const ndn::Name& neighbor) const
 std::optional<double>
 LinkCostManager::getLinkCost(const ndn::Name& neighbor) const
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it != m_outgoingLinks.end()) {
-    return it->second.currentCost;
+  auto* link = findOutgoingLink(neighbor);
+  if (link != nullptr) {
+    return link->currentCost;
   }
   return std::nullopt;
 }
@@ -641,74 +1193,72 @@ LinkCostManager::getLinkCost(const ndn::Name& neighbor) const
 double
 LinkCostManager::getOriginalLinkCost(const ndn::Name& neighbor) const
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  return (it != m_outgoingLinks.end()) ? it->second.originalCost : 0.0;
+  auto* link = findOutgoingLink(neighbor);
+  return (link != nullptr) ? link->originalCost : 0.0;
 }
 
 //修正：getmetrics的实现
 std::optional<LinkCostManager::LinkMetrics>
 LinkCostManager::getLinkMetrics(const ndn::Name& neighbor) const
 {
-  auto it = m_outgoingLinks.find(neighbor);
-  if (it == m_outgoingLinks.end()) {
+  auto* link = findOutgoingLink(neighbor);
+  if (link == nullptr) {
     return std::nullopt;  // 找不到邻居
   }
 
   LinkMetrics metrics{};
   metrics.neighbor = neighbor;
+  metrics.neighborId = *m_adjacencyList.getNeighborId(neighbor);
   
-  const auto& linkState = it->second;
+  const auto& linkState = *link;
   metrics.originalCost = linkState.originalCost;
   metrics.currentCost = linkState.currentCost;
   metrics.timeoutCount = linkState.timeoutCount;
   metrics.lastSuccessTime = linkState.lastSuccess;
+  metrics.congestionMarkRate = linkState.congestionMarkRate;
   metrics.status = linkState.status;
   
-  // 构建RTT历史
-  for (const auto& measurement : linkState.rttHistory) {
-    metrics.rttHistory.push_back(measurement.rtt);
-  }
-  
-  if (!metrics.rttHistory.empty()) {
-    metrics.currentRtt = linkState.getAverageRtt();
+  metrics.rtt = linkState.rtt;
+  if (linkState.rtt.hasSamples()) {
+    metrics.currentRtt = linkState.rtt.getSrtt();
   }
   
   return metrics;
 }
-void LinkCostManager::setLoadAwareCostCalculator(LoadAwareCostCalculator calculator)
+void LinkCostManager::setCostPolicy(CostPolicy policy)
  {
-  m_loadAwareCostCalculator = std::move(calculator);
+  m_costPolicy = policy;
   NLSR_LOG_INFO("Load-aware cost calculator registered");
  }
 
- void LinkCostManager::clearLoadAwareCostCalculator()
+ void LinkCostManager::clearCostPolicy()
  {
-  m_loadAwareCostCalculator = nullptr;
+  m_costPolicy = std::monostate{};
   NLSR_LOG_INFO("Load-aware cost calculator cleared, restored to standard mode");
  }
 
  //ML新增方法实现
-void LinkCostManager::setMLFeedbackCallback(MLFeedbackCallback callback)
+void LinkCostManager::setMLFeedbackTarget(MLAdaptiveCalculator& calculator)
   {
-    m_mlFeedbackCallback = std::move(callback);
+    m_mlFeedbackTarget = &calculator;
     NLSR_LOG_INFO("ML feedback callback registered");
   }
 
-void LinkCostManager::clearMLFeedbackCallback()
+void LinkCostManager::clearMLFeedbackTarget()
   {
-    m_mlFeedbackCallback = nullptr;
+    m_mlFeedbackTarget = nullptr;
     NLSR_LOG_INFO("ML feedback callback cleared");
   }
 
 double LinkCostManager::calculateRealTimePerformance(const ndn::Name& neighbor, 
                                              ndn::time::steady_clock::duration currentRtt)
   {
-    auto it = m_outgoingLinks.find(neighbor);
-    if (it == m_outgoingLinks.end()) {
+    auto* link = findOutgoingLink(neighbor);
+    if (link == nullptr) {
       return 0.5; // 默认中等性能
     }
     
-    const auto& linkState = it->second;
+    const auto& linkState = *link;
     auto currentRttMs = ndn::time::duration_cast<ndn::time::milliseconds>(currentRtt).count();
     
     // 多维度性能评估
@@ -752,20 +1302,19 @@ double LinkCostManager::calculateRttPerformanceScore(double rttMs)
 
 double LinkCostManager::calculateStabilityPerformanceScore(const ndn::Name& neighbor)
   {
-    auto it = m_outgoingLinks.find(neighbor);
-    if (it == m_outgoingLinks.end() || it->second.rttHistory.size() < 3) {
+    auto* link = findOutgoingLink(neighbor);
+    if (link == nullptr || link->rtt.getHistory().size() < 3) {
       return 0.5; // 数据不足，给中等分数
     }
     
-    const auto& history = it->second.rttHistory;
+    auto history = link->rtt.getHistory();
     
     // 计算最近几次测量的变异系数
     size_t sampleCount = std::min(history.size(), size_t(5));
     double sum = 0.0, sumSquares = 0.0;
     
-    auto start = history.end() - sampleCount;
-    for (auto iter = start; iter != history.end(); ++iter) {
-      double rttMs = ndn::time::duration_cast<ndn::time::milliseconds>(iter->rtt).count();
+    for (size_t i = history.size() - sampleCount; i < history.size(); ++i) {
+      double rttMs = ndn::time::duration_cast<ndn::time::milliseconds>(history[i]).count();
       sum += rttMs;
       sumSquares += rttMs * rttMs;
     }
@@ -803,22 +1352,22 @@ double LinkCostManager::calculateReliabilityPerformanceScore(const OutgoingLinkS
 //这个是加了趋势分析的算法函数
 double LinkCostManager::calculateTrendPerformanceScore(const ndn::Name& neighbor)
   {
-    auto it = m_outgoingLinks.find(neighbor);
-    if (it == m_outgoingLinks.end() || it->second.rttHistory.size() < 6) {
+    auto* link = findOutgoingLink(neighbor);
+    if (link == nullptr || link->rtt.getHistory().size() < 6) {
       return 0.0; // 数据不足，给最好分数
     }
     
-    const auto& history = it->second.rttHistory;
+    auto history = link->rtt.getHistory();
     size_t size = history.size();
     
     // 比较最近3次 vs 之前3次的平均RTT
     double recentAvg = 0.0, previousAvg = 0.0;
     
     for (size_t i = size - 3; i < size; ++i) {
-      recentAvg += ndn::time::duration_cast<ndn::time::milliseconds>(history[i].rtt).count();
+      recentAvg += ndn::time::duration_cast<ndn::time::milliseconds>(history[i]).count();
     }
     for (size_t i = size - 6; i < size - 3; ++i) {
-      previousAvg += ndn::time::duration_cast<ndn::time::milliseconds>(history[i].rtt).count();
+      previousAvg += ndn::time::duration_cast<ndn::time::milliseconds>(history[i]).count();
     }
     
     recentAvg /= 3.0;
@@ -855,7 +1404,7 @@ LinkCostManager::setExternalMetrics(const ndn::Name& neighbor, const ExternalMet
   }
   
   // 存储外部指标到独立的map
-  m_externalMetrics[neighbor] = metrics;
+  storeExternalMetrics(*m_adjacencyList.getNeighborId(neighbor), metrics);
   
   NLSR_LOG_INFO("External metrics updated for " << neighbor 
                << " (OriginalCost=" << adjacent->getOriginalLinkCost() << ")");
@@ -872,17 +1421,18 @@ LinkCostManager::getMetricsSnapshot(const ndn::Name& neighbor) const
   
   LinkMetrics metrics;
   metrics.neighbor = neighbor;
+  metrics.neighborId = *m_adjacencyList.getNeighborId(neighbor);
   metrics.originalCost = adjacent->getOriginalLinkCost();
   metrics.currentCost = adjacent->getLinkCost();
   metrics.status = adjacent->getStatus();
   
   // ✅ 从m_externalMetrics读取用户设置（如果有）
-  auto extIt = m_externalMetrics.find(neighbor);
-  if (extIt != m_externalMetrics.end()) {
-    metrics.bandwidth = extIt->second.bandwidth;
-    metrics.bandwidthUtil = extIt->second.bandwidthUtil;
-    metrics.packetLoss = extIt->second.packetLoss;
-    metrics.spectrumStrength = extIt->second.spectrumStrength;
+  auto* ext = findExternalMetrics(neighbor);
+  if (ext != nullptr) {
+    metrics.bandwidth = ext->bandwidth;
+    metrics.bandwidthUtil = ext->bandwidthUtil;
+    metrics.packetLoss = ext->packetLoss;
+    metrics.spectrumStrength = ext->spectrumStrength;
   }
   
   // 计算多维度预览成本（使用默认值或用户设置）
@@ -894,6 +1444,64 @@ LinkCostManager::getMetricsSnapshot(const ndn::Name& neighbor) const
   return metrics;
 }
 
+std::vector<LinkMetricsEntry>
+LinkCostManager::getLinkMetricsEntries() const
+{
+  std::vector<LinkMetricsEntry> entries;
+  entries.reserve(m_adjacencyList.size());
+  for (const auto& adjacent : m_adjacencyList.getAdjList()) {
+    auto metrics = getMetricsSnapshot(adjacent.getName());
+    if (!metrics) {
+      continue;
+    }
+
+    LinkMetricsEntry entry;
+    entry.neighbor = adjacent.getName();
+    entry.bandwidth = metrics->bandwidth;
+    entry.bandwidthUtil = metrics->bandwidthUtil;
+    entry.packetLoss = metrics->packetLoss;
+    entry.spectrumStrength = metrics->spectrumStrength;
+    entry.originalCost = metrics->originalCost;
+    entry.currentCost = metrics->currentCost;
+    entry.multiDimensionalCostPreview = metrics->multiDimensionalCostPreview;
+
+    const auto* rtt = getRttEstimator(adjacent.getName());
+    if (rtt != nullptr && rtt->hasSamples()) {
+      entry.smoothedRtt = ndn::time::duration_cast<ndn::time::microseconds>(rtt->getSrtt());
+    }
+    entries.push_back(std::move(entry));
+  }
+  return entries;
+}
+
+std::vector<LinkCostStatistics>
+LinkCostManager::getLinkCostStatistics() const
+{
+  std::vector<LinkCostStatistics> statistics;
+  statistics.reserve(m_outgoingLinks.size());
+  for (const auto& linkState : m_outgoingLinks) {
+    if (m_adjacencyList.findById(linkState.neighborId) == m_adjacencyList.end()) {
+      continue;
+    }
+    LinkCostStatistics stats;
+    stats.neighbor = linkState.neighbor;
+    stats.nProbes = linkState.nProbes;
+    stats.nProbeTimeouts = linkState.nProbeTimeouts;
+    stats.nCostChanges = linkState.nCostChanges;
+    stats.nSamples = linkState.rttHistogram.getCount();
+    stats.rttP50 = linkState.rttHistogram.getQuantile(0.5);
+    stats.rttP90 = linkState.rttHistogram.getQuantile(0.9);
+    stats.rttP99 = linkState.rttHistogram.getQuantile(0.99);
+    stats.rttMax = linkState.rttHistogram.getMax();
+    if (const auto* traffic = m_adjacencyList.getControlTraffic(linkState.neighborId);
+        traffic != nullptr) {
+      stats.controlTraffic = *traffic;
+    }
+    statistics.push_back(std::move(stats));
+  }
+  return statistics;
+}
+
 double
 LinkCostManager::calculateMultiDimensionalCostPreview(const ndn::Name& neighbor) const
 {
@@ -904,15 +1512,33 @@ LinkCostManager::calculateMultiDimensionalCostPreview(const ndn::Name& neighbor)
     return -1.0;
   }
   double originalCost = adjacent->getOriginalLinkCost();
+  double compositeFactor = calculateMultiDimensionalFactor(findOutgoingLink(neighbor),
+                                                           findExternalMetrics(neighbor));
+  double finalCost = originalCost * compositeFactor;
+
+  NLSR_LOG_DEBUG("Multi-dimensional cost preview for " << neighbor 
+                << ": originalCost=" << originalCost
+                << ", compositeFactor=" << std::fixed << std::setprecision(2) << compositeFactor
+                << ", finalCost=" << finalCost);
   
-  // ===== 1. RTT因子（使用默认值，不读取实际测量）=====
+  return std::round(finalCost);
+}
+
+double
+LinkCostManager::calculateMultiDimensionalFactor(const OutgoingLinkState* link,
+                                                 const ExternalMetrics* ext) const
+{
+  // ===== 1. RTT因子（使用实际测量或默认值）=====
   double rttFactor = 1.1;  // 默认假设RTT=20ms
+  if (link != nullptr && link->rtt.hasSamples()) {
+    double rttMs = ndn::time::duration_cast<ndn::time::milliseconds>(link->rtt.getSrtt()).count();
+    rttFactor = 1.0 + std::min(rttMs / 200.0, 1.0);
+  }
   
   // ===== 2. 带宽因子（使用默认值或用户设置）=====
   double bwFactor = 1.3;  // 默认假设利用率=30%
-  auto extIt = m_externalMetrics.find(neighbor);
-  if (extIt != m_externalMetrics.end() && extIt->second.bandwidthUtil) {
-    double util = *extIt->second.bandwidthUtil;
+  if (ext != nullptr && ext->bandwidthUtil) {
+    double util = *ext->bandwidthUtil;
     if (util <= 0.0) {
       bwFactor = 1.0;
     } else if (util >= 1.0) {
@@ -924,8 +1550,8 @@ LinkCostManager::calculateMultiDimensionalCostPreview(const ndn::Name& neighbor)
   
   // ===== 3. 可靠性因子（使用默认值或用户设置）=====
   double reliabilityFactor = 1.02;  // 默认假设丢包率=1%
-  if (extIt != m_externalMetrics.end() && extIt->second.packetLoss) {
-    double loss = *extIt->second.packetLoss;
+  if (ext != nullptr && ext->packetLoss) {
+    double loss = *ext->packetLoss;
     if (loss <= 0.0) {
       reliabilityFactor = 1.0;
     } else if (loss >= 0.5) {
@@ -937,8 +1563,8 @@ LinkCostManager::calculateMultiDimensionalCostPreview(const ndn::Name& neighbor)
   
   // ===== 4. 频谱因子（使用默认值或用户设置）=====
   double spectrumFactor = 1.4;  // 默认假设频谱=-50dBm
-  if (extIt != m_externalMetrics.end() && extIt->second.spectrumStrength) {
-    double strength = *extIt->second.spectrumStrength;
+  if (ext != nullptr && ext->spectrumStrength) {
+    double strength = *ext->spectrumStrength;
     if (strength >= -30) {
       spectrumFactor = 1.0;
     } else if (strength <= -80) {
@@ -954,19 +1580,31 @@ LinkCostManager::calculateMultiDimensionalCostPreview(const ndn::Name& neighbor)
     m_multiDimConfig.bandwidthWeight * bwFactor +
     m_multiDimConfig.reliabilityWeight * reliabilityFactor +
     m_multiDimConfig.spectrumWeight * spectrumFactor;
-  
-  double finalCost = originalCost * compositeFactor;
-  
-  NLSR_LOG_DEBUG("Multi-dimensional cost preview for " << neighbor 
-                << ": originalCost=" << originalCost
-                << ", rttFactor=" << std::fixed << std::setprecision(2) << rttFactor
-                << ", bwFactor=" << bwFactor
-                << ", reliabilityFactor=" << reliabilityFactor
-                << ", spectrumFactor=" << spectrumFactor
-                << ", compositeFactor=" << compositeFactor
-                << ", finalCost=" << finalCost);
-  
-  return std::round(finalCost);
+
+  NLSR_LOG_TRACE("Multi-dimensional factors: rtt=" << rttFactor
+                 << ", bw=" << bwFactor
+                 << ", reliability=" << reliabilityFactor
+                 << ", spectrum=" << spectrumFactor);
+  return compositeFactor;
+}
+
+void
+LinkCostManager::onExternalMetricsChanged(NeighborId id)
+{
+  if (!m_isActive || m_confParam.getCostMetric() != CostMetric::MULTI_DIMENSIONAL ||
+      id >= m_outgoingLinks.size()) {
+    return;
+  }
+
+  auto& linkState = m_outgoingLinks[id];
+  if (linkState.status == Adjacent::STATUS_INACTIVE) {
+    return;
+  }
+  const auto& neighbor = linkState.neighbor;
+  double newCost = applyCostDamping(neighbor, linkState, calculateNewCost(neighbor));
+  if (shouldUpdateCost(neighbor, newCost)) {
+    updateNeighborCost(neighbor, newCost);
+  }
 }
 
 // ===== nlsrc命令处理实现 =====
@@ -974,6 +1612,11 @@ LinkCostManager::calculateMultiDimensionalCostPreview(const ndn::Name& neighbor)
 void
 LinkCostManager::handleSetMetricsCommand(const ndn::Interest& interest)
 {
+  if (interest.hasApplicationParameters()) {
+    handleSetMetricsBatchCommand(interest);
+    return;
+  }
+
   const auto& name = interest.getName();
   
   // 解析Interest名称：/localhost/nlsr/link-cost-manager/set-metrics/<neighbor>/[options]
@@ -1056,6 +1699,116 @@ LinkCostManager::handleSetMetricsCommand(const ndn::Interest& interest)
   NLSR_LOG_INFO("Sent set-metrics response for " << neighborName);
 }
 
+void
+LinkCostManager::handleSetMetricsBatchCommand(const ndn::Interest& interest)
+{
+  LinkMetricsCommand command;
+  try {
+    command.wireDecode(interest.getApplicationParameters().blockFromValue());
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_WARN("Malformed set-metrics command: " << e.what());
+    sendControlResponse(interest, 400, "Malformed LinkMetricsCommand");
+    return;
+  }
+
+  size_t nUpdated = applyExternalMetrics(command.getEntries());
+  sendControlResponse(interest, 200, "Updated " + std::to_string(nUpdated) + " of " +
+                      std::to_string(command.getEntries().size()) + " neighbors");
+}
+
+LinkCostManager::OutgoingLinkState*
+LinkCostManager::findOutgoingLink(const ndn::Name& neighbor)
+{
+  auto id = m_adjacencyList.getNeighborId(neighbor);
+  return id && *id < m_outgoingLinks.size() ? &m_outgoingLinks[*id] : nullptr;
+}
+
+const LinkCostManager::OutgoingLinkState*
+LinkCostManager::findOutgoingLink(const ndn::Name& neighbor) const
+{
+  auto id = m_adjacencyList.getNeighborId(neighbor);
+  return id && *id < m_outgoingLinks.size() ? &m_outgoingLinks[*id] : nullptr;
+}
+
+const LinkCostManager::ExternalMetrics*
+LinkCostManager::findExternalMetrics(const ndn::Name& neighbor) const
+{
+  auto id = m_adjacencyList.getNeighborId(neighbor);
+  if (!id || *id >= m_externalMetrics.size() || !m_externalMetrics[*id]) {
+    return nullptr;
+  }
+  return &*m_externalMetrics[*id];
+}
+
+void
+LinkCostManager::storeExternalMetrics(NeighborId id, const ExternalMetrics& metrics)
+{
+  if (id >= m_externalMetrics.size()) {
+    m_externalMetrics.resize(id + 1);
+  }
+  m_externalMetrics[id] = metrics;
+  if (m_sampleRecorder != nullptr) {
+    auto adjacent = m_adjacencyList.findById(id);
+    if (adjacent != m_adjacencyList.end()) {
+      recordSample(adjacent->getName(), metrics);
+    }
+  }
+  onExternalMetricsChanged(id);
+}
+
+void
+LinkCostManager::recordSample(LinkSample::Type type, const ndn::Name& neighbor, uint32_t value,
+                              ndn::time::steady_clock::duration rtt)
+{
+  if (m_sampleRecorder == nullptr) {
+    return;
+  }
+  LinkSample sample;
+  sample.type = type;
+  sample.neighbor = neighbor;
+  sample.value = value;
+  sample.rtt = ndn::time::duration_cast<ndn::time::microseconds>(rtt);
+  m_sampleRecorder->record(std::move(sample));
+}
+
+void
+LinkCostManager::recordSample(const ndn::Name& neighbor, const ExternalMetrics& metrics)
+{
+  if (m_sampleRecorder == nullptr) {
+    return;
+  }
+  LinkSample sample;
+  sample.type = LinkSample::Type::EXTERNAL_METRICS;
+  sample.neighbor = neighbor;
+  sample.bandwidth = metrics.bandwidth;
+  sample.bandwidthUtil = metrics.bandwidthUtil;
+  sample.packetLoss = metrics.packetLoss;
+  sample.spectrumStrength = metrics.spectrumStrength;
+  m_sampleRecorder->record(std::move(sample));
+}
+
+size_t
+LinkCostManager::applyExternalMetrics(const std::vector<LinkMetricsEntry>& entries)
+{
+  auto now = ndn::time::steady_clock::now();
+  size_t nUpdated = 0;
+  for (const auto& entry : entries) {
+    auto id = m_adjacencyList.getNeighborId(entry.neighbor);
+    if (!id) {
+      NLSR_LOG_DEBUG("Ignoring external metrics of unknown neighbor " << entry.neighbor);
+      continue;
+    }
+    storeExternalMetrics(*id, {entry.bandwidth, entry.bandwidthUtil, entry.packetLoss,
+                               entry.spectrumStrength, now});
+    ++nUpdated;
+  }
+
+  NLSR_LOG_DEBUG("External metrics updated for " << nUpdated << " of " << entries.size()
+                 << " neighbors");
+  return nUpdated;
+}
+
 void
 LinkCostManager::handleGetMetricsCommand(const ndn::Interest& interest)
 {
@@ -1134,6 +1887,17 @@ LinkCostManager::handleGetMetricsCommand(const ndn::Interest& interest)
   NLSR_LOG_INFO("Sent get-metrics response for " << neighborName);
 }
 
+void
+LinkCostManager::sendControlResponse(const ndn::Interest& interest, uint32_t code,
+                                     const std::string& text)
+{
+  auto data = std::make_shared<ndn::Data>(interest.getName());
+  data->setContent(ndn::mgmt::ControlResponse(code, text).wireEncode());
+  data->setFreshnessPeriod(ndn::time::milliseconds(100));
+  m_keyChain.sign(*data, m_confParam.getSigningInfo());
+  m_face.put(*data);
+}
+
 void
 LinkCostManager::sendNack(const ndn::Interest& interest)
 {
@@ -1144,4 +1908,29 @@ LinkCostManager::sendNack(const ndn::Interest& interest)
   m_face.put(*data);
 }
 
+void
+LinkCostManager::reportMemory(MemoryStatus& status) const
+{
+  MemoryUsage links;
+  links.nElements = m_outgoingLinks.size();
+  links.nBytes = m_outgoingLinks.capacity() * sizeof(OutgoingLinkState) +
+                 m_externalMetrics.capacity() * sizeof(m_externalMetrics[0]);
+  for (const auto& link : m_outgoingLinks) {
+    links.nBytes += getNameMemory(link.neighbor);
+  }
+  for (const auto& [seqNo, measurement] : m_pendingMeasurements) {
+    links.nBytes += HASH_NODE_OVERHEAD + sizeof(seqNo) + sizeof(measurement) +
+                    getNameMemory(measurement.first);
+  }
+  for (const auto& [neighbor, cost] : m_pendingCostUpdates) {
+    links.nBytes += HASH_NODE_OVERHEAD + sizeof(neighbor) + sizeof(cost) +
+                    getNameMemory(neighbor);
+  }
+  for (const auto& [neighbor, trace] : m_pendingCostTraces) {
+    links.nBytes += HASH_NODE_OVERHEAD + sizeof(neighbor) + sizeof(trace) +
+                    getNameMemory(neighbor);
+  }
+  status.addComponent("link-cost", links);
+}
+
 } // namespace nlsr
\ No newline at end of file
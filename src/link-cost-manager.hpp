@@ -23,10 +23,22 @@
  #define NLSR_LINK_COST_MANAGER_HPP
  
  #include "adjacency-list.hpp"
+ #include "cost-flap-damping.hpp"
+ #include "cost-quantizer.hpp"
+ #include "face-counter-collector.hpp"
+ #include "link-metrics-status.hpp"
+ #include "link-rtt-estimator.hpp"
+ #include "link-sample-trace.hpp"
+ #include "metrics-ingestor.hpp"
+ #include "rtt-histogram.hpp"
+#include "rtt-spike-filter.hpp"
+ #include "timer-wheel.hpp"
  #include "lsdb.hpp"
+ #include "memory-usage.hpp"
  #include "route/routing-table.hpp"
  #include "conf-parameter.hpp"
  #include "common.hpp"
+ #include "convergence-tracer.hpp"
  
  #include <ndn-cxx/face.hpp>
  #include <ndn-cxx/security/key-chain.hpp>
@@ -35,23 +47,32 @@
  #include <ndn-cxx/util/signal.hpp>
  
  #include <unordered_map>
- #include <deque>
  #include <functional>
  #include <optional>
+#include <variant>
+#include <vector>
  
  namespace nlsr {
 
+class LoadAwareRoutingCalculator;
+class MLAdaptiveCalculator;
+
  class LinkCostManager {
  public:
   // ✅ 链路指标结构体（为负载感知算法提供完整数据）
   struct LinkMetrics {
     ndn::Name neighbor;
+    // Index of the neighbor's per-neighbor state, see AdjacencyList::getNeighborId
+    NeighborId neighborId = 0;
     double originalCost;
     double currentCost;
     std::optional<ndn::time::steady_clock::duration> currentRtt;
     std::optional<uint32_t> timeoutCount;
     std::optional<ndn::time::steady_clock::time_point> lastSuccessTime;
-    std::vector<ndn::time::steady_clock::duration> rttHistory;
+    // Share of returning Data carrying a congestion mark, see OutgoingLinkState
+    double congestionMarkRate = 0.0;
+    // Copy of the link's estimator; currentRtt is its smoothed RTT
+    LinkRttEstimator rtt;
     Adjacent::Status status;
     
     // === 新增：外部设定的多维度指标 ===
@@ -64,71 +85,70 @@
     std::optional<double> multiDimensionalCostPreview;
   };
 
-   // 定义负载感知成本计算回调类型
-   using LoadAwareCostCalculator = std::function<double(const ndn::Name&, double, const LinkMetrics&)>;
-
-   //ML反馈回调类型定义
-   using MLFeedbackCallback = std::function<void(const ndn::Name&, double)>;
-   //设置ML反馈回调方法
-   void setMLFeedbackCallback(MLFeedbackCallback callback);
-   void clearMLFeedbackCallback();
-   bool isMLFeedbackEnabled() const { return static_cast<bool>(m_mlFeedbackCallback);}
+  /**
+   * @brief Policy adjusting the RTT-based cost of a link on every sample.
+   *
+   * std::monostate keeps the RTT-based cost. Each policy type provides
+   * `double computeLinkCost(const OutgoingLinkState&, double rttBasedCost)` and is called
+   * through std::visit, so the per-sample cost path has neither type erasure nor a copy of
+   * the link state.
+   *
+   * The cost of MLAdaptiveCalculator is local: it is applied as an edge weight of the local
+   * SPF graph at calculation time, see MLAdaptiveCalculator::predictAllLinkCosts(). The
+   * RTT-based cost is advertised instead, and a significant change of the ML cost only
+   * schedules a routing calculation, without an Adjacency LSA rebuild.
+   */
+  using CostPolicy = std::variant<std::monostate, LoadAwareRoutingCalculator*, MLAdaptiveCalculator*>;
 
    /**
-    * @brief Simple RTT measurement for single neighbor
+    * @brief Report the real-time performance of each link to @p calculator.
     */
-   struct RttMeasurement {
-     ndn::time::steady_clock::duration rtt;
-     ndn::time::steady_clock::time_point timestamp;
-     bool isValid;
-     
-     RttMeasurement(ndn::time::steady_clock::duration r, 
-                   ndn::time::steady_clock::time_point t, 
-                   bool valid = true)
-       : rtt(r), timestamp(t), isValid(valid) {}
-   };
- 
+   void setMLFeedbackTarget(MLAdaptiveCalculator& calculator);
+   void clearMLFeedbackTarget();
+   bool isMLFeedbackEnabled() const { return m_mlFeedbackTarget != nullptr; }
+
    /**
     * @brief Outgoing link state tracking
     */
    struct OutgoingLinkState {
      ndn::Name neighbor;
+     NeighborId neighborId = 0;
      Adjacent::Status status;
      double originalCost;
      double currentCost;
      uint32_t timeoutCount;
      ndn::time::steady_clock::time_point lastSuccess;
      ndn::time::steady_clock::time_point lastLsaTriggerTime;
-     std::deque<RttMeasurement> rttHistory;
-     
-     //最大保存样本数量
-     static constexpr size_t MAX_RTT_SAMPLES = 2;
+     LinkRttEstimator rtt;
+     // Last RTT-based cost, before damping; flaps are counted on it
+     double lastComputedCost;
+     CostFlapDamping::State damping;
+     // Recent RTT samples, to tell spikes from level shifts, see rtt-spike-filter
+     RttSpikeFilter::State spikeFilter;
+     // Cost level of the last computed cost, when cost-buckets is enabled
+     std::optional<size_t> costLevel;
+     // Since when the local cost differs from the advertised one by more than
+     // cost-advertise-threshold, see shouldAdvertiseCost()
+     std::optional<ndn::time::steady_clock::time_point> divergedSince;
+     // EWMA of the share of probe and Hello Data that NFD marked as congested; rises before
+     // queueing inflates the RTT
+     double congestionMarkRate = 0.0;
+     // Current interval between RTT probes, see adaptProbeInterval()
+     ndn::time::steady_clock::duration probeInterval;
+     // Statistics since start, served by the link-cost dataset
+     RttHistogram rttHistogram;
+     uint64_t nProbes = 0;
+     uint64_t nProbeTimeouts = 0;
+     uint64_t nCostChanges = 0;
+     uint64_t nRttSpikes = 0;
+     // Local cost of the cost policy at the last routing calculation it scheduled
+     std::optional<double> localPolicyCost;
      
      bool isStable() const {
        return status == Adjacent::STATUS_ACTIVE && 
               timeoutCount == 0 && 
               (ndn::time::steady_clock::now() - lastSuccess) < ndn::time::minutes(1);
      }
-     
-     void addRttMeasurement(ndn::time::steady_clock::duration rtt) {
-       RttMeasurement measurement(rtt, ndn::time::steady_clock::now(), true);
-       rttHistory.push_back(measurement);
-       if (rttHistory.size() > MAX_RTT_SAMPLES) {
-         rttHistory.pop_front();
-       }
-     }
-     
-     ndn::time::steady_clock::duration getAverageRtt() const {
-       if (rttHistory.empty()) {
-         return ndn::time::milliseconds(0);
-       }
-       
-       auto total = ndn::time::milliseconds(0);
-       for (const auto& measurement : rttHistory) {
-         total += ndn::time::duration_cast<ndn::time::milliseconds>(measurement.rtt);
-       }
-       return total / rttHistory.size();
-     }
    };
 
  public:
@@ -139,16 +159,53 @@
    ~LinkCostManager();
   
    // ✅ 修复：移除内联日志调用，改为声明式
-   void setLoadAwareCostCalculator(LoadAwareCostCalculator calculator);
-   void clearLoadAwareCostCalculator();
+   void setCostPolicy(CostPolicy policy);
+   void clearCostPolicy();
    
    bool isLoadAwareModeEnabled() const { 
-     return static_cast<bool>(m_loadAwareCostCalculator); 
+     return !std::holds_alternative<std::monostate>(m_costPolicy); 
    }
 
+  const CostPolicy&
+  getCostPolicy() const
+  {
+    return m_costPolicy;
+  }
+
   // ✅ 获取链路完整指标
   std::optional<LinkMetrics> getLinkMetrics(const ndn::Name& neighbor) const;
 
+  /**
+   * @brief Return the dense ID of a configured neighbor, shared with the cost calculators.
+   */
+  std::optional<NeighborId> getNeighborId(const ndn::Name& neighbor) const
+  {
+    return m_adjacencyList.getNeighborId(neighbor);
+  }
+
+  /**
+   * @brief Return the io_context on which the link measurements and their feedback run.
+   */
+  boost::asio::io_context&
+  getIoContext() const
+  {
+    return m_face.getIoContext();
+  }
+
+  /**
+   * @brief Return the state of the links to all configured neighbors, indexed by NeighborId.
+   */
+  const std::vector<OutgoingLinkState>& getOutgoingLinks() const
+  {
+    return m_outgoingLinks;
+  }
+
+  /**
+   * @brief Add the memory of the link states, of the pending measurements and cost updates
+   *        and of the external metrics to @p status .
+   */
+  void reportMemory(MemoryStatus& status) const;
+
   // ===== 新增：外部指标管理接口 =====
   /**
    * @brief 外部指标结构体（用于nlsrc命令输入）
@@ -173,7 +230,7 @@
   
   /**
    * @brief 设置邻居的外部指标（通过nlsrc调用）
-   * @note 仅影响预览计算，不影响实际路由
+   * @note Only affects the advertised cost with cost-metric multi-dimensional
    */
   void setExternalMetrics(const ndn::Name& neighbor, const ExternalMetrics& metrics);
   
@@ -181,9 +238,47 @@
    * @brief 获取邻居的完整指标快照（用于nlsrc展示）
    */
   std::optional<LinkMetrics> getMetricsSnapshot(const ndn::Name& neighbor) const;
+
+  /**
+   * @brief Return the metrics of all configured neighbors, as served by the link-metrics dataset.
+   */
+  std::vector<LinkMetricsEntry> getLinkMetricsEntries() const;
+
+  /**
+   * @brief Return the spare capacity of the link to @p neighbor , in Mbps.
+   *
+   * This is bandwidth * (1 - bandwidthUtil) of its external metrics; a missing bandwidth
+   * counts as 1. Returns std::nullopt if neither metric was set.
+   */
+  std::optional<double> getSpareCapacity(const ndn::Name& neighbor) const;
+
+  /**
+   * @brief Store the utilization and loss rates measured from the NFD counters of adjacency faces.
+   *
+   * The utilization is relative to the bandwidth of the external metrics, or else to
+   * link-bandwidth; it is not set if neither is known. Other external metrics are kept.
+   */
+  void applyFaceLoads(const std::vector<FaceCounterCollector::FaceLoad>& loads);
+
+  /**
+   * @brief Return the local costs of the links whose cost is not advertised yet.
+   *
+   * They replace the advertised costs of this router's links in its own routing calculation,
+   * see LocalCostOverlay. The overlay is empty unless cost-advertise-threshold is set.
+   */
+  std::vector<std::pair<ndn::Name, double>> getLocalCostOverlay() const;
+
+  /**
+   * @brief Return the RTT percentiles, probe losses and cost changes of all links, as served by
+   *        the link-cost dataset.
+   */
+  std::vector<LinkCostStatistics> getLinkCostStatistics() const;
   
   /**
-   * @brief 计算多因素预览成本（不应用到实际路由）
+   * @brief 计算多因素成本
+   *
+   * With cost-metric multi-dimensional this is the cost that is advertised, before
+   * damping and cost-buckets; otherwise it is only reported as a preview.
    */
   double calculateMultiDimensionalCostPreview(const ndn::Name& neighbor) const;
   
@@ -199,6 +294,12 @@
     */
    void initialize();
  
+   /**
+    * @brief Follow the neighbors added to or removed from the adjacency list, and the
+    *        configured costs, after a configuration reload
+    */
+   void updateNeighbors();
+ 
    /**
     * @brief Start dynamic cost management
     */
@@ -216,14 +317,21 @@
 
    // 新增：为负载感知路由提供的接口
    /**
-    * @brief 获取邻居的RTT历史统计信息
+    * @brief 获取邻居的RTT统计信息
+    * @return RTT estimator of the neighbor, or nullptr if it is unknown
     */
-   std::vector<ndn::time::steady_clock::duration> getRttHistory(const ndn::Name& neighbor) const;
+   const LinkRttEstimator* getRttEstimator(const ndn::Name& neighbor) const;
   
    /**
     * @brief 获取邻居的超时统计信息
     */
    std::optional<uint32_t> getTimeoutCount(const ndn::Name& neighbor) const;
+
+   /**
+    * @brief Return packet loss of the link to @p neighbor , as measured from the face counters
+    *        or set by 'nlsrc set-metrics', or nullopt if it is unknown
+    */
+   std::optional<double> getPacketLoss(const ndn::Name& neighbor) const;
   
    /**
     * @brief 获取邻居的最后成功时间
@@ -238,34 +346,134 @@
    // Hello Protocol Event Handlers (called by HelloProtocol)
    void onHelloInterestSent(const ndn::Name& neighbor);
    void onHelloDataReceived(const ndn::Name& neighbor);
+   /**
+    * @brief Use the round trip of a Hello exchange as an RTT sample.
+    *
+    * Ignored unless rtt-source is hello or hybrid.
+    */
+   void onHelloRttMeasured(const ndn::Name& neighbor, ndn::time::steady_clock::duration rtt);
+   /**
+    * @brief Account whether a probe or Hello Data from @p neighbor carried a congestion mark.
+    */
+   void onCongestionSample(const ndn::Name& neighbor, bool isMarked);
    void onHelloTimeout(const ndn::Name& neighbor, uint32_t timeouts);
    void onNeighborStatusChanged(const ndn::Name& neighbor, Adjacent::Status newStatus);
  
    // Debug/Status functions
    double getCurrentCost(const ndn::Name& neighbor) const;
    std::optional<ndn::time::steady_clock::duration> getCurrentRtt(const ndn::Name& neighbor) const;
+   std::optional<ndn::time::steady_clock::duration> getProbeInterval(const ndn::Name& neighbor) const;
    std::optional<double> getLinkCost(const ndn::Name& neighbor) const;
    
    // ✅ 正确的信号声明（遵循NLSR规范）
    ndn::signal::Signal<LinkCostManager, const ndn::Name&, double> onNeighborCostUpdated;
 
+   /**
+    * @brief Emitted when the advertised cost of the link to a neighbor changes, with the
+    *        previous and the new cost.
+    */
+   ndn::signal::Signal<LinkCostManager, const ndn::Name&, double, double> afterCostChanged;
+
    // 设置是否启用负载感知模式
    void setLoadAwareMode(bool enabled) { m_loadAwareMode = enabled; }
    bool isLoadAwareMode() const { return m_loadAwareMode; }
+
+   /**
+    * @brief Begin a convergence trace for each queued cost change; nullptr to stop tracing.
+    */
+   void setConvergenceTracer(ConvergenceTracer* tracer) { m_tracer = tracer; }
  
  private:
    // RTT Measurement
+   /**
+    * @brief Answer an RTT probe from a neighbor.
+    *
+    * The reply is copied from a prepared template and protected with DigestSha256,
+    * so that turnaround time does not include an asymmetric signature.
+    */
+   void processRttProbe(const ndn::Interest& interest);
    void scheduleRttMeasurement(const ndn::Name& neighbor);
+   void onMeasurementTimer(NeighborId id);
    void performRttMeasurement(const ndn::Name& neighbor);
-   void handleRttResponse(const ndn::Name& neighbor, uint32_t seq,
+   void handleRttResponse(NeighborId id, uint32_t seq,
                          ndn::time::steady_clock::time_point sendTime,
                          const ndn::Data& data);
-   void handleRttTimeout(const ndn::Name& neighbor, uint32_t seq);
+   void handleRttTimeout(NeighborId id, uint32_t seq);
+   /**
+    * @brief Add an RTT sample, whatever its source, and update the cost if needed.
+    */
+   void processRttSample(const ndn::Name& neighbor, ndn::time::steady_clock::duration rtt);
+   /**
+    * @brief Whether a probe is needed, given the configured RTT source and the last sample.
+    */
+   bool needsRttProbe(const ndn::Name& neighbor) const;
+   /**
+    * @brief Account a computed cost in the flap damping state of the link.
+    * @return @p cost , or the conservative cost of the link while it is suppressed
+    */
+   double applyCostDamping(const ndn::Name& neighbor, OutgoingLinkState& linkState, double cost);
+   /**
+    * @brief Round a cost to its cost level, keeping the current level within the hysteresis.
+    * @return @p cost if cost-buckets is disabled
+    */
+   double quantizeCost(OutgoingLinkState& linkState, double cost);
+   /**
+    * @brief Adapt the probe interval of a link to its last RTT sample or probe timeout.
+    *
+    * The interval doubles while the RTT variation is low and halves when it is high, within
+    * rtt-probe-interval-min and rtt-probe-interval-max. A timeout resets it to the minimum.
+    */
+   void adaptProbeInterval(OutgoingLinkState& linkState, bool isTimeout);
+   ndn::time::steady_clock::duration getInitialProbeInterval() const;
  
    // Cost Calculation and Update
    double calculateNewCost(const ndn::Name& neighbor);
+   /**
+    * @brief Return the weighted multi-dimensional factor applied to the configured cost.
+    *
+    * The measured RTT of @p link and the external metrics @p ext are used when available,
+    * and default values otherwise.
+    */
+   double calculateMultiDimensionalFactor(const OutgoingLinkState* link,
+                                          const ExternalMetrics* ext) const;
+   /**
+    * @brief Recompute the cost of a link whose external metrics changed, when they are part
+    *        of the cost-metric.
+    */
+   void onExternalMetricsChanged(NeighborId id);
+   /**
+    * @brief Whether a new local cost of a link is to be advertised.
+    *
+    * Costs differing from @p advertisedCost by less than cost-advertise-threshold stay local,
+    * and larger differences must persist for cost-advertise-hold.
+    */
+   bool shouldAdvertiseCost(OutgoingLinkState& linkState, double advertisedCost, double cost,
+                            ndn::time::steady_clock::time_point now) const;
+   bool isLocalCostOverlayEnabled() const { return m_confParam.getCostAdvertiseThreshold() > 0; }
    bool shouldUpdateCost(const ndn::Name& neighbor, double newCost);
    void updateNeighborCost(const ndn::Name& neighbor, double rttBasedCost);
+   /**
+    * @brief Schedule a routing calculation if the local cost of a link changed significantly.
+    */
+   void onLocalPolicyCost(OutgoingLinkState& linkState, double cost);
+   /**
+    * @brief Append an input of the cost calculation to the link sample trace, if enabled.
+    */
+   void recordSample(LinkSample::Type type, const ndn::Name& neighbor, uint32_t value = 0,
+                     ndn::time::steady_clock::duration rtt = {});
+   void recordSample(const ndn::Name& neighbor, const ExternalMetrics& metrics);
+   /**
+    * @brief Apply the cost updates collected during the cost-update-window.
+    *
+    * All changed costs are written to the AdjacencyList together, followed by a single
+    * COST_UPDATE Adjacency LSA build.
+    */
+   void applyPendingCostUpdates();
+   /**
+    * @brief Close the convergence trace of a cost update that is no longer queued.
+    */
+   void endPendingCostTrace(const ndn::Name& neighbor);
+   void endPendingCostTraces();
  
    // ✅ 添加验证机制
    void verifyUpdateSuccess(const ndn::Name& neighbor, double expectedCost);
@@ -282,6 +490,19 @@
    * @brief 处理来自nlsrc的set-metrics命令
    */
   void handleSetMetricsCommand(const ndn::Interest& interest);
+
+  /**
+   * @brief Handle a set-metrics command carrying a LinkMetricsCommand for many neighbors.
+   *
+   * The command is answered with a single ControlResponse.
+   */
+  void handleSetMetricsBatchCommand(const ndn::Interest& interest);
+
+  /**
+   * @brief Store the external metrics of configured neighbors; others are ignored.
+   * @return number of neighbors updated
+   */
+  size_t applyExternalMetrics(const std::vector<LinkMetricsEntry>& entries);
   
   /**
    * @brief 处理来自nlsrc的get-metrics命令
@@ -292,6 +513,23 @@
    * @brief 发送错误响应
    */
   void sendNack(const ndn::Interest& interest);
+
+  void sendControlResponse(const ndn::Interest& interest, uint32_t code, const std::string& text);
+
+  /**
+   * @brief Create the link states of the neighbors with an ID above the known ones.
+   */
+  void addNewNeighbors();
+
+  /**
+   * @brief Return the link state of a neighbor, or nullptr if it was not known at initialize()
+   *        or at the last updateNeighbors().
+   */
+  OutgoingLinkState* findOutgoingLink(const ndn::Name& neighbor);
+  const OutgoingLinkState* findOutgoingLink(const ndn::Name& neighbor) const;
+
+  const ExternalMetrics* findExternalMetrics(const ndn::Name& neighbor) const;
+  void storeExternalMetrics(NeighborId id, const ExternalMetrics& metrics);
  
    // NLSR Component References
    ndn::Face& m_face;
@@ -303,10 +541,30 @@
    Fib& m_fib;
  
    // State Management
-   std::unordered_map<ndn::Name, OutgoingLinkState> m_outgoingLinks;
-   std::unordered_map<uint32_t, std::pair<ndn::Name, ndn::time::steady_clock::time_point>> m_pendingMeasurements;
+   // Indexed by NeighborId
+   std::vector<OutgoingLinkState> m_outgoingLinks;
+   // By probe sequence number; the neighbor is kept as its NeighborId, so that a probe
+   // copies no Name
+   std::unordered_map<uint32_t, std::pair<NeighborId, ndn::time::steady_clock::time_point>>
+     m_pendingMeasurements;
+   std::unordered_map<ndn::Name, double> m_pendingCostUpdates;
+   // convergence traces of the queued cost updates
+   std::unordered_map<ndn::Name, uint64_t> m_pendingCostTraces;
+   ConvergenceTracer* m_tracer = nullptr;
    
    ndn::Scheduler m_scheduler;
+   // RTT measurement timers, keyed by NeighborId
+   TimerWheel m_measurementWheel;
+   ndn::Data m_rttProbeReply;
+   ndn::scheduler::ScopedEventId m_costUpdateEvent;
+   bool m_isCostUpdateScheduled = false;
+   std::optional<CostFlapDamping> m_costDamping;
+   std::optional<CostQuantizer> m_costQuantizer;
+   std::optional<RttSpikeFilter> m_spikeFilter;
+   std::unique_ptr<MetricsIngestor> m_metricsIngestor;
+   std::unique_ptr<FaceCounterCollector> m_faceCounterCollector;
+   // Records the inputs of the cost calculation, see link-sample-trace
+   std::unique_ptr<LinkSampleRecorder> m_sampleRecorder;
    bool m_isActive;
    uint32_t m_nextSequenceNumber;
    
@@ -325,10 +583,11 @@
    bool m_loadAwareMode = false;
    
   // ✅ 负载感知成本计算器
-  LoadAwareCostCalculator m_loadAwareCostCalculator;
+  CostPolicy m_costPolicy;
   
   // ===== 新增：外部指标存储 =====
-  std::unordered_map<ndn::Name, ExternalMetrics> m_externalMetrics;
+  // Indexed by NeighborId; grown when metrics of a neighbor are first set
+  std::vector<std::optional<ExternalMetrics>> m_externalMetrics;
   MultiDimensionalCostConfig m_multiDimConfig;
  private:
     // ===== ML性能计算核心方法 =====
@@ -370,10 +629,21 @@
   double calculateTrendPerformanceScore(const ndn::Name& neighbor);
 
  private:
-  MLFeedbackCallback m_mlFeedbackCallback;
+  MLAdaptiveCalculator* m_mlFeedbackTarget = nullptr;
   
   // ===== 性能计算配置参数 =====
   static constexpr size_t MIN_SAMPLES_FOR_ML_FEEDBACK = 3;
+  // Number of samples needed before the RTT-based cost replaces the configured one
+  static constexpr size_t MIN_SAMPLES_FOR_COST_UPDATE = 2;
+  // Weight of a new sample in the congestion mark rate, as the RTT gain of RFC 6298
+  static constexpr double CONGESTION_MARK_GAIN = 0.125;
+  // Measurement delays are in seconds; a rotation covers 6.4 s
+  static constexpr ndn::time::milliseconds MEASUREMENT_TIMER_TICK{100};
+  static constexpr size_t MEASUREMENT_TIMER_SLOTS = 64;
+  // RTT variation, relative to the smoothed RTT, below which a link is probed less often
+  // and above which it is probed more often
+  static constexpr double PROBE_BACKOFF_RTTVAR_RATIO = 0.1;
+  static constexpr double PROBE_SPEEDUP_RTTVAR_RATIO = 0.25;
   
   // RTT性能评估阈值 (毫秒)
   static constexpr double RTT_EXCELLENT_THRESHOLD = 10.0;
@@ -0,0 +1,356 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "link-metrics-status.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nlsr {
+
+namespace {
+
+template<ndn::encoding::Tag TAG>
+size_t
+prependOptionalDouble(ndn::EncodingImpl<TAG>& block, uint32_t type, const std::optional<double>& value)
+{
+  return value ? ndn::encoding::prependDoubleBlock(block, type, *value) : 0;
+}
+
+void
+readOptionalDouble(ndn::Block::element_const_iterator& val, ndn::Block::element_const_iterator end,
+                   uint32_t type, std::optional<double>& value)
+{
+  if (val != end && val->type() == type) {
+    value = ndn::encoding::readDouble(*val);
+    ++val;
+  }
+}
+
+template<typename T>
+ndn::Block
+encodeToBlock(const T& object)
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = object.wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  object.wireEncode(buffer);
+
+  return buffer.block();
+}
+
+} // namespace
+
+template<ndn::encoding::Tag TAG>
+size_t
+LinkMetricsEntry::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  totalLength += prependOptionalDouble(block, nlsr::tlv::MultiDimensionalCost,
+                                       multiDimensionalCostPreview);
+  if (smoothedRtt) {
+    totalLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::SmoothedRtt,
+                                                                 smoothedRtt->count());
+  }
+  totalLength += prependOptionalDouble(block, nlsr::tlv::Cost, currentCost);
+  totalLength += prependOptionalDouble(block, nlsr::tlv::OriginalCost, originalCost);
+  totalLength += prependOptionalDouble(block, nlsr::tlv::SpectrumStrength, spectrumStrength);
+  totalLength += prependOptionalDouble(block, nlsr::tlv::PacketLoss, packetLoss);
+  totalLength += prependOptionalDouble(block, nlsr::tlv::BandwidthUtilization, bandwidthUtil);
+  totalLength += prependOptionalDouble(block, nlsr::tlv::Bandwidth, bandwidth);
+  totalLength += neighbor.wireEncode(block);
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::ExternalMetrics);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(LinkMetricsEntry);
+
+ndn::Block
+LinkMetricsEntry::wireEncode() const
+{
+  return encodeToBlock(*this);
+}
+
+void
+LinkMetricsEntry::wireDecode(const ndn::Block& wire)
+{
+  *this = {};
+
+  if (wire.type() != nlsr::tlv::ExternalMetrics) {
+    NDN_THROW(Error("ExternalMetrics", wire.type()));
+  }
+
+  wire.parse();
+  auto val = wire.elements_begin();
+  auto end = wire.elements_end();
+
+  if (val != end && val->type() == ndn::tlv::Name) {
+    neighbor.wireDecode(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required Name field"));
+  }
+
+  readOptionalDouble(val, end, nlsr::tlv::Bandwidth, bandwidth);
+  readOptionalDouble(val, end, nlsr::tlv::BandwidthUtilization, bandwidthUtil);
+  readOptionalDouble(val, end, nlsr::tlv::PacketLoss, packetLoss);
+  readOptionalDouble(val, end, nlsr::tlv::SpectrumStrength, spectrumStrength);
+  readOptionalDouble(val, end, nlsr::tlv::OriginalCost, originalCost);
+  readOptionalDouble(val, end, nlsr::tlv::Cost, currentCost);
+  if (val != end && val->type() == nlsr::tlv::SmoothedRtt) {
+    smoothedRtt = ndn::time::microseconds(ndn::encoding::readNonNegativeInteger(*val));
+    ++val;
+  }
+  readOptionalDouble(val, end, nlsr::tlv::MultiDimensionalCost, multiDimensionalCostPreview);
+
+  if (val != end) {
+    NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(val->type()) +
+                    " in ExternalMetrics"));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LinkMetricsEntry& entry)
+{
+  os << "Neighbor: " << entry.neighbor << "\n";
+  if (entry.originalCost) {
+    os << "  OriginalCost: " << *entry.originalCost << "\n";
+  }
+  if (entry.currentCost) {
+    os << "  CurrentCost: " << *entry.currentCost << "\n";
+  }
+  if (entry.smoothedRtt) {
+    os << "  SmoothedRtt: " << entry.smoothedRtt->count() / 1000.0 << " ms\n";
+  }
+  if (entry.bandwidth) {
+    os << "  Bandwidth: " << *entry.bandwidth << " Mbps\n";
+  }
+  if (entry.bandwidthUtil) {
+    os << "  BandwidthUtil: " << *entry.bandwidthUtil << "\n";
+  }
+  if (entry.packetLoss) {
+    os << "  PacketLoss: " << *entry.packetLoss << "\n";
+  }
+  if (entry.spectrumStrength) {
+    os << "  SpectrumStrength: " << *entry.spectrumStrength << " dBm\n";
+  }
+  if (entry.multiDimensionalCostPreview) {
+    os << "  MultiDimensionalCost: " << *entry.multiDimensionalCostPreview << "\n";
+  }
+  return os;
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+LinkCostStatistics::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  using ndn::encoding::prependNonNegativeIntegerBlock;
+  size_t totalLength = 0;
+
+  for (size_t i = ControlTraffic::N_MESSAGE_CLASSES; i-- > 0;) {
+    const auto& counters = controlTraffic.get(static_cast<ControlTraffic::MessageClass>(i));
+    if (counters.empty()) {
+      continue;
+    }
+    size_t length = 0;
+    length += prependNonNegativeIntegerBlock(block, nlsr::tlv::BytesReceived,
+                                             counters.nBytesReceived);
+    length += prependNonNegativeIntegerBlock(block, nlsr::tlv::BytesSent, counters.nBytesSent);
+    length += prependNonNegativeIntegerBlock(block, nlsr::tlv::DataReceived,
+                                             counters.nDataReceived);
+    length += prependNonNegativeIntegerBlock(block, nlsr::tlv::DataSent, counters.nDataSent);
+    length += prependNonNegativeIntegerBlock(block, nlsr::tlv::InterestsReceived,
+                                             counters.nInterestsReceived);
+    length += prependNonNegativeIntegerBlock(block, nlsr::tlv::InterestsSent,
+                                             counters.nInterestsSent);
+    length += prependNonNegativeIntegerBlock(block, nlsr::tlv::MessageClass, i);
+    length += block.prependVarNumber(length);
+    length += block.prependVarNumber(nlsr::tlv::ControlTraffic);
+    totalLength += length;
+  }
+
+  if (nSamples > 0) {
+    totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::MaxDuration, rttMax.count());
+    totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::P99Duration, rttP99.count());
+    totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::P90Duration, rttP90.count());
+    totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::MedianDuration, rttP50.count());
+  }
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::SampleCount, nSamples);
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::CostChangeCount, nCostChanges);
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::ProbeTimeoutCount, nProbeTimeouts);
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::ProbeCount, nProbes);
+  totalLength += neighbor.wireEncode(block);
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::LinkCostStatistics);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(LinkCostStatistics);
+
+ndn::Block
+LinkCostStatistics::wireEncode() const
+{
+  return encodeToBlock(*this);
+}
+
+void
+LinkCostStatistics::wireDecode(const ndn::Block& wire)
+{
+  *this = {};
+
+  if (wire.type() != nlsr::tlv::LinkCostStatistics) {
+    NDN_THROW(Error("LinkCostStatistics", wire.type()));
+  }
+
+  wire.parse();
+  auto val = wire.elements_begin();
+  auto end = wire.elements_end();
+
+  if (val != end && val->type() == ndn::tlv::Name) {
+    neighbor.wireDecode(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required Name field"));
+  }
+
+  auto readCount = [&] (uint32_t type, const char* field) {
+    if (val == end || val->type() != type) {
+      NDN_THROW(Error(std::string("Missing required ") + field + " field"));
+    }
+    return ndn::encoding::readNonNegativeInteger(*val++);
+  };
+  nProbes = readCount(nlsr::tlv::ProbeCount, "ProbeCount");
+  nProbeTimeouts = readCount(nlsr::tlv::ProbeTimeoutCount, "ProbeTimeoutCount");
+  nCostChanges = readCount(nlsr::tlv::CostChangeCount, "CostChangeCount");
+  nSamples = readCount(nlsr::tlv::SampleCount, "SampleCount");
+
+  if (val != end && val->type() == nlsr::tlv::MedianDuration) {
+    rttP50 = ndn::time::microseconds(readCount(nlsr::tlv::MedianDuration, "MedianDuration"));
+    rttP90 = ndn::time::microseconds(readCount(nlsr::tlv::P90Duration, "P90Duration"));
+    rttP99 = ndn::time::microseconds(readCount(nlsr::tlv::P99Duration, "P99Duration"));
+    rttMax = ndn::time::microseconds(readCount(nlsr::tlv::MaxDuration, "MaxDuration"));
+  }
+
+  for (; val != end && val->type() == nlsr::tlv::ControlTraffic; ++val) {
+    val->parse();
+    auto field = val->elements_begin();
+    auto readField = [&] (uint32_t type, const char* name) {
+      if (field == val->elements_end() || field->type() != type) {
+        NDN_THROW(Error(std::string("Missing required ") + name + " field in ControlTraffic"));
+      }
+      return ndn::encoding::readNonNegativeInteger(*field++);
+    };
+    auto messageClass = readField(nlsr::tlv::MessageClass, "MessageClass");
+    if (messageClass >= ControlTraffic::N_MESSAGE_CLASSES) {
+      NDN_THROW(Error("Unknown MessageClass " + ndn::to_string(messageClass)));
+    }
+    ControlTraffic::Counters counters;
+    counters.nInterestsSent = readField(nlsr::tlv::InterestsSent, "InterestsSent");
+    counters.nInterestsReceived = readField(nlsr::tlv::InterestsReceived, "InterestsReceived");
+    counters.nDataSent = readField(nlsr::tlv::DataSent, "DataSent");
+    counters.nDataReceived = readField(nlsr::tlv::DataReceived, "DataReceived");
+    counters.nBytesSent = readField(nlsr::tlv::BytesSent, "BytesSent");
+    counters.nBytesReceived = readField(nlsr::tlv::BytesReceived, "BytesReceived");
+    controlTraffic.set(static_cast<ControlTraffic::MessageClass>(messageClass), counters);
+  }
+
+  if (val != end) {
+    NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(val->type()) +
+                    " in LinkCostStatistics"));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LinkCostStatistics& stats)
+{
+  os << "Neighbor: " << stats.neighbor << "\n"
+     << "  Probes: " << stats.nProbes << ", timeouts: " << stats.nProbeTimeouts
+     << " (loss " << stats.getProbeLossRate() * 100 << "%)\n"
+     << "  CostChanges: " << stats.nCostChanges << "\n"
+     << "  RttSamples: " << stats.nSamples << "\n";
+  if (stats.nSamples > 0) {
+    os << "  Rtt: p50=" << stats.rttP50.count() / 1000.0 << " ms"
+       << ", p90=" << stats.rttP90.count() / 1000.0 << " ms"
+       << ", p99=" << stats.rttP99.count() / 1000.0 << " ms"
+       << ", max=" << stats.rttMax.count() / 1000.0 << " ms\n";
+  }
+  for (size_t i = 0; i < ControlTraffic::N_MESSAGE_CLASSES; ++i) {
+    auto messageClass = static_cast<ControlTraffic::MessageClass>(i);
+    const auto& counters = stats.controlTraffic.get(messageClass);
+    if (!counters.empty()) {
+      os << "  " << messageClass << ": sent " << counters.nInterestsSent << " Interests, "
+         << counters.nDataSent << " Data, " << counters.nBytesSent << " bytes; received "
+         << counters.nInterestsReceived << " Interests, " << counters.nDataReceived << " Data, "
+         << counters.nBytesReceived << " bytes\n";
+    }
+  }
+  return os;
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+LinkMetricsCommand::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto it = m_entries.rbegin(); it != m_entries.rend(); ++it) {
+    totalLength += it->wireEncode(block);
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::LinkMetricsCommand);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(LinkMetricsCommand);
+
+ndn::Block
+LinkMetricsCommand::wireEncode() const
+{
+  return encodeToBlock(*this);
+}
+
+void
+LinkMetricsCommand::wireDecode(const ndn::Block& wire)
+{
+  m_entries.clear();
+
+  if (wire.type() != nlsr::tlv::LinkMetricsCommand) {
+    NDN_THROW(Error("LinkMetricsCommand", wire.type()));
+  }
+
+  wire.parse();
+  for (const auto& element : wire.elements()) {
+    m_entries.emplace_back(element);
+  }
+}
+
+} // namespace nlsr
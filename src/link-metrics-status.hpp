@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LINK_METRICS_STATUS_HPP
+#define NLSR_LINK_METRICS_STATUS_HPP
+
+#include "common.hpp"
+#include "control-traffic.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace nlsr {
+
+/**
+ * @brief Metrics of the link to one neighbor.
+ *
+ *     ExternalMetrics = EXTERNAL-METRICS-TYPE TLV-LENGTH
+ *                         Name                   ; neighbor
+ *                         [Bandwidth]            ; double, Mbps
+ *                         [BandwidthUtilization] ; double, 0-1
+ *                         [PacketLoss]           ; double, 0-1
+ *                         [SpectrumStrength]     ; double, dBm
+ *                         [OriginalCost]         ; double
+ *                         [Cost]                 ; double, current link cost
+ *                         [SmoothedRtt]          ; NonNegativeInteger, microseconds
+ *                         [MultiDimensionalCost] ; double, preview cost
+ *
+ * The set-metrics command carries only the neighbor and the external metrics; the costs and the
+ * RTT are filled in by the link-metrics dataset.
+ */
+class LinkMetricsEntry
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  LinkMetricsEntry() = default;
+
+  explicit
+  LinkMetricsEntry(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+public:
+  ndn::Name neighbor;
+  std::optional<double> bandwidth;
+  std::optional<double> bandwidthUtil;
+  std::optional<double> packetLoss;
+  std::optional<double> spectrumStrength;
+  std::optional<double> originalCost;
+  std::optional<double> currentCost;
+  std::optional<ndn::time::microseconds> smoothedRtt;
+  std::optional<double> multiDimensionalCostPreview;
+};
+
+NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(LinkMetricsEntry);
+
+std::ostream&
+operator<<(std::ostream& os, const LinkMetricsEntry& entry);
+
+/**
+ * @brief Measurement statistics of the link to one neighbor, as served by the link-cost dataset.
+ *
+ *     LinkCostStatistics = LINK-COST-STATISTICS-TYPE TLV-LENGTH
+ *                            Name                ; neighbor
+ *                            ProbeCount          ; RTT probes sent, NonNegativeInteger
+ *                            ProbeTimeoutCount   ; RTT probes without reply
+ *                            CostChangeCount     ; changes of the advertised cost
+ *                            SampleCount         ; RTT samples, from probes or Hellos
+ *                            [MedianDuration     ; microseconds, RTT percentiles since start
+ *                             P90Duration
+ *                             P99Duration
+ *                             MaxDuration]
+ *                            *ControlTraffic
+ *
+ *     ControlTraffic = CONTROL-TRAFFIC-TYPE TLV-LENGTH
+ *                        MessageClass        ; NonNegativeInteger, ControlTraffic::MessageClass
+ *                        InterestsSent       ; NonNegativeInteger
+ *                        InterestsReceived
+ *                        DataSent
+ *                        DataReceived
+ *                        BytesSent
+ *                        BytesReceived
+ *
+ * The RTT percentiles are present when there is at least one sample, and the control traffic
+ * of the message classes of which a packet was exchanged with the neighbor.
+ */
+class LinkCostStatistics
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  LinkCostStatistics() = default;
+
+  explicit
+  LinkCostStatistics(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+  /*! \brief Return the fraction of the probes that timed out.
+   */
+  double
+  getProbeLossRate() const
+  {
+    return nProbes == 0 ? 0.0 : static_cast<double>(nProbeTimeouts) / nProbes;
+  }
+
+public:
+  ndn::Name neighbor;
+  uint64_t nProbes = 0;
+  uint64_t nProbeTimeouts = 0;
+  uint64_t nCostChanges = 0;
+  uint64_t nSamples = 0;
+  ndn::time::microseconds rttP50{0};
+  ndn::time::microseconds rttP90{0};
+  ndn::time::microseconds rttP99{0};
+  ndn::time::microseconds rttMax{0};
+  ControlTraffic controlTraffic;
+};
+
+NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(LinkCostStatistics);
+
+std::ostream&
+operator<<(std::ostream& os, const LinkCostStatistics& stats);
+
+/**
+ * @brief External metrics of many neighbors, set in one set-metrics command.
+ *
+ *     LinkMetricsCommand = LINK-METRICS-COMMAND-TYPE TLV-LENGTH
+ *                            *ExternalMetrics
+ *
+ * The command is carried in the ApplicationParameters of the set-metrics Interest.
+ */
+class LinkMetricsCommand
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  LinkMetricsCommand() = default;
+
+  explicit
+  LinkMetricsCommand(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  const std::vector<LinkMetricsEntry>&
+  getEntries() const
+  {
+    return m_entries;
+  }
+
+  void
+  addEntry(LinkMetricsEntry entry)
+  {
+    m_entries.push_back(std::move(entry));
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+private:
+  std::vector<LinkMetricsEntry> m_entries;
+};
+
+NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(LinkMetricsCommand);
+
+} // namespace nlsr
+
+#endif // NLSR_LINK_METRICS_STATUS_HPP
@@ -0,0 +1,66 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "link-rtt-estimator.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+
+void
+LinkRttEstimator::addSample(Duration rtt, TimePoint now)
+{
+  m_history[m_next] = {rtt, now};
+  m_next = (m_next + 1) % HISTORY_SIZE;
+  m_nHistory = std::min(m_nHistory + 1, HISTORY_SIZE);
+
+  if (m_nSamples == 0) {
+    m_srtt = rtt;
+    m_rttVar = rtt / 2;
+  }
+  else {
+    // RFC 6298: alpha = 1/8, beta = 1/4
+    Duration delta = m_srtt > rtt ? m_srtt - rtt : rtt - m_srtt;
+    m_rttVar = (m_rttVar * 3 + delta) / 4;
+    m_srtt = (m_srtt * 7 + rtt) / 8;
+  }
+  ++m_nSamples;
+  m_lastSampleTime = now;
+
+  if (m_nSamples == 1 || rtt <= m_minRtt) {
+    m_minRtt = rtt;
+    m_minRttTime = now;
+  }
+  else if (now - m_minRttTime > MIN_RTT_WINDOW) {
+    // The minimum expired; fall back to the best recent sample still inside the window.
+    m_minRtt = rtt;
+    m_minRttTime = now;
+    for (size_t i = 0; i < m_nHistory; ++i) {
+      const auto& sample = m_history[(m_next + HISTORY_SIZE - m_nHistory + i) % HISTORY_SIZE];
+      if (now - sample.time <= MIN_RTT_WINDOW && sample.rtt < m_minRtt) {
+        m_minRtt = sample.rtt;
+        m_minRttTime = sample.time;
+      }
+    }
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,167 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LINK_RTT_ESTIMATOR_HPP
+#define NLSR_LINK_RTT_ESTIMATOR_HPP
+
+#include <ndn-cxx/util/time.hpp>
+
+#include <array>
+
+namespace nlsr {
+
+/*! \brief Constant-memory RTT statistics of a link.
+ *
+ * Maintains the smoothed RTT and RTT variation of RFC 6298 (Jacobson/Karels), the minimum
+ * RTT over a sliding time window, and the most recent samples in a fixed ring buffer.
+ * Each sample is processed in constant time and no memory is allocated.
+ */
+class LinkRttEstimator
+{
+public:
+  using Duration = ndn::time::steady_clock::duration;
+  using TimePoint = ndn::time::steady_clock::time_point;
+
+  static constexpr size_t HISTORY_SIZE = 8;
+  static constexpr ndn::time::seconds MIN_RTT_WINDOW{60};
+
+  /*! \brief Read-only view of the recent samples, from oldest to newest.
+   */
+  class History
+  {
+  public:
+    size_t
+    size() const
+    {
+      return m_estimator->m_nHistory;
+    }
+
+    bool
+    empty() const
+    {
+      return size() == 0;
+    }
+
+    Duration
+    operator[](size_t i) const
+    {
+      return m_estimator->m_history[(m_estimator->m_next + HISTORY_SIZE - size() + i) %
+                                    HISTORY_SIZE].rtt;
+    }
+
+    Duration
+    back() const
+    {
+      return (*this)[size() - 1];
+    }
+
+  private:
+    explicit
+    History(const LinkRttEstimator& estimator)
+      : m_estimator(&estimator)
+    {
+    }
+
+  private:
+    const LinkRttEstimator* m_estimator;
+
+    friend LinkRttEstimator;
+  };
+
+  void
+  addSample(Duration rtt, TimePoint now);
+
+  /*! \brief Forget all samples, e.g. when the neighbor becomes inactive.
+   */
+  void
+  reset()
+  {
+    *this = LinkRttEstimator();
+  }
+
+  /*! \brief Return number of samples taken since the last reset.
+   */
+  uint64_t
+  getSampleCount() const
+  {
+    return m_nSamples;
+  }
+
+  bool
+  hasSamples() const
+  {
+    return m_nSamples > 0;
+  }
+
+  Duration
+  getSrtt() const
+  {
+    return m_srtt;
+  }
+
+  Duration
+  getRttVar() const
+  {
+    return m_rttVar;
+  }
+
+  /*! \brief Return minimum RTT of the samples taken during the last MIN_RTT_WINDOW.
+   */
+  Duration
+  getMinRtt() const
+  {
+    return m_minRtt;
+  }
+
+  TimePoint
+  getLastSampleTime() const
+  {
+    return m_lastSampleTime;
+  }
+
+  History
+  getHistory() const
+  {
+    return History(*this);
+  }
+
+private:
+  struct Sample
+  {
+    Duration rtt;
+    TimePoint time;
+  };
+
+  std::array<Sample, HISTORY_SIZE> m_history{};
+  size_t m_next = 0;
+  size_t m_nHistory = 0;
+  uint64_t m_nSamples = 0;
+
+  Duration m_srtt = Duration::zero();
+  Duration m_rttVar = Duration::zero();
+  Duration m_minRtt = Duration::zero();
+  TimePoint m_minRttTime;
+  TimePoint m_lastSampleTime;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LINK_RTT_ESTIMATOR_HPP
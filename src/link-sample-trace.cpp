@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "link-sample-trace.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+
+#include <algorithm>
+
+namespace nlsr {
+
+namespace {
+
+constexpr uint32_t TRACE_MAGIC = 0x4e4c5452; // "NLTR"
+constexpr uint32_t TRACE_VERSION = 1;
+
+enum : uint8_t {
+  HAS_BANDWIDTH = 1 << 0,
+  HAS_BANDWIDTH_UTIL = 1 << 1,
+  HAS_PACKET_LOSS = 1 << 2,
+  HAS_SPECTRUM_STRENGTH = 1 << 3,
+};
+
+void
+writeVarint(std::ostream& os, uint64_t value)
+{
+  // LEB128: 7 bits per byte, least significant first
+  while (value >= 0x80) {
+    os.put(static_cast<char>((value & 0x7f) | 0x80));
+    value >>= 7;
+  }
+  os.put(static_cast<char>(value));
+}
+
+uint64_t
+readVarint(std::istream& is)
+{
+  uint64_t value = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    int byte = is.get();
+    if (byte == std::char_traits<char>::eof()) {
+      throw LinkSampleReader::Error("Truncated link sample trace");
+    }
+    value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0) {
+      return value;
+    }
+  }
+  throw LinkSampleReader::Error("Malformed varint in link sample trace");
+}
+
+template<typename T>
+void
+writeValue(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+T
+readValue(std::istream& is)
+{
+  T value{};
+  if (!is.read(reinterpret_cast<char*>(&value), sizeof(value))) {
+    throw LinkSampleReader::Error("Truncated link sample trace");
+  }
+  return value;
+}
+
+void
+writeOptional(std::ostream& os, const std::optional<double>& value)
+{
+  if (value) {
+    writeValue(os, *value);
+  }
+}
+
+void
+readOptional(std::istream& is, uint8_t mask, uint8_t bit, std::optional<double>& value)
+{
+  if (mask & bit) {
+    value = readValue<double>(is);
+  }
+}
+
+} // namespace
+
+LinkSampleRecorder::LinkSampleRecorder(const std::string& path)
+  : m_os(path, std::ios::binary | std::ios::trunc)
+  , m_start(ndn::time::steady_clock::now())
+{
+  if (!m_os) {
+    throw std::runtime_error("Cannot create link sample trace " + path);
+  }
+  writeValue(m_os, TRACE_MAGIC);
+  writeValue(m_os, TRACE_VERSION);
+}
+
+void
+LinkSampleRecorder::record(LinkSample sample)
+{
+  auto time = ndn::time::duration_cast<ndn::time::microseconds>(ndn::time::steady_clock::now() -
+                                                                m_start);
+  m_os.put(static_cast<char>(sample.type));
+  writeVarint(m_os, static_cast<uint64_t>(std::max(time - m_lastTime,
+                                                   ndn::time::microseconds::zero()).count()));
+  m_lastTime = std::max(time, m_lastTime);
+
+  auto [it, isNew] = m_neighbors.try_emplace(sample.neighbor, m_neighbors.size());
+  writeVarint(m_os, it->second);
+  if (isNew) {
+    const auto& wire = sample.neighbor.wireEncode();
+    writeVarint(m_os, wire.size());
+    m_os.write(reinterpret_cast<const char*>(wire.data()), wire.size());
+  }
+
+  switch (sample.type) {
+    case LinkSample::Type::RTT:
+      writeVarint(m_os, static_cast<uint64_t>(std::max<int64_t>(sample.rtt.count(), 0)));
+      break;
+    case LinkSample::Type::HELLO_TIMEOUT:
+    case LinkSample::Type::STATUS:
+    case LinkSample::Type::CONGESTION:
+      writeVarint(m_os, sample.value);
+      break;
+    case LinkSample::Type::EXTERNAL_METRICS: {
+      uint8_t mask = (sample.bandwidth ? HAS_BANDWIDTH : 0) |
+                     (sample.bandwidthUtil ? HAS_BANDWIDTH_UTIL : 0) |
+                     (sample.packetLoss ? HAS_PACKET_LOSS : 0) |
+                     (sample.spectrumStrength ? HAS_SPECTRUM_STRENGTH : 0);
+      m_os.put(static_cast<char>(mask));
+      writeOptional(m_os, sample.bandwidth);
+      writeOptional(m_os, sample.bandwidthUtil);
+      writeOptional(m_os, sample.packetLoss);
+      writeOptional(m_os, sample.spectrumStrength);
+      break;
+    }
+  }
+  ++m_nRecords;
+}
+
+LinkSampleReader::LinkSampleReader(std::istream& is)
+  : m_is(is)
+{
+  uint32_t magic = 0, version = 0;
+  try {
+    magic = readValue<uint32_t>(m_is);
+    version = readValue<uint32_t>(m_is);
+  }
+  catch (const Error&) {
+    throw Error("Not a link sample trace");
+  }
+  if (magic != TRACE_MAGIC) {
+    throw Error("Not a link sample trace");
+  }
+  if (version != TRACE_VERSION) {
+    throw Error("Unsupported link sample trace version " + std::to_string(version));
+  }
+}
+
+std::optional<LinkSample>
+LinkSampleReader::next()
+{
+  int type = m_is.get();
+  if (type == std::char_traits<char>::eof()) {
+    return std::nullopt;
+  }
+
+  LinkSample sample;
+  sample.type = static_cast<LinkSample::Type>(type);
+  m_lastTime += ndn::time::microseconds(readVarint(m_is));
+  sample.time = m_lastTime;
+
+  uint64_t index = readVarint(m_is);
+  if (index == m_neighbors.size()) {
+    uint64_t wireSize = readVarint(m_is);
+    if (wireSize > ndn::MAX_NDN_PACKET_SIZE) {
+      throw Error("Oversized neighbor name in link sample trace");
+    }
+    std::vector<uint8_t> wire(wireSize);
+    if (!m_is.read(reinterpret_cast<char*>(wire.data()), wire.size())) {
+      throw Error("Truncated link sample trace");
+    }
+    try {
+      m_neighbors.emplace_back(ndn::Block(ndn::make_span(wire)));
+    }
+    catch (const std::exception& e) {
+      throw Error(std::string("Malformed neighbor name in link sample trace: ") + e.what());
+    }
+  }
+  else if (index > m_neighbors.size()) {
+    throw Error("Unknown neighbor index in link sample trace");
+  }
+  sample.neighbor = m_neighbors[index];
+
+  switch (sample.type) {
+    case LinkSample::Type::RTT:
+      sample.rtt = ndn::time::microseconds(readVarint(m_is));
+      break;
+    case LinkSample::Type::HELLO_TIMEOUT:
+    case LinkSample::Type::STATUS:
+    case LinkSample::Type::CONGESTION:
+      sample.value = static_cast<uint32_t>(readVarint(m_is));
+      break;
+    case LinkSample::Type::EXTERNAL_METRICS: {
+      auto mask = readValue<uint8_t>(m_is);
+      readOptional(m_is, mask, HAS_BANDWIDTH, sample.bandwidth);
+      readOptional(m_is, mask, HAS_BANDWIDTH_UTIL, sample.bandwidthUtil);
+      readOptional(m_is, mask, HAS_PACKET_LOSS, sample.packetLoss);
+      readOptional(m_is, mask, HAS_SPECTRUM_STRENGTH, sample.spectrumStrength);
+      break;
+    }
+    default:
+      throw Error("Unknown record type " + std::to_string(type) + " in link sample trace");
+  }
+  return sample;
+}
+
+} // namespace nlsr
@@ -0,0 +1,132 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LINK_SAMPLE_TRACE_HPP
+#define NLSR_LINK_SAMPLE_TRACE_HPP
+
+#include <ndn-cxx/name.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief One input of LinkCostManager, as recorded in a link sample trace.
+ */
+struct LinkSample
+{
+  enum class Type : uint8_t {
+    RTT = 1,
+    HELLO_TIMEOUT = 2,
+    STATUS = 3,
+    EXTERNAL_METRICS = 4,
+    CONGESTION = 5,
+  };
+
+  /// Time since the beginning of the trace
+  ndn::time::microseconds time{0};
+  Type type = Type::RTT;
+  ndn::Name neighbor;
+  /// RTT sample
+  ndn::time::microseconds rtt{0};
+  /// Number of Hello timeouts, Adjacent::Status, or whether the Data was congestion-marked
+  uint32_t value = 0;
+  /// External metrics, as in LinkCostManager::ExternalMetrics
+  std::optional<double> bandwidth;
+  std::optional<double> bandwidthUtil;
+  std::optional<double> packetLoss;
+  std::optional<double> spectrumStrength;
+};
+
+/*! \brief Appends link samples to a trace file.
+ *
+ * The trace begins with a magic number and a version. Each record is a type byte followed by
+ * varints: the time since the previous record in microseconds, and the index of the neighbor
+ * in the trace. The name of a neighbor follows the first record that uses its index. Then
+ * come the RTT in microseconds, a varint value, or for external metrics a presence bitmask
+ * and the doubles present, in host byte order.
+ */
+class LinkSampleRecorder : boost::noncopyable
+{
+public:
+  /*! \brief Create the trace file at \p path , replacing an existing one.
+   *  \throw std::runtime_error the file cannot be created
+   */
+  explicit
+  LinkSampleRecorder(const std::string& path);
+
+  void
+  record(LinkSample sample);
+
+  size_t
+  getRecordCount() const
+  {
+    return m_nRecords;
+  }
+
+private:
+  std::ofstream m_os;
+  ndn::time::steady_clock::time_point m_start;
+  ndn::time::microseconds m_lastTime{0};
+  std::unordered_map<ndn::Name, uint64_t> m_neighbors;
+  size_t m_nRecords = 0;
+};
+
+/*! \brief Reads back the samples of a trace written by LinkSampleRecorder.
+ */
+class LinkSampleReader
+{
+public:
+  class Error : public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  /*! \throw Error \p is does not begin with a trace header
+   */
+  explicit
+  LinkSampleReader(std::istream& is);
+
+  /*! \brief Return the next sample, or std::nullopt at the end of the trace.
+   *  \throw Error the trace is malformed or truncated
+   */
+  std::optional<LinkSample>
+  next();
+
+private:
+  std::istream& m_is;
+  ndn::time::microseconds m_lastTime{0};
+  std::vector<ndn::Name> m_neighbors;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LINK_SAMPLE_TRACE_HPP
@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "liveness-detector.hpp"
+#include "logger.hpp"
+
+#include <ndn-cxx/encoding/nfd-constants.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+
+namespace nlsr {
+
+INIT_LOGGER(LivenessDetector);
+
+LivenessDetector::LivenessDetector(ndn::Face& face, ndn::KeyChain& keyChain,
+                                   ConfParameter& confParam)
+  : m_face(face)
+  , m_keyChain(keyChain)
+  , m_confParam(confParam)
+  , m_adjacencyList(confParam.getAdjacencyList())
+  , m_scheduler(face.getIoContext())
+{
+  if (m_confParam.getLivenessInterval() <= 0_ms) {
+    return;
+  }
+
+  ndn::Name name(m_confParam.getRouterPrefix());
+  name.append("nlsr").append(LIVENESS_COMPONENT);
+
+  NLSR_LOG_DEBUG("Setting interest filter for liveness probes: " << name);
+
+  m_face.setInterestFilter(ndn::InterestFilter(name).allowLoopback(false),
+    [this] (const auto&, const auto& interest) {
+      processProbe(interest);
+    },
+    [] (const auto& name) {
+      NLSR_LOG_DEBUG("Successfully registered prefix: " << name);
+    },
+    [] (const auto& name, const auto& reason) {
+      NLSR_LOG_ERROR("Failed to register liveness probe prefix " << name << ": " << reason);
+    },
+    m_confParam.getSigningInfo(), ndn::nfd::ROUTE_FLAG_CAPTURE);
+
+  m_tickEvent = m_scheduler.schedule(m_confParam.getLivenessInterval(), [this] { onTick(); });
+}
+
+void
+LivenessDetector::onTick()
+{
+  auto now = ndn::time::steady_clock::now();
+  auto interval = m_confParam.getLivenessInterval();
+  auto detectTime = interval * m_confParam.getLivenessMultiplier();
+
+  for (const auto& adjacent : m_adjacencyList.getAdjList()) {
+    auto id = m_adjacencyList.getNeighborId(adjacent.getName());
+    if (!id) {
+      continue;
+    }
+    if (*id >= m_neighbors.size()) {
+      m_neighbors.resize(*id + 1);
+    }
+    auto& state = m_neighbors[*id];
+
+    if (adjacent.getStatus() != Adjacent::STATUS_ACTIVE || adjacent.getFaceId() == 0) {
+      // re-armed by the first reply after the neighbor is back
+      state.lastHeard.reset();
+      continue;
+    }
+
+    if (state.lastHeard && now - *state.lastHeard > detectTime) {
+      NLSR_LOG_INFO("No liveness reply from " << adjacent.getName() << " for "
+                    << ndn::time::duration_cast<ndn::time::milliseconds>(now - *state.lastHeard));
+      state.lastHeard.reset();
+      onNeighborDown(adjacent.getName());
+      continue;
+    }
+
+    // probe name: /<neighbor>/nlsr/LIVE/<router>/<seq>
+    ndn::Name probeName(adjacent.getName());
+    probeName.append("nlsr").append(LIVENESS_COMPONENT)
+             .append(ndn::tlv::GenericNameComponent, m_confParam.getRouterPrefix().wireEncode())
+             .appendNumber(m_nextSeq++);
+
+    ndn::Interest probe(probeName);
+    probe.setInterestLifetime(detectTime);
+    probe.setMustBeFresh(true);
+
+    const auto& neighbor = adjacent.getName();
+    if (auto* traffic = m_adjacencyList.findControlTraffic(neighbor); traffic != nullptr) {
+      traffic->countInterestSent(ControlTraffic::MessageClass::PROBE, probe);
+    }
+    m_face.expressInterest(probe,
+      [this, neighbor] (const auto&, const auto& data) {
+        if (auto* traffic = m_adjacencyList.findControlTraffic(neighbor); traffic != nullptr) {
+          traffic->countDataReceived(ControlTraffic::MessageClass::PROBE, data);
+        }
+        onProbeReply(neighbor);
+      },
+      [] (const auto&, const auto&) {},
+      [] (const auto&) {});
+    NLSR_LOG_TRACE("Liveness probe sent: " << probeName);
+  }
+
+  m_tickEvent = m_scheduler.schedule(interval, [this] { onTick(); });
+}
+
+void
+LivenessDetector::processProbe(const ndn::Interest& interest)
+{
+  // probe name: /<router>/nlsr/LIVE/<neighbor>/<seq>
+  const auto& probeName = interest.getName();
+  if (probeName.size() < 2) {
+    return;
+  }
+
+  ndn::Name neighbor;
+  try {
+    neighbor.wireDecode(probeName.get(-2).blockFromValue());
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_DEBUG("Malformed liveness probe " << probeName << ": " << e.what());
+    return;
+  }
+  auto* traffic = m_adjacencyList.findControlTraffic(neighbor);
+  if (traffic == nullptr) {
+    NLSR_LOG_DEBUG("Liveness probe from unknown router " << neighbor);
+    return;
+  }
+
+  ndn::Data data(probeName);
+  data.setFreshnessPeriod(0_ms);
+  m_keyChain.sign(data, ndn::security::signingWithSha256());
+  m_face.put(data);
+  traffic->countInterestReceived(ControlTraffic::MessageClass::PROBE, interest);
+  traffic->countDataSent(ControlTraffic::MessageClass::PROBE, data);
+}
+
+void
+LivenessDetector::onProbeReply(const ndn::Name& neighbor)
+{
+  auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+  auto id = m_adjacencyList.getNeighborId(neighbor);
+  if (adjacent == m_adjacencyList.end() || !id ||
+      adjacent->getStatus() != Adjacent::STATUS_ACTIVE) {
+    return;
+  }
+  if (*id >= m_neighbors.size()) {
+    m_neighbors.resize(*id + 1);
+  }
+  m_neighbors[*id].lastHeard = ndn::time::steady_clock::now();
+}
+
+} // namespace nlsr
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LIVENESS_DETECTOR_HPP
+#define NLSR_LIVENESS_DETECTOR_HPP
+
+#include "conf-parameter.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/face.hpp>
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
+#include <ndn-cxx/util/signal.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <optional>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Detects the loss of active neighbors faster than Hellos do.
+ *
+ * Every liveness-interval, each ACTIVE neighbor with a Face is sent a small probe Interest,
+ * which it answers with Data protected by a DigestSha256 rather than a signature. Once a
+ * neighbor has answered, it is declared down when it then stays silent for
+ * liveness-interval * liveness-multiplier. A neighbor that never answered is left to the
+ * Hello protocol, so that routers without liveness probes are not declared down.
+ *
+ * \sa nlsr::ConfParameter::getLivenessInterval
+ */
+class LivenessDetector : boost::noncopyable
+{
+public:
+  LivenessDetector(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam);
+
+  /*! \brief Emitted once when an armed neighbor misses its probes.
+   */
+  ndn::signal::Signal<LivenessDetector, const ndn::Name&> onNeighborDown;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Checks each active neighbor for silence, and probes those that are not down.
+   */
+  void
+  onTick();
+
+  void
+  processProbe(const ndn::Interest& interest);
+
+  void
+  onProbeReply(const ndn::Name& neighbor);
+
+public:
+  static inline const std::string LIVENESS_COMPONENT{"LIVE"};
+
+private:
+  struct NeighborLiveness
+  {
+    /// when the neighbor last answered a probe; unset while it is not armed
+    std::optional<ndn::time::steady_clock::time_point> lastHeard;
+  };
+
+  ndn::Face& m_face;
+  ndn::KeyChain& m_keyChain;
+  ConfParameter& m_confParam;
+  AdjacencyList& m_adjacencyList;
+  ndn::Scheduler m_scheduler;
+  ndn::scheduler::ScopedEventId m_tickEvent;
+  uint64_t m_nextSeq = 0;
+  // indexed by NeighborId
+  std::vector<NeighborLiveness> m_neighbors;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LIVENESS_DETECTOR_HPP
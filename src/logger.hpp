@@ -41,4 +41,12 @@
 #define NLSR_LOG_ERROR(x) NDN_LOG_ERROR(x)
 #define NLSR_LOG_FATAL(x) NDN_LOG_FATAL(x)
 
+/*! \brief Tell whether messages of a level are logged by the logger of this file.
+ *
+ * The NLSR_LOG_* macros only evaluate their argument when it is logged. This guards work
+ * done only for logging that does not fit in one message, such as a loop over a table.
+ */
+#define NLSR_LOG_TRACE_ENABLED() ndn_cxx_getLogger().isLevelEnabled(::ndn::util::LogLevel::TRACE)
+#define NLSR_LOG_DEBUG_ENABLED() ndn_cxx_getLogger().isLevelEnabled(::ndn::util::LogLevel::DEBUG)
+
 #endif // NLSR_LOGGER_HPP
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsa-segment-storage.hpp"
+#include "logger.hpp"
+
+namespace nlsr {
+
+INIT_LOGGER(LsaSegmentStorage);
+
+LsaSegmentStorage::LsaSegmentStorage(size_t capacity)
+  : m_capacity(capacity)
+{
+}
+
+void
+LsaSegmentStorage::insert(const ndn::Data& data)
+{
+  size_t nBytes = data.wireEncode().size();
+  if (m_capacity > 0 && nBytes > m_capacity) {
+    NLSR_LOG_DEBUG("Segment " << data.getName() << " is larger than the storage capacity");
+    return;
+  }
+
+  if (auto it = m_entries.find(data.getName()); it != m_entries.end()) {
+    eraseEntry(it);
+  }
+  evict(nBytes);
+
+  auto it = m_entries.try_emplace(data.getName()).first;
+  it->second.data = std::make_shared<const ndn::Data>(data);
+  it->second.staleTime = ndn::time::steady_clock::now() + data.getFreshnessPeriod();
+  m_lru.push_front(it);
+  it->second.lruPos = m_lru.begin();
+  m_nBytes += nBytes;
+}
+
+std::shared_ptr<const ndn::Data>
+LsaSegmentStorage::find(const ndn::Interest& interest)
+{
+  const auto& name = interest.getName();
+  auto now = ndn::time::steady_clock::now();
+
+  for (auto it = m_entries.lower_bound(name);
+       it != m_entries.end() && name.isPrefixOf(it->first); ++it) {
+    const auto& entry = it->second;
+    if (interest.getMustBeFresh() && entry.staleTime <= now) {
+      continue;
+    }
+    if (!interest.matchesData(*entry.data)) {
+      continue;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, entry.lruPos);
+    ++m_nHits;
+    return entry.data;
+  }
+
+  ++m_nMisses;
+  return nullptr;
+}
+
+void
+LsaSegmentStorage::erase(const ndn::Name& prefix)
+{
+  for (auto it = m_entries.lower_bound(prefix);
+       it != m_entries.end() && prefix.isPrefixOf(it->first); ) {
+    it = eraseEntry(it);
+  }
+}
+
+void
+LsaSegmentStorage::setCapacity(size_t capacity)
+{
+  m_capacity = capacity;
+  evict(0);
+}
+
+LsaSegmentStorage::EntryMap::iterator
+LsaSegmentStorage::eraseEntry(EntryMap::iterator it)
+{
+  m_nBytes -= it->second.data->wireEncode().size();
+  m_lru.erase(it->second.lruPos);
+  return m_entries.erase(it);
+}
+
+void
+LsaSegmentStorage::evict(size_t nBytesNeeded)
+{
+  if (m_capacity == 0) {
+    return;
+  }
+  while (!m_lru.empty() && m_nBytes + nBytesNeeded > m_capacity) {
+    NLSR_LOG_TRACE("Evicting segment " << m_lru.back()->first);
+    eraseEntry(m_lru.back());
+    ++m_nEvictions;
+  }
+}
+
+} // namespace nlsr
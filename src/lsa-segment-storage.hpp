@@ -0,0 +1,142 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LSA_SEGMENT_STORAGE_HPP
+#define NLSR_LSA_SEGMENT_STORAGE_HPP
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <list>
+#include <map>
+
+namespace nlsr {
+
+/*! \brief Byte-budgeted cache of the segments of other routers' LSAs.
+ *
+ * Segments fetched from other routers are kept so that Interests for the same LSA from further
+ * routers can be answered locally. The total wire size of the kept segments is bounded by the
+ * capacity; when an insertion exceeds it, the least recently used segments are evicted. A
+ * segment whose FreshnessPeriod has passed does not satisfy an Interest with MustBeFresh.
+ */
+class LsaSegmentStorage
+{
+public:
+  /*! \param capacity limit in bytes of the total wire size of the segments, 0 for no limit
+   */
+  explicit
+  LsaSegmentStorage(size_t capacity = 0);
+
+  /*! \brief Insert a segment, replacing the segment of the same name if any.
+   *
+   * A segment larger than the whole capacity is not kept.
+   */
+  void
+  insert(const ndn::Data& data);
+
+  /*! \brief Find a segment satisfying \p interest and mark it as recently used.
+   */
+  std::shared_ptr<const ndn::Data>
+  find(const ndn::Interest& interest);
+
+  /*! \brief Erase every segment whose name starts with \p prefix.
+   */
+  void
+  erase(const ndn::Name& prefix);
+
+  /*! \brief Change the capacity, evicting segments if the kept ones do not fit anymore.
+   */
+  void
+  setCapacity(size_t capacity);
+
+  size_t
+  getCapacity() const
+  {
+    return m_capacity;
+  }
+
+  /*! \brief Return number of kept segments.
+   */
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  /*! \brief Return total wire size of the kept segments.
+   */
+  size_t
+  getSizeInBytes() const
+  {
+    return m_nBytes;
+  }
+
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+  uint64_t
+  getNMisses() const
+  {
+    return m_nMisses;
+  }
+
+  uint64_t
+  getNEvictions() const
+  {
+    return m_nEvictions;
+  }
+
+private:
+  struct Entry;
+  using EntryMap = std::map<ndn::Name, Entry>;
+
+  struct Entry
+  {
+    std::shared_ptr<const ndn::Data> data;
+    ndn::time::steady_clock::time_point staleTime;
+    std::list<EntryMap::iterator>::iterator lruPos;
+  };
+
+  EntryMap::iterator
+  eraseEntry(EntryMap::iterator it);
+
+  void
+  evict(size_t nBytesNeeded);
+
+private:
+  size_t m_capacity;
+  size_t m_nBytes = 0;
+  EntryMap m_entries;
+  // Most recently used first
+  std::list<EntryMap::iterator> m_lru;
+
+  uint64_t m_nHits = 0;
+  uint64_t m_nMisses = 0;
+  uint64_t m_nEvictions = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSA_SEGMENT_STORAGE_HPP
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "adj-lsa-delta.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <algorithm>
+#include <map>
+#include <set>
+
+namespace nlsr {
+
+AdjLsaDelta::AdjLsaDelta(const AdjLsa* base, const AdjLsa& lsa)
+  : m_originRouter(lsa.getOriginRouter())
+  , m_seqNo(lsa.getSeqNo())
+  , m_baseSeqNo(base != nullptr ? base->getSeqNo() : 0)
+  , m_expirationTimePoint(lsa.getExpirationTimePoint())
+{
+  std::map<ndn::Name, const Adjacent*> baseAdjacencies;
+  if (base != nullptr) {
+    for (const auto& adjacent : *base) {
+      baseAdjacencies.emplace(adjacent.getName(), &adjacent);
+    }
+  }
+
+  for (const auto& adjacent : lsa) {
+    auto it = baseAdjacencies.find(adjacent.getName());
+    if (it == baseAdjacencies.end()) {
+      m_changed.push_back(adjacent);
+      continue;
+    }
+    if (!(*it->second == adjacent)) {
+      m_changed.push_back(adjacent);
+    }
+    baseAdjacencies.erase(it);
+  }
+
+  for (const auto& entry : baseAdjacencies) {
+    m_removed.push_back(entry.first);
+  }
+}
+
+AdjLsaDelta::AdjLsaDelta(const ndn::Block& wire)
+{
+  wireDecode(wire);
+}
+
+AdjLsa
+AdjLsaDelta::apply(const AdjLsa* base) const
+{
+  if ((base == nullptr) != (m_baseSeqNo == 0)) {
+    NDN_THROW(Error("Delta base mismatch"));
+  }
+  if (base != nullptr &&
+      (base->getSeqNo() != m_baseSeqNo || base->getOriginRouter() != m_originRouter)) {
+    NDN_THROW(Error("Delta base mismatch"));
+  }
+
+  AdjacencyList noAdjacencies;
+  AdjLsa lsa(m_originRouter, m_seqNo, m_expirationTimePoint, noAdjacencies);
+  std::set<ndn::Name> changedNeighbors;
+  for (const auto& adjacent : m_changed) {
+    changedNeighbors.insert(adjacent.getName());
+  }
+  if (base != nullptr) {
+    for (const auto& adjacent : *base) {
+      if (changedNeighbors.count(adjacent.getName()) == 0 &&
+          std::find(m_removed.begin(), m_removed.end(), adjacent.getName()) == m_removed.end()) {
+        lsa.addAdjacent(adjacent);
+      }
+    }
+  }
+  for (const auto& adjacent : m_changed) {
+    lsa.addAdjacent(adjacent);
+  }
+  return lsa;
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+AdjLsaDelta::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto it = m_removed.rbegin(); it != m_removed.rend(); ++it) {
+    totalLength += it->wireEncode(block);
+  }
+  for (auto it = m_changed.rbegin(); it != m_changed.rend(); ++it) {
+    totalLength += it->wireEncode(block);
+  }
+
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::BaseSequenceNumber, m_baseSeqNo);
+
+  size_t lsaLength = 0;
+  lsaLength += prependStringBlock(block, nlsr::tlv::ExpirationTime,
+                                  ndn::time::toString(m_expirationTimePoint));
+  lsaLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::SequenceNumber, m_seqNo);
+  lsaLength += m_originRouter.wireEncode(block);
+  lsaLength += block.prependVarNumber(lsaLength);
+  lsaLength += block.prependVarNumber(nlsr::tlv::Lsa);
+  totalLength += lsaLength;
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::AdjacencyLsaDelta);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(AdjLsaDelta);
+
+const ndn::Block&
+AdjLsaDelta::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  m_wire = buffer.block();
+
+  return m_wire;
+}
+
+void
+AdjLsaDelta::wireDecode(const ndn::Block& wire)
+{
+  LsaHeader header(wire);
+  if (wire.type() != nlsr::tlv::AdjacencyLsaDelta) {
+    NDN_THROW(Error("AdjacencyLsaDelta", wire.type()));
+  }
+  m_originRouter = header.getOriginRouter();
+  m_seqNo = header.getSeqNo();
+  m_expirationTimePoint = header.getExpirationTimePoint();
+
+  m_wire = wire;
+  m_wire.parse();
+
+  // LsaHeader checked the Lsa element
+  auto val = std::next(m_wire.elements_begin());
+
+  if (val != m_wire.elements_end() && val->type() == nlsr::tlv::BaseSequenceNumber) {
+    m_baseSeqNo = ndn::readNonNegativeInteger(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required BaseSequenceNumber field"));
+  }
+
+  m_changed.clear();
+  m_removed.clear();
+  for (; val != m_wire.elements_end() && val->type() == nlsr::tlv::Adjacency; ++val) {
+    m_changed.emplace_back(*val);
+  }
+  for (; val != m_wire.elements_end(); ++val) {
+    if (val->type() == ndn::tlv::Name) {
+      m_removed.emplace_back(*val);
+    }
+    else {
+      NDN_THROW(Error("Name", val->type()));
+    }
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LSA_ADJ_LSA_DELTA_HPP
+#define NLSR_LSA_ADJ_LSA_DELTA_HPP
+
+#include "adj-lsa.hpp"
+
+#include <vector>
+
+namespace nlsr {
+
+/**
+ * @brief Represents the changes from one version of an Adjacency LSA to a later one.
+ *
+ * A router that already has the base version rebuilds the new version from the delta, so
+ * that a change of one adjacency does not cost fetching and decoding all of them. A delta
+ * with base sequence number 0 has no base and carries all adjacencies of the new version.
+ *
+ * AdjLsaDelta is encoded as:
+ * @code{.abnf}
+ * AdjLsaDelta = ADJACENCY-LSA-DELTA-TYPE TLV-LENGTH
+ *                 Lsa                 ; of the new version
+ *                 BaseSequenceNumber
+ *                 *Adjacency          ; added or changed adjacencies
+ *                 *Name               ; neighbors that are no longer adjacent
+ * @endcode
+ */
+class AdjLsaDelta
+{
+public:
+  using Error = Lsa::Error;
+
+  /**
+   * @brief Computes the delta from @p base to @p lsa.
+   * @param base the base version, or nullptr for a delta without base
+   */
+  AdjLsaDelta(const AdjLsa* base, const AdjLsa& lsa);
+
+  explicit
+  AdjLsaDelta(const ndn::Block& wire);
+
+  const ndn::Name&
+  getOriginRouter() const
+  {
+    return m_originRouter;
+  }
+
+  uint64_t
+  getSeqNo() const
+  {
+    return m_seqNo;
+  }
+
+  uint64_t
+  getBaseSeqNo() const
+  {
+    return m_baseSeqNo;
+  }
+
+  const ndn::time::system_clock::time_point&
+  getExpirationTimePoint() const
+  {
+    return m_expirationTimePoint;
+  }
+
+  const std::vector<Adjacent>&
+  getChangedAdjacencies() const
+  {
+    return m_changed;
+  }
+
+  const std::vector<ndn::Name>&
+  getRemovedNeighbors() const
+  {
+    return m_removed;
+  }
+
+  /**
+   * @brief Builds the new version of the LSA.
+   * @param base the base version, or nullptr if the delta has no base
+   * @throw Error @p base is not the base version of this delta
+   */
+  AdjLsa
+  apply(const AdjLsa* base) const;
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  const ndn::Block&
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+private:
+  ndn::Name m_originRouter;
+  uint64_t m_seqNo = 0;
+  uint64_t m_baseSeqNo = 0;
+  ndn::time::system_clock::time_point m_expirationTimePoint;
+  std::vector<Adjacent> m_changed;
+  std::vector<ndn::Name> m_removed;
+
+  mutable ndn::Block m_wire;
+};
+
+NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(AdjLsaDelta);
+
+} // namespace nlsr
+
+#endif // NLSR_LSA_ADJ_LSA_DELTA_HPP
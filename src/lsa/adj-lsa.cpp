@@ -21,9 +21,30 @@
 
 #include "adj-lsa.hpp"
 #include "tlv-nlsr.hpp"
+#include "utility/numeric.hpp"
+
+#include <algorithm>
 
 namespace nlsr {
 
+namespace {
+
+std::vector<const Adjacent*>
+sortByName(const AdjacencyList& adl)
+{
+  std::vector<const Adjacent*> sorted;
+  sorted.reserve(adl.size());
+  for (const auto& adjacent : adl) {
+    sorted.push_back(&adjacent);
+  }
+  std::sort(sorted.begin(), sorted.end(), [] (const Adjacent* lhs, const Adjacent* rhs) {
+    return lhs->getName() < rhs->getName();
+  });
+  return sorted;
+}
+
+} // namespace
+
 AdjLsa::AdjLsa(const ndn::Name& originRouter, uint64_t seqNo,
                const ndn::time::system_clock::time_point& timepoint, AdjacencyList& adl)
   : Lsa(originRouter, seqNo, timepoint)
@@ -126,7 +147,7 @@ AdjLsa::print(std::ostream& os) const
   }
 }
 
-std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
 AdjLsa::update(const std::shared_ptr<Lsa>& lsa)
 {
   auto alsa = std::static_pointer_cast<AdjLsa>(lsa);
@@ -135,9 +156,42 @@ AdjLsa::update(const std::shared_ptr<Lsa>& lsa)
     for (const auto& adjacent : alsa->getAdl()) {
       addAdjacent(adjacent);
     }
-    return {true, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
+    return {true, std::vector<PrefixInfo>{}, std::vector<PrefixInfo>{}};
+  }
+  return {false, std::vector<PrefixInfo>{}, std::vector<PrefixInfo>{}};
+}
+
+AdjLsaDiff
+AdjLsa::diff(const AdjLsa& newer) const
+{
+  AdjLsaDiff diff;
+  auto oldLinks = sortByName(m_adl);
+  auto newLinks = sortByName(newer.m_adl);
+
+  auto oldIt = oldLinks.begin();
+  auto newIt = newLinks.begin();
+  while (oldIt != oldLinks.end() || newIt != newLinks.end()) {
+    if (newIt == newLinks.end() ||
+        (oldIt != oldLinks.end() && (*oldIt)->getName() < (*newIt)->getName())) {
+      diff.removed.push_back({(*oldIt)->getName(), (*oldIt)->getLinkCost(),
+                              Adjacent::NON_ADJACENT_COST});
+      ++oldIt;
+    }
+    else if (oldIt == oldLinks.end() || (*newIt)->getName() < (*oldIt)->getName()) {
+      diff.added.push_back({(*newIt)->getName(), Adjacent::NON_ADJACENT_COST,
+                            (*newIt)->getLinkCost()});
+      ++newIt;
+    }
+    else {
+      if (!util::diffInEpsilon((*oldIt)->getLinkCost(), (*newIt)->getLinkCost())) {
+        diff.costChanged.push_back({(*oldIt)->getName(), (*oldIt)->getLinkCost(),
+                                    (*newIt)->getLinkCost()});
+      }
+      ++oldIt;
+      ++newIt;
+    }
   }
-  return {false, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
+  return diff;
 }
 
 } // namespace nlsr
@@ -30,6 +30,31 @@
 
 namespace nlsr {
 
+/**
+ * @brief Changes of the links of a router between two versions of its Adjacency LSA.
+ */
+struct AdjLsaDiff
+{
+  struct Link
+  {
+    ndn::Name neighbor;
+    /// Adjacent::NON_ADJACENT_COST for an added link
+    double oldCost;
+    /// Adjacent::NON_ADJACENT_COST for a removed link
+    double newCost;
+  };
+
+  bool
+  empty() const
+  {
+    return added.empty() && removed.empty() && costChanged.empty();
+  }
+
+  std::vector<Link> added;
+  std::vector<Link> removed;
+  std::vector<Link> costChanged;
+};
+
 /**
  * @brief Represents an LSA of adjacencies of the origin router in link-state mode.
  *
@@ -107,9 +132,17 @@ public:
   void
   wireDecode(const ndn::Block& wire);
 
-  std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+  std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) override;
 
+  /**
+   * @brief Returns the links added, removed and changed in cost in @p newer .
+   *
+   * The links are reported in canonical order of the neighbor names.
+   */
+  AdjLsaDiff
+  diff(const AdjLsa& newer) const;
+
 private:
   void
   print(std::ostream& os) const override;
@@ -129,7 +129,7 @@ CoordinateLsa::print(std::ostream& os) const
   }
 }
 
-std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
 CoordinateLsa::update(const std::shared_ptr<Lsa>& lsa)
 {
   auto clsa = std::static_pointer_cast<CoordinateLsa>(lsa);
@@ -139,9 +139,9 @@ CoordinateLsa::update(const std::shared_ptr<Lsa>& lsa)
     for (const auto& angle : clsa->getTheta()) {
       m_hyperbolicAngles.push_back(angle);
     }
-    return {true, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
+    return {true, std::vector<PrefixInfo>{}, std::vector<PrefixInfo>{}};
   }
-  return {false, std::list<PrefixInfo>{}, std::list<PrefixInfo>{}};
+  return {false, std::vector<PrefixInfo>{}, std::vector<PrefixInfo>{}};
 }
 
 } // namespace nlsr
@@ -24,6 +24,46 @@
 
 namespace nlsr {
 
+namespace {
+
+void
+decodeLsaFields(const ndn::Block& wire, ndn::Name& originRouter, uint64_t& seqNo,
+                ndn::time::system_clock::time_point& expirationTimePoint)
+{
+  ndn::Block baseWire = wire;
+  baseWire.parse();
+
+  auto val = baseWire.elements_begin();
+
+  if (val != baseWire.elements_end() && val->type() == ndn::tlv::Name) {
+    originRouter.wireDecode(*val);
+  }
+  else {
+    NDN_THROW(Lsa::Error("OriginRouter: Missing required Name field"));
+  }
+
+  ++val;
+
+  if (val != baseWire.elements_end() && val->type() == nlsr::tlv::SequenceNumber) {
+    seqNo = ndn::readNonNegativeInteger(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Lsa::Error("Missing required SequenceNumber field"));
+  }
+
+  if (val != baseWire.elements_end() && val->type() == nlsr::tlv::ExpirationTime) {
+    expirationTimePoint = ndn::time::fromString(readString(*val));
+  }
+  else {
+    NDN_THROW(Lsa::Error("Missing required ExpirationTime field"));
+  }
+}
+
+} // namespace
+
+Lsa::Lsa() = default;
+
 Lsa::Lsa(const ndn::Name& originRouter, uint64_t seqNo,
          ndn::time::system_clock::time_point expirationTimePoint)
   : m_originRouter(originRouter)
@@ -33,9 +73,10 @@ Lsa::Lsa(const ndn::Name& originRouter, uint64_t seqNo,
 }
 
 Lsa::Lsa(const Lsa& lsa)
-  : m_originRouter(lsa.getOriginRouter())
+  : m_originRouter(lsa.m_originRouter)
   , m_seqNo(lsa.getSeqNo())
   , m_expirationTimePoint(lsa.getExpirationTimePoint())
+  , m_expirationDeadline(lsa.getExpirationDeadline())
 {
 }
 
@@ -51,7 +92,7 @@ Lsa::wireEncode(ndn::EncodingImpl<TAG>& encoder) const
 
   totalLength += prependNonNegativeIntegerBlock(encoder, nlsr::tlv::SequenceNumber, m_seqNo);
 
-  totalLength += m_originRouter.wireEncode(encoder);
+  totalLength += m_originRouter.getName().wireEncode(encoder);
 
   totalLength += encoder.prependVarNumber(totalLength);
   totalLength += encoder.prependVarNumber(nlsr::tlv::Lsa);
@@ -64,37 +105,60 @@ NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(Lsa);
 void
 Lsa::wireDecode(const ndn::Block& wire)
 {
-  m_originRouter.clear();
+  ndn::Name originRouter;
   m_seqNo = 0;
 
-  ndn::Block baseWire = wire;
-  baseWire.parse();
-
-  auto val = baseWire.elements_begin();
+  decodeLsaFields(wire, originRouter, m_seqNo, m_expirationTimePoint);
+  m_originRouter = originRouter;
+}
 
-  if (val != baseWire.elements_end() && val->type() == ndn::tlv::Name) {
-    m_originRouter.wireDecode(*val);
-  }
-  else {
-    NDN_THROW(Error("OriginRouter: Missing required Name field"));
+LsaHeader::LsaHeader(const ndn::Block& wire)
+{
+  switch (wire.type()) {
+    case nlsr::tlv::AdjacencyLsa:
+    case nlsr::tlv::AdjacencyLsaDelta:
+      m_type = Lsa::Type::ADJACENCY;
+      break;
+    case nlsr::tlv::CoordinateLsa:
+      m_type = Lsa::Type::COORDINATE;
+      break;
+    case nlsr::tlv::NameLsa:
+      m_type = Lsa::Type::NAME;
+      break;
+    default:
+      NDN_THROW(Lsa::Error("LSA", wire.type()));
   }
 
-  ++val;
-
-  if (val != baseWire.elements_end() && val->type() == nlsr::tlv::SequenceNumber) {
-    m_seqNo = ndn::readNonNegativeInteger(*val);
-    ++val;
-  }
-  else {
-    NDN_THROW(Error("Missing required SequenceNumber field"));
+  // Block::parse() only splits the top level into sub-blocks over the same buffer
+  ndn::Block lsaWire = wire;
+  lsaWire.parse();
+  auto val = lsaWire.elements_begin();
+  if (val == lsaWire.elements_end() || val->type() != nlsr::tlv::Lsa) {
+    NDN_THROW(Lsa::Error("Missing required Lsa field"));
   }
+  decodeLsaFields(*val, m_originRouter, m_seqNo, m_expirationTimePoint);
+}
 
-  if (val != baseWire.elements_end() && val->type() == nlsr::tlv::ExpirationTime) {
-    m_expirationTimePoint = ndn::time::fromString(readString(*val));
+Lsa::Type
+parseLsaType(std::string_view typeString)
+{
+  if (typeString == "ADJACENCY") {
+    return Lsa::Type::ADJACENCY;
   }
-  else {
-    NDN_THROW(Error("Missing required ExpirationTime field"));
+  else if (typeString == "COORDINATE") {
+    return Lsa::Type::COORDINATE;
+  }
+  else if (typeString == "NAME") {
+    return Lsa::Type::NAME;
   }
+  return Lsa::Type::BASE;
+}
+
+Lsa::Type
+parseLsaType(const ndn::name::Component& component)
+{
+  return parseLsaType(std::string_view(reinterpret_cast<const char*>(component.value()),
+                                       component.value_size()));
 }
 
 std::ostream&
@@ -135,18 +199,7 @@ operator>>(std::istream& is, Lsa::Type& type)
 {
   std::string typeString;
   is >> typeString;
-  if (typeString == "ADJACENCY") {
-    type = Lsa::Type::ADJACENCY;
-  }
-  else if (typeString == "COORDINATE") {
-    type = Lsa::Type::COORDINATE;
-  }
-  else if (typeString == "NAME") {
-    type = Lsa::Type::NAME;
-  }
-  else {
-    type = Lsa::Type::BASE;
-  }
+  type = parseLsaType(typeString);
   return is;
 }
 
@@ -23,12 +23,15 @@
 #define NLSR_LSA_LSA_HPP
 
 #include "common.hpp"
+#include "name-interner.hpp"
 #include "name-prefix-list.hpp"
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
 
 #include <list>
+#include <string_view>
+#include <vector>
 
 
 namespace nlsr {
@@ -61,7 +64,7 @@ public:
   };
 
 protected:
-  Lsa() = default;
+  Lsa();
 
   Lsa(const ndn::Name& originRouter, uint64_t seqNo,
       ndn::time::system_clock::time_point expirationTimePoint);
@@ -92,7 +95,19 @@ public:
   const ndn::Name&
   getOriginRouter() const
   {
-    return m_originRouter;
+    return m_originRouter.getName();
+  }
+
+  /**
+   * @brief Returns the hash of the origin router name.
+   *
+   * Hashing an ndn::Name encodes it, so the hash is computed once, when the origin router name
+   * is interned, and serves the LSDB index.
+   */
+  size_t
+  getOriginRouterHash() const
+  {
+    return m_originRouter.getHash();
   }
 
   const ndn::time::system_clock::time_point&
@@ -108,18 +123,43 @@ public:
     m_wire.reset();
   }
 
+  /**
+   * @brief Returns when the LSDB expires or refreshes this LSA.
+   */
+  ndn::time::steady_clock::time_point
+  getExpirationDeadline() const
+  {
+    return m_expirationDeadline;
+  }
+
+  /**
+   * @brief Sets when the LSDB expires or refreshes this LSA.
+   *
+   * The deadline is a key of the LSDB container; once the LSA is installed, it must only be
+   * changed through the container.
+   */
   void
-  setExpiringEventId(ndn::scheduler::EventId eid)
+  setExpirationDeadline(ndn::time::steady_clock::time_point deadline)
   {
-    m_expiringEventId = eid;
+    m_expirationDeadline = deadline;
   }
 
-  virtual std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+  virtual std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) = 0;
 
   virtual const ndn::Block&
   wireEncode() const = 0;
 
+  /**
+   * @brief Returns the size of the cached encoding, or 0 if the LSA has not been encoded since
+   *        it last changed.
+   */
+  size_t
+  getCachedWireSize() const
+  {
+    return m_wire.hasWire() ? m_wire.size() : 0;
+  }
+
 protected:
   template<ndn::encoding::Tag TAG>
   size_t
@@ -136,16 +176,72 @@ private:
   operator<<(std::ostream& os, const Lsa& lsa);
 
 PUBLIC_WITH_TESTS_ELSE_PROTECTED:
-  ndn::Name m_originRouter;
+  InternedName m_originRouter;
   uint64_t m_seqNo = 0;
   ndn::time::system_clock::time_point m_expirationTimePoint;
-  ndn::scheduler::ScopedEventId m_expiringEventId;
+  ndn::time::steady_clock::time_point m_expirationDeadline;
 
   mutable ndn::Block m_wire;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Lsa);
 
+/**
+ * @brief The header of an encoded Name, Adjacency or Coordinate LSA, or Adjacency LSA delta.
+ *
+ * Only the type and the Lsa element are decoded, so that a fetched LSA can be checked
+ * against the LSDB before its body is decoded. The wire is not copied.
+ */
+class LsaHeader
+{
+public:
+  explicit
+  LsaHeader(const ndn::Block& wire);
+
+  Lsa::Type
+  getType() const
+  {
+    return m_type;
+  }
+
+  const ndn::Name&
+  getOriginRouter() const
+  {
+    return m_originRouter;
+  }
+
+  uint64_t
+  getSeqNo() const
+  {
+    return m_seqNo;
+  }
+
+  const ndn::time::system_clock::time_point&
+  getExpirationTimePoint() const
+  {
+    return m_expirationTimePoint;
+  }
+
+private:
+  Lsa::Type m_type;
+  ndn::Name m_originRouter;
+  uint64_t m_seqNo = 0;
+  ndn::time::system_clock::time_point m_expirationTimePoint;
+};
+
+/**
+ * @brief Parses the name of an LSA type as it appears in LSA names, e.g. "ADJACENCY".
+ * @return the type, or Lsa::Type::BASE if @p typeString names no type
+ */
+Lsa::Type
+parseLsaType(std::string_view typeString);
+
+/**
+ * @brief Parses the LSA type component of an LSA name without converting it to a URI.
+ */
+Lsa::Type
+parseLsaType(const ndn::name::Component& component);
+
 std::ostream&
 operator<<(std::ostream& os, const Lsa::Type& type);
 
@@ -22,6 +22,8 @@
 #include "name-lsa.hpp"
 #include "tlv-nlsr.hpp"
 
+#include <algorithm>
+
 namespace nlsr {
 
 NameLsa::NameLsa(const ndn::Name& originRouter, uint64_t seqNo,
@@ -29,7 +31,7 @@ NameLsa::NameLsa(const ndn::Name& originRouter, uint64_t seqNo,
                  const NamePrefixList& npl)
   : Lsa(originRouter, seqNo, timepoint)
 {
-  for (const auto& name : npl.getPrefixInfo()) {
+  for (const auto& name : npl.getPrefixes()) {
     addName(name);
   }
 }
@@ -45,10 +47,51 @@ NameLsa::wireEncode(ndn::EncodingImpl<TAG>& block) const
 {
   size_t totalLength = 0;
 
-  auto names = m_npl.getPrefixInfo();
+  for (auto summary = m_areaSummaries.rbegin(); summary != m_areaSummaries.rend(); ++summary) {
+    size_t summaryLength = 0;
+    for (auto it = summary->prefixes.rbegin(); it != summary->prefixes.rend(); ++it) {
+      summaryLength += it->wireEncode(block);
+    }
+    summaryLength += summary->area.wireEncode(block);
+    summaryLength += block.prependVarNumber(summaryLength);
+    summaryLength += block.prependVarNumber(nlsr::tlv::AreaSummary);
+    totalLength += summaryLength;
+  }
+
+  auto names = m_npl.getPrefixes();
 
-  for (auto it = names.rbegin();  it != names.rend(); ++it) {
-    totalLength += it->wireEncode(block);
+  if (m_isCompressed) {
+    // The encoder prepends, so the number of shared components is computed front to back first
+    std::vector<size_t> nShared;
+    nShared.reserve(names.size());
+    const ndn::Name* previous = nullptr;
+    for (const auto& name : names) {
+      size_t n = 0;
+      if (previous != nullptr) {
+        size_t maxShared = std::min(previous->size(), name.getName().size());
+        while (n < maxShared && (*previous)[n] == name.getName()[n]) {
+          ++n;
+        }
+      }
+      nShared.push_back(n);
+      previous = &name.getName();
+    }
+
+    size_t prefixesLength = 0;
+    auto shared = nShared.rbegin();
+    for (auto it = names.rbegin(); it != names.rend(); ++it, ++shared) {
+      prefixesLength += ndn::encoding::prependDoubleBlock(block, nlsr::tlv::Cost, it->getCost());
+      prefixesLength += it->getName().getSubName(*shared).wireEncode(block);
+      prefixesLength += ndn::encoding::prependNonNegativeIntegerBlock(block, nlsr::tlv::SharedComponents, *shared);
+    }
+    prefixesLength += block.prependVarNumber(prefixesLength);
+    prefixesLength += block.prependVarNumber(nlsr::tlv::CompressedPrefixes);
+    totalLength += prefixesLength;
+  }
+  else {
+    for (auto it = names.rbegin();  it != names.rend(); ++it) {
+      totalLength += it->wireEncode(block);
+    }
   }
 
   totalLength += Lsa::wireEncode(block);
@@ -101,7 +144,30 @@ NameLsa::wireDecode(const ndn::Block& wire)
   }
 
   NamePrefixList npl;
-  for (; val != m_wire.elements_end(); ++val) {
+  m_isCompressed = val != m_wire.elements_end() && val->type() == nlsr::tlv::CompressedPrefixes;
+  if (m_isCompressed) {
+    ndn::Block prefixes = *val;
+    prefixes.parse();
+    ndn::Name previous;
+    for (auto it = prefixes.elements_begin(); it != prefixes.elements_end(); ) {
+      if (it->type() != nlsr::tlv::SharedComponents) {
+        NDN_THROW(Error("SharedComponents", it->type()));
+      }
+      auto nShared = ndn::readNonNegativeInteger(*it++);
+      if (nShared > previous.size() || it == prefixes.elements_end() ||
+          it->type() != ndn::tlv::Name) {
+        NDN_THROW(Error("Malformed compressed prefix"));
+      }
+      ndn::Name name = previous.getPrefix(nShared).append(ndn::Name(*it++));
+      if (it == prefixes.elements_end() || it->type() != nlsr::tlv::Cost) {
+        NDN_THROW(Error("Missing required Cost field"));
+      }
+      npl.insert(PrefixInfo(name, ndn::encoding::readDouble(*it++)));
+      previous = std::move(name);
+    }
+    ++val;
+  }
+  for (; val != m_wire.elements_end() && val->type() != nlsr::tlv::AreaSummary; ++val) {
     if (val->type() == nlsr::tlv::PrefixInfo) {
       //TODO: Implement this structure as a type instead and add decoding
       npl.insert(PrefixInfo(*val));
@@ -110,7 +176,30 @@ NameLsa::wireDecode(const ndn::Block& wire)
       NDN_THROW(Error("Name", val->type()));
     }
   }
+
+  std::vector<AreaSummary> summaries;
+  for (; val != m_wire.elements_end(); ++val) {
+    if (val->type() != nlsr::tlv::AreaSummary) {
+      NDN_THROW(Error("AreaSummary", val->type()));
+    }
+    ndn::Block summaryBlock = *val;
+    summaryBlock.parse();
+    auto it = summaryBlock.elements_begin();
+    if (it == summaryBlock.elements_end() || it->type() != ndn::tlv::Name) {
+      NDN_THROW(Error("Missing required area Name field"));
+    }
+    AreaSummary& summary = summaries.emplace_back();
+    summary.area.wireDecode(*it++);
+    for (; it != summaryBlock.elements_end(); ++it) {
+      if (it->type() != nlsr::tlv::PrefixInfo) {
+        NDN_THROW(Error("PrefixInfo", it->type()));
+      }
+      summary.prefixes.emplace_back(*it);
+    }
+  }
+
   m_npl = npl;
+  m_areaSummaries = std::move(summaries);
 }
 
 void
@@ -118,44 +207,59 @@ NameLsa::print(std::ostream& os) const
 {
   os << "      Names:\n";
   int i = 0;
-  for (const auto& name : m_npl.getPrefixInfo()) {
+  for (const auto& name : m_npl.getPrefixes()) {
     os << "        Name " << i << ": " << name.getName()
        << " | Cost: " << name.getCost() << "\n";
     i++;
   }
+  for (const auto& summary : m_areaSummaries) {
+    os << "      Summary for area " << summary.area << ":\n";
+    for (const auto& prefix : summary.prefixes) {
+      os << "        Name: " << prefix.getName() << " | Cost: " << prefix.getCost() << "\n";
+    }
+  }
 }
 
-std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
 NameLsa::update(const std::shared_ptr<Lsa>& lsa)
 {
   auto nlsa = std::static_pointer_cast<NameLsa>(lsa);
   bool updated = false;
+  setCompressed(nlsa->isCompressed());
 
-  // Obtain the set difference of the current and the incoming
-  // name prefix sets, and add those.
+  // A single merge of the current and the incoming prefixes, both in canonical order, finds
+  // the added and the removed names. The names advertised by both keep their current cost.
+  auto oldNames = m_npl.getPrefixes();
+  auto newNames = nlsa->getNpl().getPrefixes();
+  std::vector<PrefixInfo> namesToAdd;
+  std::vector<PrefixInfo> namesToRemove;
+  NamePrefixList merged;
 
-  std::list<ndn::Name> newNames = nlsa->getNpl().getNames();
-  std::list<ndn::Name> oldNames = m_npl.getNames();
-  std::list<ndn::Name> nameRefToAdd;
-  std::list<PrefixInfo> namesToAdd;
+  auto oldIt = oldNames.begin();
+  auto newIt = newNames.begin();
+  while (oldIt != oldNames.end() || newIt != newNames.end()) {
+    if (newIt == newNames.end() || (oldIt != oldNames.end() && oldIt->getName() < newIt->getName())) {
+      namesToRemove.push_back(*oldIt++);
+    }
+    else if (oldIt == oldNames.end() || newIt->getName() < oldIt->getName()) {
+      namesToAdd.push_back(*newIt);
+      merged.insert(*newIt++);
+    }
+    else {
+      merged.insert(*oldIt++);
+      ++newIt;
+    }
+  }
 
-  std::set_difference(newNames.begin(), newNames.end(), oldNames.begin(), oldNames.end(),
-                      std::inserter(nameRefToAdd, nameRefToAdd.begin()));
-  for (const auto& name : nameRefToAdd) {
-    namesToAdd.push_back(nlsa->getNpl().getPrefixInfoForName(name));
-    addName(nlsa->getNpl().getPrefixInfoForName(name));
+  if (!namesToAdd.empty() || !namesToRemove.empty()) {
+    m_wire.reset();
+    m_npl = std::move(merged);
     updated = true;
   }
-
-  // Also remove any names that are no longer being advertised.
-  std::list<ndn::Name> nameRefToRemove;
-  std::list<PrefixInfo> namesToRemove;
-  std::set_difference(oldNames.begin(), oldNames.end(), newNames.begin(), newNames.end(),
-                      std::inserter(nameRefToRemove, nameRefToRemove.begin()));
-  for (const auto& name : nameRefToRemove) {
-    namesToRemove.push_back(m_npl.getPrefixInfoForName(name));
-    removeName(m_npl.getPrefixInfoForName(name));
-
+  // the costs of the summarized prefixes follow the routes of the border router
+  if (m_areaSummaries != nlsa->getAreaSummaries()) {
+    m_wire.reset();
+    m_areaSummaries = nlsa->getAreaSummaries();
     updated = true;
   }
   return {updated, namesToAdd, namesToRemove};
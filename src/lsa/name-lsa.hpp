@@ -27,8 +27,33 @@
 
 #include <boost/operators.hpp>
 
+#include <vector>
+
 namespace nlsr {
 
+/**
+ * @brief Name prefixes that an area border router advertises into one of its areas, with
+ *        its cost to reach each of them.
+ */
+struct AreaSummary
+{
+  ndn::Name area;
+  /// in canonical order
+  std::vector<PrefixInfo> prefixes;
+
+  friend bool
+  operator==(const AreaSummary& lhs, const AreaSummary& rhs)
+  {
+    return lhs.area == rhs.area && lhs.prefixes == rhs.prefixes;
+  }
+
+  friend bool
+  operator!=(const AreaSummary& lhs, const AreaSummary& rhs)
+  {
+    return !(lhs == rhs);
+  }
+};
+
 /**
  * @brief Represents an LSA of name prefixes announced by the origin router.
  *
@@ -36,8 +61,22 @@ namespace nlsr {
  * @code{.abnf}
  * NameLsa = NAME-LSA-TYPE TLV-LENGTH
  *             Lsa
- *             1*Name
+ *             (*PrefixInfo / CompressedPrefixes)
+ *             *AreaSummary
+ *
+ * CompressedPrefixes = COMPRESSED-PREFIXES-TYPE TLV-LENGTH
+ *                        *(SharedComponents Name Cost)
+ *
+ * AreaSummary = AREA-SUMMARY-TYPE TLV-LENGTH
+ *                 Name ; area
+ *                 *PrefixInfo
  * @endcode
+ *
+ * In the compressed form, the prefixes are in canonical order and each Name only holds the
+ * components that follow the SharedComponents leading components of the previous prefix.
+ *
+ * The area summaries are only carried by the Name LSAs of area border routers. Each is meant
+ * for the routers of its area, see ConfParameter::setAreaDepth.
  */
 class NameLsa : public Lsa, private boost::equality_comparable<NameLsa>
 {
@@ -89,6 +128,35 @@ public:
     m_npl.erase(name.getName());
   }
 
+  const std::vector<AreaSummary>&
+  getAreaSummaries() const
+  {
+    return m_areaSummaries;
+  }
+
+  void
+  setAreaSummaries(std::vector<AreaSummary> summaries)
+  {
+    m_wire.reset();
+    m_areaSummaries = std::move(summaries);
+  }
+
+  /**
+   * @brief Returns whether the prefixes are encoded in the compressed form.
+   */
+  bool
+  isCompressed() const
+  {
+    return m_isCompressed;
+  }
+
+  void
+  setCompressed(bool isCompressed)
+  {
+    m_wire.reset();
+    m_isCompressed = isCompressed;
+  }
+
   template<ndn::encoding::Tag TAG>
   size_t
   wireEncode(ndn::EncodingImpl<TAG>& block) const;
@@ -99,7 +167,7 @@ public:
   void
   wireDecode(const ndn::Block& wire);
 
-  std::tuple<bool, std::list<PrefixInfo>, std::list<PrefixInfo>>
+  std::tuple<bool, std::vector<PrefixInfo>, std::vector<PrefixInfo>>
   update(const std::shared_ptr<Lsa>& lsa) override;
 
 private:
@@ -114,11 +182,13 @@ private: // non-member operators
   friend bool
   operator==(const NameLsa& lhs, const NameLsa& rhs)
   {
-    return lhs.m_npl == rhs.m_npl;
+    return lhs.m_npl == rhs.m_npl && lhs.m_areaSummaries == rhs.m_areaSummaries;
   }
 
 private:
   NamePrefixList m_npl;
+  std::vector<AreaSummary> m_areaSummaries;
+  bool m_isCompressed = false;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(NameLsa);
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LSDB_SNAPSHOT_HPP
+#define NLSR_LSDB_SNAPSHOT_HPP
+
+#include "lsa/lsa.hpp"
+
+#include <array>
+#include <memory>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Immutable view of the LSDB at one version.
+
+  A snapshot holds the LSAs that were installed when it was taken. The LSDB never modifies
+  an LSA that a snapshot holds; it installs a modified copy instead. A snapshot can therefore
+  be read on any thread while the LSDB keeps changing on the io thread, as long as only the
+  const accessors of the LSAs are used; Lsa::wireEncode() caches the encoding, so it is
+  reserved to the io thread.
+ */
+class LsdbSnapshot
+{
+public:
+  using LsaList = std::vector<std::shared_ptr<const Lsa>>;
+  using LsaLists = std::array<LsaList, static_cast<size_t>(Lsa::Type::BASE)>;
+
+  LsdbSnapshot(uint64_t version, LsaLists lsas)
+    : m_version(version)
+    , m_lsas(std::move(lsas))
+  {
+  }
+
+  /*! \brief Returns the LSDB version, which changes whenever an LSA is installed, updated,
+             refreshed or removed.
+   */
+  uint64_t
+  getVersion() const
+  {
+    return m_version;
+  }
+
+  const LsaList&
+  getLsas(Lsa::Type type) const
+  {
+    static const LsaList empty;
+    auto index = static_cast<size_t>(type);
+    return index < m_lsas.size() ? m_lsas[index] : empty;
+  }
+
+  template<typename T>
+  const LsaList&
+  getLsas() const
+  {
+    return getLsas(T::type());
+  }
+
+  size_t
+  size() const
+  {
+    size_t nLsas = 0;
+    for (const auto& lsas : m_lsas) {
+      nLsas += lsas.size();
+    }
+    return nLsas;
+  }
+
+private:
+  uint64_t m_version;
+  LsaLists m_lsas;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSDB_SNAPSHOT_HPP
@@ -21,16 +21,53 @@
 
 #include "lsdb.hpp"
 
+#include "link-cost-manager.hpp"
 #include "logger.hpp"
 #include "nlsr.hpp"
+#include "tlv-nlsr.hpp"
 #include "utility/name-helper.hpp"
 
 #include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/util/random.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <set>
 
 namespace nlsr {
 
 INIT_LOGGER(Lsdb);
 
+namespace {
+
+constexpr uint32_t SNAPSHOT_FILE_MAGIC = 0x4e4c5344; // "NLSD"
+constexpr uint32_t SNAPSHOT_FILE_VERSION = 1;
+// Retries of an LSA fetch back off for up to 2^4 LSA Interest lifetimes
+constexpr uint32_t LSA_FETCH_RETRY_BACKOFF_MAX_EXPONENT = 4;
+// Initial window, in segments, of LSA fetches through a neighbor without loss
+constexpr double LSA_FETCH_INIT_CWND = 8.0;
+// Packet loss from which the link to a neighbor is lossy
+constexpr double LSA_FETCH_LOSSY_LINK = 0.01;
+
+std::vector<ndn::Name>
+makeBorderSyncPrefixes(const ConfParameter& confParam)
+{
+  std::vector<ndn::Name> syncPrefixes;
+  auto ownArea = confParam.getArea();
+  for (const auto& area : confParam.getAreas()) {
+    if (area != ownArea) {
+      syncPrefixes.push_back(confParam.getAreaSyncPrefix(area));
+    }
+  }
+  return syncPrefixes;
+}
+
+} // namespace
+
 Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   : m_face(face)
   , m_scheduler(face.getIoContext())
@@ -41,11 +78,14 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
       },
       SyncLogicOptions{
         confParam.getSyncProtocol(),
-        confParam.getSyncPrefix(),
+        confParam.getAreaSyncPrefix(confParam.getArea()),
         confParam.getSyncUserPrefix(),
         confParam.getSyncInterestLifetime(),
         confParam.getRouterPrefix(),
-        confParam.getHyperbolicState()
+        confParam.getHyperbolicState(),
+        confParam.getSyncPublishHoldDown(),
+        makeBorderSyncPrefixes(confParam),
+        confParam.getSyncExpectedRouters()
       })
   , m_lsaRefreshTime(ndn::time::seconds(m_confParam.getLsaRefreshTime()))
   , m_adjLsaBuildInterval(m_confParam.getAdjLsaBuildInterval())
@@ -54,8 +94,23 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_onNewLsaConnection(m_sync.onNewLsa.connect(
       [this] (const ndn::Name& updateName, uint64_t sequenceNumber,
               const ndn::Name& originRouter, uint64_t incomingFaceId) {
+        if (m_latency != nullptr) {
+          if (getHighestSeqNo(updateName) < sequenceNumber) {
+            m_syncNotifications.try_emplace(updateName,
+                                            SyncNotification{sequenceNumber,
+                                                             ndn::time::steady_clock::now()});
+          }
+        }
         ndn::Name lsaInterest{updateName};
         lsaInterest.appendNumber(sequenceNumber);
+        if (auto it = m_pendingInlineLsas.find(lsaInterest); it != m_pendingInlineLsas.end()) {
+          // The LSA arrived inline and is being validated
+          it->second = true;
+          return;
+        }
+        if (deferLsaFetch(updateName, sequenceNumber, incomingFaceId)) {
+          return;
+        }
         expressInterest(lsaInterest, 0, incomingFaceId);
       }))
   , m_segmenter(keyChain, m_confParam.getSigningInfo())
@@ -63,6 +118,8 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_isBuildAdjLsaScheduled(false)
   , m_adjBuildCount(0)
 {
+  m_lsaStorage.setCapacity(static_cast<size_t>(m_confParam.getLsaSegmentStorageLimit()) * 1024);
+
   ndn::Name name = m_confParam.getLsaPrefix();
   NLSR_LOG_DEBUG("Setting interest filter for LsaPrefix: " << name);
 
@@ -75,32 +132,176 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
     },
     m_confParam.getSigningInfo(), ndn::nfd::ROUTE_FLAG_CAPTURE);
 
+  m_afterPublishConnection = m_sync.afterPublish.connect([this] (const ndn::Name& lsaName) {
+    if (m_tracer != nullptr) {
+      m_tracer->record(ConvergenceStage::SYNC_PUBLISH, lsaName);
+    }
+  });
+
+  if (m_confParam.getSyncInlineLsaSize() > 0) {
+    m_sync.setInlineLsaCallbacks([this] { return getInlineLsas(); },
+                                 [this] (const ndn::Data& data) { onInlineLsa(data); });
+  }
+
   buildAndInstallOwnNameLsa();
   // Install coordinate LSAs if using HR or dry-run HR.
   if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
     buildAndInstallOwnCoordinateLsa();
   }
+
+  if (m_confParam.getLsdbSnapshotInterval() > 0 && !m_confParam.getStateFileDir().empty()) {
+    m_snapshotFilePath = m_confParam.getStateFileDir() + "/" + LSDB_SNAPSHOT_FILE;
+    scheduleSnapshotFileWrite();
+  }
 }
 
 Lsdb::~Lsdb()
 {
-  for (const auto& fetcher : m_fetchers) {
-    fetcher->stop();
+  writeSnapshotFile();
+  for (const auto& [lsaName, fetch] : m_lsaFetches) {
+    if (fetch.fetcher != nullptr) {
+      fetch.fetcher->stop();
+    }
   }
 }
 
 void
 Lsdb::buildAndInstallOwnNameLsa()
 {
+  // this build covers the changes a scheduled one was waiting for
+  m_scheduledNameLsaBuild.cancel();
+  m_isNameLsaBuildScheduled = false;
+
   NameLsa nameLsa(m_thisRouterPrefix, m_sequencingManager.getNameLsaSeq() + 1,
-                  getLsaExpirationTimePoint(), m_confParam.getNamePrefixList());
+                  getLsaExpirationTimePoint(), getAdvertisedPrefixes());
+  nameLsa.setCompressed(m_confParam.getNameLsaCompression());
+  nameLsa.setAreaSummaries(m_areaSummaries);
   m_sequencingManager.increaseNameLsaSeq();
-  m_sequencingManager.writeSeqNoToFile();
+  m_sequencingManager.leaseSeqNo();
+  if (m_tracer != nullptr) {
+    m_tracer->record(ConvergenceStage::NAME_LSA_BUILD);
+  }
   m_sync.publishRoutingUpdate(Lsa::Type::NAME, m_sequencingManager.getNameLsaSeq());
 
   installLsa(std::make_shared<NameLsa>(nameLsa));
 }
 
+void
+Lsdb::scheduleNameLsaBuild(const ndn::Name& prefix)
+{
+  if (m_tracer != nullptr) {
+    m_tracer->begin(ConvergenceStage::PREFIX_COMMAND, prefix, ConvergenceTracer::LOCAL_PREFIX_PATH);
+  }
+
+  auto interval = m_confParam.getNameLsaBuildInterval();
+  if (interval <= 0_ms) {
+    buildAndInstallOwnNameLsa();
+    return;
+  }
+
+  if (m_isNameLsaBuildScheduled) {
+    NLSR_LOG_TRACE("Name LSA build already scheduled");
+    return;
+  }
+  // not postponed by further changes, so that continuous churn is still advertised
+  NLSR_LOG_DEBUG("Scheduling Name LSA build in " << interval);
+  m_isNameLsaBuildScheduled = true;
+  m_scheduledNameLsaBuild = m_scheduler.schedule(interval, [this] { buildAndInstallOwnNameLsa(); });
+}
+
+void
+Lsdb::setAreaSummaries(std::vector<AreaSummary> summaries)
+{
+  if (summaries == m_areaSummaries) {
+    return;
+  }
+  NLSR_LOG_DEBUG("Area summaries changed, rebuilding Name LSA");
+  m_areaSummaries = std::move(summaries);
+  scheduleNameLsaBuild();
+}
+
+const ndn::Name*
+Lsdb::findAggregate(const ndn::Name& name) const
+{
+  const ndn::Name* found = nullptr;
+  for (const auto& aggregate : m_confParam.getAggregatePrefixes()) {
+    if (aggregate.size() < name.size() && aggregate.isPrefixOf(name) &&
+        (found == nullptr || aggregate.size() < found->size())) {
+      found = &aggregate;
+    }
+  }
+  return found;
+}
+
+NamePrefixList
+Lsdb::getAdvertisedPrefixes() const
+{
+  const auto& npl = m_confParam.getNamePrefixList();
+  if (m_confParam.getAggregatePrefixes().empty()) {
+    return npl;
+  }
+
+  // prefixes that the other routers originate under the aggregates
+  std::set<ndn::Name> foreignPrefixes;
+  auto range = getLsdbIterator<NameLsa>();
+  for (auto it = range.first; it != range.second; ++it) {
+    if ((*it)->getOriginRouter() == m_thisRouterPrefix) {
+      continue;
+    }
+    for (const auto& prefix : static_cast<const NameLsa&>(**it).getNpl().getPrefixes()) {
+      if (findAggregate(prefix.getName()) != nullptr) {
+        foreignPrefixes.insert(prefix.getName());
+      }
+    }
+  }
+
+  NamePrefixList advertised;
+  std::map<ndn::Name, double> aggregated;
+  for (const auto& prefix : npl.getPrefixes()) {
+    const auto& name = prefix.getName();
+    const ndn::Name* aggregate = findAggregate(name);
+    bool isException = false;
+    for (size_t i = aggregate == nullptr ? name.size() : aggregate->size() + 1;
+         i <= name.size() && !isException; ++i) {
+      isException = foreignPrefixes.count(name.getPrefix(i)) > 0;
+    }
+    if (aggregate == nullptr || isException) {
+      advertised.insert(prefix);
+      continue;
+    }
+    auto [it, isNew] = aggregated.try_emplace(*aggregate, prefix.getCost());
+    if (!isNew) {
+      it->second = std::min(it->second, prefix.getCost());
+    }
+  }
+  // an aggregate that is also advertised as such keeps its own cost
+  for (const auto& [name, cost] : aggregated) {
+    advertised.insert(PrefixInfo(name, cost));
+  }
+  NLSR_LOG_TRACE("Advertising " << advertised.size() << " of " << npl.size() << " prefixes");
+  return advertised;
+}
+
+bool
+Lsdb::coversAggregatedPrefix(ndn::span<const PrefixInfo> foreignPrefixes) const
+{
+  auto ownPrefixes = m_confParam.getNamePrefixList().getPrefixes();
+  for (const auto& prefix : foreignPrefixes) {
+    if (findAggregate(prefix.getName()) == nullptr) {
+      continue;
+    }
+    // our prefixes under this one directly follow it in canonical order
+    auto it = std::lower_bound(ownPrefixes.begin(), ownPrefixes.end(), prefix.getName(),
+                               [] (const PrefixInfo& own, const ndn::Name& name) {
+                                 return own.getName() < name;
+                               });
+    if (it != ownPrefixes.end() && prefix.getName().isPrefixOf(it->getName())) {
+      return true;
+    }
+  }
+  return false;
+}
+
 void
 Lsdb::buildAndInstallOwnCoordinateLsa()
 {
@@ -108,7 +309,7 @@ Lsdb::buildAndInstallOwnCoordinateLsa()
                        getLsaExpirationTimePoint(), m_confParam.getCorR(),
                        m_confParam.getCorTheta());
   m_sequencingManager.increaseCorLsaSeq();
-  m_sequencingManager.writeSeqNoToFile();
+  m_sequencingManager.leaseSeqNo();
 
   // Sync coordinate LSAs if using HR or HR dry run.
   if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
@@ -203,6 +404,11 @@ Lsdb::scheduleAdjLsaBuildWithType(AdjLsaBuildType buildType)
 void
 Lsdb::writeLog() const
 {
+  if (!NLSR_LOG_DEBUG_ENABLED()) {
+    return;
+  }
+
+  auto snapshot = getSnapshot();
   for (auto type : {Lsa::Type::COORDINATE, Lsa::Type::NAME, Lsa::Type::ADJACENCY}) {
     if ((type == Lsa::Type::COORDINATE &&
          m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_OFF) ||
@@ -212,13 +418,129 @@ Lsdb::writeLog() const
     }
 
     NLSR_LOG_DEBUG("---------------" << type << " LSDB-------------------");
-    auto lsaRange = m_lsdb.get<byType>().equal_range(type);
-    for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; ++lsaIt) {
-      NLSR_LOG_DEBUG(**lsaIt);
+    for (const auto& lsa : snapshot->getLsas(type)) {
+      NLSR_LOG_DEBUG(*lsa);
     }
   }
 }
 
+void
+Lsdb::scheduleSnapshotFileWrite()
+{
+  m_snapshotFileEvent = m_scheduler.schedule(
+    ndn::time::seconds(m_confParam.getLsdbSnapshotInterval()), [this] {
+      writeSnapshotFile();
+      scheduleSnapshotFileWrite();
+    });
+}
+
+void
+Lsdb::writeSnapshotFile()
+{
+  if (m_snapshotFilePath.empty() || m_snapshotFileVersion == m_version) {
+    return;
+  }
+
+  auto snapshot = getSnapshot();
+  std::string tempPath = m_snapshotFilePath + ".tmp";
+  size_t nLsas = 0;
+  {
+    std::ofstream os(tempPath, std::ios::binary | std::ios::trunc);
+    os.write(reinterpret_cast<const char*>(&SNAPSHOT_FILE_MAGIC), sizeof(SNAPSHOT_FILE_MAGIC));
+    os.write(reinterpret_cast<const char*>(&SNAPSHOT_FILE_VERSION), sizeof(SNAPSHOT_FILE_VERSION));
+    for (auto type : {Lsa::Type::ADJACENCY, Lsa::Type::COORDINATE, Lsa::Type::NAME}) {
+      for (const auto& lsa : snapshot->getLsas(type)) {
+        if (lsa->getOriginRouter() == m_thisRouterPrefix) {
+          continue;
+        }
+        const auto& wire = lsa->wireEncode();
+        os.write(reinterpret_cast<const char*>(wire.data()), wire.size());
+        ++nLsas;
+      }
+    }
+    if (!os) {
+      NLSR_LOG_WARN("Cannot write LSDB snapshot " << tempPath);
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tempPath, m_snapshotFilePath, ec);
+  if (ec) {
+    NLSR_LOG_WARN("Cannot write LSDB snapshot " << m_snapshotFilePath << ": " << ec.message());
+    return;
+  }
+  m_snapshotFileVersion = snapshot->getVersion();
+  NLSR_LOG_DEBUG("Wrote " << nLsas << " LSAs to " << m_snapshotFilePath);
+}
+
+size_t
+Lsdb::loadSnapshotFile()
+{
+  if (m_snapshotFilePath.empty()) {
+    return 0;
+  }
+
+  std::ifstream is(m_snapshotFilePath, std::ios::binary);
+  if (!is) {
+    NLSR_LOG_DEBUG("No LSDB snapshot at " << m_snapshotFilePath);
+    return 0;
+  }
+  auto buffer = std::make_shared<ndn::Buffer>(std::istreambuf_iterator<char>(is),
+                                              std::istreambuf_iterator<char>());
+
+  uint32_t magic = 0, version = 0;
+  size_t offset = sizeof(magic) + sizeof(version);
+  if (buffer->size() >= offset) {
+    std::memcpy(&magic, buffer->data(), sizeof(magic));
+    std::memcpy(&version, buffer->data() + sizeof(magic), sizeof(version));
+  }
+  if (magic != SNAPSHOT_FILE_MAGIC || version != SNAPSHOT_FILE_VERSION) {
+    NLSR_LOG_WARN("Ignoring incompatible LSDB snapshot " << m_snapshotFilePath);
+    return 0;
+  }
+
+  auto now = ndn::time::system_clock::now();
+  size_t nInstalled = 0;
+  while (offset < buffer->size()) {
+    auto [isOk, block] = ndn::Block::fromBuffer(buffer, offset);
+    if (!isOk) {
+      NLSR_LOG_WARN("Ignoring truncated tail of LSDB snapshot " << m_snapshotFilePath);
+      break;
+    }
+    offset += block.size();
+
+    try {
+      std::shared_ptr<Lsa> lsa;
+      switch (block.type()) {
+        case nlsr::tlv::AdjacencyLsa:
+          lsa = std::make_shared<AdjLsa>(block);
+          break;
+        case nlsr::tlv::CoordinateLsa:
+          lsa = std::make_shared<CoordinateLsa>(block);
+          break;
+        case nlsr::tlv::NameLsa:
+          lsa = std::make_shared<NameLsa>(block);
+          break;
+        default:
+          continue;
+      }
+      if (lsa->getOriginRouter() == m_thisRouterPrefix || lsa->getExpirationTimePoint() <= now ||
+          !isLsaNew(lsa->getOriginRouter(), lsa->getType(), lsa->getSeqNo())) {
+        continue;
+      }
+      installLsa(lsa);
+      ++nInstalled;
+    }
+    catch (const std::exception& e) {
+      NLSR_LOG_WARN("Ignoring undecodable LSA in LSDB snapshot: " << e.what());
+    }
+  }
+
+  NLSR_LOG_INFO("Loaded " << nInstalled << " LSAs from " << m_snapshotFilePath);
+  return nInstalled;
+}
+
 void
 Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
 {
@@ -230,7 +552,7 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
     auto data = m_segmentFifo.find(interestName);
     if (data) {
       NLSR_LOG_TRACE("Replying from FIFO buffer");
-      m_face.put(*data);
+      putLsaData(interest, *data);
       return;
     }
 
@@ -240,10 +562,9 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
   }
 
   // increment RCV_LSA_INTEREST
-  lsaIncrementSignal(Statistics::PacketType::RCV_LSA_INTEREST);
+  countPacket(Statistics::PacketType::RCV_LSA_INTEREST);
 
-  std::string chkString("LSA");
-  int32_t lsaPosition = util::getNameComponentPosition(interestName, chkString);
+  int32_t lsaPosition = util::getNameComponentPosition(interestName, util::LSA_COMPONENT);
 
   // Forms the name of the router that the Interest packet came from.
   ndn::Name originRouter = m_confParam.getNetwork();
@@ -255,23 +576,29 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
     uint64_t seqNo = interestName[-1].toNumber();
     NLSR_LOG_DEBUG("LSA sequence number from interest: " << seqNo);
 
-    std::string lsaType = interestName[-2].toUri();
-    Lsa::Type interestedLsType;
-    std::istringstream(lsaType) >> interestedLsType;
+    if (interestName[-2] == ADJ_LSA_DELTA_COMPONENT) {
+      incrementInterestRcvdStats(Lsa::Type::ADJACENCY);
+      if (processInterestForAdjLsaDelta(interest, seqNo)) {
+        countPacket(Statistics::PacketType::SENT_LSA_DATA);
+      }
+      return;
+    }
+
+    Lsa::Type interestedLsType = parseLsaType(interestName[-2]);
     if (interestedLsType == Lsa::Type::BASE) {
-      NLSR_LOG_WARN("Received unrecognized LSA type: " << lsaType);
+      NLSR_LOG_WARN("Received unrecognized LSA type: " << interestName[-2].toUri());
       return;
     }
 
     incrementInterestRcvdStats(interestedLsType);
     if (processInterestForLsa(interest, originRouter, interestedLsType, seqNo)) {
-      lsaIncrementSignal(Statistics::PacketType::SENT_LSA_DATA);
+      countPacket(Statistics::PacketType::SENT_LSA_DATA);
     }
   }
   // else the interest is for other router's LSA, serve signed data from LsaSegmentStorage
   else if (auto lsaSegment = m_lsaStorage.find(interest); lsaSegment) {
     NLSR_LOG_TRACE("Found data in LSA storage. Sending data for " << interest.getName());
-    m_face.put(*lsaSegment);
+    putLsaData(interest, *lsaSegment);
   }
 }
 
@@ -284,21 +611,15 @@ Lsdb::processInterestForLsa(const ndn::Interest& interest, const ndn::Name& orig
   if (auto lsaPtr = findLsa(originRouter, lsaType); lsaPtr) {
     NLSR_LOG_TRACE("Verifying SeqNo for " << lsaType << " is same as requested");
     if (lsaPtr->getSeqNo() == seqNo) {
-      auto segments = m_segmenter.segment(lsaPtr->wireEncode(),
-                                          ndn::Name(interest.getName()).appendVersion(),
-                                          ndn::MAX_NDN_PACKET_SIZE / 2, m_lsaRefreshTime);
-      for (const auto& data : segments) {
-        m_segmentFifo.insert(*data, m_lsaRefreshTime);
-        m_scheduler.schedule(m_lsaRefreshTime,
-                             [this, name = data->getName()] { m_segmentFifo.erase(name); });
-      }
+      const auto& segments = getOwnLsaSegments(m_ownLsaSegments[static_cast<size_t>(lsaType)],
+                                               seqNo, lsaPtr->wireEncode(), interest);
 
       uint64_t segNum = 0;
       if (interest.getName()[-1].isSegment()) {
         segNum = interest.getName()[-1].toSegment();
       }
       if (segNum < segments.size()) {
-        m_face.put(*segments[segNum]);
+        putLsaData(interest, *segments[segNum]);
       }
       incrementDataSentStats(lsaType);
       return true;
@@ -311,39 +632,229 @@ Lsdb::processInterestForLsa(const ndn::Interest& interest, const ndn::Name& orig
 }
 
 void
+Lsdb::putLsaData(const ndn::Interest& interest, const ndn::Data& data)
+{
+  m_face.put(data);
+  auto& adjacencyList = m_confParam.getAdjacencyList();
+  if (auto* traffic = adjacencyList.findControlTraffic(getIncomingFaceId(interest));
+      traffic != nullptr) {
+    traffic->countInterestReceived(ControlTraffic::MessageClass::LSA_FETCH, interest);
+    traffic->countDataSent(ControlTraffic::MessageClass::LSA_FETCH, data);
+  }
+}
+
+bool
+Lsdb::processInterestForAdjLsaDelta(const ndn::Interest& interest, uint64_t seqNo)
+{
+  auto lsa = findLsa<AdjLsa>(m_thisRouterPrefix);
+  if (lsa == nullptr || lsa->getSeqNo() != seqNo) {
+    NLSR_LOG_TRACE(interest << " is not for our current Adjacency LSA");
+    return false;
+  }
+
+  if (m_ownAdjLsaDeltaSegments.segments.empty() || m_ownAdjLsaDeltaSegments.seqNo != seqNo) {
+    const AdjLsa* base = nullptr;
+    if (m_previousOwnAdjLsa != nullptr && m_previousOwnAdjLsa->getSeqNo() + 1 == seqNo) {
+      base = m_previousOwnAdjLsa.get();
+    }
+    AdjLsaDelta delta(base, *lsa);
+    NLSR_LOG_DEBUG("Adjacency LSA delta " << delta.getBaseSeqNo() << " -> " << seqNo << ": "
+                   << delta.getChangedAdjacencies().size() << " changed, "
+                   << delta.getRemovedNeighbors().size() << " removed");
+    getOwnLsaSegments(m_ownAdjLsaDeltaSegments, seqNo, delta.wireEncode(), interest);
+  }
+  const auto& segments = m_ownAdjLsaDeltaSegments.segments;
+
+  uint64_t segNum = 0;
+  if (interest.getName()[-1].isSegment()) {
+    segNum = interest.getName()[-1].toSegment();
+  }
+  if (segNum < segments.size()) {
+    putLsaData(interest, *segments[segNum]);
+  }
+  incrementDataSentStats(Lsa::Type::ADJACENCY);
+  return true;
+}
+
+const std::vector<std::shared_ptr<ndn::Data>>&
+Lsdb::getOwnLsaSegments(OwnLsaSegments& ownSegments, uint64_t seqNo, const ndn::Block& wire,
+                        const ndn::Interest& interest)
+{
+  // Segment and sign each version of our own LSAs once, for all neighbors
+  if (ownSegments.segments.empty() || ownSegments.seqNo != seqNo) {
+    ndn::Name lsaName = interest.getName();
+    if (lsaName[-1].isSegment() && lsaName.size() > 1 && lsaName[-2].isVersion()) {
+      lsaName = lsaName.getPrefix(-2);
+    }
+    ownSegments.seqNo = seqNo;
+    ownSegments.segments = m_segmenter.segment(wire, lsaName.appendVersion(),
+                                               m_confParam.getLsaSegmentSize(), m_lsaRefreshTime);
+    NLSR_LOG_DEBUG("Segmented " << lsaName << " (" << wire.size() << " bytes) into "
+                   << ownSegments.segments.size() << " segments");
+    for (const auto& data : ownSegments.segments) {
+      m_segmentFifo.insert(*data, m_lsaRefreshTime);
+      m_scheduler.schedule(m_lsaRefreshTime,
+                           [this, name = data->getName()] { m_segmentFifo.erase(name); });
+    }
+  }
+  return ownSegments.segments;
+}
+
+bool
 Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
 {
+  bool isRemote = lsa->getOriginRouter() != m_thisRouterPrefix;
   auto timeToExpire = m_lsaRefreshTime;
-  if (lsa->getOriginRouter() != m_thisRouterPrefix) {
+  if (isRemote) {
     auto duration = lsa->getExpirationTimePoint() - ndn::time::system_clock::now();
     if (duration > ndn::time::seconds(0)) {
       timeToExpire = ndn::time::duration_cast<ndn::time::seconds>(duration);
     }
   }
 
-  auto chkLsa = findLsa(lsa->getOriginRouter(), lsa->getType());
-  if (chkLsa == nullptr) {
+  auto lsaIt = m_lsdb.get<byName>().find(ExtractLsaKey{}(*lsa));
+  if (lsaIt == m_lsdb.end()) {
     NLSR_LOG_DEBUG("Adding LSA:\n" << *lsa);
 
+    beginModification();
+    lsa->setExpirationDeadline(ndn::time::steady_clock::now() + timeToExpire + GRACE_PERIOD);
     m_lsdb.emplace(lsa);
-    onLsdbModified(lsa, LsdbUpdate::INSTALLED, {}, {});
-
-    lsa->setExpiringEventId(scheduleLsaExpiration(lsa, timeToExpire));
+    scheduleExpirationSweep();
+    updateRouterMap(*lsa, LsdbUpdate::INSTALLED);
+    if (isRemote && m_tracer != nullptr) {
+      m_tracer->record(ConvergenceStage::LSA_INSTALL);
+    }
+    onLsdbModified(lsa, LsdbUpdate::INSTALLED, {}, {}, {});
+    if (isRemote && lsa->getType() == Lsa::Type::NAME &&
+        coversAggregatedPrefix(static_cast<const NameLsa&>(*lsa).getNpl().getPrefixes())) {
+      NLSR_LOG_DEBUG(lsa->getOriginRouter() << " originates some of our aggregated prefixes");
+      scheduleNameLsaBuild();
+    }
+    return true;
   }
   // Else this is a known name LSA, so we are updating it.
-  else if (chkLsa->getSeqNo() < lsa->getSeqNo()) {
+  else if ((*lsaIt)->getSeqNo() < lsa->getSeqNo()) {
+    beginModification();
+    auto chkLsa = makeWritable(lsaIt);
     NLSR_LOG_DEBUG("Updating LSA:\n" << *chkLsa);
     chkLsa->setSeqNo(lsa->getSeqNo());
     chkLsa->setExpirationTimePoint(lsa->getExpirationTimePoint());
+    scheduleLsaExpiration(lsaIt, timeToExpire);
+
+    AdjLsaDiff adjLsaDiff;
+    if (lsa->getType() == Lsa::Type::ADJACENCY) {
+      adjLsaDiff = static_cast<const AdjLsa&>(*chkLsa).diff(static_cast<const AdjLsa&>(*lsa));
+    }
 
     auto [updated, namesToAdd, namesToRemove] = chkLsa->update(lsa);
     if (updated) {
-      onLsdbModified(lsa, LsdbUpdate::UPDATED, namesToAdd, namesToRemove);
+      updateRouterMap(*chkLsa, LsdbUpdate::UPDATED, adjLsaDiff);
+      if (isRemote && m_tracer != nullptr) {
+        m_tracer->record(ConvergenceStage::LSA_INSTALL);
+      }
+      onLsdbModified(lsa, LsdbUpdate::UPDATED, namesToAdd, namesToRemove, adjLsaDiff);
+      if (isRemote && lsa->getType() == Lsa::Type::NAME &&
+          (coversAggregatedPrefix(namesToAdd) || coversAggregatedPrefix(namesToRemove))) {
+        NLSR_LOG_DEBUG(lsa->getOriginRouter() << " changed some of our aggregated prefixes");
+        scheduleNameLsaBuild();
+      }
     }
 
-    chkLsa->setExpiringEventId(scheduleLsaExpiration(chkLsa, timeToExpire));
     NLSR_LOG_DEBUG("Updated LSA:\n" << *chkLsa);
+    return updated;
+  }
+  return false;
+}
+
+void
+Lsdb::beginModification()
+{
+  ++m_version;
+  m_snapshot.reset();
+}
+
+std::shared_ptr<Lsa>
+Lsdb::makeWritable(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt)
+{
+  if (lsaIt->use_count() == 1) {
+    return *lsaIt;
+  }
+
+  std::shared_ptr<Lsa> copy;
+  switch ((*lsaIt)->getType()) {
+    case Lsa::Type::ADJACENCY:
+      copy = std::make_shared<AdjLsa>(static_cast<const AdjLsa&>(**lsaIt));
+      break;
+    case Lsa::Type::COORDINATE:
+      copy = std::make_shared<CoordinateLsa>(static_cast<const CoordinateLsa&>(**lsaIt));
+      break;
+    case Lsa::Type::NAME:
+      copy = std::make_shared<NameLsa>(static_cast<const NameLsa&>(**lsaIt));
+      break;
+    default:
+      return *lsaIt;
+  }
+  m_lsdb.get<byName>().replace(lsaIt, copy);
+  return copy;
+}
+
+std::shared_ptr<const LsdbSnapshot>
+Lsdb::getSnapshot() const
+{
+  if (m_snapshot == nullptr) {
+    LsdbSnapshot::LsaLists lsas;
+    for (auto type : {Lsa::Type::ADJACENCY, Lsa::Type::COORDINATE, Lsa::Type::NAME}) {
+      auto lsaRange = m_lsdb.get<byType>().equal_range(type);
+      auto& list = lsas[static_cast<size_t>(type)];
+      list.assign(lsaRange.first, lsaRange.second);
+    }
+    m_snapshot = std::make_shared<LsdbSnapshot>(m_version, std::move(lsas));
   }
+  return m_snapshot;
+}
+
+void
+Lsdb::reportMemory(MemoryStatus& status) const
+{
+  MemoryUsage lsdb;
+  for (const auto& lsa : m_lsdb) {
+    ++lsdb.nElements;
+    // the pointer in each of the two hashed indices and the ordered index
+    lsdb.nBytes += sizeof(lsa) + 2 * HASH_NODE_OVERHEAD + TREE_NODE_OVERHEAD +
+                   lsa->getCachedWireSize();
+    switch (lsa->getType()) {
+      case Lsa::Type::NAME: {
+        const auto& prefixes = static_cast<const NameLsa&>(*lsa).getNpl().getPrefixes();
+        lsdb.nBytes += sizeof(NameLsa) + prefixes.size() * sizeof(PrefixInfo);
+        for (const auto& prefix : prefixes) {
+          lsdb.nBytes += getNameMemory(prefix.getName());
+        }
+        break;
+      }
+      case Lsa::Type::ADJACENCY:
+        // neighbor names are interned, and counted once by the NameInterner
+        lsdb.nBytes += sizeof(AdjLsa) +
+                       static_cast<const AdjLsa&>(*lsa).getAdl().size() * sizeof(Adjacent);
+        break;
+      case Lsa::Type::COORDINATE:
+        lsdb.nBytes += sizeof(CoordinateLsa) +
+                       static_cast<const CoordinateLsa&>(*lsa).getTheta().size() * sizeof(double);
+        break;
+      default:
+        break;
+    }
+  }
+  status.addComponent("lsdb", lsdb);
+
+  status.addComponent("lsa-segments", {m_lsaStorage.size(), m_lsaStorage.getSizeInBytes()});
+
+  MemoryUsage highestSeqNo;
+  for (const auto& entry : m_highestSeqNo) {
+    ++highestSeqNo.nElements;
+    highestSeqNo.nBytes += HASH_NODE_OVERHEAD + TREE_NODE_OVERHEAD + sizeof(entry) +
+                           getNameMemory(entry.lsaName);
+  }
+  status.addComponent("highest-seq-no", highestSeqNo);
 }
 
 void
@@ -352,15 +863,93 @@ Lsdb::removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt)
   if (lsaIt != m_lsdb.end()) {
     auto lsaPtr = *lsaIt;
     NLSR_LOG_DEBUG("Removing LSA:\n" << *lsaPtr);
+    beginModification();
     m_lsdb.erase(lsaIt);
-    onLsdbModified(lsaPtr, LsdbUpdate::REMOVED, {}, {});
+    // the announcements of the LSA go with it
+    ndn::Name routerLsaPrefix(m_confParam.getLsaPrefix());
+    routerLsaPrefix.append(lsaPtr->getOriginRouter().getSubName(m_confParam.getNetwork().size()));
+    auto lsaName = makeLsaUserPrefix(routerLsaPrefix, lsaPtr->getType());
+    m_highestSeqNo.erase(lsaName);
+    m_lsaArrivals.erase(lsaName);
+    updateRouterMap(*lsaPtr, LsdbUpdate::REMOVED);
+    onLsdbModified(lsaPtr, LsdbUpdate::REMOVED, {}, {}, {});
+    if (lsaPtr->getType() == Lsa::Type::NAME && lsaPtr->getOriginRouter() != m_thisRouterPrefix &&
+        coversAggregatedPrefix(static_cast<const NameLsa&>(*lsaPtr).getNpl().getPrefixes())) {
+      NLSR_LOG_DEBUG(lsaPtr->getOriginRouter() << " no longer originates our aggregated prefixes");
+      scheduleNameLsaBuild();
+    }
+  }
+}
+
+void
+Lsdb::updateRouterMap(const Lsa& lsa, LsdbUpdate updateType, const AdjLsaDiff& adjLsaDiff)
+{
+  if (lsa.getType() != Lsa::Type::ADJACENCY) {
+    return;
+  }
+
+  const auto& adjLsa = static_cast<const AdjLsa&>(lsa);
+  switch (updateType) {
+    case LsdbUpdate::INSTALLED:
+      addRouterRef(adjLsa.getOriginRouter());
+      for (const auto& adjacent : adjLsa.getAdl()) {
+        addRouterRef(adjacent.getName());
+      }
+      return;
+    case LsdbUpdate::UPDATED:
+      for (const auto& link : adjLsaDiff.added) {
+        addRouterRef(link.neighbor);
+      }
+      for (const auto& link : adjLsaDiff.removed) {
+        releaseRouterRef(link.neighbor);
+      }
+      break;
+    case LsdbUpdate::REMOVED:
+      releaseRouterRef(adjLsa.getOriginRouter());
+      for (const auto& adjacent : adjLsa.getAdl()) {
+        releaseRouterRef(adjacent.getName());
+      }
+      break;
+  }
+
+  // Routers keep their numbers after leaving, so that the remaining routers are not
+  // renumbered. Compact the registry once most of its entries are stale, keeping the order
+  // of the remaining routers.
+  if (m_routerRefs.size() * 2 < m_routerMap.size()) {
+    NLSR_LOG_DEBUG("Compacting router map from " << m_routerMap.size() <<
+                   " to " << m_routerRefs.size() << " routers");
+    NameMap liveMap;
+    for (int32_t mappingNo = 0; mappingNo < static_cast<int32_t>(m_routerMap.size()); ++mappingNo) {
+      auto router = m_routerMap.getRouterNameByMappingNo(mappingNo);
+      if (router && m_routerRefs.count(*router) > 0) {
+        liveMap.addEntry(*router);
+      }
+    }
+    m_routerMap = std::move(liveMap);
+  }
+}
+
+void
+Lsdb::addRouterRef(const ndn::Name& router)
+{
+  if (++m_routerRefs[router] == 1) {
+    m_routerMap.addEntry(router);
+  }
+}
+
+void
+Lsdb::releaseRouterRef(const ndn::Name& router)
+{
+  auto it = m_routerRefs.find(router);
+  if (it != m_routerRefs.end() && --it->second == 0) {
+    m_routerRefs.erase(it);
   }
 }
 
 void
 Lsdb::removeLsa(const ndn::Name& router, Lsa::Type lsaType)
 {
-  removeLsa(m_lsdb.get<byName>().find(std::make_tuple(router, lsaType)));
+  removeLsa(m_lsdb.get<byName>().find(LsaKey(router, lsaType)));
 }
 
 void
@@ -414,7 +1003,14 @@ Lsdb::buildAndInstallOwnAdjLsa()
                 getLsaExpirationTimePoint(),
                 m_confParam.getAdjacencyList());
   m_sequencingManager.increaseAdjLsaSeq();
-  m_sequencingManager.writeSeqNoToFile();
+  m_sequencingManager.leaseSeqNo();
+  if (m_tracer != nullptr) {
+    m_tracer->record(ConvergenceStage::ADJ_LSA_BUILD);
+  }
+
+  if (auto currentLsa = findLsa<AdjLsa>(m_thisRouterPrefix); currentLsa) {
+    m_previousOwnAdjLsa = std::make_shared<AdjLsa>(*currentLsa);
+  }
 
   //Sync adjacency LSAs if link-state or dry-run HR is enabled.
   if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_ON) {
@@ -424,11 +1020,66 @@ Lsdb::buildAndInstallOwnAdjLsa()
   installLsa(std::make_shared<AdjLsa>(adjLsa));
 }
 
-ndn::scheduler::EventId
-Lsdb::scheduleLsaExpiration(std::shared_ptr<Lsa> lsa, ndn::time::seconds expTime)
+void
+Lsdb::scheduleLsaExpiration(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt,
+                            ndn::time::seconds expTime)
+{
+  NLSR_LOG_DEBUG("Scheduling expiration in: " << expTime + GRACE_PERIOD << " for " << (*lsaIt)->getOriginRouter());
+  auto deadline = ndn::time::steady_clock::now() + expTime + GRACE_PERIOD;
+  m_lsdb.get<byName>().modify(lsaIt, [deadline] (auto& lsa) { lsa->setExpirationDeadline(deadline); });
+  scheduleExpirationSweep();
+}
+
+void
+Lsdb::scheduleExpirationSweep()
+{
+  const auto& index = m_lsdb.get<byExpiration>();
+  const auto& highestIndex = m_highestSeqNo.get<byExpiration>();
+  if (index.empty() && highestIndex.empty()) {
+    return;
+  }
+
+  auto deadline = ndn::time::steady_clock::time_point::max();
+  if (!index.empty()) {
+    deadline = (*index.begin())->getExpirationDeadline();
+  }
+  if (!highestIndex.empty()) {
+    deadline = std::min(deadline, highestIndex.begin()->expiration);
+  }
+  auto sweepTime = std::max(deadline, m_lastExpirationSweep + EXPIRATION_SWEEP_INTERVAL);
+  if (m_isExpirationSweepScheduled && m_nextExpirationSweep <= sweepTime) {
+    return;
+  }
+
+  m_isExpirationSweepScheduled = true;
+  m_nextExpirationSweep = sweepTime;
+  auto delay = std::max<ndn::time::nanoseconds>(sweepTime - ndn::time::steady_clock::now(),
+                                                 ndn::time::nanoseconds::zero());
+  m_expirationSweepEvent = m_scheduler.schedule(delay, [this] { sweepExpiredLsas(); });
+}
+
+void
+Lsdb::sweepExpiredLsas()
 {
-  NLSR_LOG_DEBUG("Scheduling expiration in: " << expTime + GRACE_PERIOD << " for " << lsa->getOriginRouter());
-  return m_scheduler.schedule(expTime + GRACE_PERIOD, [this, lsa] { expireOrRefreshLsa(lsa); });
+  m_isExpirationSweepScheduled = false;
+  auto now = ndn::time::steady_clock::now();
+  m_lastExpirationSweep = now;
+
+  // Expiring and refreshing change the index, so collect the due LSAs first
+  const auto& index = m_lsdb.get<byExpiration>();
+  std::vector<std::shared_ptr<Lsa>> dueLsas;
+  for (auto it = index.begin(); it != index.end() && (*it)->getExpirationDeadline() <= now; ++it) {
+    dueLsas.push_back(*it);
+  }
+  NLSR_LOG_DEBUG("Expiration sweep: " << dueLsas.size() << " LSAs due");
+
+  for (const auto& lsa : dueLsas) {
+    expireOrRefreshLsa(lsa);
+  }
+
+  auto& highestIndex = m_highestSeqNo.get<byExpiration>();
+  highestIndex.erase(highestIndex.begin(), highestIndex.upper_bound(now));
+  scheduleExpirationSweep();
 }
 
 void
@@ -437,30 +1088,34 @@ Lsdb::expireOrRefreshLsa(std::shared_ptr<Lsa> lsa)
   NLSR_LOG_DEBUG("ExpireOrRefreshLsa called for " << lsa->getType());
   NLSR_LOG_DEBUG("OriginRouter: " << lsa->getOriginRouter() << " Seq No: " << lsa->getSeqNo());
 
-  auto lsaIt = m_lsdb.get<byName>().find(std::make_tuple(lsa->getOriginRouter(), lsa->getType()));
+  auto lsaIt = m_lsdb.get<byName>().find(ExtractLsaKey{}(*lsa));
 
   // If this name LSA exists in the LSDB
   if (lsaIt != m_lsdb.end()) {
-    auto lsaPtr = *lsaIt;
-    NLSR_LOG_DEBUG(*lsaPtr);
-    NLSR_LOG_DEBUG("LSA Exists with seq no: " << lsaPtr->getSeqNo());
-    // If its seq no is the one we are expecting.
-    if (lsaPtr->getSeqNo() == lsa->getSeqNo()) {
-      if (lsaPtr->getOriginRouter() == m_thisRouterPrefix) {
+    NLSR_LOG_DEBUG(**lsaIt);
+    NLSR_LOG_DEBUG("LSA Exists with seq no: " << (*lsaIt)->getSeqNo());
+    // Unless it was updated since the sweep began.
+    if ((*lsaIt)->getExpirationDeadline() <= ndn::time::steady_clock::now()) {
+      if ((*lsaIt)->getOriginRouter() == m_thisRouterPrefix) {
+        beginModification();
+        auto lsaPtr = makeWritable(lsaIt);
         NLSR_LOG_DEBUG("Own " << lsaPtr->getType() << " LSA, so refreshing it");
         NLSR_LOG_DEBUG("Current LSA:\n" << *lsaPtr);
+        if (lsaPtr->getType() == Lsa::Type::ADJACENCY) {
+          m_previousOwnAdjLsa = std::make_shared<AdjLsa>(static_cast<const AdjLsa&>(*lsaPtr));
+        }
         lsaPtr->setSeqNo(lsaPtr->getSeqNo() + 1);
         m_sequencingManager.setLsaSeq(lsaPtr->getSeqNo(), lsaPtr->getType());
         lsaPtr->setExpirationTimePoint(getLsaExpirationTimePoint());
         NLSR_LOG_DEBUG("Updated LSA:\n" << *lsaPtr);
-        // schedule refreshing event again
-        lsaPtr->setExpiringEventId(scheduleLsaExpiration(lsaPtr, m_lsaRefreshTime));
-        m_sequencingManager.writeSeqNoToFile();
+        // schedule refreshing again
+        scheduleLsaExpiration(lsaIt, m_lsaRefreshTime);
+        m_sequencingManager.leaseSeqNo();
         m_sync.publishRoutingUpdate(lsaPtr->getType(), m_sequencingManager.getLsaSeq(lsaPtr->getType()));
       }
       // Since we cannot refresh other router's LSAs, our only choice is to expire.
       else {
-        NLSR_LOG_DEBUG("Other's " << lsaPtr->getType() << " LSA, so removing from LSDB");
+        NLSR_LOG_DEBUG("Other's " << (*lsaIt)->getType() << " LSA, so removing from LSDB");
         removeLsa(lsaIt);
       }
     }
@@ -471,9 +1126,6 @@ void
 Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
                       ndn::time::steady_clock::time_point deadline)
 {
-  // increment SENT_LSA_INTEREST
-  lsaIncrementSignal(Statistics::PacketType::SENT_LSA_INTEREST);
-
   if (deadline == DEFAULT_LSA_RETRIEVAL_DEADLINE) {
     deadline = ndn::time::steady_clock::now() + ndn::time::seconds(static_cast<int>(LSA_REFRESH_TIME_MAX));
   }
@@ -482,58 +1134,330 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint
   // The seq no is the last
   uint64_t seqNo = interestName[-1].toNumber();
 
-  // If the LSA is not found in the list currently.
-  if (m_highestSeqNo.find(lsaName) == m_highestSeqNo.end()) {
-    m_highestSeqNo[lsaName] = seqNo;
+  // An old LSA, superseded by the one announced since
+  if (!updateHighestSeqNo(lsaName, seqNo)) {
+    return;
+  }
+
+  if (auto fetch = m_lsaFetches.find(lsaName); fetch != m_lsaFetches.end()) {
+    if (fetch->second.fetcher != nullptr && fetch->second.seqNo == seqNo) {
+      NLSR_LOG_TRACE("Already fetching LSA: " << interestName);
+      return;
+    }
+    // superseded by the newer version, or retried right away
+    cancelLsaFetch(lsaName);
+  }
+
+  uint32_t window = m_confParam.getLsaFetchWindow();
+  bool hasWindow = window == 0 || m_nLsaFetchesInFlight < window;
+  if (hasWindow && takeFetchToken(incomingFaceId)) {
+    startLsaFetch(interestName, timeoutCount, incomingFaceId, deadline);
+    return;
+  }
+
+  auto [it, isNew] = m_pendingFetches.try_emplace(lsaName);
+  if (isNew) {
+    auto& queue = parseLsaType(lsaName[-1]) == Lsa::Type::NAME ? m_pendingNameLsaFetches :
+                                                                m_pendingRoutingLsaFetches;
+    queue.push_back(lsaName);
+  }
+  else {
+    NLSR_LOG_TRACE("Superseding queued fetch of " << lsaName << " seq " << it->second.seqNo);
+  }
+  it->second = {seqNo, timeoutCount, incomingFaceId, deadline};
+  NLSR_LOG_DEBUG("Queued fetch of LSA: " << interestName << ", queue size: "
+                 << m_pendingFetches.size());
+  if (hasWindow) {
+    scheduleRateLimitedFetches();
+  }
+}
+
+bool
+Lsdb::updateHighestSeqNo(const ndn::Name& lsaName, uint64_t seqNo)
+{
+  // no LSA lives longer from its announcement
+  auto expiration = ndn::time::steady_clock::now() +
+                    ndn::time::seconds(LSA_REFRESH_TIME_MAX) + GRACE_PERIOD;
+  auto& index = m_highestSeqNo.get<byName>();
+  auto it = index.find(lsaName);
+  if (it == index.end()) {
+    index.insert({lsaName, seqNo, expiration});
+    scheduleExpirationSweep();
+    return true;
+  }
+  if (seqNo < it->seqNo) {
+    return false;
+  }
+  index.modify(it, [&] (auto& entry) {
+    entry.seqNo = seqNo;
+    entry.expiration = expiration;
+  });
+  return true;
+}
+
+uint64_t
+Lsdb::getHighestSeqNo(const ndn::Name& lsaName) const
+{
+  auto it = m_highestSeqNo.find(lsaName);
+  return it != m_highestSeqNo.end() ? it->seqNo : 0;
+}
+
+void
+Lsdb::startPendingLsaFetches()
+{
+  uint32_t window = m_confParam.getLsaFetchWindow();
+  bool isRateLimited = false;
+  // A fetch held back by the rate of its neighbor does not hold back those through other ones
+  for (auto* queue : {&m_pendingRoutingLsaFetches, &m_pendingNameLsaFetches}) {
+    auto queueIt = queue->begin();
+    while (queueIt != queue->end() && (window == 0 || m_nLsaFetchesInFlight < window)) {
+      auto it = m_pendingFetches.find(*queueIt);
+      auto fetch = it->second;
+      uint64_t highest = getHighestSeqNo(it->first);
+      if (fetch.seqNo >= highest && !takeFetchToken(fetch.incomingFaceId)) {
+        isRateLimited = true;
+        ++queueIt;
+        continue;
+      }
+      ndn::Name interestName = ndn::Name(it->first).appendNumber(fetch.seqNo);
+      m_pendingFetches.erase(it);
+      queueIt = queue->erase(queueIt);
+      if (fetch.seqNo < highest) {
+        continue;
+      }
+      startLsaFetch(interestName, fetch.timeoutCount, fetch.incomingFaceId, fetch.deadline);
+    }
+  }
+
+  if (isRateLimited) {
+    scheduleRateLimitedFetches();
+  }
+}
+
+bool
+Lsdb::takeFetchToken(uint64_t incomingFaceId)
+{
+  uint32_t rate = m_confParam.getLsaFetchRate();
+  if (rate == 0) {
+    return true;
+  }
+
+  auto now = ndn::time::steady_clock::now();
+  auto [it, isNew] = m_fetchTokens.try_emplace(incomingFaceId);
+  auto& bucket = it->second;
+  if (isNew) {
+    bucket.tokens = rate;
+  }
+  else {
+    auto elapsed = ndn::time::duration_cast<ndn::time::microseconds>(now - bucket.lastRefill);
+    bucket.tokens = std::min<double>(rate, bucket.tokens + elapsed.count() * rate / 1e6);
+  }
+  bucket.lastRefill = now;
+
+  if (bucket.tokens < 1) {
+    NLSR_LOG_TRACE("No LSA fetch token for face " << incomingFaceId);
+    return false;
+  }
+  bucket.tokens -= 1;
+  return true;
+}
+
+void
+Lsdb::scheduleRateLimitedFetches()
+{
+  if (!m_rateLimitedFetchEvent) {
+    // Every bucket has gained a token by then
+    auto interval = ndn::time::microseconds(1000000 / m_confParam.getLsaFetchRate());
+    m_rateLimitedFetchEvent = m_scheduler.schedule(interval, [this] { startPendingLsaFetches(); });
+  }
+}
+
+void
+Lsdb::seedFetcherOptions(ndn::SegmentFetcher::Options& options, uint64_t incomingFaceId) const
+{
+  if (m_linkCostManager == nullptr) {
+    return;
   }
-  // If the new seq no is higher, that means the LSA is valid
-  else if (seqNo > m_highestSeqNo[lsaName]) {
-    m_highestSeqNo[lsaName] = seqNo;
+  auto& adjacencyList = m_confParam.getAdjacencyList();
+  auto adjacent = adjacencyList.findAdjacent(incomingFaceId);
+  if (adjacent == adjacencyList.end()) {
+    return;
   }
-  // Otherwise, its an old/invalid LSA
-  else if (seqNo < m_highestSeqNo[lsaName]) {
+  const auto* rtt = m_linkCostManager->getRttEstimator(adjacent->getName());
+  if (rtt == nullptr || !rtt->hasSamples()) {
     return;
   }
 
-  ndn::Interest interest(interestName);
+  auto& rttOptions = options.rttOptions;
+  ndn::time::nanoseconds rto = rtt->getSrtt() + rttOptions.k * rtt->getRttVar();
+  rttOptions.initialRto = std::clamp(rto, rttOptions.minRto, rttOptions.maxRto);
+
+  double loss = m_linkCostManager->getPacketLoss(adjacent->getName()).value_or(0.0);
+  if (loss < LSA_FETCH_LOSSY_LINK) {
+    options.initCwnd = LSA_FETCH_INIT_CWND;
+  }
+  else {
+    options.initCwnd = 1.0;
+    options.initSsthresh = 1.0;
+  }
+  NLSR_LOG_TRACE("Fetching through " << adjacent->getName() << " with initial RTO "
+                 << ndn::time::duration_cast<ndn::time::milliseconds>(rttOptions.initialRto)
+                 << " and window " << options.initCwnd);
+}
+
+void
+Lsdb::startLsaFetch(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
+                    ndn::time::steady_clock::time_point deadline)
+{
+  // increment SENT_LSA_INTEREST
+  countPacket(Statistics::PacketType::SENT_LSA_INTEREST);
+
+  ndn::Name lsaName = interestName.getPrefix(-1);
+  uint64_t seqNo = interestName[-1].toNumber();
+
+  // Retries always fetch the full LSA
+  ndn::Name fetchName = interestName;
+  if (timeoutCount == 0 && canFetchAdjLsaDelta(interestName)) {
+    fetchName = lsaName.getPrefix(-1).append(ADJ_LSA_DELTA_COMPONENT).appendNumber(seqNo);
+  }
+
+  ndn::Interest interest(fetchName);
   if (incomingFaceId != 0) {
     interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(incomingFaceId));
   }
   ndn::SegmentFetcher::Options options;
   options.interestLifetime = m_confParam.getLsaInterestLifetime();
   options.maxTimeout = m_confParam.getLsaInterestLifetime();
+  if (incomingFaceId != 0) {
+    seedFetcherOptions(options, incomingFaceId);
+  }
 
-  NLSR_LOG_DEBUG("Fetching Data for LSA: " << interestName << " Seq number: " << seqNo);
-  auto fetcher = ndn::SegmentFetcher::start(m_face, interest, m_confParam.getValidator(), options);
+  NLSR_LOG_DEBUG("Fetching Data for LSA: " << fetchName << " Seq number: " << seqNo);
+  cancelLsaFetch(lsaName);
+  LsaFetch* fetch = &m_lsaFetches[lsaName];
+  fetch->seqNo = seqNo;
+  fetch->fetcher = ndn::SegmentFetcher::start(m_face, interest, m_confParam.getValidator(),
+                                              options);
+  fetch->startTime = ndn::time::steady_clock::now();
+  ++m_nLsaFetchesInFlight;
+
+  // Each segment Interest is counted against the neighbor whose Face answered it, or against
+  // the Face the fetch is pinned to when it was not answered. The Interests of the segments
+  // are about the size of the first one.
+  auto messageClass = timeoutCount == 0 ? ControlTraffic::MessageClass::LSA_FETCH
+                                        : ControlTraffic::MessageClass::LSA_RETRANSMISSION;
+  auto countUnanswered = [this, interest, messageClass, incomingFaceId] {
+    auto& adjacencyList = m_confParam.getAdjacencyList();
+    if (auto* traffic = adjacencyList.findControlTraffic(incomingFaceId); traffic != nullptr) {
+      traffic->countInterestSent(messageClass, interest);
+    }
+  };
+  fetch->fetcher->afterSegmentTimedOut.connect(countUnanswered);
+  fetch->fetcher->afterSegmentNacked.connect(countUnanswered);
+
+  // A cancelled fetcher emits no more signals, so the fetch outlives them.
+  fetch->fetcher->afterSegmentReceived.connect(
+    [this, fetch, interest, messageClass] (const ndn::Data& data) {
+      auto& adjacencyList = m_confParam.getAdjacencyList();
+      if (auto* traffic = adjacencyList.findControlTraffic(getIncomingFaceId(data));
+          traffic != nullptr) {
+        traffic->countInterestSent(messageClass, interest);
+        traffic->countDataReceived(messageClass, data);
+      }
+      if (m_latency != nullptr) {
+        fetch->segmentArrivals.emplace(data.getName(), ndn::time::steady_clock::now());
+      }
+    });
 
-  auto it = m_fetchers.insert(fetcher).first;
+  fetch->fetcher->afterSegmentValidated.connect([this, fetch] (const ndn::Data& data) {
+    auto arrival = fetch->segmentArrivals.find(data.getName());
+    if (arrival != fetch->segmentArrivals.end()) {
+      if (m_latency != nullptr) {
+        m_latency->record(LatencyStatistics::STAGE_VALIDATE_SEGMENT,
+                          ndn::time::steady_clock::now() - arrival->second);
+      }
+      fetch->segmentArrivals.erase(arrival);
+    }
 
-  fetcher->afterSegmentValidated.connect([this] (const ndn::Data& data) {
     // Nlsr class subscribes to this to fetch certificates
     afterSegmentValidatedSignal(data);
 
-    // If we don't do this IMS throws: std::bad_weak_ptr: bad_weak_ptr
-    auto lsaSegment = std::make_shared<const ndn::Data>(data);
-    m_lsaStorage.insert(*lsaSegment);
+    m_confParam.getValidator().cacheValidated(data);
+    m_lsaStorage.insert(data);
     // Schedule deletion of the segment
     m_scheduler.schedule(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT),
-                         [this, name = lsaSegment->getName()] { m_lsaStorage.erase(name); });
+                         [this, name = data.getName()] { m_lsaStorage.erase(name); });
   });
 
-  fetcher->onComplete.connect([=] (const ndn::ConstBufferPtr& bufferPtr) {
+  fetch->fetcher->onComplete.connect([=] (const ndn::ConstBufferPtr& bufferPtr) {
+    if (m_latency != nullptr) {
+      recordFetchLatency(parseLsaType(interestName[-2]),
+                         ndn::time::steady_clock::now() - fetch->startTime);
+    }
+    // before the LSA is processed, which may fetch it again in full
+    cancelLsaFetch(lsaName);
     m_lsaStorage.erase(ndn::Name(lsaName).appendNumber(seqNo - 1));
-    afterFetchLsa(bufferPtr, interestName);
-    m_fetchers.erase(it);
+    afterFetchLsa(bufferPtr, fetchName);
+    startPendingLsaFetches();
   });
 
-  fetcher->onError.connect([=] (uint32_t errorCode, const std::string& msg) {
+  fetch->fetcher->onError.connect([=] (uint32_t errorCode, const std::string& msg) {
     onFetchLsaError(errorCode, msg, interestName, timeoutCount, deadline, lsaName, seqNo);
-    m_fetchers.erase(it);
+    startPendingLsaFetches();
   });
 
-  Lsa::Type lsaType;
-  std::istringstream(interestName[-2].toUri()) >> lsaType;
-  incrementInterestSentStats(lsaType);
+  incrementInterestSentStats(parseLsaType(interestName[-2]));
+}
+
+void
+Lsdb::cancelLsaFetch(const ndn::Name& lsaName)
+{
+  auto fetch = m_lsaFetches.find(lsaName);
+  if (fetch == m_lsaFetches.end()) {
+    return;
+  }
+  if (fetch->second.fetcher != nullptr) {
+    NLSR_LOG_TRACE("Ending fetch of " << lsaName << " seq " << fetch->second.seqNo);
+    fetch->second.fetcher->stop();
+    --m_nLsaFetchesInFlight;
+  }
+  m_lsaFetches.erase(fetch);
+}
+
+void
+Lsdb::recordFetchLatency(Lsa::Type type, ndn::time::nanoseconds duration)
+{
+  switch (type) {
+    case Lsa::Type::NAME:
+      m_latency->record(LatencyStatistics::STAGE_FETCH_NAME_LSA, duration);
+      break;
+    case Lsa::Type::ADJACENCY:
+      m_latency->record(LatencyStatistics::STAGE_FETCH_ADJACENCY_LSA, duration);
+      break;
+    case Lsa::Type::COORDINATE:
+      m_latency->record(LatencyStatistics::STAGE_FETCH_COORDINATE_LSA, duration);
+      break;
+    case Lsa::Type::BASE:
+      break;
+  }
+}
+
+bool
+Lsdb::canFetchAdjLsaDelta(const ndn::Name& interestName) const
+{
+  if (!m_confParam.getAdjLsaDelta() || parseLsaType(interestName[-2]) != Lsa::Type::ADJACENCY) {
+    return false;
+  }
+
+  int32_t lsaPosition = util::getNameComponentPosition(interestName, util::LSA_COMPONENT);
+  if (lsaPosition < 0) {
+    return false;
+  }
+  ndn::Name originRouter = m_confParam.getNetwork();
+  originRouter.append(interestName.getSubName(lsaPosition + 1,
+                                              interestName.size() - lsaPosition - 3));
+  auto lsa = findLsa<AdjLsa>(originRouter);
+  return lsa != nullptr && lsa->getSeqNo() + 1 == interestName[-1].toNumber();
 }
 
 void
@@ -544,19 +1468,28 @@ Lsdb::onFetchLsaError(uint32_t errorCode, const std::string& msg, const ndn::Nam
   NLSR_LOG_DEBUG("Failed to fetch LSA: " << lsaName << ", Error code: " << errorCode
                  << ", Message: " << msg);
 
+  auto fetch = m_lsaFetches.find(lsaName);
+  if (fetch == m_lsaFetches.end() || fetch->second.seqNo != seqNo) {
+    // superseded by a newer version of the LSA
+    return;
+  }
+  cancelLsaFetch(lsaName);
+
   if (ndn::time::steady_clock::now() < deadline) {
-    auto it = m_highestSeqNo.find(lsaName);
-    if (it != m_highestSeqNo.end() && it->second == seqNo) {
-      // If the SegmentFetcher failed due to an Interest timeout, it is safe to re-express
-      // immediately since at the least the LSA Interest lifetime has elapsed.
-      // Otherwise, it is necessary to delay the Interest re-expression to prevent
-      // the potential for constant Interest flooding.
-      auto delay = m_confParam.getLsaInterestLifetime();
-      if (errorCode == ndn::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT) {
-        delay = 0_s;
-      }
-      m_scheduler.schedule(delay, std::bind(&Lsdb::expressInterest, this, interestName,
-                                            retransmitNo + 1, /*Multicast FaceID*/0, deadline));
+    if (getHighestSeqNo(lsaName) == seqNo) {
+      // Back off exponentially from the LSA Interest lifetime, with full jitter so that the
+      // routers which failed together, as after a cold start, do not retry together.
+      auto maxDelay = ndn::time::duration_cast<ndn::time::milliseconds>(
+                        m_confParam.getLsaInterestLifetime()) *
+                      (1 << std::min(retransmitNo, LSA_FETCH_RETRY_BACKOFF_MAX_EXPONENT));
+      auto delay = ndn::time::milliseconds(ndn::random::generateWord64() %
+                                           (static_cast<uint64_t>(maxDelay.count()) + 1));
+      NLSR_LOG_TRACE("Retrying fetch of " << lsaName << " in " << delay);
+      auto& retry = m_lsaFetches[lsaName];
+      retry.seqNo = seqNo;
+      retry.retryEvent = m_scheduler.schedule(delay, [=] {
+        expressInterest(interestName, retransmitNo + 1, /*Multicast FaceID*/0, deadline);
+      });
     }
   }
 }
@@ -565,24 +1498,21 @@ void
 Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& interestName)
 {
   NLSR_LOG_DEBUG("Received data for LSA interest: " << interestName);
-  lsaIncrementSignal(Statistics::PacketType::RCV_LSA_DATA);
+  countPacket(Statistics::PacketType::RCV_LSA_DATA);
+
+  if (interestName[-2] == ADJ_LSA_DELTA_COMPONENT) {
+    afterFetchAdjLsaDelta(bufferPtr, interestName);
+    return;
+  }
 
   ndn::Name lsaName = interestName.getSubName(0, interestName.size()-1);
   uint64_t seqNo = interestName[-1].toNumber();
 
-  if (m_highestSeqNo.find(lsaName) == m_highestSeqNo.end()) {
-    m_highestSeqNo[lsaName] = seqNo;
-  }
-  else if (seqNo > m_highestSeqNo[lsaName]) {
-    m_highestSeqNo[lsaName] = seqNo;
-    NLSR_LOG_TRACE("SeqNo for LSA(name): " << interestName << " updated");
-  }
-  else if (seqNo < m_highestSeqNo[lsaName]) {
+  if (!updateHighestSeqNo(lsaName, seqNo)) {
     return;
   }
 
-  std::string chkString("LSA");
-  int32_t lsaPosition = util::getNameComponentPosition(interestName, chkString);
+  int32_t lsaPosition = util::getNameComponentPosition(interestName, util::LSA_COMPONENT);
 
   if (lsaPosition >= 0) {
     // Extracts the prefix of the originating router from the data.
@@ -590,32 +1520,44 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
     originRouter.append(interestName.getSubName(lsaPosition + 1,
                                                 interestName.size() - lsaPosition - 3));
     try {
-      Lsa::Type interestedLsType;
-      std::istringstream(interestName[-2].toUri()) >> interestedLsType;
+      Lsa::Type interestedLsType = parseLsaType(interestName[-2]);
 
       if (interestedLsType == Lsa::Type::BASE) {
         NLSR_LOG_WARN("Received unrecognized LSA Type: " << interestName[-2].toUri());
         return;
       }
 
-      ndn::Block block(bufferPtr);
       if (interestedLsType == Lsa::Type::NAME) {
-        lsaIncrementSignal(Statistics::PacketType::RCV_NAME_LSA_DATA);
-        if (isLsaNew(originRouter, interestedLsType, seqNo)) {
-          installLsa(std::make_shared<NameLsa>(block));
-        }
+        countPacket(Statistics::PacketType::RCV_NAME_LSA_DATA);
       }
       else if (interestedLsType == Lsa::Type::ADJACENCY) {
-        lsaIncrementSignal(Statistics::PacketType::RCV_ADJ_LSA_DATA);
-        if (isLsaNew(originRouter, interestedLsType, seqNo)) {
-          installLsa(std::make_shared<AdjLsa>(block));
-        }
+        countPacket(Statistics::PacketType::RCV_ADJ_LSA_DATA);
       }
       else if (interestedLsType == Lsa::Type::COORDINATE) {
-        lsaIncrementSignal(Statistics::PacketType::RCV_COORD_LSA_DATA);
-        if (isLsaNew(originRouter, interestedLsType, seqNo)) {
-          installLsa(std::make_shared<CoordinateLsa>(block));
-        }
+        countPacket(Statistics::PacketType::RCV_COORD_LSA_DATA);
+      }
+
+      // The block and the decoded LSA share the fetched buffer. Only the header is decoded
+      // until the LSA turns out to be new.
+      ndn::Block block(bufferPtr);
+      LsaHeader header(block);
+      if (header.getType() != interestedLsType) {
+        NLSR_LOG_WARN("Received " << header.getType() << " LSA for " << interestName);
+        return;
+      }
+      if (!isLsaNew(header.getOriginRouter(), header.getType(), header.getSeqNo())) {
+        NLSR_LOG_TRACE("Fetched LSA " << interestName << " is not new");
+        return;
+      }
+
+      if (interestedLsType == Lsa::Type::NAME) {
+        installFetchedLsa(std::make_shared<NameLsa>(block), interestName);
+      }
+      else if (interestedLsType == Lsa::Type::ADJACENCY) {
+        installFetchedLsa(std::make_shared<AdjLsa>(block), interestName);
+      }
+      else {
+        installFetchedLsa(std::make_shared<CoordinateLsa>(block), interestName);
       }
     }
     catch (const std::exception& e) {
@@ -624,4 +1566,257 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
   }
 }
 
+std::vector<std::shared_ptr<const ndn::Data>>
+Lsdb::getInlineLsas()
+{
+  std::vector<std::shared_ptr<const ndn::Data>> inlineLsas;
+  size_t budget = m_confParam.getSyncInlineLsaSize();
+  auto addIfFits = [&] (std::shared_ptr<const ndn::Data> data) {
+    size_t size = data->wireEncode().size();
+    if (size <= budget) {
+      budget -= size;
+      inlineLsas.push_back(std::move(data));
+    }
+  };
+
+  // Our own LSAs first, the ones needed by the routing calculation ahead of the Name LSA
+  for (auto type : {Lsa::Type::ADJACENCY, Lsa::Type::COORDINATE, Lsa::Type::NAME}) {
+    auto lsa = findLsa(m_thisRouterPrefix, type);
+    if (lsa == nullptr) {
+      continue;
+    }
+    ndn::Name lsaName = makeLsaUserPrefix(m_confParam.getSyncUserPrefix(), type);
+    lsaName.appendNumber(lsa->getSeqNo());
+    const auto& segments = getOwnLsaSegments(m_ownLsaSegments[static_cast<size_t>(type)],
+                                             lsa->getSeqNo(), lsa->wireEncode(),
+                                             ndn::Interest(lsaName));
+    if (segments.size() == 1) {
+      addIfFits(segments.front());
+    }
+  }
+
+  // Then relay the LSAs received inline that are still current
+  for (auto it = m_relayedInlineLsas.begin(); it != m_relayedInlineLsas.end();) {
+    auto lsa = findLsa(it->second.originRouter, it->second.type);
+    if (lsa == nullptr || lsa->getSeqNo() != it->second.seqNo) {
+      it = m_relayedInlineLsas.erase(it);
+      continue;
+    }
+    addIfFits(it->second.data);
+    ++it;
+  }
+  return inlineLsas;
+}
+
+void
+Lsdb::onInlineLsa(const ndn::Data& data)
+{
+  // /<network>/NLSR/LSA/<site>/%C1.Router/<router>/<lsa-type>/<seqNo>/<version>/<segment>
+  const ndn::Name& dataName = data.getName();
+  if (dataName.size() < 4 || !dataName[-1].isSegment() || !dataName[-2].isVersion() ||
+      !dataName[-3].isNumber() || data.getFinalBlock() != dataName[-1]) {
+    NLSR_LOG_TRACE("Ignoring inline data " << dataName);
+    return;
+  }
+
+  ndn::Name interestName = dataName.getPrefix(-2);
+  ndn::Name lsaName = interestName.getPrefix(-1);
+  uint64_t seqNo = interestName[-1].toNumber();
+  Lsa::Type lsaType = parseLsaType(interestName[-2]);
+  int32_t lsaPosition = util::getNameComponentPosition(interestName, util::LSA_COMPONENT);
+  if (lsaType == Lsa::Type::BASE || lsaPosition < 0) {
+    NLSR_LOG_TRACE("Ignoring inline data " << dataName);
+    return;
+  }
+  ndn::Name originRouter = m_confParam.getNetwork();
+  originRouter.append(interestName.getSubName(lsaPosition + 1,
+                                              interestName.size() - lsaPosition - 3));
+
+  // too early for lsa-min-arrival: left to the deferred fetch of the sync announcement
+  auto arrival = m_lsaArrivals.find(lsaName);
+  if (arrival != m_lsaArrivals.end() &&
+      ndn::time::steady_clock::now() < arrival->second + m_confParam.getLsaMinArrival()) {
+    NLSR_LOG_TRACE("Ignoring inline data " << dataName << " within lsa-min-arrival");
+    return;
+  }
+
+  if (originRouter == m_thisRouterPrefix || !isLsaNew(originRouter, lsaType, seqNo) ||
+      getHighestSeqNo(lsaName) > seqNo ||
+      !m_pendingInlineLsas.try_emplace(interestName, false).second) {
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Received inline data for LSA: " << interestName);
+  auto arrivalTime = ndn::time::steady_clock::now();
+  m_confParam.getValidator().validate(data,
+    [=] (const ndn::Data& validData) {
+      if (m_latency != nullptr) {
+        m_latency->record(LatencyStatistics::STAGE_VALIDATE_SEGMENT,
+                          ndn::time::steady_clock::now() - arrivalTime);
+      }
+      bool isAnnounced = m_pendingInlineLsas[interestName];
+      m_pendingInlineLsas.erase(interestName);
+      afterSegmentValidatedSignal(validData);
+      m_confParam.getValidator().cacheValidated(validData);
+      m_lsaStorage.insert(validData);
+      m_scheduler.schedule(ndn::time::seconds(LSA_REFRESH_TIME_DEFAULT),
+                           [this, name = validData.getName()] { m_lsaStorage.erase(name); });
+
+      const auto& content = validData.getContent();
+      afterFetchLsa(std::make_shared<ndn::Buffer>(content.value_begin(), content.value_end()),
+                    interestName);
+      if (auto lsa = findLsa(originRouter, lsaType); lsa != nullptr && lsa->getSeqNo() == seqNo) {
+        m_relayedInlineLsas[lsaName] = {originRouter, lsaType, seqNo,
+                                        std::make_shared<ndn::Data>(validData)};
+      }
+      else if (isAnnounced) {
+        expressInterest(interestName, 0, 0);
+      }
+    },
+    [=] (const ndn::Data&, const ndn::security::ValidationError& error) {
+      NLSR_LOG_DEBUG("Inline data for LSA " << interestName << " failed validation: " << error);
+      auto it = m_pendingInlineLsas.find(interestName);
+      if (it == m_pendingInlineLsas.end()) {
+        return;
+      }
+      bool isAnnounced = it->second;
+      m_pendingInlineLsas.erase(it);
+      if (isAnnounced) {
+        // Sync announced the LSA while it was being validated
+        expressInterest(interestName, 0, 0);
+      }
+    });
+}
+
+void
+Lsdb::afterFetchAdjLsaDelta(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& interestName)
+{
+  countPacket(Statistics::PacketType::RCV_ADJ_LSA_DATA);
+  ndn::Name fullLsaName = interestName.getPrefix(-2).append("ADJACENCY")
+                                                    .appendNumber(interestName[-1].toNumber());
+  try {
+    AdjLsaDelta delta{ndn::Block(bufferPtr)};
+    if (!isLsaNew(delta.getOriginRouter(), Lsa::Type::ADJACENCY, delta.getSeqNo())) {
+      return;
+    }
+    auto base = findLsa<AdjLsa>(delta.getOriginRouter());
+    if (delta.getBaseSeqNo() == 0 || (base != nullptr && base->getSeqNo() == delta.getBaseSeqNo())) {
+      auto lsa = std::make_shared<AdjLsa>(delta.apply(delta.getBaseSeqNo() == 0 ? nullptr :
+                                                                                  base.get()));
+      installFetchedLsa(std::move(lsa), fullLsaName);
+      return;
+    }
+    NLSR_LOG_DEBUG("Adjacency LSA delta " << interestName << " does not apply to seq "
+                   << (base != nullptr ? base->getSeqNo() : 0));
+  }
+  catch (const std::exception& e) {
+    NLSR_LOG_TRACE("LSA delta decoding error: " << e.what());
+  }
+  // A retry fetches the full LSA
+  expressInterest(fullLsaName, 1, 0);
+}
+
+void
+Lsdb::installFetchedLsa(std::shared_ptr<Lsa> lsa, const ndn::Name& lsaName)
+{
+  uint64_t traceId = 0;
+  if (m_tracer != nullptr) {
+    if (lsa->getType() == Lsa::Type::NAME) {
+      traceId = m_tracer->begin(ConvergenceStage::LSA_RECEIVED, lsaName,
+                                ConvergenceTracer::REMOTE_PREFIX_PATH);
+    }
+    // Coordinate LSAs are only used by hyperbolic routing
+    else if (lsa->getType() == Lsa::Type::ADJACENCY ||
+             m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
+      traceId = m_tracer->begin(ConvergenceStage::LSA_RECEIVED, lsaName,
+                                ConvergenceTracer::REMOTE_TOPOLOGY_PATH);
+    }
+  }
+
+  if (auto notification = m_syncNotifications.find(lsaName.getPrefix(-1));
+      notification != m_syncNotifications.end() && notification->second.seqNo <= lsa->getSeqNo()) {
+    if (m_latency != nullptr) {
+      m_latency->record(LatencyStatistics::STAGE_SYNC_TO_INSTALL,
+                        ndn::time::steady_clock::now() - notification->second.time);
+    }
+    m_syncNotifications.erase(notification);
+  }
+
+  if (!isWithinSizeBudget(*lsa)) {
+    countPacket(Statistics::PacketType::REJECTED_LSA);
+    if (traceId != 0) {
+      m_tracer->reroute(traceId, 0);
+    }
+    return;
+  }
+  if (m_confParam.getLsaMinArrival() > 0_ms) {
+    m_lsaArrivals[lsaName.getPrefix(-1)] = ndn::time::steady_clock::now();
+  }
+
+  if (!installLsa(std::move(lsa)) && traceId != 0) {
+    NLSR_LOG_TRACE("Fetched LSA " << lsaName << " did not modify the LSDB");
+    m_tracer->reroute(traceId, 0);
+  }
+}
+
+bool
+Lsdb::deferLsaFetch(const ndn::Name& lsaName, uint64_t seqNo, uint64_t incomingFaceId)
+{
+  auto minArrival = m_confParam.getLsaMinArrival();
+  auto arrival = m_lsaArrivals.find(lsaName);
+  if (minArrival <= 0_ms || arrival == m_lsaArrivals.end()) {
+    return false;
+  }
+  auto now = ndn::time::steady_clock::now();
+  auto earliest = arrival->second + minArrival;
+  if (now >= earliest) {
+    return false;
+  }
+
+  countPacket(Statistics::PacketType::DEFERRED_LSA);
+  auto [it, isNew] = m_deferredLsaFetches.try_emplace(lsaName);
+  if (!isNew && it->second.seqNo >= seqNo) {
+    return true;
+  }
+  it->second.seqNo = seqNo;
+  it->second.incomingFaceId = incomingFaceId;
+  if (isNew) {
+    NLSR_LOG_DEBUG("Deferring fetch of " << lsaName << " by " <<
+                   ndn::time::duration_cast<ndn::time::milliseconds>(earliest - now));
+    it->second.event = m_scheduler.schedule(earliest - now, [this, lsaName] {
+      auto node = m_deferredLsaFetches.extract(lsaName);
+      ndn::Name interestName(lsaName);
+      interestName.appendNumber(node.mapped().seqNo);
+      expressInterest(interestName, 0, node.mapped().incomingFaceId);
+    });
+  }
+  return true;
+}
+
+bool
+Lsdb::isWithinSizeBudget(const Lsa& lsa) const
+{
+  if (lsa.getType() == Lsa::Type::NAME && m_confParam.getLsaMaxNamePrefixes() > 0) {
+    const auto& nameLsa = static_cast<const NameLsa&>(lsa);
+    size_t nPrefixes = nameLsa.getNpl().size();
+    for (const auto& summary : nameLsa.getAreaSummaries()) {
+      nPrefixes += summary.prefixes.size();
+    }
+    if (nPrefixes > m_confParam.getLsaMaxNamePrefixes()) {
+      NLSR_LOG_WARN("Rejecting Name LSA of " << lsa.getOriginRouter() << " seq " <<
+                    lsa.getSeqNo() << " with " << nPrefixes << " name prefixes");
+      return false;
+    }
+  }
+  else if (lsa.getType() == Lsa::Type::ADJACENCY && m_confParam.getLsaMaxAdjacencies() > 0) {
+    size_t nAdjacencies = static_cast<const AdjLsa&>(lsa).getAdl().size();
+    if (nAdjacencies > m_confParam.getLsaMaxAdjacencies()) {
+      NLSR_LOG_WARN("Rejecting Adjacency LSA of " << lsa.getOriginRouter() << " seq " <<
+                    lsa.getSeqNo() << " with " << nAdjacencies << " adjacencies");
+      return false;
+    }
+  }
+  return true;
+}
+
 } // namespace nlsr
@@ -24,25 +24,37 @@
 
 #include "communication/sync-logic-handler.hpp"
 #include "conf-parameter.hpp"
+#include "convergence-tracer.hpp"
+#include "latency-statistics.hpp"
 #include "lsa/lsa.hpp"
 #include "lsa/name-lsa.hpp"
 #include "lsa/coordinate-lsa.hpp"
 #include "lsa/adj-lsa.hpp"
+#include "lsa/adj-lsa-delta.hpp"
+#include "lsa-segment-storage.hpp"
+#include "lsdb-snapshot.hpp"
+#include "memory-usage.hpp"
+#include "route/name-map.hpp"
 #include "sequencing-manager.hpp"
 #include "statistics.hpp"
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/ims/in-memory-storage-fifo.hpp>
-#include <ndn-cxx/ims/in-memory-storage-persistent.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/util/segmenter.hpp>
 #include <ndn-cxx/util/segment-fetcher.hpp>
 #include <ndn-cxx/util/signal.hpp>
 #include <ndn-cxx/util/time.hpp>
 
+#include <boost/container_hash/hash.hpp>
 #include <boost/multi_index_container.hpp>
-#include <boost/multi_index/composite_key.hpp>
 #include <boost/multi_index/hashed_index.hpp>
+#include <boost/multi_index/mem_fun.hpp>
+#include <boost/multi_index/member.hpp>
+#include <boost/multi_index/ordered_index.hpp>
+
+#include <deque>
+#include <unordered_map>
 
 namespace nlsr {
 
@@ -50,6 +62,26 @@ namespace bmi = boost::multi_index;
 
 inline constexpr ndn::time::seconds GRACE_PERIOD = 10_s;
 
+/*! \brief Minimum interval between two sweeps that expire or refresh LSAs.
+
+  LSAs whose deadlines fall within the interval after a sweep are handled together by the
+  next one, at most this much late.
+ */
+inline constexpr ndn::time::seconds EXPIRATION_SWEEP_INTERVAL = 1_s;
+
+/*! \brief Name of the file in the state directory that keeps the LSDB across restarts.
+ */
+inline constexpr char LSDB_SNAPSHOT_FILE[] = "lsdb.snapshot";
+
+/*! \brief LSA type component of the names of Adjacency LSA deltas, see AdjLsaDelta.
+
+    /<lsa-prefix>/<router>/ADJACENCY-DELTA/<seqNo> is the delta of the Adjacency LSA with
+    sequence number seqNo from the one before.
+ */
+inline const ndn::name::Component ADJ_LSA_DELTA_COMPONENT{"ADJACENCY-DELTA"};
+
+class LinkCostManager;
+
 enum class LsdbUpdate {
   INSTALLED,
   UPDATED,
@@ -68,7 +100,7 @@ public:
   bool
   doesLsaExist(const ndn::Name& router, Lsa::Type lsaType)
   {
-    return m_lsdb.get<byName>().find(std::make_tuple(router, lsaType)) != m_lsdb.end();
+    return m_lsdb.get<byName>().find(LsaKey(router, lsaType)) != m_lsdb.end();
   }
 
   /*! \brief Builds a name LSA for this router and then installs it
@@ -77,7 +109,44 @@ public:
   void
   buildAndInstallOwnNameLsa();
 
+  /*! \brief Builds a name LSA for this router after name-lsa-build-interval.
+   *
+   * Further calls until then are coalesced into that build, so that a burst of changes of
+   * the advertised name prefixes results in a single new Name LSA.
+   *
+   * \param prefix the changed name prefix, which names the convergence trace of the change
+   */
+  void
+  scheduleNameLsaBuild(const ndn::Name& prefix = {});
+
+  /*! \brief Sets the summaries that our Name LSA advertises into the areas of this area
+   *         border router, and schedules a Name LSA build if they changed.
+   *
+   * \sa AreaSummarizer
+   */
+  void
+  setAreaSummaries(std::vector<AreaSummary> summaries);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Returns the name prefixes that our Name LSA advertises, with the prefixes under
+   *         the configured aggregates replaced by the aggregates.
+   *
+   * \sa ConfParameter::addAggregatePrefix
+   */
+  NamePrefixList
+  getAdvertisedPrefixes() const;
+
+  /*! \brief Returns whether any of \p foreignPrefixes of another router decides if one of our
+   *         prefixes is aggregated, i.e. is under an aggregate and is a prefix of ours.
+   */
+  bool
+  coversAggregatedPrefix(ndn::span<const PrefixInfo> foreignPrefixes) const;
+
+  /*! \brief Returns the shortest aggregate strictly covering \p name , or nullptr.
+   */
+  const ndn::Name*
+  findAggregate(const ndn::Name& name) const;
+
   /*! \brief Builds a cor. LSA for this router and installs it into the LSDB. */
   void
   buildAndInstallOwnCoordinateLsa();
@@ -90,6 +159,74 @@ public:
   void
   writeLog() const;
 
+  /*! \brief Returns an immutable snapshot of the current LSDB.
+
+    The snapshot is shared by all readers until the LSDB changes, so the first reader after
+    a change pays for collecting the LSA pointers and the others get it in O(1). It may be
+    handed over to another thread.
+   */
+  std::shared_ptr<const LsdbSnapshot>
+  getSnapshot() const;
+
+  /*! \brief Returns the LSDB version, see LsdbSnapshot::getVersion().
+   */
+  uint64_t
+  getVersion() const
+  {
+    return m_version;
+  }
+
+  /*! \brief Writes the LSAs of other routers to the snapshot file in the state directory.
+
+    The LSAs are written as the TLV blocks they were fetched in, into a temporary file that
+    then replaces the previous one, so a crash never leaves a partial file behind. Nothing is
+    written if the LSDB did not change since the last write, or if lsdb-snapshot-interval is 0.
+   */
+  void
+  writeSnapshotFile();
+
+  /*! \brief Installs the unexpired LSAs of the snapshot file in the state directory.
+
+    This lets a restarted router calculate routes from the LSDB of its previous run before
+    sync has caught up. The LSAs keep their recorded sequence numbers and expiration times,
+    so sync supersedes each one that its origin has replaced since, and the others expire as
+    usual. This router's own LSAs are never loaded.
+    \return the number of installed LSAs
+   */
+  size_t
+  loadSnapshotFile();
+
+  /*! \brief Returns the number of LSA fetches that wait for a slot in the fetch window.
+   */
+  size_t
+  getLsaFetchQueueSize() const
+  {
+    return m_pendingFetches.size();
+  }
+
+  /*! \brief Returns the number of LSAs that are being fetched.
+   */
+  size_t
+  getLsaFetchesInFlight() const
+  {
+    return m_nLsaFetchesInFlight;
+  }
+
+  /*! \brief Returns the number of segments of the current version of our own LSA of type
+   *         \p type , or 0 if it was not fetched yet.
+   */
+  size_t
+  getOwnLsaSegmentCount(Lsa::Type type) const
+  {
+    return m_ownLsaSegments[static_cast<size_t>(type)].segments.size();
+  }
+
+  /*! \brief Adds the memory of the LSDB, of the LSA segments kept to answer Interests and of
+   *         the highest sequence numbers to \p status.
+   */
+  void
+  reportMemory(MemoryStatus& status) const;
+
   /* \brief Process interest which can be either:
    * 1) Discovery interest from segment fetcher:
    *    /localhop/<network>/nlsr/LSA/<site>/<router>/<lsaType>/<seqNo>
@@ -105,12 +242,62 @@ public:
     return m_isBuildAdjLsaScheduled;
   }
 
+  /*! \brief Count the LSA packets in \p stats; nullptr to stop counting them.
+   */
+  void
+  setStatistics(Statistics* stats)
+  {
+    m_stats = stats;
+  }
+
+  /*! \brief Trace the LSA builds, publications and installations in \p tracer , and begin a
+   *         trace for each fetched LSA and prefix change; nullptr to stop tracing.
+   */
+  void
+  setConvergenceTracer(ConvergenceTracer* tracer)
+  {
+    m_tracer = tracer;
+  }
+
+  /*! \brief Record the latencies of LSA fetches, segment validations and installations in
+   *         \p latency ; nullptr to stop recording them.
+   */
+  void
+  setLatencyStatistics(LatencyStatistics* latency)
+  {
+    m_latency = latency;
+  }
+
+  /*! \brief Seed the congestion control of LSA fetches from the RTT and loss that
+   *         \p linkCostManager measured toward the neighbor they are sent to; nullptr to start
+   *         every fetch from the defaults.
+   */
+  void
+  setLinkCostManager(const LinkCostManager* linkCostManager)
+  {
+    m_linkCostManager = linkCostManager;
+  }
+
+  /*! \brief Returns the io_context on which the LSDB and its signals run.
+   */
+  boost::asio::io_context&
+  getIoContext() const
+  {
+    return m_face.getIoContext();
+  }
+
   SyncLogicHandler&
   getSync()
   {
     return m_sync;
   }
 
+  const SyncLogicHandler&
+  getSync() const
+  {
+    return m_sync;
+  }
+
   template<typename T>
   std::shared_ptr<T>
   findLsa(const ndn::Name& router) const
@@ -118,21 +305,66 @@ public:
     return std::static_pointer_cast<T>(findLsa(router, T::type()));
   }
 
-  struct ExtractOriginRouter
+  /*! \brief Key of the byName index: origin router and LSA type.
+
+    Refers to the origin router rather than copying it, and carries its hash, so that a lookup
+    hashes the name once and the LSAs in the container are never rehashed, see
+    Lsa::getOriginRouterHash().
+   */
+  struct LsaKey
+  {
+    LsaKey(const ndn::Name& router, Lsa::Type type)
+      : LsaKey(router, type, std::hash<ndn::Name>{}(router))
+    {
+    }
+
+    LsaKey(const ndn::Name& router, Lsa::Type type, size_t routerHash)
+      : router(&router)
+      , type(type)
+      , routerHash(routerHash)
+    {
+    }
+
+    const ndn::Name* router;
+    Lsa::Type type;
+    size_t routerHash;
+  };
+
+  struct ExtractLsaKey
   {
-    using result_type = ndn::Name;
+    using result_type = LsaKey;
 
-    ndn::Name
+    LsaKey
     operator()(const Lsa& lsa) const
     {
-      return lsa.getOriginRouter();
+      return {lsa.getOriginRouter(), lsa.getType(), lsa.getOriginRouterHash()};
+    }
+
+    LsaKey
+    operator()(const std::shared_ptr<Lsa>& lsa) const
+    {
+      return (*this)(*lsa);
     }
   };
 
-  struct name_hash {
-    int
-    operator()(const ndn::Name& name) const {
-      return std::hash<ndn::Name>{}(name);
+  struct LsaKeyHash
+  {
+    size_t
+    operator()(const LsaKey& key) const
+    {
+      size_t seed = key.routerHash;
+      boost::hash_combine(seed, static_cast<int>(key.type));
+      return seed;
+    }
+  };
+
+  struct LsaKeyEqual
+  {
+    bool
+    operator()(const LsaKey& lhs, const LsaKey& rhs) const
+    {
+      return lhs.type == rhs.type && lhs.routerHash == rhs.routerHash &&
+             *lhs.router == *rhs.router;
     }
   };
 
@@ -146,27 +378,42 @@ public:
 
   struct byName{};
   struct byType{};
+  struct byExpiration{};
 
   using LsaContainer = boost::multi_index_container<
     std::shared_ptr<Lsa>,
     bmi::indexed_by<
       bmi::hashed_unique<
         bmi::tag<byName>,
-        bmi::composite_key<
-          Lsa,
-          ExtractOriginRouter,
-          bmi::const_mem_fun<Lsa, Lsa::Type, &Lsa::getType>
-        >,
-        bmi::composite_key_hash<name_hash, enum_class_hash>
+        ExtractLsaKey,
+        LsaKeyHash,
+        LsaKeyEqual
       >,
       bmi::hashed_non_unique<
         bmi::tag<byType>,
         bmi::const_mem_fun<Lsa, Lsa::Type, &Lsa::getType>,
         enum_class_hash
+      >,
+      bmi::ordered_non_unique<
+        bmi::tag<byExpiration>,
+        bmi::const_mem_fun<Lsa, ndn::time::steady_clock::time_point, &Lsa::getExpirationDeadline>
       >
     >
   >;
 
+  /*! \brief Returns the mapping numbers of the routers known from Adjacency LSAs.
+
+    The registry is updated as Adjacency LSAs are installed, updated and removed, before
+    onLsdbModified is emitted. A router keeps its mapping number across routing calculations;
+    numbers of routers that left the LSDB are reclaimed only when they make up more than half
+    of the registry, at which point all routers are renumbered.
+   */
+  const NameMap&
+  getRouterMap() const
+  {
+    return m_routerMap;
+  }
+
   template<typename T>
   std::pair<LsaContainer::index<Lsdb::byType>::type::iterator,
             LsaContainer::index<Lsdb::byType>::type::iterator>
@@ -179,21 +426,29 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::shared_ptr<Lsa>
   findLsa(const ndn::Name& router, Lsa::Type lsaType) const
   {
-    auto it = m_lsdb.get<byName>().find(std::make_tuple(router, lsaType));
+    auto it = m_lsdb.get<byName>().find(LsaKey(router, lsaType));
     return it != m_lsdb.end() ? *it : nullptr;
   }
 
+  void
+  countPacket(Statistics::PacketType type)
+  {
+    if (m_stats != nullptr) {
+      m_stats->increment(type);
+    }
+  }
+
   void
   incrementDataSentStats(Lsa::Type lsaType)
   {
     if (lsaType == Lsa::Type::NAME) {
-      lsaIncrementSignal(Statistics::PacketType::SENT_NAME_LSA_DATA);
+      countPacket(Statistics::PacketType::SENT_NAME_LSA_DATA);
     }
     else if (lsaType == Lsa::Type::ADJACENCY) {
-      lsaIncrementSignal(Statistics::PacketType::SENT_ADJ_LSA_DATA);
+      countPacket(Statistics::PacketType::SENT_ADJ_LSA_DATA);
     }
     else if (lsaType == Lsa::Type::COORDINATE) {
-      lsaIncrementSignal(Statistics::PacketType::SENT_COORD_LSA_DATA);
+      countPacket(Statistics::PacketType::SENT_COORD_LSA_DATA);
     }
   }
 
@@ -201,13 +456,13 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   incrementInterestRcvdStats(Lsa::Type lsaType)
   {
     if (lsaType == Lsa::Type::NAME) {
-      lsaIncrementSignal(Statistics::PacketType::RCV_NAME_LSA_INTEREST);
+      countPacket(Statistics::PacketType::RCV_NAME_LSA_INTEREST);
     }
     else if (lsaType == Lsa::Type::ADJACENCY) {
-      lsaIncrementSignal(Statistics::PacketType::RCV_ADJ_LSA_INTEREST);
+      countPacket(Statistics::PacketType::RCV_ADJ_LSA_INTEREST);
     }
     else if (lsaType == Lsa::Type::COORDINATE) {
-      lsaIncrementSignal(Statistics::PacketType::RCV_COORD_LSA_INTEREST);
+      countPacket(Statistics::PacketType::RCV_COORD_LSA_INTEREST);
     }
   }
 
@@ -215,13 +470,13 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   incrementInterestSentStats(Lsa::Type lsaType)
   {
     if (lsaType == Lsa::Type::NAME) {
-      lsaIncrementSignal(Statistics::PacketType::SENT_NAME_LSA_INTEREST);
+      countPacket(Statistics::PacketType::SENT_NAME_LSA_INTEREST);
     }
     else if (lsaType == Lsa::Type::ADJACENCY) {
-      lsaIncrementSignal(Statistics::PacketType::SENT_ADJ_LSA_INTEREST);
+      countPacket(Statistics::PacketType::SENT_ADJ_LSA_INTEREST);
     }
     else if (lsaType == Lsa::Type::COORDINATE) {
-      lsaIncrementSignal(Statistics::PacketType::SENT_COORD_LSA_INTEREST);
+      countPacket(Statistics::PacketType::SENT_COORD_LSA_INTEREST);
     }
   }
 
@@ -238,7 +493,10 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
     return lsaPtr ? lsaPtr->getSeqNo() < seqNo : true;
   }
 
-  void
+  /*! \brief Add a new LSA, or update the LSA it supersedes.
+    \return whether the LSDB was modified
+  */
+  bool
   installLsa(std::shared_ptr<Lsa> lsa);
 
   /*! \brief Remove a name LSA from the LSDB.
@@ -255,6 +513,19 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt);
 
+  /*! \brief Updates the router registry after an LSA was installed, updated or removed.
+
+    \param adjLsaDiff the changed links of an updated Adjacency LSA
+   */
+  void
+  updateRouterMap(const Lsa& lsa, LsdbUpdate updateType, const AdjLsaDiff& adjLsaDiff = {});
+
+  void
+  addRouterRef(const ndn::Name& router);
+
+  void
+  releaseRouterRef(const ndn::Name& router);
+
   /*! \brief Attempts to construct an adj. LSA.
 
     This function will attempt to construct an adjacency LSA. An LSA
@@ -269,31 +540,159 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   buildAndInstallOwnAdjLsa();
 
-  /*! \brief Schedules a refresh/expire event in the scheduler.
-    \param lsa The LSA.
-    \param expTime How many seconds to wait before triggering the event.
+  /*! \brief Sets when an installed LSA is to be refreshed or expired.
+    \param lsaIt The LSA.
+    \param expTime How many seconds to wait, before the grace period.
+   */
+  void
+  scheduleLsaExpiration(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt,
+                        ndn::time::seconds expTime);
+
+  /*! \brief Schedules the expiration sweep for the earliest deadline in the LSDB.
+
+    Sweeps are at least EXPIRATION_SWEEP_INTERVAL apart. A pending sweep is moved only if
+    an earlier one is needed.
    */
-  ndn::scheduler::EventId
-  scheduleLsaExpiration(std::shared_ptr<Lsa> lsa, ndn::time::seconds expTime);
+  void
+  scheduleExpirationSweep();
+
+  void
+  scheduleSnapshotFileWrite();
+
+  /*! \brief Expires or refreshes all LSAs whose deadline has passed.
+   */
+  void
+  sweepExpiredLsas();
 
-  /*! \brief Either allow to expire, or refresh a name LSA.
+  /*! \brief Either allow to expire, or refresh an LSA.
     \param lsa The LSA.
   */
   void
   expireOrRefreshLsa(std::shared_ptr<Lsa> lsa);
 
+  /*! \brief Starts a new LSDB version, before an LSA is installed, changed or removed.
+   */
+  void
+  beginModification();
+
+  /*! \brief Returns the LSA at \p lsaIt , ready to be modified.
+
+    An LSA also held by a snapshot is replaced with a copy first, which is returned.
+    Must follow beginModification(), so that the cached snapshot does not hold the LSA.
+   */
+  std::shared_ptr<Lsa>
+  makeWritable(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt);
+
   bool
   processInterestForLsa(const ndn::Interest& interest, const ndn::Name& originRouter,
                         Lsa::Type lsaType, uint64_t seqNo);
 
+  /*! \brief Sends \p data in reply to \p interest , and counts it in the control traffic of
+   *         the neighbor that sent the Interest.
+   */
+  void
+  putLsaData(const ndn::Interest& interest, const ndn::Data& data);
+
+  /*! \brief Answers an Interest for the delta of our Adjacency LSA from its previous version.
+
+    If the previous version is not known, the delta has no base.
+   */
+  bool
+  processInterestForAdjLsaDelta(const ndn::Interest& interest, uint64_t seqNo);
+
+  struct OwnLsaSegments
+  {
+    uint64_t seqNo = 0;
+    std::vector<std::shared_ptr<ndn::Data>> segments;
+  };
+
+  /*! \brief Records \p seqNo as the highest known sequence number of \p lsaName , unless a
+   *         higher one is known, and extends the lifetime of the record.
+   *  \return false if a higher sequence number is known
+   */
+  bool
+  updateHighestSeqNo(const ndn::Name& lsaName, uint64_t seqNo);
+
+  /*! \brief Returns the highest known sequence number of \p lsaName , or 0 if none is known.
+   */
+  uint64_t
+  getHighestSeqNo(const ndn::Name& lsaName) const;
+
+  /*! \brief Returns the signed segments of one of our own LSAs, segmenting it on first use.
+   */
+  const std::vector<std::shared_ptr<ndn::Data>>&
+  getOwnLsaSegments(OwnLsaSegments& ownSegments, uint64_t seqNo, const ndn::Block& wire,
+                    const ndn::Interest& interest);
+
+  /*! \brief Records the duration of a completed fetch of an LSA of type \p type .
+   */
+  void
+  recordFetchLatency(Lsa::Type type, ndn::time::nanoseconds duration);
+
+  /*! \brief Returns whether a new Adjacency LSA can be fetched as a delta.
+
+    That is the case if adj-lsa-delta is enabled and the LSDB has the version before it.
+   */
+  bool
+  canFetchAdjLsaDelta(const ndn::Name& interestName) const;
+
+  /*! \brief Fetches an LSA, or queues the fetch if lsa-fetch-window fetches are in flight
+             or if lsa-fetch-rate fetches were started through the same neighbor.
+
+    A queued fetch is replaced by a later one for a newer version of the same LSA, and so is a
+    fetch in flight or waiting for its retry, which is cancelled. A version that is already
+    being fetched is not fetched again. Queued Adjacency and Coordinate LSAs, which the
+    routing calculation needs, are fetched before Name LSAs.
+   */
   void
   expressInterest(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
                   ndn::time::steady_clock::time_point deadline = DEFAULT_LSA_RETRIEVAL_DEADLINE);
 
+  void
+  startLsaFetch(const ndn::Name& interestName, uint32_t timeoutCount, uint64_t incomingFaceId,
+                ndn::time::steady_clock::time_point deadline);
+
+  /*! \brief Seeds the initial RTO and window of a fetch through \p incomingFaceId from the
+             neighbor on that Face.
+
+    The initial RTO is the neighbor's RFC 6298 RTO instead of one second. On a link without
+    loss, the fetch starts with a window of LSA_FETCH_INIT_CWND segments, so that a segmented
+    LSA comes in one burst; on a lossy link, the window grows linearly from one segment.
+    Nothing is changed without an RTT sample of that neighbor.
+   */
+  void
+  seedFetcherOptions(ndn::SegmentFetcher::Options& options, uint64_t incomingFaceId) const;
+
+  /*! \brief Cancels the fetch of an LSA, whether it is in flight or waits for its retry.
+   */
+  void
+  cancelLsaFetch(const ndn::Name& lsaName);
+
+  /*! \brief Starts queued LSA fetches while the fetch window has room.
+
+    A fetch through a neighbor that is out of tokens is skipped, and retried when the token
+    buckets have refilled.
+   */
+  void
+  startPendingLsaFetches();
+
+  /*! \brief Takes a token from the bucket of the neighbor an LSA is fetched through.
+
+    The bucket of each incoming face, 0 standing for multicast, holds up to lsa-fetch-rate
+    tokens and gains lsa-fetch-rate tokens per second.
+    \return whether the fetch can start, always true if lsa-fetch-rate is 0
+   */
+  bool
+  takeFetchToken(uint64_t incomingFaceId);
+
+  void
+  scheduleRateLimitedFetches();
+
   /*!
      \brief Error callback when SegmentFetcher fails to return an LSA
 
-     In all error cases, a reattempt to fetch the LSA will be made.
+     In all error cases, a reattempt to fetch the LSA will be made, after a random delay of
+     up to the LSA Interest lifetime doubled for each previous attempt.
 
      Segment validation can fail either because the packet does not have a
      valid signature (fatal) or because some of the certificates in the trust chain
@@ -319,6 +718,49 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& interestName);
 
+  /*! \brief Installs the Adjacency LSA rebuilt from a fetched delta.
+
+    If the delta does not apply to the LSDB, the full LSA is fetched instead.
+   */
+  void
+  afterFetchAdjLsaDelta(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& interestName);
+
+  /*! \brief Installs an LSA fetched as \p lsaName , tracing its way to the FIB.
+   */
+  void
+  installFetchedLsa(std::shared_ptr<Lsa> lsa, const ndn::Name& lsaName);
+
+  /*! \brief Defers the fetch of an LSA version announced sooner than lsa-min-arrival after the
+             previous accepted version of \p lsaName .
+
+    The deferred fetch is for the newest version announced until then.
+    \return whether the fetch was deferred
+   */
+  bool
+  deferLsaFetch(const ndn::Name& lsaName, uint64_t seqNo, uint64_t incomingFaceId);
+
+  /*! \brief Returns whether a fetched LSA of another router is within lsa-max-name-prefixes
+             and lsa-max-adjacencies.
+   */
+  bool
+  isWithinSizeBudget(const Lsa& lsa) const;
+
+  /*! \brief Returns the LSA segments to carry in our sync Interests.
+
+    These are the single-segment LSAs that fit together in sync-inline-lsa-size bytes: our
+    own, then the current LSAs of other routers that were received inline.
+   */
+  std::vector<std::shared_ptr<const ndn::Data>>
+  getInlineLsas();
+
+  /*! \brief Validates and installs an LSA segment received in a sync Interest.
+
+    The LSA is skipped if it is not new. Otherwise it is not fetched when sync announces it
+    during the validation, unless it fails to validate or to install.
+   */
+  void
+  onInlineLsa(const ndn::Data& data);
+
   void
   emitSegmentValidatedSignal(const ndn::Data& data)
   {
@@ -332,10 +774,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   }
 
 public:
-  ndn::signal::Signal<Lsdb, Statistics::PacketType> lsaIncrementSignal;
   ndn::signal::Signal<Lsdb, ndn::Data> afterSegmentValidatedSignal;
+  /*! \brief Signal emitted when an LSA is installed, updated or removed.
+
+    An update of a Name LSA carries the prefixes added and removed, and an update of an
+    Adjacency LSA carries the changes of its links. They are empty otherwise.
+   */
   using AfterLsdbModified = ndn::signal::Signal<Lsdb, std::shared_ptr<Lsa>, LsdbUpdate,
-                                                std::list<nlsr::PrefixInfo>, std::list<nlsr::PrefixInfo>>;
+                                                std::vector<nlsr::PrefixInfo>, std::vector<nlsr::PrefixInfo>,
+                                                AdjLsaDiff>;
   AfterLsdbModified onLsdbModified;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
@@ -346,28 +793,152 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   SyncLogicHandler m_sync;
 
   LsaContainer m_lsdb;
+  NameMap m_routerMap;
+  // Number of Adjacency LSAs that name each router, as origin or neighbor; the routers of
+  // m_routerMap that are missing here have left the LSDB
+  std::unordered_map<ndn::Name, uint32_t> m_routerRefs;
+  uint64_t m_version = 0;
+  mutable std::shared_ptr<const LsdbSnapshot> m_snapshot;
 
   ndn::time::seconds m_lsaRefreshTime;
   ndn::time::seconds m_adjLsaBuildInterval;
   const ndn::Name& m_thisRouterPrefix;
 
-  // Maps the name of an LSA to its highest known sequence number from sync;
-  // Used to stop NLSR from trying to fetch outdated LSAs
-  std::map<ndn::Name, uint64_t> m_highestSeqNo;
+  struct HighestSeqNo
+  {
+    ndn::Name lsaName;
+    uint64_t seqNo;
+    /// dropped by the expiration sweep after this time, or with the LSA of the name
+    ndn::time::steady_clock::time_point expiration;
+  };
+
+  using HighestSeqNoContainer = boost::multi_index_container<
+    HighestSeqNo,
+    bmi::indexed_by<
+      bmi::hashed_unique<
+        bmi::tag<byName>,
+        bmi::member<HighestSeqNo, ndn::Name, &HighestSeqNo::lsaName>,
+        std::hash<ndn::Name>
+      >,
+      bmi::ordered_non_unique<
+        bmi::tag<byExpiration>,
+        bmi::member<HighestSeqNo, ndn::time::steady_clock::time_point, &HighestSeqNo::expiration>
+      >
+    >
+  >;
+
+  // The highest sequence number known from sync of each LSA name without sequence number,
+  // used to stop NLSR from trying to fetch outdated LSAs. An entry lives as long as the
+  // longest LSA lifetime from its last update, and no longer than the LSA of the name.
+  HighestSeqNoContainer m_highestSeqNo;
+
+  struct SyncNotification
+  {
+    uint64_t seqNo;
+    ndn::time::steady_clock::time_point time;
+  };
+  // The first notification of each LSA newer than the installed one, by LSA name without
+  // sequence number; only kept while latencies are recorded
+  std::map<ndn::Name, SyncNotification> m_syncNotifications;
 
   SequencingManager m_sequencingManager;
+  Statistics* m_stats = nullptr;
+  ConvergenceTracer* m_tracer = nullptr;
+  LatencyStatistics* m_latency = nullptr;
+  const LinkCostManager* m_linkCostManager = nullptr;
 
   ndn::signal::ScopedConnection m_onNewLsaConnection;
+  ndn::signal::ScopedConnection m_afterPublishConnection;
+
+  struct LsaFetch
+  {
+    uint64_t seqNo = 0;
+    // unset while the fetch waits for its retry
+    std::shared_ptr<ndn::SegmentFetcher> fetcher;
+    ndn::time::steady_clock::time_point startTime;
+    // when each segment arrived, until it is validated; only kept while latencies are recorded
+    std::map<ndn::Name, ndn::time::steady_clock::time_point> segmentArrivals;
+    ndn::scheduler::ScopedEventId retryEvent;
+  };
+  // The state of each LSA fetch in flight or waiting for its retry, by LSA name without
+  // sequence number
+  std::map<ndn::Name, LsaFetch> m_lsaFetches;
+  size_t m_nLsaFetchesInFlight = 0;
+
+  struct PendingLsaFetch
+  {
+    uint64_t seqNo;
+    uint32_t timeoutCount;
+    uint64_t incomingFaceId;
+    ndn::time::steady_clock::time_point deadline;
+  };
+  // Fetches waiting for the fetch window, by LSA name without sequence number. Each name is
+  // in exactly one of the two queues, which keep the order in which the LSAs were announced.
+  std::map<ndn::Name, PendingLsaFetch> m_pendingFetches;
+  std::deque<ndn::Name> m_pendingRoutingLsaFetches;
+  std::deque<ndn::Name> m_pendingNameLsaFetches;
+
+  struct FetchTokenBucket
+  {
+    double tokens = 0;
+    ndn::time::steady_clock::time_point lastRefill;
+  };
+  // Limits the fetches started through each incoming face, 0 for multicast
+  std::map<uint64_t, FetchTokenBucket> m_fetchTokens;
+  ndn::scheduler::ScopedEventId m_rateLimitedFetchEvent;
+  // LSAs received inline that are being validated, by LSA name with sequence number, and
+  // whether sync announced them meanwhile
+  std::map<ndn::Name, bool> m_pendingInlineLsas;
+
+  // When the current version of each LSA of other routers was accepted, by LSA name without
+  // sequence number; only kept with lsa-min-arrival, and erased with the LSA
+  std::map<ndn::Name, ndn::time::steady_clock::time_point> m_lsaArrivals;
+  struct DeferredLsaFetch
+  {
+    uint64_t seqNo;
+    uint64_t incomingFaceId;
+    ndn::scheduler::ScopedEventId event;
+  };
+  // Fetches held back by lsa-min-arrival, by LSA name without sequence number
+  std::map<ndn::Name, DeferredLsaFetch> m_deferredLsaFetches;
+
+  struct InlineLsa
+  {
+    ndn::Name originRouter;
+    Lsa::Type type;
+    uint64_t seqNo;
+    std::shared_ptr<const ndn::Data> data;
+  };
+  // The segments of other routers' LSAs received inline, by LSA name without sequence number
+  std::map<ndn::Name, InlineLsa> m_relayedInlineLsas;
 
-  std::set<std::shared_ptr<ndn::SegmentFetcher>> m_fetchers;
   ndn::Segmenter m_segmenter;
   ndn::InMemoryStorageFifo m_segmentFifo;
 
+  // The signed segments of the current version of each of this router's LSAs, by type
+  std::array<OwnLsaSegments, static_cast<size_t>(Lsa::Type::BASE)> m_ownLsaSegments;
+  OwnLsaSegments m_ownAdjLsaDeltaSegments;
+  // The version of this router's Adjacency LSA before the current one
+  std::shared_ptr<const AdjLsa> m_previousOwnAdjLsa;
+
   bool m_isBuildAdjLsaScheduled;
   int64_t m_adjBuildCount;
   ndn::scheduler::ScopedEventId m_scheduledAdjLsaBuild;
 
-  ndn::InMemoryStoragePersistent m_lsaStorage;
+  bool m_isNameLsaBuildScheduled = false;
+  std::vector<AreaSummary> m_areaSummaries;
+  ndn::scheduler::ScopedEventId m_scheduledNameLsaBuild;
+
+  ndn::scheduler::ScopedEventId m_expirationSweepEvent;
+  bool m_isExpirationSweepScheduled = false;
+  ndn::time::steady_clock::time_point m_nextExpirationSweep;
+  ndn::time::steady_clock::time_point m_lastExpirationSweep;
+
+  std::string m_snapshotFilePath;
+  uint64_t m_snapshotFileVersion = 0;
+  ndn::scheduler::ScopedEventId m_snapshotFileEvent;
+
+  LsaSegmentStorage m_lsaStorage;
 
   static inline const ndn::time::steady_clock::time_point DEFAULT_LSA_RETRIEVAL_DEADLINE =
     ndn::time::steady_clock::time_point::min();
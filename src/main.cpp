@@ -19,6 +19,7 @@
  * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  **/
 
+#include "async-log-sink.hpp"
 #include "conf-file-processor.hpp"
 #include "nlsr.hpp"
 #include "security/certificate-store.hpp"
@@ -26,6 +27,7 @@
 
 #include <boost/exception/diagnostic_information.hpp>
 #include <iostream>
+#include <optional>
 
 static void
 printUsage(std::ostream& os, const std::string& programName)
@@ -73,6 +75,11 @@ main(int argc, char** argv)
     return 2;
   }
 
+  std::optional<nlsr::AsyncLogSink> asyncLogSink;
+  if (confParam.getAsyncLogging()) {
+    asyncLogSink.emplace(std::clog);
+  }
+
   // Since confParam is already populated, key is initialized here before
   // and independent of the NLSR class
   auto certificate = confParam.initializeKey();
@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory-usage.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <iomanip>
+
+namespace nlsr {
+
+size_t
+getNameMemory(const ndn::Name& name)
+{
+  size_t nBytes = name.size() * sizeof(ndn::name::Component);
+  for (const auto& component : name) {
+    nBytes += component.size();
+  }
+  return nBytes;
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+MemoryStatus::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto it = m_components.rbegin(); it != m_components.rend(); ++it) {
+    size_t componentLength = 0;
+    componentLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::ByteCount,
+                                                      it->usage.nBytes);
+    componentLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::ElementCount,
+                                                      it->usage.nElements);
+    componentLength += prependStringBlock(block, nlsr::tlv::PhaseName, it->name);
+    componentLength += block.prependVarNumber(componentLength);
+    componentLength += block.prependVarNumber(nlsr::tlv::MemoryComponent);
+    totalLength += componentLength;
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::MemoryUsage);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(MemoryStatus);
+
+ndn::Block
+MemoryStatus::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  return buffer.block();
+}
+
+void
+MemoryStatus::wireDecode(const ndn::Block& wire)
+{
+  m_components.clear();
+
+  if (wire.type() != nlsr::tlv::MemoryUsage) {
+    NDN_THROW(Error("MemoryUsage", wire.type()));
+  }
+
+  wire.parse();
+  for (const auto& element : wire.elements()) {
+    if (element.type() != nlsr::tlv::MemoryComponent) {
+      NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(element.type()) +
+                      " in MemoryUsage"));
+    }
+
+    element.parse();
+    const auto& fields = element.elements();
+    if (fields.size() != 3 ||
+        fields[0].type() != nlsr::tlv::PhaseName ||
+        fields[1].type() != nlsr::tlv::ElementCount ||
+        fields[2].type() != nlsr::tlv::ByteCount) {
+      NDN_THROW(Error("Malformed MemoryComponent"));
+    }
+
+    using ndn::encoding::readNonNegativeInteger;
+    Component component;
+    component.name = readString(fields[0]);
+    component.usage.nElements = readNonNegativeInteger(fields[1]);
+    component.usage.nBytes = readNonNegativeInteger(fields[2]);
+    m_components.push_back(std::move(component));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const MemoryStatus& status)
+{
+  os << "Memory (approximate):\n";
+  uint64_t totalBytes = 0;
+  for (const auto& component : status.getComponents()) {
+    os << "  " << std::left << std::setw(20) << component.name << std::right
+       << " elements=" << component.usage.nElements
+       << " bytes=" << component.usage.nBytes << "\n";
+    totalBytes += component.usage.nBytes;
+  }
+  os << "  total bytes=" << totalBytes << "\n";
+  return os;
+}
+
+} // namespace nlsr
@@ -0,0 +1,119 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_MEMORY_USAGE_HPP
+#define NLSR_MEMORY_USAGE_HPP
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/name.hpp>
+
+#include <string>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Approximate memory of a data structure: its number of elements, and the bytes of
+ *         the elements, of the buffers they own and of the container nodes holding them.
+ *
+ * Allocator overhead and buffers shared with other structures are not counted, so that the
+ * estimates can be added up, and are lower bounds of the resident memory.
+ */
+struct MemoryUsage
+{
+  uint64_t nElements = 0;
+  uint64_t nBytes = 0;
+};
+
+/// bytes of a node of std::map, std::set or std::list, besides its element
+inline constexpr size_t TREE_NODE_OVERHEAD = 4 * sizeof(void*);
+/// bytes of a node of std::unordered_map or std::unordered_set and of its bucket, besides its
+/// element
+inline constexpr size_t HASH_NODE_OVERHEAD = 2 * sizeof(void*) + sizeof(size_t);
+
+/*! \brief Returns the bytes owned by \p name besides sizeof(ndn::Name): its components.
+ *
+ * The encoding of the name is not counted, as it usually shares the buffer of a packet.
+ */
+size_t
+getNameMemory(const ndn::Name& name);
+
+/*! \brief Memory used by the major data structures of NLSR, as served by the memory dataset.
+ *
+ *     MemoryUsage = MEMORY-USAGE-TYPE TLV-LENGTH
+ *                     *MemoryComponent
+ *
+ *     MemoryComponent = MEMORY-COMPONENT-TYPE TLV-LENGTH
+ *                         PhaseName    ; name of the data structure
+ *                         ElementCount ; NonNegativeInteger
+ *                         ByteCount    ; NonNegativeInteger
+ */
+class MemoryStatus
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  struct Component
+  {
+    std::string name;
+    MemoryUsage usage;
+  };
+
+  MemoryStatus() = default;
+
+  explicit
+  MemoryStatus(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  const std::vector<Component>&
+  getComponents() const
+  {
+    return m_components;
+  }
+
+  void
+  addComponent(std::string name, MemoryUsage usage)
+  {
+    m_components.push_back({std::move(name), usage});
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+private:
+  std::vector<Component> m_components;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const MemoryStatus& status);
+
+} // namespace nlsr
+
+#endif // NLSR_MEMORY_USAGE_HPP
@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "metrics-ingestor.hpp"
+#include "logger.hpp"
+
+#include <ndn-cxx/encoding/tlv.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <unistd.h>
+
+namespace nlsr {
+
+INIT_LOGGER(MetricsIngestor);
+
+class MetricsIngestor::Connection : public std::enable_shared_from_this<Connection>
+{
+public:
+  Connection(MetricsIngestor& ingestor, boost::asio::local::stream_protocol::socket socket)
+    : m_ingestor(ingestor)
+    , m_socket(std::move(socket))
+  {
+  }
+
+  void
+  read()
+  {
+    m_socket.async_read_some(boost::asio::buffer(m_buffer.data() + m_size, m_buffer.size() - m_size),
+      [self = shared_from_this()] (const boost::system::error_code& error, size_t nBytes) {
+        self->onRead(error, nBytes);
+      });
+  }
+
+  void
+  close()
+  {
+    m_isClosed = true;
+    boost::system::error_code error;
+    m_socket.close(error);
+  }
+
+private:
+  void
+  onRead(const boost::system::error_code& error, size_t nBytes)
+  {
+    if (m_isClosed) {
+      // the ingestor may be gone already
+      return;
+    }
+    if (error) {
+      if (error != boost::asio::error::operation_aborted) {
+        NLSR_LOG_DEBUG("Metrics connection closed: " << error.message());
+      }
+      return;
+    }
+    m_size += nBytes;
+
+    std::vector<LinkMetricsEntry> batch;
+    size_t offset = 0;
+    while (offset < m_size) {
+      auto [isOk, block] = ndn::Block::fromBuffer({m_buffer.data() + offset, m_size - offset});
+      if (!isOk) {
+        break;
+      }
+      offset += block.size();
+      try {
+        batch.emplace_back(block);
+      }
+      catch (const ndn::tlv::Error& e) {
+        NLSR_LOG_WARN("Closing metrics connection after malformed record: " << e.what());
+        m_ingestor.deliver(batch);
+        close();
+        return;
+      }
+    }
+
+    // keep the incomplete record at the start of the buffer
+    std::memmove(m_buffer.data(), m_buffer.data() + offset, m_size - offset);
+    m_size -= offset;
+    if (m_size == m_buffer.size()) {
+      NLSR_LOG_WARN("Closing metrics connection after oversized record");
+      m_ingestor.deliver(batch);
+      close();
+      return;
+    }
+
+    m_ingestor.deliver(batch);
+    read();
+  }
+
+private:
+  MetricsIngestor& m_ingestor;
+  boost::asio::local::stream_protocol::socket m_socket;
+  std::array<uint8_t, ndn::MAX_NDN_PACKET_SIZE> m_buffer;
+  size_t m_size = 0;
+  bool m_isClosed = false;
+};
+
+MetricsIngestor::MetricsIngestor(boost::asio::io_context& io, BatchCallback onBatch)
+  : m_io(io)
+  , m_acceptor(io)
+  , m_onBatch(std::move(onBatch))
+{
+}
+
+MetricsIngestor::~MetricsIngestor()
+{
+  close();
+}
+
+void
+MetricsIngestor::listen(const std::string& path)
+{
+  close();
+
+  ::unlink(path.data());
+  boost::asio::local::stream_protocol::endpoint endpoint(path);
+  m_acceptor.open(endpoint.protocol());
+  m_acceptor.bind(endpoint);
+  m_acceptor.listen();
+  m_path = path;
+
+  NLSR_LOG_INFO("Listening for external metrics on " << path);
+  accept();
+}
+
+void
+MetricsIngestor::close()
+{
+  for (const auto& weakConnection : m_connections) {
+    if (auto connection = weakConnection.lock()) {
+      connection->close();
+    }
+  }
+  m_connections.clear();
+
+  if (m_acceptor.is_open()) {
+    boost::system::error_code error;
+    m_acceptor.close(error);
+    ::unlink(m_path.data());
+  }
+}
+
+void
+MetricsIngestor::accept()
+{
+  m_acceptor.async_accept(
+    [this] (const boost::system::error_code& error,
+            boost::asio::local::stream_protocol::socket socket) {
+      if (error) {
+        if (error != boost::asio::error::operation_aborted) {
+          NLSR_LOG_ERROR("Cannot accept metrics connection: " << error.message());
+        }
+        return;
+      }
+
+      NLSR_LOG_DEBUG("Accepted metrics connection");
+      auto connection = std::make_shared<Connection>(*this, std::move(socket));
+      // forget the connections that were closed since the last accept
+      m_connections.erase(std::remove_if(m_connections.begin(), m_connections.end(),
+                                         [] (const auto& c) { return c.expired(); }),
+                          m_connections.end());
+      m_connections.push_back(connection);
+      connection->read();
+      accept();
+    });
+}
+
+void
+MetricsIngestor::deliver(std::vector<LinkMetricsEntry>& batch)
+{
+  if (batch.empty()) {
+    return;
+  }
+  m_nRecords += batch.size();
+  m_onBatch(batch);
+}
+
+} // namespace nlsr
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_METRICS_INGESTOR_HPP
+#define NLSR_METRICS_INGESTOR_HPP
+
+#include "link-metrics-status.hpp"
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Receives external link metrics from local telemetry agents over a Unix stream socket.
+ *
+ * Agents keep a connection open and write ExternalMetrics TLV records back to back, with the
+ * same encoding as in the set-metrics command. All complete records received by one read are
+ * delivered together, on the io thread, so that a high record rate costs one callback per read
+ * instead of one signed Interest/Data exchange per record. Sockets are never read synchronously,
+ * so a slow or stalled agent cannot block routing. A connection that sends a malformed or
+ * oversized record is closed.
+ */
+class MetricsIngestor : boost::noncopyable
+{
+public:
+  using BatchCallback = std::function<void(const std::vector<LinkMetricsEntry>&)>;
+
+  MetricsIngestor(boost::asio::io_context& io, BatchCallback onBatch);
+
+  ~MetricsIngestor();
+
+  /*! \brief Listen on the Unix socket at \p path , replacing a stale socket file.
+   *  \throw boost::system::system_error the socket cannot be bound
+   */
+  void
+  listen(const std::string& path);
+
+  void
+  close();
+
+  size_t
+  getRecordCount() const
+  {
+    return m_nRecords;
+  }
+
+private:
+  class Connection;
+
+  void
+  accept();
+
+  void
+  deliver(std::vector<LinkMetricsEntry>& batch);
+
+private:
+  boost::asio::io_context& m_io;
+  boost::asio::local::stream_protocol::acceptor m_acceptor;
+  BatchCallback m_onBatch;
+  std::string m_path;
+  std::vector<std::weak_ptr<Connection>> m_connections;
+  size_t m_nRecords = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_METRICS_INGESTOR_HPP
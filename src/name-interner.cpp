@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "name-interner.hpp"
+
+namespace nlsr {
+
+InternedName::InternedName()
+  : InternedName(NameInterner::get().intern(ndn::Name()))
+{
+}
+
+InternedName::InternedName(const ndn::Name& name)
+  : InternedName(NameInterner::get().intern(name))
+{
+}
+
+NameInterner&
+NameInterner::get()
+{
+  // Never destroyed, so that handles in static objects can outlive the other statics
+  static NameInterner* instance = new NameInterner;
+  return *instance;
+}
+
+InternedName
+NameInterner::intern(const ndn::Name& name)
+{
+  size_t hash = std::hash<ndn::Name>{}(name);
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto range = m_entries.equal_range(hash);
+  for (auto it = range.first; it != range.second; ++it) {
+    if (it->second.entry->name == name) {
+      if (auto handle = it->second.handle.lock(); handle) {
+        return InternedName(std::move(handle));
+      }
+    }
+  }
+
+  auto entry = new InternedName::Entry{name, hash};
+  std::shared_ptr<const InternedName::Entry> handle(entry, [this] (const InternedName::Entry* e) {
+    release(e);
+  });
+  m_entries.emplace(hash, Slot{entry, handle});
+  return InternedName(std::move(handle));
+}
+
+void
+NameInterner::release(const InternedName::Entry* entry)
+{
+  {
+    // an expired slot may also have been replaced by intern() in the meantime, so the slot is
+    // found by its entry rather than by its name
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto range = m_entries.equal_range(entry->hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (it->second.entry == entry) {
+        m_entries.erase(it);
+        break;
+      }
+    }
+  }
+  delete entry;
+}
+
+NameInterner::MemoryReport
+NameInterner::getMemoryReport() const
+{
+  MemoryReport report;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (const auto& [hash, slot] : m_entries) {
+    size_t nHandles = slot.handle.use_count();
+    size_t nBytes = slot.entry->name.wireEncode().size();
+    ++report.nNames;
+    report.nHandles += nHandles;
+    report.nBytes += nBytes;
+    if (nHandles > 1) {
+      report.nBytesSaved += (nHandles - 1) * nBytes;
+    }
+  }
+  return report;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const NameInterner::MemoryReport& report)
+{
+  return os << "Interned names: " << report.nNames
+            << ", handles: " << report.nHandles
+            << ", bytes: " << report.nBytes
+            << ", bytes saved: " << report.nBytesSaved;
+}
+
+} // namespace nlsr
@@ -0,0 +1,187 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_NAME_INTERNER_HPP
+#define NLSR_NAME_INTERNER_HPP
+
+#include <ndn-cxx/name.hpp>
+
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace nlsr {
+
+/*! \brief Immutable, refcounted handle to a router or prefix name held by the NameInterner.
+ *
+ * All handles to equal names share one copy of the name and its hash, so a handle is as cheap
+ * to copy as a shared pointer, hashing it does not encode the name, and handles compare equal
+ * by pointer. Ordering still follows the canonical order of the names.
+ */
+class InternedName
+{
+public:
+  /*! \brief Construct a handle to the empty name.
+   */
+  InternedName();
+
+  explicit
+  InternedName(const ndn::Name& name);
+
+  InternedName&
+  operator=(const ndn::Name& name)
+  {
+    return *this = InternedName(name);
+  }
+
+  const ndn::Name&
+  getName() const
+  {
+    return m_entry->name;
+  }
+
+  operator const ndn::Name&() const
+  {
+    return m_entry->name;
+  }
+
+  size_t
+  getHash() const
+  {
+    return m_entry->hash;
+  }
+
+  friend bool
+  operator==(const InternedName& lhs, const InternedName& rhs)
+  {
+    return lhs.m_entry == rhs.m_entry;
+  }
+
+  friend bool
+  operator!=(const InternedName& lhs, const InternedName& rhs)
+  {
+    return lhs.m_entry != rhs.m_entry;
+  }
+
+  friend bool
+  operator<(const InternedName& lhs, const InternedName& rhs)
+  {
+    return lhs.m_entry != rhs.m_entry && lhs.m_entry->name < rhs.m_entry->name;
+  }
+
+  friend std::ostream&
+  operator<<(std::ostream& os, const InternedName& name)
+  {
+    return os << name.m_entry->name;
+  }
+
+private:
+  struct Entry
+  {
+    ndn::Name name;
+    size_t hash;
+  };
+
+  explicit
+  InternedName(std::shared_ptr<const Entry> entry)
+    : m_entry(std::move(entry))
+  {
+  }
+
+private:
+  std::shared_ptr<const Entry> m_entry;
+
+  friend class NameInterner;
+};
+
+/*! \brief Process-wide table of interned names.
+ *
+ * The table only holds weak references: a name leaves the table when its last handle is
+ * destroyed. The table is locked, since the handles are also copied and destroyed by the
+ * routing calculation threads.
+ */
+class NameInterner
+{
+public:
+  /*! \brief Memory used by the interned names, and memory that separate copies would use.
+   */
+  struct MemoryReport
+  {
+    /// number of distinct names
+    size_t nNames = 0;
+    /// number of live handles
+    size_t nHandles = 0;
+    /// wire size of the distinct names
+    size_t nBytes = 0;
+    /// wire size that the extra copies of the names would have taken without interning
+    size_t nBytesSaved = 0;
+  };
+
+  static NameInterner&
+  get();
+
+  InternedName
+  intern(const ndn::Name& name);
+
+  size_t
+  size() const
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+  }
+
+  MemoryReport
+  getMemoryReport() const;
+
+private:
+  NameInterner() = default;
+
+  void
+  release(const InternedName::Entry* entry);
+
+private:
+  struct Slot
+  {
+    const InternedName::Entry* entry;
+    std::weak_ptr<const InternedName::Entry> handle;
+  };
+
+  mutable std::mutex m_mutex;
+  // Keyed by the hash of the name, so that lookups do not copy the name
+  std::unordered_multimap<size_t, Slot> m_entries;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const NameInterner::MemoryReport& report);
+
+} // namespace nlsr
+
+template<>
+struct std::hash<nlsr::InternedName>
+{
+  size_t
+  operator()(const nlsr::InternedName& name) const noexcept
+  {
+    return name.getHash();
+  }
+};
+
+#endif // NLSR_NAME_INTERNER_HPP
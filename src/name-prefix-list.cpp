@@ -23,6 +23,8 @@
 #include "common.hpp"
 #include "tlv-nlsr.hpp"
 
+#include <algorithm>
+
 namespace nlsr {
 
 NamePrefixList::NamePrefixList() = default;
@@ -34,33 +36,70 @@ NamePrefixList::NamePrefixList(std::initializer_list<ndn::Name> names)
   }
 }
 
+size_t
+NamePrefixList::findPosition(const ndn::Name& name) const
+{
+  // Fast path for prefixes inserted in canonical order
+  if (m_prefixes.empty() || m_prefixes.back().getName() < name) {
+    return m_prefixes.size();
+  }
+  auto it = std::lower_bound(m_prefixes.begin(), m_prefixes.end(), name,
+                             [] (const PrefixInfo& prefix, const ndn::Name& n) {
+                               return prefix.getName() < n;
+                             });
+  return static_cast<size_t>(it - m_prefixes.begin());
+}
+
+bool
+NamePrefixList::insertAt(size_t pos, const PrefixInfo& prefix, const std::string& source)
+{
+  if (!isAt(pos, prefix.getName())) {
+    m_prefixes.insert(m_prefixes.begin() + pos, prefix);
+    m_sources.insert(m_sources.begin() + pos, std::vector<std::string>{source});
+    return true;
+  }
+
+  // Because NFD only readvertises each prefix once, this will be the first cost
+  // announced via NFD
+  m_prefixes[pos] = prefix;
+  auto& sources = m_sources[pos];
+  auto it = std::lower_bound(sources.begin(), sources.end(), source);
+  if (it != sources.end() && *it == source) {
+    return false;
+  }
+  sources.insert(it, source);
+  return true;
+}
+
 bool
 NamePrefixList::insert(const ndn::Name& name, const std::string& source, double cost)
 {
-  auto& soucePrefixInfo = m_namesSources[name];
-  soucePrefixInfo.costObj = PrefixInfo(name, cost);
-  return soucePrefixInfo.sources.insert(source).second;
+  return insertAt(findPosition(name), PrefixInfo(name, cost), source);
 }
 
 bool
 NamePrefixList::insert(const PrefixInfo& nameCost)
 {
-  auto& soucePrefixInfo = m_namesSources[nameCost.getName()];
-  soucePrefixInfo.costObj = nameCost;
-  return soucePrefixInfo.sources.insert("").second;
+  return insertAt(findPosition(nameCost.getName()), nameCost, "");
 }
 
 bool
 NamePrefixList::erase(const ndn::Name& name, const std::string& source)
 {
-  auto it = m_namesSources.find(name);
-  if (it == m_namesSources.end()) {
+  size_t pos = findPosition(name);
+  if (!isAt(pos, name)) {
     return false;
   }
 
-  bool isRemoved = it->second.sources.erase(source);
-  if (it->second.sources.empty()) {
-    m_namesSources.erase(it);
+  auto& sources = m_sources[pos];
+  auto it = std::lower_bound(sources.begin(), sources.end(), source);
+  bool isRemoved = it != sources.end() && *it == source;
+  if (isRemoved) {
+    sources.erase(it);
+  }
+  if (sources.empty()) {
+    m_prefixes.erase(m_prefixes.begin() + pos);
+    m_sources.erase(m_sources.begin() + pos);
   }
   return isRemoved;
 }
@@ -68,17 +107,17 @@ NamePrefixList::erase(const ndn::Name& name, const std::string& source)
 const PrefixInfo&
 NamePrefixList::getPrefixInfoForName(const ndn::Name& name) const
 {
-  auto it = m_namesSources.find(name);
-  BOOST_ASSERT(it != m_namesSources.end());
-  return it->second.costObj;
+  size_t pos = findPosition(name);
+  BOOST_ASSERT(isAt(pos, name));
+  return m_prefixes[pos];
 }
 
 std::list<ndn::Name>
 NamePrefixList::getNames() const
 {
   std::list<ndn::Name> names;
-  for (const auto& [name, sources] : m_namesSources) {
-    names.emplace_back(name);
+  for (const auto& prefix : m_prefixes) {
+    names.emplace_back(prefix.getName());
   }
   return names;
 }
@@ -86,11 +125,7 @@ NamePrefixList::getNames() const
 std::list<PrefixInfo>
 NamePrefixList::getPrefixInfo() const
 {
-  std::list<PrefixInfo> nameCosts;
-  for (const auto& [name, soucePrefixInfo] : m_namesSources) {
-    nameCosts.emplace_back(name, soucePrefixInfo.costObj.getCost());
-  }
-  return nameCosts;
+  return {m_prefixes.begin(), m_prefixes.end()};
 }
 
 #ifdef WITH_TESTS
@@ -98,8 +133,8 @@ NamePrefixList::getPrefixInfo() const
 std::set<std::string>
 NamePrefixList::getSources(const ndn::Name& name) const
 {
-  if (auto it = m_namesSources.find(name); it != m_namesSources.end()) {
-    return it->second.sources;
+  if (size_t pos = findPosition(name); isAt(pos, name)) {
+    return {m_sources[pos].begin(), m_sources[pos].end()};
   }
   return {};
 }
@@ -110,9 +145,9 @@ std::ostream&
 operator<<(std::ostream& os, const NamePrefixList& list)
 {
   os << "Name prefix list: {\n";
-  for (const auto& [name, sources] : list.m_namesSources) {
-    os << name << "\nSources:\n";
-    for (const auto& source : sources.sources) {
+  for (size_t i = 0; i < list.m_prefixes.size(); ++i) {
+    os << list.m_prefixes[i].getName() << "\nSources:\n";
+    for (const auto& source : list.m_sources[i]) {
       os << "  " << source << "\n";
     }
   }
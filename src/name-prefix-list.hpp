@@ -25,14 +25,15 @@
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/name.hpp>
+#include <ndn-cxx/util/span.hpp>
 
 #include <boost/operators.hpp>
 
 #include <initializer_list>
 #include <list>
-#include <map>
 #include <set>
 #include <string>
+#include <vector>
 
 namespace nlsr {
 
@@ -99,6 +100,12 @@ private:
   mutable ndn::Block m_wire;
 };
 
+/*! \brief Prefixes advertised by a router, with the sources that advertise each of them.
+ *
+ * The prefixes are stored contiguously in canonical order, so that two lists can be compared
+ * with a single merge, and inserting prefixes in canonical order (as when decoding an LSA)
+ * only appends.
+ */
 class NamePrefixList : private boost::equality_comparable<NamePrefixList>
 {
 public:
@@ -127,7 +134,7 @@ public:
   size_t
   size() const
   {
-    return m_namesSources.size();
+    return m_prefixes.size();
   }
 
   const PrefixInfo&
@@ -139,6 +146,16 @@ public:
   std::list<PrefixInfo>
   getPrefixInfo() const;
 
+  /*! \brief Returns the prefixes in canonical order.
+   *
+   * The span is invalidated by any modification of the list.
+   */
+  ndn::span<const PrefixInfo>
+  getPrefixes() const
+  {
+    return m_prefixes;
+  }
+
 #ifdef WITH_TESTS
   /*! Returns the sources that this name has.
       If the name does not exist, returns an empty container.
@@ -150,7 +167,8 @@ public:
   void
   clear()
   {
-    m_namesSources.clear();
+    m_prefixes.clear();
+    m_sources.clear();
   }
 
 private: // non-member operators
@@ -161,19 +179,29 @@ private: // non-member operators
   friend bool
   operator==(const NamePrefixList& lhs, const NamePrefixList& rhs)
   {
-    return lhs.getPrefixInfo() == rhs.getPrefixInfo();
+    return lhs.m_prefixes == rhs.m_prefixes;
   }
 
-  struct PrefixInfoSource
+private:
+  /*! \brief Returns the position of \p name, or where it would be inserted.
+   */
+  size_t
+  findPosition(const ndn::Name& name) const;
+
+  bool
+  isAt(size_t pos, const ndn::Name& name) const
   {
-    std::set<std::string> sources;
-    // Because NFD only readvertises each prefix once, this will be the first cost
-    // announced via NFD
-    PrefixInfo costObj;
-  };
+    return pos < m_prefixes.size() && m_prefixes[pos].getName() == name;
+  }
+
+  bool
+  insertAt(size_t pos, const PrefixInfo& prefix, const std::string& source);
 
 private:
-  std::map<ndn::Name, PrefixInfoSource> m_namesSources;
+  std::vector<PrefixInfo> m_prefixes;
+  // Sorted sources of each prefix, at the same position as the prefix. Most prefixes have a
+  // single source, which keeps this cheaper than one std::set per prefix.
+  std::vector<std::vector<std::string>> m_sources;
 
   friend std::ostream&
   operator<<(std::ostream& os, const NamePrefixList& list);
@@ -7,10 +7,16 @@
 
 #include "nlsr.hpp"
 #include "adjacent.hpp"
+#include "conf-file-processor.hpp"
 #include "logger.hpp"
+#include "route/what-if.hpp"
 
+#include <algorithm>
 #include <cstdlib>
 #include <cstdio>
+#include <filesystem>
+#include <string_view>
+#include <unordered_map>
 #include <unistd.h>
 
 #include <ndn-cxx/mgmt/nfd/control-command.hpp>
@@ -21,8 +27,16 @@ namespace nlsr {
 
 INIT_LOGGER(Nlsr);
 
+/*! \brief Reloads the configuration file; it takes no parameters.
+ */
+class ReloadConfCommand : public ndn::nfd::ControlCommand<ReloadConfCommand>
+{
+  NDN_CXX_CONTROL_COMMAND("config", "reload");
+};
+
 Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   : m_face(face)
+  , m_keyChain(keyChain)
   , m_scheduler(face.getIoContext())
   , m_confParam(confParam)
   , m_adjacencyList(confParam.getAdjacencyList())
@@ -31,7 +45,8 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_lsdb(m_face, keyChain, m_confParam)
   , m_routingTable(m_scheduler, m_lsdb, m_confParam)
   , m_namePrefixTable(confParam.getRouterPrefix(), m_fib, m_routingTable,
-                      m_routingTable.afterRoutingChange, m_lsdb.onLsdbModified)
+                      m_routingTable.afterRoutingDelta, m_lsdb.onLsdbModified)
+  , m_routingChangeFeed(m_routingTable, m_routingTable.afterRoutingDelta)
   , m_helloProtocol(m_face, keyChain, confParam, m_routingTable, m_lsdb, *this)
   , m_linkCostManager(std::make_unique<LinkCostManager>(m_face, keyChain, m_confParam, 
                                                        m_adjacencyList, m_lsdb, m_routingTable, m_fib))
@@ -53,7 +68,9 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
         }
       }))
   , m_dispatcher(m_face, keyChain)
-  , m_datasetHandler(m_dispatcher, m_lsdb, m_routingTable)
+  , m_datasetHandler(m_dispatcher, m_lsdb, m_routingTable, m_namePrefixTable, m_fib,
+                     m_routingChangeFeed, *m_linkCostManager, m_convergenceTracer,
+                     m_latencyStatistics)
   , m_controller(m_face, keyChain)
   , m_faceDatasetController(m_face, keyChain)
   , m_prefixUpdateProcessor(m_dispatcher,
@@ -67,28 +84,87 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_statsCollector(m_lsdb, m_helloProtocol)
   , m_faceMonitor(m_face)
   , m_terminateSignals(face.getIoContext(), SIGINT, SIGTERM)
+  , m_reloadSignals(face.getIoContext(), SIGHUP)
 {
   NLSR_LOG_DEBUG("Initializing Nlsr");
 
   m_faceMonitor.onNotification.connect(std::bind(&Nlsr::onFaceEventNotification, this, _1));
+  // a notification that could not be fetched or decoded may have been a Face event
+  m_faceMonitor.onNack.connect([this] (const auto&) { m_isFaceDatasetStale = true; });
+  m_faceMonitor.onDecodeError.connect([this] (const auto&) { m_isFaceDatasetStale = true; });
   m_faceMonitor.start();
 
+  m_fib.setConvergenceTracer(&m_convergenceTracer);
+  m_lsdb.setConvergenceTracer(&m_convergenceTracer);
+  m_routingTable.setConvergenceTracer(&m_convergenceTracer);
+  m_namePrefixTable.setConvergenceTracer(&m_convergenceTracer);
+  m_helloProtocol.setConvergenceTracer(&m_convergenceTracer);
+  m_linkCostManager->setConvergenceTracer(&m_convergenceTracer);
+  m_fib.setLatencyStatistics(&m_latencyStatistics);
+  m_lsdb.setLatencyStatistics(&m_latencyStatistics);
+  m_lsdb.setLinkCostManager(m_linkCostManager.get());
+
+  if (m_confParam.getManagementThread()) {
+    m_prefixUpdateProcessor.enableWriterThread();
+  }
+
+  auto areas = m_confParam.getAreas();
+  if (areas.size() > 1) {
+    NLSR_LOG_INFO("Area border router of " << areas.size() << " areas");
+    m_areaSummarizer = std::make_unique<AreaSummarizer>(m_scheduler, m_confParam, m_lsdb,
+                                                        m_routingTable);
+  }
+  m_namePrefixTable.setAreas(std::move(areas));
+
   m_fib.setStrategy(m_confParam.getLsaPrefix(), Fib::MULTICAST_STRATEGY, 0);
   m_fib.setStrategy(m_confParam.getSyncPrefix(), Fib::MULTICAST_STRATEGY, 0);
 
   NLSR_LOG_DEBUG("Default NLSR identity: " << m_confParam.getSigningInfo().getSignerName());
 
+  m_dispatcher.addControlCommand<ReloadConfCommand>(
+    // only local applications may reload the configuration
+    [] (const ndn::Name& prefix, const ndn::Interest&, const ndn::mgmt::ControlParametersBase*,
+        const ndn::mgmt::AcceptContinuation& accept,
+        const ndn::mgmt::RejectContinuation& reject) {
+      if (LOCALHOST_PREFIX.isPrefixOf(prefix)) {
+        accept("");
+      }
+      else {
+        reject(ndn::mgmt::RejectReply::STATUS403);
+      }
+    },
+    std::bind(&Nlsr::onReloadCommand, this, _4));
+
+  // NFD does not forward /localhost from other hosts, so only local applications can query
+  m_face.setInterestFilter(ndn::Name(LOCALHOST_PREFIX).append(WHAT_IF_COMPONENT),
+    [this] (const auto&, const auto& interest) {
+      processWhatIfQuery(interest);
+    },
+    [] (const auto& name) {
+      NLSR_LOG_DEBUG("Successfully registered prefix: " << name);
+    },
+    [] (const auto& name, const auto& reason) {
+      NLSR_LOG_ERROR("Failed to register what-if prefix " << name << ": " << reason);
+    });
+
   addDispatcherTopPrefix(ndn::Name(m_confParam.getRouterPrefix()).append("nlsr"));
   addDispatcherTopPrefix(LOCALHOST_PREFIX);
 
   enableIncomingFaceIdIndication();
 
+  // Routes of a previous run that are not computed again once the adjacencies are back up
+  // are removed
+  m_fib.reconcileWithRib(ndn::time::seconds(m_confParam.getRouterDeadInterval() +
+                                            m_confParam.getRoutingCalcInterval()));
+
   initializeFaces(std::bind(&Nlsr::processFaceDataset, this, _1),
                   std::bind(&Nlsr::onFaceDatasetFetchTimeout, this, _1, _2, 0));
 
   m_adjacencyList.writeLog();
   NLSR_LOG_DEBUG(m_namePrefixList);
 
+  m_lsdb.loadSnapshotFile();
+
   if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
     for (auto&& neighbor : m_adjacencyList.getAdjList()) {
       neighbor.setLinkCost(0);
@@ -98,6 +174,54 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   m_terminateSignals.async_wait([this] (auto&&... args) {
     terminate(std::forward<decltype(args)>(args)...);
   });
+  waitForReloadSignal();
+
+  if (!m_confParam.getMetricsExportSocketPath().empty() || m_confParam.getMetricsExportPort() != 0) {
+    m_metricsExporter = std::make_unique<MetricsExporter>(m_face.getIoContext(), m_lsdb,
+      m_routingTable, m_namePrefixTable, m_fib, m_statsCollector.getStatistics(),
+      *m_linkCostManager, m_adjacencyList);
+    if (!m_confParam.getMetricsExportSocketPath().empty()) {
+      try {
+        m_metricsExporter->listen(m_confParam.getMetricsExportSocketPath());
+      }
+      catch (const boost::system::system_error& e) {
+        NLSR_LOG_ERROR("Cannot export metrics on " << m_confParam.getMetricsExportSocketPath()
+                       << ": " << e.what());
+      }
+    }
+    if (m_confParam.getMetricsExportPort() != 0) {
+      try {
+        m_metricsExporter->listen(m_confParam.getMetricsExportPort());
+      }
+      catch (const boost::system::system_error& e) {
+        NLSR_LOG_ERROR("Cannot export metrics on port " << m_confParam.getMetricsExportPort()
+                       << ": " << e.what());
+      }
+    }
+  }
+
+  if (!m_confParam.getEventStreamSocketPath().empty()) {
+    m_eventStream = std::make_unique<EventStream>(m_face.getIoContext(), m_adjacencyList,
+      m_lsdb, m_routingTable, m_fib, *m_linkCostManager);
+    try {
+      m_eventStream->listen(m_confParam.getEventStreamSocketPath());
+    }
+    catch (const boost::system::system_error& e) {
+      NLSR_LOG_ERROR("Cannot stream events on " << m_confParam.getEventStreamSocketPath()
+                     << ": " << e.what());
+    }
+  }
+
+  if (m_confParam.getSharedStateExport()) {
+    auto path = std::filesystem::path(m_confParam.getStateFileDir()) / "routing-state.shm";
+    try {
+      m_sharedStateExporter = std::make_unique<SharedStateExporter>(m_scheduler, path.string(),
+        m_routingTable, *m_linkCostManager);
+    }
+    catch (const std::system_error& e) {
+      NLSR_LOG_ERROR("Cannot export the routing state in " << path << ": " << e.what());
+    }
+  }
 
   // ✅ 教学要点：HelloProtocol事件连接的重要性
   // 这些连接让LinkCostManager能够实时感知邻居状态变化
@@ -114,12 +238,21 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   m_helloProtocol.onInterestSent.connect(
          [this](const ndn::Name& neighbor) { onHelloInterestSent(neighbor); });
 
+  m_helloProtocol.onRttMeasured.connect(
+    [this] (const ndn::Name& neighbor, ndn::time::steady_clock::duration rtt) {
+      onHelloRttMeasured(neighbor, rtt);
+    });
+
+  m_helloProtocol.onCongestionSample.connect(
+    [this] (const ndn::Name& neighbor, bool isMarked) { onHelloCongestionSample(neighbor, isMarked); });
+
   // ✅ 教学要点：立即设置LinkCostManager到RoutingTable的重要性
   // 这个设置必须在LinkCostManager启动之前完成，确保路由表可以使用智能成本计算
   // 无论是负载感知算法还是ML算法，都需要这个基础设施
   if ((m_confParam.getLoadAwareRouting() || m_confParam.getMLAdaptiveRouting()) && m_linkCostManager) {
     NLSR_LOG_INFO("🔧 Setting LinkCostManager to RoutingTable for intelligent routing");
     m_routingTable.setLinkCostManager(m_linkCostManager.get());
+    m_fib.setLinkCostManager(m_linkCostManager.get());
     NLSR_LOG_INFO("✅ LinkCostManager integration completed");
   }
 
@@ -166,6 +299,23 @@ Nlsr::onHelloDataReceived(const ndn::Name& neighbor)
     m_linkCostManager->onHelloDataReceived(neighbor);
   }
 }
+
+void
+Nlsr::onHelloRttMeasured(const ndn::Name& neighbor, ndn::time::steady_clock::duration rtt)
+{
+  if (m_linkCostManager && m_linkCostManager->isActive()) {
+    m_linkCostManager->onHelloRttMeasured(neighbor, rtt);
+  }
+}
+
+void
+Nlsr::onHelloCongestionSample(const ndn::Name& neighbor, bool isMarked)
+{
+  if (m_linkCostManager && m_linkCostManager->isActive()) {
+    m_linkCostManager->onCongestionSample(neighbor, isMarked);
+  }
+}
+
 /************这是有关linkcost的超时处理函数 */
 void
 Nlsr::onHelloTimeout(const ndn::Name& neighbor, uint32_t timeoutCount)
@@ -178,6 +328,15 @@ Nlsr::onHelloTimeout(const ndn::Name& neighbor, uint32_t timeoutCount)
 void
 Nlsr::onHelloNeighborStatusChanged(const ndn::Name& neighbor, Adjacent::Status status)
 {
+  if (status == Adjacent::STATUS_INACTIVE && m_confParam.getLoopFreeAlternates()) {
+    // Switch to the alternates now; the Adjacency LSA build and recalculation follow later.
+    m_routingTable.repairRoutesThrough(neighbor);
+  }
+  if (status == Adjacent::STATUS_INACTIVE && m_confParam.getRoutingCalcNeighborDown()) {
+    // The calculation leaves out the neighbor's links until our Adjacency LSA is rebuilt.
+    m_routingTable.calculateWithoutNeighbor(neighbor);
+  }
+
   if (m_linkCostManager && m_linkCostManager->isActive()) {
     m_linkCostManager->onNeighborStatusChanged(neighbor, status);
   }
@@ -224,6 +383,326 @@ Nlsr::terminate(const boost::system::error_code& error, int signalNo)
   m_face.getIoContext().stop();
 }
 
+void
+Nlsr::waitForReloadSignal()
+{
+  m_reloadSignals.async_wait([this] (const boost::system::error_code& error, int signalNo) {
+    if (error) {
+      return;
+    }
+    NLSR_LOG_INFO("Caught signal " << signalNo << " (" << ::strsignal(signalNo) << "), reloading "
+                  << m_confParam.getConfFileName());
+    reloadConfFile();
+    waitForReloadSignal();
+  });
+}
+
+void
+Nlsr::onReloadCommand(const ndn::mgmt::CommandContinuation& done)
+{
+  if (reloadConfFile()) {
+    done(ndn::nfd::ControlResponse(200, "OK"));
+  }
+  else {
+    done(ndn::nfd::ControlResponse(400, "Cannot parse " + m_confParam.getConfFileName()));
+  }
+}
+
+void
+Nlsr::processWhatIfQuery(const ndn::Interest& interest)
+{
+  const auto& name = interest.getName();
+  if (!interest.hasApplicationParameters()) {
+    sendWhatIfResponse(name, ndn::nfd::ControlResponse(400, "Missing WhatIfQuery"));
+    return;
+  }
+
+  WhatIfQuery query;
+  try {
+    query.wireDecode(interest.getApplicationParameters().blockFromValue());
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_DEBUG("Malformed what-if query: " << e.what());
+    sendWhatIfResponse(name, ndn::nfd::ControlResponse(400, "Malformed WhatIfQuery"));
+    return;
+  }
+
+  if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
+    sendWhatIfResponse(name, ndn::nfd::ControlResponse(501,
+                       "What-if queries need link-state routing"));
+    return;
+  }
+
+  const auto& map = m_lsdb.getRouterMap();
+  for (const auto& scenario : query.scenarios) {
+    for (const auto& change : scenario) {
+      std::optional<ndn::Name> unknown;
+      if (!map.getMappingNoByRouterName(change.router)) {
+        unknown = change.router;
+      }
+      else if (change.type != WhatIfChange::Type::ROUTER_DOWN &&
+               !map.getMappingNoByRouterName(change.neighbor)) {
+        unknown = change.neighbor;
+      }
+      if (unknown) {
+        sendWhatIfResponse(name, ndn::nfd::ControlResponse(404,
+                           "Unknown router " + unknown->toUri()));
+        return;
+      }
+    }
+  }
+
+  NLSR_LOG_DEBUG("What-if query of " << query.scenarios.size() << " scenarios");
+  m_routingTable.calculateWhatIf(query, [this, name] (const WhatIfResult& result) {
+    ndn::nfd::ControlResponse response(200, "OK");
+    response.setBody(result.wireEncode());
+    sendWhatIfResponse(name, response);
+  });
+}
+
+void
+Nlsr::sendWhatIfResponse(const ndn::Name& name, const ndn::nfd::ControlResponse& response)
+{
+  ndn::Data data(name);
+  auto content = response.wireEncode();
+  // the name and the signature must fit in the packet too
+  if (content.size() + name.wireEncode().size() + 1024 > ndn::MAX_NDN_PACKET_SIZE) {
+    content = ndn::nfd::ControlResponse(413, "What-if result too large, query fewer scenarios")
+                .wireEncode();
+  }
+  data.setContent(content);
+  data.setFreshnessPeriod(0_ms);
+  m_keyChain.sign(data, m_confParam.getSigningInfo());
+  m_face.put(data);
+}
+
+bool
+Nlsr::reloadConfFile()
+{
+  // parsed into a separate ConfParameter, so that an invalid file changes nothing
+  ConfParameter conf(m_face, m_keyChain, m_confParam.getConfFileName());
+  ConfFileProcessor processor(conf);
+  if (!processor.reloadConfFile()) {
+    NLSR_LOG_ERROR("Cannot reload " << m_confParam.getConfFileName()
+                   << ", the running configuration is kept");
+    return false;
+  }
+  applyConfChanges(conf);
+  return true;
+}
+
+void
+Nlsr::applyConfChanges(ConfParameter& conf)
+{
+  // Options that are set up once at startup
+  auto checkRestart = [&] (std::string_view option, auto get) {
+    if ((conf.*get)() != (m_confParam.*get)()) {
+      NLSR_LOG_WARN("Reloaded " << option << " takes effect after a restart");
+    }
+  };
+  checkRestart("network, site or router", &ConfParameter::getRouterPrefix);
+  checkRestart("sync-protocol", &ConfParameter::getSyncProtocol);
+  checkRestart("state-dir", &ConfParameter::getStateFileDir);
+  checkRestart("lsa-refresh-time", &ConfParameter::getLsaRefreshTime);
+  checkRestart("adj-lsa-build-interval", &ConfParameter::getAdjLsaBuildInterval);
+  checkRestart("hyperbolic state", &ConfParameter::getHyperbolicState);
+  checkRestart("routing-calc-async", &ConfParameter::getRoutingCalcAsync);
+  checkRestart("routing-calc-threads", &ConfParameter::getRoutingCalcThreads);
+  checkRestart("verification-threads", &ConfParameter::getVerificationThreads);
+  checkRestart("rtt-source", &ConfParameter::getRttSource);
+  checkRestart("cost-metric", &ConfParameter::getCostMetric);
+  checkRestart("cost-damping", &ConfParameter::getCostDamping);
+  checkRestart("cost-buckets", &ConfParameter::getCostBuckets);
+  checkRestart("rtt-spike-filter", &ConfParameter::getRttSpikeFilter);
+
+  // Options that are read at each use, and take effect when next used
+  auto retune = [&] (std::string_view option, auto get, auto set) {
+    auto value = (conf.*get)();
+    if (value == (m_confParam.*get)()) {
+      return false;
+    }
+    NLSR_LOG_INFO("Reloaded " << option << ": " << (m_confParam.*get)() << " -> " << value);
+    (m_confParam.*set)(value);
+    return true;
+  };
+  retune("hello-retries", &ConfParameter::getInterestRetryNumber,
+         &ConfParameter::setInterestRetryNumber);
+  retune("hello-timeout", &ConfParameter::getInterestResendTime,
+         &ConfParameter::setInterestResendTime);
+  retune("hello-interval", &ConfParameter::getInfoInterestInterval,
+         &ConfParameter::setInfoInterestInterval);
+  retune("hello-interval-cap", &ConfParameter::getHelloIntervalCap,
+         &ConfParameter::setHelloIntervalCap);
+  retune("rtt-probe-interval-min", &ConfParameter::getRttProbeIntervalMin,
+         &ConfParameter::setRttProbeIntervalMin);
+  retune("rtt-probe-interval-max", &ConfParameter::getRttProbeIntervalMax,
+         &ConfParameter::setRttProbeIntervalMax);
+  retune("cost-update-window", &ConfParameter::getCostUpdateWindow,
+         &ConfParameter::setCostUpdateWindow);
+  retune("cost-advertise-threshold", &ConfParameter::getCostAdvertiseThreshold,
+         &ConfParameter::setCostAdvertiseThreshold);
+  retune("cost-advertise-hold", &ConfParameter::getCostAdvertiseHold,
+         &ConfParameter::setCostAdvertiseHold);
+  retune("link-bandwidth", &ConfParameter::getLinkBandwidth, &ConfParameter::setLinkBandwidth);
+  retune("lsa-fetch-window", &ConfParameter::getLsaFetchWindow,
+         &ConfParameter::setLsaFetchWindow);
+  retune("lsa-fetch-rate", &ConfParameter::getLsaFetchRate, &ConfParameter::setLsaFetchRate);
+  retune("lsa-max-name-prefixes", &ConfParameter::getLsaMaxNamePrefixes,
+         &ConfParameter::setLsaMaxNamePrefixes);
+  retune("lsa-max-adjacencies", &ConfParameter::getLsaMaxAdjacencies,
+         &ConfParameter::setLsaMaxAdjacencies);
+  retune("lsa-segment-size", &ConfParameter::getLsaSegmentSize,
+         &ConfParameter::setLsaSegmentSize);
+  retune("cert-prefetch", &ConfParameter::getCertPrefetch, &ConfParameter::setCertPrefetch);
+  if (retune("sync-expected-routers", &ConfParameter::getSyncExpectedRouters,
+             &ConfParameter::setSyncExpectedRouters)) {
+    m_lsdb.getSync().setExpectedRouters(m_confParam.getSyncExpectedRouters());
+  }
+  if (conf.getLsaMinArrival() != m_confParam.getLsaMinArrival()) {
+    NLSR_LOG_INFO("Reloaded lsa-min-arrival: " << m_confParam.getLsaMinArrival() << " -> "
+                  << conf.getLsaMinArrival());
+    m_confParam.setLsaMinArrival(conf.getLsaMinArrival().count());
+  }
+
+  // Routing options, which the next calculation follows
+  bool isRoutingChanged = false;
+  isRoutingChanged |= retune("routing-calc-interval", &ConfParameter::getRoutingCalcInterval,
+                             &ConfParameter::setRoutingCalcInterval);
+  isRoutingChanged |= retune("routing-calc-throttle", &ConfParameter::getRoutingCalcThrottle,
+                             &ConfParameter::setRoutingCalcThrottle);
+  isRoutingChanged |= retune("routing-calc-initial-delay",
+                             &ConfParameter::getRoutingCalcInitialDelay,
+                             &ConfParameter::setRoutingCalcInitialDelay);
+  isRoutingChanged |= retune("routing-calc-hold-time", &ConfParameter::getRoutingCalcHoldTime,
+                             &ConfParameter::setRoutingCalcHoldTime);
+  isRoutingChanged |= retune("routing-calc-neighbor-down",
+                             &ConfParameter::getRoutingCalcNeighborDown,
+                             &ConfParameter::setRoutingCalcNeighborDown);
+  isRoutingChanged |= retune("routing-calc-shadow", &ConfParameter::getRoutingCalcShadow,
+                             &ConfParameter::setRoutingCalcShadow);
+  isRoutingChanged |= retune("loop-free-alternates", &ConfParameter::getLoopFreeAlternates,
+                             &ConfParameter::setLoopFreeAlternates);
+  isRoutingChanged |= retune("disjoint-multipath", &ConfParameter::getDisjointPaths,
+                             &ConfParameter::setDisjointPaths);
+  isRoutingChanged |= retune("weighted-multipath", &ConfParameter::getWeightedMultipath,
+                             &ConfParameter::setWeightedMultipath);
+  isRoutingChanged |= retune("max-faces-per-prefix", &ConfParameter::getMaxFacesPerPrefix,
+                             &ConfParameter::setMaxFacesPerPrefix);
+  bool isCostModeChanged = false;
+  isCostModeChanged |= retune("load-aware-routing", &ConfParameter::getLoadAwareRouting,
+                              &ConfParameter::setLoadAwareRouting);
+  isCostModeChanged |= retune("ml-adaptive-routing", &ConfParameter::getMLAdaptiveRouting,
+                              &ConfParameter::setMLAdaptiveRouting);
+  if (isCostModeChanged) {
+    if (m_confParam.getLoadAwareRouting() || m_confParam.getMLAdaptiveRouting()) {
+      m_routingTable.setLinkCostManager(m_linkCostManager.get());
+      m_fib.setLinkCostManager(m_linkCostManager.get());
+    }
+    m_routingTable.updateCostCalculators();
+    isRoutingChanged = true;
+  }
+
+  // Neighbors: those removed or moved to another FaceUri are dropped, and the new ones are
+  // added INACTIVE, then matched to their Faces like at startup
+  std::vector<ndn::Name> removed;
+  for (const auto& adjacent : m_adjacencyList.getAdjList()) {
+    auto it = conf.getAdjacencyList().findAdjacent(adjacent.getName());
+    if (it == conf.getAdjacencyList().end() || it->getFaceUri() != adjacent.getFaceUri()) {
+      removed.push_back(adjacent.getName());
+    }
+  }
+  for (const auto& neighbor : removed) {
+    removeNeighbor(neighbor);
+  }
+
+  bool isAdjacencyChanged = !removed.empty();
+  bool isNeighborAdded = false;
+  for (const auto& adjacent : conf.getAdjacencyList().getAdjList()) {
+    auto it = m_adjacencyList.findAdjacent(adjacent.getName());
+    if (it == m_adjacencyList.end()) {
+      NLSR_LOG_INFO("Adding neighbor " << adjacent.getName() << " at " << adjacent.getFaceUri());
+      Adjacent neighbor(adjacent);
+      if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
+        neighbor.setLinkCost(0);
+      }
+      m_adjacencyList.insert(neighbor);
+      isNeighborAdded = true;
+    }
+    else if (it->getOriginalLinkCost() != adjacent.getOriginalLinkCost()) {
+      NLSR_LOG_INFO("Reloaded link-cost of " << adjacent.getName() << ": "
+                    << it->getOriginalLinkCost() << " -> " << adjacent.getOriginalLinkCost());
+      it->setOriginalLinkCost(adjacent.getOriginalLinkCost());
+      if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_ON) {
+        it->setLinkCost(adjacent.getOriginalLinkCost());
+        if (it->getFaceId() != 0) {
+          registerAdjacencyPrefixes(*it, ndn::time::milliseconds::max());
+        }
+        isAdjacencyChanged = true;
+      }
+    }
+  }
+
+  if (isAdjacencyChanged || isNeighborAdded) {
+    m_linkCostManager->updateNeighbors();
+    m_adjacencyList.writeLog();
+  }
+  if (isNeighborAdded) {
+    // the periodic dataset fetch goes on as it was; this one only matches the new neighbors
+    m_isFaceDatasetStale = true;
+    m_faceDatasetController.fetch<ndn::nfd::FaceDataset>(
+      [this] (const auto& faces) { matchFacesToAdjacencies(faces); },
+      [] (uint32_t, const std::string& msg) {
+        NLSR_LOG_WARN("Failed to fetch dataset for the new neighbors: " << msg
+                      << ", they are matched at the next fetch");
+      });
+  }
+  if (isAdjacencyChanged) {
+    if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
+      isRoutingChanged = true;
+    }
+    else {
+      m_lsdb.scheduleAdjLsaBuild();
+    }
+  }
+  if (isRoutingChanged) {
+    m_routingTable.scheduleRoutingTableCalculation();
+  }
+}
+
+void
+Nlsr::removeNeighbor(const ndn::Name& neighbor)
+{
+  auto adjacent = m_adjacencyList.findAdjacent(neighbor);
+  if (adjacent == m_adjacencyList.end()) {
+    return;
+  }
+  NLSR_LOG_INFO("Removing neighbor " << neighbor << " at " << adjacent->getFaceUri());
+  bool wasActive = adjacent->getStatus() == Adjacent::STATUS_ACTIVE;
+
+  // unregistered while the FIB can still find the Face ID of the neighbor
+  if (adjacent->getFaceId() != 0) {
+    const auto& faceUri = adjacent->getFaceUri();
+    m_fib.unregisterPrefix(neighbor, faceUri);
+    // the LSA and Sync prefixes stay on a Face shared with another neighbor
+    const auto& adjList = m_adjacencyList.getAdjList();
+    bool isFaceShared = std::any_of(adjList.begin(), adjList.end(), [&] (const auto& other) {
+      return other.getName() != neighbor && other.getFaceUri() == faceUri;
+    });
+    if (!isFaceShared) {
+      m_fib.unregisterPrefix(m_confParam.getLsaPrefix(), faceUri);
+      if (wasActive) {
+        m_fib.unregisterPrefix(m_confParam.getSyncPrefix(), faceUri);
+      }
+    }
+  }
+
+  if (wasActive && m_linkCostManager && m_linkCostManager->isActive()) {
+    m_linkCostManager->onNeighborStatusChanged(neighbor, Adjacent::STATUS_INACTIVE);
+  }
+  // the Hellos and link measurements of its ID stop once findById no longer finds it
+  m_adjacencyList.erase(neighbor);
+}
+
 // ✅ 其余方法保持完全不变，维持系统的稳定性
 void
 Nlsr::registerStrategyForCerts(const ndn::Name& originRouter)
@@ -298,11 +777,12 @@ Nlsr::onFaceEventNotification(const ndn::nfd::FaceEventNotification& faceEventNo
       if (adjacent != m_adjacencyList.end()) {
         NLSR_LOG_DEBUG("Face to " << adjacent->getName() << " with face id: " << faceId << " destroyed");
 
-        adjacent->setFaceId(0);
+        m_adjacencyList.setFaceId(adjacent->getName(), 0);
 
         if (adjacent->getStatus() == Adjacent::STATUS_ACTIVE) {
-          adjacent->setStatus(Adjacent::STATUS_INACTIVE);
-          adjacent->setInterestTimedOutNo(m_confParam.getInterestRetryNumber());
+          m_adjacencyList.setStatusOfNeighbor(adjacent->getName(), Adjacent::STATUS_INACTIVE);
+          m_adjacencyList.setTimedOutInterestCount(adjacent->getName(),
+                                                   m_confParam.getInterestRetryNumber());
 
           if (m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) {
             m_routingTable.scheduleRoutingTableCalculation();
@@ -331,7 +811,7 @@ Nlsr::onFaceEventNotification(const ndn::nfd::FaceEventNotification& faceEventNo
       {
         NLSR_LOG_DEBUG("Face creation event matches neighbor: " << adjacent->getName()
                         << ". New Face ID: " << faceId << ". Registering prefixes.");
-        adjacent->setFaceId(faceId);
+        m_adjacencyList.setFaceId(adjacent->getName(), faceId);
 
         registerAdjacencyPrefixes(*adjacent, ndn::time::milliseconds::max());
       }
@@ -352,26 +832,52 @@ Nlsr::initializeFaces(const FetchDatasetCallback& onFetchSuccess,
 
 void
 Nlsr::processFaceDataset(const std::vector<ndn::nfd::FaceStatus>& faces)
+{
+  matchFacesToAdjacencies(faces);
+  scheduleDatasetFetch();
+}
+
+void
+Nlsr::matchFacesToAdjacencies(const std::vector<ndn::nfd::FaceStatus>& faces)
 {
   NLSR_LOG_DEBUG("Processing face dataset");
+  m_isFaceDatasetStale = false;
 
+  // the first Face with a given remote FaceUri is taken, as the nested loop used to
+  std::unordered_map<std::string_view, const ndn::nfd::FaceStatus*> facesByUri;
+  facesByUri.reserve(faces.size());
+  for (const auto& faceStatus : faces) {
+    facesByUri.emplace(faceStatus.getRemoteUri(), &faceStatus);
+  }
+
+  std::vector<const Adjacent*> matched;
   for (auto&& adjacent : m_adjacencyList.getAdjList()) {
-    const std::string& faceUriString = adjacent.getFaceUri().toString();
-    for (const auto& faceStatus : faces) {
-      if (adjacent.getFaceId() == 0 && faceUriString == faceStatus.getRemoteUri()) {
-        NLSR_LOG_DEBUG("FaceUri: " << faceStatus.getRemoteUri() <<
-                   " FaceId: "<< faceStatus.getFaceId());
-        adjacent.setFaceId(faceStatus.getFaceId());
-        this->registerAdjacencyPrefixes(adjacent, ndn::time::milliseconds::max());
-      }
+    if (adjacent.getFaceId() != 0) {
+      continue;
     }
-    if (adjacent.getFaceId() == 0) {
+    auto it = facesByUri.find(adjacent.getFaceUri().toString());
+    if (it == facesByUri.end()) {
       NLSR_LOG_WARN("The adjacency " << adjacent.getName() <<
-                " has no Face information in this dataset.");
+                    " has no Face information in this dataset.");
+      continue;
     }
+    NLSR_LOG_DEBUG("FaceUri: " << it->second->getRemoteUri() <<
+                   " FaceId: " << it->second->getFaceId());
+    m_adjacencyList.setFaceId(adjacent.getName(), it->second->getFaceId());
+    matched.push_back(&adjacent);
   }
 
-  scheduleDatasetFetch();
+  // The neighbor prefixes, whose registration sends the first Hellos, are queued in the FIB
+  // command window ahead of the LSA prefix on each Face.
+  for (const auto* adjacent : matched) {
+    m_fib.registerPrefix(adjacent->getName(), adjacent->getFaceUri(), adjacent->getLinkCost(),
+                         ndn::time::milliseconds::max(), ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+  }
+  for (const auto* adjacent : matched) {
+    m_fib.registerPrefix(m_confParam.getLsaPrefix(), adjacent->getFaceUri(),
+                         adjacent->getLinkCost(), ndn::time::milliseconds::max(),
+                         ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+  }
 }
 
 void
@@ -413,6 +919,15 @@ Nlsr::scheduleDatasetFetch()
   NLSR_LOG_DEBUG("Scheduling dataset fetch in " << m_confParam.getFaceDatasetFetchInterval());
 
   m_scheduler.schedule(m_confParam.getFaceDatasetFetchInterval(), [this] {
+    // The Face events keep the adjacencies up to date after the first dataset, which is then
+    // only fetched again to check them once in a while, or when events may have been missed.
+    if (!m_isFaceDatasetStale && ++m_nFaceDatasetFetchesSkipped < FACE_DATASET_CHECK_PERIOD) {
+      NLSR_LOG_DEBUG("Face events are followed, skipping dataset fetch");
+      scheduleDatasetFetch();
+      return;
+    }
+    m_nFaceDatasetFetchesSkipped = 0;
+
     initializeFaces(
       [this] (const auto& faces) { processFaceDataset(faces); },
       [this] (uint32_t code, const std::string& msg) { onFaceDatasetFetchTimeout(code, msg, 0); });
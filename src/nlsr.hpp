@@ -10,13 +10,20 @@
 
 #include "adjacency-list.hpp"
 #include "conf-parameter.hpp"
+#include "convergence-tracer.hpp"
+#include "latency-statistics.hpp"
 #include "hello-protocol.hpp"
 #include "lsdb.hpp"
 #include "name-prefix-list.hpp"
 #include "test-access-control.hpp"
 #include "publisher/dataset-interest-handler.hpp"
+#include "publisher/event-stream.hpp"
+#include "publisher/shared-state-exporter.hpp"
+#include "publisher/metrics-exporter.hpp"
+#include "route/area-summarizer.hpp"
 #include "route/fib.hpp"
 #include "route/name-prefix-table.hpp"
+#include "route/routing-change-feed.hpp"
 #include "route/routing-table.hpp"
 #include "update/prefix-update-processor.hpp"
 #include "update/nfd-rib-command-processor.hpp"
@@ -39,6 +46,20 @@
 
 namespace nlsr {
 
+/*! \brief The NLSR router.
+ *
+ * Threading model: everything runs on the io thread of the Face, unless handed to one of
+ * the following workers, which are given copies of their inputs and post their results back
+ * to the io thread, where they are dropped once their component is destroyed.
+ *  - link-state route calculations, with routing-calc-async, and what-if queries;
+ *  - per-neighbor paths of a calculation, with routing-calc-threads;
+ *  - signature verification of LSAs, with verification-threads;
+ *  - writes of the sequence number file;
+ *  - writes of the configuration file by prefix-update commands, with management-thread.
+ *
+ * Hellos, liveness probes, Sync, LSA fetching and FIB updates stay on the io thread, and so
+ * do datasets, which are answered while their Interest is processed.
+ */
 class Nlsr
 {
 public:
@@ -70,6 +91,16 @@ public:
   // 只暴露必要的接口，避免不必要的复杂性
   LinkCostManager& getLinkCostManager() { return *m_linkCostManager; }
 
+  /*! \brief Parse the configuration file again and apply what changed, without a restart.
+   *
+   * Triggered by SIGHUP and by the config/reload command of local applications.
+   *
+   * \return false if the file cannot be parsed, in which case nothing is changed
+   * \sa applyConfChanges
+   */
+  bool
+  reloadConfFile();
+
 private:
   void
   registerStrategyForCerts(const ndn::Name& originRouter);
@@ -90,10 +121,30 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   processFaceDataset(const std::vector<ndn::nfd::FaceStatus>& faces);
 
+  /*! \brief Apply the differences of \p conf from the running configuration.
+   *
+   * Neighbors are added, removed or given their new cost, and the timers and options that are
+   * read at each use are replaced, so that a change of calculator takes effect in the routing
+   * calculation that is then scheduled. Options set up once at startup are left unchanged,
+   * and logged as taking a restart.
+   */
+  void
+  applyConfChanges(ConfParameter& conf);
+
 private:
   void
   registerAdjacencyPrefixes(const Adjacent& adj, ndn::time::milliseconds timeout);
 
+  /*! \brief Set the Face IDs of the adjacencies without one, and register their prefixes.
+   */
+  void
+  matchFacesToAdjacencies(const std::vector<ndn::nfd::FaceStatus>& faces);
+
+  /*! \brief Drop a neighbor removed from the configuration, and its prefixes on its Face.
+   */
+  void
+  removeNeighbor(const ndn::Name& neighbor);
+
   void
   registerPrefix(const ndn::Name& prefix);
 
@@ -109,31 +160,59 @@ private:
   void
   terminate(const boost::system::error_code& error, int signalNo);
 
+  void
+  waitForReloadSignal();
+
+  void
+  onReloadCommand(const ndn::mgmt::CommandContinuation& done);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Answer a what-if query of a local application, see RoutingTable::calculateWhatIf.
+   *
+   * The WhatIfQuery is carried in the ApplicationParameters, and the WhatIfResult is the body
+   * of the ControlResponse, which is sent once the scenarios are calculated.
+   */
+  void
+  processWhatIfQuery(const ndn::Interest& interest);
+
+private:
+  void
+  sendWhatIfResponse(const ndn::Name& name, const ndn::nfd::ControlResponse& response);
+
 public:
   static inline const ndn::Name LOCALHOST_PREFIX{"/localhost/nlsr"};
+  static inline const ndn::Name::Component WHAT_IF_COMPONENT{"what-if"};
 
   // ✅ 教学要点：HelloProtocol事件处理器设计
   // 这些方法实现了HelloProtocol与LinkCostManager的集成
   // 通过事件驱动的方式，LinkCostManager可以实时获取邻居状态变化
   void onHelloInterestSent(const ndn::Name& neighbor);
   void onHelloDataReceived(const ndn::Name& neighbor);
+  void onHelloRttMeasured(const ndn::Name& neighbor, ndn::time::steady_clock::duration rtt);
+  void onHelloCongestionSample(const ndn::Name& neighbor, bool isMarked);
   void onHelloTimeout(const ndn::Name& neighbor, uint32_t timeoutCount);
   void onHelloNeighborStatusChanged(const ndn::Name& neighbor, Adjacent::Status status);
   void onNeighborCostUpdated(const ndn::Name& neighbor, double newCost);
 
 private:
   ndn::Face& m_face;
+  ndn::KeyChain& m_keyChain;
   ndn::Scheduler m_scheduler;
   ConfParameter& m_confParam;
   AdjacencyList& m_adjacencyList;
   NamePrefixList& m_namePrefixList;
   std::vector<ndn::Name> m_strategySetOnRouters;
+  // referred to by the routing components, which are destroyed first
+  ConvergenceTracer m_convergenceTracer;
+  LatencyStatistics m_latencyStatistics;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   Fib m_fib;
   Lsdb m_lsdb;
   RoutingTable m_routingTable;
   NamePrefixTable m_namePrefixTable;
+  std::unique_ptr<AreaSummarizer> m_areaSummarizer;
+  RoutingChangeFeed m_routingChangeFeed;
   HelloProtocol m_helloProtocol;
   
  
@@ -159,10 +238,20 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   update::NfdRibCommandProcessor m_nfdRibCommandProcessor;
 
   StatsCollector m_statsCollector;
+  std::unique_ptr<MetricsExporter> m_metricsExporter;
+  std::unique_ptr<EventStream> m_eventStream;
+  std::unique_ptr<SharedStateExporter> m_sharedStateExporter;
 
 private:
   ndn::nfd::FaceMonitor m_faceMonitor;
+  /// whether the adjacencies may have missed Face events since the last dataset
+  bool m_isFaceDatasetStale = true;
+  /// periodic dataset fetches skipped since the last one
+  uint32_t m_nFaceDatasetFetchesSkipped = 0;
+  /// the dataset is fetched at least once in this many face-dataset-fetch-intervals
+  static constexpr uint32_t FACE_DATASET_CHECK_PERIOD = 6;
   boost::asio::signal_set m_terminateSignals;
+  boost::asio::signal_set m_reloadSignals;
   
   // ✅ 教学要点：避免重复的系统级ML对象
   // 之前的设计中考虑过在Nlsr类中添加ML计算器，但这会与RoutingTable中的产生冲突
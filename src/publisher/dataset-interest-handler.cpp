@@ -22,7 +22,12 @@
 #include "dataset-interest-handler.hpp"
 #include "nlsr.hpp"
 #include "logger.hpp"
+#include "name-interner.hpp"
+#include "tlv-nlsr.hpp"
+#include "route/ml-adaptive-calculator.hpp"
 
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <ndn-cxx/mgmt/nfd/control-command.hpp>
 #include <ndn-cxx/mgmt/nfd/control-response.hpp>
 #include <ndn-cxx/util/regex.hpp>
 
@@ -34,12 +39,39 @@ const ndn::PartialName ADJACENCIES_DATASET{"lsdb/adjacencies"};
 const ndn::PartialName COORDINATES_DATASET{"lsdb/coordinates"};
 const ndn::PartialName NAMES_DATASET{"lsdb/names"};
 const ndn::PartialName RT_DATASET{"routing-table"};
+const ndn::PartialName RT_CHANGES_DATASET{"routing-table-changes"};
+const ndn::PartialName TOPOLOGY_DATASET{"topology"};
+const ndn::PartialName CALCULATION_PROFILE_DATASET{"routing-calc-profile"};
+const ndn::PartialName LINK_METRICS_DATASET{"link-metrics"};
+const ndn::PartialName LINK_COST_DATASET{"link-cost"};
+const ndn::PartialName CONVERGENCE_TRACE_DATASET{"convergence-trace"};
+const ndn::PartialName LATENCY_DATASET{"latency/list"};
+const ndn::PartialName MEMORY_DATASET{"memory"};
+
+/*! \brief Restarts the latency histograms; it takes no parameters.
+ */
+class ResetLatencyCommand : public ndn::nfd::ControlCommand<ResetLatencyCommand>
+{
+  NDN_CXX_CONTROL_COMMAND("latency", "reset");
+};
 
 DatasetInterestHandler::DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher,
                                                const Lsdb& lsdb,
-                                               const RoutingTable& rt)
+                                               const RoutingTable& rt,
+                                               const NamePrefixTable& namePrefixTable,
+                                               const Fib& fib,
+                                               const RoutingChangeFeed& routingChangeFeed,
+                                               const LinkCostManager& linkCostManager,
+                                               const ConvergenceTracer& convergenceTracer,
+                                               LatencyStatistics& latencyStatistics)
   : m_lsdb(lsdb)
   , m_routingTable(rt)
+  , m_namePrefixTable(namePrefixTable)
+  , m_fib(fib)
+  , m_routingChangeFeed(routingChangeFeed)
+  , m_linkCostManager(linkCostManager)
+  , m_convergenceTracer(convergenceTracer)
+  , m_latencyStatistics(latencyStatistics)
 {
   dispatcher.addStatusDataset(ADJACENCIES_DATASET,
     ndn::mgmt::makeAcceptAllAuthorization(),
@@ -53,6 +85,43 @@ DatasetInterestHandler::DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher
   dispatcher.addStatusDataset(RT_DATASET,
     ndn::mgmt::makeAcceptAllAuthorization(),
     std::bind(&DatasetInterestHandler::publishRtStatus, this, _1, _2, _3));
+  dispatcher.addStatusDataset(RT_CHANGES_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishRtChanges, this, _1, _2, _3));
+  dispatcher.addStatusDataset(TOPOLOGY_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishTopologyStatus, this, _1, _2, _3));
+  dispatcher.addStatusDataset(CALCULATION_PROFILE_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishCalculationProfile, this, _1, _2, _3));
+  dispatcher.addStatusDataset(LINK_METRICS_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishLinkMetrics, this, _1, _2, _3));
+  dispatcher.addStatusDataset(LINK_COST_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishLinkCost, this, _1, _2, _3));
+  dispatcher.addStatusDataset(CONVERGENCE_TRACE_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishConvergenceTrace, this, _1, _2, _3));
+  dispatcher.addStatusDataset(LATENCY_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishLatency, this, _1, _2, _3));
+  dispatcher.addStatusDataset(MEMORY_DATASET,
+    ndn::mgmt::makeAcceptAllAuthorization(),
+    std::bind(&DatasetInterestHandler::publishMemory, this, _1, _2, _3));
+  dispatcher.addControlCommand<ResetLatencyCommand>(
+    // only local applications may reset the histograms
+    [] (const ndn::Name& prefix, const ndn::Interest&, const ndn::mgmt::ControlParametersBase*,
+        const ndn::mgmt::AcceptContinuation& accept,
+        const ndn::mgmt::RejectContinuation& reject) {
+      if (Nlsr::LOCALHOST_PREFIX.isPrefixOf(prefix)) {
+        accept("");
+      }
+      else {
+        reject(ndn::mgmt::RejectReply::STATUS403);
+      }
+    },
+    std::bind(&DatasetInterestHandler::resetLatency, this, _4));
 }
 
 template <typename T>
@@ -61,13 +130,113 @@ DatasetInterestHandler::publishLsaStatus(const ndn::Name& topPrefix, const ndn::
                                          ndn::mgmt::StatusDatasetContext& context)
 {
   NLSR_LOG_TRACE("Received interest: " << interest);
-  auto lsaRange = m_lsdb.getLsdbIterator<T>();
-  for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; ++lsaIt) {
-    context.append((*lsaIt)->wireEncode());
+  // /<top-prefix>/lsdb/<type>[/<query>]
+  const auto& name = interest.getName();
+  size_t queryPos = topPrefix.size() + ADJACENCIES_DATASET.size();
+  if (name.size() <= queryPos) {
+    context.append(getEncodedLsas<T>());
+    context.end();
+    return;
+  }
+
+  LsdbQuery query;
+  try {
+    query.wireDecode(name[queryPos].blockFromValue());
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_DEBUG("Malformed LSDB query in " << name << ": " << e.what());
+    context.reject(ndn::mgmt::ControlResponse(400, "Malformed LSDB query"));
+    return;
+  }
+
+  NLSR_LOG_TRACE("Answering " << query);
+  for (const auto& block : queryLsas<T>(query)) {
+    context.append(block);
   }
   context.end();
 }
 
+template<typename T>
+std::vector<ndn::Block>
+DatasetInterestHandler::queryLsas(const LsdbQuery& query) const
+{
+  std::vector<std::shared_ptr<const Lsa>> lsas;
+  if (query.originRouter) {
+    auto lsa = m_lsdb.findLsa<T>(*query.originRouter);
+    if (lsa != nullptr && query.matches(*lsa)) {
+      lsas.push_back(std::move(lsa));
+    }
+  }
+  else {
+    auto snapshot = m_lsdb.getSnapshot();
+    for (const auto& lsa : snapshot->getLsas<T>()) {
+      if (query.matches(*lsa)) {
+        lsas.push_back(lsa);
+      }
+    }
+  }
+
+  auto byOriginRouter = [] (const auto& lhs, const auto& rhs) {
+    return lhs->getOriginRouter() < rhs->getOriginRouter();
+  };
+  bool isTruncated = query.pageSize != 0 && lsas.size() > query.pageSize;
+  if (isTruncated) {
+    auto pageEnd = lsas.begin() + static_cast<ptrdiff_t>(query.pageSize);
+    std::partial_sort(lsas.begin(), pageEnd, lsas.end(), byOriginRouter);
+    lsas.erase(pageEnd, lsas.end());
+  }
+  else {
+    std::sort(lsas.begin(), lsas.end(), byOriginRouter);
+  }
+
+  std::vector<ndn::Block> blocks;
+  blocks.reserve(lsas.size() + 1);
+  for (const auto& lsa : lsas) {
+    if constexpr (std::is_same_v<T, NameLsa>) {
+      if (query.prefix) {
+        // only the prefixes that were asked for
+        const auto& nameLsa = static_cast<const NameLsa&>(*lsa);
+        NamePrefixList npl;
+        for (const auto& prefix : query.getMatchingPrefixes(nameLsa)) {
+          npl.insert(prefix);
+        }
+        NameLsa trimmed(nameLsa.getOriginRouter(), nameLsa.getSeqNo(),
+                        nameLsa.getExpirationTimePoint(), npl);
+        trimmed.setCompressed(nameLsa.isCompressed());
+        blocks.push_back(trimmed.wireEncode());
+        continue;
+      }
+    }
+    blocks.push_back(lsa->wireEncode());
+  }
+
+  if (isTruncated) {
+    blocks.push_back(ndn::encoding::makeNestedBlock(nlsr::tlv::ContinuationToken,
+                                                    lsas.back()->getOriginRouter()));
+  }
+  return blocks;
+}
+
+template<typename T>
+const ndn::Buffer&
+DatasetInterestHandler::getEncodedLsas()
+{
+  auto& encoded = m_encodedLsas[static_cast<size_t>(T::type())];
+  if (encoded.wire != nullptr && encoded.lsdbVersion == m_lsdb.getVersion()) {
+    return *encoded.wire;
+  }
+
+  auto snapshot = m_lsdb.getSnapshot();
+  auto wire = std::make_shared<ndn::Buffer>();
+  for (const auto& lsa : snapshot->getLsas<T>()) {
+    // each LSA keeps its own encoding until it is modified
+    const auto& block = lsa->wireEncode();
+    wire->insert(wire->end(), block.begin(), block.end());
+  }
+  encoded = {snapshot->getVersion(), std::move(wire)};
+  return *encoded.wire;
+}
+
 void
 DatasetInterestHandler::publishRtStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
                                         ndn::mgmt::StatusDatasetContext& context)
@@ -77,4 +246,121 @@ DatasetInterestHandler::publishRtStatus(const ndn::Name& topPrefix, const ndn::I
   context.end();
 }
 
+void
+DatasetInterestHandler::publishRtChanges(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                                         ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  // /<top-prefix>/routing-table-changes[/<version>]
+  const auto& name = interest.getName();
+  size_t versionPos = topPrefix.size() + RT_CHANGES_DATASET.size();
+  if (name.size() <= versionPos) {
+    context.append(m_routingChangeFeed.getSnapshot().wireEncode());
+    context.end();
+    return;
+  }
+
+  if (!name[versionPos].isNumber()) {
+    NLSR_LOG_DEBUG("Malformed routing table version in " << name);
+    context.reject(ndn::mgmt::ControlResponse(400, "Malformed routing table version"));
+    return;
+  }
+  context.append(m_routingChangeFeed.getChangesSince(name[versionPos].toNumber()).wireEncode());
+  context.end();
+}
+
+void
+DatasetInterestHandler::publishTopologyStatus(const ndn::Name& topPrefix,
+                                              const ndn::Interest& interest,
+                                              ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  context.append(m_routingTable.getTopologyExporter().getStatus().wireEncode());
+  context.end();
+}
+
+void
+DatasetInterestHandler::publishCalculationProfile(const ndn::Name& topPrefix,
+                                                  const ndn::Interest& interest,
+                                                  ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  context.append(m_routingTable.getCalculationProfile().getStatus().wireEncode());
+  context.end();
+}
+
+void
+DatasetInterestHandler::publishLinkMetrics(const ndn::Name& topPrefix,
+                                           const ndn::Interest& interest,
+                                           ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  for (const auto& entry : m_linkCostManager.getLinkMetricsEntries()) {
+    context.append(entry.wireEncode());
+  }
+  context.end();
+}
+
+void
+DatasetInterestHandler::publishLinkCost(const ndn::Name& topPrefix,
+                                        const ndn::Interest& interest,
+                                        ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  for (const auto& stats : m_linkCostManager.getLinkCostStatistics()) {
+    context.append(stats.wireEncode());
+  }
+  context.end();
+}
+
+void
+DatasetInterestHandler::publishConvergenceTrace(const ndn::Name& topPrefix,
+                                                const ndn::Interest& interest,
+                                                ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  for (const auto& event : m_convergenceTracer.getEvents()) {
+    context.append(event.wireEncode());
+  }
+  context.end();
+}
+
+void
+DatasetInterestHandler::publishLatency(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                                       ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+  context.append(m_latencyStatistics.getStatus().wireEncode());
+  context.end();
+}
+
+void
+DatasetInterestHandler::publishMemory(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                                      ndn::mgmt::StatusDatasetContext& context)
+{
+  NLSR_LOG_TRACE("Received interest: " << interest);
+
+  MemoryStatus status;
+  m_lsdb.reportMemory(status);
+  m_namePrefixTable.reportMemory(status);
+  m_fib.reportMemory(status);
+  m_linkCostManager.reportMemory(status);
+  if (const auto* calculator = m_routingTable.getMLAdaptiveCalculator(); calculator != nullptr) {
+    calculator->reportMemory(status);
+  }
+  auto interned = NameInterner::get().getMemoryReport();
+  status.addComponent("interned-names", {interned.nNames, interned.nBytes});
+
+  context.append(status.wireEncode());
+  context.end();
+}
+
+void
+DatasetInterestHandler::resetLatency(const ndn::mgmt::CommandContinuation& done)
+{
+  NLSR_LOG_INFO("Resetting the latency histograms");
+  m_latencyStatistics.resetAll();
+  done(ndn::nfd::ControlResponse(200, "OK"));
+}
+
 } // namespace nlsr
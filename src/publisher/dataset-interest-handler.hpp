@@ -33,8 +33,15 @@
 
 #include "route/routing-table-entry.hpp"
 #include "route/routing-table.hpp"
+#include "route/name-prefix-table.hpp"
 #include "route/nexthop-list.hpp"
+#include "route/routing-change-feed.hpp"
+#include "publisher/lsdb-query.hpp"
+#include "convergence-tracer.hpp"
+#include "latency-statistics.hpp"
+#include "link-cost-manager.hpp"
 #include "lsdb.hpp"
+#include "test-access-control.hpp"
 
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/mgmt/dispatcher.hpp>
@@ -64,7 +71,13 @@ public:
 
   DatasetInterestHandler(ndn::mgmt::Dispatcher& dispatcher,
                          const Lsdb& lsdb,
-                         const RoutingTable& rt);
+                         const RoutingTable& rt,
+                         const NamePrefixTable& namePrefixTable,
+                         const Fib& fib,
+                         const RoutingChangeFeed& routingChangeFeed,
+                         const LinkCostManager& linkCostManager,
+                         const ConvergenceTracer& convergenceTracer,
+                         LatencyStatistics& latencyStatistics);
 
 private:
   /*! \brief provide routing-table dataset
@@ -73,16 +86,107 @@ private:
   publishRtStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
                   ndn::mgmt::StatusDatasetContext& context);
 
-  /*! \brief provide LSA status dataset
+  /*! \brief provide routing-table-changes dataset, the changes of the routing table since the
+   *         version that may follow the dataset name, or the whole table
+   */
+  void
+  publishRtChanges(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                   ndn::mgmt::StatusDatasetContext& context);
+
+  /*! \brief provide topology dataset, the router graph of the last link-state calculation
+   */
+  void
+  publishTopologyStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                        ndn::mgmt::StatusDatasetContext& context);
+
+  /*! \brief provide routing-calc-profile dataset, the durations of the calculation phases
+   */
+  void
+  publishCalculationProfile(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                            ndn::mgmt::StatusDatasetContext& context);
+
+  /*! \brief provide link-metrics dataset, the metrics of the links to all neighbors
+   */
+  void
+  publishLinkMetrics(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                     ndn::mgmt::StatusDatasetContext& context);
+
+  /*! \brief provide link-cost dataset, the measurement statistics of the links to all neighbors
+   */
+  void
+  publishLinkCost(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                  ndn::mgmt::StatusDatasetContext& context);
+
+  /*! \brief provide convergence-trace dataset, the events of the recent convergence traces
+   */
+  void
+  publishConvergenceTrace(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                          ndn::mgmt::StatusDatasetContext& context);
+
+  /*! \brief provide latency/list dataset, the latency percentiles of LSA retrieval and
+   *         route installation
+   */
+  void
+  publishLatency(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                 ndn::mgmt::StatusDatasetContext& context);
+
+  /*! \brief provide memory dataset, the approximate memory of the major data structures
+   */
+  void
+  publishMemory(const ndn::Name& topPrefix, const ndn::Interest& interest,
+                ndn::mgmt::StatusDatasetContext& context);
+
+  /*! \brief handle latency/reset command, which restarts the latency histograms
+   */
+  void
+  resetLatency(const ndn::mgmt::CommandContinuation& done);
+
+  /*! \brief provide LSA status dataset, filtered and paged by the LsdbQuery that may follow
+   *         the dataset name
    */
   template<typename T>
   void
   publishLsaStatus(const ndn::Name& topPrefix, const ndn::Interest& interest,
                    ndn::mgmt::StatusDatasetContext& context);
 
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  struct EncodedLsas
+  {
+    uint64_t lsdbVersion = 0;
+    std::shared_ptr<const ndn::Buffer> wire;
+  };
+
+  /*! \brief Returns the concatenated encodings of the LSAs of type T.
+   *
+   * They are encoded again only after the LSDB has changed, so that frequent polling of the
+   * LSDB datasets does not walk the LSDB each time.
+   */
+  template<typename T>
+  const ndn::Buffer&
+  getEncodedLsas();
+
+  /*! \brief Returns the encodings of the LSAs of type T selected by \p query , by origin
+   *         router, followed by a ContinuationToken if they do not fit in the page.
+   *
+   * With an OriginRouter, the LSA is looked up rather than the LSDB walked.
+   */
+  template<typename T>
+  std::vector<ndn::Block>
+  queryLsas(const LsdbQuery& query) const;
+
 private:
   const Lsdb& m_lsdb;
   const RoutingTable& m_routingTable;
+  const NamePrefixTable& m_namePrefixTable;
+  const Fib& m_fib;
+  const RoutingChangeFeed& m_routingChangeFeed;
+  const LinkCostManager& m_linkCostManager;
+  const ConvergenceTracer& m_convergenceTracer;
+  LatencyStatistics& m_latencyStatistics;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  // by LSA type, for the LSDB version they were encoded at
+  std::array<EncodedLsas, static_cast<size_t>(Lsa::Type::BASE)> m_encodedLsas;
 };
 
 } // namespace nlsr
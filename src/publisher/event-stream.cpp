@@ -0,0 +1,419 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "event-stream.hpp"
+#include "adjacency-list.hpp"
+#include "link-cost-manager.hpp"
+#include "logger.hpp"
+#include "lsdb.hpp"
+#include "route/fib.hpp"
+#include "route/routing-table.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <deque>
+#include <sstream>
+#include <unistd.h>
+
+namespace nlsr {
+
+INIT_LOGGER(EventStream);
+
+namespace {
+
+void
+writeString(std::ostream& os, std::string_view value)
+{
+  // names are URI-escaped, but FaceUris may hold any character
+  os << '"';
+  for (char c : value) {
+    if (c == '"' || c == '\\') {
+      os << '\\' << c;
+    }
+    else if (static_cast<unsigned char>(c) < 0x20) {
+      std::array<char, 7> escaped;
+      std::snprintf(escaped.data(), escaped.size(), "\\u%04x", c);
+      os << escaped.data();
+    }
+    else {
+      os << c;
+    }
+  }
+  os << '"';
+}
+
+template<typename T>
+void
+writeString(std::ostream& os, const T& value)
+{
+  writeString(os, std::string_view(boost::lexical_cast<std::string>(value)));
+}
+
+void
+writeNumber(std::ostream& os, double value)
+{
+  // unreachable links have an infinite cost, which JSON cannot represent
+  if (std::isfinite(value)) {
+    os << value;
+  }
+  else {
+    os << "null";
+  }
+}
+
+const char*
+toString(Adjacent::Status status)
+{
+  switch (status) {
+    case Adjacent::STATUS_ACTIVE:
+      return "ACTIVE";
+    case Adjacent::STATUS_INACTIVE:
+      return "INACTIVE";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+const char*
+toString(LsdbUpdate update)
+{
+  switch (update) {
+    case LsdbUpdate::INSTALLED:
+      return "installed";
+    case LsdbUpdate::UPDATED:
+      return "updated";
+    default:
+      return "removed";
+  }
+}
+
+template<typename NextHops>
+void
+writeNextHops(std::ostream& os, const NextHops& hops)
+{
+  os << '[';
+  bool isFirst = true;
+  for (const auto& hop : hops) {
+    os << (isFirst ? "" : ",") << "{\"faceUri\":";
+    writeString(os, hop.getConnectingFaceUri());
+    os << ",\"cost\":";
+    writeNumber(os, hop.getRouteCost());
+    os << '}';
+    isFirst = false;
+  }
+  os << ']';
+}
+
+void
+writeRoutes(std::ostream& os, const std::list<RoutingTableEntry>& entries)
+{
+  os << '[';
+  bool isFirst = true;
+  for (const auto& entry : entries) {
+    os << (isFirst ? "" : ",") << "{\"destination\":";
+    writeString(os, entry.getDestination());
+    os << ",\"nexthops\":";
+    writeNextHops(os, entry.getNexthopList());
+    os << '}';
+    isFirst = false;
+  }
+  os << ']';
+}
+
+} // namespace
+
+class EventStream::Client : public std::enable_shared_from_this<Client>
+{
+public:
+  explicit
+  Client(boost::asio::local::stream_protocol::socket socket)
+    : m_socket(std::move(socket))
+  {
+  }
+
+  /*! \brief Wait for the client to close the connection; what it sends is ignored.
+   */
+  void
+  watch()
+  {
+    m_socket.async_read_some(boost::asio::buffer(m_discard),
+      [self = shared_from_this()] (const boost::system::error_code& error, size_t) {
+        if (self->m_isClosed) {
+          return;
+        }
+        if (error) {
+          if (error != boost::asio::error::eof && error != boost::asio::error::operation_aborted) {
+            NLSR_LOG_DEBUG("Event stream connection closed: " << error.message());
+          }
+          self->close();
+          return;
+        }
+        self->watch();
+      });
+  }
+
+  /*! \brief Queue \p line to be written.
+   *  \return false if the backlog of the client would exceed \p maxBacklog
+   */
+  bool
+  send(const std::shared_ptr<const std::string>& line, size_t maxBacklog)
+  {
+    if (m_backlog + line->size() > maxBacklog) {
+      return false;
+    }
+    m_queue.push_back(line);
+    m_backlog += line->size();
+    if (!m_isWriting) {
+      write();
+    }
+    return true;
+  }
+
+  bool
+  isClosed() const
+  {
+    return m_isClosed;
+  }
+
+  void
+  close()
+  {
+    m_isClosed = true;
+    m_queue.clear();
+    boost::system::error_code error;
+    m_socket.close(error);
+  }
+
+private:
+  void
+  write()
+  {
+    m_isWriting = true;
+    boost::asio::async_write(m_socket, boost::asio::buffer(*m_queue.front()),
+      [self = shared_from_this()] (const boost::system::error_code& error, size_t) {
+        self->m_isWriting = false;
+        if (self->m_isClosed) {
+          return;
+        }
+        if (error) {
+          NLSR_LOG_DEBUG("Cannot write event: " << error.message());
+          self->close();
+          return;
+        }
+        self->m_backlog -= self->m_queue.front()->size();
+        self->m_queue.pop_front();
+        if (!self->m_queue.empty()) {
+          self->write();
+        }
+      });
+  }
+
+private:
+  boost::asio::local::stream_protocol::socket m_socket;
+  std::array<char, 256> m_discard;
+  // events are formatted once, and shared by the queues of all clients
+  std::deque<std::shared_ptr<const std::string>> m_queue;
+  size_t m_backlog = 0;
+  bool m_isWriting = false;
+  bool m_isClosed = false;
+};
+
+EventStream::EventStream(boost::asio::io_context& io, AdjacencyList& adjacencyList, Lsdb& lsdb,
+                         RoutingTable& rt, Fib& fib, LinkCostManager& linkCostManager,
+                         size_t maxClientBacklog)
+  : m_acceptor(io)
+  , m_maxClientBacklog(maxClientBacklog)
+{
+  m_signalConnections.emplace_back(adjacencyList.onStatusChanged.connect(
+    [this] (const Adjacent& adjacent, Adjacent::Status oldStatus) {
+      if (!hasClients()) {
+        return;
+      }
+      std::ostringstream os;
+      os << "\"neighbor\":";
+      writeString(os, adjacent.getName());
+      os << ",\"status\":\"" << toString(adjacent.getStatus())
+         << "\",\"previous\":\"" << toString(oldStatus) << '"';
+      publish("adjacency", os.str());
+    }));
+
+  m_signalConnections.emplace_back(linkCostManager.afterCostChanged.connect(
+    [this] (const ndn::Name& neighbor, double oldCost, double newCost) {
+      if (!hasClients()) {
+        return;
+      }
+      std::ostringstream os;
+      os << "\"neighbor\":";
+      writeString(os, neighbor);
+      os << ",\"cost\":";
+      writeNumber(os, newCost);
+      os << ",\"previous\":";
+      writeNumber(os, oldCost);
+      publish("link-cost", os.str());
+    }));
+
+  m_signalConnections.emplace_back(lsdb.onLsdbModified.connect(
+    [this] (const std::shared_ptr<Lsa>& lsa, LsdbUpdate update,
+            const auto&, const auto&, const auto&) {
+      if (!hasClients()) {
+        return;
+      }
+      std::ostringstream os;
+      os << "\"origin\":";
+      writeString(os, lsa->getOriginRouter());
+      os << ",\"lsaType\":";
+      writeString(os, lsa->getType());
+      os << ",\"seqNo\":" << lsa->getSeqNo()
+         << ",\"update\":\"" << toString(update) << '"';
+      publish("lsa", os.str());
+    }));
+
+  m_signalConnections.emplace_back(rt.afterRoutingDelta.connect(
+    [this] (const RoutingTableDelta& delta) {
+      if (!hasClients()) {
+        return;
+      }
+      std::ostringstream os;
+      os << "\"added\":";
+      writeRoutes(os, delta.added);
+      os << ",\"changed\":";
+      writeRoutes(os, delta.changed);
+      os << ",\"removed\":[";
+      bool isFirst = true;
+      for (const auto& destination : delta.removed) {
+        os << (isFirst ? "" : ",");
+        writeString(os, destination);
+        isFirst = false;
+      }
+      os << ']';
+      publish("routing", os.str());
+    }));
+
+  m_signalConnections.emplace_back(fib.afterEntryChanged.connect(
+    [this] (const ndn::Name& name, const NextHopsUriSortedSet& hops) {
+      if (!hasClients()) {
+        return;
+      }
+      std::ostringstream os;
+      os << "\"name\":";
+      writeString(os, name);
+      os << ",\"nexthops\":";
+      writeNextHops(os, hops);
+      publish("fib", os.str());
+    }));
+}
+
+EventStream::~EventStream()
+{
+  close();
+}
+
+void
+EventStream::listen(const std::string& path)
+{
+  if (m_acceptor.is_open()) {
+    boost::system::error_code error;
+    m_acceptor.close(error);
+    ::unlink(m_path.data());
+  }
+
+  ::unlink(path.data());
+  boost::asio::local::stream_protocol::endpoint endpoint(path);
+  m_acceptor.open(endpoint.protocol());
+  m_acceptor.bind(endpoint);
+  m_acceptor.listen();
+  m_path = path;
+
+  NLSR_LOG_INFO("Streaming events on " << path);
+  accept();
+}
+
+void
+EventStream::close()
+{
+  for (const auto& client : m_clients) {
+    client->close();
+  }
+  m_clients.clear();
+
+  if (m_acceptor.is_open()) {
+    boost::system::error_code error;
+    m_acceptor.close(error);
+    ::unlink(m_path.data());
+  }
+}
+
+void
+EventStream::accept()
+{
+  m_acceptor.async_accept(
+    [this] (const boost::system::error_code& error,
+            boost::asio::local::stream_protocol::socket socket) {
+      if (error) {
+        if (error != boost::asio::error::operation_aborted) {
+          NLSR_LOG_ERROR("Cannot accept event stream connection: " << error.message());
+        }
+        return;
+      }
+
+      auto client = std::make_shared<Client>(std::move(socket));
+      m_clients.push_back(client);
+      client->watch();
+      accept();
+    });
+}
+
+bool
+EventStream::hasClients()
+{
+  // forget the clients that closed the connection
+  m_clients.erase(std::remove_if(m_clients.begin(), m_clients.end(),
+                                 [] (const auto& client) { return client->isClosed(); }),
+                  m_clients.end());
+  return !m_clients.empty();
+}
+
+void
+EventStream::publish(std::string_view type, std::string_view members)
+{
+  std::ostringstream os;
+  os << "{\"seq\":" << ++m_lastSeqNo
+     << ",\"time\":" << ndn::time::toUnixTimestamp(ndn::time::system_clock::now()).count()
+     << ",\"type\":\"" << type << "\"," << members << "}\n";
+  auto line = std::make_shared<const std::string>(os.str());
+
+  for (const auto& client : m_clients) {
+    if (!client->isClosed() && !client->send(line, m_maxClientBacklog)) {
+      NLSR_LOG_WARN("Disconnecting event stream client more than " << m_maxClientBacklog
+                    << " bytes behind");
+      client->close();
+      ++m_nDroppedClients;
+    }
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_EVENT_STREAM_HPP
+#define NLSR_PUBLISHER_EVENT_STREAM_HPP
+
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/util/signal.hpp>
+
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nlsr {
+
+class AdjacencyList;
+class Fib;
+class LinkCostManager;
+class Lsdb;
+class RoutingTable;
+
+/*! \brief Streams changes of the routing state to local consumers over a Unix stream socket.
+ *
+ * Each event is written as one line of JSON, with a sequence number, the system time in
+ * milliseconds, a type and the members of that type:
+ *  - adjacency: neighbor, status, previous: a neighbor went up or down
+ *  - link-cost: neighbor, cost, previous: the advertised cost of a link changed
+ *  - lsa: origin, lsaType, seqNo, update: an LSA was installed, updated or removed
+ *  - routing: added, changed, removed: the delta of a routing table calculation
+ *  - fib: name, nexthops: the next hops of a FIB entry changed; none when it is removed
+ *
+ * Events are formatted once and queued to each client, whose socket is written
+ * asynchronously, so that a slow consumer cannot block routing. A client with more than
+ * maxClientBacklog bytes of unwritten events is disconnected instead, so a connected client
+ * always sees consecutive sequence numbers. Nothing is formatted while no client is connected.
+ */
+class EventStream : boost::noncopyable
+{
+public:
+  static constexpr size_t DEFAULT_MAX_CLIENT_BACKLOG = 1 << 20;
+
+  EventStream(boost::asio::io_context& io, AdjacencyList& adjacencyList, Lsdb& lsdb,
+              RoutingTable& rt, Fib& fib, LinkCostManager& linkCostManager,
+              size_t maxClientBacklog = DEFAULT_MAX_CLIENT_BACKLOG);
+
+  ~EventStream();
+
+  /*! \brief Listen on the Unix socket at \p path , replacing a stale socket file.
+   *  \throw boost::system::system_error the socket cannot be bound
+   */
+  void
+  listen(const std::string& path);
+
+  void
+  close();
+
+  /*! \brief Returns the sequence number of the last event, 0 before the first one.
+   */
+  uint64_t
+  getLastSeqNo() const
+  {
+    return m_lastSeqNo;
+  }
+
+  size_t
+  getClientCount() const
+  {
+    return m_clients.size();
+  }
+
+  /*! \brief Returns how many clients were disconnected for falling behind.
+   */
+  size_t
+  getDroppedClientCount() const
+  {
+    return m_nDroppedClients;
+  }
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Send an event of \p type , with the JSON object members \p members , to all clients.
+   */
+  void
+  publish(std::string_view type, std::string_view members);
+
+  bool
+  hasClients();
+
+private:
+  class Client;
+
+  void
+  accept();
+
+private:
+  boost::asio::local::stream_protocol::acceptor m_acceptor;
+  std::string m_path;
+  size_t m_maxClientBacklog;
+  std::vector<std::shared_ptr<Client>> m_clients;
+  uint64_t m_lastSeqNo = 0;
+  size_t m_nDroppedClients = 0;
+  std::vector<ndn::signal::ScopedConnection> m_signalConnections;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_EVENT_STREAM_HPP
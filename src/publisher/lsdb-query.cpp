@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsdb-query.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <algorithm>
+
+namespace nlsr {
+
+bool
+LsdbQuery::matches(const Lsa& lsa) const
+{
+  if ((originRouter && lsa.getOriginRouter() != *originRouter) ||
+      lsa.getSeqNo() < minSeqNo || lsa.getSeqNo() > maxSeqNo ||
+      (continuation && lsa.getOriginRouter() <= *continuation)) {
+    return false;
+  }
+  if (!prefix) {
+    return true;
+  }
+  return lsa.getType() == Lsa::Type::NAME &&
+         !getMatchingPrefixes(static_cast<const NameLsa&>(lsa)).empty();
+}
+
+ndn::span<const PrefixInfo>
+LsdbQuery::getMatchingPrefixes(const NameLsa& lsa) const
+{
+  auto prefixes = lsa.getNpl().getPrefixes();
+  if (!prefix) {
+    return prefixes;
+  }
+
+  // the prefixes under the filter are contiguous in canonical order
+  auto first = std::lower_bound(prefixes.begin(), prefixes.end(), *prefix,
+                                [] (const PrefixInfo& info, const ndn::Name& name) {
+                                  return info.getName() < name;
+                                });
+  auto last = std::find_if(first, prefixes.end(), [this] (const PrefixInfo& info) {
+    return !prefix->isPrefixOf(info.getName());
+  });
+  return prefixes.subspan(static_cast<size_t>(first - prefixes.begin()),
+                          static_cast<size_t>(last - first));
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+LsdbQuery::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  if (continuation) {
+    totalLength += prependNestedBlock(block, nlsr::tlv::ContinuationToken, *continuation);
+  }
+  if (pageSize != 0) {
+    totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::PageSize, pageSize);
+  }
+  if (maxSeqNo != std::numeric_limits<uint64_t>::max()) {
+    totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::MaxSequenceNumber, maxSeqNo);
+  }
+  if (minSeqNo != 0) {
+    totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::MinSequenceNumber, minSeqNo);
+  }
+  if (prefix) {
+    totalLength += prependNestedBlock(block, nlsr::tlv::PrefixFilter, *prefix);
+  }
+  if (originRouter) {
+    totalLength += prependNestedBlock(block, nlsr::tlv::OriginRouter, *originRouter);
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::LsdbQuery);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(LsdbQuery);
+
+ndn::Block
+LsdbQuery::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  return buffer.block();
+}
+
+void
+LsdbQuery::wireDecode(const ndn::Block& wire)
+{
+  *this = {};
+
+  if (wire.type() != nlsr::tlv::LsdbQuery) {
+    NDN_THROW(Error("LsdbQuery", wire.type()));
+  }
+
+  wire.parse();
+  auto val = wire.elements_begin();
+  auto decodeName = [&] (uint32_t type, std::optional<ndn::Name>& name) {
+    if (val != wire.elements_end() && val->type() == type) {
+      name.emplace(val->blockFromValue());
+      ++val;
+    }
+  };
+  auto decodeNumber = [&] (uint32_t type, uint64_t& number) {
+    if (val != wire.elements_end() && val->type() == type) {
+      number = ndn::encoding::readNonNegativeInteger(*val);
+      ++val;
+    }
+  };
+
+  decodeName(nlsr::tlv::OriginRouter, originRouter);
+  decodeName(nlsr::tlv::PrefixFilter, prefix);
+  decodeNumber(nlsr::tlv::MinSequenceNumber, minSeqNo);
+  decodeNumber(nlsr::tlv::MaxSequenceNumber, maxSeqNo);
+  decodeNumber(nlsr::tlv::PageSize, pageSize);
+  decodeName(nlsr::tlv::ContinuationToken, continuation);
+
+  if (val != wire.elements_end()) {
+    NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(val->type()) +
+                    " in LsdbQuery"));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const LsdbQuery& query)
+{
+  os << "LsdbQuery(";
+  if (query.originRouter) {
+    os << "router=" << *query.originRouter << " ";
+  }
+  if (query.prefix) {
+    os << "prefix=" << *query.prefix << " ";
+  }
+  os << "seq=" << query.minSeqNo << "-" << query.maxSeqNo;
+  if (query.pageSize != 0) {
+    os << " page-size=" << query.pageSize;
+  }
+  if (query.continuation) {
+    os << " after=" << *query.continuation;
+  }
+  return os << ")";
+}
+
+} // namespace nlsr
@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_LSDB_QUERY_HPP
+#define NLSR_PUBLISHER_LSDB_QUERY_HPP
+
+#include "lsa/name-lsa.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <limits>
+#include <optional>
+
+namespace nlsr {
+
+/*! \brief Filter and page of an LSDB dataset, carried in the name component that follows
+ *         lsdb/adjacencies, lsdb/coordinates or lsdb/names.
+ *
+ *     LsdbQuery = LSDB-QUERY-TYPE TLV-LENGTH
+ *                   [OriginRouter]
+ *                   [PrefixFilter]
+ *                   [MinSequenceNumber]
+ *                   [MaxSequenceNumber]
+ *                   [PageSize]
+ *                   [ContinuationToken]
+ *
+ *     OriginRouter = ORIGIN-ROUTER-TYPE TLV-LENGTH Name
+ *     PrefixFilter = PREFIX-FILTER-TYPE TLV-LENGTH Name
+ *     MinSequenceNumber = MIN-SEQUENCE-NUMBER-TYPE TLV-LENGTH NonNegativeInteger
+ *     MaxSequenceNumber = MAX-SEQUENCE-NUMBER-TYPE TLV-LENGTH NonNegativeInteger
+ *     PageSize = PAGE-SIZE-TYPE TLV-LENGTH NonNegativeInteger
+ *     ContinuationToken = CONTINUATION-TOKEN-TYPE TLV-LENGTH Name
+ *
+ * The LSAs of a page are in the order of their origin routers. When more LSAs match, the
+ * page is followed by a ContinuationToken, which the query of the next page carries.
+ */
+class LsdbQuery
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  LsdbQuery() = default;
+
+  explicit
+  LsdbQuery(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  /*! \brief Returns whether \p lsa is selected by the query, regardless of the page.
+   *
+   * With a PrefixFilter, only the Name LSAs which advertise a prefix under it are selected.
+   */
+  bool
+  matches(const Lsa& lsa) const;
+
+  /*! \brief Returns the prefixes of \p lsa under the PrefixFilter, or all of them without one.
+   */
+  ndn::span<const PrefixInfo>
+  getMatchingPrefixes(const NameLsa& lsa) const;
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+public:
+  std::optional<ndn::Name> originRouter;
+  std::optional<ndn::Name> prefix;
+  uint64_t minSeqNo = 0;
+  uint64_t maxSeqNo = std::numeric_limits<uint64_t>::max();
+  /// LSAs per page, 0 for all of them
+  uint64_t pageSize = 0;
+  /// origin router of the last LSA of the previous page
+  std::optional<ndn::Name> continuation;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LsdbQuery& query);
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_LSDB_QUERY_HPP
@@ -0,0 +1,524 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "metrics-exporter.hpp"
+#include "adjacency-list.hpp"
+#include "async-log-sink.hpp"
+#include "link-cost-manager.hpp"
+#include "logger.hpp"
+#include "lsdb.hpp"
+#include "route/fib.hpp"
+#include "route/name-prefix-table.hpp"
+#include "route/routing-table.hpp"
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/write.hpp>
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+#include <unistd.h>
+
+namespace nlsr {
+
+INIT_LOGGER(MetricsExporter);
+
+namespace {
+
+constexpr std::array<const char*, Statistics::N_PACKET_TYPES> PACKET_TYPE_NAMES{
+  "sent_hello_interest",
+  "sent_hello_data",
+  "rcv_hello_interest",
+  "rcv_hello_data",
+  "sent_lsa_interest",
+  "sent_adj_lsa_interest",
+  "sent_coord_lsa_interest",
+  "sent_name_lsa_interest",
+  "sent_lsa_data",
+  "sent_adj_lsa_data",
+  "sent_coord_lsa_data",
+  "sent_name_lsa_data",
+  "rcv_lsa_interest",
+  "rcv_adj_lsa_interest",
+  "rcv_coord_lsa_interest",
+  "rcv_name_lsa_interest",
+  "rcv_lsa_data",
+  "rcv_adj_lsa_data",
+  "rcv_coord_lsa_data",
+  "rcv_name_lsa_data",
+  "deferred_lsa",
+  "rejected_lsa",
+};
+
+constexpr std::array<const char*, static_cast<size_t>(Lsa::Type::BASE)> LSA_TYPE_NAMES{
+  "adjacency",
+  "coordinate",
+  "name",
+};
+
+/// The largest request header that is read; scrapers send a few hundred bytes.
+constexpr size_t MAX_REQUEST_SIZE = 8192;
+
+void
+writeFamily(std::ostream& os, std::string_view name, std::string_view type, std::string_view help)
+{
+  os << "# TYPE " << name << ' ' << type << '\n'
+     << "# HELP " << name << ' ' << help << '\n';
+}
+
+std::string
+escapeLabelValue(std::string_view value)
+{
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value) {
+    switch (c) {
+      case '\\':
+        escaped += "\\\\";
+        break;
+      case '"':
+        escaped += "\\\"";
+        break;
+      case '\n':
+        escaped += "\\n";
+        break;
+      default:
+        escaped += c;
+        break;
+    }
+  }
+  return escaped;
+}
+
+double
+toSeconds(ndn::time::microseconds duration)
+{
+  return static_cast<double>(duration.count()) / 1000000;
+}
+
+} // namespace
+
+class MetricsExporter::ConnectionBase
+{
+public:
+  virtual
+  ~ConnectionBase() = default;
+
+  virtual void
+  close() = 0;
+};
+
+template<typename Protocol>
+class MetricsExporter::Connection : public ConnectionBase,
+                                    public std::enable_shared_from_this<Connection<Protocol>>
+{
+public:
+  Connection(MetricsExporter& exporter, typename Protocol::socket socket)
+    : m_exporter(exporter)
+    , m_socket(std::move(socket))
+    , m_request(MAX_REQUEST_SIZE, '\0')
+  {
+  }
+
+  void
+  read()
+  {
+    m_socket.async_read_some(boost::asio::buffer(m_request.data() + m_size, m_request.size() - m_size),
+      [self = this->shared_from_this()] (const boost::system::error_code& error, size_t nBytes) {
+        self->onRead(error, nBytes);
+      });
+  }
+
+  void
+  close() final
+  {
+    m_isClosed = true;
+    boost::system::error_code error;
+    m_socket.close(error);
+  }
+
+private:
+  void
+  onRead(const boost::system::error_code& error, size_t nBytes)
+  {
+    if (m_isClosed) {
+      // the exporter may be gone already
+      return;
+    }
+    if (error) {
+      if (error != boost::asio::error::operation_aborted) {
+        NLSR_LOG_DEBUG("Metrics export connection closed: " << error.message());
+      }
+      return;
+    }
+    m_size += nBytes;
+
+    std::string_view request(m_request.data(), m_size);
+    if (request.find("\r\n\r\n") == std::string_view::npos &&
+        request.find("\n\n") == std::string_view::npos) {
+      if (m_size == m_request.size()) {
+        NLSR_LOG_WARN("Closing metrics export connection after oversized request");
+        close();
+        return;
+      }
+      read();
+      return;
+    }
+
+    // HTTP/1.0: one response per connection, which is then closed
+    m_response = m_exporter.makeResponse(request);
+    boost::asio::async_write(m_socket, boost::asio::buffer(m_response),
+      [self = this->shared_from_this()] (const boost::system::error_code& error, size_t) {
+        if (error && error != boost::asio::error::operation_aborted) {
+          NLSR_LOG_DEBUG("Cannot write metrics: " << error.message());
+        }
+        self->close();
+      });
+  }
+
+private:
+  MetricsExporter& m_exporter;
+  typename Protocol::socket m_socket;
+  std::string m_request;
+  size_t m_size = 0;
+  std::string m_response;
+  bool m_isClosed = false;
+};
+
+MetricsExporter::MetricsExporter(boost::asio::io_context& io, const Lsdb& lsdb,
+                                 const RoutingTable& rt, const NamePrefixTable& npt,
+                                 const Fib& fib, const Statistics& stats,
+                                 const LinkCostManager& linkCostManager,
+                                 const AdjacencyList& adjacencyList)
+  : m_lsdb(lsdb)
+  , m_routingTable(rt)
+  , m_namePrefixTable(npt)
+  , m_fib(fib)
+  , m_stats(stats)
+  , m_linkCostManager(linkCostManager)
+  , m_adjacencyList(adjacencyList)
+  , m_localAcceptor(io)
+  , m_tcpAcceptor(io)
+{
+}
+
+MetricsExporter::~MetricsExporter()
+{
+  close();
+}
+
+void
+MetricsExporter::listen(const std::string& path)
+{
+  if (m_localAcceptor.is_open()) {
+    boost::system::error_code error;
+    m_localAcceptor.close(error);
+    ::unlink(m_path.data());
+  }
+
+  ::unlink(path.data());
+  boost::asio::local::stream_protocol::endpoint endpoint(path);
+  m_localAcceptor.open(endpoint.protocol());
+  m_localAcceptor.bind(endpoint);
+  m_localAcceptor.listen();
+  m_path = path;
+
+  NLSR_LOG_INFO("Exporting metrics on " << path);
+  accept(m_localAcceptor);
+}
+
+void
+MetricsExporter::listen(uint16_t port)
+{
+  if (m_tcpAcceptor.is_open()) {
+    boost::system::error_code error;
+    m_tcpAcceptor.close(error);
+  }
+
+  boost::asio::ip::tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(), port);
+  m_tcpAcceptor.open(endpoint.protocol());
+  m_tcpAcceptor.set_option(boost::asio::ip::tcp::acceptor::reuse_address(true));
+  m_tcpAcceptor.bind(endpoint);
+  m_tcpAcceptor.listen();
+
+  NLSR_LOG_INFO("Exporting metrics on " << m_tcpAcceptor.local_endpoint());
+  accept(m_tcpAcceptor);
+}
+
+void
+MetricsExporter::close()
+{
+  for (const auto& weakConnection : m_connections) {
+    if (auto connection = weakConnection.lock()) {
+      connection->close();
+    }
+  }
+  m_connections.clear();
+
+  boost::system::error_code error;
+  if (m_localAcceptor.is_open()) {
+    m_localAcceptor.close(error);
+    ::unlink(m_path.data());
+  }
+  if (m_tcpAcceptor.is_open()) {
+    m_tcpAcceptor.close(error);
+  }
+}
+
+template<typename Acceptor>
+void
+MetricsExporter::accept(Acceptor& acceptor)
+{
+  using Protocol = typename Acceptor::protocol_type;
+
+  acceptor.async_accept(
+    [this, &acceptor] (const boost::system::error_code& error, typename Protocol::socket socket) {
+      if (error) {
+        if (error != boost::asio::error::operation_aborted) {
+          NLSR_LOG_ERROR("Cannot accept metrics export connection: " << error.message());
+        }
+        return;
+      }
+
+      auto connection = std::make_shared<Connection<Protocol>>(*this, std::move(socket));
+      // forget the connections that were closed since the last accept
+      m_connections.erase(std::remove_if(m_connections.begin(), m_connections.end(),
+                                         [] (const auto& c) { return c.expired(); }),
+                          m_connections.end());
+      m_connections.push_back(connection);
+      connection->read();
+      accept(acceptor);
+    });
+}
+
+std::string
+MetricsExporter::makeResponse(std::string_view request)
+{
+  if (request.substr(0, 4) != "GET ") {
+    return "HTTP/1.0 405 Method Not Allowed\r\n"
+           "Allow: GET\r\n"
+           "Content-Length: 0\r\n"
+           "\r\n";
+  }
+
+  ++m_nScrapes;
+  std::string body = render(collect());
+  std::string response = "HTTP/1.0 200 OK\r\n"
+                         "Content-Type: application/openmetrics-text; version=1.0.0; charset=utf-8\r\n"
+                         "Content-Length: " + std::to_string(body.size()) + "\r\n"
+                         "\r\n";
+  response += body;
+  return response;
+}
+
+MetricsExporter::Snapshot
+MetricsExporter::collect() const
+{
+  Snapshot snapshot;
+  snapshot.packets = m_stats.getSnapshot();
+
+  auto lsdb = m_lsdb.getSnapshot();
+  for (size_t type = 0; type < snapshot.lsas.size(); ++type) {
+    snapshot.lsas[type] = lsdb->getLsas(static_cast<Lsa::Type>(type)).size();
+    snapshot.ownLsaSegments[type] = m_lsdb.getOwnLsaSegmentCount(static_cast<Lsa::Type>(type));
+  }
+
+  snapshot.routingTableEntries = m_routingTable.getRoutingTableEntry().size();
+  snapshot.namePrefixTableEntries = m_namePrefixTable.size();
+  snapshot.fibEntries = m_fib.size();
+  snapshot.calculationProfile = m_routingTable.getCalculationProfile().getStatus();
+
+  snapshot.links = m_linkCostManager.getLinkCostStatistics();
+  for (const auto& adjacent : m_adjacencyList.getAdjList()) {
+    snapshot.linkCosts.emplace_back(adjacent.getName(), adjacent.getLinkCost());
+  }
+
+  if (auto ml = m_routingTable.getMLAdaptiveCalculator(); ml != nullptr) {
+    snapshot.ml = ml->getStatistics();
+  }
+
+  snapshot.lsaFetchesQueued = m_lsdb.getLsaFetchQueueSize();
+  snapshot.lsaFetchesInFlight = m_lsdb.getLsaFetchesInFlight();
+  snapshot.ribCommandsQueued = m_fib.getQueuedRibCommands();
+  snapshot.ribCommandsInFlight = m_fib.getRibCommandsInFlight();
+  snapshot.syncIbfCells = m_lsdb.getSync().getIbfCount();
+  snapshot.syncIbfResizes = m_lsdb.getSync().getIbfResizeCount();
+  snapshot.droppedLogRecords = AsyncLogSink::getDroppedRecords();
+  snapshot.shadow = m_routingTable.getShadowComparison().getStatus();
+  return snapshot;
+}
+
+std::string
+MetricsExporter::render(const Snapshot& snapshot)
+{
+  std::ostringstream os;
+  // durations are exact to the microsecond
+  os << std::fixed << std::setprecision(6);
+
+  writeFamily(os, "nlsr_packets", "counter", "Hello and LSA packets sent and received.");
+  for (size_t type = 0; type < snapshot.packets.size(); ++type) {
+    os << "nlsr_packets_total{type=\"" << PACKET_TYPE_NAMES[type] << "\"} "
+       << snapshot.packets[type] << '\n';
+  }
+
+  writeFamily(os, "nlsr_lsdb_lsas", "gauge", "LSAs in the LSDB.");
+  for (size_t type = 0; type < snapshot.lsas.size(); ++type) {
+    os << "nlsr_lsdb_lsas{type=\"" << LSA_TYPE_NAMES[type] << "\"} " << snapshot.lsas[type] << '\n';
+  }
+  writeFamily(os, "nlsr_own_lsa_segments", "gauge",
+              "Signed segments of the current version of each of our LSAs.");
+  for (size_t type = 0; type < snapshot.ownLsaSegments.size(); ++type) {
+    os << "nlsr_own_lsa_segments{type=\"" << LSA_TYPE_NAMES[type] << "\"} "
+       << snapshot.ownLsaSegments[type] << '\n';
+  }
+
+  writeFamily(os, "nlsr_routing_table_entries", "gauge", "Destinations in the routing table.");
+  os << "nlsr_routing_table_entries " << snapshot.routingTableEntries << '\n';
+  writeFamily(os, "nlsr_name_prefix_table_entries", "gauge", "Name prefixes in the NPT.");
+  os << "nlsr_name_prefix_table_entries " << snapshot.namePrefixTableEntries << '\n';
+  writeFamily(os, "nlsr_fib_entries", "gauge", "Name prefixes in the FIB.");
+  os << "nlsr_fib_entries " << snapshot.fibEntries << '\n';
+
+  const auto& phases = snapshot.calculationProfile.getPhases();
+  writeFamily(os, "nlsr_calculation_phase_seconds", "summary",
+              "Durations of the phases of the recent routing calculations.");
+  for (const auto& timing : phases) {
+    auto phase = escapeLabelValue(timing.phase);
+    os << "nlsr_calculation_phase_seconds{phase=\"" << phase << "\",quantile=\"0.5\"} "
+       << toSeconds(timing.median) << '\n'
+       << "nlsr_calculation_phase_seconds{phase=\"" << phase << "\",quantile=\"0.9\"} "
+       << toSeconds(timing.p90) << '\n'
+       << "nlsr_calculation_phase_seconds{phase=\"" << phase << "\",quantile=\"1\"} "
+       << toSeconds(timing.max) << '\n'
+       << "nlsr_calculation_phase_seconds_count{phase=\"" << phase << "\"} "
+       << timing.count << '\n';
+  }
+  writeFamily(os, "nlsr_calculation_phase_last_seconds", "gauge",
+              "Duration of each phase in the last routing calculation.");
+  for (const auto& timing : phases) {
+    os << "nlsr_calculation_phase_last_seconds{phase=\"" << escapeLabelValue(timing.phase) << "\"} "
+       << toSeconds(timing.last) << '\n';
+  }
+
+  writeFamily(os, "nlsr_link_rtt_seconds", "summary", "RTT samples of each neighbor link.");
+  for (const auto& link : snapshot.links) {
+    auto neighbor = escapeLabelValue(link.neighbor.toUri());
+    if (link.nSamples > 0) {
+      os << "nlsr_link_rtt_seconds{neighbor=\"" << neighbor << "\",quantile=\"0.5\"} "
+         << toSeconds(link.rttP50) << '\n'
+         << "nlsr_link_rtt_seconds{neighbor=\"" << neighbor << "\",quantile=\"0.9\"} "
+         << toSeconds(link.rttP90) << '\n'
+         << "nlsr_link_rtt_seconds{neighbor=\"" << neighbor << "\",quantile=\"0.99\"} "
+         << toSeconds(link.rttP99) << '\n'
+         << "nlsr_link_rtt_seconds{neighbor=\"" << neighbor << "\",quantile=\"1\"} "
+         << toSeconds(link.rttMax) << '\n';
+    }
+    os << "nlsr_link_rtt_seconds_count{neighbor=\"" << neighbor << "\"} " << link.nSamples << '\n';
+  }
+  writeFamily(os, "nlsr_link_probes", "counter", "RTT probes sent to each neighbor.");
+  for (const auto& link : snapshot.links) {
+    os << "nlsr_link_probes_total{neighbor=\"" << escapeLabelValue(link.neighbor.toUri()) << "\"} "
+       << link.nProbes << '\n';
+  }
+  writeFamily(os, "nlsr_link_probe_timeouts", "counter", "RTT probes that timed out.");
+  for (const auto& link : snapshot.links) {
+    os << "nlsr_link_probe_timeouts_total{neighbor=\"" << escapeLabelValue(link.neighbor.toUri())
+       << "\"} " << link.nProbeTimeouts << '\n';
+  }
+  writeFamily(os, "nlsr_link_cost_changes", "counter",
+              "Changes of the cost of each neighbor link.");
+  for (const auto& link : snapshot.links) {
+    os << "nlsr_link_cost_changes_total{neighbor=\"" << escapeLabelValue(link.neighbor.toUri())
+       << "\"} " << link.nCostChanges << '\n';
+  }
+  writeFamily(os, "nlsr_link_cost", "gauge", "Current cost of each neighbor link.");
+  for (const auto& [neighbor, cost] : snapshot.linkCosts) {
+    os << "nlsr_link_cost{neighbor=\"" << escapeLabelValue(neighbor.toUri()) << "\"} "
+       << cost << '\n';
+  }
+
+  if (snapshot.ml) {
+    writeFamily(os, "nlsr_ml_predictions", "counter",
+                "Link cost predictions of the ML-adaptive calculator.");
+    os << "nlsr_ml_predictions_total " << snapshot.ml->predictionCount << '\n';
+    writeFamily(os, "nlsr_ml_model_updates", "counter", "Updates of the ML-adaptive models.");
+    os << "nlsr_ml_model_updates_total " << snapshot.ml->modelUpdateCount << '\n';
+    writeFamily(os, "nlsr_ml_pattern_detections", "counter", "Traffic patterns detected.");
+    os << "nlsr_ml_pattern_detections_total " << snapshot.ml->patternDetectionCount << '\n';
+    writeFamily(os, "nlsr_ml_prediction_error", "gauge", "Average error of the predictions.");
+    os << "nlsr_ml_prediction_error " << snapshot.ml->averagePredictionError << '\n';
+  }
+
+  writeFamily(os, "nlsr_lsa_fetches_queued", "gauge",
+              "LSA fetches waiting for a slot in the fetch window.");
+  os << "nlsr_lsa_fetches_queued " << snapshot.lsaFetchesQueued << '\n';
+  writeFamily(os, "nlsr_lsa_fetches_in_flight", "gauge", "LSAs being fetched.");
+  os << "nlsr_lsa_fetches_in_flight " << snapshot.lsaFetchesInFlight << '\n';
+  writeFamily(os, "nlsr_rib_commands_queued", "gauge",
+              "RIB commands waiting for a slot in the command window.");
+  os << "nlsr_rib_commands_queued " << snapshot.ribCommandsQueued << '\n';
+  writeFamily(os, "nlsr_rib_commands_in_flight", "gauge",
+              "RIB commands sent to NFD and not answered yet.");
+  os << "nlsr_rib_commands_in_flight " << snapshot.ribCommandsInFlight << '\n';
+  writeFamily(os, "nlsr_sync_ibf_cells", "gauge",
+              "Cells of the PSync IBF of our area's sync group; 0 with other sync protocols.");
+  os << "nlsr_sync_ibf_cells " << snapshot.syncIbfCells << '\n';
+  writeFamily(os, "nlsr_sync_ibf_resizes", "counter",
+              "PSync IBFs resized because sync-expected-routers was reloaded.");
+  os << "nlsr_sync_ibf_resizes_total " << snapshot.syncIbfResizes << '\n';
+  writeFamily(os, "nlsr_log_records_dropped", "counter",
+              "Log records dropped because the async-logging queue was full.");
+  os << "nlsr_log_records_dropped_total " << snapshot.droppedLogRecords << '\n';
+
+  if (!snapshot.shadow.empty()) {
+    writeFamily(os, "nlsr_shadow_calculations", "counter",
+                "Routes of each calculator compared with the live routes.");
+    for (const auto& status : snapshot.shadow) {
+      os << "nlsr_shadow_calculations_total{calculator=\"" << status.calculator << "\"} "
+         << status.nCalculations << '\n';
+    }
+    writeFamily(os, "nlsr_shadow_next_hop_disagreements", "gauge",
+                "Live destinations whose best next hop differs with each calculator.");
+    for (const auto& status : snapshot.shadow) {
+      os << "nlsr_shadow_next_hop_disagreements{calculator=\"" << status.calculator << "\"} "
+         << status.nNextHopDisagreements << '\n';
+    }
+    writeFamily(os, "nlsr_shadow_path_stretch", "gauge",
+                "Cost of the paths of each calculator over the shortest advertised paths.");
+    for (const auto& status : snapshot.shadow) {
+      os << "nlsr_shadow_path_stretch{calculator=\"" << status.calculator << "\",stat=\"mean\"} "
+         << status.meanStretch << '\n'
+         << "nlsr_shadow_path_stretch{calculator=\"" << status.calculator << "\",stat=\"max\"} "
+         << status.maxStretch << '\n';
+    }
+    writeFamily(os, "nlsr_shadow_fib_churn", "counter",
+                "Next hops each calculator added or removed from one calculation to the next.");
+    for (const auto& status : snapshot.shadow) {
+      os << "nlsr_shadow_fib_churn_total{calculator=\"" << status.calculator << "\"} "
+         << status.nNextHopChanges << '\n';
+    }
+  }
+
+  os << "# EOF\n";
+  return os.str();
+}
+
+} // namespace nlsr
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_METRICS_EXPORTER_HPP
+#define NLSR_PUBLISHER_METRICS_EXPORTER_HPP
+
+#include "link-metrics-status.hpp"
+#include "lsa/lsa.hpp"
+#include "route/calculation-profile.hpp"
+#include "route/ml-adaptive-calculator.hpp"
+#include "route/shadow-comparison.hpp"
+#include "statistics.hpp"
+
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace nlsr {
+
+class AdjacencyList;
+class Fib;
+class LinkCostManager;
+class Lsdb;
+class NamePrefixTable;
+class RoutingTable;
+
+/*! \brief Serves the internals of NLSR as OpenMetrics text, e.g. for Prometheus.
+ *
+ * Each HTTP GET received on the Unix socket or the TCP port of 127.0.0.1 is answered with the
+ * packet counters, LSDB, routing table, NPT and FIB sizes, routing calculation phase timings,
+ * per-link RTT, cost and probe statistics, ML-adaptive calculator statistics, the depth of
+ * the LSA fetch and RIB command queues, and the size of the PSync IBFs. They are collected on the io thread into a Snapshot of
+ * plain values, from counters, sizes and the shared LSDB snapshot only, so that a scrape costs
+ * no more than a dataset request; sockets are never read or written synchronously.
+ */
+class MetricsExporter : boost::noncopyable
+{
+public:
+  /*! \brief Values of the exported metrics at one instant.
+   */
+  struct Snapshot
+  {
+    Statistics::Snapshot packets{};
+    /// indexed by Lsa::Type
+    std::array<size_t, static_cast<size_t>(Lsa::Type::BASE)> lsas{};
+    /// segments of our own current LSAs, indexed by Lsa::Type
+    std::array<size_t, static_cast<size_t>(Lsa::Type::BASE)> ownLsaSegments{};
+    size_t routingTableEntries = 0;
+    size_t namePrefixTableEntries = 0;
+    size_t fibEntries = 0;
+    CalculationProfileStatus calculationProfile;
+    std::vector<LinkCostStatistics> links;
+    std::vector<std::pair<ndn::Name, double>> linkCosts;
+    /// unset until the first ML-adaptive calculation
+    std::optional<MLAdaptiveCalculator::Statistics> ml;
+    size_t lsaFetchesQueued = 0;
+    size_t lsaFetchesInFlight = 0;
+    size_t ribCommandsQueued = 0;
+    size_t ribCommandsInFlight = 0;
+    /// 0 with sync protocols other than PSync
+    size_t syncIbfCells = 0;
+    uint64_t syncIbfResizes = 0;
+    uint64_t droppedLogRecords = 0;
+    /// empty without routing-calc-shadow
+    std::vector<ShadowComparison::Status> shadow;
+  };
+
+  MetricsExporter(boost::asio::io_context& io, const Lsdb& lsdb, const RoutingTable& rt,
+                  const NamePrefixTable& npt, const Fib& fib, const Statistics& stats,
+                  const LinkCostManager& linkCostManager, const AdjacencyList& adjacencyList);
+
+  ~MetricsExporter();
+
+  /*! \brief Serve on the Unix socket at \p path , replacing a stale socket file.
+   *  \throw boost::system::system_error the socket cannot be bound
+   */
+  void
+  listen(const std::string& path);
+
+  /*! \brief Serve on \p port of 127.0.0.1.
+   *  \throw boost::system::system_error the port cannot be bound
+   */
+  void
+  listen(uint16_t port);
+
+  void
+  close();
+
+  Snapshot
+  collect() const;
+
+  /*! \brief Format \p snapshot in the OpenMetrics text format, ending with "# EOF".
+   */
+  static std::string
+  render(const Snapshot& snapshot);
+
+  size_t
+  getScrapeCount() const
+  {
+    return m_nScrapes;
+  }
+
+private:
+  class ConnectionBase;
+
+  template<typename Protocol>
+  class Connection;
+
+  template<typename Acceptor>
+  void
+  accept(Acceptor& acceptor);
+
+  std::string
+  makeResponse(std::string_view request);
+
+private:
+  const Lsdb& m_lsdb;
+  const RoutingTable& m_routingTable;
+  const NamePrefixTable& m_namePrefixTable;
+  const Fib& m_fib;
+  const Statistics& m_stats;
+  const LinkCostManager& m_linkCostManager;
+  const AdjacencyList& m_adjacencyList;
+
+  boost::asio::local::stream_protocol::acceptor m_localAcceptor;
+  boost::asio::ip::tcp::acceptor m_tcpAcceptor;
+  std::string m_path;
+  std::vector<std::weak_ptr<ConnectionBase>> m_connections;
+  size_t m_nScrapes = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_METRICS_EXPORTER_HPP
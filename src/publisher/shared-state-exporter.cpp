@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shared-state-exporter.hpp"
+#include "link-cost-manager.hpp"
+#include "logger.hpp"
+#include "route/routing-table.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <system_error>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nlsr {
+
+INIT_LOGGER(SharedStateExporter);
+
+using namespace shared_state;
+
+namespace {
+
+constexpr size_t INITIAL_SIZE = 64 * 1024;
+
+size_t
+align(size_t offset)
+{
+  return (offset + alignof(uint64_t) - 1) & ~(alignof(uint64_t) - 1);
+}
+
+class RegionWriter
+{
+public:
+  RegionWriter(std::vector<uint8_t>& body, size_t stringsOffset)
+    : m_body(body)
+    , m_stringsOffset(stringsOffset)
+  {
+  }
+
+  template<typename T>
+  void
+  put(size_t offset, const T& record)
+  {
+    std::memcpy(m_body.data() + offset - sizeof(Header), &record, sizeof(record));
+  }
+
+  String
+  addString(const std::string& value)
+  {
+    String string{static_cast<uint32_t>(m_stringsOffset + m_strings.size()),
+                  static_cast<uint32_t>(value.size())};
+    m_strings += value;
+    return string;
+  }
+
+  template<typename T>
+  String
+  addString(const T& value)
+  {
+    return addString(boost::lexical_cast<std::string>(value));
+  }
+
+  void
+  finish()
+  {
+    m_body.insert(m_body.end(), m_strings.begin(), m_strings.end());
+  }
+
+private:
+  std::vector<uint8_t>& m_body;
+  const size_t m_stringsOffset;
+  std::string m_strings;
+};
+
+} // namespace
+
+SharedStateExporter::SharedStateExporter(ndn::Scheduler& scheduler, const std::string& path,
+                                         RoutingTable& rt, const LinkCostManager& linkCostManager,
+                                         ndn::time::milliseconds refreshInterval)
+  : m_scheduler(scheduler)
+  , m_routingTable(rt)
+  , m_linkCostManager(linkCostManager)
+  , m_refreshInterval(refreshInterval)
+  , m_path(path)
+{
+  ::unlink(path.data());
+  m_fd = ::open(path.data(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (m_fd < 0) {
+    throw std::system_error(errno, std::generic_category(), "Cannot create " + path);
+  }
+  try {
+    resize(INITIAL_SIZE);
+  }
+  catch (const std::system_error&) {
+    ::close(m_fd);
+    ::unlink(path.data());
+    throw;
+  }
+
+  auto* header = new (m_region) Header{};
+  header->magic = MAGIC;
+  header->layoutVersion = LAYOUT_VERSION;
+  header->size = m_size;
+  write();
+
+  m_afterRoutingChangeConnection = rt.afterRoutingChange.connect([this] (const auto&) { write(); });
+  scheduleRefresh();
+  NLSR_LOG_INFO("Exporting the routing state in " << path);
+}
+
+SharedStateExporter::~SharedStateExporter()
+{
+  if (m_region != nullptr) {
+    ::munmap(m_region, m_size);
+  }
+  if (m_fd >= 0) {
+    ::close(m_fd);
+    ::unlink(m_path.data());
+  }
+}
+
+uint64_t
+SharedStateExporter::getSeqNo() const
+{
+  return reinterpret_cast<const Header*>(m_region)->seq.load(std::memory_order_relaxed);
+}
+
+std::vector<uint8_t>
+SharedStateExporter::encode(Header& header) const
+{
+  const auto& topology = m_routingTable.getTopologyExporter().getStatus();
+  const auto& routes = m_routingTable.getRoutingTableEntry();
+  auto links = m_linkCostManager.getLinkCostStatistics();
+
+  size_t nNextHops = 0;
+  for (const auto& route : routes) {
+    nNextHops += route.getNexthopList().size();
+  }
+
+  header.nRouters = topology.getRouters().size();
+  header.nLinks = topology.getLinks().size();
+  header.nRoutes = routes.size();
+  header.nNextHops = nNextHops;
+  header.nLinkMetrics = links.size();
+  header.routersOffset = align(sizeof(Header));
+  header.linksOffset = align(header.routersOffset + header.nRouters * sizeof(Router));
+  header.routesOffset = align(header.linksOffset + header.nLinks * sizeof(Link));
+  header.nextHopsOffset = align(header.routesOffset + header.nRoutes * sizeof(Route));
+  header.linkMetricsOffset = align(header.nextHopsOffset + header.nNextHops * sizeof(NextHop));
+  size_t stringsOffset = header.linkMetricsOffset + header.nLinkMetrics * sizeof(LinkMetric);
+
+  std::vector<uint8_t> body(stringsOffset - sizeof(Header));
+  RegionWriter writer(body, stringsOffset);
+
+  size_t offset = header.routersOffset;
+  for (const auto& router : topology.getRouters()) {
+    writer.put(offset, Router{writer.addString(router)});
+    offset += sizeof(Router);
+  }
+
+  offset = header.linksOffset;
+  for (const auto& link : topology.getLinks()) {
+    writer.put(offset, Link{static_cast<uint32_t>(link.source),
+                            static_cast<uint32_t>(link.target), link.cost});
+    offset += sizeof(Link);
+  }
+
+  offset = header.routesOffset;
+  size_t nextHopOffset = header.nextHopsOffset;
+  uint32_t nextHopIndex = 0;
+  for (const auto& route : routes) {
+    const auto& hops = route.getNexthopList();
+    writer.put(offset, Route{writer.addString(route.getDestination()), nextHopIndex,
+                             static_cast<uint32_t>(hops.size())});
+    offset += sizeof(Route);
+    for (const auto& hop : hops) {
+      writer.put(nextHopOffset, NextHop{writer.addString(hop.getConnectingFaceUri()),
+                                        hop.getRouteCost()});
+      nextHopOffset += sizeof(NextHop);
+    }
+    nextHopIndex += hops.size();
+  }
+
+  offset = header.linkMetricsOffset;
+  for (const auto& link : links) {
+    writer.put(offset, LinkMetric{writer.addString(link.neighbor),
+                                  m_linkCostManager.getCurrentCost(link.neighbor),
+                                  link.nProbes, link.nProbeTimeouts, link.nCostChanges,
+                                  static_cast<uint64_t>(link.rttP50.count()),
+                                  static_cast<uint64_t>(link.rttP99.count())});
+    offset += sizeof(LinkMetric);
+  }
+
+  writer.finish();
+  return body;
+}
+
+void
+SharedStateExporter::write()
+{
+  Header counts{};
+  auto body = encode(counts);
+  size_t size = sizeof(Header) + body.size();
+  if (size > m_size) {
+    size_t newSize = m_size;
+    while (newSize < size) {
+      newSize *= 2;
+    }
+    resize(newSize);
+  }
+
+  auto* header = reinterpret_cast<Header*>(m_region);
+  uint64_t seq = header->seq.load(std::memory_order_relaxed);
+  header->seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  header->size = m_size;
+  header->timestamp = ndn::time::duration_cast<ndn::time::nanoseconds>(
+                        ndn::time::system_clock::now().time_since_epoch()).count();
+  header->nRouters = counts.nRouters;
+  header->routersOffset = counts.routersOffset;
+  header->nLinks = counts.nLinks;
+  header->linksOffset = counts.linksOffset;
+  header->nRoutes = counts.nRoutes;
+  header->routesOffset = counts.routesOffset;
+  header->nNextHops = counts.nNextHops;
+  header->nextHopsOffset = counts.nextHopsOffset;
+  header->nLinkMetrics = counts.nLinkMetrics;
+  header->linkMetricsOffset = counts.linkMetricsOffset;
+  std::memcpy(m_region + sizeof(Header), body.data(), body.size());
+
+  header->seq.store(seq + 2, std::memory_order_release);
+}
+
+void
+SharedStateExporter::resize(size_t size)
+{
+  if (::ftruncate(m_fd, size) != 0) {
+    throw std::system_error(errno, std::generic_category(), "Cannot resize " + m_path);
+  }
+  // readers remap once they see the new size in the header; the old bytes are kept
+  void* region = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+  if (region == MAP_FAILED) {
+    throw std::system_error(errno, std::generic_category(), "Cannot map " + m_path);
+  }
+  if (m_region != nullptr) {
+    ::munmap(m_region, m_size);
+  }
+  m_region = static_cast<uint8_t*>(region);
+  m_size = size;
+}
+
+void
+SharedStateExporter::scheduleRefresh()
+{
+  m_refreshEvent = m_scheduler.schedule(m_refreshInterval, [this] {
+    write();
+    scheduleRefresh();
+  });
+}
+
+} // namespace nlsr
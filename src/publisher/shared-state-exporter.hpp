@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_PUBLISHER_SHARED_STATE_EXPORTER_HPP
+#define NLSR_PUBLISHER_SHARED_STATE_EXPORTER_HPP
+
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+#include <ndn-cxx/util/signal.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace nlsr {
+
+class LinkCostManager;
+class RoutingTable;
+
+/*! \brief Binary layout of the shared routing state region.
+ *
+ * The region starts with a Header, followed by the arrays it gives the offsets of, in bytes
+ * from the start of the region, and by the strings they refer to. Numbers are in host byte
+ * order, as the region is only read by processes on the same host. Names and FaceUris are
+ * URI strings, not terminated by a null character.
+ *
+ * The region is published with a sequence lock: a reader loads Header::seq with acquire
+ * ordering, copies what it needs if seq is even, issues an acquire fence and loads seq again;
+ * the copy is consistent if both loads returned the same even number. A reader remaps the
+ * region when Header::size exceeds its mapping, as the region grows but never shrinks.
+ */
+namespace shared_state {
+
+/// "NLSR" in ASCII
+inline constexpr uint32_t MAGIC = 0x4e4c5352;
+inline constexpr uint32_t LAYOUT_VERSION = 1;
+
+struct String
+{
+  uint32_t offset;
+  uint32_t length;
+};
+
+struct Header
+{
+  uint32_t magic;
+  uint32_t layoutVersion;
+  /// incremented before and after each write: odd while the region is written
+  std::atomic<uint64_t> seq;
+  /// bytes of the region
+  uint64_t size;
+  /// system time of the last write, in nanoseconds since the Unix epoch
+  uint64_t timestamp;
+  uint32_t nRouters;
+  uint32_t routersOffset;
+  uint32_t nLinks;
+  uint32_t linksOffset;
+  uint32_t nRoutes;
+  uint32_t routesOffset;
+  uint32_t nNextHops;
+  uint32_t nextHopsOffset;
+  uint32_t nLinkMetrics;
+  uint32_t linkMetricsOffset;
+};
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free);
+
+/// router of the topology graph of the last link-state calculation, the n-th has index n
+struct Router
+{
+  String name;
+};
+
+/// link of the topology graph, once per pair of routers, with source < target
+struct Link
+{
+  uint32_t source;
+  uint32_t target;
+  double cost;
+};
+
+/// routing table entry, with nNextHops next hops from firstNextHop in the next hop array
+struct Route
+{
+  String destination;
+  uint32_t firstNextHop;
+  uint32_t nNextHops;
+};
+
+struct NextHop
+{
+  String faceUri;
+  double cost;
+};
+
+/// metrics of the link to a neighbor, as in the link-cost dataset
+struct LinkMetric
+{
+  String neighbor;
+  double cost;
+  uint64_t nProbes;
+  uint64_t nProbeTimeouts;
+  uint64_t nCostChanges;
+  uint64_t rttP50;
+  uint64_t rttP99;
+};
+
+} // namespace shared_state
+
+/*! \brief Publishes the topology, routing table and link metrics in a shared memory region.
+ *
+ * The region is a file mmap'd read-write by NLSR and read-only by co-located agents, with
+ * the layout of nlsr::shared_state. It is rewritten after each routing table publication and
+ * every refresh interval for the link metrics. Readers never block NLSR, and do not copy more
+ * than they read.
+ */
+class SharedStateExporter : boost::noncopyable
+{
+public:
+  /*! \brief Create the region file at \p path , replacing an existing one.
+   *  \throw std::system_error the file cannot be created or mapped
+   */
+  SharedStateExporter(ndn::Scheduler& scheduler, const std::string& path, RoutingTable& rt,
+                      const LinkCostManager& linkCostManager,
+                      ndn::time::milliseconds refreshInterval = ndn::time::seconds(1));
+
+  ~SharedStateExporter();
+
+  uint64_t
+  getSeqNo() const;
+
+  /*! \brief Write the current state to the region.
+   */
+  void
+  write();
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Encode the current state: the region after the Header, and the counts and
+   *         offsets of \p header .
+   */
+  std::vector<uint8_t>
+  encode(shared_state::Header& header) const;
+
+  const uint8_t*
+  getRegion() const
+  {
+    return m_region;
+  }
+
+private:
+  void
+  resize(size_t size);
+
+  void
+  scheduleRefresh();
+
+private:
+  ndn::Scheduler& m_scheduler;
+  const RoutingTable& m_routingTable;
+  const LinkCostManager& m_linkCostManager;
+  const ndn::time::milliseconds m_refreshInterval;
+  std::string m_path;
+  int m_fd = -1;
+  uint8_t* m_region = nullptr;
+  size_t m_size = 0;
+  ndn::signal::ScopedConnection m_afterRoutingChangeConnection;
+  ndn::scheduler::ScopedEventId m_refreshEvent;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_PUBLISHER_SHARED_STATE_EXPORTER_HPP
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "area-summarizer.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <map>
+
+namespace nlsr {
+
+INIT_LOGGER(route.AreaSummarizer);
+
+AreaSummarizer::AreaSummarizer(ndn::Scheduler& scheduler, const ConfParameter& confParam,
+                               Lsdb& lsdb, RoutingTable& routingTable)
+  : m_scheduler(scheduler)
+  , m_confParam(confParam)
+  , m_lsdb(lsdb)
+  , m_routingTable(routingTable)
+  , m_areas(confParam.getAreas())
+{
+  m_afterRoutingChange = m_routingTable.afterRoutingChange.connect([this] (const auto&) {
+    scheduleUpdate();
+  });
+  m_onLsdbModified = m_lsdb.onLsdbModified.connect(
+    [this] (const std::shared_ptr<Lsa>& lsa, auto&&...) {
+      if (lsa->getType() == Lsa::Type::NAME) {
+        scheduleUpdate();
+      }
+    });
+}
+
+void
+AreaSummarizer::scheduleUpdate()
+{
+  // coalesces the changes of a burst of LSAs
+  if (m_updateEvent) {
+    return;
+  }
+  m_updateEvent = m_scheduler.schedule(0_ms, [this] {
+    m_lsdb.setAreaSummaries(computeSummaries());
+  });
+}
+
+std::vector<AreaSummary>
+AreaSummarizer::computeSummaries()
+{
+  const ndn::Name& backbone = m_confParam.getBackboneArea();
+  bool isBackboneBorder = !backbone.empty() && m_areas.count(backbone) > 0;
+
+  std::map<ndn::Name, std::map<ndn::Name, double>> byArea;
+  auto addPrefix = [] (std::map<ndn::Name, double>& summary, const ndn::Name& name,
+                       double cost) {
+    auto [it, isNew] = summary.try_emplace(name, cost);
+    if (!isNew) {
+      it->second = std::min(it->second, cost);
+    }
+  };
+
+  auto [begin, end] = m_lsdb.getLsdbIterator<NameLsa>();
+  for (auto it = begin; it != end; ++it) {
+    const auto& lsa = static_cast<const NameLsa&>(**it);
+    const ndn::Name& origin = lsa.getOriginRouter();
+    if (origin == m_confParam.getRouterPrefix()) {
+      continue;
+    }
+    auto cost = getRouteCost(origin);
+    if (!cost) {
+      continue;
+    }
+
+    auto originAreas = getAreasOf(origin);
+    for (const auto& area : m_areas) {
+      // the LSAs of the origin are synchronized in that area already
+      if (originAreas.count(area) > 0) {
+        continue;
+      }
+      auto& summary = byArea[area];
+      addPrefix(summary, origin, *cost);
+      for (const auto& prefix : lsa.getNpl().getPrefixes()) {
+        addPrefix(summary, prefix.getName(), *cost + prefix.getCost());
+      }
+      if (isBackboneBorder && area != backbone) {
+        for (const auto& received : lsa.getAreaSummaries()) {
+          if (received.area != backbone) {
+            continue;
+          }
+          for (const auto& prefix : received.prefixes) {
+            addPrefix(summary, prefix.getName(), *cost + prefix.getCost());
+          }
+        }
+      }
+    }
+  }
+
+  std::vector<AreaSummary> summaries;
+  for (auto& [area, prefixes] : byArea) {
+    AreaSummary& summary = summaries.emplace_back();
+    summary.area = area;
+    summary.prefixes.reserve(prefixes.size());
+    for (const auto& [name, cost] : prefixes) {
+      summary.prefixes.emplace_back(name, cost);
+    }
+    NLSR_LOG_TRACE("Summary for area " << area << ": " << prefixes.size() << " prefixes");
+  }
+  return summaries;
+}
+
+std::set<ndn::Name>
+AreaSummarizer::getAreasOf(const ndn::Name& router) const
+{
+  std::set<ndn::Name> areas{m_confParam.getAreaOf(router)};
+  if (auto adjLsa = m_lsdb.findLsa<AdjLsa>(router); adjLsa != nullptr) {
+    for (const auto& adjacent : adjLsa->getAdl().getAdjList()) {
+      areas.insert(m_confParam.getAreaOf(adjacent.getName()));
+    }
+  }
+  return areas;
+}
+
+std::optional<double>
+AreaSummarizer::getRouteCost(const ndn::Name& router)
+{
+  const auto* entry = m_routingTable.findRoutingTableEntry(router);
+  if (entry == nullptr || entry->getNexthopList().size() == 0) {
+    return std::nullopt;
+  }
+  double cost = std::numeric_limits<double>::infinity();
+  for (const auto& nexthop : entry->getNexthopList()) {
+    cost = std::min(cost, nexthop.getRouteCost());
+  }
+  return cost;
+}
+
+} // namespace nlsr
@@ -0,0 +1,88 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_AREA_SUMMARIZER_HPP
+#define NLSR_ROUTE_AREA_SUMMARIZER_HPP
+
+#include "conf-parameter.hpp"
+#include "lsdb.hpp"
+#include "routing-table.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <optional>
+#include <set>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Computes the summaries that an area border router advertises into its areas.
+ *
+ * The summary advertised into an area holds the router names and the name prefixes of the
+ * routers that are not in that area, each with our cost to reach it. A border router of the
+ * backbone area also passes on into its other areas the summaries it receives in the backbone,
+ * but never the other way around, so that summaries cannot loop between border routers.
+ *
+ * The summaries are computed again shortly after each routing calculation and each change of
+ * a Name LSA, and put into our Name LSA when they change.
+ *
+ * \sa ConfParameter::setAreaDepth
+ */
+class AreaSummarizer : boost::noncopyable
+{
+public:
+  AreaSummarizer(ndn::Scheduler& scheduler, const ConfParameter& confParam, Lsdb& lsdb,
+                 RoutingTable& routingTable);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  std::vector<AreaSummary>
+  computeSummaries();
+
+  /*! \brief Returns the areas of \p router : its own, and those of the neighbors listed in its
+   *         Adjacency LSA, if we have it.
+   */
+  std::set<ndn::Name>
+  getAreasOf(const ndn::Name& router) const;
+
+private:
+  void
+  scheduleUpdate();
+
+  std::optional<double>
+  getRouteCost(const ndn::Name& router);
+
+private:
+  ndn::Scheduler& m_scheduler;
+  const ConfParameter& m_confParam;
+  Lsdb& m_lsdb;
+  RoutingTable& m_routingTable;
+  std::set<ndn::Name> m_areas;
+  ndn::scheduler::ScopedEventId m_updateEvent;
+  ndn::signal::ScopedConnection m_afterRoutingChange;
+  ndn::signal::ScopedConnection m_onLsdbModified;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_AREA_SUMMARIZER_HPP
@@ -0,0 +1,220 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "calculation-profile.hpp"
+#include "logger.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <algorithm>
+#include <sstream>
+
+namespace nlsr {
+
+INIT_LOGGER(route.CalculationProfile);
+
+template<ndn::encoding::Tag TAG>
+size_t
+CalculationProfileStatus::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto it = m_phases.rbegin(); it != m_phases.rend(); ++it) {
+    size_t phaseLength = 0;
+    phaseLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::MaxDuration, it->max.count());
+    phaseLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::P90Duration, it->p90.count());
+    phaseLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::MedianDuration,
+                                                  it->median.count());
+    phaseLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::LastDuration, it->last.count());
+    phaseLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::SampleCount, it->count);
+    phaseLength += prependStringBlock(block, nlsr::tlv::PhaseName, it->phase);
+    phaseLength += block.prependVarNumber(phaseLength);
+    phaseLength += block.prependVarNumber(nlsr::tlv::PhaseTiming);
+    totalLength += phaseLength;
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::CalculationProfile);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(CalculationProfileStatus);
+
+ndn::Block
+CalculationProfileStatus::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  return buffer.block();
+}
+
+void
+CalculationProfileStatus::wireDecode(const ndn::Block& wire)
+{
+  m_phases.clear();
+
+  if (wire.type() != nlsr::tlv::CalculationProfile) {
+    NDN_THROW(Error("CalculationProfile", wire.type()));
+  }
+
+  wire.parse();
+  for (const auto& element : wire.elements()) {
+    if (element.type() != nlsr::tlv::PhaseTiming) {
+      NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(element.type()) +
+                      " in CalculationProfile"));
+    }
+
+    element.parse();
+    const auto& fields = element.elements();
+    if (fields.size() != 6 ||
+        fields[0].type() != nlsr::tlv::PhaseName ||
+        fields[1].type() != nlsr::tlv::SampleCount ||
+        fields[2].type() != nlsr::tlv::LastDuration ||
+        fields[3].type() != nlsr::tlv::MedianDuration ||
+        fields[4].type() != nlsr::tlv::P90Duration ||
+        fields[5].type() != nlsr::tlv::MaxDuration) {
+      NDN_THROW(Error("Malformed PhaseTiming"));
+    }
+
+    using ndn::encoding::readNonNegativeInteger;
+    PhaseTiming timing;
+    timing.phase = readString(fields[0]);
+    timing.count = readNonNegativeInteger(fields[1]);
+    timing.last = ndn::time::microseconds(readNonNegativeInteger(fields[2]));
+    timing.median = ndn::time::microseconds(readNonNegativeInteger(fields[3]));
+    timing.p90 = ndn::time::microseconds(readNonNegativeInteger(fields[4]));
+    timing.max = ndn::time::microseconds(readNonNegativeInteger(fields[5]));
+    m_phases.push_back(std::move(timing));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const CalculationProfileStatus& status)
+{
+  os << "Routing Calculation Profile (microseconds):\n";
+  for (const auto& timing : status.getPhases()) {
+    os << "  " << timing.phase << ": count=" << timing.count
+       << " last=" << timing.last.count() << " median=" << timing.median.count()
+       << " p90=" << timing.p90.count() << " max=" << timing.max.count() << "\n";
+  }
+  return os;
+}
+
+const char*
+CalculationProfile::getPhaseName(Phase phase)
+{
+  switch (phase) {
+    case PHASE_LSDB_LOG:
+      return "lsdb-log";
+    case PHASE_GRAPH:
+      return "graph";
+    case PHASE_TOPOLOGY_EXPORT:
+      return "topology-export";
+    case PHASE_SPF:
+      return "spf";
+    case PHASE_HYPERBOLIC:
+      return "hyperbolic";
+    case PHASE_INSTALL:
+      return "install";
+    case PHASE_PUBLISH:
+      return "publish";
+    case PHASE_TOTAL:
+      return "total";
+    case N_PHASES:
+      break;
+  }
+  return "unknown";
+}
+
+void
+CalculationProfile::record(Phase phase, ndn::time::nanoseconds duration)
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  auto& samples = m_samples[phase];
+  samples.window[samples.count % WINDOW] = duration;
+  ++samples.count;
+  m_current[phase] += duration;
+}
+
+void
+CalculationProfile::beginCalculation()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_current.fill(ndn::time::nanoseconds::zero());
+}
+
+void
+CalculationProfile::endCalculation()
+{
+  std::lock_guard<std::mutex> lock(m_mutex);
+  if (m_current[PHASE_TOTAL] < SLOW_CALCULATION) {
+    return;
+  }
+
+  std::ostringstream os;
+  for (size_t phase = 0; phase < PHASE_TOTAL; ++phase) {
+    if (m_current[phase] > ndn::time::nanoseconds::zero()) {
+      os << " " << getPhaseName(static_cast<Phase>(phase)) << "="
+         << ndn::time::duration_cast<ndn::time::microseconds>(m_current[phase]).count() << "us";
+    }
+  }
+  NLSR_LOG_WARN("Slow routing calculation: total=" <<
+                ndn::time::duration_cast<ndn::time::microseconds>(m_current[PHASE_TOTAL]).count() <<
+                "us" << os.str());
+}
+
+CalculationProfileStatus
+CalculationProfile::getStatus() const
+{
+  using ndn::time::duration_cast;
+  using ndn::time::microseconds;
+
+  CalculationProfileStatus status;
+  std::lock_guard<std::mutex> lock(m_mutex);
+  for (size_t phase = 0; phase < N_PHASES; ++phase) {
+    const auto& samples = m_samples[phase];
+    if (samples.count == 0) {
+      continue;
+    }
+
+    size_t n = std::min<uint64_t>(samples.count, WINDOW);
+    std::vector<ndn::time::nanoseconds> recent(samples.window.begin(), samples.window.begin() + n);
+    std::sort(recent.begin(), recent.end());
+
+    CalculationProfileStatus::PhaseTiming timing;
+    timing.phase = getPhaseName(static_cast<Phase>(phase));
+    timing.count = samples.count;
+    timing.last = duration_cast<microseconds>(samples.window[(samples.count - 1) % WINDOW]);
+    timing.median = duration_cast<microseconds>(recent[n / 2]);
+    timing.p90 = duration_cast<microseconds>(recent[(n * 9) / 10]);
+    timing.max = duration_cast<microseconds>(recent.back());
+    status.addPhase(std::move(timing));
+  }
+  return status;
+}
+
+} // namespace nlsr
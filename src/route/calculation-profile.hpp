@@ -0,0 +1,193 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_CALCULATION_PROFILE_HPP
+#define NLSR_ROUTE_CALCULATION_PROFILE_HPP
+
+#include "common.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/util/time.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <mutex>
+
+namespace nlsr {
+
+/**
+ * @brief Durations of the phases of routing table calculations, as served by the
+ *        routing-calc-profile dataset.
+ *
+ *     CalculationProfile = CALCULATION-PROFILE-TYPE TLV-LENGTH
+ *                            *PhaseTiming
+ *
+ *     PhaseTiming = PHASE-TIMING-TYPE TLV-LENGTH
+ *                     PhaseName
+ *                     SampleCount    ; calculations since start, NonNegativeInteger
+ *                     LastDuration   ; microseconds, NonNegativeInteger
+ *                     MedianDuration ; microseconds, of the recent calculations
+ *                     P90Duration    ; microseconds, of the recent calculations
+ *                     MaxDuration    ; microseconds, of the recent calculations
+ */
+class CalculationProfileStatus
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  struct PhaseTiming
+  {
+    std::string phase;
+    uint64_t count = 0;
+    ndn::time::microseconds last{0};
+    ndn::time::microseconds median{0};
+    ndn::time::microseconds p90{0};
+    ndn::time::microseconds max{0};
+  };
+
+  CalculationProfileStatus() = default;
+
+  explicit
+  CalculationProfileStatus(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  const std::vector<PhaseTiming>&
+  getPhases() const
+  {
+    return m_phases;
+  }
+
+  void
+  addPhase(PhaseTiming timing)
+  {
+    m_phases.push_back(std::move(timing));
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+private:
+  std::vector<PhaseTiming> m_phases;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const CalculationProfileStatus& status);
+
+/**
+ * @brief Rolling statistics of the phases of routing table calculations.
+ *
+ * Each phase keeps its last WINDOW durations. Phases may be recorded from any thread, so that
+ * calculations running on a worker thread can be timed as well.
+ */
+class CalculationProfile
+{
+public:
+  enum Phase : size_t {
+    PHASE_LSDB_LOG,
+    PHASE_GRAPH,
+    PHASE_TOPOLOGY_EXPORT,
+    PHASE_SPF,
+    PHASE_HYPERBOLIC,
+    PHASE_INSTALL,
+    PHASE_PUBLISH,
+    PHASE_TOTAL,
+    N_PHASES
+  };
+
+  static constexpr size_t WINDOW = 128;
+
+  /// A calculation taking longer is logged with its breakdown.
+  static constexpr ndn::time::milliseconds SLOW_CALCULATION = ndn::time::milliseconds(100);
+
+  /**
+   * @brief Times a phase for as long as it is in scope.
+   */
+  class Scope : boost::noncopyable
+  {
+  public:
+    Scope(CalculationProfile& profile, Phase phase)
+      : m_profile(profile)
+      , m_phase(phase)
+      , m_start(ndn::time::steady_clock::now())
+    {
+    }
+
+    ~Scope()
+    {
+      m_profile.record(m_phase, ndn::time::steady_clock::now() - m_start);
+    }
+
+  private:
+    CalculationProfile& m_profile;
+    Phase m_phase;
+    ndn::time::steady_clock::time_point m_start;
+  };
+
+  void
+  record(Phase phase, ndn::time::nanoseconds duration);
+
+  /**
+   * @brief Start the breakdown of a calculation.
+   */
+  void
+  beginCalculation();
+
+  /**
+   * @brief End the breakdown of a calculation, and log it if the total is slow.
+   *
+   * Phases that ran on a worker thread after the calculation ended are not part of it.
+   */
+  void
+  endCalculation();
+
+  CalculationProfileStatus
+  getStatus() const;
+
+  static const char*
+  getPhaseName(Phase phase);
+
+private:
+  struct Samples
+  {
+    uint64_t count = 0;
+    std::array<ndn::time::nanoseconds, WINDOW> window{};
+  };
+
+  mutable std::mutex m_mutex;
+  std::array<Samples, N_PHASES> m_samples;
+  /// Durations of the phases of the current calculation
+  std::array<ndn::time::nanoseconds, N_PHASES> m_current{};
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_CALCULATION_PROFILE_HPP
@@ -21,10 +21,15 @@
 #include "fib.hpp"
 #include "adjacency-list.hpp"
 #include "conf-parameter.hpp"
+#include "link-cost-manager.hpp"
 #include "logger.hpp"
+#include "multipath-weights.hpp"
 #include "nexthop-list.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-command.hpp>
+#include <ndn-cxx/mgmt/nfd/status-dataset.hpp>
+
+#include <boost/container_hash/hash.hpp>
 
 #include <algorithm>
 #include <cmath>
@@ -56,6 +61,7 @@ Fib::remove(const ndn::Name& name)
       unregisterPrefix((it->second).name, nexthop.getConnectingFaceUri());
     }
     m_table.erase(it);
+    afterEntryChanged(name, NextHopsUriSortedSet());
   }
 }
 void
@@ -63,6 +69,7 @@ Fib::addNextHopsToFibEntryAndNfd(FibEntry& entry, const NextHopsUriSortedSet& ho
 {
   const ndn::Name& name = entry.name;
   bool shouldReg = shouldRegister(name);
+  auto firstExpiration = ndn::time::steady_clock::time_point::max();
 
   for (const auto& hop : hopsToAdd)
   {
@@ -70,12 +77,46 @@ Fib::addNextHopsToFibEntryAndNfd(FibEntry& entry, const NextHopsUriSortedSet& ho
     entry.nexthopSet.addNextHop(hop);
 
     if (shouldReg) {
-      registerPrefix(name, ndn::FaceUri(hop.getConnectingFaceUri()),
+      ndn::FaceUri faceUri(hop.getConnectingFaceUri());
+      auto expiration = claimStaleRoute(name, faceUri, hop.getRouteCostAsAdjustedInteger());
+      if (expiration) {
+        NLSR_LOG_DEBUG("Keeping the route of " << name << " on " << faceUri << " from NFD");
+        firstExpiration = std::min(firstExpiration, *expiration);
+        continue;
+      }
+      registerPrefix(name, faceUri,
                      hop.getRouteCostAsAdjustedInteger(),
                      ndn::time::seconds(m_refreshTime + GRACE_PERIOD),
                      ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
     }
   }
+
+  if (firstExpiration != ndn::time::steady_clock::time_point::max()) {
+    m_staleRouteExpirations.emplace(firstExpiration, name);
+  }
+}
+
+std::optional<ndn::time::steady_clock::time_point>
+Fib::claimStaleRoute(const ndn::Name& name, const ndn::FaceUri& faceUri, uint64_t cost)
+{
+  if (m_staleRoutes.empty()) {
+    return std::nullopt;
+  }
+
+  auto it = m_staleRoutes.find({name, m_adjacencyList.getFaceId(faceUri)});
+  if (it == m_staleRoutes.end()) {
+    return std::nullopt;
+  }
+  StaleRoute route = it->second;
+  m_staleRoutes.erase(it);
+
+  // the route must outlive the sweep tick that refreshes it before it expires
+  auto margin = REFRESH_SWEEP_TICK + ndn::time::seconds(GRACE_PERIOD);
+  if (route.cost != cost || route.flags != ndn::nfd::ROUTE_FLAG_CAPTURE ||
+      route.expiration - ndn::time::steady_clock::now() <= margin) {
+    return std::nullopt;
+  }
+  return route.expiration;
 }
 
 void
@@ -95,6 +136,12 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
     hopsToAdd.addNextHop(*it);
   }
 
+  bool isWeighted = m_confParameter.getWeightedMultipath() && m_linkCostManager != nullptr &&
+                    hopsToAdd.size() > 1;
+  if (isWeighted) {
+    hopsToAdd = weighNextHops(name, hopsToAdd);
+  }
+
   auto entryIt = m_table.find(name);
 
   // New FIB entry that has nextHops
@@ -103,7 +150,12 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
 
     FibEntry entry;
     entry.name = name;
+    entry.nexthopHash = hashNextHops(hopsToAdd);
     addNextHopsToFibEntryAndNfd(entry, hopsToAdd);
+    if (isWeighted) {
+      // ASF probes the other next hops and moves traffic away from congested faces
+      setStrategy(name, ASF_STRATEGY, 0);
+    }
 
     entryIt = m_table.try_emplace(name, std::move(entry)).first;
   }
@@ -119,6 +171,15 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
     }
 
     FibEntry& entry = entryIt->second;
+    // Most updates after a routing table calculation leave the entry as it is
+    size_t hash = hashNextHops(hopsToAdd);
+    if (hash == entry.nexthopHash &&
+        std::equal(entry.nexthopSet.begin(), entry.nexthopSet.end(),
+                   hopsToAdd.begin(), hopsToAdd.end())) {
+      NLSR_LOG_TRACE("Next hops of " << name << " unchanged");
+      return;
+    }
+    entry.nexthopHash = hash;
     addNextHopsToFibEntryAndNfd(entry, hopsToAdd);
 
     std::set<NextHop, NextHopUriSortedComparator> hopsToRemove;
@@ -135,6 +196,8 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
       NLSR_LOG_DEBUG("Removing " << hop.getConnectingFaceUri() << " from " << entry.name);
       entry.nexthopSet.removeNextHop(hop);
     }
+    // addNextHop() keeps the lower of two costs, so a cost increase is only recorded here
+    entry.nexthopSet = hopsToAdd;
 
     // Increment sequence number
     entry.seqNo += 1;
@@ -142,12 +205,58 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
   }
 
   if (entryIt != m_table.end() &&
-      !entryIt->second.refreshEventId &&
+      entryIt->second.refreshToken == 0 &&
       shouldRegister(entryIt->second.name)) {
-    scheduleEntryRefresh(entryIt->second, [this] (FibEntry& entry) { scheduleLoop(entry); });
+    scheduleEntryRefresh(entryIt->second);
+  }
+  if (entryIt != m_table.end()) {
+    afterEntryChanged(name, entryIt->second.nexthopSet);
   }
 }
 
+NextHopsUriSortedSet
+Fib::weighNextHops(const ndn::Name& name, const NextHopsUriSortedSet& hops) const
+{
+  std::vector<NextHop> nextHops(hops.begin(), hops.end());
+  std::vector<double> routeCosts;
+  std::vector<std::optional<double>> spareCapacities;
+  for (const auto& hop : nextHops) {
+    if (hop.isHyperbolic()) {
+      return hops;
+    }
+    routeCosts.push_back(hop.getRouteCost());
+    auto adjacent = m_adjacencyList.findAdjacent(hop.getConnectingFaceUri());
+    spareCapacities.push_back(adjacent != m_adjacencyList.end() ?
+                              m_linkCostManager->getSpareCapacity(adjacent->getName()) :
+                              std::nullopt);
+  }
+
+  auto weights = computeSplitWeights(routeCosts, spareCapacities);
+  auto costs = getWeightedCosts(routeCosts, weights);
+
+  NextHopsUriSortedSet weighted;
+  for (size_t i = 0; i < nextHops.size(); ++i) {
+    NLSR_LOG_TRACE("Share of " << nextHops[i].getConnectingFaceUri() << " for " << name << ": "
+                   << weights[i] << ", cost " << routeCosts[i] << " -> " << costs[i]);
+    nextHops[i].setRouteCost(costs[i]);
+    weighted.addNextHop(nextHops[i]);
+  }
+  return weighted;
+}
+
+size_t
+Fib::hashNextHops(const NextHopsUriSortedSet& hops) const
+{
+  size_t seed = 0;
+  for (const auto& hop : hops) {
+    boost::hash_combine(seed, hop.getInternedFaceUri());
+    boost::hash_combine(seed, hop.getRouteCostAsAdjustedInteger());
+    // a recreated face has lost its routes
+    boost::hash_combine(seed, m_adjacencyList.getFaceId(hop.getConnectingFaceUri()));
+  }
+  return seed;
+}
+
 unsigned int
 Fib::getNumberOfFacesForName(const NexthopList& nextHopList)
 {
@@ -194,10 +303,14 @@ Fib::registerPrefix(const ndn::Name& namePrefix, const ndn::FaceUri& faceUri,
      .setExpirationPeriod(timeout)
      .setOrigin(ndn::nfd::ROUTE_ORIGIN_NLSR);
 
+    RibCommandKey key{namePrefix, faceId};
+    m_staleRoutes.erase(key);
+    if (m_routesBeforeRibDataset) {
+      m_routesBeforeRibDataset->insert(key);
+    }
+
     NLSR_LOG_DEBUG("Registering prefix: " << faceParameters.getName() << " faceUri: " << faceUri);
-    m_controller.start<ndn::nfd::RibRegisterCommand>(faceParameters,
-      std::bind(&Fib::onRegistrationSuccess, this, _1, faceUri),
-      std::bind(&Fib::onRegistrationFailure, this, _1, faceParameters, faceUri, times));
+    submitRibCommand({true, faceParameters, faceUri, times});
   }
   else {
     NLSR_LOG_WARN("Error: No Face Id for face uri: " << faceUri);
@@ -213,7 +326,7 @@ Fib::onRegistrationSuccess(const ndn::nfd::ControlParameters& param,
 
   auto adjacent = m_adjacencyList.findAdjacent(faceUri);
   if (adjacent != m_adjacencyList.end()) {
-    adjacent->setFaceId(param.getFaceId());
+    m_adjacencyList.setFaceId(adjacent->getName(), param.getFaceId());
   }
   onPrefixRegistrationSuccess(param.getName());
 }
@@ -227,16 +340,7 @@ Fib::onRegistrationFailure(const ndn::nfd::ControlResponse& response,
   NLSR_LOG_DEBUG("Failed in name registration: " << response.getText() <<
                  " (code: " << response.getCode() << ")");
   NLSR_LOG_DEBUG("Prefix: " << parameters.getName() << " failed for: " << +times);
-  if (times < 3) {
-    NLSR_LOG_DEBUG("Trying to register again...");
-    registerPrefix(parameters.getName(), faceUri,
-                   parameters.getCost(),
-                   parameters.getExpirationPeriod(),
-                   parameters.getFlags(), times+1);
-  }
-  else {
-    NLSR_LOG_DEBUG("Registration trial given up");
-  }
+  retryRibCommand({true, parameters, faceUri, times});
 }
 
 void
@@ -256,18 +360,188 @@ Fib::unregisterPrefix(const ndn::Name& namePrefix, const ndn::FaceUri& faceUri)
       .setFaceId(faceId)
       .setOrigin(ndn::nfd::ROUTE_ORIGIN_NLSR);
 
-    m_controller.start<ndn::nfd::RibUnregisterCommand>(controlParameters,
-      [] (const ndn::nfd::ControlParameters& commandSuccessResult) {
+    m_staleRoutes.erase({namePrefix, faceId});
+    submitRibCommand({false, controlParameters, faceUri, 0});
+  }
+}
+
+void
+Fib::reconcileWithRib(ndn::time::nanoseconds gracePeriod)
+{
+  NLSR_LOG_DEBUG("Fetching the RIB to take over the routes of a previous run");
+  m_routesBeforeRibDataset.emplace();
+
+  m_controller.fetch<ndn::nfd::RibDataset>(
+    [this, gracePeriod] (const std::vector<ndn::nfd::RibEntry>& ribEntries) {
+      processRibDataset(ribEntries, gracePeriod);
+    },
+    [this] (uint32_t code, const std::string& reason) {
+      // the routes of the previous run expire on their own
+      NLSR_LOG_WARN("Failed to fetch the RIB: " << reason << " (code: " << code << ")");
+      m_routesBeforeRibDataset.reset();
+    });
+}
+
+void
+Fib::processRibDataset(const std::vector<ndn::nfd::RibEntry>& ribEntries,
+                       ndn::time::nanoseconds gracePeriod)
+{
+  auto now = ndn::time::steady_clock::now();
+  for (const auto& ribEntry : ribEntries) {
+    for (const auto& route : ribEntry.getRoutes()) {
+      RibCommandKey key{ribEntry.getName(), route.getFaceId()};
+      if (route.getOrigin() != ndn::nfd::ROUTE_ORIGIN_NLSR ||
+          (m_routesBeforeRibDataset && m_routesBeforeRibDataset->count(key) > 0)) {
+        continue;
+      }
+      auto expiration = route.hasExpirationPeriod() ?
+                        now + route.getExpirationPeriod() :
+                        ndn::time::steady_clock::time_point::max();
+      m_staleRoutes.insert_or_assign(key, StaleRoute{route.getCost(), route.getFlags(),
+                                                     expiration});
+    }
+  }
+  m_routesBeforeRibDataset.reset();
+
+  NLSR_LOG_INFO("Found " << m_staleRoutes.size() << " stale routes in the RIB");
+  if (!m_staleRoutes.empty()) {
+    m_staleRouteRemovalEvent = m_scheduler.schedule(gracePeriod, [this] { removeStaleRoutes(); });
+  }
+}
+
+void
+Fib::removeStaleRoutes()
+{
+  NLSR_LOG_DEBUG("Removing " << m_staleRoutes.size() << " stale routes not computed again");
+
+  for (const auto& [key, route] : m_staleRoutes) {
+    ndn::nfd::ControlParameters controlParameters;
+    controlParameters
+      .setName(key.first)
+      .setFaceId(key.second)
+      .setOrigin(ndn::nfd::ROUTE_ORIGIN_NLSR);
+
+    submitRibCommand({false, controlParameters, ndn::FaceUri(), 0});
+  }
+  m_staleRoutes.clear();
+}
+
+void
+Fib::submitRibCommand(RibCommand command)
+{
+  RibCommandKey key{command.parameters.getName(), command.parameters.getFaceId()};
+  m_ribRetryEvents.erase(key);
+  if (m_tracer != nullptr && command.fibInstall == nullptr) {
+    command.fibInstall = m_tracer->getFibInstall();
+  }
+
+  uint32_t window = m_confParameter.getFibCommandWindow();
+  if (window == 0 || (m_ribCommandOrder.empty() && m_nInFlightRibCommands < window)) {
+    startRibCommand(command);
+    return;
+  }
+
+  auto [it, isNew] = m_queuedRibCommands.insert_or_assign(key, std::move(command));
+  if (isNew) {
+    m_ribCommandOrder.push_back(key);
+  }
+  else {
+    NLSR_LOG_TRACE("Queued RIB command for " << key.first << " on face " << key.second <<
+                   " replaced");
+  }
+}
+
+void
+Fib::startRibCommand(const RibCommand& command)
+{
+  ++m_nInFlightRibCommands;
+  auto startTime = ndn::time::steady_clock::now();
+
+  if (command.isRegister) {
+    m_controller.start<ndn::nfd::RibRegisterCommand>(command.parameters,
+      [this, faceUri = command.faceUri, fibInstall = command.fibInstall,
+       startTime] (const auto& param) {
+        recordRibLatency(LatencyStatistics::STAGE_RIB_REGISTER, startTime);
+        onRibCommandDone();
+        onRegistrationSuccess(param, faceUri);
+      },
+      [this, command, startTime] (const ndn::nfd::ControlResponse& response) {
+        recordRibLatency(LatencyStatistics::STAGE_RIB_REGISTER, startTime);
+        onRibCommandDone();
+        onRegistrationFailure(response, command.parameters, command.faceUri, command.times);
+      });
+  }
+  else {
+    m_controller.start<ndn::nfd::RibUnregisterCommand>(command.parameters,
+      [this, fibInstall = command.fibInstall, startTime] (const auto& commandSuccessResult) {
+        recordRibLatency(LatencyStatistics::STAGE_RIB_UNREGISTER, startTime);
+        onRibCommandDone();
         NLSR_LOG_DEBUG("Unregister successful Prefix: " << commandSuccessResult.getName() <<
                        " Face Id: " << commandSuccessResult.getFaceId());
       },
-      [] (const ndn::nfd::ControlResponse& response) {
+      [this, command, startTime] (const ndn::nfd::ControlResponse& response) {
+        recordRibLatency(LatencyStatistics::STAGE_RIB_UNREGISTER, startTime);
+        onRibCommandDone();
         NLSR_LOG_DEBUG("Failed in unregistering name: " << response.getText() <<
                        " (code " << response.getCode() << ")");
+        retryRibCommand(command);
       });
   }
 }
 
+void
+Fib::recordRibLatency(LatencyStatistics::Stage stage, ndn::time::steady_clock::time_point startTime)
+{
+  // failed commands, including those that timed out, are answered too
+  if (m_latency != nullptr) {
+    m_latency->record(stage, ndn::time::steady_clock::now() - startTime);
+  }
+}
+
+void
+Fib::onRibCommandDone()
+{
+  --m_nInFlightRibCommands;
+
+  uint32_t window = m_confParameter.getFibCommandWindow();
+  while (!m_ribCommandOrder.empty() && (window == 0 || m_nInFlightRibCommands < window)) {
+    auto it = m_queuedRibCommands.find(m_ribCommandOrder.front());
+    m_ribCommandOrder.pop_front();
+    RibCommand command = std::move(it->second);
+    m_queuedRibCommands.erase(it);
+    startRibCommand(command);
+  }
+}
+
+void
+Fib::retryRibCommand(RibCommand command)
+{
+  if (command.times >= 3) {
+    NLSR_LOG_DEBUG((command.isRegister ? "Registration" : "Unregistration") <<
+                   " trial given up for " << command.parameters.getName());
+    return;
+  }
+
+  // Failed commands wait on their own, so that they do not hold back the others
+  auto delay = RIB_RETRY_BACKOFF * (1 << command.times);
+  ++command.times;
+  NLSR_LOG_DEBUG("Trying " << command.parameters.getName() << " again in " << delay);
+
+  RibCommandKey key{command.parameters.getName(), command.parameters.getFaceId()};
+  m_ribRetryEvents[key] = m_scheduler.schedule(delay, [this, key, command] {
+    m_ribRetryEvents.erase(key);
+    if (command.isRegister) {
+      // the Face ID of the neighbor may have changed in the meantime
+      registerPrefix(command.parameters.getName(), command.faceUri,
+                     command.parameters.getCost(), command.parameters.getExpirationPeriod(),
+                     command.parameters.getFlags(), command.times);
+    }
+    else {
+      submitRibCommand(command);
+    }
+  });
+}
+
 void
 Fib::setStrategy(const ndn::Name& name, const ndn::Name& strategy, uint32_t count)
 {
@@ -301,36 +575,84 @@ Fib::onSetStrategyFailure(const ndn::nfd::ControlResponse&,
 }
 
 void
-Fib::scheduleEntryRefresh(FibEntry& entry, const AfterRefreshCallback& refreshCallback)
+Fib::scheduleEntryRefresh(FibEntry& entry)
 {
   NLSR_LOG_DEBUG("Scheduling refresh for " << entry.name <<
                  " Seq Num: " << entry.seqNo <<
-                 " in " << m_refreshTime << " seconds");
+                 " every " << m_refreshTime << " seconds");
 
-  entry.refreshEventId = m_scheduler.schedule(ndn::time::seconds(m_refreshTime),
-                                              std::bind(&Fib::refreshEntry, this,
-                                                        entry.name, refreshCallback));
+  entry.refreshToken = m_nextRefreshToken++;
+  m_refreshQueue.push_back({entry.name, entry.refreshToken, ndn::time::steady_clock::now()});
+
+  if (!m_refreshSweepEvent) {
+    m_refreshSweepEvent = m_scheduler.schedule(std::min<ndn::time::seconds>(REFRESH_SWEEP_TICK,
+                                                 ndn::time::seconds(m_refreshTime)),
+                                               [this] { sweepRefresh(); });
+  }
 }
 
 void
-Fib::scheduleLoop(FibEntry& entry)
+Fib::sweepRefresh()
 {
-  scheduleEntryRefresh(entry, std::bind(&Fib::scheduleLoop, this, _1));
+  auto period = ndn::time::seconds(m_refreshTime);
+  auto tick = std::min<ndn::time::seconds>(REFRESH_SWEEP_TICK, period);
+
+  // The share of the queue due at each tick, rounded up, so that the whole queue is
+  // refreshed once per refresh time
+  size_t nTicks = std::max<size_t>(1, period / tick);
+  size_t nDue = (m_refreshQueue.size() + nTicks - 1) / nTicks;
+  NLSR_LOG_TRACE("Refresh sweep of " << nDue << " of " << m_refreshQueue.size() << " entries");
+
+  auto now = ndn::time::steady_clock::now();
+
+  // Claimed stale routes are registered again before they expire, however far the entries
+  // are from their turn
+  auto expiring = now + tick + ndn::time::seconds(GRACE_PERIOD);
+  while (!m_staleRouteExpirations.empty() && m_staleRouteExpirations.begin()->first <= expiring) {
+    auto node = m_staleRouteExpirations.extract(m_staleRouteExpirations.begin());
+    auto it = m_table.find(node.mapped());
+    if (it != m_table.end()) {
+      refreshEntry(it->second);
+    }
+  }
+
+  // The queue is in the order of the last refreshes. Entries refreshed less than half of the
+  // refresh time ago wait, so that a small FIB is not refreshed at every tick, and entries
+  // that would expire before the next tick are refreshed beyond the share.
+  size_t nRefreshed = 0;
+  while (!m_refreshQueue.empty()) {
+    auto age = now - m_refreshQueue.front().lastRefresh;
+    bool isLate = age + tick >= period;
+    if (!isLate && (nRefreshed >= nDue || age < period / 2)) {
+      break;
+    }
+
+    QueuedRefresh queued = std::move(m_refreshQueue.front());
+    m_refreshQueue.pop_front();
+
+    auto it = m_table.find(queued.name);
+    if (it == m_table.end() || it->second.refreshToken != queued.token) {
+      continue;
+    }
+    refreshEntry(it->second);
+    ++nRefreshed;
+    queued.lastRefresh = now;
+    m_refreshQueue.push_back(std::move(queued));
+  }
+
+  if (!m_refreshQueue.empty()) {
+    m_refreshSweepEvent = m_scheduler.schedule(tick, [this] { sweepRefresh(); });
+  }
 }
 
 void
-Fib::refreshEntry(const ndn::Name& name, AfterRefreshCallback refreshCb)
+Fib::refreshEntry(FibEntry& entry)
 {
-  auto it = m_table.find(name);
-  if (it == m_table.end()) {
-    return;
-  }
-
-  FibEntry& entry = it->second;
   NLSR_LOG_DEBUG("Refreshing " << entry.name << " Seq Num: " << entry.seqNo);
 
   entry.seqNo += 1;
 
+  // the registrations go through the RIB command window like the others
   for (const NextHop& hop : entry.nexthopSet) {
     registerPrefix(entry.name,
                    ndn::FaceUri(hop.getConnectingFaceUri()),
@@ -338,13 +660,27 @@ Fib::refreshEntry(const ndn::Name& name, AfterRefreshCallback refreshCb)
                    ndn::time::seconds(m_refreshTime + GRACE_PERIOD),
                    ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
   }
+}
 
-  refreshCb(entry);
+const FibEntry*
+Fib::findLongestPrefixMatch(const ndn::Name& name) const
+{
+  for (size_t len = name.size() + 1; len-- > 0;) {
+    auto it = m_table.find(name.getPrefix(static_cast<ssize_t>(len)));
+    if (it != m_table.end()) {
+      return &it->second;
+    }
+  }
+  return nullptr;
 }
 
 void
 Fib::writeLog()
 {
+  if (!NLSR_LOG_DEBUG_ENABLED()) {
+    return;
+  }
+
   NLSR_LOG_DEBUG("-------------------FIB-----------------------------");
   for (const auto& entry : m_table) {
     NLSR_LOG_DEBUG("Name prefix: "  << entry.first);
@@ -353,4 +689,36 @@ Fib::writeLog()
   }
 }
 
+void
+Fib::reportMemory(MemoryStatus& status) const
+{
+  MemoryUsage fib;
+  for (const auto& [name, entry] : m_table) {
+    ++fib.nElements;
+    // the entry holds a copy of its name
+    fib.nBytes += HASH_NODE_OVERHEAD + sizeof(name) + sizeof(entry) + 2 * getNameMemory(name) +
+                  entry.nexthopSet.getHeapMemory();
+  }
+  for (const auto& refresh : m_refreshQueue) {
+    fib.nBytes += sizeof(refresh) + getNameMemory(refresh.name);
+  }
+  status.addComponent("fib", fib);
+
+  MemoryUsage rib;
+  for (const auto& [key, command] : m_queuedRibCommands) {
+    ++rib.nElements;
+    // the key is also in the submission order
+    rib.nBytes += TREE_NODE_OVERHEAD + 2 * sizeof(key) + sizeof(command) +
+                  2 * getNameMemory(key.first) + getNameMemory(command.parameters.getName());
+  }
+  for (const auto& [key, route] : m_staleRoutes) {
+    ++rib.nElements;
+    rib.nBytes += TREE_NODE_OVERHEAD + sizeof(key) + sizeof(route) + getNameMemory(key.first);
+  }
+  for (const auto& [expiration, name] : m_staleRouteExpirations) {
+    rib.nBytes += TREE_NODE_OVERHEAD + sizeof(expiration) + sizeof(name) + getNameMemory(name);
+  }
+  status.addComponent("rib-commands", rib);
+}
+
 } // namespace nlsr
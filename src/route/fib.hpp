@@ -22,13 +22,23 @@
 #ifndef NLSR_ROUTE_FIB_HPP
 #define NLSR_ROUTE_FIB_HPP
 
+#include "convergence-tracer.hpp"
+#include "latency-statistics.hpp"
+#include "memory-usage.hpp"
 #include "test-access-control.hpp"
 #include "nexthop-list.hpp"
 
 #include <ndn-cxx/mgmt/nfd/controller.hpp>
+#include <ndn-cxx/mgmt/nfd/rib-entry.hpp>
 #include <ndn-cxx/util/scheduler.hpp>
 #include <ndn-cxx/util/time.hpp>
 
+#include <deque>
+#include <map>
+#include <optional>
+#include <set>
+#include <unordered_map>
+
 namespace nlsr {
 
 using NextHopsUriSortedSet = NexthopListT<NextHopUriSortedComparator>;
@@ -36,15 +46,17 @@ using NextHopsUriSortedSet = NexthopListT<NextHopUriSortedComparator>;
 struct FibEntry
 {
   ndn::Name name;
-  ndn::scheduler::ScopedEventId refreshEventId;
+  /// identifies the entry in the refresh queue; 0 while no refresh is scheduled
+  uint64_t refreshToken = 0;
   int32_t seqNo = 1;
   NextHopsUriSortedSet nexthopSet;
+  /// hash of the next hops, their costs and Face IDs as last installed
+  size_t nexthopHash = 0;
 };
 
-using AfterRefreshCallback = std::function<void(FibEntry&)>;
-
 class AdjacencyList;
 class ConfParameter;
+class LinkCostManager;
 
 /*! \brief Maps names to lists of next hops, and exports this information to NFD.
  *
@@ -124,12 +136,91 @@ public:
                  uint64_t flags,
                  uint8_t times);
 
+  /*! \brief Unregisters a prefix from NFD's RIB.
+   *
+   * Used for the prefixes registered on the Face of a neighbor that is removed.
+   */
+  void
+  unregisterPrefix(const ndn::Name& namePrefix, const ndn::FaceUri& faceUri);
+
   void
   setStrategy(const ndn::Name& name, const ndn::Name& strategy, uint32_t count);
 
+  /*! \brief Take over the routes that a previous run of NLSR left in the NFD RIB.
+   *
+   * The routes of origin NLSR found in the RIB are kept as stale but serving. A stale route
+   * that is computed again with the same cost is not registered again until shortly before
+   * it expires, and the stale routes that are not computed again within \p gracePeriod are
+   * unregistered. A restart thereby leaves the routes in NFD in place, and only updates the
+   * ones that changed.
+   */
+  void
+  reconcileWithRib(ndn::time::nanoseconds gracePeriod);
+
+  /*! \brief Set the source of the spare link capacities used by weighted-multipath.
+   */
+  void
+  setLinkCostManager(const LinkCostManager* linkCostManager)
+  {
+    m_linkCostManager = linkCostManager;
+  }
+
+  /*! \brief Return the entry of the longest prefix of \p name in the FIB, or nullptr.
+   *
+   * The prefixes of \p name are looked up from the longest, for diagnostics.
+   */
+  const FibEntry*
+  findLongestPrefixMatch(const ndn::Name& name) const;
+
+  size_t
+  size() const
+  {
+    return m_table.size();
+  }
+
+  /*! \brief Return the number of RIB commands sent to NFD and not answered yet.
+   */
+  size_t
+  getRibCommandsInFlight() const
+  {
+    return m_nInFlightRibCommands;
+  }
+
+  /*! \brief Return the number of RIB commands waiting for a slot in the command window.
+   */
+  size_t
+  getQueuedRibCommands() const
+  {
+    return m_queuedRibCommands.size();
+  }
+
+  /*! \brief Hold the FIB_INSTALL of the NPT update in progress in \p tracer until its RIB
+   *         commands are answered; nullptr to stop tracing.
+   */
+  void
+  setConvergenceTracer(ConvergenceTracer* tracer)
+  {
+    m_tracer = tracer;
+  }
+
+  /*! \brief Record the round-trip times of the RIB commands in \p latency ; nullptr to stop
+   *         recording them.
+   */
+  void
+  setLatencyStatistics(LatencyStatistics* latency)
+  {
+    m_latency = latency;
+  }
+
   void
   writeLog();
 
+  /*! \brief Adds the memory of the FIB entries and of the RIB commands and refreshes queued
+   *         for them to \p status.
+   */
+  void
+  reportMemory(MemoryStatus& status) const;
+
 private:
   /*! \brief Check if a prefix should be registered/updated in NFD.
    * 
@@ -157,14 +248,29 @@ private:
   void
   addNextHopsToFibEntryAndNfd(FibEntry& entry, const NextHopsUriSortedSet& hopsToAdd);
 
-  unsigned int
-  getNumberOfFacesForName(const NexthopList& nextHopList);
+  /*! \brief Replace the costs of the next hops of a multipath entry by load-weighted costs.
+   *
+   * \sa computeSplitWeights, getWeightedCosts
+   */
+  NextHopsUriSortedSet
+  weighNextHops(const ndn::Name& name, const NextHopsUriSortedSet& hops) const;
 
-  /*! \brief Unregisters a prefix from NFD's RIB.
+  /*! \brief Take over the stale route of a next hop, if it is still good for a while.
    *
+   * \return when the stale route expires, which is the time point max if it does not
    */
-  void
-  unregisterPrefix(const ndn::Name& namePrefix, const ndn::FaceUri& faceUri);
+  std::optional<ndn::time::steady_clock::time_point>
+  claimStaleRoute(const ndn::Name& name, const ndn::FaceUri& faceUri, uint64_t cost);
+
+  /*! \brief Hash the FaceUris, costs and current Face IDs of next hops.
+   *
+   * An entry whose hash and next hops are unchanged is not sent to NFD again.
+   */
+  size_t
+  hashNextHops(const NextHopsUriSortedSet& hops) const;
+
+  unsigned int
+  getNumberOfFacesForName(const NexthopList& nextHopList);
 
   /*! \brief Log registration success, and update the Face ID associated with a URI.
    */
@@ -193,53 +299,158 @@ private:
                        uint32_t count);
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  /*! \brief Schedule a refresh event for an entry.
+  struct RibCommand
+  {
+    bool isRegister;
+    ndn::nfd::ControlParameters parameters;
+    ndn::FaceUri faceUri;
+    /// how many times the command has failed
+    uint8_t times;
+    /// held until the command is answered, see ConvergenceTracer::getFibInstall
+    std::shared_ptr<void> fibInstall = nullptr;
+  };
+
+  /*! \brief Send a RIB command to NFD, or queue it behind the commands in flight.
    *
-   * Schedules a refresh event for an entry. In order to form a
-   * perpetual loop, refreshCallback needs to call
-   * Fib::scheduleEntryRefresh in some way, with refreshCallback being
-   * the same each time. In the current implementation, this is
-   * accomplished by having a separate function, Fib::scheduleLoop,
-   * that does this work.
-   * \sa Fib::scheduleLoop
+   * At most fib-command-window commands await an answer at a time. A queued command is
+   * replaced by a newer command for the same name and face, and a pending retry of that name
+   * and face is cancelled.
+   *
+   * \sa nlsr::ConfParameter::getFibCommandWindow
+   */
+  void
+  submitRibCommand(RibCommand command);
+
+  /*! \brief Record the routes of origin NLSR in a RIB dataset as stale.
    */
   void
-  scheduleEntryRefresh(FibEntry& entry, const AfterRefreshCallback& refreshCb);
+  processRibDataset(const std::vector<ndn::nfd::RibEntry>& ribEntries,
+                    ndn::time::nanoseconds gracePeriod);
+
+  /*! \brief Unregister the stale routes that were not computed again.
+   */
+  void
+  removeStaleRoutes();
 
 private:
-  /*! \brief Continue the entry refresh cycle.
+  void
+  startRibCommand(const RibCommand& command);
+
+  /*! \brief Record the round-trip time of a RIB command started at \p startTime .
    */
   void
-  scheduleLoop(FibEntry& entry);
+  recordRibLatency(LatencyStatistics::Stage stage, ndn::time::steady_clock::time_point startTime);
+
+  /*! \brief Account for an answered command and start queued ones.
+   */
+  void
+  onRibCommandDone();
+
+  /*! \brief Submit a failed command again after an exponential back-off, up to three times.
+   */
+  void
+  retryRibCommand(RibCommand command);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Add an entry to the refresh sweep.
+   *
+   * All entries are refreshed by one sweep timer. Each tick refreshes the share of the queued
+   * entries that spreads them evenly over the refresh time, so entries installed together are
+   * not refreshed together, and the number of timers does not grow with the FIB. An entry is
+   * refreshed no earlier than half of the refresh time after its last registration, and no
+   * later than a tick before the refresh time.
+   */
+  void
+  scheduleEntryRefresh(FibEntry& entry);
+
+private:
+  /*! \brief Refresh the next share of the queued entries and requeue them.
+   */
+  void
+  sweepRefresh();
 
   /*! \brief Refreshes an entry in NFD.
    */
   void
-  refreshEntry(const ndn::Name& name, AfterRefreshCallback refreshCb);
+  refreshEntry(FibEntry& entry);
 
 public:
   static inline const ndn::Name MULTICAST_STRATEGY{"/localhost/nfd/strategy/multicast"};
   static inline const ndn::Name BEST_ROUTE_STRATEGY{"/localhost/nfd/strategy/best-route"};
+  static inline const ndn::Name ASF_STRATEGY{"/localhost/nfd/strategy/asf"};
 
   ndn::signal::Signal<Fib, ndn::Name> onPrefixRegistrationSuccess;
 
+  /*! \brief Emitted when the next hops of an entry change, with its new next hops, which are
+   *         empty when the entry is removed.
+   */
+  ndn::signal::Signal<Fib, ndn::Name, NextHopsUriSortedSet> afterEntryChanged;
+
 private:
   ndn::Scheduler& m_scheduler;
   int32_t m_refreshTime;
+  struct QueuedRefresh
+  {
+    ndn::Name name;
+    uint64_t token;
+    /// when the entry was last registered or refreshed
+    ndn::time::steady_clock::time_point lastRefresh;
+  };
+
+  // Entries in refresh order, with their refresh tokens; entries removed or replaced since
+  // are dropped from the queue when their turn comes
+  std::deque<QueuedRefresh> m_refreshQueue;
+  uint64_t m_nextRefreshToken = 1;
+  ndn::scheduler::ScopedEventId m_refreshSweepEvent;
   ndn::nfd::Controller m_controller;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  std::map<ndn::Name, FibEntry> m_table;
+  // Hashed, as there can be an entry for every prefix in the network. Entries do not move
+  // when the table grows, so references to them stay valid.
+  std::unordered_map<ndn::Name, FibEntry> m_table;
+
+  // RIB commands waiting for the window, by name and Face ID, in submission order
+  using RibCommandKey = std::pair<ndn::Name, uint64_t>;
+  std::map<RibCommandKey, RibCommand> m_queuedRibCommands;
+  std::deque<RibCommandKey> m_ribCommandOrder;
+  size_t m_nInFlightRibCommands = 0;
+  ConvergenceTracer* m_tracer = nullptr;
+  LatencyStatistics* m_latency = nullptr;
+
+  struct StaleRoute
+  {
+    uint64_t cost;
+    uint64_t flags;
+    ndn::time::steady_clock::time_point expiration;
+  };
+
+  // Routes left in the RIB by a previous run, by name and Face ID
+  std::map<RibCommandKey, StaleRoute> m_staleRoutes;
+  // Entries with claimed stale routes, by the time the first of these routes expires
+  std::multimap<ndn::time::steady_clock::time_point, ndn::Name> m_staleRouteExpirations;
 
 private:
+  // Routes registered while the RIB dataset is being fetched, which are not stale
+  std::optional<std::set<RibCommandKey>> m_routesBeforeRibDataset;
+  ndn::scheduler::ScopedEventId m_staleRouteRemovalEvent;
+  std::map<RibCommandKey, ndn::scheduler::ScopedEventId> m_ribRetryEvents;
   AdjacencyList& m_adjacencyList;
   ConfParameter& m_confParameter;
+  const LinkCostManager* m_linkCostManager = nullptr;
 
   /*! GRACE_PERIOD A "window" we append to the timeout time to
    * allow for things like stuttering prefix registrations and
    * processing time when refreshing events.
    */
   static constexpr uint64_t GRACE_PERIOD = 10;
+
+  /*! Back-off before the first retry of a failed RIB command, doubled at each retry.
+   */
+  static constexpr ndn::time::milliseconds RIB_RETRY_BACKOFF{100};
+
+  /*! Interval between two refresh sweeps, unless the refresh time is shorter.
+   */
+  static constexpr ndn::time::seconds REFRESH_SWEEP_TICK{1};
 };
 
 } // namespace nlsr
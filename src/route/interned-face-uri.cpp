@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "interned-face-uri.hpp"
+
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <set>
+
+namespace nlsr {
+
+InternedFaceUri::InternedFaceUri()
+{
+  static const Entry* const empty = intern(ndn::FaceUri());
+  m_entry = empty;
+}
+
+InternedFaceUri::InternedFaceUri(const ndn::FaceUri& faceUri)
+  : m_entry(intern(faceUri))
+{
+}
+
+const InternedFaceUri::Entry*
+InternedFaceUri::intern(const ndn::FaceUri& faceUri)
+{
+  struct ByFaceUri
+  {
+    using is_transparent = void;
+
+    bool
+    operator()(const Entry& lhs, const Entry& rhs) const
+    {
+      return lhs.faceUri < rhs.faceUri;
+    }
+
+    bool
+    operator()(const Entry& lhs, const ndn::FaceUri& rhs) const
+    {
+      return lhs.faceUri < rhs;
+    }
+
+    bool
+    operator()(const ndn::FaceUri& lhs, const Entry& rhs) const
+    {
+      return lhs < rhs.faceUri;
+    }
+  };
+
+  // routes are calculated on a worker thread
+  static std::mutex mutex;
+  // elements of a set do not move, and are never erased
+  static std::set<Entry, ByFaceUri> entries;
+
+  // gap left between FaceUris interned in increasing order
+  constexpr uint64_t STEP = uint64_t{1} << 32;
+  constexpr uint64_t MAX_RANK = std::numeric_limits<uint64_t>::max();
+
+  std::lock_guard<std::mutex> lock(mutex);
+
+  auto next = entries.lower_bound(faceUri);
+  if (next != entries.end() && next->faceUri == faceUri) {
+    return &*next;
+  }
+
+  // A rank between the ranks of the neighboring FaceUris. When there is none left, the rank
+  // of the previous one is taken, and the FaceUris are compared.
+  uint64_t rank = MAX_RANK / 2 + 1;
+  bool hasNext = next != entries.end();
+  bool hasPrev = next != entries.begin();
+  uint64_t nextRank = hasNext ? next->rank : MAX_RANK;
+  uint64_t prevRank = hasPrev ? std::prev(next)->rank : 0;
+  if (hasPrev && !hasNext) {
+    rank = prevRank <= MAX_RANK - STEP ? prevRank + STEP : prevRank + (MAX_RANK - prevRank) / 2;
+  }
+  else if (!hasPrev && hasNext) {
+    rank = nextRank >= STEP ? nextRank - STEP : nextRank / 2;
+  }
+  else if (hasPrev && hasNext) {
+    rank = prevRank + (nextRank - prevRank) / 2;
+  }
+
+  return &*entries.insert(next, Entry{faceUri, rank});
+}
+
+} // namespace nlsr
@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_INTERNED_FACE_URI_HPP
+#define NLSR_ROUTE_INTERNED_FACE_URI_HPP
+
+#include <ndn-cxx/net/face-uri.hpp>
+
+#include <boost/operators.hpp>
+
+#include <functional>
+
+namespace nlsr {
+
+/*! \brief Compact handle of a FaceUri, which is stored once for all the next hops through it.
+ *
+ * Copying a handle copies a pointer, and two handles are equal if they refer to the same
+ * FaceUri. Each FaceUri is given a rank when it is first interned, which orders the handles
+ * like the FaceUris, so that ordering them rarely compares the FaceUris themselves.
+ *
+ * Interned FaceUris are never released, as there are only as many as faces to neighbors.
+ * Handles can be created from any thread.
+ */
+class InternedFaceUri : private boost::totally_ordered<InternedFaceUri>
+{
+public:
+  /*! \brief Refer to the empty FaceUri.
+   */
+  InternedFaceUri();
+
+  explicit
+  InternedFaceUri(const ndn::FaceUri& faceUri);
+
+  const ndn::FaceUri&
+  get() const
+  {
+    return m_entry->faceUri;
+  }
+
+private: // non-member operators
+  // NOTE: the following "hidden friend" operators are available via
+  //       argument-dependent lookup only and must be defined inline.
+  // boost::totally_ordered provides !=, <=, >=, and > operators.
+
+  friend bool
+  operator==(const InternedFaceUri& lhs, const InternedFaceUri& rhs)
+  {
+    return lhs.m_entry == rhs.m_entry;
+  }
+
+  friend bool
+  operator<(const InternedFaceUri& lhs, const InternedFaceUri& rhs)
+  {
+    if (lhs.m_entry == rhs.m_entry) {
+      return false;
+    }
+    if (lhs.m_entry->rank != rhs.m_entry->rank) {
+      return lhs.m_entry->rank < rhs.m_entry->rank;
+    }
+    // the ranks between two neighboring FaceUris have run out
+    return lhs.get() < rhs.get();
+  }
+
+  friend size_t
+  hash_value(const InternedFaceUri& faceUri)
+  {
+    return std::hash<const void*>()(faceUri.m_entry);
+  }
+
+private:
+  struct Entry
+  {
+    ndn::FaceUri faceUri;
+    /// ranks of interned FaceUris are in the order of the FaceUris; never changed
+    uint64_t rank;
+  };
+
+  static const Entry*
+  intern(const ndn::FaceUri& faceUri);
+
+private:
+  const Entry* m_entry;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_INTERNED_FACE_URI_HPP
@@ -0,0 +1,216 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "link-state-graph.hpp"
+#include "name-map.hpp"
+
+#include "adjacent.hpp"
+#include "logger.hpp"
+#include "lsdb.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <optional>
+#include <tuple>
+#include <unordered_map>
+
+namespace nlsr {
+
+INIT_LOGGER(route.LinkStateGraph);
+
+LinkCost
+toLinkCost(double cost)
+{
+  if (!(cost > 0)) {
+    return 0;
+  }
+  double scaled = cost * LINK_COST_SCALE;
+  if (scaled >= MAX_LINK_COST) {
+    return MAX_LINK_COST;
+  }
+  return std::max<LinkCost>(static_cast<LinkCost>(std::lround(scaled)), 1);
+}
+
+LinkStateGraph
+LinkStateGraph::createFromAdjLsdb(const LsdbSnapshot& lsdb, const NameMap& map)
+{
+  size_t nRouters = map.size();
+  const auto& lsas = lsdb.getLsas<AdjLsa>();
+
+  // Router names are interned, so that all the LSAs refer to a single copy of each. Each name
+  // is looked up in the map once, then found again by the address of that copy.
+  std::unordered_map<const ndn::Name*, std::optional<int32_t>> mappingNos;
+  auto getMappingNo = [&] (const ndn::Name& router) {
+    auto [it, isNew] = mappingNos.try_emplace(&router);
+    if (isNew) {
+      it->second = map.getMappingNoByRouterName(router);
+    }
+    return it->second;
+  };
+
+  size_t nAdvertised = 0;
+  for (const auto& lsa : lsas) {
+    nAdvertised += static_cast<const AdjLsa&>(*lsa).getAdl().size();
+  }
+  std::vector<DirectedEdge> edges;
+  edges.reserve(nAdvertised);
+
+  for (const auto& lsa : lsas) {
+    const auto& adjLsa = static_cast<const AdjLsa&>(*lsa);
+    auto row = getMappingNo(adjLsa.getOriginRouter());
+    if (!row || *row >= static_cast<int32_t>(nRouters)) {
+      continue;
+    }
+
+    for (const auto& adjacent : adjLsa.getAdl()) {
+      auto col = getMappingNo(adjacent.getName());
+      if (col && *col < static_cast<int32_t>(nRouters)) {
+        edges.push_back({*row, *col, adjacent.getLinkCost()});
+      }
+    }
+  }
+
+  return createFromEdges(nRouters, std::move(edges));
+}
+
+LinkStateGraph
+LinkStateGraph::createFromEdges(size_t nRouters, std::vector<DirectedEdge> edges)
+{
+  auto byEndpoints = [] (const DirectedEdge& a, const DirectedEdge& b) {
+    return std::tie(a.from, a.to) < std::tie(b.from, b.to);
+  };
+  auto sameEndpoints = [] (const DirectedEdge& a, const DirectedEdge& b) {
+    return a.from == b.from && a.to == b.to;
+  };
+
+  // Keep only the last advertisement of each directed edge.
+  std::stable_sort(edges.begin(), edges.end(), byEndpoints);
+  auto last = edges.end();
+  auto out = edges.begin();
+  for (auto it = edges.begin(); it != last; ++it) {
+    if (std::next(it) != last && sameEndpoints(*it, *std::next(it))) {
+      continue;
+    }
+    *out++ = *it;
+  }
+  edges.erase(out, last);
+
+  auto findCost = [&edges, &byEndpoints] (int32_t from, int32_t to) {
+    DirectedEdge key{from, to, 0.0};
+    auto it = std::lower_bound(edges.begin(), edges.end(), key, byEndpoints);
+    if (it == edges.end() || it->from != from || it->to != to) {
+      return Adjacent::NON_ADJACENT_COST;
+    }
+    return it->cost;
+  };
+
+  // Links that do not have the same cost for both directions should
+  // have their costs corrected:
+  //
+  //   If the cost of one side of the link is NON_ADJACENT_COST (i.e. broken) or negative,
+  //   the link is dropped in both directions.
+  //
+  //   Otherwise, both sides of the link should use the larger of the two costs.
+  std::vector<DirectedEdge> links;
+  links.reserve(edges.size());
+  for (const auto& edge : edges) {
+    double toCost = edge.cost;
+    double fromCost = findCost(edge.to, edge.from);
+
+    double correctedCost = toCost;
+    if (fromCost != toCost) {
+      correctedCost = Adjacent::NON_ADJACENT_COST;
+      if (toCost >= 0 && fromCost >= 0) {
+        correctedCost = std::max(toCost, fromCost);
+      }
+
+      // Each mismatched pair is seen from both ends; log it only once.
+      if (edge.from < edge.to || fromCost == Adjacent::NON_ADJACENT_COST) {
+        NLSR_LOG_WARN("Cost between [" << edge.from << "][" << edge.to << "] and [" <<
+                      edge.to << "][" << edge.from << "] are not the same (" << toCost <<
+                      " != " << fromCost << "). " << "Correcting to cost: " << correctedCost);
+      }
+    }
+
+    if (correctedCost >= 0) {
+      links.push_back({edge.from, edge.to, correctedCost});
+    }
+  }
+
+  // The advertised edges were sorted by (from, to), so the links already are in CSR order.
+  LinkStateGraph graph;
+  graph.m_offsets.assign(nRouters + 1, 0);
+  graph.m_targets.reserve(links.size());
+  graph.m_costs.reserve(links.size());
+  for (const auto& link : links) {
+    ++graph.m_offsets[link.from + 1];
+    graph.m_targets.push_back(link.to);
+    graph.m_costs.push_back(toLinkCost(link.cost));
+  }
+  for (size_t i = 0; i < nRouters; ++i) {
+    graph.m_offsets[i + 1] += graph.m_offsets[i];
+  }
+  return graph;
+}
+
+double
+LinkStateGraph::getCost(int32_t from, int32_t to) const
+{
+  auto neighbors = getNeighbors(from);
+  auto it = std::lower_bound(neighbors.begin(), neighbors.end(), to);
+  if (it == neighbors.end() || *it != to) {
+    return Adjacent::NON_ADJACENT_COST;
+  }
+  return fromLinkCost(getCosts(from)[std::distance(neighbors.begin(), it)]);
+}
+
+void
+LinkStateGraph::setCost(int32_t a, int32_t b, double cost)
+{
+  for (auto [from, to] : {std::pair(a, b), std::pair(b, a)}) {
+    auto neighbors = getNeighbors(from);
+    auto it = std::lower_bound(neighbors.begin(), neighbors.end(), to);
+    if (it == neighbors.end() || *it != to) {
+      return;
+    }
+    m_costs[m_offsets[from] + std::distance(neighbors.begin(), it)] = toLinkCost(cost);
+  }
+}
+
+void
+LinkStateGraph::removeLink(int32_t a, int32_t b)
+{
+  for (auto [from, to] : {std::pair(a, b), std::pair(b, a)}) {
+    auto neighbors = getNeighbors(from);
+    auto it = std::lower_bound(neighbors.begin(), neighbors.end(), to);
+    if (it == neighbors.end() || *it != to) {
+      return;
+    }
+    auto pos = m_offsets[from] + std::distance(neighbors.begin(), it);
+    m_targets.erase(m_targets.begin() + pos);
+    m_costs.erase(m_costs.begin() + pos);
+    for (size_t i = from + 1; i < m_offsets.size(); ++i) {
+      --m_offsets[i];
+    }
+  }
+}
+
+} // namespace nlsr
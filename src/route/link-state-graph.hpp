@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_LINK_STATE_GRAPH_HPP
+#define NLSR_ROUTE_LINK_STATE_GRAPH_HPP
+
+#include "common.hpp"
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/util/span.hpp>
+
+#include <limits>
+#include <vector>
+
+namespace nlsr {
+
+class LsdbSnapshot;
+class NameMap;
+
+/**
+ * @brief Link cost or path distance in the SPF, in fixed point with @c LINK_COST_SCALE units
+ *        per advertised cost unit.
+ *
+ * Integer distances do not depend on the order in which costs are added, so every router
+ * finds the same distances, and breaks ties between equal-cost paths the same way.
+ */
+using LinkCost = uint32_t;
+
+/**
+ * @brief Number of LinkCost units per advertised cost unit.
+ *
+ * Fractional costs, such as RTT-based ones, then keep three decimals in the SPF.
+ */
+constexpr LinkCost LINK_COST_SCALE = 1000;
+
+/**
+ * @brief Largest link cost; larger costs are clamped to it, i.e. about 2.1 million advertised
+ *        cost units.
+ */
+constexpr LinkCost MAX_LINK_COST = std::numeric_limits<LinkCost>::max() / 2 - 1;
+
+/**
+ * @brief Convert an advertised link cost to the nearest LinkCost.
+ *
+ * Positive costs are clamped to `[1, MAX_LINK_COST]`, so that a small cost is not taken as a
+ * free link; other costs give 0.
+ */
+LinkCost
+toLinkCost(double cost);
+
+/**
+ * @brief Convert a LinkCost or a distance back to advertised cost units.
+ */
+inline double
+fromLinkCost(LinkCost cost)
+{
+  return static_cast<double>(cost) / LINK_COST_SCALE;
+}
+
+/**
+ * @brief Sparse router graph in compressed sparse row (CSR) form.
+ *
+ * Routers are identified by their NameMap mapping numbers. The neighbors of router @c u are
+ * stored contiguously, sorted by mapping number, in the range
+ * `[offsets[u], offsets[u + 1])` of the target and cost arrays.
+ *
+ * The graph is undirected: a link is present only if both routers advertise each other with a
+ * non-negative cost, in which case both directions carry the larger of the two costs, converted
+ * by toLinkCost().
+ * Memory and construction time are proportional to the number of links.
+ */
+class LinkStateGraph
+{
+public:
+  /**
+   * @brief Build the graph from the Adjacency LSAs in @p lsdb .
+   * @param lsdb LSDB snapshot providing Adjacency LSAs; it may be read outside of the io thread.
+   * @param map Mapping numbers of the routers; adjacencies to unmapped routers are ignored.
+   */
+  static LinkStateGraph
+  createFromAdjLsdb(const LsdbSnapshot& lsdb, const NameMap& map);
+
+  /**
+   * @brief Return number of routers in the graph.
+   */
+  size_t
+  size() const
+  {
+    return m_offsets.size() - 1;
+  }
+
+  /**
+   * @brief Return number of directed edges; each link is counted once per direction.
+   */
+  size_t
+  getNumEdges() const
+  {
+    return m_targets.size();
+  }
+
+  /**
+   * @brief Return mapping numbers of the neighbors of @p router , in ascending order.
+   */
+  ndn::span<const int32_t>
+  getNeighbors(int32_t router) const
+  {
+    return {m_targets.data() + m_offsets[router], m_offsets[router + 1] - m_offsets[router]};
+  }
+
+  /**
+   * @brief Return link costs toward the neighbors of @p router .
+   *
+   * The i-th element is the cost toward the i-th element of getNeighbors().
+   */
+  ndn::span<const LinkCost>
+  getCosts(int32_t router) const
+  {
+    return {m_costs.data() + m_offsets[router], m_offsets[router + 1] - m_offsets[router]};
+  }
+
+  /**
+   * @brief Return cost of the link between @p from and @p to .
+   * @returns Link cost, or @c Adjacent::NON_ADJACENT_COST if they are not adjacent.
+   */
+  double
+  getCost(int32_t from, int32_t to) const;
+
+  /**
+   * @brief Replace cost of the link between @p a and @p b , in both directions.
+   *
+   * The cost is converted by toLinkCost(). Nothing is changed if they are not adjacent.
+   */
+  void
+  setCost(int32_t a, int32_t b, double cost);
+
+  /**
+   * @brief Remove the link between @p a and @p b , in both directions.
+   *
+   * Nothing is changed if they are not adjacent.
+   */
+  void
+  removeLink(int32_t a, int32_t b);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  struct DirectedEdge
+  {
+    int32_t from;
+    int32_t to;
+    double cost;
+  };
+
+  /**
+   * @brief Build the graph from directed advertisements.
+   * @param nRouters Number of routers.
+   * @param edges Advertised edges; a later advertisement of the same edge overrides an earlier one.
+   */
+  static LinkStateGraph
+  createFromEdges(size_t nRouters, std::vector<DirectedEdge> edges);
+
+private:
+  std::vector<size_t> m_offsets{0};
+  std::vector<int32_t> m_targets;
+  std::vector<LinkCost> m_costs;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_LINK_STATE_GRAPH_HPP
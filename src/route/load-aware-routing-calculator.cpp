@@ -35,11 +35,7 @@ LoadAwareRoutingCalculator::LoadAwareRoutingCalculator(LinkCostManager& linkCost
   : m_linkCostManager(linkCostManager)
  {
   // ✅ 修正：使用正确的回调注册方法
-  m_linkCostManager.setLoadAwareCostCalculator(
-    [this](const ndn::Name& neighbor, double rttBasedCost, 
-           const LinkCostManager::LinkMetrics& metrics) {
-      return this->calculateLoadAwareCost(neighbor, rttBasedCost, metrics);
-    });
+  m_linkCostManager.setCostPolicy(this);
   
   NLSR_LOG_INFO("LoadAwareRoutingCalculator: Registered with LinkCostManager");
  }
@@ -47,20 +43,22 @@ LoadAwareRoutingCalculator::LoadAwareRoutingCalculator(LinkCostManager& linkCost
 LoadAwareRoutingCalculator::~LoadAwareRoutingCalculator()
  {
   // ✅ 清除回调，恢复标准模式
-  m_linkCostManager.clearLoadAwareCostCalculator();
+  m_linkCostManager.clearCostPolicy();
   
   NLSR_LOG_INFO("LoadAwareRoutingCalculator: Unregistered, LinkCostManager restored to standard mode");
  }
 
 void
-LoadAwareRoutingCalculator::calculatePath(NameMap& map, RoutingTable& rt,ConfParameter& confParam, const Lsdb& lsdb)
+LoadAwareRoutingCalculator::calculatePath(const NameMap& map, RoutingTable& rt,ConfParameter& confParam, const Lsdb& lsdb,
+                                          SpfState* spfState)
  {
   NLSR_LOG_DEBUG("LoadAwareRoutingCalculator::calculatePath called");
   ++m_calculationCount;
   
   // ✅ 简化：直接使用标准路由计算
   // 成本已经通过回调机制自动调整了
-  calculateLinkStateRoutingPath(map, rt, confParam, lsdb);
+  calculateLinkStateRoutingPath(map, rt, confParam, lsdb, spfState,
+                                m_linkCostManager.getLocalCostOverlay());
   
   NLSR_LOG_DEBUG("Load-aware routing calculation completed. Adjustments: " << m_costAdjustmentCount);
  }
@@ -68,56 +66,65 @@ LoadAwareRoutingCalculator::calculatePath(NameMap& map, RoutingTable& rt,ConfPar
 
 // ✅ 修正：确保方法签名与LinkCostManager回调完全匹配
 double
-LoadAwareRoutingCalculator::calculateLoadAwareCost(const ndn::Name& neighbor, double rttBasedCost,const LinkCostManager::LinkMetrics& metrics)
+LoadAwareRoutingCalculator::computeLinkCost(const LinkCostManager::OutgoingLinkState& link,
+                                            double rttBasedCost)
  {
   // ✅ 如果基础成本无效，直接返回
-  if (rttBasedCost <= 0 || metrics.originalCost <= 0) {
+  if (rttBasedCost <= 0 || link.originalCost <= 0) {
     return rttBasedCost;
   }
   
   // ✅ 计算各种影响因子
-  double rttFactor = getRttFactor(metrics);
-  double loadFactor = getLoadFactor(metrics);
-  double stabilityFactor = getStabilityFactor(metrics);
+  double rttFactor = getRttFactor(link);
+  double loadFactor = getLoadFactor(link);
+  double stabilityFactor = getStabilityFactor(link);
+  double congestionFactor = getCongestionFactor(link);
   
   // ✅ 计算综合调整因子
   double adjustmentFactor = m_rttWeight * rttFactor + 
                            m_loadWeight * loadFactor +
-                           m_stabilityWeight * stabilityFactor;
+                           m_stabilityWeight * stabilityFactor +
+                           m_congestionWeight * congestionFactor;
   
   // ✅ 应用调整因子到RTT成本
   double adjustedCost = rttBasedCost * (1.0 + adjustmentFactor);
   
   // ✅ 限制在合理范围内
-  adjustedCost = std::min(adjustedCost, metrics.originalCost * 3.0);
-  adjustedCost = std::max(adjustedCost, metrics.originalCost * 0.5);
+  adjustedCost = std::min(adjustedCost, link.originalCost * 3.0);
+  adjustedCost = std::max(adjustedCost, link.originalCost * 0.5);
   
   // ✅ 更新RTT历史（用于下次负载计算）
-  if (metrics.currentRtt) {
-    auto rttMs = ndn::time::duration_cast<ndn::time::milliseconds>(*metrics.currentRtt).count();
-    updateRttHistory(neighbor, rttMs);
+  if (link.rtt.hasSamples()) {
+    updateRttHistory(link.neighborId, getRttMs(link));
   }
   
   ++m_costAdjustmentCount;
   
-  NLSR_LOG_TRACE("Load-aware cost for " << neighbor
+  NLSR_LOG_TRACE("Load-aware cost for " << link.neighbor
                 << ": RTT-based=" << rttBasedCost
                 << ", factors(rtt=" << rttFactor 
                 << ", load=" << loadFactor
-                << ", stability=" << stabilityFactor << ")"
+                << ", stability=" << stabilityFactor
+                << ", congestion=" << congestionFactor << ")"
                 << ", final=" << adjustedCost);
   
   return adjustedCost;
  }
 
 double
-LoadAwareRoutingCalculator::getRttFactor(const LinkCostManager::LinkMetrics& metrics)
+LoadAwareRoutingCalculator::getRttMs(const LinkCostManager::OutgoingLinkState& link)
 {
-  if (!metrics.currentRtt) {
+  return ndn::time::duration_cast<ndn::time::milliseconds>(link.rtt.getSrtt()).count();
+}
+
+double
+LoadAwareRoutingCalculator::getRttFactor(const LinkCostManager::OutgoingLinkState& link)
+{
+  if (!link.rtt.hasSamples()) {
     return 0.0; // 没有RTT数据，不调整
   }
   
-  auto rttMsValue = ndn::time::duration_cast<ndn::time::milliseconds>(*metrics.currentRtt).count();
+  auto rttMsValue = getRttMs(link);
   
   if (rttMsValue <= RTT_THRESHOLD_EXCELLENT) {
     return 0.0;  // 优秀
@@ -133,21 +140,19 @@ LoadAwareRoutingCalculator::getRttFactor(const LinkCostManager::LinkMetrics& met
 }
 
 double
-LoadAwareRoutingCalculator::getLoadFactor(const LinkCostManager::LinkMetrics& metrics)
+LoadAwareRoutingCalculator::getLoadFactor(const LinkCostManager::OutgoingLinkState& link)
 {
   // ✅ 优先使用metrics中的RTT历史更新本地历史
-  if (metrics.currentRtt) {
-    auto rttMs = ndn::time::duration_cast<ndn::time::milliseconds>(*metrics.currentRtt).count();
-    updateRttHistory(metrics.neighbor, rttMs);
+  if (link.rtt.hasSamples()) {
+    updateRttHistory(link.neighborId, getRttMs(link));
   }
   
   // 基于RTT历史计算负载因子（变化率）
-  auto it = m_rttHistory.find(metrics.neighbor);
-  if (it == m_rttHistory.end() || it->second.size() < 3) {
+  if (link.neighborId >= m_rttHistory.size() || m_rttHistory[link.neighborId].size() < 3) {
     return 0.0; // 数据不足，不调整
   }
   
-  const auto& history = it->second;
+  const auto& history = m_rttHistory[link.neighborId];
   
   // 计算均值和标准差
   double sum = 0.0;
@@ -176,35 +181,40 @@ LoadAwareRoutingCalculator::getLoadFactor(const LinkCostManager::LinkMetrics& me
   }
 }
 
-// ✅ 修正：使用LinkMetrics参数
 double
-LoadAwareRoutingCalculator::getStabilityFactor(const LinkCostManager::LinkMetrics& metrics)
+LoadAwareRoutingCalculator::getStabilityFactor(const LinkCostManager::OutgoingLinkState& link)
 {
   double factor = 0.0;
   
   // 超时惩罚
-  if (metrics.timeoutCount) {
-    factor += *metrics.timeoutCount * 0.2;
-  }
+  factor += link.timeoutCount * 0.2;
   
   // 时间惩罚
-  if (metrics.lastSuccessTime) {
-    auto now = ndn::time::steady_clock::now();
-    auto timeSinceSuccess = now - *metrics.lastSuccessTime;
-    auto secondsSinceSuccess = ndn::time::duration_cast<ndn::time::seconds>(timeSinceSuccess).count();
-    
-    if (secondsSinceSuccess > 60) { // 超过1分钟
-      factor += std::min(2.0, secondsSinceSuccess / 60.0 * 0.1);
-    }
+  auto now = ndn::time::steady_clock::now();
+  auto timeSinceSuccess = now - link.lastSuccess;
+  auto secondsSinceSuccess = ndn::time::duration_cast<ndn::time::seconds>(timeSinceSuccess).count();
+  
+  if (secondsSinceSuccess > 60) { // 超过1分钟
+    factor += std::min(2.0, secondsSinceSuccess / 60.0 * 0.1);
   }
   
   return factor;
 }
 
+double
+LoadAwareRoutingCalculator::getCongestionFactor(const LinkCostManager::OutgoingLinkState& link)
+{
+  // on the scale of the RTT factor: a link marking every packet counts as a very poor RTT
+  return 2.0 * link.congestionMarkRate;
+}
+
 void
-LoadAwareRoutingCalculator::updateRttHistory(const ndn::Name& neighbor, double currentRttMs)
+LoadAwareRoutingCalculator::updateRttHistory(NeighborId id, double currentRttMs)
 {
-  auto& history = m_rttHistory[neighbor];
+  if (id >= m_rttHistory.size()) {
+    m_rttHistory.resize(id + 1);
+  }
+  auto& history = m_rttHistory[id];
   history.push_back(currentRttMs);
   
   // 保持历史记录大小在限制范围内
@@ -8,6 +8,7 @@
 #include <ndn-cxx/util/time.hpp>
 #include <unordered_map>
 #include <deque>
+#include <vector>
 
 #include "adjacency-list.hpp"  // ✅ 添加缺失的包含
 #include "lsdb.hpp"           // ✅ 添加缺失的包含
@@ -34,26 +35,32 @@ public:
   // 匹配你的实现文件
   explicit LoadAwareRoutingCalculator(LinkCostManager& linkCostManager);
   ~LoadAwareRoutingCalculator();
+
+  /**
+   * @brief Adjust the RTT-based cost of a link to its load, see LinkCostManager::CostPolicy.
+   */
+  double computeLinkCost(const LinkCostManager::OutgoingLinkState& link, double rttBasedCost);
   
   // 匹配你的实现文件
-  void calculatePath(NameMap& map, RoutingTable& rt, 
-                    ConfParameter& confParam, const Lsdb& lsdb);
+  void calculatePath(const NameMap& map, RoutingTable& rt, 
+                    ConfParameter& confParam, const Lsdb& lsdb,
+                    SpfState* spfState = nullptr);
 
 private:
   //void applyLoadAwareAdjustments(NameMap& map, RoutingTable& rt,ConfParameter& confParam, const Lsdb& lsdb);
                                 
   
   //核心：负载感知成本计算方法
-  double calculateLoadAwareCost(const ndn::Name& neighbor, double rttBasedCost, 
-                               const LinkCostManager::LinkMetrics& metrics);
-  
-  double getRttFactor(const LinkCostManager::LinkMetrics& metrics);
-  double getLoadFactor(const LinkCostManager::LinkMetrics& metrics);
-  double getStabilityFactor(const LinkCostManager::LinkMetrics& metrics);
+  double getRttFactor(const LinkCostManager::OutgoingLinkState& link);
+  double getLoadFactor(const LinkCostManager::OutgoingLinkState& link);
+  double getStabilityFactor(const LinkCostManager::OutgoingLinkState& link);
+  static double getCongestionFactor(const LinkCostManager::OutgoingLinkState& link);
+
+  static double getRttMs(const LinkCostManager::OutgoingLinkState& link);
   
   //double getOriginalLinkCost(const ndn::Name& sourceRouter,const ndn::Name& targetRouter);
   
-  void updateRttHistory(const ndn::Name& neighbor, double currentRttMs);
+  void updateRttHistory(NeighborId id, double currentRttMs);
   //bool shouldSuppressUpdate(const ndn::Name& neighbor, double newCost);
   //void recordCostUpdate(const ndn::Name& neighbor, double newCost);
   //void adjustRoutingTableCosts(RoutingTable& rt, const ndn::Name& neighbor,double originalCost, double newCost);
@@ -64,8 +71,10 @@ private:
   double m_rttWeight = 0.3;
   double m_loadWeight = 0.4;
   double m_stabilityWeight = 0.3;
+  double m_congestionWeight = 0.4;
   
-  std::unordered_map<ndn::Name, std::deque<double>> m_rttHistory;
+  // Indexed by NeighborId
+  std::vector<std::deque<double>> m_rttHistory;
   static constexpr size_t MAX_RTT_HISTORY = 10;
   
   struct CostUpdateRecord {
@@ -21,6 +21,11 @@
 #include <algorithm>
 #include <cmath>
 #include <chrono>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+
+#include <boost/asio/post.hpp>
 
 // 关键修正：显式命名空间引用，避免using namespace
 // 不使用 using namespace boost; 避免命名空间污染
@@ -29,34 +34,60 @@ namespace nlsr {
 
 INIT_LOGGER(route.MLAdaptiveCalculator);
 
+namespace {
+
+// Checkpoint layout, in host byte order: magic, version, feature count, weights, bias,
+// learning rate, update count, ready flag, then the time patterns of the neighbors
+constexpr uint32_t CHECKPOINT_MAGIC = 0x4e4c4d4c; // "NLML"
+constexpr uint32_t CHECKPOINT_VERSION = 2;
+
+template<typename T>
+void
+writeValue(std::ostream& os, const T& value)
+{
+  os.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+template<typename T>
+bool
+readValue(std::istream& is, T& value)
+{
+  is.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return static_cast<bool>(is);
+}
+
+bool
+isWithinForecastTolerance(double cost, double expected)
+{
+  return std::abs(cost - expected) <=
+         MLAdaptiveCalculator::FORECAST_TOLERANCE * std::max(std::abs(expected), 1.0);
+}
+
+} // namespace
+
 // ============================================================================
 // LinearRegressionModel Implementation
 // ============================================================================
 
-MLAdaptiveCalculator::LinearRegressionModel::LinearRegressionModel(size_t featureCount)
-  : m_weights(featureCount, 0.2)  // 初始化为小的随机值
-  , m_bias(0.0)
-  , m_updateCount(0)
-{
+MLAdaptiveCalculator::LinearRegressionModel::LinearRegressionModel()
   // ✅ 教学要点：启发式权重初始化的重要性
   // 在机器学习中，初始权重的选择直接影响模型的收敛速度和最终性能
   // 这里使用基于特征重要性的启发式初始化策略
-  if (featureCount >= 4) {
-    m_weights[0] = 0.4;  // RTT趋势权重较高 - 网络延迟是路由选择的关键因素
-    m_weights[1] = 0.3;  // 稳定性权重中等 - 连接稳定性影响用户体验
-    m_weights[2] = 0.2;  // 成功率权重中等 - 数据包投递成功率很重要
-    m_weights[3] = 0.1;  // 负载指示器权重较低 - 作为辅助判断因素
-  }
-  if (featureCount >= 5) {
-    m_weights[4] = 0.15; // 时间特征权重 - 考虑网络的时间模式
-  }
+  : m_weights{{0.4,    // RTT趋势权重较高 - 网络延迟是路由选择的关键因素
+               0.3,    // 稳定性权重中等 - 连接稳定性影响用户体验
+               0.2,    // 成功率权重中等 - 数据包投递成功率很重要
+               0.1,    // 负载指示器权重较低 - 作为辅助判断因素
+               0.15}}  // 时间特征权重 - 考虑网络的时间模式
+  , m_bias(0.0)
+  , m_updateCount(0)
+{
 }
 
 double
-MLAdaptiveCalculator::LinearRegressionModel::predict(const std::vector<double>& features) const
+MLAdaptiveCalculator::LinearRegressionModel::predict(const FeatureVector& features) const
 {
   double result = m_bias;
-  for (size_t i = 0; i < features.size() && i < m_weights.size(); ++i) {
+  for (size_t i = 0; i < FEATURE_COUNT; ++i) {
     result += m_weights[i] * features[i];
   }
   
@@ -67,13 +98,25 @@ MLAdaptiveCalculator::LinearRegressionModel::predict(const std::vector<double>&
 }
 
 void
-MLAdaptiveCalculator::LinearRegressionModel::updateOnline(const std::vector<double>& features, 
-                                                         double target, double learningRate)
+MLAdaptiveCalculator::LinearRegressionModel::predictBatch(const FeatureVector* features,
+                                                          size_t count, double* scores) const
 {
-  if (features.size() != m_weights.size()) {
-    return;
+  std::fill_n(scores, count, m_bias);
+  for (size_t j = 0; j < FEATURE_COUNT; ++j) {
+    double weight = m_weights[j];
+    for (size_t i = 0; i < count; ++i) {
+      scores[i] += weight * features[i][j];
+    }
   }
-  
+  for (size_t i = 0; i < count; ++i) {
+    scores[i] = 1.0 / (1.0 + std::exp(-scores[i]));
+  }
+}
+
+void
+MLAdaptiveCalculator::LinearRegressionModel::updateOnline(const FeatureVector& features, 
+                                                         double target, double learningRate)
+{
   double prediction = predict(features);
   double error = target - prediction;
   
@@ -81,7 +124,7 @@ MLAdaptiveCalculator::LinearRegressionModel::updateOnline(const std::vector<doub
   // 这里实现的是随机梯度下降(SGD)，这是机器学习中最基础也最重要的优化算法
   // 通过计算损失函数对参数的梯度，然后朝着梯度的反方向更新参数
   m_bias += learningRate * error;
-  for (size_t i = 0; i < m_weights.size(); ++i) {
+  for (size_t i = 0; i < FEATURE_COUNT; ++i) {
     m_weights[i] += learningRate * error * features[i];
   }
   
@@ -92,66 +135,159 @@ MLAdaptiveCalculator::LinearRegressionModel::updateOnline(const std::vector<doub
 // TemporalPatternLearner Implementation  
 // ============================================================================
 
-void
-MLAdaptiveCalculator::TemporalPatternLearner::updatePattern(const ndn::Name& neighbor, 
-                                                           double performance)
+MLAdaptiveCalculator::TemporalPatternLearner::TemporalPatternLearner(bool hasDayOfWeekPlanes)
+  : m_nPlanes(hasDayOfWeekPlanes ? DAYS_PER_WEEK : 1)
+{
+}
+
+std::chrono::seconds
+MLAdaptiveCalculator::TemporalPatternLearner::getUtcOffset() const
 {
   auto now = std::chrono::system_clock::now();
-  auto time_t = std::chrono::system_clock::to_time_t(now);
-  auto localtime = *std::localtime(&time_t);
-  
-  // ✅ 教学要点：时间粒度的选择策略
-  // 这里选择10分钟作为时间粒度，这是基于网络流量模式的经验选择
-  // 太细的粒度会导致数据稀疏，太粗的粒度会丢失重要的时间模式
-  int timeSlotKey = getTimeSlotKey(localtime.tm_hour, localtime.tm_min / 10 * 10);
-  
-  auto& timeSlot = m_timePatterns[neighbor][timeSlotKey];
+  if (now >= m_utcOffsetExpiry) {
+    // daylight saving time only changes on the hour, so the offset is valid until then
+    std::time_t time = std::chrono::system_clock::to_time_t(now);
+    std::tm local{};
+    ::localtime_r(&time, &local);
+    m_utcOffset = std::chrono::seconds(local.tm_gmtoff);
+    m_utcOffsetExpiry = std::chrono::time_point_cast<std::chrono::hours>(now) + std::chrono::hours(1);
+  }
+  return m_utcOffset;
+}
+
+auto
+MLAdaptiveCalculator::TemporalPatternLearner::getNextSlotStart(TimePoint time) const -> TimePoint
+{
+  auto offset = getUtcOffset();
+  auto localMinutes = std::chrono::duration_cast<std::chrono::minutes>(time.time_since_epoch() +
+                                                                       offset);
+  constexpr std::chrono::minutes SLOT_LENGTH(SLOT_MINUTES);
+  auto slotStart = localMinutes - localMinutes % SLOT_LENGTH;
+  return TimePoint(slotStart + SLOT_LENGTH - offset);
+}
+
+size_t
+MLAdaptiveCalculator::TemporalPatternLearner::getSlot(TimePoint time) const
+{
+  auto localMinutes = std::chrono::duration_cast<std::chrono::minutes>(time.time_since_epoch() +
+                                                                       getUtcOffset()).count();
+  constexpr int64_t MINUTES_PER_DAY = 24 * 60;
+  size_t slot = static_cast<size_t>(localMinutes % MINUTES_PER_DAY) / SLOT_MINUTES;
+  if (m_nPlanes == 1) {
+    return slot;
+  }
+  // 1970-01-01 was a Thursday; plane 0 is Sunday
+  size_t day = static_cast<size_t>((localMinutes / MINUTES_PER_DAY + 4) % DAYS_PER_WEEK);
+  return day * SLOTS_PER_DAY + slot;
+}
+
+void
+MLAdaptiveCalculator::TemporalPatternLearner::updatePattern(NeighborId id, double performance)
+{
+  size_t slotsPerNeighbor = m_nPlanes * SLOTS_PER_DAY;
+  if ((id + 1) * slotsPerNeighbor > m_slots.size()) {
+    m_slots.resize((id + 1) * slotsPerNeighbor);
+  }
+  auto& timeSlot = m_slots[id * slotsPerNeighbor + getCurrentSlot()];
   
   // ✅ 教学要点：指数移动平均(EMA)的优势
   // EMA能够给最新的数据更高的权重，同时保留历史信息
   // 这在网络环境中特别有用，因为网络状态会随时间变化
   if (timeSlot.sampleCount == 0) {
-    timeSlot.hour = localtime.tm_hour;
-    timeSlot.minute = localtime.tm_min / 10 * 10;
-    timeSlot.averagePerformance = performance;
-    timeSlot.sampleCount = 1;
+    timeSlot.averagePerformance = static_cast<float>(performance);
   } else {
     double alpha = 0.1; // 平滑因子 - 控制新旧数据的权重平衡
-    timeSlot.averagePerformance = alpha * performance + (1 - alpha) * timeSlot.averagePerformance;
-    timeSlot.sampleCount++;
+    timeSlot.averagePerformance = static_cast<float>(alpha * performance +
+                                                     (1 - alpha) * timeSlot.averagePerformance);
   }
-  
-  timeSlot.lastUpdate = ndn::time::steady_clock::now();
+  ++timeSlot.sampleCount;
 }
 
 double
-MLAdaptiveCalculator::TemporalPatternLearner::getTimeFeature(const ndn::Name& neighbor) const
+MLAdaptiveCalculator::TemporalPatternLearner::getTimeFeature(NeighborId id) const
 {
-  auto now = std::chrono::system_clock::now();
-  auto time_t = std::chrono::system_clock::to_time_t(now);
-  auto localtime = *std::localtime(&time_t);
-  
-  int currentTimeSlot = getTimeSlotKey(localtime.tm_hour, localtime.tm_min / 10 * 10);
-  
-  auto neighborIt = m_timePatterns.find(neighbor);
-  if (neighborIt != m_timePatterns.end()) {
-    auto slotIt = neighborIt->second.find(currentTimeSlot);
-    if (slotIt != neighborIt->second.end()) {
-      return slotIt->second.averagePerformance;
-    }
+  return getTimeFeature(id, getCurrentSlot());
+}
+
+double
+MLAdaptiveCalculator::TemporalPatternLearner::getTimeFeature(NeighborId id, size_t slot) const
+{
+  size_t index = id * m_nPlanes * SLOTS_PER_DAY + slot;
+  if (index < m_slots.size() && m_slots[index].sampleCount > 0) {
+    return m_slots[index].averagePerformance;
   }
   
   return 0.5; // 默认中等性能，当没有历史数据时的安全选择
 }
 
+void
+MLAdaptiveCalculator::TemporalPatternLearner::save(std::ostream& os,
+                                                   const GetNeighborName& getName) const
+{
+  size_t slotsPerNeighbor = m_nPlanes * SLOTS_PER_DAY;
+  size_t nNeighbors = m_slots.size() / slotsPerNeighbor;
+  writeValue(os, static_cast<uint32_t>(m_nPlanes));
+  writeValue(os, static_cast<uint32_t>(nNeighbors));
+  for (NeighborId id = 0; id < nNeighbors; ++id) {
+    const auto& wire = getName(id).wireEncode();
+    writeValue(os, static_cast<uint32_t>(wire.size()));
+    os.write(reinterpret_cast<const char*>(wire.data()), wire.size());
+    os.write(reinterpret_cast<const char*>(&m_slots[id * slotsPerNeighbor]),
+             slotsPerNeighbor * sizeof(TimeSlot));
+  }
+}
+
+bool
+MLAdaptiveCalculator::TemporalPatternLearner::load(std::istream& is,
+                                                   const GetNeighborId& getId)
+{
+  uint32_t nPlanes = 0, nNeighbors = 0;
+  if (!readValue(is, nPlanes) || !readValue(is, nNeighbors) || nPlanes > DAYS_PER_WEEK) {
+    return false;
+  }
+  // patterns learned with a different number of planes are read, but not used
+  bool isCompatible = nPlanes == m_nPlanes;
+  std::vector<TimeSlot> slots(nPlanes * SLOTS_PER_DAY);
+  for (uint32_t i = 0; i < nNeighbors; ++i) {
+    uint32_t wireSize = 0;
+    if (!readValue(is, wireSize) || wireSize > ndn::MAX_NDN_PACKET_SIZE) {
+      return false;
+    }
+    std::vector<uint8_t> wire(wireSize);
+    if (!is.read(reinterpret_cast<char*>(wire.data()), wireSize) ||
+        !is.read(reinterpret_cast<char*>(slots.data()), slots.size() * sizeof(TimeSlot))) {
+      return false;
+    }
+
+    ndn::Name neighbor;
+    try {
+      neighbor.wireDecode(ndn::Block(ndn::make_span(wire)));
+    }
+    catch (const std::exception&) {
+      return false;
+    }
+    // neighbor IDs can change across restarts, but names cannot
+    auto id = getId(neighbor);
+    if (isCompatible && id) {
+      size_t offset = *id * slots.size();
+      if (offset + slots.size() > m_slots.size()) {
+        m_slots.resize(offset + slots.size());
+      }
+      std::copy(slots.begin(), slots.end(), m_slots.begin() + offset);
+    }
+  }
+  return true;
+}
+
 // ============================================================================
 // MLAdaptiveCalculator Main Implementation
 // ============================================================================
 
-MLAdaptiveCalculator::MLAdaptiveCalculator(LinkCostManager& linkCostManager)
+MLAdaptiveCalculator::MLAdaptiveCalculator(LinkCostManager& linkCostManager,
+                                           const std::string& stateDir, bool hasWeeklyPatterns)
   : m_linkCostManager(linkCostManager)
-  , m_model(std::make_unique<LinearRegressionModel>(FEATURE_COUNT))
-  , m_patternLearner(std::make_unique<TemporalPatternLearner>())
+  , m_model(std::make_unique<LinearRegressionModel>())
+  , m_patternLearner(std::make_unique<TemporalPatternLearner>(hasWeeklyPatterns))
   , m_learningRate(0.01)
   , m_adaptationThreshold(0.2)
   , m_isModelReady(false)
@@ -160,11 +296,14 @@ MLAdaptiveCalculator::MLAdaptiveCalculator(LinkCostManager& linkCostManager)
   // ✅ 教学要点：回调机制的设计精髓
   // 通过lambda表达式注册回调，实现了ML算法与LinkCostManager的松耦合
   // 这种设计允许在不修改LinkCostManager核心逻辑的情况下添加智能能力
-  m_linkCostManager.setLoadAwareCostCalculator(
-    [this](const ndn::Name& neighbor, double rttBasedCost, 
-           const LinkCostManager::LinkMetrics& metrics) {
-      return this->predictLinkQuality(neighbor, metrics);
-    });
+  m_linkCostManager.setCostPolicy(this);
+  m_linkCostManager.setMLFeedbackTarget(*this);
+
+  if (!stateDir.empty()) {
+    m_checkpointPath = stateDir + "/nlsrMlModel.bin";
+    loadCheckpoint();
+  }
+  m_lastCheckpoint = ndn::time::steady_clock::now();
   
   NLSR_LOG_INFO("MLAdaptiveCalculator: Initialized with ML model registered");
 }
@@ -174,13 +313,118 @@ MLAdaptiveCalculator::~MLAdaptiveCalculator()
   // RAII原则的体现
   // 析构函数自动清理回调注册，确保没有悬挂指针和资源泄漏
   // 这是现代C++的最佳实践，让对象的生命周期管理变得自动和安全
-  m_linkCostManager.clearLoadAwareCostCalculator();
+  m_linkCostManager.clearCostPolicy();
+  m_linkCostManager.clearMLFeedbackTarget();
+  if (m_trainingWorker) {
+    // the model trained since the last publication is checkpointed too
+    m_trainingWorker->join();
+    if (m_training->modelUpdateCount != m_statistics.modelUpdateCount) {
+      publishModel(*m_training);
+    }
+  }
+  if (m_hasUncheckpointedUpdates) {
+    saveCheckpoint();
+  }
   NLSR_LOG_INFO("MLAdaptiveCalculator: Deregistered, LinkCostManager restored");
 }
 
 void
-MLAdaptiveCalculator::calculatePath(NameMap& map, RoutingTable& rt, 
-                                   ConfParameter& confParam, const Lsdb& lsdb)
+MLAdaptiveCalculator::saveCheckpoint()
+{
+  if (m_checkpointPath.empty()) {
+    return;
+  }
+
+  std::string tempPath = m_checkpointPath + ".tmp";
+  {
+    std::ofstream os(tempPath, std::ios::binary | std::ios::trunc);
+    writeValue(os, CHECKPOINT_MAGIC);
+    writeValue(os, CHECKPOINT_VERSION);
+    writeValue(os, static_cast<uint32_t>(FEATURE_COUNT));
+    for (double weight : m_model->getWeights()) {
+      writeValue(os, weight);
+    }
+    writeValue(os, m_model->getBias());
+    writeValue(os, m_learningRate);
+    writeValue(os, static_cast<uint64_t>(m_model->getUpdateCount()));
+    writeValue(os, static_cast<uint8_t>(m_isModelReady));
+    m_patternLearner->save(os, [this] (NeighborId id) {
+      const auto& links = m_linkCostManager.getOutgoingLinks();
+      return id < links.size() ? links[id].neighbor : ndn::Name();
+    });
+    if (!os) {
+      NLSR_LOG_WARN("Cannot write ML model checkpoint " << tempPath);
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tempPath, m_checkpointPath, ec);
+  if (ec) {
+    NLSR_LOG_WARN("Cannot write ML model checkpoint " << m_checkpointPath << ": " << ec.message());
+    return;
+  }
+  m_lastCheckpoint = ndn::time::steady_clock::now();
+  m_hasUncheckpointedUpdates = false;
+  NLSR_LOG_DEBUG("ML model checkpointed to " << m_checkpointPath);
+}
+
+void
+MLAdaptiveCalculator::loadCheckpoint()
+{
+  std::ifstream is(m_checkpointPath, std::ios::binary);
+  if (!is) {
+    NLSR_LOG_DEBUG("No ML model checkpoint at " << m_checkpointPath);
+    return;
+  }
+
+  uint32_t magic = 0, version = 0, featureCount = 0;
+  if (!readValue(is, magic) || !readValue(is, version) || !readValue(is, featureCount) ||
+      magic != CHECKPOINT_MAGIC || version != CHECKPOINT_VERSION || featureCount != FEATURE_COUNT) {
+    NLSR_LOG_WARN("Ignoring incompatible ML model checkpoint " << m_checkpointPath);
+    return;
+  }
+
+  FeatureVector weights{};
+  double bias = 0.0, learningRate = 0.0;
+  uint64_t updateCount = 0;
+  uint8_t isModelReady = 0;
+  bool isValid = true;
+  for (auto& weight : weights) {
+    isValid = isValid && readValue(is, weight) && std::isfinite(weight);
+  }
+  isValid = isValid && readValue(is, bias) && std::isfinite(bias) &&
+            readValue(is, learningRate) && learningRate > 0.0 &&
+            readValue(is, updateCount) && readValue(is, isModelReady);
+  auto patterns = std::make_unique<TemporalPatternLearner>(*m_patternLearner);
+  if (!isValid || !patterns->load(is, [this] (const ndn::Name& neighbor) {
+        return m_linkCostManager.getNeighborId(neighbor);
+      })) {
+    NLSR_LOG_WARN("Ignoring truncated or corrupt ML model checkpoint " << m_checkpointPath);
+    return;
+  }
+
+  m_model->restore(weights, bias, updateCount);
+  m_learningRate = learningRate;
+  m_isModelReady = isModelReady != 0;
+  m_patternLearner = std::move(patterns);
+  NLSR_LOG_INFO("Loaded ML model checkpoint " << m_checkpointPath << " after "
+                << updateCount << " updates");
+}
+
+void
+MLAdaptiveCalculator::maybeSaveCheckpoint()
+{
+  if (m_hasUncheckpointedUpdates &&
+      ndn::time::steady_clock::now() - m_lastCheckpoint >= CHECKPOINT_INTERVAL) {
+    saveCheckpoint();
+  }
+}
+
+void
+MLAdaptiveCalculator::calculatePath(const NameMap& map, RoutingTable& rt, 
+                                   ConfParameter& confParam, const Lsdb& lsdb,
+                                   SpfState* spfState)
 {
   NLSR_LOG_DEBUG("MLAdaptiveCalculator::calculatePath called");
   ++m_statistics.predictionCount;
@@ -188,44 +432,154 @@ MLAdaptiveCalculator::calculatePath(NameMap& map, RoutingTable& rt,
   // ✅ 教学要点：智能路由的实现策略
   // ML算法的智能体现在成本计算上，而不是路径算法本身
   // 这种设计保持了路由算法的稳定性，同时增加了智能决策能力
-  calculateLinkStateRoutingPath(map, rt, confParam, lsdb);
+  // The predictions are only edge weights of the local graph; the advertised costs stay
+  // RTT-based, so they need no Adjacency LSA.
+  calculateLinkStateRoutingPath(map, rt, confParam, lsdb, spfState, getCostOverlay());
   
   NLSR_LOG_DEBUG("ML adaptive routing calculation completed. Predictions: " 
                 << m_statistics.predictionCount);
 }
 
-std::vector<double>
-MLAdaptiveCalculator::extractCoreFeatures(const ndn::Name& neighbor)
+MLAdaptiveCalculator::FeatureVector
+MLAdaptiveCalculator::extractCoreFeatures(NeighborId id)
 {
-  std::vector<double> features(FEATURE_COUNT, 0.0);
+  FeatureVector features{};
   
   // ✅ 教学要点：特征工程的艺术
   // 特征工程是机器学习成功的关键，这里选择的每个特征都有明确的网络意义
   
   // 特征1: RTT趋势 - 捕获网络延迟的变化趋势
-  features[0] = calculateRttTrend(neighbor);
+  features[0] = calculateRttTrend(id);
   
   // 特征2: 稳定性 - 量化连接的稳定程度
-  features[1] = calculateRttVariationCoefficient(neighbor);
+  features[1] = calculateRttVariationCoefficient(id);
   
   // 特征3: 成功率 - 反映链路的可靠性
-  features[2] = calculateSuccessRate(neighbor);
+  features[2] = calculateSuccessRate(id);
   
   // 特征4: 负载指示器 - 检测网络拥塞状况
-  features[3] = calculateLoadIndicator(neighbor);
+  features[3] = calculateLoadIndicator(id);
   
   // 特征5: 时间模式特征 - 利用网络的时间规律性
-  features[4] = m_patternLearner->getTimeFeature(neighbor);
+  features[4] = m_patternLearner->getTimeFeature(id);
   
   return features;
 }
 
+LocalCostOverlay
+MLAdaptiveCalculator::getCostOverlay()
+{
+  auto overlay = m_linkCostManager.getLocalCostOverlay();
+  predictAllLinkCosts(overlay);
+  return overlay;
+}
+
+void
+MLAdaptiveCalculator::predictAllLinkCosts(LocalCostOverlay& overlay)
+{
+  reclaimHistory();
+  scoreLinks();
+  if (m_batchLinks.empty()) {
+    return;
+  }
+
+  overlay.reserve(overlay.size() + m_batchLinks.size());
+  for (size_t i = 0; i < m_batchLinks.size(); ++i) {
+    double cost = m_batchLinks[i]->originalCost * (1.0 + m_batchScores[i]);
+    overlay.emplace_back(m_batchLinks[i]->neighbor, cost);
+    NLSR_LOG_TRACE("Batch ML cost for " << m_batchLinks[i]->neighbor << ": " << cost);
+  }
+}
+
+void
+MLAdaptiveCalculator::scoreLinks(std::optional<size_t> slot)
+{
+  m_featureBatch.clear();
+  m_batchLinks.clear();
+  // Only links that went through computeLinkCost() have the history features need
+  for (const auto& link : m_linkCostManager.getOutgoingLinks()) {
+    if (link.status == Adjacent::STATUS_ACTIVE && !getRttHistory(link.neighborId).empty()) {
+      auto& features = m_featureBatch.emplace_back(extractCoreFeatures(link.neighborId));
+      if (slot) {
+        features[4] = m_patternLearner->getTimeFeature(link.neighborId, *slot);
+      }
+      m_batchLinks.push_back(&link);
+    }
+  }
+
+  m_batchScores.resize(m_batchLinks.size());
+  if (m_isModelReady && m_model) {
+    m_model->predictBatch(m_featureBatch.data(), m_featureBatch.size(), m_batchScores.data());
+  }
+  else {
+    for (size_t i = 0; i < m_featureBatch.size(); ++i) {
+      m_batchScores[i] = predictWithFixedWeights(m_featureBatch[i]);
+    }
+  }
+}
+
+std::chrono::system_clock::time_point
+MLAdaptiveCalculator::getNextSlotStart() const
+{
+  return m_patternLearner->getNextSlotStart(std::chrono::system_clock::now());
+}
+
+std::optional<MLAdaptiveCalculator::CostForecast>
+MLAdaptiveCalculator::forecastNextSlot()
+{
+  auto slotStart = getNextSlotStart();
+
+  scoreLinks();
+  std::vector<double> currentScores = m_batchScores;
+  scoreLinks(m_patternLearner->getSlot(slotStart));
+
+  CostForecast forecast{slotStart, {}};
+  forecast.costs.reserve(m_batchLinks.size());
+  bool hasChange = false;
+  for (size_t i = 0; i < m_batchLinks.size(); ++i) {
+    double originalCost = m_batchLinks[i]->originalCost;
+    double cost = originalCost * (1.0 + m_batchScores[i]);
+    if (!isWithinForecastTolerance(cost, originalCost * (1.0 + currentScores[i]))) {
+      hasChange = true;
+    }
+    forecast.costs.emplace_back(m_batchLinks[i]->neighbor, cost);
+  }
+  if (!hasChange) {
+    return std::nullopt;
+  }
+  return forecast;
+}
+
+bool
+MLAdaptiveCalculator::confirmForecast(const CostForecast& forecast)
+{
+  scoreLinks();
+  if (m_batchLinks.size() != forecast.costs.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < m_batchLinks.size(); ++i) {
+    const auto& [neighbor, forecastCost] = forecast.costs[i];
+    double cost = m_batchLinks[i]->originalCost * (1.0 + m_batchScores[i]);
+    if (m_batchLinks[i]->neighbor != neighbor || !isWithinForecastTolerance(cost, forecastCost)) {
+      NLSR_LOG_DEBUG("Live cost " << cost << " of " << m_batchLinks[i]->neighbor
+                     << " does not confirm the forecast");
+      return false;
+    }
+  }
+  return true;
+}
+
 double
-MLAdaptiveCalculator::predictLinkQuality(const ndn::Name& neighbor, 
-                                        const LinkCostManager::LinkMetrics& metrics)
+MLAdaptiveCalculator::computeLinkCost(const LinkCostManager::OutgoingLinkState& link, double)
+{
+  return predictLinkQuality(link);
+}
+
+double
+MLAdaptiveCalculator::predictLinkQuality(const LinkCostManager::OutgoingLinkState& link)
 {
   // ✅ 教学要点：特征提取与预测的流水线
-  auto features = extractCoreFeatures(neighbor);
+  auto features = extractCoreFeatures(link.neighborId);
   
   double mlPrediction = 0.0;
   if (m_isModelReady && m_model) {
@@ -238,19 +592,18 @@ MLAdaptiveCalculator::predictLinkQuality(const ndn::Name& neighbor,
   // ✅ 教学要点：ML预测与基础成本的融合策略
   // 这里使用乘法融合，保持了原有成本的基础结构
   // 同时让ML预测能够动态调整成本倍数
-  double finalCost = metrics.originalCost * (1.0 + mlPrediction);
+  double finalCost = link.originalCost * (1.0 + mlPrediction);
   
   // ✅ 更新特征计算所需的历史数据
-  if (metrics.currentRtt) {
-    auto rttMs = ndn::time::duration_cast<ndn::time::milliseconds>(*metrics.currentRtt).count();
-    auto& history = m_rttHistory[neighbor];
-    history.push_back(rttMs);
-    if (history.size() > MAX_RTT_HISTORY) {
-      history.pop_front();
+  if (link.rtt.hasSamples()) {
+    auto rttMs = ndn::time::duration_cast<ndn::time::milliseconds>(link.rtt.getSrtt()).count();
+    if (link.neighborId >= m_rttHistory.size()) {
+      m_rttHistory.resize(link.neighborId + 1);
     }
+    m_rttHistory[link.neighborId].add(rttMs);
   }
   
-  NLSR_LOG_TRACE("ML prediction for " << neighbor
+  NLSR_LOG_TRACE("ML prediction for " << link.neighbor
                 << ": features=[" << features[0] << "," << features[1] 
                 << "," << features[2] << "," << features[3] << "," << features[4] << "]"
                 << ", ml_score=" << mlPrediction 
@@ -264,17 +617,18 @@ MLAdaptiveCalculator::predictLinkQuality(const ndn::Name& neighbor,
 // ============================================================================
 
 double
-MLAdaptiveCalculator::predictWithFixedWeights(const std::vector<double>& features)
+MLAdaptiveCalculator::predictWithFixedWeights(const FeatureVector& features)
 {
+  static_assert(FIXED_WEIGHTS.size() <= FEATURE_COUNT);
   double score = 0.0;
-  for (size_t i = 0; i < features.size() && i < FIXED_WEIGHTS.size(); ++i) {
+  for (size_t i = 0; i < FIXED_WEIGHTS.size(); ++i) {
     score += FIXED_WEIGHTS[i] * features[i];
   }
   return std::max(0.0, std::min(score, 1.0));
 }
 
 MLAdaptiveCalculator::LinkQuality 
-MLAdaptiveCalculator::categorizeLinkQuality(const std::vector<double>& features)
+MLAdaptiveCalculator::categorizeLinkQuality(const FeatureVector& features)
 {
   // ✅ 教学要点：基于规则的智能分类
   // 这种分类方法结合了机器学习特征和专家知识
@@ -295,14 +649,13 @@ MLAdaptiveCalculator::categorizeLinkQuality(const std::vector<double>& features)
 // ============================================================================
 
 double
-MLAdaptiveCalculator::calculateRttTrend(const ndn::Name& neighbor)
+MLAdaptiveCalculator::calculateRttTrend(NeighborId id)
 {
-  auto it = m_rttHistory.find(neighbor);
-  if (it == m_rttHistory.end() || it->second.size() < 10) {
+  const auto& history = getRttHistory(id).getSamples();
+  if (history.size() < 10) {
     return 0.0; // 数据不足时返回中性值
   }
-  
-  const auto& history = it->second;
+
   size_t size = history.size();
   
   // ✅ 教学要点：滑动窗口趋势分析
@@ -327,66 +680,47 @@ MLAdaptiveCalculator::calculateRttTrend(const ndn::Name& neighbor)
 }
 
 double
-MLAdaptiveCalculator::calculateRttVariationCoefficient(const ndn::Name& neighbor)
+MLAdaptiveCalculator::calculateRttVariationCoefficient(NeighborId id)
 {
-  auto it = m_rttHistory.find(neighbor);
-  if (it == m_rttHistory.end() || it->second.size() < 3) {
+  const auto& history = getRttHistory(id);
+  if (history.size() < 3) {
     return 0.0;
   }
   
-  const auto& history = it->second;
-  
   // ✅ 教学要点：变异系数作为稳定性指标
   // 变异系数 = 标准差/均值，是一个归一化的离散程度度量
   // 在网络分析中，它能很好地反映连接的稳定性
-  double sum = 0.0;
-  for (double rtt : history) {
-    sum += rtt;
-  }
-  double mean = sum / history.size();
+  double mean = history.getMean();
   
   if (mean <= 0) return 1.0; // 异常情况处理
   
-  double variance = 0.0;
-  for (double rtt : history) {
-    variance += (rtt - mean) * (rtt - mean);
-  }
-  double stddev = std::sqrt(variance / history.size());
+  double stddev = std::sqrt(history.getVariance());
   
   double cv = stddev / mean;
   return std::min(cv, 1.0); // 限制最大值，避免极端情况
 }
 
 double
-MLAdaptiveCalculator::calculateSuccessRate(const ndn::Name& neighbor)
+MLAdaptiveCalculator::calculateSuccessRate(NeighborId id)
 {
   // ✅ 教学要点：基于RTT历史估算成功率
   // 这是一个实用的近似方法，假设RTT过高表示网络拥塞或不稳定
-  auto it = m_rttHistory.find(neighbor);
-  if (it == m_rttHistory.end() || it->second.empty()) {
+  const auto& history = getRttHistory(id);
+  if (history.empty()) {
     return 0.5; // 默认中等成功率
   }
-  
-  const auto& history = it->second;
-  int successCount = 0;
-  for (double rtt : history) {
-    if (rtt < 500.0) { // 500ms作为成功阈值
-      successCount++;
-    }
-  }
-  
-  return static_cast<double>(successCount) / history.size();
+
+  return static_cast<double>(history.getSuccessCount()) / history.size();
 }
 
 double
-MLAdaptiveCalculator::calculateLoadIndicator(const ndn::Name& neighbor)
+MLAdaptiveCalculator::calculateLoadIndicator(NeighborId id)
 {
-  auto it = m_rttHistory.find(neighbor);
-  if (it == m_rttHistory.end() || it->second.size() < 5) {
+  const auto& history = getRttHistory(id).getSamples();
+  if (history.size() < 5) {
     return 0.0;
   }
-  
-  const auto& history = it->second;
+
   size_t size = history.size();
   
   // ✅ 教学要点：二阶导数作为负载指示器
@@ -404,6 +738,68 @@ MLAdaptiveCalculator::calculateLoadIndicator(const ndn::Name& neighbor)
   return 0.0;
 }
 
+const MLAdaptiveCalculator::RttWindow&
+MLAdaptiveCalculator::getRttHistory(NeighborId id) const
+{
+  static const RttWindow EMPTY;
+  return id < m_rttHistory.size() ? m_rttHistory[id] : EMPTY;
+}
+
+void
+MLAdaptiveCalculator::reclaimHistory()
+{
+  const auto& links = m_linkCostManager.getOutgoingLinks();
+  if (m_rttHistory.size() > links.size()) {
+    m_rttHistory.resize(links.size());
+    m_rttHistory.shrink_to_fit();
+  }
+  if (m_performanceHistory.size() > links.size()) {
+    m_performanceHistory.resize(links.size());
+    m_performanceHistory.shrink_to_fit();
+  }
+  // A link that went down starts over when it comes back, like its RTT estimator
+  for (const auto& link : links) {
+    if (link.status != Adjacent::STATUS_ACTIVE && link.neighborId < m_rttHistory.size()) {
+      m_rttHistory[link.neighborId].clear();
+    }
+  }
+}
+
+void
+MLAdaptiveCalculator::RttWindow::add(double rttMs)
+{
+  if (m_samples.full()) {
+    double oldest = m_samples.front();
+    m_sum -= oldest;
+    m_sumSquares -= oldest * oldest;
+    if (oldest < SUCCESS_THRESHOLD_MS) {
+      --m_nSuccess;
+    }
+  }
+  m_samples.push_back(rttMs);
+  m_sum += rttMs;
+  m_sumSquares += rttMs * rttMs;
+  if (rttMs < SUCCESS_THRESHOLD_MS) {
+    ++m_nSuccess;
+  }
+
+  if (++m_nPushesSinceRecompute >= CAPACITY) {
+    recomputeSums();
+  }
+}
+
+void
+MLAdaptiveCalculator::RttWindow::recomputeSums()
+{
+  m_sum = 0.0;
+  m_sumSquares = 0.0;
+  for (size_t i = 0; i < m_samples.size(); ++i) {
+    m_sum += m_samples[i];
+    m_sumSquares += m_samples[i] * m_samples[i];
+  }
+  m_nPushesSinceRecompute = 0;
+}
+
 // ============================================================================
 // 在线学习和反馈机制
 // ============================================================================
@@ -414,70 +810,95 @@ MLAdaptiveCalculator::reportPathPerformance(const ndn::Name& neighbor, double ac
   // ✅ 教学要点：完整的学习循环
   // 这个方法实现了从预测到反馈到学习的完整循环，这是ML系统的核心
   
-  auto features = extractCoreFeatures(neighbor);
+  auto id = m_linkCostManager.getNeighborId(neighbor);
+  if (!id) {
+    NLSR_LOG_DEBUG("Ignoring performance feedback for unknown neighbor " << neighbor);
+    return;
+  }
+  auto features = extractCoreFeatures(*id);
   
   // 更新时间模式学习
-  m_patternLearner->updatePattern(neighbor, actualPerformance);
+  m_patternLearner->updatePattern(*id, actualPerformance);
   
   // 执行在线模型更新
-  updateModelWithFeedback(neighbor, features, actualPerformance);
-  
+  // The model is trained on a shadow copy by the worker, which publishes it back to the
+  // io_context; inference keeps using m_model meanwhile.
+  if (!m_trainingWorker) {
+    m_training = std::make_unique<TrainingState>(TrainingState{
+      *m_model, m_learningRate, m_statistics.averagePredictionError,
+      m_statistics.modelUpdateCount, m_lastModelUpdate});
+    m_trainingWorker = std::make_unique<boost::asio::thread_pool>(1);
+  }
+  boost::asio::post(*m_trainingWorker,
+    [this, sample = FeedbackSample{neighbor, features, actualPerformance,
+                                   m_statistics.predictionCount, ndn::time::steady_clock::now()},
+     &io = m_linkCostManager.getIoContext(), token = std::weak_ptr<int>(m_lifetimeToken)] {
+      if (!updateModelWithFeedback(*m_training, sample)) {
+        return;
+      }
+      boost::asio::post(io, [this, token, state = *m_training] {
+        if (token.expired()) {
+          return;
+        }
+        publishModel(state);
+      });
+    });
+
   // 记录性能历史，用于后续分析
   PerformanceRecord record;
   record.predictedScore = m_model->predict(features);
   record.actualPerformance = actualPerformance;
   record.timestamp = ndn::time::steady_clock::now();
   
-  auto& history = m_performanceHistory[neighbor];
-  history.push_back(record);
-  if (history.size() > MAX_PERFORMANCE_HISTORY) {
-    history.pop_front();
+  if (*id >= m_performanceHistory.size()) {
+    m_performanceHistory.resize(*id + 1);
   }
+  m_performanceHistory[*id].push_back(record);
   
   NLSR_LOG_DEBUG("Performance feedback for " << neighbor 
                 << ": predicted=" << record.predictedScore
                 << ", actual=" << actualPerformance);
+
+  m_hasUncheckpointedUpdates = true;
+  maybeSaveCheckpoint();
 }
 
-void
-MLAdaptiveCalculator::updateModelWithFeedback(const ndn::Name& neighbor,
-                                             const std::vector<double>& features, 
-                                             double actualPerformance)
+bool
+MLAdaptiveCalculator::updateModelWithFeedback(TrainingState& state,
+                                              const FeedbackSample& sample) const
 {
-  if (!m_model || features.size() != FEATURE_COUNT) {
-    return;
-  }
-  
-  double prediction = m_model->predict(features);
-  double error = std::abs(actualPerformance - prediction);
+  double prediction = state.model.predict(sample.features);
+  double error = std::abs(sample.actualPerformance - prediction);
   
   // ✅ 更新统计信息
-  if (m_statistics.predictionCount > 0) {
-    m_statistics.averagePredictionError = 
-      (m_statistics.averagePredictionError * (m_statistics.predictionCount - 1) + error) 
-      / m_statistics.predictionCount;
+  if (sample.predictionCount > 0) {
+    state.averagePredictionError = 
+      (state.averagePredictionError * (sample.predictionCount - 1) + error) 
+      / sample.predictionCount;
   } else {
-    m_statistics.averagePredictionError = error;
+    state.averagePredictionError = error;
   }
   
   // ✅ 教学要点：自适应学习策略
   // 只有在满足特定条件时才触发模型更新，避免过拟合和计算资源浪费
-  if (shouldTriggerModelUpdate(error)) {
-    adaptLearningRate();
-    m_model->updateOnline(features, actualPerformance, m_learningRate);
-    
-    ++m_statistics.modelUpdateCount;
-    m_lastModelUpdate = ndn::time::steady_clock::now();
-    m_isModelReady = true;
-    
-    NLSR_LOG_DEBUG("Model updated for " << neighbor 
-                  << ": error=" << error 
-                  << ", learning_rate=" << m_learningRate);
+  if (!shouldTriggerModelUpdate(state, error, sample.timestamp)) {
+    return false;
   }
+
+  adaptLearningRate(state);
+  state.model.updateOnline(sample.features, sample.actualPerformance, state.learningRate);
+  ++state.modelUpdateCount;
+  state.lastModelUpdate = sample.timestamp;
+
+  NLSR_LOG_DEBUG("Model updated for " << sample.neighbor 
+                << ": error=" << error 
+                << ", learning_rate=" << state.learningRate);
+  return true;
 }
 
 bool
-MLAdaptiveCalculator::shouldTriggerModelUpdate(double predictionError)
+MLAdaptiveCalculator::shouldTriggerModelUpdate(const TrainingState& state, double predictionError,
+                                               ndn::time::steady_clock::time_point now) const
 {
   // ✅ 教学要点：智能更新触发条件
   // 这些条件平衡了学习速度和计算效率
@@ -488,24 +909,51 @@ MLAdaptiveCalculator::shouldTriggerModelUpdate(double predictionError)
   }
   
   // 条件2: 定期更新保持模型活跃
-  auto timeSinceUpdate = ndn::time::steady_clock::now() - m_lastModelUpdate;
-  if (timeSinceUpdate > MIN_UPDATE_INTERVAL) {
-    return true;
-  }
-  
-  return false;
+  return now - state.lastModelUpdate > MIN_UPDATE_INTERVAL;
 }
 
 void
-MLAdaptiveCalculator::adaptLearningRate()
+MLAdaptiveCalculator::adaptLearningRate(TrainingState& state)
 {
   // ✅ 教学要点：自适应学习率调整
   // 根据模型的当前性能动态调整学习率，这是现代ML的重要技巧
-  if (m_statistics.averagePredictionError > 0.3) {
-    m_learningRate = std::min(0.05, m_learningRate * 1.1); // 误差大时加速学习
-  } else if (m_statistics.averagePredictionError < 0.1) {
-    m_learningRate = std::max(0.001, m_learningRate * 0.90); // 误差小时稳定学习
+  if (state.averagePredictionError > 0.3) {
+    state.learningRate = std::min(0.05, state.learningRate * 1.1); // 误差大时加速学习
+  } else if (state.averagePredictionError < 0.1) {
+    state.learningRate = std::max(0.001, state.learningRate * 0.90); // 误差小时稳定学习
+  }
+}
+
+void
+MLAdaptiveCalculator::publishModel(const TrainingState& state)
+{
+  *m_model = state.model;
+  m_learningRate = state.learningRate;
+  m_statistics.averagePredictionError = state.averagePredictionError;
+  m_statistics.modelUpdateCount = state.modelUpdateCount;
+  m_lastModelUpdate = state.lastModelUpdate;
+  m_isModelReady = true;
+  m_hasUncheckpointedUpdates = true;
+  maybeSaveCheckpoint();
+}
+
+void
+MLAdaptiveCalculator::reportMemory(MemoryStatus& status) const
+{
+  MemoryUsage history;
+  history.nElements = m_performanceHistory.size() + m_rttHistory.size();
+  history.nBytes = m_performanceHistory.capacity() * sizeof(m_performanceHistory[0]) +
+                   m_rttHistory.capacity() * sizeof(RttWindow) +
+                   m_featureBatch.capacity() * sizeof(FeatureVector) +
+                   m_batchLinks.capacity() * sizeof(m_batchLinks[0]) +
+                   m_batchScores.capacity() * sizeof(double);
+  if (m_model) {
+    history.nBytes += sizeof(LinearRegressionModel);
+  }
+  if (m_patternLearner) {
+    history.nBytes += sizeof(TemporalPatternLearner) + m_patternLearner->getMemory();
   }
+  status.addComponent("ml-history", history);
 }
 
 } // namespace nlsr
\ No newline at end of file
@@ -13,11 +13,18 @@
 #include "common.hpp"
 
 // 标准库头文件
+#include <algorithm>
 #include <vector>
 #include <unordered_map>
-#include <deque>
 #include <functional>
 #include <array>
+#include <chrono>
+#include <optional>
+#include <iosfwd>
+#include <memory>
+#include <string>
+
+#include <boost/asio/thread_pool.hpp>
 
 // NDN-CXX库头文件 
 #include <ndn-cxx/name.hpp>
@@ -26,6 +33,9 @@
 // 本地头文件（只包含必要的前向声明）
 #include "route/routing-table.hpp"
 #include "link-cost-manager.hpp"
+#include "memory-usage.hpp"
+#include "test-access-control.hpp"
+#include "utility/ring-buffer.hpp"
 
 namespace nlsr {
 
@@ -42,30 +52,109 @@ class Lsdb;
  */
 class MLAdaptiveCalculator {
 public:
+  static constexpr size_t FEATURE_COUNT = 5;
+
+  /**
+   * @brief Features of one link, see extractCoreFeatures()
+   *
+   * A fixed-size array, so that extracting features and predicting allocate nothing and the
+   * dot products have a compile-time trip count.
+   */
+  using FeatureVector = std::array<double, FEATURE_COUNT>;
+
   /**
    * @brief 构造函数
    * @param linkCostManager LinkCostManager的引用，用于智能成本计算集成
+   * @param stateDir Directory of the model checkpoint; empty disables checkpointing.
+   * @param hasWeeklyPatterns Learn the time pattern of each day of the week separately.
+   *
+   * A model checkpointed by a previous run in @p stateDir is loaded, so that learning
+   * resumes where it stopped instead of from the heuristic weights.
    */
-  explicit MLAdaptiveCalculator(LinkCostManager& linkCostManager);
+  explicit MLAdaptiveCalculator(LinkCostManager& linkCostManager, const std::string& stateDir = "",
+                                bool hasWeeklyPatterns = false);
   
   /**
    * @brief 析构函数，自动清理回调注册
    */
   ~MLAdaptiveCalculator();
+
+  /**
+   * @brief Write the model weights, bias, learning rate and time patterns to the checkpoint.
+   *
+   * The checkpoint is written to a temporary file and renamed, so that a crash while writing
+   * leaves the previous checkpoint intact. It is also written every CHECKPOINT_INTERVAL while
+   * the model learns, and on destruction.
+   */
+  void saveCheckpoint();
+
+  bool isModelReady() const { return m_isModelReady; }
   
   /**
    * @brief 执行路由路径计算
    */
-  void calculatePath(NameMap& map, RoutingTable& rt, 
-                    ConfParameter& confParam, const Lsdb& lsdb);
+  void calculatePath(const NameMap& map, RoutingTable& rt, 
+                    ConfParameter& confParam, const Lsdb& lsdb,
+                    SpfState* spfState = nullptr);
+
+  /**
+   * @brief Return the costs of this router's links that a calculation would use, predicted
+   *        from the current measurements.
+   */
+  LocalCostOverlay getCostOverlay();
 
   /**
    * @brief 报告路径的实际性能（用于在线学习）
    * @param neighbor 邻居节点名称
    * @param actualPerformance 实际性能值 (0-1，越低越好)
+   *
+   * The features and time patterns are updated immediately. The model is trained on a
+   * shadow copy on a worker thread, and the new weights are installed on the io_context
+   * afterwards, so that predictions never wait for training.
    */
   void reportPathPerformance(const ndn::Name& neighbor, double actualPerformance);
 
+  /**
+   * @brief Predict the cost of a link from its state, see LinkCostManager::CostPolicy.
+   *
+   * The prediction only records the link's history; the cost applied to the SPF graph is
+   * predicted again in the batch of the calculation.
+   */
+  double computeLinkCost(const LinkCostManager::OutgoingLinkState& link, double rttBasedCost);
+
+  /// Relative difference below which a forecast link cost is considered unchanged or confirmed
+  static constexpr double FORECAST_TOLERANCE = 0.1;
+
+  /**
+   * @brief Link costs forecast for a time slot of the time patterns.
+   */
+  struct CostForecast {
+    std::chrono::system_clock::time_point slotStart;
+    LocalCostOverlay costs;
+  };
+
+  /**
+   * @brief Return the time at which the next time slot of the time patterns begins.
+   */
+  std::chrono::system_clock::time_point getNextSlotStart() const;
+
+  /**
+   * @brief Forecast the link costs of the next time slot.
+   *
+   * The current measurements of each link are scored with the time pattern of the next slot
+   * instead of the current one.
+   * @return std::nullopt if no link cost is forecast to change by more than FORECAST_TOLERANCE
+   */
+  std::optional<CostForecast> forecastNextSlot();
+
+  /**
+   * @brief Check whether the live link costs match @p forecast within FORECAST_TOLERANCE.
+   *
+   * Meant to be called once the forecast slot has begun; a link that came up or went down
+   * since the forecast fails the check.
+   */
+  bool confirmForecast(const CostForecast& forecast);
+
   /**
    * @brief ML算法统计信息
    */
@@ -78,23 +167,49 @@ public:
   
   const Statistics& getStatistics() const { return m_statistics; }
 
-private:
+  /**
+   * @brief Add the memory of the histories of the links and of the learned patterns to
+   *        @p status .
+   */
+  void reportMemory(MemoryStatus& status) const;
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   /**
    * @brief 轻量级线性回归模型
    */
   class LinearRegressionModel {
   public:
-    explicit LinearRegressionModel(size_t featureCount);
+    LinearRegressionModel();
     
-    double predict(const std::vector<double>& features) const;
+    double predict(const FeatureVector& features) const;
+
+    /**
+     * @brief Predict the scores of @p count feature vectors into @p scores .
+     *
+     * The weighted sums are accumulated feature by feature over the whole batch, so that the
+     * inner loop runs over the links and can be vectorized.
+     */
+    void predictBatch(const FeatureVector* features, size_t count, double* scores) const;
     
-    void updateOnline(const std::vector<double>& features, 
+    void updateOnline(const FeatureVector& features, 
                      double target, double learningRate);
     
-    const std::vector<double>& getWeights() const { return m_weights; }
+    const FeatureVector& getWeights() const { return m_weights; }
+
+    double getBias() const { return m_bias; }
+
+    size_t getUpdateCount() const { return m_updateCount; }
+
+    void
+    restore(const FeatureVector& weights, double bias, size_t updateCount)
+    {
+      m_weights = weights;
+      m_bias = bias;
+      m_updateCount = updateCount;
+    }
     
   private:
-    std::vector<double> m_weights;
+    FeatureVector m_weights;
     double m_bias;
     size_t m_updateCount;
   };
@@ -104,43 +219,216 @@ private:
    */
   class TemporalPatternLearner {
   public:
+    static constexpr size_t SLOT_MINUTES = 10;
+    static constexpr size_t SLOTS_PER_DAY = 24 * 60 / SLOT_MINUTES;
+    static constexpr size_t DAYS_PER_WEEK = 7;
+
     struct TimeSlot {
-      int hour;
-      int minute; 
-      double averagePerformance;
-      int sampleCount;
-      ndn::time::steady_clock::time_point lastUpdate;
+      float averagePerformance = 0.0f;
+      uint32_t sampleCount = 0;
     };
+
+    using GetNeighborName = std::function<ndn::Name(NeighborId)>;
+    using GetNeighborId = std::function<std::optional<NeighborId>(const ndn::Name&)>;
+
+    /**
+     * @param hasDayOfWeekPlanes Learn a separate pattern for each day of the week.
+     */
+    explicit TemporalPatternLearner(bool hasDayOfWeekPlanes = false);
     
-    void updatePattern(const ndn::Name& neighbor, double performance);
-    double getTimeFeature(const ndn::Name& neighbor) const;
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    void updatePattern(NeighborId id, double performance);
+    double getTimeFeature(NeighborId id) const;
+    /// @brief Return the learned performance of slot @p slot , see getSlot().
+    double getTimeFeature(NeighborId id, size_t slot) const;
+
+    /**
+     * @brief Return the index of the time slot of @p time within the slots of a neighbor.
+     *
+     * The local time is derived from a cached UTC offset, which is refreshed every full
+     * hour of the system clock to follow daylight saving time.
+     */
+    size_t getSlot(TimePoint time) const;
+
+    /// @brief Return the time at which the slot following the one of @p time begins.
+    TimePoint getNextSlotStart(TimePoint time) const;
+
+    /// @brief Return the bytes of the slots of all neighbors.
+    size_t getMemory() const
+    {
+      return m_slots.capacity() * sizeof(TimeSlot);
+    }
+
+    void save(std::ostream& os, const GetNeighborName& getName) const;
+    /// @return false if the input is truncated
+    bool load(std::istream& is, const GetNeighborId& getId);
     
   private:
-    std::unordered_map<ndn::Name, std::unordered_map<int, TimeSlot>> m_timePatterns;
-    
-    int getTimeSlotKey(int hour, int minute) const {
-      return hour * 60 + minute;
+    size_t getCurrentSlot() const
+    {
+      return getSlot(std::chrono::system_clock::now());
     }
+
+    std::chrono::seconds getUtcOffset() const;
+
+  private:
+    // 1 or DAYS_PER_WEEK planes of SLOTS_PER_DAY slots per neighbor, contiguous and indexed
+    // by NeighborId
+    std::vector<TimeSlot> m_slots;
+    size_t m_nPlanes;
+    mutable std::chrono::seconds m_utcOffset{0};
+    mutable std::chrono::system_clock::time_point m_utcOffsetExpiry;
+  };
+
+  /**
+   * @brief The last RTT samples of a neighbor, with running sums of the window.
+   *
+   * The mean, variance and success rate of the window are O(1) to read. The sums are
+   * recomputed from the samples once per CAPACITY pushes, so that rounding errors of the
+   * incremental updates do not accumulate.
+   */
+  class RttWindow {
+  public:
+    static constexpr size_t CAPACITY = 20;
+    /// RTTs below this are counted as successful
+    static constexpr double SUCCESS_THRESHOLD_MS = 500.0;
+
+    using Samples = util::RingBuffer<double, CAPACITY>;
+
+    void add(double rttMs);
+
+    void clear()
+    {
+      *this = RttWindow();
+    }
+
+    const Samples& getSamples() const
+    {
+      return m_samples;
+    }
+
+    size_t size() const
+    {
+      return m_samples.size();
+    }
+
+    bool empty() const
+    {
+      return m_samples.empty();
+    }
+
+    double getMean() const
+    {
+      return empty() ? 0.0 : m_sum / size();
+    }
+
+    /// @brief Population variance of the window.
+    double getVariance() const
+    {
+      if (empty()) {
+        return 0.0;
+      }
+      double mean = getMean();
+      return std::max(m_sumSquares / size() - mean * mean, 0.0);
+    }
+
+    size_t getSuccessCount() const
+    {
+      return m_nSuccess;
+    }
+
+  private:
+    void recomputeSums();
+
+  private:
+    Samples m_samples;
+    double m_sum = 0.0;
+    double m_sumSquares = 0.0;
+    size_t m_nSuccess = 0;
+    size_t m_nPushesSinceRecompute = 0;
   };
 
   // ✅ 核心算法接口
-  std::vector<double> extractCoreFeatures(const ndn::Name& neighbor);
-  double predictLinkQuality(const ndn::Name& neighbor, 
-                           const LinkCostManager::LinkMetrics& metrics);
-  double predictWithFixedWeights(const std::vector<double>& features);
+  FeatureVector extractCoreFeatures(NeighborId id);
+  double predictLinkQuality(const LinkCostManager::OutgoingLinkState& link);
+  double predictWithFixedWeights(const FeatureVector& features);
+
+  /**
+   * @brief Score all links that have RTT history in one batch and return their predicted costs.
+   *
+   * The costs are appended to @p overlay , after the entries already there, so that they take
+   * precedence in the SPF graph. The feature matrix is reused across calculations.
+   */
+  void predictAllLinkCosts(LocalCostOverlay& overlay);
+
+  /**
+   * @brief Score all active links that have RTT history into m_batchLinks and m_batchScores.
+   * @param slot Time slot of the time feature; the current slot if not set.
+   */
+  void scoreLinks(std::optional<size_t> slot = std::nullopt);
 
   // ✅ 特征工程函数
-  double calculateRttTrend(const ndn::Name& neighbor);
-  double calculateRttVariationCoefficient(const ndn::Name& neighbor);
-  double calculateSuccessRate(const ndn::Name& neighbor);
-  double calculateLoadIndicator(const ndn::Name& neighbor);
+  double calculateRttTrend(NeighborId id);
+  double calculateRttVariationCoefficient(NeighborId id);
+  double calculateSuccessRate(NeighborId id);
+  double calculateLoadIndicator(NeighborId id);
+
+  /**
+   * @brief Return the RTT history of a neighbor, empty if no RTT was recorded yet.
+   */
+  const RttWindow& getRttHistory(NeighborId id) const;
+
+  /**
+   * @brief Release the history of neighbors that are gone and of links that went down.
+   *
+   * Neighbors only disappear when the AdjacencyList is reset, after which LinkCostManager
+   * renumbers its links from zero, so the histories beyond the current link count are dropped.
+   */
+  void reclaimHistory();
+
+  /**
+   * @brief A performance feedback, queued for the training worker.
+   */
+  struct FeedbackSample {
+    ndn::Name neighbor;
+    FeatureVector features;
+    double actualPerformance;
+    /// Predictions made when the feedback was reported, which weigh the average error
+    uint64_t predictionCount;
+    ndn::time::steady_clock::time_point timestamp;
+  };
+
+  /**
+   * @brief The shadow model and the learning state, owned by the training worker.
+   *
+   * A copy is published to the io_context after each model update.
+   */
+  struct TrainingState {
+    LinearRegressionModel model;
+    double learningRate;
+    double averagePredictionError;
+    uint64_t modelUpdateCount;
+    ndn::time::steady_clock::time_point lastModelUpdate;
+  };
 
   // ✅ 在线学习机制
-  void updateModelWithFeedback(const ndn::Name& neighbor,
-                              const std::vector<double>& features, 
-                              double actualPerformance);
-  bool shouldTriggerModelUpdate(double predictionError);
-  void adaptLearningRate();
+  /**
+   * @brief Train the shadow model with @p sample ; runs on the training worker.
+   * @return whether the model was updated
+   */
+  bool updateModelWithFeedback(TrainingState& state, const FeedbackSample& sample) const;
+  bool shouldTriggerModelUpdate(const TrainingState& state, double predictionError,
+                                ndn::time::steady_clock::time_point now) const;
+  static void adaptLearningRate(TrainingState& state);
+
+  /**
+   * @brief Install the model published by the training worker.
+   */
+  void publishModel(const TrainingState& state);
+
+  void loadCheckpoint();
+  void maybeSaveCheckpoint();
 
 private:
   // ✅ 关键：核心依赖关系
@@ -153,7 +441,6 @@ private:
   double m_adaptationThreshold;
   
   // ✅ 算法常量
-  static constexpr size_t FEATURE_COUNT = 5;
   static constexpr std::array<double, 4> FIXED_WEIGHTS{{0.4, 0.3, 0.2, 0.1}};
   
   // ✅ 数据缓存
@@ -163,11 +450,16 @@ private:
     ndn::time::steady_clock::time_point timestamp;
   };
   
-  std::unordered_map<ndn::Name, std::deque<PerformanceRecord>> m_performanceHistory;
-  std::unordered_map<ndn::Name, std::deque<double>> m_rttHistory;
-  
   static constexpr size_t MAX_PERFORMANCE_HISTORY = 100;
-  static constexpr size_t MAX_RTT_HISTORY = 20;
+
+  // Indexed by NeighborId
+  std::vector<util::RingBuffer<PerformanceRecord, MAX_PERFORMANCE_HISTORY>> m_performanceHistory;
+  std::vector<RttWindow> m_rttHistory;
+
+  // Batch of predictAllLinkCosts(), kept to avoid reallocating on every calculation
+  std::vector<FeatureVector> m_featureBatch;
+  std::vector<const LinkCostManager::OutgoingLinkState*> m_batchLinks;
+  std::vector<double> m_batchScores;
   
   // ✅ 运行时状态
   mutable Statistics m_statistics;
@@ -176,10 +468,23 @@ private:
   
   // ✅ 现在可以安全地使用 common.hpp 中的时间常量
   static constexpr auto MIN_UPDATE_INTERVAL = 30_s;  // 使用时间字面量
+  static constexpr auto CHECKPOINT_INTERVAL = 5_min;
+
+  // Path of the model checkpoint, empty if checkpointing is disabled
+  std::string m_checkpointPath;
+  ndn::time::steady_clock::time_point m_lastCheckpoint;
+  bool m_hasUncheckpointedUpdates = false;
+
+  /// Worker thread of the model training, created on the first feedback.
+  std::unique_ptr<boost::asio::thread_pool> m_trainingWorker;
+  /// Trained by m_trainingWorker, and only accessed from it once the worker exists.
+  std::unique_ptr<TrainingState> m_training;
+  /// Lets models published to the io_context detect that the calculator is gone.
+  std::shared_ptr<int> m_lifetimeToken = std::make_shared<int>(0);
   
   // ✅ 枚举类型定义
   enum class LinkQuality { EXCELLENT, GOOD, FAIR, POOR };
-  LinkQuality categorizeLinkQuality(const std::vector<double>& features);
+  LinkQuality categorizeLinkQuality(const FeatureVector& features);
 };
 
 } // namespace nlsr
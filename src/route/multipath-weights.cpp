@@ -0,0 +1,85 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "multipath-weights.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace nlsr {
+
+std::vector<double>
+computeSplitWeights(const std::vector<double>& routeCosts,
+                    const std::vector<std::optional<double>>& spareCapacities)
+{
+  double knownSum = 0.0;
+  size_t nKnown = 0;
+  for (const auto& capacity : spareCapacities) {
+    if (capacity) {
+      knownSum += std::max(*capacity, 0.0);
+      ++nKnown;
+    }
+  }
+  double defaultCapacity = nKnown > 0 ? knownSum / nKnown : 1.0;
+
+  std::vector<double> weights(routeCosts.size());
+  for (size_t i = 0; i < routeCosts.size(); ++i) {
+    double capacity = spareCapacities[i] ? std::max(*spareCapacities[i], 0.0) : defaultCapacity;
+    weights[i] = capacity / std::max(routeCosts[i], 1.0);
+  }
+
+  double maxWeight = weights.empty() ? 0.0 : *std::max_element(weights.begin(), weights.end());
+  if (maxWeight <= 0.0) {
+    // no spare capacity anywhere: split by route cost only
+    for (size_t i = 0; i < routeCosts.size(); ++i) {
+      weights[i] = 1.0 / std::max(routeCosts[i], 1.0);
+    }
+    maxWeight = *std::max_element(weights.begin(), weights.end());
+  }
+  for (auto& weight : weights) {
+    weight = std::max(weight, maxWeight * MIN_RELATIVE_WEIGHT);
+  }
+
+  double sum = std::accumulate(weights.begin(), weights.end(), 0.0);
+  for (auto& weight : weights) {
+    weight /= sum;
+  }
+  return weights;
+}
+
+std::vector<double>
+getWeightedCosts(const std::vector<double>& routeCosts, const std::vector<double>& weights)
+{
+  std::vector<double> costs(routeCosts.size());
+  if (routeCosts.empty()) {
+    return costs;
+  }
+
+  size_t best = std::distance(weights.begin(), std::max_element(weights.begin(), weights.end()));
+  for (size_t i = 0; i < routeCosts.size(); ++i) {
+    costs[i] = i == best ? routeCosts[i] :
+                           std::round(std::max(routeCosts[best], 1.0) * weights[best] / weights[i]);
+  }
+  return costs;
+}
+
+} // namespace nlsr
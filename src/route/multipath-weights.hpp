@@ -0,0 +1,58 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_MULTIPATH_WEIGHTS_HPP
+#define NLSR_ROUTE_MULTIPATH_WEIGHTS_HPP
+
+#include <optional>
+#include <vector>
+
+namespace nlsr {
+
+/// Smallest share of a next hop, relative to the largest share of the same route
+constexpr double MIN_RELATIVE_WEIGHT = 0.01;
+
+/**
+ * @brief Compute the traffic share of each next hop of a multipath route.
+ * @param routeCosts Route cost of each next hop.
+ * @param spareCapacities Spare capacity of the link of each next hop, in any common unit, or
+ *                        std::nullopt if unknown. Unknown capacities are taken as the mean of
+ *                        the known ones.
+ * @return Share of each next hop, proportional to its spare capacity over its route cost, and
+ *         summing to 1. No share is smaller than MIN_RELATIVE_WEIGHT times the largest one.
+ */
+std::vector<double>
+computeSplitWeights(const std::vector<double>& routeCosts,
+                    const std::vector<std::optional<double>>& spareCapacities);
+
+/**
+ * @brief Return the costs with which the next hops are registered to NFD.
+ *
+ * NFD forwards by route cost only, so the shares are expressed in the costs: the next hop with
+ * the largest share keeps its route cost, and the cost of each other next hop grows in inverse
+ * proportion to its share. Without spare capacities, the route costs are returned unchanged.
+ */
+std::vector<double>
+getWeightedCosts(const std::vector<double>& routeCosts, const std::vector<double>& weights);
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_MULTIPATH_WEIGHTS_HPP
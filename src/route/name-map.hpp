@@ -29,6 +29,7 @@
 #include <boost/concept_check.hpp>
 
 #include <optional>
+#include <unordered_set>
 
 namespace nlsr {
 
@@ -59,12 +60,20 @@ public:
   {
     BOOST_CONCEPT_ASSERT((boost::InputIterator<IteratorType>));
     NameMap map;
+    // Router names are interned, so each is inserted once, then skipped by the address of its
+    // single copy without being hashed again.
+    std::unordered_set<const ndn::Name*> added;
+    auto addRouter = [&] (const ndn::Name& router) {
+      if (added.insert(&router).second) {
+        map.addEntry(router);
+      }
+    };
     for (auto it = first; it != last; ++it) {
       // *it has type std::shared_ptr<Lsa> ; it->get() has type Lsa*
       auto lsa = static_cast<const AdjLsa*>(it->get());
-      map.addEntry(lsa->getOriginRouter());
-      for (const auto& adjacent : lsa->getAdl().getAdjList()) {
-        map.addEntry(adjacent.getName());
+      addRouter(lsa->getOriginRouter());
+      for (const auto& adjacent : lsa->getAdl()) {
+        addRouter(adjacent.getName());
       }
     }
     return map;
@@ -25,51 +25,64 @@
 #include "nexthop.hpp"
 #include "logger.hpp"
 
+#include <algorithm>
+
 namespace nlsr {
 
 INIT_LOGGER(route.NamePrefixTableEntry);
 
-void
+bool
 NamePrefixTableEntry::generateNhlfromRteList()
 {
-  m_nexthopList.clear();
-  for (auto iterator = m_rteList.begin(); iterator != m_rteList.end(); ++iterator) {
-    for (auto nhItr = (*iterator)->getNexthopList().getNextHops().begin();
-         nhItr != (*iterator)->getNexthopList().getNextHops().end();
-         ++nhItr) {
-      m_nexthopList.addNextHop((*nhItr));
+  NexthopList nexthopList;
+  if (m_rteList.size() == 1) {
+    // the next hops of a single routing entry are already unique and sorted
+    nexthopList = m_rteList.front()->getNexthopList();
+  }
+  else {
+    for (const auto& rte : m_rteList) {
+      for (const auto& nexthop : rte->getNexthopList().getNextHops()) {
+        nexthopList.addNextHop(nexthop);
+      }
     }
   }
+
+  if (nexthopList == m_nexthopList) {
+    return false;
+  }
+  m_nexthopList = std::move(nexthopList);
+  return true;
 }
 
 uint64_t
-NamePrefixTableEntry::removeRoutingTableEntry(std::shared_ptr<RoutingTablePoolEntry> entryPtr)
+NamePrefixTableEntry::removeRoutingTableEntry(RoutingTablePoolEntry& rtpe)
 {
-  auto iterator = std::find(m_rteList.begin(), m_rteList.end(), entryPtr);
+  auto iterator = std::find(m_rteList.begin(), m_rteList.end(), &rtpe);
 
   if (iterator != m_rteList.end()) {
-    (*iterator)->decrementUseCount();
+    rtpe.decrementUseCount();
     // Remove this NamePrefixEntry from the RoutingTablePoolEntry
-    (*iterator)->namePrefixTableEntries.erase(getNamePrefix());
+    rtpe.namePrefixTableEntries.erase(this);
     m_rteList.erase(iterator);
   }
   else {
-    NLSR_LOG_ERROR("Routing entry for: " << entryPtr->getDestination()
+    NLSR_LOG_ERROR("Routing entry for: " << rtpe.getDestination()
                << " not found in NPT entry: " << getNamePrefix());
   }
-  return entryPtr->getUseCount();
+  return rtpe.getUseCount();
 }
 
 void
-NamePrefixTableEntry::addRoutingTableEntry(std::shared_ptr<RoutingTablePoolEntry> entryPtr)
+NamePrefixTableEntry::addRoutingTableEntry(RoutingTablePoolEntry& rtpe)
 {
-  auto iterator = std::find(m_rteList.begin(), m_rteList.end(), entryPtr);
+  auto iterator = std::find(m_rteList.begin(), m_rteList.end(), &rtpe);
 
   // Ensure that this is a new entry
   if (iterator == m_rteList.end()) {
     // Adding a new routing entry to the NPT entry
-    entryPtr->incrementUseCount();
-    m_rteList.push_back(entryPtr);
+    rtpe.incrementUseCount();
+    rtpe.namePrefixTableEntries.insert(this);
+    m_rteList.push_back(&rtpe);
   }
   // Note: we don't need to update in the else case because these are
   // pointers, and they are centrally-located in the NPT and will all
@@ -93,9 +106,9 @@ operator<<(std::ostream& os, const NamePrefixTableEntry& entry)
 {
   os << "Name: " << entry.getNamePrefix() << "\n";
 
-  for (const auto& entryPtr : entry.getRteList()) {
-    os << "  Destination: " << entryPtr->getDestination() << "\n";
-    os << entryPtr->getNexthopList();
+  for (const auto* rtpe : entry.getRteList()) {
+    os << "  Destination: " << rtpe->getDestination() << "\n";
+    os << rtpe->getNexthopList();
   }
   return os;
 }
@@ -26,8 +26,8 @@
 #include "test-access-control.hpp"
 #include "nexthop.hpp"
 
-#include <list>
 #include <utility>
+#include <vector>
 
 namespace nlsr {
 
@@ -50,7 +50,7 @@ public:
     return m_namePrefix;
   }
 
-  const std::list<std::shared_ptr<RoutingTablePoolEntry>>&
+  const std::vector<RoutingTablePoolEntry*>&
   getRteList() const
   {
     return m_rteList;
@@ -62,10 +62,8 @@ public:
   void
   resetRteListNextHop()
   {
-    if (m_rteList.size() > 0) {
-      for (auto it = m_rteList.begin(); it != m_rteList.end(); ++it) {
-        (*it)->getNexthopList().clear();
-      }
+    for (auto* rtpe : m_rteList) {
+      rtpe->getNexthopList().clear();
     }
   }
 
@@ -89,25 +87,30 @@ public:
 
   /*! \brief Collect all next-hops that are advertised by this entry's
    * routing entries.
+   * \return whether the next-hop list of this entry has changed
    */
-  void
+  bool
   generateNhlfromRteList();
 
   /*! \brief Removes a routing entry from this NPT entry.
+   *
+   * The routing entry stops referring to this NPT entry, and its use count is decremented.
    * \return The number of NPTs using the just-removed routing entry.
    */
   uint64_t
-  removeRoutingTableEntry(std::shared_ptr<RoutingTablePoolEntry> rtpePtr);
+  removeRoutingTableEntry(RoutingTablePoolEntry& rtpe);
 
   /*! \brief Adds a routing entry to this NPT entry.
-   * \param rtpePtr The routing entry.
+   * \param rtpe The routing entry.
    *
    * Adds a routing table pool entry to this NPT entry's list
    * (reminder: each RTPE has a next-hop list). They are used to
-   * calculate this entry's overall next-hop list.
+   * calculate this entry's overall next-hop list. The routing entry
+   * refers back to this NPT entry until it is removed from it, so this
+   * NPT entry must not move in the meantime.
    */
   void
-  addRoutingTableEntry(std::shared_ptr<RoutingTablePoolEntry> rtpePtr);
+  addRoutingTableEntry(RoutingTablePoolEntry& rtpe);
 
   void
   writeLog();
@@ -116,7 +119,8 @@ private:
   ndn::Name m_namePrefix;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
-  std::list<std::shared_ptr<RoutingTablePoolEntry>> m_rteList;
+  // one entry per origin router of the prefix; seldom more than a few
+  std::vector<RoutingTablePoolEntry*> m_rteList;
   NexthopList m_nexthopList;
 };
 
@@ -26,6 +26,7 @@
 #include "routing-table.hpp"
 
 #include <algorithm>
+#include <iterator>
 #include <list>
 #include <utility>
 
@@ -35,20 +36,20 @@ INIT_LOGGER(route.NamePrefixTable);
 
 NamePrefixTable::NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib,
                                  RoutingTable& routingTable,
-                                 AfterRoutingChange& afterRoutingChangeSignal,
+                                 AfterRoutingDelta& afterRoutingDeltaSignal,
                                  Lsdb::AfterLsdbModified& afterLsdbModifiedSignal)
   : m_ownRouterName(ownRouterName)
   , m_fib(fib)
   , m_routingTable(routingTable)
 {
-  m_afterRoutingChangeConnection = afterRoutingChangeSignal.connect(
-    [this] (const std::list<RoutingTableEntry>& entries) {
-      updateWithNewRoute(entries);
+  m_afterRoutingDeltaConnection = afterRoutingDeltaSignal.connect(
+    [this] (const RoutingTableDelta& delta) {
+      updateWithRoutingDelta(delta);
     });
 
   m_afterLsdbModified = afterLsdbModifiedSignal.connect(
     [this] (std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
-            const auto& namesToAdd, const auto& namesToRemove) {
+            const auto& namesToAdd, const auto& namesToRemove, const auto&) {
       updateFromLsdb(lsa, updateType, namesToAdd, namesToRemove);
     }
   );
@@ -56,51 +57,43 @@ NamePrefixTable::NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib,
 
 NamePrefixTable::~NamePrefixTable()
 {
-  m_afterRoutingChangeConnection.disconnect();
+  m_afterRoutingDeltaConnection.disconnect();
   m_afterLsdbModified.disconnect();
 }
 
 void
 NamePrefixTable::updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
-                                const std::list<nlsr::PrefixInfo>& namesToAdd,
-                                const std::list<nlsr::PrefixInfo>& namesToRemove)
+                                const std::vector<nlsr::PrefixInfo>& namesToAdd,
+                                const std::vector<nlsr::PrefixInfo>& namesToRemove)
 {
-  if (m_ownRouterName == lsa->getOriginRouter()) {
+  if (m_ownRouterName == lsa->getOriginRouter() ||
+      // only the name prefixes of the router are used here
+      (updateType == LsdbUpdate::UPDATED && lsa->getType() != Lsa::Type::NAME)) {
     return;
   }
   NLSR_LOG_TRACE("Got update from Lsdb for router: " << lsa->getOriginRouter());
+  ConvergenceTracer::NptUpdateScope traceScope(m_tracer);
 
   if (updateType == LsdbUpdate::INSTALLED) {
     addEntry(lsa->getOriginRouter(), lsa->getOriginRouter());
 
     if (lsa->getType() == Lsa::Type::NAME) {
       auto nlsa = std::static_pointer_cast<NameLsa>(lsa);
-      for (const auto &prefix : nlsa->getNpl().getPrefixInfo()) {
-        if (prefix.getName() != m_ownRouterName) {
-          m_nexthopCost[DestNameKey(lsa->getOriginRouter(), prefix.getName())] = prefix.getCost();
-          addEntry(prefix.getName(), lsa->getOriginRouter());
-        }
-      }
+      auto prefixes = nlsa->getNpl().getPrefixInfo();
+      addEntries({prefixes.begin(), prefixes.end()}, lsa->getOriginRouter());
+      updateSummarizedPrefixes(*nlsa);
     }
   }
   else if (updateType == LsdbUpdate::UPDATED) {
-    if (lsa->getType() != Lsa::Type::NAME) {
-      return;
-    }
-
-    for (const auto &prefix : namesToAdd) {
-      if (prefix.getName() != m_ownRouterName) {
-        m_nexthopCost[DestNameKey(lsa->getOriginRouter(), prefix.getName())] = prefix.getCost();
-        addEntry(prefix.getName(), lsa->getOriginRouter());
-      }
-    }
+    addEntries(namesToAdd, lsa->getOriginRouter());
 
     for (const auto &prefix : namesToRemove) {
       if (prefix.getName() != m_ownRouterName) {
-        m_nexthopCost.erase(m_nexthopCost.find(DestNameKey(lsa->getOriginRouter(), prefix.getName())));
+        m_nexthopCost.erase(DestNameKey(lsa->getOriginRouter(), prefix.getName()));
         removeEntry(prefix.getName(), lsa->getOriginRouter());
       }
     }
+    updateSummarizedPrefixes(static_cast<const NameLsa&>(*lsa));
   }
   else {
     removeEntry(lsa->getOriginRouter(), lsa->getOriginRouter());
@@ -108,21 +101,105 @@ NamePrefixTable::updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
       auto nlsa = std::static_pointer_cast<NameLsa>(lsa);
       for (const auto& name : nlsa->getNpl().getNames()) {
         if (name != m_ownRouterName) {
-          m_nexthopCost.erase(m_nexthopCost.find(DestNameKey(lsa->getOriginRouter(), name)));
+          m_nexthopCost.erase(DestNameKey(lsa->getOriginRouter(), name));
           removeEntry(name, lsa->getOriginRouter());
         }
       }
+      removeSummarizedPrefixes(lsa->getOriginRouter());
     }
   }
 }
 
+void
+NamePrefixTable::updateSummarizedPrefixes(const NameLsa& lsa)
+{
+  const ndn::Name& destRouter = lsa.getOriginRouter();
+  auto advertised = lsa.getNpl().getPrefixes();
+  auto isAdvertised = [&advertised] (const ndn::Name& name) {
+    auto it = std::lower_bound(advertised.begin(), advertised.end(), name,
+                               [] (const PrefixInfo& prefix, const ndn::Name& name) {
+                                 return prefix.getName() < name;
+                               });
+    return it != advertised.end() && it->getName() == name;
+  };
+
+  std::map<ndn::Name, double> summarized;
+  for (const auto& summary : lsa.getAreaSummaries()) {
+    if (m_areas.count(summary.area) == 0) {
+      continue;
+    }
+    for (const auto& prefix : summary.prefixes) {
+      if (prefix.getName() == m_ownRouterName || isAdvertised(prefix.getName())) {
+        continue;
+      }
+      auto [it, isNew] = summarized.try_emplace(prefix.getName(), prefix.getCost());
+      if (!isNew) {
+        it->second = std::min(it->second, prefix.getCost());
+      }
+    }
+  }
+
+  auto previous = m_summarizedPrefixes.find(destRouter);
+  if (previous == m_summarizedPrefixes.end()) {
+    if (summarized.empty()) {
+      return;
+    }
+    previous = m_summarizedPrefixes.try_emplace(destRouter).first;
+  }
+
+  std::vector<PrefixInfo> toAdd;
+  for (const auto& [name, cost] : summarized) {
+    auto it = previous->second.find(name);
+    if (it == previous->second.end() || it->second != cost) {
+      toAdd.emplace_back(name, cost);
+    }
+  }
+  for (const auto& [name, cost] : previous->second) {
+    // a prefix now advertised by the router itself was taken over by its prefix list
+    if (summarized.count(name) == 0 && !isAdvertised(name)) {
+      m_nexthopCost.erase(DestNameKey(destRouter, name));
+      removeEntry(name, destRouter);
+    }
+  }
+  if (!toAdd.empty()) {
+    NLSR_LOG_DEBUG(destRouter << " summarizes " << toAdd.size() << " new or changed prefixes");
+    addEntries(toAdd, destRouter);
+  }
+
+  if (summarized.empty()) {
+    m_summarizedPrefixes.erase(previous);
+  }
+  else {
+    previous->second = std::move(summarized);
+  }
+}
+
+void
+NamePrefixTable::removeSummarizedPrefixes(const ndn::Name& destRouter)
+{
+  auto it = m_summarizedPrefixes.find(destRouter);
+  if (it == m_summarizedPrefixes.end()) {
+    return;
+  }
+  for (const auto& [name, cost] : it->second) {
+    m_nexthopCost.erase(DestNameKey(destRouter, name));
+    removeEntry(name, destRouter);
+  }
+  m_summarizedPrefixes.erase(it);
+}
+
 NexthopList
 NamePrefixTable::adjustNexthopCosts(const NexthopList& nhlist, const ndn::Name& nameToCheck, const ndn::Name& destRouterName)
 {
+  // Looked up once for all next hops; a prefix without cost is not added to the map
+  auto cost = m_nexthopCost.find(DestNameKey(destRouterName, nameToCheck));
+  if (cost == m_nexthopCost.end() || cost->second == 0) {
+    return nhlist;
+  }
+
   NexthopList new_nhList;
   for (const auto& nh : nhlist.getNextHops()) {
-      const NextHop newNextHop = NextHop(nh.getConnectingFaceUri(), nh.getRouteCost() +
-                                              m_nexthopCost[DestNameKey(destRouterName, nameToCheck)]);
+      const NextHop newNextHop = NextHop(nh.getInternedFaceUri(), nh.getRouteCost() + cost->second);
       new_nhList.addNextHop(newNextHop);
   }
   return new_nhList;
@@ -131,85 +208,72 @@ NamePrefixTable::adjustNexthopCosts(const NexthopList& nhlist, const ndn::Name&
 void
 NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
 {
-  // Check if the advertised name prefix is in the table already.
-  auto nameItr = std::find_if(m_table.begin(), m_table.end(),
-                              [&] (const auto& entry) { return name == entry->getNamePrefix(); });
-
-  // Attempt to find a routing table pool entry (RTPE) we can use.
-  auto rtpeItr = m_rtpool.find(destRouter);
+  addEntry(name, findOrAddPoolEntry(destRouter));
+}
 
-  // These declarations just to make the compiler happy...
-  RoutingTablePoolEntry rtpe;
-  std::shared_ptr<RoutingTablePoolEntry> rtpePtr(nullptr);
+void
+NamePrefixTable::addEntries(const std::vector<PrefixInfo>& prefixes, const ndn::Name& destRouter)
+{
+  NLSR_LOG_DEBUG("Adding origin: " << destRouter << " to " << prefixes.size() << " name prefixes");
 
-  // There isn't currently a routing table entry in the pool for this name
-  if (rtpeItr == m_rtpool.end()) {
-    // See if there is a routing table entry available we could use
-    RoutingTableEntry* routeEntryPtr = m_routingTable.findRoutingTableEntry(destRouter);
+  // The pool entry is resolved once for all prefixes
+  auto& rtpe = findOrAddPoolEntry(destRouter);
+  m_nameIndex.reserve(m_nameIndex.size() + prefixes.size());
 
-    // We have to create a new routing table entry
-    if (routeEntryPtr == nullptr) {
-      rtpe = RoutingTablePoolEntry(destRouter, 0);
+  for (const auto& prefix : prefixes) {
+    if (prefix.getName() != m_ownRouterName) {
+      m_nexthopCost[DestNameKey(destRouter, prefix.getName())] = prefix.getCost();
+      addEntry(prefix.getName(), rtpe);
     }
-    // There was already a usable one in the routing table
-    else {
-      rtpe = RoutingTablePoolEntry(*routeEntryPtr, 0);
-    }
-
-    // Add the new pool object to the pool.
-    rtpePtr = addRtpeToPool(rtpe);
   }
+}
+
+RoutingTablePoolEntry&
+NamePrefixTable::findOrAddPoolEntry(const ndn::Name& destRouter)
+{
+  // Attempt to find a routing table pool entry (RTPE) we can use.
+  auto rtpeItr = m_rtpool.find(destRouter);
+
   // There was one already, so just fetch that one.
-  else {
-    rtpePtr = (*rtpeItr).second;
+  if (rtpeItr != m_rtpool.end()) {
+    return rtpeItr->second;
   }
 
-  std::shared_ptr<NamePrefixTableEntry> npte;
+  // See if there is a routing table entry available we could use
+  RoutingTableEntry* routeEntryPtr = m_routingTable.findRoutingTableEntry(destRouter);
+
+  // We have to create a new routing table entry
+  if (routeEntryPtr == nullptr) {
+    return addRtpeToPool(RoutingTablePoolEntry(destRouter, 0));
+  }
+  // There was already a usable one in the routing table
+  return addRtpeToPool(RoutingTablePoolEntry(*routeEntryPtr, 0));
+}
+
+void
+NamePrefixTable::addEntry(const ndn::Name& name, RoutingTablePoolEntry& rtpe)
+{
+  const ndn::Name& destRouter = rtpe.getDestination();
+
+  // Check if the advertised name prefix is in the table already.
+  auto nameItr = findEntry(name);
+
   // Either we have to make a new NPT entry or there already was one.
+  // The RTPE refers back to the NPT entry, which stays in place in m_table.
   if (nameItr == m_table.end()) {
-    NLSR_LOG_DEBUG("Adding origin: " << rtpePtr->getDestination()
-                   << " to a new name prefix: " << name);
-    npte = std::make_shared<NamePrefixTableEntry>(name);
-    npte->addRoutingTableEntry(rtpePtr);
-    npte->generateNhlfromRteList();
-    m_table.push_back(npte);
-
-    // If this entry has next hops, we need to inform the FIB
-    if (npte->getNexthopList().size() > 0) {
-      NLSR_LOG_TRACE("Updating FIB with next hops for " << npte->getNamePrefix());
-      m_fib.update(name, adjustNexthopCosts(npte->getNexthopList(), name, destRouter));
-    }
-    // The routing table may recalculate and add a routing table entry
-    // with no next hops to replace an existing routing table entry. In
-    // this case, the name prefix is no longer reachable through a next
-    // hop and should be removed from the FIB. But, the prefix should
-    // remain in the Name Prefix Table as a future routing table
-    // calculation may add next hops.
-    else {
-      NLSR_LOG_TRACE(npte->getNamePrefix() << " has no next hops; removing from FIB");
-      m_fib.remove(name);
-    }
+    NLSR_LOG_DEBUG("Adding origin: " << destRouter << " to a new name prefix: " << name);
+    auto& npte = m_table.emplace_back(name);
+    npte.addRoutingTableEntry(rtpe);
+    npte.generateNhlfromRteList();
+    m_nameIndex.emplace(name, std::prev(m_table.end()));
+    updateFib(npte, destRouter);
   }
   else {
-    npte = *nameItr;
-    NLSR_LOG_TRACE("Adding origin: " << rtpePtr->getDestination() <<
-                   " to existing prefix: " << **nameItr);
-    (*nameItr)->addRoutingTableEntry(rtpePtr);
-    (*nameItr)->generateNhlfromRteList();
-
-    if ((*nameItr)->getNexthopList().size() > 0) {
-      NLSR_LOG_TRACE("Updating FIB with next hops for " << (**nameItr));
-      m_fib.update(name, adjustNexthopCosts((*nameItr)->getNexthopList(), name, destRouter));
-    }
-    else {
-      NLSR_LOG_TRACE(npte->getNamePrefix() << " has no next hops; removing from FIB");
-      m_fib.remove(name);
-    }
+    NLSR_LOG_TRACE("Adding origin: " << destRouter << " to existing prefix: " << *nameItr);
+    nameItr->addRoutingTableEntry(rtpe);
+    nameItr->generateNhlfromRteList();
+    updateFib(*nameItr, destRouter);
   }
-
-  // Add the reference to this NPT to the RTPE.
-  rtpePtr->namePrefixTableEntries.try_emplace(npte->getNamePrefix(),
-                                              std::weak_ptr<NamePrefixTableEntry>(npte));
 }
 
 void
@@ -227,19 +291,17 @@ NamePrefixTable::removeEntry(const ndn::Name& name, const ndn::Name& destRouter)
                    << " found, so it cannot be removed from prefix: " << name);
     return;
   }
-  std::shared_ptr<RoutingTablePoolEntry> rtpePtr = rtpeItr->second;
+  RoutingTablePoolEntry& rtpe = rtpeItr->second;
 
   // Ensure that the entry exists
-  auto nameItr = std::find_if(m_table.begin(), m_table.end(),
-                              [&] (const auto& entry) { return entry->getNamePrefix() == name; });
+  auto nameItr = findEntry(name);
   if (nameItr != m_table.end()) {
-    NLSR_LOG_TRACE("Removing origin: " << rtpePtr->getDestination()
-                   << " from prefix: " << **nameItr);
+    NLSR_LOG_TRACE("Removing origin: " << destRouter << " from prefix: " << *nameItr);
 
     // Rather than iterating through the whole list periodically, just
     // delete them here if they have no references.
-    if ((*nameItr)->removeRoutingTableEntry(rtpePtr) == 0) {
-      deleteRtpeFromPool(rtpePtr);
+    if (nameItr->removeRoutingTableEntry(rtpe) == 0) {
+      m_rtpool.erase(rtpeItr);
     }
 
     // If the prefix is a router prefix and it does not have any other
@@ -257,21 +319,22 @@ NamePrefixTable::removeEntry(const ndn::Name& name, const ndn::Name& destRouter)
     //   Prefix Table. Once a new Name LSA advertises this prefix, a
     //   new entry for the prefix will be created.
     //
-    if ((*nameItr)->getRteListSize() == 0) {
-      NLSR_LOG_TRACE(**nameItr << " has no routing table entries;"
+    if (nameItr->getRteListSize() == 0) {
+      NLSR_LOG_TRACE(*nameItr << " has no routing table entries;"
                      << " removing from table and FIB");
+      m_nameIndex.erase(name);
       m_table.erase(nameItr);
       m_fib.remove(name);
     }
     else {
-      NLSR_LOG_TRACE(**nameItr << " has other routing table entries;"
+      NLSR_LOG_TRACE(*nameItr << " has other routing table entries;"
                      << " updating FIB with next hops");
-      (*nameItr)->generateNhlfromRteList();
-      m_fib.update(name, adjustNexthopCosts((*nameItr)->getNexthopList(), name, destRouter));
+      nameItr->generateNhlfromRteList();
+      m_fib.update(name, adjustNexthopCosts(nameItr->getNexthopList(), name, destRouter));
     }
   }
   else {
-    NLSR_LOG_DEBUG("Attempted to remove origin: " << rtpePtr->getDestination()
+    NLSR_LOG_DEBUG("Attempted to remove origin: " << destRouter
                    << " from non-existent prefix: " << name);
   }
 }
@@ -280,48 +343,114 @@ void
 NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
 {
   NLSR_LOG_DEBUG("Updating table with newly calculated routes");
+  ConvergenceTracer::NptUpdateScope traceScope(m_tracer);
+
+  std::unordered_map<ndn::Name, const RoutingTableEntry*> entriesByDestination;
+  entriesByDestination.reserve(entries.size());
+  for (const auto& entry : entries) {
+    entriesByDestination.emplace(entry.getDestination(), &entry);
+  }
 
   // Iterate over each pool entry we have
-  for (auto&& poolEntryPair : m_rtpool) {
-    auto&& poolEntry = poolEntryPair.second;
-    auto sourceEntry = std::find_if(entries.begin(), entries.end(),
-                                    [&poolEntry] (const RoutingTableEntry& entry) {
-                                      return poolEntry->getDestination() == entry.getDestination();
-                                    });
+  for (auto& [destination, poolEntry] : m_rtpool) {
+    auto sourceEntry = entriesByDestination.find(destination);
     // If this pool entry has a corresponding entry in the routing table now
-    if (sourceEntry != entries.end()
-        && poolEntry->getNexthopList() != sourceEntry->getNexthopList()) {
-      NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " has changed next-hops.");
-      poolEntry->setNexthopList(sourceEntry->getNexthopList());
-      for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
-        auto nameEntryFullPtr = nameEntry.second.lock();
-        addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
-      }
+    if (sourceEntry != entriesByDestination.end()
+        && poolEntry.getNexthopList() != sourceEntry->second->getNexthopList()) {
+      NLSR_LOG_DEBUG("Routing entry: " << destination << " has changed next-hops.");
+      setPoolEntryNexthops(poolEntry, sourceEntry->second->getNexthopList());
     }
-    else if (sourceEntry == entries.end()) {
-      NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " now has no next-hops.");
-      poolEntry->getNexthopList().clear();
-      for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
-        auto nameEntryFullPtr = nameEntry.second.lock();
-        addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
-      }
+    else if (sourceEntry == entriesByDestination.end()) {
+      NLSR_LOG_DEBUG("Routing entry: " << destination << " now has no next-hops.");
+      setPoolEntryNexthops(poolEntry, NexthopList());
     }
     else {
-      NLSR_LOG_TRACE("No change in routing entry:" << poolEntry->getDestination()
+      NLSR_LOG_TRACE("No change in routing entry:" << destination
                  << ", no action necessary.");
     }
   }
 }
 
+void
+NamePrefixTable::updateWithRoutingDelta(const RoutingTableDelta& delta)
+{
+  NLSR_LOG_DEBUG("Updating table with routing delta");
+  ConvergenceTracer::NptUpdateScope traceScope(m_tracer);
+
+  auto update = [this] (const RoutingTableEntry& entry) {
+    auto poolEntry = m_rtpool.find(entry.getDestination());
+    if (poolEntry != m_rtpool.end() &&
+        poolEntry->second.getNexthopList() != entry.getNexthopList()) {
+      NLSR_LOG_DEBUG("Routing entry: " << entry.getDestination() << " has changed next-hops.");
+      setPoolEntryNexthops(poolEntry->second, entry.getNexthopList());
+    }
+  };
+
+  for (const auto& entry : delta.added) {
+    update(entry);
+  }
+  for (const auto& entry : delta.changed) {
+    update(entry);
+  }
+  for (const auto& destination : delta.removed) {
+    auto poolEntry = m_rtpool.find(destination);
+    if (poolEntry != m_rtpool.end()) {
+      NLSR_LOG_DEBUG("Routing entry: " << destination << " now has no next-hops.");
+      setPoolEntryNexthops(poolEntry->second, NexthopList());
+    }
+  }
+}
+
+void
+NamePrefixTable::setPoolEntryNexthops(RoutingTablePoolEntry& poolEntry, const NexthopList& nexthops)
+{
+  poolEntry.setNexthopList(nexthops);
+  // The NPT entries using the pool entry are at hand, so they are not looked up by name.
+  // Only those whose next hops have changed, e.g. not those also reached through a closer
+  // destination on the same faces, are pushed to the FIB.
+  for (auto* npte : poolEntry.namePrefixTableEntries) {
+    if (npte->generateNhlfromRteList()) {
+      updateFib(*npte, poolEntry.getDestination());
+    }
+  }
+}
+
+void
+NamePrefixTable::updateFib(const NamePrefixTableEntry& npte, const ndn::Name& destRouter)
+{
+  const ndn::Name& name = npte.getNamePrefix();
+
+  // If this entry has next hops, we need to inform the FIB
+  if (npte.getNexthopList().size() > 0) {
+    NLSR_LOG_TRACE("Updating FIB with next hops for " << name);
+    m_fib.update(name, adjustNexthopCosts(npte.getNexthopList(), name, destRouter));
+  }
+  // The routing table may recalculate and add a routing table entry
+  // with no next hops to replace an existing routing table entry. In
+  // this case, the name prefix is no longer reachable through a next
+  // hop and should be removed from the FIB. But, the prefix should
+  // remain in the Name Prefix Table as a future routing table
+  // calculation may add next hops.
+  else {
+    NLSR_LOG_TRACE(name << " has no next hops; removing from FIB");
+    m_fib.remove(name);
+  }
+}
+
+NamePrefixTable::NptEntryList::iterator
+NamePrefixTable::findEntry(const ndn::Name& name)
+{
+  auto it = m_nameIndex.find(name);
+  return it == m_nameIndex.end() ? m_table.end() : it->second;
+}
+
 // Inserts the routing table pool entry into the NPT's RTE storage
 // pool.  This cannot fail, so the pool is guaranteed to contain the
 // item after this occurs.
-std::shared_ptr<RoutingTablePoolEntry>
-NamePrefixTable::addRtpeToPool(RoutingTablePoolEntry& rtpe)
+RoutingTablePoolEntry&
+NamePrefixTable::addRtpeToPool(const RoutingTablePoolEntry& rtpe)
 {
-  auto poolIt = m_rtpool.try_emplace(rtpe.getDestination(),
-                                     std::make_shared<RoutingTablePoolEntry>(rtpe)).first;
-  return poolIt->second;
+  return m_rtpool.try_emplace(rtpe.getDestination(), rtpe).first->second;
 }
 
 // Removes the routing table pool entry from the storage pool. The
@@ -331,13 +460,17 @@ NamePrefixTable::addRtpeToPool(RoutingTablePoolEntry& rtpe)
 // given in the case that this function is called with an entry that
 // isn't in the pool.
 void
-NamePrefixTable::deleteRtpeFromPool(std::shared_ptr<RoutingTablePoolEntry> rtpePtr)
+NamePrefixTable::deleteRtpeFromPool(const RoutingTablePoolEntry& rtpe)
 {
-  if (m_rtpool.erase(rtpePtr->getDestination()) != 1) {
+  // rtpe may be the pool entry itself, so its destination is not used past the erasure
+  auto it = m_rtpool.find(rtpe.getDestination());
+  if (it == m_rtpool.end()) {
     NLSR_LOG_DEBUG("Attempted to delete non-existent origin: "
-                   << rtpePtr->getDestination()
+                   << rtpe.getDestination()
                    << " from NPT routing table entry storage pool.");
+    return;
   }
+  m_rtpool.erase(it);
 }
 
 void
@@ -346,13 +479,43 @@ NamePrefixTable::writeLog()
   NLSR_LOG_DEBUG(*this);
 }
 
+void
+NamePrefixTable::reportMemory(MemoryStatus& status) const
+{
+  MemoryUsage npt;
+  for (const auto& entry : m_table) {
+    ++npt.nElements;
+    npt.nBytes += TREE_NODE_OVERHEAD + sizeof(entry) + getNameMemory(entry.getNamePrefix()) +
+                  entry.getRteList().capacity() * sizeof(RoutingTablePoolEntry*) +
+                  entry.getNexthopList().getHeapMemory();
+  }
+  for (const auto& [name, it] : m_nameIndex) {
+    npt.nBytes += HASH_NODE_OVERHEAD + sizeof(name) + sizeof(it) + getNameMemory(name);
+  }
+  for (const auto& [key, cost] : m_nexthopCost) {
+    npt.nBytes += HASH_NODE_OVERHEAD + sizeof(key) + sizeof(cost) +
+                  getNameMemory(std::get<0>(key)) + getNameMemory(std::get<1>(key));
+  }
+  status.addComponent("name-prefix-table", npt);
+
+  MemoryUsage pool;
+  for (const auto& [name, rtpe] : m_rtpool) {
+    ++pool.nElements;
+    pool.nBytes += HASH_NODE_OVERHEAD + sizeof(name) + sizeof(rtpe) + getNameMemory(name) +
+                   getNameMemory(rtpe.getDestination()) + rtpe.getNexthopList().getHeapMemory() +
+                   rtpe.namePrefixTableEntries.size() *
+                     (HASH_NODE_OVERHEAD + sizeof(NamePrefixTableEntry*));
+  }
+  status.addComponent("routing-table-pool", pool);
+}
+
 std::ostream&
 operator<<(std::ostream& os, const NamePrefixTable& table)
 {
   os << "----------------NPT----------------------\n";
 
-  for (const auto& entryPtr : table) {
-    os << *entryPtr << std::endl;
+  for (const auto& entry : table) {
+    os << entry << std::endl;
   }
 
   return os;
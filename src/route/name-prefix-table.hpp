@@ -23,13 +23,19 @@
 #define NLSR_NAME_PREFIX_TABLE_HPP
 
 #include "name-prefix-table-entry.hpp"
+#include "memory-usage.hpp"
 #include "routing-table-pool-entry.hpp"
 #include "signals.hpp"
 #include "test-access-control.hpp"
 #include "route/fib.hpp"
 #include "lsdb.hpp"
 
+#include <boost/container_hash/hash.hpp>
+
 #include <list>
+#include <map>
+#include <set>
+#include <tuple>
 #include <unordered_map>
 
 namespace nlsr {
@@ -37,14 +43,26 @@ namespace nlsr {
 class NamePrefixTable
 {
 public:
-  using RoutingTableEntryPool =
-    std::unordered_map<ndn::Name, std::shared_ptr<RoutingTablePoolEntry>>;
-  using NptEntryList = std::list<std::shared_ptr<NamePrefixTableEntry>>;
+  // Both containers keep their elements in place, which refer to each other by plain
+  // pointers; each element takes a single allocation, without reference counting.
+  using RoutingTableEntryPool = std::unordered_map<ndn::Name, RoutingTablePoolEntry>;
+  using NptEntryList = std::list<NamePrefixTableEntry>;
   using const_iterator = NptEntryList::const_iterator;
   using DestNameKey = std::tuple<ndn::Name, ndn::Name>;
 
+  struct DestNameKeyHash
+  {
+    size_t
+    operator()(const DestNameKey& key) const
+    {
+      size_t seed = std::hash<ndn::Name>()(std::get<0>(key));
+      boost::hash_combine(seed, std::hash<ndn::Name>()(std::get<1>(key)));
+      return seed;
+    }
+  };
+
   NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib, RoutingTable& routingTable,
-                  AfterRoutingChange& afterRoutingChangeSignal,
+                  AfterRoutingDelta& afterRoutingDeltaSignal,
                   Lsdb::AfterLsdbModified& afterLsdbModifiedSignal);
 
   ~NamePrefixTable();
@@ -60,8 +78,8 @@ public:
    */
   void
   updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
-                 const std::list<nlsr::PrefixInfo>& namesToAdd,
-                 const std::list<nlsr::PrefixInfo>& namesToRemove);
+                 const std::vector<nlsr::PrefixInfo>& namesToAdd,
+                 const std::vector<nlsr::PrefixInfo>& namesToRemove);
 
   /*! \brief Adds a destination to the specified name prefix.
     \param name The name prefix
@@ -79,6 +97,18 @@ public:
   void
   addEntry(const ndn::Name& name, const ndn::Name& destRouter);
 
+  /*! \brief Adds a destination to the name prefixes it advertises.
+    \param prefixes The name prefixes, with their advertised costs
+    \param destRouter The destination router prefix
+
+    This is addEntry for all name prefixes of a Name LSA at once: the
+    routing table pool entry of destRouter is found or created only
+    once. The FIB updates go out one after the other, and are pipelined
+    by the FIB. The name prefix of this router is skipped.
+   */
+  void
+  addEntries(const std::vector<PrefixInfo>& prefixes, const ndn::Name& destRouter);
+
   /*! \brief Removes a destination from a name prefix table entry.
     \param name The name prefix
     \param destRouter The destination.
@@ -104,32 +134,108 @@ public:
   void
   updateWithNewRoute(const std::list<RoutingTableEntry>& entries);
 
+  /*! \brief Updates the routing information of the destinations that changed.
+
+    Pool entries of added and changed destinations take the new next hops; pool entries of
+    removed destinations lose their next hops. Other pool entries are not visited.
+   */
+  void
+  updateWithRoutingDelta(const RoutingTableDelta& delta);
+
   /*! \brief Adds a pool entry to the pool.
     \param rtpe The entry.
 
-    \return A shared_ptr to the entry, now in the pool.
+    \return The entry in the pool, which stays in place until it is
+    deleted from the pool.
 
-    Adds a RoutingTablePoolEntry to the NPT's local pool. Shared
-    pointers are used because it eliminates complicated hacks to deal
-    with lifetime issues, and to simplify memory management.
+    Adds a copy of a RoutingTablePoolEntry to the NPT's local pool,
+    unless the pool already has an entry for its destination.
    */
-  std::shared_ptr<RoutingTablePoolEntry>
-  addRtpeToPool(RoutingTablePoolEntry& rtpe);
+  RoutingTablePoolEntry&
+  addRtpeToPool(const RoutingTablePoolEntry& rtpe);
 
   /*! \brief Removes a pool entry from the pool.
-    \param rtpePtr The shared_ptr to the entry.
+    \param rtpe The entry, which is looked up by destination.
 
-    Removes a pool entry from the pool. Comparing these shared_ptrs
-    should not be a problem, because the same pointer is moved around,
-    all sourced from this central location. A more robust solution is
-    certainly possible, though.
+    The entry must no longer be used by any NPT entry.
   */
   void
-  deleteRtpeFromPool(std::shared_ptr<RoutingTablePoolEntry> rtpePtr);
+  deleteRtpeFromPool(const RoutingTablePoolEntry& rtpe);
+
+  size_t
+  size() const
+  {
+    return m_table.size();
+  }
 
   void
   writeLog();
 
+  /*! \brief Adds the memory of the NPT and of the routing table entries it shares to
+   *         \p status.
+   */
+  void
+  reportMemory(MemoryStatus& status) const;
+
+  /*! \brief Record the NPT updates in \p tracer , and hold the FIB_INSTALL of their traces
+   *         until the RIB commands they issue are answered; nullptr to stop tracing.
+   */
+  void
+  setConvergenceTracer(ConvergenceTracer* tracer)
+  {
+    m_tracer = tracer;
+  }
+
+  /*! \brief Set the areas of this router; the name prefixes that area border routers
+   *         summarize into them are added to the table as prefixes of the border routers.
+   */
+  void
+  setAreas(std::set<ndn::Name> areas)
+  {
+    m_areas = std::move(areas);
+  }
+
+private:
+  /*! \brief Brings the prefixes that a Name LSA summarizes into our areas up to date.
+   *
+   * A prefix summarized into several of our areas takes the lowest cost. The prefixes that
+   * the origin router advertises itself are left to its prefix list.
+   */
+  void
+  updateSummarizedPrefixes(const NameLsa& lsa);
+
+  /*! \brief Removes the prefixes that \p destRouter summarized into our areas.
+   */
+  void
+  removeSummarizedPrefixes(const ndn::Name& destRouter);
+
+  /*! \brief Replaces the next hops of a pool entry and refreshes the NPT entries using it.
+   */
+  void
+  setPoolEntryNexthops(RoutingTablePoolEntry& poolEntry, const NexthopList& nexthops);
+
+  /*! \brief Returns the pool entry of a destination, adding it to the pool if needed.
+   */
+  RoutingTablePoolEntry&
+  findOrAddPoolEntry(const ndn::Name& destRouter);
+
+  /*! \brief Adds a pool entry to a name prefix table entry, creating the latter if needed.
+   */
+  void
+  addEntry(const ndn::Name& name, RoutingTablePoolEntry& rtpe);
+
+  /*! \brief Returns the entry of a name prefix in m_table, or the end of m_table.
+   */
+  NptEntryList::iterator
+  findEntry(const ndn::Name& name);
+
+  /*! \brief Installs the next hops of an NPT entry in the FIB, or removes it if there are none.
+   */
+  void
+  updateFib(const NamePrefixTableEntry& npte, const ndn::Name& destRouter);
+
+public:
+
   const_iterator
   begin() const;
 
@@ -140,14 +246,21 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   RoutingTableEntryPool m_rtpool;
 
   NptEntryList m_table;
+  // Entries of m_table by name prefix; the list keeps them in insertion order for output
+  std::unordered_map<ndn::Name, NptEntryList::iterator> m_nameIndex;
+  // Costs advertised with the name prefixes, by origin router and name prefix
+  std::unordered_map<DestNameKey, double, DestNameKeyHash> m_nexthopCost;
+  // Prefixes, with their costs, that area border routers summarized into our areas
+  std::unordered_map<ndn::Name, std::map<ndn::Name, double>> m_summarizedPrefixes;
+  std::set<ndn::Name> m_areas;
 
 private:
   const ndn::Name& m_ownRouterName;
   Fib& m_fib;
   RoutingTable& m_routingTable;
-  ndn::signal::Connection m_afterRoutingChangeConnection;
+  ConvergenceTracer* m_tracer = nullptr;
+  ndn::signal::Connection m_afterRoutingDeltaConnection;
   ndn::signal::Connection m_afterLsdbModified;
-  std::map<std::tuple<ndn::Name, ndn::Name>, double> m_nexthopCost;
 };
 
 inline NamePrefixTable::const_iterator
@@ -27,7 +27,9 @@
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/util/ostream-joiner.hpp>
 
-#include <set>
+#include <boost/container/small_vector.hpp>
+
+#include <algorithm>
 
 namespace nlsr {
 
@@ -36,14 +38,22 @@ struct NextHopUriSortedComparator
   bool
   operator()(const NextHop& lhs, const NextHop& rhs) const
   {
-    return lhs.getConnectingFaceUri() < rhs.getConnectingFaceUri();
+    return lhs.getInternedFaceUri() < rhs.getInternedFaceUri();
   }
 };
 
+/*! \brief A list of next hops, sorted by \p T, with at most one next hop per FaceUri.
+ *
+ * The next hops are kept in a sorted vector with inline room for a few of them, as most
+ * lists have one to four next hops. Such lists are copied and compared without allocation.
+ */
 template<typename T = std::less<NextHop>>
 class NexthopListT
 {
 public:
+  static constexpr size_t INLINE_CAPACITY = 4;
+  using Container = boost::container::small_vector<NextHop, INLINE_CAPACITY>;
+
   NexthopListT() = default;
 
   /*! \brief Adds a next hop to the list.
@@ -58,14 +68,14 @@ public:
   {
     auto it = std::find_if(m_nexthopList.begin(), m_nexthopList.end(),
       [&nh] (const auto& item) {
-        return item.getConnectingFaceUri() == nh.getConnectingFaceUri();
+        return item.getInternedFaceUri() == nh.getInternedFaceUri();
       });
     if (it == m_nexthopList.end()) {
-      m_nexthopList.insert(nh);
+      insertSorted(nh);
     }
     else if (it->getRouteCost() > nh.getRouteCost()) {
       m_nexthopList.erase(it);
-      m_nexthopList.insert(nh);
+      insertSorted(nh);
     }
   }
 
@@ -95,16 +105,26 @@ public:
     m_nexthopList.clear();
   }
 
-  const std::set<NextHop, T>&
+  /*! \brief Returns the bytes allocated for next hops that did not fit in the list itself.
+   */
+  size_t
+  getHeapMemory() const
+  {
+    return m_nexthopList.capacity() > INLINE_CAPACITY ?
+           m_nexthopList.capacity() * sizeof(NextHop) : 0;
+  }
+
+  const Container&
   getNextHops() const
   {
     return m_nexthopList;
   }
 
   typedef T value_type;
-  typedef typename std::set<NextHop, T>::iterator iterator;
-  typedef typename std::set<NextHop, T>::const_iterator const_iterator;
-  typedef typename std::set<NextHop, T>::reverse_iterator reverse_iterator;
+  // next hops cannot be modified in place, which would break the order
+  typedef typename Container::const_iterator iterator;
+  typedef typename Container::const_iterator const_iterator;
+  typedef typename Container::const_reverse_iterator reverse_iterator;
 
   iterator
   begin() const
@@ -143,7 +163,16 @@ public:
   }
 
 private:
-  std::set<NextHop, T> m_nexthopList;
+  void
+  insertSorted(const NextHop& nh)
+  {
+    // unique FaceUris make the position unique, as in a set
+    m_nexthopList.insert(std::upper_bound(m_nexthopList.begin(), m_nexthopList.end(), nh, T()),
+                         nh);
+  }
+
+private:
+  Container m_nexthopList;
 };
 
 typedef NexthopListT<> NexthopList;
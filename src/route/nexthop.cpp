@@ -32,7 +32,8 @@ NextHop::wireEncode(ndn::EncodingImpl<TAG>& block) const
   size_t totalLength = 0;
 
   totalLength += ndn::encoding::prependDoubleBlock(block, nlsr::tlv::CostDouble, m_routeCost);
-  totalLength += ndn::encoding::prependStringBlock(block, nlsr::tlv::Uri, m_connectingFaceUri.toString());
+  totalLength += ndn::encoding::prependStringBlock(block, nlsr::tlv::Uri,
+                                                   getConnectingFaceUri().toString());
 
   totalLength += block.prependVarNumber(totalLength);
   totalLength += block.prependVarNumber(nlsr::tlv::NextHop);
@@ -63,7 +64,7 @@ NextHop::wireEncode() const
 void
 NextHop::wireDecode(const ndn::Block& wire)
 {
-  m_connectingFaceUri = {};
+  m_connectingFaceUri = InternedFaceUri();
   m_routeCost = 0;
 
   m_wire = wire;
@@ -78,7 +79,7 @@ NextHop::wireDecode(const ndn::Block& wire)
 
   if (val != m_wire.elements_end() && val->type() == nlsr::tlv::Uri) {
     try {
-      m_connectingFaceUri = ndn::FaceUri(ndn::encoding::readString(*val));
+      m_connectingFaceUri = InternedFaceUri(ndn::FaceUri(ndn::encoding::readString(*val)));
     }
     catch (const ndn::FaceUri::Error& e) {
       NDN_THROW_NESTED(Error("Invalid Uri"));
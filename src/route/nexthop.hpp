@@ -21,12 +21,12 @@
 #ifndef NLSR_ROUTE_NEXTHOP_HPP
 #define NLSR_ROUTE_NEXTHOP_HPP
 
+#include "interned-face-uri.hpp"
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/encoding/tlv.hpp>
-#include <ndn-cxx/net/face-uri.hpp>
 
 #include <boost/operators.hpp>
 
@@ -41,6 +41,9 @@ namespace nlsr {
  *                Uri
  *                Cost
  *
+ * The FaceUri is interned, so that next hops are small, and are copied and compared without
+ * copying or comparing strings. It is only resolved for datasets and logs.
+ *
  * \sa https://redmine.named-data.net/projects/nlsr/wiki/Routing_Table_Dataset
  */
 class NextHop : private boost::totally_ordered<NextHop>
@@ -56,6 +59,12 @@ public:
   {
   }
 
+  NextHop(const InternedFaceUri& cfu, double rc)
+    : m_connectingFaceUri(cfu)
+    , m_routeCost(rc)
+  {
+  }
+
   explicit
   NextHop(const ndn::Block& block)
   {
@@ -64,6 +73,12 @@ public:
 
   const ndn::FaceUri&
   getConnectingFaceUri() const
+  {
+    return m_connectingFaceUri.get();
+  }
+
+  const InternedFaceUri&
+  getInternedFaceUri() const
   {
     return m_connectingFaceUri;
   }
@@ -71,7 +86,7 @@ public:
   void
   setConnectingFaceUri(const ndn::FaceUri& cfu)
   {
-    m_connectingFaceUri = cfu;
+    m_connectingFaceUri = InternedFaceUri(cfu);
   }
 
   uint64_t
@@ -131,18 +146,19 @@ private: // non-member operators
   operator==(const NextHop& lhs, const NextHop& rhs)
   {
     return lhs.getRouteCostAsAdjustedInteger() == rhs.getRouteCostAsAdjustedInteger() &&
-           lhs.getConnectingFaceUri() == rhs.getConnectingFaceUri();
+           lhs.m_connectingFaceUri == rhs.m_connectingFaceUri;
   }
 
   friend bool
   operator<(const NextHop& lhs, const NextHop& rhs)
   {
-    return std::forward_as_tuple(lhs.getRouteCostAsAdjustedInteger(), lhs.getConnectingFaceUri()) <
-           std::forward_as_tuple(rhs.getRouteCostAsAdjustedInteger(), rhs.getConnectingFaceUri());
+    auto lhsCost = lhs.getRouteCostAsAdjustedInteger();
+    auto rhsCost = rhs.getRouteCostAsAdjustedInteger();
+    return lhsCost != rhsCost ? lhsCost < rhsCost : lhs.m_connectingFaceUri < rhs.m_connectingFaceUri;
   }
 
 private:
-  ndn::FaceUri m_connectingFaceUri;
+  InternedFaceUri m_connectingFaceUri;
   double m_routeCost = 0.0;
   bool m_isHyperbolic = false;
 
@@ -27,7 +27,10 @@
 #include "logger.hpp"
 #include "nlsr.hpp"
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
+#include <optional>
 
 namespace nlsr {
 
@@ -36,46 +39,102 @@ INIT_LOGGER(route.RoutingCalculatorHyperbolic);
 class HyperbolicRoutingCalculator
 {
 public:
-  HyperbolicRoutingCalculator(size_t nRouters, bool isDryRun, ndn::Name thisRouterName)
+  HyperbolicRoutingCalculator(size_t nRouters, ndn::Name thisRouterName)
     : m_nRouters(nRouters)
-    , m_isDryRun(isDryRun)
     , m_thisRouterName(thisRouterName)
   {
   }
 
-  void
-  calculatePath(NameMap& map, RoutingTable& rt, Lsdb& lsdb, AdjacencyList& adjacencies);
+  /**
+   * @param cache If not null, distances of the previous calculations; only the missing ones
+   *              are computed, and then stored in it.
+   */
+  RouteList
+  calculatePath(const NameMap& map, const Lsdb& lsdb, const AdjacencyList& adjacencies,
+                HyperbolicDistanceCache* cache);
 
 private:
+  /**
+   * @brief Coordinates of every router, in structure-of-arrays form indexed by mapping number.
+   *
+   * The angles of each router are converted once to a point on the unit sphere, so that the
+   * angular distance between two routers reduces to an inner product. Coordinate k of router i
+   * is stored at `point[k * nRouters + i]`.
+   */
+  struct Coordinates
+  {
+    size_t nCoordinates = 0;
+    std::vector<double> point;
+    /// Number of angles of each router, 0 if its coordinates are unknown or invalid.
+    std::vector<size_t> nAngles;
+    std::vector<double> coshRadius;
+    std::vector<double> sinhRadius;
+  };
+
+  Coordinates
+  gatherCoordinates(const NameMap& map, const Lsdb& lsdb) const;
+
+  /**
+   * @brief Tell whether the distance between @p src and @p dest can be computed.
+   * @param innerProduct Inner product of their points on the unit sphere.
+   */
+  bool
+  isKnownDistance(const Coordinates& coordinates, int32_t src, int32_t dest,
+                  double innerProduct) const;
+
+  /**
+   * @brief Compute the hyperbolic distance from router @p src to router @p dest .
+   */
   double
-  getHyperbolicDistance(Lsdb& lsdb, ndn::Name src, ndn::Name dest);
+  calculateDistance(const Coordinates& coordinates, int32_t src, int32_t dest) const;
 
+  /**
+   * @brief Compute hyperbolic distances from router @p src to every router.
+   * @param[out] distances Distance to each router, or UNKNOWN_DISTANCE.
+   */
   void
-  addNextHop(const ndn::Name& destinationRouter, const ndn::FaceUri& faceUri, double cost, RoutingTable& rt);
-
-  double
-  calculateHyperbolicDistance(double rI, double rJ, double deltaTheta);
+  calculateDistances(const Coordinates& coordinates, int32_t src,
+                     std::vector<double>& distances) const;
 
-  double
-  calculateAngularDistance(std::vector<double> angleVectorI,
-                           std::vector<double> angleVectorJ);
+  void
+  addNextHop(const ndn::Name& destinationRouter, const ndn::FaceUri& faceUri, double cost);
 
 private:
   const size_t m_nRouters;
-  const bool m_isDryRun;
   const ndn::Name m_thisRouterName;
+  RouteList m_routes;
 };
 
 constexpr double UNKNOWN_DISTANCE = -1.0;
 constexpr double UNKNOWN_RADIUS   = -1.0;
 
-void
-HyperbolicRoutingCalculator::calculatePath(NameMap& map, RoutingTable& rt,
-                                           Lsdb& lsdb, AdjacencyList& adjacencies)
+RouteList
+HyperbolicRoutingCalculator::calculatePath(const NameMap& map, const Lsdb& lsdb,
+                                           const AdjacencyList& adjacencies,
+                                           HyperbolicDistanceCache* cache)
 {
   NLSR_LOG_TRACE("Calculating hyperbolic paths");
 
   auto thisRouter = map.getMappingNoByRouterName(m_thisRouterName);
+  std::vector<double> distances(m_nRouters);
+
+  // The coordinates are only needed if some distance is not cached.
+  std::optional<Coordinates> coordinates;
+  auto getCoordinates = [&] () -> const Coordinates& {
+    if (!coordinates) {
+      coordinates = gatherCoordinates(map, lsdb);
+    }
+    return *coordinates;
+  };
+
+  // Index of each router in the cache.
+  std::vector<int32_t> cacheIndex;
+  if (cache != nullptr) {
+    cacheIndex.reserve(m_nRouters);
+    for (size_t i = 0; i < m_nRouters; ++i) {
+      cacheIndex.push_back(cache->getIndex(*map.getRouterNameByMappingNo(i)));
+    }
+  }
 
   // Iterate over directly connected neighbors
   std::list<Adjacent> neighbors = adjacencies.getAdjList();
@@ -95,7 +154,7 @@ HyperbolicRoutingCalculator::calculatePath(NameMap& map, RoutingTable& rt,
     }
 
     // Install nexthops for this router to the neighbor; direct neighbors have a 0 cost link
-    addNextHop(srcRouterName, adj->getFaceUri(), 0, rt);
+    addNextHop(srcRouterName, adj->getFaceUri(), 0);
 
     auto src = map.getMappingNoByRouterName(srcRouterName);
     if (!src) {
@@ -104,184 +163,246 @@ HyperbolicRoutingCalculator::calculatePath(NameMap& map, RoutingTable& rt,
     }
 
     // Get hyperbolic distance from direct neighbor to every other router
+    if (cache == nullptr) {
+      calculateDistances(getCoordinates(), *src, distances);
+    }
+    else {
+      auto& row = cache->getRow(cacheIndex[*src]);
+      size_t nMissing = 0;
+      for (size_t dest = 0; dest < m_nRouters; ++dest) {
+        nMissing += static_cast<size_t>(std::isnan(row[cacheIndex[dest]]));
+      }
+
+      if (nMissing == m_nRouters) {
+        calculateDistances(getCoordinates(), *src, distances);
+      }
+      for (size_t dest = 0; dest < m_nRouters; ++dest) {
+        double& cached = row[cacheIndex[dest]];
+        if (!std::isnan(cached)) {
+          distances[dest] = cached;
+          continue;
+        }
+        if (nMissing != m_nRouters) {
+          distances[dest] = calculateDistance(getCoordinates(), *src, static_cast<int32_t>(dest));
+        }
+        cached = distances[dest];
+      }
+      NLSR_LOG_TRACE("Computed " << nMissing << " of " << m_nRouters << " distances from " <<
+                     srcRouterName);
+    }
     for (int dest = 0; dest < static_cast<int>(m_nRouters); ++dest) {
       // Don't calculate nexthops to this router or from a router to itself
       if (thisRouter && dest != *thisRouter && dest != *src) {
 
         auto destRouterName = map.getRouterNameByMappingNo(dest);
         if (destRouterName) {
-          double distance = getHyperbolicDistance(lsdb, srcRouterName, *destRouterName);
-
           // Could not compute distance
-          if (distance == UNKNOWN_DISTANCE) {
+          if (distances[dest] == UNKNOWN_DISTANCE) {
             NLSR_LOG_WARN("Could not calculate hyperbolic distance from " << srcRouterName
                            << " to " << *destRouterName);
             continue;
           }
-          addNextHop(*destRouterName, adj->getFaceUri(), distance, rt);
+          NLSR_LOG_TRACE("Distance from " << srcRouterName << " to " << *destRouterName <<
+                         " is " << distances[dest]);
+          addNextHop(*destRouterName, adj->getFaceUri(), distances[dest]);
         }
       }
     }
   }
+  return std::move(m_routes);
 }
 
-double
-HyperbolicRoutingCalculator::getHyperbolicDistance(Lsdb& lsdb, ndn::Name src, ndn::Name dest)
+HyperbolicRoutingCalculator::Coordinates
+HyperbolicRoutingCalculator::gatherCoordinates(const NameMap& map, const Lsdb& lsdb) const
 {
-  NLSR_LOG_TRACE("Calculating hyperbolic distance from " << src << " to " << dest);
-
-  double distance = UNKNOWN_DISTANCE;
-
-  auto srcLsa  = lsdb.findLsa<CoordinateLsa>(src);
-  auto destLsa = lsdb.findLsa<CoordinateLsa>(dest);
-
-  // Coordinate LSAs do not exist for these routers
-  if (srcLsa == nullptr || destLsa == nullptr) {
-    return UNKNOWN_DISTANCE;
+  // It is not possible for angle vector size to be zero as ensured by conf-file-processor
+  std::vector<std::shared_ptr<CoordinateLsa>> lsas(m_nRouters);
+  size_t maxAngles = 0;
+  for (size_t i = 0; i < m_nRouters; ++i) {
+    lsas[i] = lsdb.findLsa<CoordinateLsa>(*map.getRouterNameByMappingNo(i));
+    if (lsas[i] != nullptr) {
+      maxAngles = std::max(maxAngles, lsas[i]->getTheta().size());
+    }
   }
 
-  std::vector<double> srcTheta = srcLsa->getTheta();
-  std::vector<double> destTheta = destLsa->getTheta();
-
-  double srcRadius = srcLsa->getRadius();
-  double destRadius = destLsa->getRadius();
+  Coordinates coordinates;
+  coordinates.nCoordinates = maxAngles + 1;
+  coordinates.point.assign(coordinates.nCoordinates * m_nRouters, 0.0);
+  coordinates.nAngles.assign(m_nRouters, 0);
+  coordinates.coshRadius.assign(m_nRouters, 0.0);
+  coordinates.sinhRadius.assign(m_nRouters, 0.0);
 
-  double diffTheta = calculateAngularDistance(srcTheta, destTheta);
-
-  if (srcRadius == UNKNOWN_RADIUS || destRadius == UNKNOWN_RADIUS ||
-      diffTheta == UNKNOWN_DISTANCE) {
-    return UNKNOWN_DISTANCE;
-  }
+  for (size_t i = 0; i < m_nRouters; ++i) {
+    // Coordinate LSA does not exist for this router
+    if (lsas[i] == nullptr) {
+      continue;
+    }
 
-  // double r_i, double r_j, double delta_theta, double zeta = 1 (default)
-  distance = calculateHyperbolicDistance(srcRadius, destRadius, diffTheta);
+    const auto& angles = lsas[i]->getTheta();
+    double radius = lsas[i]->getRadius();
+    if (radius == UNKNOWN_RADIUS || angles.empty()) {
+      continue;
+    }
+    if (radius <= 0.0) {
+      NLSR_LOG_ERROR("Radius of " << lsas[i]->getOriginRouter() << " is <= 0");
+      continue;
+    }
+    if (angles.back() > 2. * M_PI || angles.back() < 0.0) {
+      NLSR_LOG_ERROR("Angle of " << lsas[i]->getOriginRouter() << " not within [0, 2PI]");
+      continue;
+    }
 
-  NLSR_LOG_TRACE("Distance from " << src << " to " << dest << " is " << distance);
+    // https://en.wikipedia.org/wiki/N-sphere#Spherical_coordinates
+    // Euclidean coordinates given the angles and assuming R_sphere = 1
+    double sinProduct = 1.0;
+    for (size_t k = 0; k < angles.size(); ++k) {
+      coordinates.point[k * m_nRouters + i] = sinProduct * std::cos(angles[k]);
+      sinProduct *= std::sin(angles[k]);
+    }
+    coordinates.point[angles.size() * m_nRouters + i] = sinProduct;
 
-  return distance;
+    coordinates.nAngles[i] = angles.size();
+    coordinates.coshRadius[i] = std::cosh(radius);
+    coordinates.sinhRadius[i] = std::sinh(radius);
+  }
+  return coordinates;
 }
 
-double
-HyperbolicRoutingCalculator::calculateAngularDistance(std::vector<double> angleVectorI,
-                                                      std::vector<double> angleVectorJ)
+void
+HyperbolicRoutingCalculator::calculateDistances(const Coordinates& coordinates, int32_t src,
+                                                std::vector<double>& distances) const
 {
-  // It is not possible for angle vector size to be zero as ensured by conf-file-processor
-
-  // https://en.wikipedia.org/wiki/N-sphere#Spherical_coordinates
+  const size_t n = m_nRouters;
+  const double* point = coordinates.point.data();
+  const double* coshRadius = coordinates.coshRadius.data();
+  const double* sinhRadius = coordinates.sinhRadius.data();
+  double* out = distances.data();
+
+  // The loops below run over all destinations without branches, so that they can be
+  // vectorized. The inner product of the unit vectors is the cosine of the angular distance.
+  std::vector<double> innerProduct(n, 0.0);
+  double* dot = innerProduct.data();
+  for (size_t k = 0; k < coordinates.nCoordinates; ++k) {
+    const double* column = point + k * n;
+    double srcCoordinate = column[src];
+    for (size_t dest = 0; dest < n; ++dest) {
+      dot[dest] += srcCoordinate * column[dest];
+    }
+  }
 
-  // Check if two vector lengths are the same
-  if (angleVectorI.size() != angleVectorJ.size()) {
-    NLSR_LOG_ERROR("Angle vector sizes do not match");
-    return UNKNOWN_DISTANCE;
+  // Usually, we set zeta = 1 in all experiments
+  double coshSrc = coshRadius[src];
+  double sinhSrc = sinhRadius[src];
+  for (size_t dest = 0; dest < n; ++dest) {
+    out[dest] = std::acosh(coshSrc * coshRadius[dest] - sinhSrc * sinhRadius[dest] * dot[dest]);
   }
 
-  // Check if all angles are within the [0, PI] and [0, 2PI] ranges
-  if (angleVectorI.size() > 1) {
-    for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
-      if ((angleVectorI[k] > M_PI && angleVectorI[k] < 0.0) ||
-          (angleVectorJ[k] > M_PI && angleVectorJ[k] < 0.0)) {
-        NLSR_LOG_ERROR("Angle outside [0, PI]");
-        return UNKNOWN_DISTANCE;
-      }
+  for (size_t dest = 0; dest < n; ++dest) {
+    if (!isKnownDistance(coordinates, src, static_cast<int32_t>(dest), dot[dest])) {
+      out[dest] = UNKNOWN_DISTANCE;
     }
   }
+}
 
-  if (angleVectorI[angleVectorI.size()-1] > 2.*M_PI ||
-      angleVectorI[angleVectorI.size()-1] < 0.0) {
-    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
-    return UNKNOWN_DISTANCE;
+double
+HyperbolicRoutingCalculator::calculateDistance(const Coordinates& coordinates,
+                                               int32_t src, int32_t dest) const
+{
+  double innerProduct = 0.0;
+  for (size_t k = 0; k < coordinates.nCoordinates; ++k) {
+    const double* column = coordinates.point.data() + k * m_nRouters;
+    innerProduct += column[src] * column[dest];
   }
 
-  if (angleVectorI[angleVectorI.size()-1] > 2.*M_PI ||
-      angleVectorI[angleVectorI.size()-1] < 0.0) {
-    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
+  if (!isKnownDistance(coordinates, src, dest, innerProduct)) {
     return UNKNOWN_DISTANCE;
   }
+  return std::acosh(coordinates.coshRadius[src] * coordinates.coshRadius[dest] -
+                    coordinates.sinhRadius[src] * coordinates.sinhRadius[dest] * innerProduct);
+}
 
-  // deltaTheta = arccos(vectorI . vectorJ) -> do the inner product
-  double innerProduct = 0.0;
-
-  // Calculate x0 of the vectors
-  double x0i = std::cos(angleVectorI[0]);
-  double x0j = std::cos(angleVectorJ[0]);
-
-  // Calculate xn of the vectors
-  double xni = std::sin(angleVectorI[angleVectorI.size() - 1]);
-  double xnj = std::sin(angleVectorJ[angleVectorJ.size() - 1]);
-
-  // Do the aggregation of the (n-1) coordinates (if there is more than one angle)
-  // i.e contraction of all (n-1)-dimensional angular coordinates to one variable
-  for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
-    xni *= std::sin(angleVectorI[k]);
-    xnj *= std::sin(angleVectorJ[k]);
+bool
+HyperbolicRoutingCalculator::isKnownDistance(const Coordinates& coordinates, int32_t src,
+                                             int32_t dest, double innerProduct) const
+{
+  size_t nAngles = coordinates.nAngles[src];
+  if (nAngles == 0 || coordinates.nAngles[dest] != nAngles) {
+    return false;
   }
-  innerProduct += (x0i * x0j) + (xni * xnj);
-
-  // If d > 1
-  if (angleVectorI.size() > 1) {
-    for (unsigned int m = 1; m < angleVectorI.size(); m++) {
-      // calculate euclidean coordinates given the angles and assuming R_sphere = 1
-      double xmi = std::cos(angleVectorI[m]);
-      double xmj = std::cos(angleVectorJ[m]);
-      for (unsigned int l = 0; l < m; l++) {
-        xmi *= std::sin(angleVectorI[l]);
-        xmj *= std::sin(angleVectorJ[l]);
-      }
-      innerProduct += xmi * xmj;
-    }
+  if (innerProduct >= 1.0 && dest != src) {
+    NLSR_LOG_ERROR("Delta theta is <= 0");
+    NLSR_LOG_ERROR("Please make sure that no two nodes have the exact same HR coordinates");
+    return false;
   }
-
-  // ArcCos of the inner product gives the angular distance
-  // between two points on a d-dimensional sphere
-  return std::acos(innerProduct);
+  return true;
 }
 
-double
-HyperbolicRoutingCalculator::calculateHyperbolicDistance(double rI, double rJ,
-                                                         double deltaTheta)
+void
+HyperbolicDistanceCache::invalidate(const ndn::Name& router)
 {
-  if (deltaTheta == UNKNOWN_DISTANCE) {
-    return UNKNOWN_DISTANCE;
+  auto index = m_routers.getMappingNoByRouterName(router);
+  if (!index) {
+    return;
   }
 
-  // Usually, we set zeta = 1 in all experiments
-  double zeta = 1;
-
-  if (deltaTheta <= 0.0 || rI <= 0.0 || rJ <= 0.0) {
-    NLSR_LOG_ERROR("Delta theta or rI or rJ is <= 0");
-    NLSR_LOG_ERROR("Please make sure that no two nodes have the exact same HR coordinates");
-    return UNKNOWN_DISTANCE;
+  m_rows.erase(*index);
+  for (auto& [src, row] : m_rows) {
+    if (static_cast<size_t>(*index) < row.size()) {
+      row[*index] = std::numeric_limits<double>::quiet_NaN();
+    }
   }
+}
 
-  double xij = (1. / zeta) * std::acosh(std::cosh(zeta*rI) * std::cosh(zeta*rJ) -
-               std::sinh(zeta*rI)*std::sinh(zeta*rJ)*std::cos(deltaTheta));
-  return xij;
+int32_t
+HyperbolicDistanceCache::getIndex(const ndn::Name& router)
+{
+  m_routers.addEntry(router);
+  return *m_routers.getMappingNoByRouterName(router);
+}
+
+std::vector<double>&
+HyperbolicDistanceCache::getRow(int32_t src)
+{
+  auto& row = m_rows[src];
+  row.resize(m_routers.size(), std::numeric_limits<double>::quiet_NaN());
+  return row;
 }
 
 void
 HyperbolicRoutingCalculator::addNextHop(const ndn::Name& dest, const ndn::FaceUri& faceUri,
-                                        double cost, RoutingTable& rt)
+                                        double cost)
 {
   NextHop hop(faceUri, cost);
   hop.setHyperbolic(true);
 
   NLSR_LOG_TRACE("Calculated " << hop << " for destination: " << dest);
 
-  if (m_isDryRun) {
-    rt.addNextHopToDryTable(dest, hop);
-  }
-  else {
-    rt.addNextHop(dest, hop);
-  }
+  m_routes.emplace_back(dest, hop);
+}
+
+RouteList
+calculateHyperbolicRoutes(const NameMap& map, const Lsdb& lsdb,
+                          const AdjacencyList& adjacencies, const ndn::Name& thisRouterName,
+                          HyperbolicDistanceCache* cache)
+{
+  HyperbolicRoutingCalculator calculator(map.size(), thisRouterName);
+  return calculator.calculatePath(map, lsdb, adjacencies, cache);
 }
 
 void
 calculateHyperbolicRoutingPath(NameMap& map, RoutingTable& rt, Lsdb& lsdb,
                                AdjacencyList& adjacencies, ndn::Name thisRouterName,
-                               bool isDryRun)
+                               bool isDryRun, HyperbolicDistanceCache* cache)
 {
-  HyperbolicRoutingCalculator calculator(map.size(), isDryRun, thisRouterName);
-  calculator.calculatePath(map, rt, lsdb, adjacencies);
+  for (auto& [dest, hop] : calculateHyperbolicRoutes(map, lsdb, adjacencies, thisRouterName,
+                                                     cache)) {
+    if (isDryRun) {
+      rt.addNextHopToDryTable(dest, hop);
+    }
+    else {
+      rt.addNextHop(dest, hop);
+    }
+  }
 }
 
 } // namespace nlsr
@@ -20,43 +20,44 @@
  */
 
 #include "routing-calculator.hpp"
+#include "link-state-graph.hpp"
 #include "name-map.hpp"
 #include "nexthop.hpp"
+#include "shortest-path.hpp"
 
 #include "adjacent.hpp"
 #include "logger.hpp"
 #include "nlsr.hpp"
 #include "topology.hpp"
-#include <boost/multi_array.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory_resource>
+#include <mutex>
+#include <set>
+#include <system_error>
+#include <thread>
+#include <tuple>
 
 namespace nlsr {
 namespace {
 
 INIT_LOGGER(route.RoutingCalculatorLinkState);
 
-constexpr int EMPTY_PARENT = -12345;
-constexpr double INF_DISTANCE = 2147483647;
 constexpr int NO_NEXT_HOP = -12345;
 
-/**
- * @brief Adjacency matrix.
- *
- * The matrix shall be a 2D array with N rows and N columns, where N is the number of routers.
- * Element i,j is the cost from router i to router j.
- */
-using AdjMatrix = boost::multi_array<double, 2>;
-
-struct PrintAdjMatrix
+struct PrintGraph
 {
-  const AdjMatrix& matrix;
+  const LinkStateGraph& graph;
   const NameMap& map;
 };
 
 /**
- * @brief Print adjacency matrix.
+ * @brief Print router graph.
  */
 std::ostream&
-operator<<(std::ostream& os, const PrintAdjMatrix& p)
+operator<<(std::ostream& os, const PrintGraph& p)
 {
   size_t nRouters = p.map.size();
 
@@ -65,27 +66,14 @@ operator<<(std::ostream& os, const PrintAdjMatrix& p)
     os << "Router:" << *p.map.getRouterNameByMappingNo(i)
        << " Index:" << i << "\n";
   }
-  os << " |";
-  for (size_t i = 0; i < nRouters; ++i) {
-    os << i << " ";
-  }
-  os << "\n";
-  os << "--";
-  for (size_t i = 0; i < nRouters; ++i) {
-    os << "--";
-  }
-  os << "\n";
+  os << "-----------Links (index: neighbor=cost)------\n";
 
   for (size_t i = 0; i < nRouters; i++) {
-    os << i << "|";
-    for (size_t j = 0; j < nRouters; j++) {
-      double cost = p.matrix[i][j];
-      if (cost == NO_NEXT_HOP) {
-        os << "0 ";
-      }
-      else {
-        os << cost << " ";
-      }
+    os << i << ":";
+    auto neighbors = p.graph.getNeighbors(i);
+    auto costs = p.graph.getCosts(i);
+    for (size_t j = 0; j < neighbors.size(); j++) {
+      os << " " << neighbors[j] << "=" << fromLinkCost(costs[j]);
     }
     os << "\n";
   }
@@ -93,294 +81,482 @@ operator<<(std::ostream& os, const PrintAdjMatrix& p)
   return os;
 }
 
-/**
- * @brief Allocate and populate adjacency matrix.
- *
- * The adjacency matrix is resized to match the number of routers in @p map .
- * Costs from Adjacency LSAs are filled into the matrix; in case of a mismatch in bidirectional
- * costs, the higher cost is assigned for both directions.
- * All other elements are set to @c NON_ADJACENT_COST .
- */
-AdjMatrix
-makeAdjMatrix(const Lsdb& lsdb, NameMap& map)
-{
-  // Create the matrix to have N rows and N columns, where N is number of routers.
-  size_t nRouters = map.size();
-  AdjMatrix matrix(boost::extents[nRouters][nRouters]);
-
-  // Initialize all elements to NON_ADJACENT_COST.
-  std::fill_n(matrix.origin(), matrix.num_elements(), Adjacent::NON_ADJACENT_COST);
-
-  // For each LSA represented in the map
-  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
-  for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; ++lsaIt) {
-    auto adjLsa = std::static_pointer_cast<AdjLsa>(*lsaIt);
-    auto row = map.getMappingNoByRouterName(adjLsa->getOriginRouter());
-
-    std::list<Adjacent> adl = adjLsa->getAdl().getAdjList();
-    // For each adjacency represented in the LSA
-    for (const auto& adjacent : adl) {
-      auto col = map.getMappingNoByRouterName(adjacent.getName());
-      double cost = adjacent.getLinkCost();
-
-      if (row && col && *row < static_cast<int32_t>(nRouters)
-          && *col < static_cast<int32_t>(nRouters)) {
-        matrix[*row][*col] = cost;
-      }
-    }
-  }
-
-  // Links that do not have the same cost for both directions should
-  // have their costs corrected:
-  //
-  //   If the cost of one side of the link is NON_ADJACENT_COST (i.e. broken) or negative,
-  //   both direction of the link should have their cost corrected to NON_ADJACENT_COST.
-  //
-  //   Otherwise, both sides of the link should use the larger of the two costs.
-  //
-  // Additionally, this means that we can halve the amount of space
-  // that the matrix uses by only maintaining a triangle.
-  // - But that is not yet implemented.
-  for (size_t row = 0; row < nRouters; ++row) {
-    for (size_t col = 0; col < nRouters; ++col) {
-      double& toCost = matrix[row][col];
-      double& fromCost = matrix[col][row];
-
-      if (fromCost == toCost) {
-        continue;
-      }
-
-      // If both sides of the link are up, use the larger cost else break the link
-      double correctedCost = Adjacent::NON_ADJACENT_COST;
-      if (toCost >= 0 && fromCost >= 0) {
-        correctedCost = std::max(toCost, fromCost);
-      }
-
-      NLSR_LOG_WARN("Cost between [" << row << "][" << col << "] and [" << col << "][" << row <<
-                "] are not the same (" << toCost << " != " << fromCost << "). " <<
-                "Correcting to cost: " << correctedCost);
-
-      toCost = correctedCost;
-      fromCost = correctedCost;
-    }
-  }
-
-  return matrix;
-}
-
-void
-sortQueueByDistance(std::vector<int>& q, const std::vector<double>& dist, size_t start)
-{
-  for (size_t i = start; i < q.size(); ++i) {
-    for (size_t j = i + 1; j < q.size(); ++j) {
-      if (dist[q[j]] < dist[q[i]]) {
-        std::swap(q[i], q[j]);
-      }
-    }
-  }
-}
-
-bool
-isNotExplored(std::vector<int>& q, int u, size_t start)
-{
-  for (size_t i = start; i < q.size(); i++) {
-    if (q[i] == u) {
-      return true;
-    }
-  }
-  return false;
-}
-
 struct Link
 {
   size_t index;
-  double cost;
+  LinkCost cost;
 };
 
 /**
  * @brief List adjacencies and link costs from a source router.
  */
 std::vector<Link>
-gatherLinks(const AdjMatrix& matrix, int sourceRouter)
+gatherLinks(const LinkStateGraph& graph, int sourceRouter)
 {
-  size_t nRouters = matrix.size();
+  auto neighbors = graph.getNeighbors(sourceRouter);
+  auto costs = graph.getCosts(sourceRouter);
   std::vector<Link> result;
-  result.reserve(nRouters);
-  for (size_t i = 0; i < nRouters; ++i) {
-    if (i == static_cast<size_t>(sourceRouter)) {
+  result.reserve(neighbors.size());
+  for (size_t i = 0; i < neighbors.size(); ++i) {
+    if (neighbors[i] == sourceRouter) {
       continue;
     }
-    double cost = matrix[sourceRouter][i];
-    if (cost >= 0.0) {
-      result.emplace_back(Link{i, cost});
-    }
+    result.emplace_back(Link{static_cast<size_t>(neighbors[i]), costs[i]});
   }
   return result;
 }
 
+int
+getNextHop(const ShortestPathTree& tree, int dest, int source)
+{
+  int nextHop = NO_NEXT_HOP;
+  while (tree.parent[dest] != ShortestPathTree::NO_PARENT) {
+    nextHop = dest;
+    dest = tree.parent[dest];
+  }
+  if (dest != source) {
+    nextHop = NO_NEXT_HOP;
+  }
+  return nextHop;
+}
+
 /**
- * @brief Adjust link costs to simulate having only one accessible neighbor.
+ * @brief Insert shortest paths into the routes.
  */
 void
-simulateOneNeighbor(AdjMatrix& matrix, int sourceRouter, const Link& accessibleNeighbor)
+addNextHopsToRoutes(LinkStateRoutes& routes, const NameMap& map, int sourceRouter,
+                    const AdjacencyList& adjacencies, const ShortestPathTree& tree)
 {
-  size_t nRouters = matrix.size();
-  for (size_t i = 0; i < nRouters; ++i) {
-    if (i == accessibleNeighbor.index) {
-      matrix[sourceRouter][i] = accessibleNeighbor.cost;
+  NLSR_LOG_DEBUG("addNextHopsToRoutes Called");
+  int nRouters = static_cast<int>(map.size());
+
+  // For each router we have
+  for (int i = 0; i < nRouters; ++i) {
+    if (i == sourceRouter) {
+      continue;
     }
-    else {
-      // if "i" is not a link to the source, set its cost to a non adjacent value.
-      matrix[sourceRouter][i] = Adjacent::NON_ADJACENT_COST;
+
+    // Obtain the next hop that was determined by the algorithm
+    int nextHopRouter = getNextHop(tree, i, sourceRouter);
+    if (nextHopRouter == NO_NEXT_HOP) {
+      continue;
     }
+    // If this router is accessible at all
+
+    // Fetch its distance
+    double routeCost = fromLinkCost(tree.distance[i]);
+    // Fetch its actual name
+    auto nextHopRouterName = map.getRouterNameByMappingNo(nextHopRouter);
+    BOOST_ASSERT(nextHopRouterName.has_value());
+    InternedFaceUri nextHopFace(adjacencies.getAdjacent(*nextHopRouterName).getFaceUri());
+    // Add next hop to the routes
+    routes.nextHops.emplace_back(*map.getRouterNameByMappingNo(i), NextHop(nextHopFace, routeCost));
   }
 }
 
-class DijkstraResult
+/**
+ * @brief Insert paths through one neighbor of the source router into the routes.
+ * @param tree Tree rooted at the neighbor that excludes the source router.
+ */
+void
+addNeighborNextHopsToRoutes(LinkStateRoutes& routes, const NameMap& map, int sourceRouter,
+                            const AdjacencyList& adjacencies, const Link& neighbor,
+                            const ShortestPathTree& tree)
 {
-public:
-  int
-  getNextHop(int dest, int source) const
-  {
-    int nextHop = NO_NEXT_HOP;
-    while (parent[dest] != EMPTY_PARENT) {
-      nextHop = dest;
-      dest = parent[dest];
-    }
-    if (dest != source) {
-      nextHop = NO_NEXT_HOP;
+  auto neighborName = map.getRouterNameByMappingNo(static_cast<int32_t>(neighbor.index));
+  BOOST_ASSERT(neighborName.has_value());
+  InternedFaceUri nextHopFace(adjacencies.getAdjacent(*neighborName).getFaceUri());
+
+  int nRouters = static_cast<int>(map.size());
+  for (int i = 0; i < nRouters; ++i) {
+    if (i == sourceRouter || tree.distance[i] == ShortestPathTree::INF_DISTANCE) {
+      continue;
     }
-    return nextHop;
+    routes.nextHops.emplace_back(*map.getRouterNameByMappingNo(i),
+                                 NextHop(nextHopFace, fromLinkCost(tree.distance[i])));
   }
-
-public:
-  std::vector<int> parent;
-  std::vector<double> distance;
-};
+}
 
 /**
- * @brief Compute the shortest path from a source router to every other router.
+ * @brief Insert the paths through each neighbor of the source router into the routes, keeping
+ *        only disjoint ones as next hops.
+ * @param linkTrees Trees rooted at each neighbor in @p links , that exclude the source router.
+ *
+ * Toward each destination, the paths through the neighbors are taken cheapest first. A path that
+ * shares a link with one already taken, or with DisjointPaths::NODE a router other than the
+ * destination, is recorded as an alternate rather than a next hop.
  */
-DijkstraResult
-calculateDijkstraPath(const AdjMatrix& matrix, int sourceRouter)
+void
+addDisjointNextHopsToRoutes(LinkStateRoutes& routes, const NameMap& map, int sourceRouter,
+                            const AdjacencyList& adjacencies, const std::vector<Link>& links,
+                            const std::vector<ShortestPathTree>& linkTrees,
+                            DisjointPaths disjointPaths)
 {
-  size_t nRouters = matrix.size();
-  std::vector<int> parent(nRouters, EMPTY_PARENT);
-  // Array where the ith element is the distance to the router with mapping no i.
-  std::vector<double> distance(nRouters, INF_DISTANCE);
-  // Each cell represents the router with that mapping no.
-  std::vector<int> q(nRouters);
-  for (size_t i = 0 ; i < nRouters; ++i) {
-    q[i] = static_cast<int>(i);
+  std::vector<InternedFaceUri> faces;
+  faces.reserve(links.size());
+  for (const auto& link : links) {
+    auto neighborName = map.getRouterNameByMappingNo(static_cast<int32_t>(link.index));
+    BOOST_ASSERT(neighborName.has_value());
+    faces.emplace_back(adjacencies.getAdjacent(*neighborName).getFaceUri());
   }
 
-  size_t head = 0;
-  // Distance to source from source is always 0.
-  distance[sourceRouter] = 0;
-  sortQueueByDistance(q, distance, head);
-  // While we haven't visited every node.
-  while (head < nRouters) {
-    int u = q[head]; // Set u to be the current node pointed to by head.
-    if (distance[u] == INF_DISTANCE) {
-      break; // This can only happen when there are no accessible nodes.
+  auto makeLinkKey = [] (int32_t a, int32_t b) {
+    return std::make_pair(std::min(a, b), std::max(a, b));
+  };
+
+  int nRouters = static_cast<int>(map.size());
+  // routers on the paths taken toward destination i are marked with i + 1
+  std::vector<int> usedRouters(nRouters, 0);
+  std::set<std::pair<int32_t, int32_t>> usedLinks;
+  std::vector<size_t> order;
+  std::vector<int32_t> path;
+  for (int i = 0; i < nRouters; ++i) {
+    if (i == sourceRouter) {
+      continue;
     }
-    // Iterate over the adjacent nodes to u.
-    for (size_t v = 0; v < nRouters; ++v) {
-      // If the current node is accessible and we haven't visited it yet.
-      if (matrix[u][v] >= 0 && isNotExplored(q, v, head + 1)) {
-        // And if the distance to this node + from this node to v
-        // is less than the distance from our source node to v
-        // that we got when we built the adj LSAs
-        double newDistance = distance[u] + matrix[u][v];
-        if (newDistance < distance[v]) {
-          // Set the new distance
-          distance[v] = newDistance;
-          // Set how we get there.
-          parent[v] = u;
+
+    order.clear();
+    for (size_t j = 0; j < links.size(); ++j) {
+      if (linkTrees[j].distance[i] != ShortestPathTree::INF_DISTANCE) {
+        order.push_back(j);
+      }
+    }
+    std::sort(order.begin(), order.end(), [&] (size_t a, size_t b) {
+      return std::tie(linkTrees[a].distance[i], links[a].index) <
+             std::tie(linkTrees[b].distance[i], links[b].index);
+    });
+
+    auto destName = *map.getRouterNameByMappingNo(i);
+    usedLinks.clear();
+    for (size_t j : order) {
+      const auto& tree = linkTrees[j];
+      // from the destination back to the neighbor, which is the root, then to the source
+      path.clear();
+      for (int32_t router = i; router != ShortestPathTree::NO_PARENT;
+           router = tree.parent[router]) {
+        path.push_back(router);
+      }
+      path.push_back(sourceRouter);
+
+      bool isDisjoint = true;
+      for (size_t k = 0; k + 1 < path.size() && isDisjoint; ++k) {
+        if (disjointPaths == DisjointPaths::NODE && k > 0 && usedRouters[path[k]] == i + 1) {
+          isDisjoint = false;
+        }
+        else if (usedLinks.count(makeLinkKey(path[k], path[k + 1])) > 0) {
+          isDisjoint = false;
         }
       }
+
+      NextHop nextHop(faces[j], fromLinkCost(tree.distance[i]));
+      if (!isDisjoint) {
+        routes.alternates.emplace_back(destName, nextHop);
+        continue;
+      }
+      for (size_t k = 0; k + 1 < path.size(); ++k) {
+        usedRouters[path[k]] = i + 1;
+        usedLinks.insert(makeLinkKey(path[k], path[k + 1]));
+      }
+      routes.nextHops.emplace_back(destName, nextHop);
     }
-    // Increment the head position, resort the list by distance from where we are.
-    ++head;
-    sortQueueByDistance(q, distance, head);
   }
-
-  return DijkstraResult{std::move(parent), std::move(distance)};
 }
 
 /**
- * @brief Insert shortest paths into the routing table.
+ * @brief Record loop-free alternates of the shortest paths in the routes.
+ * @param tree Tree rooted at the source router.
+ * @param linkTrees Trees rooted at each neighbor in @p links , on the whole graph.
+ *
+ * Following RFC 5286, neighbor N is a loop-free alternate toward destination D if
+ * `dist(N, D) < dist(N, S) + dist(S, D)`, i.e. N does not send traffic for D back through
+ * the source S. The cheapest such neighbor other than the primary next hop is recorded.
  */
 void
-addNextHopsToRoutingTable(RoutingTable& rt, const NameMap& map, int sourceRouter,
-                          const AdjacencyList& adjacencies, const DijkstraResult& dr)
+addAlternatesToRoutes(LinkStateRoutes& routes, const NameMap& map, int sourceRouter,
+                      const AdjacencyList& adjacencies, const ShortestPathTree& tree,
+                      const std::vector<Link>& links,
+                      const std::vector<ShortestPathTree>& linkTrees)
 {
-  NLSR_LOG_DEBUG("addNextHopsToRoutingTable Called");
   int nRouters = static_cast<int>(map.size());
-
-  // For each router we have
   for (int i = 0; i < nRouters; ++i) {
     if (i == sourceRouter) {
       continue;
     }
+    int primary = getNextHop(tree, i, sourceRouter);
+    if (primary == NO_NEXT_HOP) {
+      continue;
+    }
 
-    // Obtain the next hop that was determined by the algorithm
-    int nextHopRouter = dr.getNextHop(i, sourceRouter);
-    if (nextHopRouter == NO_NEXT_HOP) {
+    size_t best = links.size();
+    LinkCost bestCost = ShortestPathTree::INF_DISTANCE;
+    for (size_t j = 0; j < links.size(); ++j) {
+      const auto& distance = linkTrees[j].distance;
+      if (static_cast<int>(links[j].index) == primary ||
+          !(distance[i] < addDistance(distance[sourceRouter], tree.distance[i]))) {
+        continue;
+      }
+      LinkCost cost = addDistance(links[j].cost, distance[i]);
+      if (cost < bestCost) {
+        best = j;
+        bestCost = cost;
+      }
+    }
+    if (best == links.size()) {
       continue;
     }
-    // If this router is accessible at all
 
-    // Fetch its distance
-    double routeCost = dr.distance[i];
-    // Fetch its actual name
-    auto nextHopRouterName = map.getRouterNameByMappingNo(nextHopRouter);
-    BOOST_ASSERT(nextHopRouterName.has_value());
-    auto nextHopFace = adjacencies.getAdjacent(*nextHopRouterName).getFaceUri();
-    // Add next hop to routing table
-    NextHop nh(nextHopFace, routeCost);
-    rt.addNextHop(*map.getRouterNameByMappingNo(i), nh);
+    auto neighborName = map.getRouterNameByMappingNo(static_cast<int32_t>(links[best].index));
+    BOOST_ASSERT(neighborName.has_value());
+    InternedFaceUri nextHopFace(adjacencies.getAdjacent(*neighborName).getFaceUri());
+    routes.alternates.emplace_back(*map.getRouterNameByMappingNo(i),
+                                   NextHop(nextHopFace, fromLinkCost(bestCost)));
+  }
+}
+
+/**
+ * @brief Obtain a shortest-path tree, updating the previous one when possible.
+ * @param previous Trees of the previous calculation, or nullptr if they cannot be reused;
+ *                 a reused tree is moved out of it.
+ *
+ * The temporary arrays of the computation are taken from an arena, which is released at once
+ * when the tree is obtained, so that the SPF does not allocate them one by one on the heap.
+ */
+ShortestPathTree
+computeTree(const LinkStateGraph& graph, SpfState* previous,
+            int32_t root, LinkCost rootDistance, int32_t excluded)
+{
+  // enough for the arrays of a full computation; an update may need more, which is added
+  std::pmr::monotonic_buffer_resource arena(graph.size() * 4 * sizeof(size_t) + 1024);
+
+  if (previous != nullptr) {
+    auto it = previous->trees.find(root);
+    if (it != previous->trees.end() && it->second.rootDistance == rootDistance) {
+      ShortestPathTree tree = std::move(it->second.tree);
+      size_t nUpdated = updateShortestPathTree(tree, previous->graph, graph,
+                                               root, rootDistance, excluded, &arena);
+      NLSR_LOG_DEBUG("Incremental SPF rooted at " << root << " recomputed " <<
+                     nUpdated << " of " << graph.size() << " routers");
+      return tree;
+    }
+  }
+  return calculateShortestPathTree(graph, root, rootDistance, excluded, &arena);
+}
+
+/**
+ * @brief Invoke @p task for every index in `[0, nTasks)` using up to @p nThreads threads.
+ *
+ * The calling thread takes part in the work and returns once every task has completed.
+ * Tasks must not touch state shared with other tasks or with the io thread.
+ * If a task throws, the remaining tasks are skipped, and the first exception is rethrown
+ * once every thread has been joined.
+ */
+void
+runTasks(size_t nTasks, size_t nThreads, const std::function<void(size_t)>& task)
+{
+  std::atomic<size_t> nextTask{0};
+  std::mutex errorMutex;
+  std::exception_ptr error;
+  auto worker = [&] {
+    try {
+      for (size_t i = nextTask++; i < nTasks; i = nextTask++) {
+        task(i);
+      }
+    }
+    catch (...) {
+      nextTask = nTasks;
+      std::lock_guard<std::mutex> lock(errorMutex);
+      if (!error) {
+        error = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  size_t nWorkers = std::min(nThreads, nTasks);
+  threads.reserve(nWorkers);
+  try {
+    for (size_t i = 1; i < nWorkers; ++i) {
+      threads.emplace_back(worker);
+    }
+  }
+  catch (const std::system_error& e) {
+    // the threads already started, and the calling thread, still complete every task
+    NLSR_LOG_WARN("Cannot start a calculation thread: " << e.what() <<
+                  ", continuing with " << threads.size() + 1);
+  }
+  worker();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
   }
 }
 
 } // anonymous namespace
 
+LinkStateInput
+makeLinkStateInput(const NameMap& map, ConfParameter& confParam)
+{
+  LinkStateInput input;
+  input.map = map;
+  input.adjacencies = confParam.getAdjacencyList();
+  input.routerPrefix = confParam.getRouterPrefix();
+  input.isMultipath = confParam.getMaxFacesPerPrefix() != 1;
+  input.hasLoopFreeAlternates = confParam.getLoopFreeAlternates();
+  input.disjointPaths = confParam.getDisjointPaths();
+  input.nThreads = confParam.getRoutingCalcThreads();
+  return input;
+}
+
 void
-calculateLinkStateRoutingPath(NameMap& map, RoutingTable& rt, ConfParameter& confParam,
-                              const Lsdb& lsdb)
+buildLinkStateGraph(LinkStateInput& input, const LsdbSnapshot& lsdb)
 {
-  NLSR_LOG_DEBUG("calculateLinkStateRoutingPath called");
+  if (input.map.getMappingNoByRouterName(input.routerPrefix)) {
+    input.graph = LinkStateGraph::createFromAdjLsdb(lsdb, input.map);
+    NLSR_LOG_TRACE((PrintGraph{input.graph, input.map}));
+  }
+}
+
+LinkStateInput
+makeLinkStateInput(const NameMap& map, ConfParameter& confParam, const Lsdb& lsdb)
+{
+  LinkStateInput input = makeLinkStateInput(map, confParam);
+  buildLinkStateGraph(input, *lsdb.getSnapshot());
+  return input;
+}
+
+LinkStateRoutes
+calculateLinkStateRoutes(LinkStateInput input, SpfState* spfState)
+{
+  LinkStateRoutes routes;
+  const auto& map = input.map;
 
-  auto sourceRouter = map.getMappingNoByRouterName(confParam.getRouterPrefix());
+  auto sourceRouter = map.getMappingNoByRouterName(input.routerPrefix);
   if (!sourceRouter) {
     NLSR_LOG_DEBUG("Source router is absent, nothing to do");
-    return;
+    return routes;
+  }
+
+  for (const auto& [neighbor, cost] : input.localCosts) {
+    auto index = map.getMappingNoByRouterName(neighbor);
+    if (index) {
+      input.graph.setCost(*sourceRouter, *index, cost);
+    }
+  }
+  for (const auto& neighbor : input.failedNeighbors) {
+    auto index = map.getMappingNoByRouterName(neighbor);
+    if (index) {
+      input.graph.removeLink(*sourceRouter, *index);
+    }
+  }
+  const auto& graph = input.graph;
+
+  bool isMultipath = input.isMultipath;
+  std::vector<ndn::Name> routers;
+  routers.reserve(map.size());
+  for (size_t i = 0; i < map.size(); ++i) {
+    routers.push_back(*map.getRouterNameByMappingNo(i));
   }
 
-  AdjMatrix matrix = makeAdjMatrix(lsdb, map);
-  NLSR_LOG_DEBUG((PrintAdjMatrix{matrix, map}));
-  //在建立matrix后，导出拓扑信息到json文件
-  exportTopology(matrix, map, confParam);
-  if (confParam.getMaxFacesPerPrefix() == 1) {
+  // The previous trees can be updated incrementally only if they refer to the same routers.
+  SpfState* previous = nullptr;
+  if (spfState != nullptr && spfState->source == *sourceRouter &&
+      spfState->isMultipath == isMultipath && spfState->routers == routers) {
+    previous = spfState;
+  }
+
+  std::map<int32_t, SpfState::RootedTree> trees;
+  if (!isMultipath) {
     // In the single path case we can simply run Dijkstra's algorithm.
-    auto dr = calculateDijkstraPath(matrix, *sourceRouter);
-    // Inform the routing table of the new next hops.
-    addNextHopsToRoutingTable(rt, map, *sourceRouter, confParam.getAdjacencyList(), dr);
+    auto tree = computeTree(graph, previous, *sourceRouter, 0, NO_EXCLUDED_ROUTER);
+    // Record the new next hops.
+    addNextHopsToRoutes(routes, map, *sourceRouter, input.adjacencies, tree);
+
+    if (input.hasLoopFreeAlternates) {
+      // The alternates need the distances from every neighbor on the whole graph.
+      auto links = gatherLinks(graph, *sourceRouter);
+      std::vector<ShortestPathTree> linkTrees(links.size());
+      runTasks(links.size(), input.nThreads, [&] (size_t i) {
+        linkTrees[i] = computeTree(graph, previous, static_cast<int32_t>(links[i].index),
+                                   0, NO_EXCLUDED_ROUTER);
+      });
+
+      addAlternatesToRoutes(routes, map, *sourceRouter, input.adjacencies, tree, links, linkTrees);
+      for (size_t i = 0; i < links.size(); ++i) {
+        trees.emplace(static_cast<int32_t>(links[i].index),
+                      SpfState::RootedTree{0, std::move(linkTrees[i])});
+      }
+    }
+    trees.emplace(*sourceRouter, SpfState::RootedTree{0, std::move(tree)});
   }
   else {
     // Multi Path
     // Gets a sparse listing of adjacencies for path calculation
-    auto links = gatherLinks(matrix, *sourceRouter);
-    for (const auto& link : links) {
-      // Simulate that only the current neighbor is accessible
-      simulateOneNeighbor(matrix, *sourceRouter, link);
-      NLSR_LOG_DEBUG((PrintAdjMatrix{matrix, map}));
-      // Do Dijkstra's algorithm using the current neighbor as your start.
-      auto dr = calculateDijkstraPath(matrix, *sourceRouter);
-      // Update the routing table with the calculations.
-      addNextHopsToRoutingTable(rt, map, *sourceRouter, confParam.getAdjacencyList(), dr);
+    auto links = gatherLinks(graph, *sourceRouter);
+    std::vector<ShortestPathTree> linkTrees(links.size());
+    // Compute the distances obtained when only the current neighbor is accessible:
+    // the tree is rooted at the neighbor and never goes back through the source.
+    // The computations are independent, so they may run on several threads.
+    runTasks(links.size(), input.nThreads, [&] (size_t i) {
+      linkTrees[i] = computeTree(graph, previous, static_cast<int32_t>(links[i].index),
+                                 links[i].cost, *sourceRouter);
+    });
+
+    if (input.disjointPaths != DisjointPaths::NONE) {
+      addDisjointNextHopsToRoutes(routes, map, *sourceRouter, input.adjacencies, links,
+                                  linkTrees, input.disjointPaths);
+    }
+    for (size_t i = 0; i < links.size(); ++i) {
+      // Record the calculated next hops.
+      if (input.disjointPaths == DisjointPaths::NONE) {
+        addNeighborNextHopsToRoutes(routes, map, *sourceRouter, input.adjacencies,
+                                    links[i], linkTrees[i]);
+      }
+      trees.emplace(static_cast<int32_t>(links[i].index),
+                    SpfState::RootedTree{links[i].cost, std::move(linkTrees[i])});
     }
   }
+
+  if (spfState != nullptr) {
+    spfState->routers = std::move(routers);
+    spfState->graph = std::move(input.graph);
+    spfState->source = *sourceRouter;
+    spfState->isMultipath = isMultipath;
+    spfState->trees = std::move(trees);
+  }
+  return routes;
+}
+
+void
+calculateLinkStateRoutingPath(const NameMap& map, RoutingTable& rt, ConfParameter& confParam,
+                              const Lsdb& lsdb, SpfState* spfState, LocalCostOverlay localCosts)
+{
+  NLSR_LOG_DEBUG("calculateLinkStateRoutingPath called");
+
+  auto& profile = rt.getCalculationProfile();
+
+  LinkStateInput input;
+  {
+    CalculationProfile::Scope scope(profile, CalculationProfile::PHASE_GRAPH);
+    input = makeLinkStateInput(map, confParam, lsdb);
+    input.localCosts = std::move(localCosts);
+    input.failedNeighbors = rt.getFailedNeighbors();
+  }
+  if (input.graph.size() > 0) {
+    CalculationProfile::Scope scope(profile, CalculationProfile::PHASE_TOPOLOGY_EXPORT);
+    rt.getTopologyExporter().publish(input.graph, input.map);
+  }
+
+  LinkStateRoutes routes;
+  {
+    CalculationProfile::Scope scope(profile, CalculationProfile::PHASE_SPF);
+    routes = calculateLinkStateRoutes(std::move(input), spfState);
+  }
+
+  CalculationProfile::Scope scope(profile, CalculationProfile::PHASE_INSTALL);
+  rt.addLinkStateRoutes(routes);
 }
 
 } // namespace nlsr
@@ -23,20 +23,150 @@
 
 #include "common.hpp"
 #include "lsdb.hpp"
+#include "route/link-state-graph.hpp"
+#include "route/name-map.hpp"
+#include "route/nexthop.hpp"
+
+#include <unordered_map>
 
 namespace nlsr {
 
-class NameMap;
 class RoutingTable;
+struct SpfState;
+
+/**
+ * @brief Next hops found by a routing calculation, with their destination router.
+ */
+using RouteList = std::vector<std::pair<ndn::Name, NextHop>>;
+
+/**
+ * @brief Costs toward neighbors that replace the advertised costs of this router's links,
+ *        in its own calculation only.
+ */
+using LocalCostOverlay = std::vector<std::pair<ndn::Name, double>>;
+
+/**
+ * @brief Input of a link-state calculation, detached from the LSDB and the configuration.
+ *
+ * It can be handed over to another thread while the LSDB keeps changing.
+ */
+struct LinkStateInput
+{
+  NameMap map;
+  LinkStateGraph graph;
+  AdjacencyList adjacencies;
+  ndn::Name routerPrefix;
+  bool isMultipath = true;
+  bool hasLoopFreeAlternates = false;
+  DisjointPaths disjointPaths = DisjointPaths::NONE;
+  size_t nThreads = 1;
+  LocalCostOverlay localCosts;
+  /// neighbors whose links are left out although this router's Adjacency LSA still lists them
+  std::vector<ndn::Name> failedNeighbors;
+};
+
+/**
+ * @brief Next hops found by a link-state calculation, by destination router.
+ */
+struct LinkStateRoutes
+{
+  RouteList nextHops;
+  RouteList alternates;
+};
+
+/**
+ * @brief Take a snapshot of the settings of a link-state calculation, without its graph.
+ */
+LinkStateInput
+makeLinkStateInput(const NameMap& map, ConfParameter& confParam);
+
+/**
+ * @brief Build the graph of @p input from the Adjacency LSAs of @p lsdb .
+ *
+ * As it only reads an LSDB snapshot, this may run outside of the io thread.
+ */
+void
+buildLinkStateGraph(LinkStateInput& input, const LsdbSnapshot& lsdb);
 
+/**
+ * @brief Take a snapshot of the Adjacency LSAs and of the settings of a link-state calculation.
+ */
+LinkStateInput
+makeLinkStateInput(const NameMap& map, ConfParameter& confParam, const Lsdb& lsdb);
+
+/**
+ * @brief Calculate link-state routes from a snapshot.
+ * @param spfState See calculateLinkStateRoutingPath().
+ *
+ * This only touches @p input and @p spfState , so it may run outside of the io thread.
+ */
+LinkStateRoutes
+calculateLinkStateRoutes(LinkStateInput input, SpfState* spfState = nullptr);
+
+/**
+ * @brief Calculate link-state routes and insert them into @p rt .
+ * @param spfState If not null, the shortest-path trees of the previous calculation; they are
+ *                 updated incrementally when the set of routers is unchanged, and replaced
+ *                 with the trees of this calculation.
+ * @param localCosts Costs of this router's links that differ from the advertised ones.
+ */
 void
-calculateLinkStateRoutingPath(NameMap& map, RoutingTable& rt, ConfParameter& confParam,
-                              const Lsdb& lsdb);
+calculateLinkStateRoutingPath(const NameMap& map, RoutingTable& rt, ConfParameter& confParam,
+                              const Lsdb& lsdb, SpfState* spfState = nullptr,
+                              LocalCostOverlay localCosts = {});
+
+/**
+ * @brief Hyperbolic distances kept across calculations.
+ *
+ * Distances are stored by (neighbor, destination) pair of router indices. Indices are assigned
+ * on first sight and never change, so that a Coordinate LSA change only drops one row and one
+ * column, and the next calculation only recomputes those.
+ */
+class HyperbolicDistanceCache
+{
+public:
+  /**
+   * @brief Drop the distances from and to @p router , whose Coordinate LSA changed.
+   */
+  void
+  invalidate(const ndn::Name& router);
+
+  /**
+   * @brief Return index of @p router , assigning one if needed.
+   */
+  int32_t
+  getIndex(const ndn::Name& router);
+
+  /**
+   * @brief Return distances from router @p src by destination index; missing ones are NaN.
+   */
+  std::vector<double>&
+  getRow(int32_t src);
+
+private:
+  NameMap m_routers;
+  std::unordered_map<int32_t, std::vector<double>> m_rows;
+};
 
+/**
+ * @param cache If not null, distances of the previous calculations, see
+ *              HyperbolicDistanceCache.
+ */
 void
 calculateHyperbolicRoutingPath(NameMap& map, RoutingTable& rt, Lsdb& lsdb,
                                AdjacencyList& adjacencies, ndn::Name thisRouterName,
-                               bool isDryRun);
+                               bool isDryRun, HyperbolicDistanceCache* cache = nullptr);
+
+/**
+ * @brief Calculate hyperbolic routes without touching the routing table.
+ *
+ * This only reads Coordinate LSAs, @p adjacencies and @p cache , so it may run alongside a
+ * link-state calculation as long as none of them are modified.
+ */
+RouteList
+calculateHyperbolicRoutes(const NameMap& map, const Lsdb& lsdb,
+                          const AdjacencyList& adjacencies, const ndn::Name& thisRouterName,
+                          HyperbolicDistanceCache* cache = nullptr);
 
 } // namespace nlsr
 
@@ -0,0 +1,231 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "routing-change-feed.hpp"
+#include "logger.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <map>
+
+namespace nlsr {
+
+INIT_LOGGER(route.RoutingChangeFeed);
+
+template<ndn::encoding::Tag TAG>
+size_t
+RoutingTableChanges::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto it = delta.removed.rbegin(); it != delta.removed.rend(); ++it) {
+    totalLength += prependNestedBlock(block, nlsr::tlv::RemovedDestination, *it);
+  }
+  for (auto it = delta.changed.rbegin(); it != delta.changed.rend(); ++it) {
+    totalLength += prependNestedBlock(block, nlsr::tlv::ChangedRoute, *it);
+  }
+  for (auto it = delta.added.rbegin(); it != delta.added.rend(); ++it) {
+    totalLength += prependNestedBlock(block, nlsr::tlv::AddedRoute, *it);
+  }
+  if (isSnapshot) {
+    totalLength += prependEmptyBlock(block, nlsr::tlv::FullSnapshot);
+  }
+  totalLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::RoutingTableVersion, version);
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::RoutingTableChanges);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(RoutingTableChanges);
+
+ndn::Block
+RoutingTableChanges::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  return buffer.block();
+}
+
+void
+RoutingTableChanges::wireDecode(const ndn::Block& wire)
+{
+  *this = {};
+
+  if (wire.type() != nlsr::tlv::RoutingTableChanges) {
+    NDN_THROW(Error("RoutingTableChanges", wire.type()));
+  }
+
+  wire.parse();
+  auto val = wire.elements_begin();
+
+  if (val == wire.elements_end() || val->type() != nlsr::tlv::RoutingTableVersion) {
+    NDN_THROW(Error("Missing required RoutingTableVersion field"));
+  }
+  version = ndn::encoding::readNonNegativeInteger(*val);
+  ++val;
+
+  if (val != wire.elements_end() && val->type() == nlsr::tlv::FullSnapshot) {
+    isSnapshot = true;
+    ++val;
+  }
+  for (; val != wire.elements_end() && val->type() == nlsr::tlv::AddedRoute; ++val) {
+    delta.added.emplace_back(val->blockFromValue());
+  }
+  for (; val != wire.elements_end() && val->type() == nlsr::tlv::ChangedRoute; ++val) {
+    delta.changed.emplace_back(val->blockFromValue());
+  }
+  for (; val != wire.elements_end() && val->type() == nlsr::tlv::RemovedDestination; ++val) {
+    delta.removed.emplace_back(val->blockFromValue());
+  }
+
+  if (val != wire.elements_end()) {
+    NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(val->type()) +
+                    " in RoutingTableChanges"));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const RoutingTableChanges& changes)
+{
+  os << "Routing Table Changes: version=" << changes.version
+     << (changes.isSnapshot ? " (full snapshot)" : "") << "\n";
+  if (!changes.delta.added.empty()) {
+    os << "Added:\n";
+    for (const auto& entry : changes.delta.added) {
+      os << entry;
+    }
+  }
+  if (!changes.delta.changed.empty()) {
+    os << "Changed:\n";
+    for (const auto& entry : changes.delta.changed) {
+      os << entry;
+    }
+  }
+  if (!changes.delta.removed.empty()) {
+    os << "Removed:\n";
+    for (const auto& destination : changes.delta.removed) {
+      os << "  Destination: " << destination << "\n";
+    }
+  }
+  return os;
+}
+
+RoutingChangeFeed::RoutingChangeFeed(const RoutingTable& routingTable,
+                                     AfterRoutingDelta& afterRoutingDeltaSignal,
+                                     size_t capacity)
+  : m_routingTable(routingTable)
+  , m_capacity(capacity)
+{
+  m_afterRoutingDeltaConnection = afterRoutingDeltaSignal.connect(
+    [this] (const RoutingTableDelta& delta) {
+      onRoutingDelta(delta);
+    });
+}
+
+void
+RoutingChangeFeed::onRoutingDelta(const RoutingTableDelta& delta)
+{
+  ++m_version;
+  size_t size = delta.added.size() + delta.changed.size() + delta.removed.size();
+  m_history.push_back({m_version, delta, size});
+  m_historySize += size;
+
+  while (!m_history.empty() && m_historySize > m_capacity) {
+    m_historySize -= m_history.front().size;
+    m_history.pop_front();
+  }
+  NLSR_LOG_TRACE("Routing table version " << m_version << ", history of " << m_history.size() <<
+                 " deltas");
+}
+
+RoutingTableChanges
+RoutingChangeFeed::getSnapshot() const
+{
+  RoutingTableChanges changes;
+  changes.version = m_version;
+  changes.isSnapshot = true;
+  changes.delta.added = m_routingTable.getRoutingTableEntry();
+  return changes;
+}
+
+RoutingTableChanges
+RoutingChangeFeed::getChangesSince(uint64_t version) const
+{
+  // the history holds the deltas after oldestVersion
+  uint64_t oldestVersion = m_history.empty() ? m_version : m_history.front().version - 1;
+  if (version < oldestVersion || version > m_version) {
+    return getSnapshot();
+  }
+
+  struct Change
+  {
+    bool wasPresent;
+    // unset when the destination is absent from the current table
+    const RoutingTableEntry* entry;
+  };
+  std::map<ndn::Name, Change> merged;
+  auto merge = [&merged] (const ndn::Name& destination, bool wasPresent,
+                          const RoutingTableEntry* entry) {
+    auto [it, isNew] = merged.try_emplace(destination, Change{wasPresent, entry});
+    if (!isNew) {
+      it->second.entry = entry;
+    }
+  };
+
+  auto first = m_history.begin() + static_cast<ptrdiff_t>(version - oldestVersion);
+  for (auto it = first; it != m_history.end(); ++it) {
+    for (const auto& entry : it->delta.added) {
+      merge(entry.getDestination(), false, &entry);
+    }
+    for (const auto& entry : it->delta.changed) {
+      merge(entry.getDestination(), true, &entry);
+    }
+    for (const auto& destination : it->delta.removed) {
+      merge(destination, true, nullptr);
+    }
+  }
+
+  RoutingTableChanges changes;
+  changes.version = m_version;
+  for (const auto& [destination, change] : merged) {
+    if (change.entry == nullptr) {
+      if (change.wasPresent) {
+        changes.delta.removed.push_back(destination);
+      }
+    }
+    else if (change.wasPresent) {
+      changes.delta.changed.push_back(*change.entry);
+    }
+    else {
+      changes.delta.added.push_back(*change.entry);
+    }
+  }
+  return changes;
+}
+
+} // namespace nlsr
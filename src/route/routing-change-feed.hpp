@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_ROUTING_CHANGE_FEED_HPP
+#define NLSR_ROUTE_ROUTING_CHANGE_FEED_HPP
+
+#include "routing-table.hpp"
+#include "signals.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <boost/noncopyable.hpp>
+
+#include <deque>
+
+namespace nlsr {
+
+/*! \brief Changes of the routing table between a version known to the consumer and the
+ *         current one, or the whole table.
+ *
+ *     RoutingTableChanges = ROUTING-TABLE-CHANGES-TYPE TLV-LENGTH
+ *                             RoutingTableVersion
+ *                             [FullSnapshot]
+ *                             *AddedRoute
+ *                             *ChangedRoute
+ *                             *RemovedDestination
+ *
+ *     RoutingTableVersion = ROUTING-TABLE-VERSION-TYPE TLV-LENGTH NonNegativeInteger
+ *     FullSnapshot = FULL-SNAPSHOT-TYPE TLV-LENGTH ; zero length
+ *     AddedRoute = ADDED-ROUTE-TYPE TLV-LENGTH RoutingTableEntry
+ *     ChangedRoute = CHANGED-ROUTE-TYPE TLV-LENGTH RoutingTableEntry
+ *     RemovedDestination = REMOVED-DESTINATION-TYPE TLV-LENGTH Name
+ *
+ * In a FullSnapshot, every entry of the table is an AddedRoute and the consumer replaces its
+ * copy of the table.
+ */
+class RoutingTableChanges
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  RoutingTableChanges() = default;
+
+  explicit
+  RoutingTableChanges(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+public:
+  /// version of the routing table after the changes
+  uint64_t version = 0;
+  bool isSnapshot = false;
+  RoutingTableDelta delta;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const RoutingTableChanges& changes);
+
+/*! \brief Numbers the publications of the routing table, and keeps the recent deltas so that
+ *         consumers can catch up from the version they last saw.
+ *
+ * Each delta emitted by the routing table increments the version. The history is bounded by
+ * the number of destinations in the deltas it holds, and the oldest deltas are dropped first;
+ * a consumer whose version is no longer covered is given a full snapshot instead.
+ */
+class RoutingChangeFeed : boost::noncopyable
+{
+public:
+  RoutingChangeFeed(const RoutingTable& routingTable, AfterRoutingDelta& afterRoutingDeltaSignal,
+                    size_t capacity = DEFAULT_CAPACITY);
+
+  uint64_t
+  getVersion() const
+  {
+    return m_version;
+  }
+
+  /*! \brief Returns the changes from \p version to the current version, merged by
+   *         destination, or a full snapshot when \p version is not covered by the history.
+   */
+  RoutingTableChanges
+  getChangesSince(uint64_t version) const;
+
+  /*! \brief Returns the current routing table as a full snapshot.
+   */
+  RoutingTableChanges
+  getSnapshot() const;
+
+private:
+  void
+  onRoutingDelta(const RoutingTableDelta& delta);
+
+public:
+  /// destinations held in the history by default
+  static constexpr size_t DEFAULT_CAPACITY = 4096;
+
+private:
+  struct VersionedDelta
+  {
+    uint64_t version;
+    RoutingTableDelta delta;
+    size_t size;
+  };
+
+  const RoutingTable& m_routingTable;
+  ndn::signal::ScopedConnection m_afterRoutingDeltaConnection;
+  size_t m_capacity;
+  uint64_t m_version = 0;
+  // oldest first, in consecutive versions ending at m_version
+  std::deque<VersionedDelta> m_history;
+  size_t m_historySize = 0;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_ROUTING_CHANGE_FEED_HPP
@@ -33,8 +33,8 @@ operator<<(std::ostream& os, RoutingTablePoolEntry& rtpe)
     os << nh;
   }
   os << "NamePrefixTableEntries using this entry:";
-  for (const auto& entryPtr : rtpe.namePrefixTableEntries) {
-    os << entryPtr.first << ":";
+  for (const auto* npte : rtpe.namePrefixTableEntries) {
+    os << npte->getNamePrefix() << ":";
   }
 
   return os;
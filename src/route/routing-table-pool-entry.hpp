@@ -25,7 +25,7 @@
 #include "nexthop-list.hpp"
 
 #include <ndn-cxx/name.hpp>
-#include <unordered_map>
+#include <unordered_set>
 
 namespace nlsr {
 
@@ -41,6 +41,12 @@ namespace nlsr {
  * class can be associated with the name prefixes instead of the
  * original entries, which provides a minimal memory solution.
  *
+ * The pool entries are stored in the pool itself, and are referenced by
+ * plain pointers: the use count is the number of NPT entries that list
+ * this entry, and the NamePrefixTable erases the entry when it drops to
+ * zero. In turn, NPT entries unlink themselves from the pool entries in
+ * removeRoutingTableEntry before they are erased.
+ *
  * \sa NamePrefixTable
  */
 class NamePrefixTableEntry;
@@ -97,10 +103,11 @@ public:
   }
 
 public:
-  std::unordered_map<ndn::Name, std::weak_ptr<NamePrefixTableEntry>> namePrefixTableEntries;
+  /// NPT entries using this entry; they outlive their membership in this set
+  std::unordered_set<NamePrefixTableEntry*> namePrefixTableEntries;
 
 private:
-  uint64_t m_useCount;
+  uint64_t m_useCount = 0;
 };
 
 bool
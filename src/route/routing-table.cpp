@@ -10,16 +10,46 @@
 #include "routing-table-entry.hpp"
 #include "load-aware-routing-calculator.hpp"
 #include "ml-adaptive-calculator.hpp"  // 注意：文件名要与实际文件名一致
+#include "what-if.hpp"
 
 #include "conf-parameter.hpp"
 #include "logger.hpp"
 #include "nlsr.hpp"
 #include "tlv-nlsr.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <future>
+#include <set>
+
+#include <boost/asio/post.hpp>
+
 namespace nlsr {
 
 INIT_LOGGER(route.RoutingTable);
 
+namespace {
+
+/// How long before an ML time slot begins its routes are precomputed
+constexpr ndn::time::seconds PRECOMPUTE_LEAD{30};
+
+ndn::time::nanoseconds
+getDelayUntil(std::chrono::system_clock::time_point time)
+{
+  auto delay = std::chrono::duration_cast<std::chrono::nanoseconds>(time -
+                                                                   std::chrono::system_clock::now());
+  return ndn::time::nanoseconds(std::max<int64_t>(delay.count(), 0));
+}
+
+} // namespace
+
+struct RoutingTable::PrecomputedRoutes
+{
+  MLAdaptiveCalculator::CostForecast forecast;
+  LinkStateRoutes routes;
+  uint64_t lsdbVersion;
+};
+
 RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter& confParam)
   // ✅ 教学要点：初始化列表顺序必须与头文件中成员声明顺序完全一致
   // 这是C++的基本要求，违反会导致编译警告甚至未定义行为
@@ -27,7 +57,7 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
   , m_lsdb(lsdb)
   , m_confParam(confParam)
   , m_hyperbolicState(m_confParam.getHyperbolicState())
-  , m_routingCalcInterval{confParam.getRoutingCalcInterval()}
+  , m_routingCalcHoldTime{confParam.getRoutingCalcHoldTime()}
   , m_isRoutingTableCalculating(false)
   , m_isRouteCalculationScheduled(false)
   , m_ownAdjLsaExist(false)
@@ -36,12 +66,14 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
   // ✅ 智能指针初始化：nullptr是现代C++的最佳实践
   , m_loadAwareCalculator(nullptr)
   , m_mlAdaptiveCalculator(nullptr)
+  , m_topologyExporter(confParam)
 {
   // ✅ 教学要点：信号连接在所有成员初始化完成后进行
   // 这确保了回调函数中引用的所有成员都已正确初始化
   m_afterLsdbModified = lsdb.onLsdbModified.connect(
     [this] (std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
-            const auto& namesToAdd, const auto& namesToRemove) {
+            const auto& namesToAdd, const auto& namesToRemove, const AdjLsaDiff& adjLsaDiff) {
+      ++m_lsdbVersion;
       auto type = lsa->getType();
       bool updateForOwnAdjacencyLsa = lsa->getOriginRouter() == m_confParam.getRouterPrefix() &&
                                       type == Lsa::Type::ADJACENCY;
@@ -52,16 +84,32 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
         clearRoutingTable();
         clearDryRoutingTable();
         NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-        afterRoutingChange(m_rTable);
-        NLSR_LOG_DEBUG(*this);
+        publishRoutingChange();
+        NLSR_LOG_TRACE(*this);
         m_ownAdjLsaExist = false;
+        // The result of a running calculation must not bring the routes back.
+        m_isAsyncCalculationPending = m_isAsyncCalculationRunning;
       }
 
       if (updateType == LsdbUpdate::INSTALLED && updateForOwnAdjacencyLsa) {
         m_ownAdjLsaExist = true;
       }
 
-      if (updateType == LsdbUpdate::INSTALLED || updateType == LsdbUpdate::UPDATED) {
+      if (updateForOwnAdjacencyLsa) {
+        // the new Adjacency LSA no longer lists the failed neighbors as active
+        m_failedNeighbors.clear();
+      }
+
+      if (type == Lsa::Type::COORDINATE) {
+        m_hyperbolicDistances.invalidate(lsa->getOriginRouter());
+      }
+
+      if (updateType == LsdbUpdate::UPDATED && type == Lsa::Type::ADJACENCY &&
+          !updateForOwnAdjacencyLsa && adjLsaDiff.empty()) {
+        // Only the Face URIs of another router's adjacencies changed, which does not affect routes
+        NLSR_LOG_DEBUG("Links of " << lsa->getOriginRouter() << " unchanged, no calculation needed");
+      }
+      else if (updateType == LsdbUpdate::INSTALLED || updateType == LsdbUpdate::UPDATED) {
         if ((type == Lsa::Type::ADJACENCY  && m_hyperbolicState != HYPERBOLIC_STATE_ON) ||
             (type == Lsa::Type::COORDINATE && m_hyperbolicState != HYPERBOLIC_STATE_OFF)) {
           scheduleCalculation = true;
@@ -80,16 +128,30 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
 RoutingTable::~RoutingTable()
 {
   m_afterLsdbModified.disconnect();
+  if (m_calcWorker) {
+    // The running calculation uses m_spfState.
+    m_calcWorker->join();
+  }
   // unique_ptr会自动管理LoadAwareRoutingCalculator和MLAdaptiveCalculator的生命周期
 }
 
 void RoutingTable::calculate()
 {
-  m_lsdb.writeLog();
+  m_calculationProfile.beginCalculation();
+  auto start = ndn::time::steady_clock::now();
+  // The LSDB can be large; "nlsrc lsdb" shows it on demand.
+  if (NLSR_LOG_TRACE_ENABLED()) {
+    CalculationProfile::Scope scope(m_calculationProfile, CalculationProfile::PHASE_LSDB_LOG);
+    m_lsdb.writeLog();
+  }
   NLSR_LOG_TRACE("Calculating routing table");
 
   if (m_isRoutingTableCalculating == false) {
     m_isRoutingTableCalculating = true;//开启算法计算标志位
+    m_lastCalculationTime = ndn::time::steady_clock::now();
+    if (m_tracer != nullptr) {
+      m_tracer->record(ConvergenceStage::CALCULATION);
+    }
 
     
     if (m_confParam.getMLAdaptiveRouting()) {
@@ -107,8 +169,17 @@ void RoutingTable::calculate()
     }
     else if (m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN) {
       NLSR_LOG_INFO("Using hyperbolic routing (dry-run mode)");
+      // The dry run only reads Coordinate LSAs and does not touch the routing table, so it
+      // overlaps with the link-state calculation, which is installed without waiting for it.
+      auto dryRun = std::async(std::launch::async, [this] {
+        CalculationProfile::Scope scope(m_calculationProfile, CalculationProfile::PHASE_HYPERBOLIC);
+        auto lsaRange = m_lsdb.getLsdbIterator<CoordinateLsa>();
+        auto map = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+        return calculateHyperbolicRoutes(map, m_lsdb, m_confParam.getAdjacencyList(),
+                                         m_confParam.getRouterPrefix(), &m_hyperbolicDistances);
+      });
       calculateLsRoutingTable();
-      calculateHypRoutingTable(true);
+      setDryRoutingTable(dryRun.get());
     }
     else if (m_hyperbolicState == HYPERBOLIC_STATE_ON) {
       NLSR_LOG_INFO("Using hyperbolic routing algorithm");
@@ -117,6 +188,14 @@ void RoutingTable::calculate()
 
     m_isRouteCalculationScheduled = false;
     m_isRoutingTableCalculating = false;
+
+    if (m_isShadowCalculationDue && !m_isAsyncCalculationRunning) {
+      calculateShadowRoutes();
+    }
+
+    m_calculationProfile.record(CalculationProfile::PHASE_TOTAL,
+                                ndn::time::steady_clock::now() - start);
+    m_calculationProfile.endCalculation();
   }
   else {
     scheduleRoutingTableCalculation();
@@ -138,6 +217,13 @@ RoutingTable::calculateLoadAwareRoutingTable()
     return;
   }
 
+  if (m_isAsyncCalculationRunning) {
+    // m_spfState belongs to the worker thread; the calculation is redone once it ends.
+    NLSR_LOG_DEBUG("Link-state calculation running, will recalculate once it ends");
+    m_isAsyncCalculationPending = true;
+    return;
+  }
+
   clearRoutingTable();
   
   if (m_linkCostManager == nullptr) {
@@ -146,9 +232,8 @@ RoutingTable::calculateLoadAwareRoutingTable()
     return;
   }
 
-  auto lsaRange = m_lsdb.getLsdbIterator<AdjLsa>();
-  auto map = NameMap::createFromAdjLsdb(lsaRange.first, lsaRange.second);
-  NLSR_LOG_DEBUG(map);
+  const auto& map = m_lsdb.getRouterMap();
+  NLSR_LOG_TRACE(map);
 
   // ✅ 教学要点：懒加载模式的优势
   // 只在第一次使用时创建对象，避免不必要的资源消耗
@@ -158,11 +243,11 @@ RoutingTable::calculateLoadAwareRoutingTable()
     m_loadAwareCalculator = std::make_unique<LoadAwareRoutingCalculator>(*m_linkCostManager);
   }
 
-  m_loadAwareCalculator->calculatePath(map, *this, m_confParam, m_lsdb);
+  m_loadAwareCalculator->calculatePath(map, *this, m_confParam, m_lsdb, &m_spfState);
 
   NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-  afterRoutingChange(m_rTable);
-  NLSR_LOG_DEBUG(*this);
+  publishRoutingChange();
+  NLSR_LOG_TRACE(*this);
 }
 
 // ✅ 新增：ML自适应路由表计算方法
@@ -182,6 +267,13 @@ RoutingTable::calculateMLAdaptiveRoutingTable()
     return;
   }
 
+  if (m_isAsyncCalculationRunning) {
+    // m_spfState belongs to the worker thread; the calculation is redone once it ends.
+    NLSR_LOG_DEBUG("Link-state calculation running, will recalculate once it ends");
+    m_isAsyncCalculationPending = true;
+    return;
+  }
+
   clearRoutingTable();
   
   // 如果关键依赖不可用，自动降级到可靠的备选方案
@@ -191,36 +283,153 @@ RoutingTable::calculateMLAdaptiveRoutingTable()
     return;
   }
 
-  auto lsaRange = m_lsdb.getLsdbIterator<AdjLsa>();
-  auto map = NameMap::createFromAdjLsdb(lsaRange.first, lsaRange.second);
-  NLSR_LOG_DEBUG(map);
+  const auto& map = m_lsdb.getRouterMap();
+  NLSR_LOG_TRACE(map);
 
   // 严格遵循负载感知算法的成功模式
   // 使用相同的懒加载策略，确保ML学习状态的持久性
   if (!m_mlAdaptiveCalculator) {
     NLSR_LOG_INFO("Creating persistent MLAdaptiveCalculator (first time)");
-    m_mlAdaptiveCalculator = std::make_unique<MLAdaptiveCalculator>(*m_linkCostManager);
-    // ✅ 关键：建立ML反馈连接
-    if (m_linkCostManager) {
-      m_linkCostManager->setMLFeedbackCallback(
-        [this](const ndn::Name& neighbor, double performance) {
-          if (m_mlAdaptiveCalculator) {
-            m_mlAdaptiveCalculator->reportPathPerformance(neighbor, performance);
-            NLSR_LOG_TRACE("🔄 ML learning cycle: " << neighbor 
-                          << " performance=" << performance);
-          }
-        });
-      
-      NLSR_LOG_INFO("🔗 ML feedback loop established between LinkCostManager and MLAdaptiveCalculator");
-    }
+    // the calculator also registers itself as the target of the ML feedback
+    m_mlAdaptiveCalculator = std::make_unique<MLAdaptiveCalculator>(*m_linkCostManager,
+                                                                     m_confParam.getStateFileDir(),
+                                                                     m_confParam.getMLWeeklyPatterns());
   }
 
   // ✅ 关键设计：直接调用持久化对象方法，避免临时对象陷阱
-  m_mlAdaptiveCalculator->calculatePath(map, *this, m_confParam, m_lsdb);
+  m_mlAdaptiveCalculator->calculatePath(map, *this, m_confParam, m_lsdb, &m_spfState);
 
   NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-  afterRoutingChange(m_rTable);
-  NLSR_LOG_DEBUG(*this);
+  publishRoutingChange();
+  NLSR_LOG_TRACE(*this);
+
+  scheduleRoutePrecomputation();
+}
+
+void
+RoutingTable::updateCostCalculators()
+{
+  bool isMlAdaptive = m_confParam.getMLAdaptiveRouting();
+  bool isLoadAware = !isMlAdaptive && m_confParam.getLoadAwareRouting();
+
+  // the routes of a running link-state calculation do not follow the new routing mode
+  m_isAsyncCalculationPending = m_isAsyncCalculationRunning;
+
+  if (!isMlAdaptive && m_mlAdaptiveCalculator) {
+    NLSR_LOG_INFO("Destroying the MLAdaptiveCalculator");
+    m_precomputeEvent.cancel();
+    m_precomputedRoutes.reset();
+    m_isPrecomputationScheduled = false;
+    m_mlAdaptiveCalculator.reset();
+  }
+  if (!isLoadAware && m_loadAwareCalculator) {
+    NLSR_LOG_INFO("Destroying the LoadAwareRoutingCalculator");
+    m_loadAwareCalculator.reset();
+  }
+  if (m_linkCostManager == nullptr) {
+    return;
+  }
+
+  if (isMlAdaptive && !m_mlAdaptiveCalculator) {
+    m_mlAdaptiveCalculator = std::make_unique<MLAdaptiveCalculator>(*m_linkCostManager,
+                                                                     m_confParam.getStateFileDir(),
+                                                                     m_confParam.getMLWeeklyPatterns());
+  }
+  if (isLoadAware && !m_loadAwareCalculator) {
+    m_loadAwareCalculator = std::make_unique<LoadAwareRoutingCalculator>(*m_linkCostManager);
+  }
+
+  // a destroyed calculator cleared the cost policy, even when another one had registered it
+  if (m_mlAdaptiveCalculator) {
+    m_linkCostManager->setCostPolicy(m_mlAdaptiveCalculator.get());
+    m_linkCostManager->setMLFeedbackTarget(*m_mlAdaptiveCalculator);
+  }
+  else if (m_loadAwareCalculator) {
+    m_linkCostManager->setCostPolicy(m_loadAwareCalculator.get());
+  }
+}
+
+void
+RoutingTable::scheduleRoutePrecomputation()
+{
+  if (m_isPrecomputationScheduled || !m_confParam.getMLRoutePrecompute() ||
+      !m_mlAdaptiveCalculator) {
+    return;
+  }
+  m_isPrecomputationScheduled = true;
+
+  auto delay = getDelayUntil(m_mlAdaptiveCalculator->getNextSlotStart()) - PRECOMPUTE_LEAD;
+  m_precomputeEvent = m_scheduler.schedule(std::max(delay, ndn::time::nanoseconds::zero()),
+                                           [this] { precomputeNextSlotRoutes(); });
+}
+
+void
+RoutingTable::precomputeNextSlotRoutes()
+{
+  auto forecast = m_mlAdaptiveCalculator->forecastNextSlot();
+  if (!forecast || !m_ownAdjLsaExist || m_lsdb.getIsBuildAdjLsaScheduled() ||
+      m_linkCostManager == nullptr) {
+    NLSR_LOG_DEBUG("No routes to precompute for the next time slot");
+    m_precomputeEvent = m_scheduler.schedule(
+      getDelayUntil(m_mlAdaptiveCalculator->getNextSlotStart()),
+      [this] { installPrecomputedRoutes(); });
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Precomputing routes for the link costs forecast for the next time slot");
+  LinkStateInput input = makeLinkStateInput(m_lsdb.getRouterMap(), m_confParam);
+  // the forecast comes after the other local costs, so that it takes precedence
+  input.localCosts = m_linkCostManager->getLocalCostOverlay();
+  input.localCosts.insert(input.localCosts.end(), forecast->costs.begin(), forecast->costs.end());
+
+  if (!m_calcWorker) {
+    m_calcWorker = std::make_unique<boost::asio::thread_pool>(1);
+  }
+  // Without SpfState, the calculation leaves m_spfState to the calculations of the live table.
+  boost::asio::post(*m_calcWorker,
+    [this, input = std::move(input), snapshot = m_lsdb.getSnapshot(),
+     forecast = std::move(*forecast), version = m_lsdbVersion,
+     &io = m_lsdb.getIoContext(), token = std::weak_ptr<int>(m_lifetimeToken)] () mutable {
+      buildLinkStateGraph(input, *snapshot);
+      auto routes = calculateLinkStateRoutes(std::move(input));
+      boost::asio::post(io,
+        [this, token, forecast = std::move(forecast), version, routes = std::move(routes)] () mutable {
+          if (token.expired()) {
+            return;
+          }
+          auto delay = getDelayUntil(forecast.slotStart);
+          m_precomputedRoutes = std::make_unique<PrecomputedRoutes>(
+            PrecomputedRoutes{std::move(forecast), std::move(routes), version});
+          m_precomputeEvent = m_scheduler.schedule(delay, [this] { installPrecomputedRoutes(); });
+        });
+    });
+}
+
+void
+RoutingTable::installPrecomputedRoutes()
+{
+  auto precomputed = std::move(m_precomputedRoutes);
+  m_isPrecomputationScheduled = false;
+
+  if (precomputed && m_confParam.getMLAdaptiveRouting() && m_mlAdaptiveCalculator) {
+    if (precomputed->lsdbVersion != m_lsdbVersion) {
+      // the LSDB change has scheduled a calculation already
+      NLSR_LOG_DEBUG("Dropping routes precomputed from an outdated LSDB");
+    }
+    else if (!m_mlAdaptiveCalculator->confirmForecast(precomputed->forecast)) {
+      NLSR_LOG_DEBUG("Dropping precomputed routes, live link costs differ from the forecast");
+      scheduleRoutingTableCalculation();
+    }
+    else {
+      NLSR_LOG_INFO("Installing routes precomputed for the new time slot");
+      clearRoutingTable();
+      addLinkStateRoutes(precomputed->routes);
+      publishRoutingChange();
+      NLSR_LOG_TRACE(*this);
+    }
+  }
+
+  scheduleRoutePrecomputation();
 }
 
 // ✅ 其他方法保持完全不变
@@ -229,7 +438,8 @@ RoutingTable::calculateLsRoutingTable()
 {
   NLSR_LOG_TRACE("CalculateLsRoutingTable Called");
 
-  if (m_lsdb.getIsBuildAdjLsaScheduled()) {
+  // The failed neighbors are the reason for the build, and are left out of the calculation.
+  if (m_lsdb.getIsBuildAdjLsaScheduled() && m_failedNeighbors.empty()) {
     NLSR_LOG_DEBUG("Adjacency build is scheduled, routing table can not be calculated :(");
     return;
   }
@@ -238,17 +448,101 @@ RoutingTable::calculateLsRoutingTable()
     return;
   }
 
+  if (m_confParam.getRoutingCalcAsync()) {
+    calculateLsRoutingTableAsync();
+    return;
+  }
+
   clearRoutingTable();
 
-  auto lsaRange = m_lsdb.getLsdbIterator<AdjLsa>();
-  auto map = NameMap::createFromAdjLsdb(lsaRange.first, lsaRange.second);
-  NLSR_LOG_DEBUG(map);
+  const auto& map = m_lsdb.getRouterMap();
+  NLSR_LOG_TRACE(map);
 
-  calculateLinkStateRoutingPath(map, *this, m_confParam, m_lsdb);
+  calculateLinkStateRoutingPath(map, *this, m_confParam, m_lsdb, &m_spfState);
 
   NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-  afterRoutingChange(m_rTable);
-  NLSR_LOG_DEBUG(*this);
+  publishRoutingChange();
+  NLSR_LOG_TRACE(*this);
+}
+
+void
+RoutingTable::calculateLsRoutingTableAsync()
+{
+  if (m_isAsyncCalculationRunning) {
+    NLSR_LOG_DEBUG("Calculation running, will restart from the latest LSDB");
+    m_isAsyncCalculationPending = true;
+    return;
+  }
+
+  if (!m_calcWorker) {
+    m_calcWorker = std::make_unique<boost::asio::thread_pool>(1);
+  }
+
+  const auto& map = m_lsdb.getRouterMap();
+  NLSR_LOG_TRACE(map);
+
+  // The graph is built on the worker, from a snapshot that the LSDB will not modify.
+  LinkStateInput input = makeLinkStateInput(map, m_confParam);
+  input.failedNeighbors = m_failedNeighbors;
+  auto snapshot = m_lsdb.getSnapshot();
+
+  m_isAsyncCalculationRunning = true;
+  boost::asio::post(*m_calcWorker,
+    [this, input = std::move(input), snapshot = std::move(snapshot), &io = m_lsdb.getIoContext(),
+     token = std::weak_ptr<int>(m_lifetimeToken)] () mutable {
+      {
+        CalculationProfile::Scope scope(m_calculationProfile, CalculationProfile::PHASE_GRAPH);
+        buildLinkStateGraph(input, *snapshot);
+      }
+      if (input.graph.size() > 0) {
+        boost::asio::post(io, [this, token, graph = input.graph, map = input.map] {
+          if (!token.expired()) {
+            CalculationProfile::Scope scope(m_calculationProfile,
+                                            CalculationProfile::PHASE_TOPOLOGY_EXPORT);
+            m_topologyExporter.publish(graph, map);
+          }
+        });
+      }
+
+      // While a calculation is running, m_spfState belongs to the worker thread.
+      LinkStateRoutes routes;
+      {
+        CalculationProfile::Scope scope(m_calculationProfile, CalculationProfile::PHASE_SPF);
+        routes = calculateLinkStateRoutes(std::move(input), &m_spfState);
+      }
+      boost::asio::post(io, [this, token, routes = std::move(routes)] {
+        if (!token.expired()) {
+          onAsyncCalculationDone(routes);
+        }
+      });
+    });
+}
+
+void
+RoutingTable::onAsyncCalculationDone(const LinkStateRoutes& routes)
+{
+  m_isAsyncCalculationRunning = false;
+
+  if (m_isAsyncCalculationPending) {
+    NLSR_LOG_DEBUG("Dropping routes calculated from an outdated LSDB or routing mode");
+    m_isAsyncCalculationPending = false;
+    calculate();
+    return;
+  }
+
+  clearRoutingTable();
+  {
+    CalculationProfile::Scope scope(m_calculationProfile, CalculationProfile::PHASE_INSTALL);
+    addLinkStateRoutes(routes);
+  }
+
+  NLSR_LOG_DEBUG("Calling Update NPT With new Route");
+  publishRoutingChange();
+  NLSR_LOG_TRACE(*this);
+
+  if (m_isShadowCalculationDue) {
+    calculateShadowRoutes();
+  }
 }
 
 void
@@ -261,79 +555,308 @@ RoutingTable::calculateHypRoutingTable(bool isDryRun)
     clearRoutingTable();
   }
 
-  auto lsaRange = m_lsdb.getLsdbIterator<CoordinateLsa>();
-  auto map = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
-  NLSR_LOG_DEBUG(map);
+  {
+    CalculationProfile::Scope scope(m_calculationProfile, CalculationProfile::PHASE_HYPERBOLIC);
+    auto lsaRange = m_lsdb.getLsdbIterator<CoordinateLsa>();
+    auto map = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+    NLSR_LOG_TRACE(map);
 
-  calculateHyperbolicRoutingPath(map, *this, m_lsdb, m_confParam.getAdjacencyList(),
-                                 m_confParam.getRouterPrefix(), isDryRun);
+    calculateHyperbolicRoutingPath(map, *this, m_lsdb, m_confParam.getAdjacencyList(),
+                                   m_confParam.getRouterPrefix(), isDryRun,
+                                   &m_hyperbolicDistances);
+  }
 
   if (!isDryRun) {
     NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-    afterRoutingChange(m_rTable);
-    NLSR_LOG_DEBUG(*this);
+    publishRoutingChange();
+    NLSR_LOG_TRACE(*this);
+  }
+}
+
+void
+RoutingTable::setDryRoutingTable(const RouteList& routes)
+{
+  clearDryRoutingTable();
+  for (const auto& [destRouter, nh] : routes) {
+    NLSR_LOG_DEBUG("Adding " << nh << " to dry table for destination: " << destRouter);
+    addNextHopToTable(m_dryTable, m_dryTableIndex, destRouter, nh);
+  }
+}
+
+void
+RoutingTable::calculateShadowRoutes()
+{
+  m_isShadowCalculationDue = false;
+  if (m_isShadowCalculationRunning) {
+    NLSR_LOG_DEBUG("Shadow calculation running, skipping this one");
+    return;
+  }
+
+  RouteList live;
+  for (const auto& entry : m_rTable) {
+    for (const auto& nh : entry.getNexthopList()) {
+      live.emplace_back(entry.getDestination(), nh);
+    }
+  }
+  RouteList dryRun;
+  for (const auto& entry : m_dryTable) {
+    for (const auto& nh : entry.getNexthopList()) {
+      dryRun.emplace_back(entry.getDestination(), nh);
+    }
+  }
+
+  const auto& map = m_lsdb.getRouterMap();
+  LinkStateInput settings = makeLinkStateInput(map, m_confParam);
+  // the cost of the shortest path through each neighbor, with the advertised costs
+  LinkStateInput reference = settings;
+  reference.isMultipath = true;
+  reference.hasLoopFreeAlternates = false;
+
+  std::vector<std::pair<std::string, LocalCostOverlay>> calculators;
+  calculators.emplace_back("link-state", LocalCostOverlay{});
+  if (m_linkCostManager != nullptr) {
+    calculators.emplace_back("load-aware", m_linkCostManager->getLocalCostOverlay());
+  }
+  if (m_mlAdaptiveCalculator) {
+    calculators.emplace_back("ml-adaptive", m_mlAdaptiveCalculator->getCostOverlay());
+  }
+
+  if (!m_calcWorker) {
+    m_calcWorker = std::make_unique<boost::asio::thread_pool>(1);
+  }
+  m_isShadowCalculationRunning = true;
+  boost::asio::post(*m_calcWorker,
+    [this, settings = std::move(settings), reference = std::move(reference),
+     calculators = std::move(calculators), live = std::move(live), dryRun = std::move(dryRun),
+     snapshot = m_lsdb.getSnapshot(), &io = m_lsdb.getIoContext(),
+     token = std::weak_ptr<int>(m_lifetimeToken)] () mutable {
+      // the graph does not depend on the costs of this router's links, which are applied later
+      buildLinkStateGraph(reference, *snapshot);
+      std::vector<std::pair<std::string, RouteList>> results;
+      for (auto& [calculator, costs] : calculators) {
+        LinkStateInput input = settings;
+        input.graph = reference.graph;
+        input.localCosts = std::move(costs);
+        results.emplace_back(calculator, calculateLinkStateRoutes(std::move(input)).nextHops);
+      }
+      if (!dryRun.empty()) {
+        results.emplace_back("hyperbolic", std::move(dryRun));
+      }
+      auto referenceRoutes = calculateLinkStateRoutes(std::move(reference)).nextHops;
+
+      boost::asio::post(io,
+        [this, token, live = std::move(live), results = std::move(results),
+         referenceRoutes = std::move(referenceRoutes)] {
+          if (token.expired()) {
+            return;
+          }
+          m_isShadowCalculationRunning = false;
+          m_shadowComparison.compare("live", live, live, referenceRoutes);
+          for (const auto& [calculator, routes] : results) {
+            m_shadowComparison.compare(calculator, routes, live, referenceRoutes);
+          }
+        });
+    });
+}
+
+void
+RoutingTable::calculateWhatIf(const WhatIfQuery& query,
+                              std::function<void(const WhatIfResult&)> onDone)
+{
+  LinkStateInput input = makeLinkStateInput(m_lsdb.getRouterMap(), m_confParam);
+  input.failedNeighbors = m_failedNeighbors;
+  if (m_confParam.getMLAdaptiveRouting() && m_mlAdaptiveCalculator) {
+    input.localCosts = m_mlAdaptiveCalculator->getCostOverlay();
   }
+  else if (m_confParam.getLoadAwareRouting() && m_linkCostManager != nullptr) {
+    input.localCosts = m_linkCostManager->getLocalCostOverlay();
+  }
+
+  if (!m_calcWorker) {
+    m_calcWorker = std::make_unique<boost::asio::thread_pool>(1);
+  }
+  boost::asio::post(*m_calcWorker,
+    [input = std::move(input), query, onDone = std::move(onDone),
+     snapshot = m_lsdb.getSnapshot(), &io = m_lsdb.getIoContext(),
+     token = std::weak_ptr<int>(m_lifetimeToken)] () mutable {
+      auto result = nlsr::calculateWhatIf(std::move(input), *snapshot, query);
+      boost::asio::post(io,
+        [token, onDone = std::move(onDone), result = std::move(result)] {
+          if (!token.expired()) {
+            onDone(result);
+          }
+        });
+    });
 }
 
 void
 RoutingTable::scheduleRoutingTableCalculation()
 {
   if (!m_isRouteCalculationScheduled) {
-    NLSR_LOG_DEBUG("Scheduling routing table calculation in " << m_routingCalcInterval);
-    m_scheduler.schedule(m_routingCalcInterval, [this] { calculate(); });
+    auto delay = getRoutingCalcDelay();
+    NLSR_LOG_DEBUG("Scheduling routing table calculation in " << delay);
+    m_scheduler.schedule(delay, [this] { calculate(); });
     m_isRouteCalculationScheduled = true;
   }
 }
 
-static bool
-routingTableEntryCompare(RoutingTableEntry& rte, ndn::Name& destRouter)
+ndn::time::milliseconds
+RoutingTable::getRoutingCalcDelay()
 {
-  return rte.getDestination() == destRouter;
+  // read at each calculation, so that a reload retunes it
+  ndn::time::milliseconds maxWait = ndn::time::seconds(m_confParam.getRoutingCalcInterval());
+  if (!m_confParam.getRoutingCalcThrottle()) {
+    return maxWait;
+  }
+
+  auto now = ndn::time::steady_clock::now();
+  ndn::time::milliseconds initialDelay(m_confParam.getRoutingCalcInitialDelay());
+
+  if (!m_lastCalculationTime || now - *m_lastCalculationTime >= 2 * maxWait) {
+    // Nothing happened for a while: react quickly, and restart the back-off.
+    m_routingCalcHoldTime = std::min(ndn::time::milliseconds(m_confParam.getRoutingCalcHoldTime()),
+                                     maxWait);
+    return initialDelay;
+  }
+
+  auto holdRemaining = ndn::time::duration_cast<ndn::time::milliseconds>(
+                         *m_lastCalculationTime + m_routingCalcHoldTime - now);
+  m_routingCalcHoldTime = std::min(2 * m_routingCalcHoldTime, maxWait);
+  return std::max(initialDelay, holdRemaining);
 }
 
 void
 RoutingTable::addNextHop(const ndn::Name& destRouter, NextHop& nh)
 {
   NLSR_LOG_DEBUG("Adding " << nh << " for destination: " << destRouter);
-
-  RoutingTableEntry* rteChk = findRoutingTableEntry(destRouter);
-  if (rteChk == nullptr) {
-    RoutingTableEntry rte(destRouter);
-    rte.getNexthopList().addNextHop(nh);
-    m_rTable.push_back(rte);
-  }
-  else {
-    rteChk->getNexthopList().addNextHop(nh);
-  }
-  m_wire.reset();
+  addNextHopToTable(m_rTable, m_rTableIndex, destRouter, nh);
 }
 
 RoutingTableEntry*
 RoutingTable::findRoutingTableEntry(const ndn::Name& destRouter)
 {
-  auto it = std::find_if(m_rTable.begin(), m_rTable.end(),
-                         std::bind(&routingTableEntryCompare, _1, destRouter));
-  if (it != m_rTable.end()) {
-    return &(*it);
+  auto it = m_rTableIndex.find(destRouter);
+  if (it != m_rTableIndex.end()) {
+    return &(*it->second);
   }
   return nullptr;
 }
 
+void
+RoutingTable::addLinkStateRoutes(const LinkStateRoutes& routes)
+{
+  for (const auto& [destRouter, nh] : routes.nextHops) {
+    NLSR_LOG_DEBUG("Adding " << nh << " for destination: " << destRouter);
+    addNextHopToTable(m_rTable, m_rTableIndex, destRouter, nh);
+  }
+  for (const auto& [destRouter, nh] : routes.alternates) {
+    addAlternateNextHop(destRouter, nh);
+  }
+}
+
+void
+RoutingTable::addAlternateNextHop(const ndn::Name& destRouter, const NextHop& nh)
+{
+  NLSR_LOG_DEBUG("Adding alternate " << nh << " for destination: " << destRouter);
+  m_alternates[destRouter].addNextHop(nh);
+}
+
+void
+RoutingTable::calculateWithoutNeighbor(const ndn::Name& neighbor)
+{
+  if (m_hyperbolicState == HYPERBOLIC_STATE_ON || m_confParam.getLoadAwareRouting() ||
+      m_confParam.getMLAdaptiveRouting()) {
+    return;
+  }
+
+  if (std::find(m_failedNeighbors.begin(), m_failedNeighbors.end(), neighbor) ==
+      m_failedNeighbors.end()) {
+    m_failedNeighbors.push_back(neighbor);
+  }
+  if (!m_ownAdjLsaExist || m_isRoutingTableCalculating) {
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Neighbor " << neighbor << " is down, calculating without its links at once");
+  if (m_tracer != nullptr) {
+    m_tracer->record(ConvergenceStage::CALCULATION);
+  }
+  m_isRoutingTableCalculating = true;
+  calculateLsRoutingTable();
+  m_isRoutingTableCalculating = false;
+}
+
+size_t
+RoutingTable::repairRoutesThrough(const ndn::Name& neighbor)
+{
+  auto& adjacencies = m_confParam.getAdjacencyList();
+  auto adjacent = adjacencies.findAdjacent(neighbor);
+  if (adjacent == adjacencies.end()) {
+    return 0;
+  }
+
+  InternedFaceUri faceUri(adjacent->getFaceUri());
+  auto isThroughNeighbor = [&faceUri] (const NextHop& nh) {
+    return nh.getInternedFaceUri() == faceUri;
+  };
+
+  size_t nRepaired = 0;
+  for (auto& entry : m_rTable) {
+    NexthopList& hops = entry.getNexthopList();
+    if (std::none_of(hops.begin(), hops.end(), isThroughNeighbor)) {
+      continue;
+    }
+
+    NexthopList repaired;
+    for (const auto& nh : hops) {
+      if (!isThroughNeighbor(nh)) {
+        repaired.addNextHop(nh);
+      }
+    }
+    if (repaired.size() == 0) {
+      auto alternates = m_alternates.find(entry.getDestination());
+      if (alternates != m_alternates.end()) {
+        for (const auto& nh : alternates->second) {
+          if (!isThroughNeighbor(nh)) {
+            repaired.addNextHop(nh);
+          }
+        }
+      }
+    }
+    // Without any other next hop, keep the route until the next calculation.
+    if (repaired.size() == 0) {
+      continue;
+    }
+
+    NLSR_LOG_DEBUG("Repairing " << entry.getDestination() << " around " << neighbor);
+    hops = repaired;
+    ++nRepaired;
+  }
+
+  if (nRepaired > 0) {
+    m_wire.reset();
+    publishRoutingChange();
+  }
+  return nRepaired;
+}
+
 void
 RoutingTable::addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh)
 {
   NLSR_LOG_DEBUG("Adding " << nh << " to dry table for destination: " << destRouter);
+  addNextHopToTable(m_dryTable, m_dryTableIndex, destRouter, nh);
+}
 
-  auto it = std::find_if(m_dryTable.begin(), m_dryTable.end(),
-                         std::bind(&routingTableEntryCompare, _1, destRouter));
-  if (it == m_dryTable.end()) {
-    RoutingTableEntry rte(destRouter);
-    rte.getNexthopList().addNextHop(nh);
-    m_dryTable.push_back(rte);
-  }
-  else {
-    it->getNexthopList().addNextHop(nh);
+void
+RoutingTable::addNextHopToTable(std::list<RoutingTableEntry>& table, EntryIndex& index,
+                                const ndn::Name& destRouter, const NextHop& nh)
+{
+  auto [it, isNew] = index.try_emplace(destRouter);
+  if (isNew) {
+    // Entries stay in insertion order in the list, so that wireEncode is deterministic.
+    it->second = table.emplace(table.end(), destRouter);
   }
+  it->second->getNexthopList().addNextHop(nh);
   m_wire.reset();
 }
 
@@ -341,6 +864,8 @@ void
 RoutingTable::clearRoutingTable()
 {
   m_rTable.clear();
+  m_rTableIndex.clear();
+  m_alternates.clear();
   m_wire.reset();
 }
 
@@ -348,9 +873,45 @@ void
 RoutingTable::clearDryRoutingTable()
 {
   m_dryTable.clear();
+  m_dryTableIndex.clear();
   m_wire.reset();
 }
 
+void
+RoutingTable::publishRoutingChange()
+{
+  CalculationProfile::Scope scope(m_calculationProfile, CalculationProfile::PHASE_PUBLISH);
+  afterRoutingChange(m_rTable);
+
+  RoutingTableDelta delta;
+  std::unordered_map<ndn::Name, NexthopList> newTable;
+  newTable.reserve(m_rTable.size());
+  for (const auto& entry : m_rTable) {
+    auto it = m_publishedTable.find(entry.getDestination());
+    if (it == m_publishedTable.end()) {
+      delta.added.push_back(entry);
+    }
+    else {
+      if (it->second != entry.getNexthopList()) {
+        delta.changed.push_back(entry);
+      }
+      m_publishedTable.erase(it);
+    }
+    newTable.emplace(entry.getDestination(), entry.getNexthopList());
+  }
+  for (const auto& [destination, nexthops] : m_publishedTable) {
+    delta.removed.push_back(destination);
+  }
+  m_publishedTable = std::move(newTable);
+
+  NLSR_LOG_DEBUG("Routing table delta: " << delta.added.size() << " added, " <<
+                 delta.changed.size() << " changed, " << delta.removed.size() << " removed");
+  if (!delta.empty()) {
+    afterRoutingDelta(delta);
+  }
+  m_isShadowCalculationDue = m_confParam.getRoutingCalcShadow();
+}
+
 // 其余方法保持不变...
 template<ndn::encoding::Tag TAG>
 size_t
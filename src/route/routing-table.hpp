@@ -11,12 +11,21 @@
 #include "routing-table-entry.hpp"
 #include "signals.hpp"
 #include "lsdb.hpp"
+#include "route/calculation-profile.hpp"
 #include "route/fib.hpp"
 #include "test-access-control.hpp"
 #include "route/name-prefix-table.hpp"
+#include "route/routing-calculator.hpp"
+#include "route/shadow-comparison.hpp"
+#include "route/shortest-path.hpp"
+#include "route/topology.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
+
+#include <boost/asio/thread_pool.hpp>
 #include <memory>
+#include <optional>
+#include <unordered_map>
 
 namespace nlsr {
 
@@ -26,6 +35,26 @@ class LoadAwareRoutingCalculator;
 class MLAdaptiveCalculator;  // 注意：类名要与ml-adaptive-calculator.hpp中一致
 class Nlsr;
 class LinkCostManager;
+class WhatIfQuery;
+class WhatIfResult;
+
+/*! \brief Difference between two consecutively published routing tables.
+ */
+struct RoutingTableDelta
+{
+  bool
+  empty() const
+  {
+    return added.empty() && changed.empty() && removed.empty();
+  }
+
+  /// Destinations that were not in the previous table, with their next hops.
+  std::list<RoutingTableEntry> added;
+  /// Destinations whose next hops changed, with their new next hops.
+  std::list<RoutingTableEntry> changed;
+  /// Destinations that are no longer in the table.
+  std::list<ndn::Name> removed;
+};
 
 class RoutingTableStatus
 {
@@ -94,9 +123,116 @@ public:
   RoutingTableEntry*
   findRoutingTableEntry(const ndn::Name& destRouter);
 
+  /*! \brief Adds the next hops and alternates found by a link-state calculation.
+   */
+  void
+  addLinkStateRoutes(const LinkStateRoutes& routes);
+
+  /*! \brief Records a loop-free alternate next hop toward \p destRouter .
+
+    Alternates are not part of the routing table; repairRoutesThrough() falls back to them.
+   */
+  void
+  addAlternateNextHop(const ndn::Name& destRouter, const NextHop& nh);
+
+  /*! \brief Moves routes off a neighbor that was declared INACTIVE, without recalculating.
+
+    Next hops through \p neighbor are removed from the destinations that have other next hops.
+    A destination reachable only through \p neighbor switches to its loop-free alternates, if
+    it has any. The next calculation replaces the repaired routes.
+    \return The number of destinations whose next hops changed.
+   */
+  size_t
+  repairRoutesThrough(const ndn::Name& neighbor);
+
+  /*! \brief Recalculates the link-state routes at once without the links to \p neighbor ,
+             which was declared INACTIVE, see routing-calc-neighbor-down.
+
+    The links stay left out of the link-state calculations until our new Adjacency LSA is
+    installed, so that the FIB is updated before that Adjacency LSA is built and flooded.
+    Hyperbolic, load-aware and ML-adaptive routing are left to their regular calculations.
+   */
+  void
+  calculateWithoutNeighbor(const ndn::Name& neighbor);
+
+  const std::vector<ndn::Name>&
+  getFailedNeighbors() const
+  {
+    return m_failedNeighbors;
+  }
+
   void
   scheduleRoutingTableCalculation();
 
+  TopologyExporter&
+  getTopologyExporter()
+  {
+    return m_topologyExporter;
+  }
+
+  const TopologyExporter&
+  getTopologyExporter() const
+  {
+    return m_topologyExporter;
+  }
+
+  CalculationProfile&
+  getCalculationProfile()
+  {
+    return m_calculationProfile;
+  }
+
+  const CalculationProfile&
+  getCalculationProfile() const
+  {
+    return m_calculationProfile;
+  }
+
+  /*! \brief Returns the ML-adaptive calculator, or nullptr before the first ML-adaptive calculation.
+   */
+  const MLAdaptiveCalculator*
+  getMLAdaptiveCalculator() const
+  {
+    return m_mlAdaptiveCalculator.get();
+  }
+
+  /*! \brief Follows a change of load-aware-routing or ml-adaptive-routing.
+   *
+   * The calculator of the routing mode in use is created, and registered as the cost policy
+   * of the LinkCostManager. The other calculators are destroyed, so that the link costs of a
+   * disabled mode go back to the RTT-based ones. ml-adaptive-routing takes precedence.
+   * The result of a running link-state calculation is dropped.
+   */
+  void
+  updateCostCalculators();
+
+  /*! \brief Returns the comparisons of the other calculators with the live routes, see
+             routing-calc-shadow.
+   */
+  const ShadowComparison&
+  getShadowComparison() const
+  {
+    return m_shadowComparison;
+  }
+
+  /*! \brief Calculates on the worker thread the routes of the scenarios of \p query , and
+             compares them with the routes without the changes, see nlsr::calculateWhatIf().
+
+    Like the live link-state routes, the calculation uses the link costs of the configured
+    calculator and leaves out the neighbors declared INACTIVE. It does not touch the routing
+    table. \p onDone is called on the io thread, unless the table is destroyed first.
+   */
+  void
+  calculateWhatIf(const WhatIfQuery& query, std::function<void(const WhatIfResult&)> onDone);
+
+  /*! \brief Record the start of each calculation in \p tracer ; nullptr to stop tracing.
+   */
+  void
+  setConvergenceTracer(ConvergenceTracer* tracer)
+  {
+    m_tracer = tracer;
+  }
+
 private:
   void
   calculateLsRoutingTable();
@@ -104,12 +240,30 @@ private:
   void
   calculateHypRoutingTable(bool isDryRun);
 
+  /*! \brief Replaces the dry-run table with the next hops of a hyperbolic calculation.
+   */
   void
-  clearRoutingTable();
+  setDryRoutingTable(const RouteList& routes);
+
+  /*! \brief Starts a link-state calculation on the worker thread, see routing-calc-async.
+
+    At most one calculation runs at a time. A request made meanwhile is remembered, and
+    serviced with a fresh snapshot once the running calculation ends.
+   */
+  void
+  calculateLsRoutingTableAsync();
 
   void
   clearDryRoutingTable();
 
+  using EntryIndex = std::unordered_map<ndn::Name, std::list<RoutingTableEntry>::iterator>;
+
+  /*! \brief Adds a next hop to the entry of \p destRouter in \p table , creating it if needed.
+   */
+  void
+  addNextHopToTable(std::list<RoutingTableEntry>& table, EntryIndex& index,
+                    const ndn::Name& destRouter, const NextHop& nh);
+
   // ✅ 负载感知路由计算方法（已有）
   void
   calculateLoadAwareRoutingTable();
@@ -118,8 +272,36 @@ private:
   void
   calculateMLAdaptiveRoutingTable();
 
+  /*! \brief Schedules the precomputation of the routes of the next ML time slot.
+
+    With ml-route-precompute, the link costs of the next time slot of the ML time patterns
+    are forecast shortly before the slot begins. If they differ from the current costs, the
+    routes for them are calculated on the worker thread, and installed when the slot begins
+    if the LSDB is unchanged and the live costs confirm the forecast.
+   */
+  void
+  scheduleRoutePrecomputation();
+
+  void
+  precomputeNextSlotRoutes();
+
+  void
+  installPrecomputedRoutes();
+
+  /*! \brief Calculates on the worker thread the routes of the other calculators, and compares
+             them with the live routes, see routing-calc-shadow.
+
+    The link-state calculators only differ by the costs of this router's links: the
+    advertised costs, the local costs of load-aware routing, and the costs predicted by the
+    ML-adaptive calculator once it exists. Hyperbolic routing is represented by the dry-run
+    table. A calculation is skipped while the previous one runs.
+   */
+  void
+  calculateShadowRoutes();
+
 public:
   AfterRoutingChange afterRoutingChange;
+  AfterRoutingDelta afterRoutingDelta;
 
   void setLinkCostManager(LinkCostManager* linkCostManager) {
     m_linkCostManager = linkCostManager;
@@ -132,7 +314,9 @@ private:
   ConfParameter& m_confParam;
   
   int32_t m_hyperbolicState;
-  ndn::time::seconds m_routingCalcInterval; 
+  /// Current hold time of the calculation throttle.
+  ndn::time::milliseconds m_routingCalcHoldTime;
+  std::optional<ndn::time::steady_clock::time_point> m_lastCalculationTime;
   bool m_isRoutingTableCalculating;
   bool m_isRouteCalculationScheduled;
   bool m_ownAdjLsaExist;
@@ -144,8 +328,79 @@ private:
   std::unique_ptr<LoadAwareRoutingCalculator> m_loadAwareCalculator;
   std::unique_ptr<MLAdaptiveCalculator> m_mlAdaptiveCalculator;  // 注意类名
 
+  /// Shortest-path trees of the previous link-state calculation, for incremental SPF.
+  SpfState m_spfState;
+
+  /// Hyperbolic distances of the previous calculations, dropped per Coordinate LSA change.
+  HyperbolicDistanceCache m_hyperbolicDistances;
+
+  TopologyExporter m_topologyExporter;
+  CalculationProfile m_calculationProfile;
+  ConvergenceTracer* m_tracer = nullptr;
+
+  /// Position of each destination in m_rTable and m_dryTable.
+  EntryIndex m_rTableIndex;
+  EntryIndex m_dryTableIndex;
+
+  /// Worker thread of asynchronous calculations, created on first use.
+  std::unique_ptr<boost::asio::thread_pool> m_calcWorker;
+  /// Lets completion handlers queued on the io_context detect that the table is gone.
+  std::shared_ptr<int> m_lifetimeToken = std::make_shared<int>(0);
+
+  /// Loop-free alternates of each destination, from the last link-state calculation.
+  std::unordered_map<ndn::Name, NexthopList> m_alternates;
+
+  /// Neighbors declared INACTIVE since our Adjacency LSA was last installed.
+  std::vector<ndn::Name> m_failedNeighbors;
+
+  /// Next hops of every destination at the last publishRoutingChange().
+  std::unordered_map<ndn::Name, NexthopList> m_publishedTable;
+
+  /// Incremented on every LSDB change, to detect routes calculated from an outdated LSDB.
+  uint64_t m_lsdbVersion = 0;
+
+  struct PrecomputedRoutes;
+  /// Routes of the next ML time slot, see scheduleRoutePrecomputation().
+  std::unique_ptr<PrecomputedRoutes> m_precomputedRoutes;
+  ndn::scheduler::ScopedEventId m_precomputeEvent;
+  bool m_isPrecomputationScheduled = false;
+
+  ShadowComparison m_shadowComparison;
+  /// The live routes were published since the last shadow calculation.
+  bool m_isShadowCalculationDue = false;
+  bool m_isShadowCalculationRunning = false;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   // 测试访问控制成员保持不变
+  void
+  clearRoutingTable();
+
+  /*! \brief Returns how long to wait before the calculation being scheduled.
+
+    Without routing-calc-throttle, this is routing-calc-interval. Otherwise, the first
+    change after a quiet period waits routing-calc-initial-delay; later calculations wait
+    for a hold time after the previous one, which doubles up to routing-calc-interval.
+   */
+  ndn::time::milliseconds
+  getRoutingCalcDelay();
+  /*! \brief Notifies listeners that the routing table was recalculated.
+
+    Emits afterRoutingChange with the whole table, then afterRoutingDelta with the
+    destinations that differ from the previous publication.
+   */
+  void
+  publishRoutingChange();
+
+  /*! \brief Installs the routes of an asynchronous calculation, unless they are outdated.
+
+    Outdated routes are dropped, and the routing table is calculated again.
+   */
+  void
+  onAsyncCalculationDone(const LinkStateRoutes& routes);
+
+  bool m_isAsyncCalculationRunning = false;
+  /// The LSDB or the routing mode changed while the calculation was running.
+  bool m_isAsyncCalculationPending = false;
 };
 
 } // namespace nlsr
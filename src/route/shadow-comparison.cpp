@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shadow-comparison.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <map>
+
+namespace nlsr {
+
+namespace {
+
+/**
+ * @brief Returns the next hop of lowest cost toward each destination of @p routes .
+ */
+std::map<ndn::Name, NextHop>
+getBestNextHops(const RouteList& routes)
+{
+  std::map<ndn::Name, NextHop> best;
+  for (const auto& [destination, nextHop] : routes) {
+    auto [it, isNew] = best.try_emplace(destination, nextHop);
+    if (!isNew && std::make_pair(nextHop.getRouteCost(), nextHop.getInternedFaceUri()) <
+                  std::make_pair(it->second.getRouteCost(), it->second.getInternedFaceUri())) {
+      it->second = nextHop;
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+void
+ShadowComparison::compare(const std::string& calculator, const RouteList& routes,
+                          const RouteList& live, const RouteList& reference)
+{
+  auto status = std::find_if(m_status.begin(), m_status.end(),
+                             [&] (const auto& s) { return s.calculator == calculator; });
+  if (status == m_status.end()) {
+    status = m_status.insert(m_status.end(), Status{calculator});
+  }
+  ++status->nCalculations;
+
+  auto bestLive = getBestNextHops(live);
+  auto best = getBestNextHops(routes);
+  status->nDestinations = bestLive.size();
+  status->nNextHopDisagreements = 0;
+  for (const auto& [destination, nextHop] : bestLive) {
+    auto it = best.find(destination);
+    if (it == best.end() || it->second.getInternedFaceUri() != nextHop.getInternedFaceUri()) {
+      ++status->nNextHopDisagreements;
+    }
+  }
+
+  // cost of the shortest path through each neighbor, and of the shortest path overall
+  std::map<std::pair<ndn::Name, InternedFaceUri>, double> costThrough;
+  std::map<ndn::Name, double> shortest;
+  for (const auto& [destination, nextHop] : reference) {
+    costThrough.try_emplace({destination, nextHop.getInternedFaceUri()}, nextHop.getRouteCost());
+    auto [it, isNew] = shortest.try_emplace(destination, nextHop.getRouteCost());
+    it->second = std::min(it->second, nextHop.getRouteCost());
+  }
+  double sumStretch = 0.0;
+  size_t nStretches = 0;
+  status->maxStretch = 1.0;
+  for (const auto& [destination, nextHop] : best) {
+    auto through = costThrough.find({destination, nextHop.getInternedFaceUri()});
+    auto it = shortest.find(destination);
+    if (through == costThrough.end() || it == shortest.end() || it->second <= 0.0) {
+      continue;
+    }
+    double stretch = through->second / it->second;
+    sumStretch += stretch;
+    ++nStretches;
+    status->maxStretch = std::max(status->maxStretch, stretch);
+  }
+  status->meanStretch = nStretches > 0 ? sumStretch / nStretches : 1.0;
+
+  std::set<std::pair<ndn::Name, InternedFaceUri>> nextHops;
+  for (const auto& [destination, nextHop] : routes) {
+    nextHops.emplace(destination, nextHop.getInternedFaceUri());
+  }
+  auto& previous = m_nextHops[calculator];
+  std::vector<std::pair<ndn::Name, InternedFaceUri>> changes;
+  std::set_symmetric_difference(previous.begin(), previous.end(),
+                                nextHops.begin(), nextHops.end(), std::back_inserter(changes));
+  status->nNextHopChanges += changes.size();
+  previous = std::move(nextHops);
+}
+
+} // namespace nlsr
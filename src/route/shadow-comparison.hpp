@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_SHADOW_COMPARISON_HPP
+#define NLSR_ROUTE_SHADOW_COMPARISON_HPP
+
+#include "route/interned-face-uri.hpp"
+#include "route/routing-calculator.hpp"
+
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace nlsr {
+
+/**
+ * @brief Compares the routes of the calculators that are not in use with the live routes,
+ *        see routing-calc-shadow.
+ *
+ * For each calculator, a comparison measures against the live routes:
+ *  - next-hop disagreement: live destinations whose best next hop differs, or that the
+ *    calculator does not reach;
+ *  - path stretch: cost, with the advertised link costs, of the best path through the best
+ *    next hop of the calculator, over the cost of the shortest path;
+ *  - churn: next hops added or removed since the previous routes of the same calculator,
+ *    i.e. the FIB updates the calculator would have caused.
+ */
+class ShadowComparison
+{
+public:
+  struct Status
+  {
+    std::string calculator;
+    uint64_t nCalculations = 0;
+    /// live destinations, at the last comparison
+    size_t nDestinations = 0;
+    /// live destinations with another best next hop or unreached, at the last comparison
+    size_t nNextHopDisagreements = 0;
+    /// over the destinations reached by both, at the last comparison
+    double meanStretch = 1.0;
+    double maxStretch = 1.0;
+    /// next hops added or removed, since start
+    uint64_t nNextHopChanges = 0;
+  };
+
+  /**
+   * @brief Compare the routes of @p calculator with the live routes.
+   * @param reference Multipath link-state routes with the advertised link costs, which give
+   *                  the cost of the shortest path through each neighbor.
+   */
+  void
+  compare(const std::string& calculator, const RouteList& routes, const RouteList& live,
+          const RouteList& reference);
+
+  /**
+   * @brief Returns the status of each calculator, in the order of their first comparison.
+   */
+  const std::vector<Status>&
+  getStatus() const
+  {
+    return m_status;
+  }
+
+private:
+  std::vector<Status> m_status;
+  /// next hops of the previous routes of each calculator
+  std::unordered_map<std::string, std::set<std::pair<ndn::Name, InternedFaceUri>>> m_nextHops;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_SHADOW_COMPARISON_HPP
@@ -0,0 +1,363 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shortest-path.hpp"
+
+#include <boost/assert.hpp>
+
+#include <functional>
+#include <queue>
+
+namespace nlsr {
+
+namespace {
+
+/**
+ * @brief Indexed binary min-heap of router mapping numbers keyed by tentative distance.
+ *
+ * Every router is present in the heap from the start; its position is tracked so that a
+ * relaxed distance can be applied in O(log N) via decreaseKey(). Ties are broken by the
+ * lower mapping number, which keeps the visiting order deterministic.
+ */
+class DistanceHeap
+{
+public:
+  DistanceHeap(const std::vector<LinkCost>& distance, std::pmr::memory_resource* memory)
+    : m_distance(distance)
+    , m_heap(distance.size(), memory)
+    , m_position(distance.size(), memory)
+  {
+    for (size_t i = 0; i < m_heap.size(); ++i) {
+      m_heap[i] = static_cast<int>(i);
+      m_position[i] = i;
+    }
+    for (size_t i = m_heap.size() / 2; i-- > 0;) {
+      siftDown(i);
+    }
+  }
+
+  bool
+  empty() const
+  {
+    return m_heap.empty();
+  }
+
+  int
+  top() const
+  {
+    return m_heap.front();
+  }
+
+  void
+  pop()
+  {
+    swapNodes(0, m_heap.size() - 1);
+    m_heap.pop_back();
+    if (!m_heap.empty()) {
+      siftDown(0);
+    }
+  }
+
+  /**
+   * @brief Restore heap order after the distance of @p router has been lowered.
+   */
+  void
+  decreaseKey(int router)
+  {
+    siftUp(m_position[router]);
+  }
+
+private:
+  bool
+  isLess(int a, int b) const
+  {
+    return m_distance[a] < m_distance[b] || (m_distance[a] == m_distance[b] && a < b);
+  }
+
+  void
+  swapNodes(size_t i, size_t j)
+  {
+    std::swap(m_heap[i], m_heap[j]);
+    m_position[m_heap[i]] = i;
+    m_position[m_heap[j]] = j;
+  }
+
+  void
+  siftUp(size_t i)
+  {
+    while (i > 0) {
+      size_t parent = (i - 1) / 2;
+      if (!isLess(m_heap[i], m_heap[parent])) {
+        break;
+      }
+      swapNodes(i, parent);
+      i = parent;
+    }
+  }
+
+  void
+  siftDown(size_t i)
+  {
+    size_t n = m_heap.size();
+    while (true) {
+      size_t smallest = i;
+      size_t left = 2 * i + 1;
+      size_t right = left + 1;
+      if (left < n && isLess(m_heap[left], m_heap[smallest])) {
+        smallest = left;
+      }
+      if (right < n && isLess(m_heap[right], m_heap[smallest])) {
+        smallest = right;
+      }
+      if (smallest == i) {
+        break;
+      }
+      swapNodes(i, smallest);
+      i = smallest;
+    }
+  }
+
+private:
+  const std::vector<LinkCost>& m_distance;
+  std::pmr::vector<int> m_heap;
+  std::pmr::vector<size_t> m_position;
+};
+
+} // anonymous namespace
+
+ShortestPathTree
+calculateShortestPathTree(const LinkStateGraph& graph, int32_t root, LinkCost rootDistance,
+                          int32_t excluded, std::pmr::memory_resource* scratch)
+{
+  size_t nRouters = graph.size();
+  ShortestPathTree tree;
+  tree.parent.assign(nRouters, ShortestPathTree::NO_PARENT);
+  // Array where the ith element is the distance to the router with mapping no i.
+  tree.distance.assign(nRouters, ShortestPathTree::INF_DISTANCE);
+  // Routers whose shortest distance is final.
+  std::pmr::vector<bool> visited(nRouters, false, scratch);
+
+  if (excluded != NO_EXCLUDED_ROUTER) {
+    visited[excluded] = true;
+  }
+  tree.distance[root] = rootDistance;
+  DistanceHeap heap(tree.distance, scratch);
+
+  // While we haven't visited every node.
+  while (!heap.empty()) {
+    int u = heap.top(); // Closest router that has not been visited yet.
+    if (tree.distance[u] == ShortestPathTree::INF_DISTANCE) {
+      break; // This can only happen when there are no accessible nodes.
+    }
+    heap.pop();
+    visited[u] = true;
+
+    // Iterate over the adjacent nodes to u.
+    auto neighbors = graph.getNeighbors(u);
+    auto costs = graph.getCosts(u);
+    for (size_t i = 0; i < neighbors.size(); ++i) {
+      int v = neighbors[i];
+      // If we haven't visited v yet, and if the distance to u + from u to v
+      // is less than the distance from the root to v found so far
+      if (!visited[v]) {
+        LinkCost newDistance = addDistance(tree.distance[u], costs[i]);
+        if (newDistance < tree.distance[v]) {
+          // Set the new distance
+          tree.distance[v] = newDistance;
+          // Set how we get there.
+          tree.parent[v] = u;
+          heap.decreaseKey(v);
+        }
+        else if (newDistance == tree.distance[v] && u < tree.parent[v]) {
+          tree.parent[v] = u;
+        }
+      }
+    }
+  }
+
+  return tree;
+}
+
+size_t
+updateShortestPathTree(ShortestPathTree& tree, const LinkStateGraph& oldGraph,
+                       const LinkStateGraph& newGraph, int32_t root, LinkCost rootDistance,
+                       int32_t excluded, std::pmr::memory_resource* scratch)
+{
+  BOOST_ASSERT(oldGraph.size() == newGraph.size());
+  BOOST_ASSERT(tree.distance.size() == newGraph.size());
+  BOOST_ASSERT(tree.distance[root] == rootDistance);
+
+  size_t nRouters = newGraph.size();
+  auto& parent = tree.parent;
+  auto& distance = tree.distance;
+
+  struct CostChange
+  {
+    int32_t from;
+    int32_t to;
+    LinkCost cost;
+  };
+  // routers whose tree link got worse or disappeared
+  std::pmr::vector<int32_t> brokenChildren(scratch);
+  // directed links that got cheaper or appeared
+  std::pmr::vector<CostChange> improved(scratch);
+
+  // Compare the sorted neighbor lists of both graphs.
+  for (int32_t u = 0; u < static_cast<int32_t>(nRouters); ++u) {
+    auto oldNeighbors = oldGraph.getNeighbors(u);
+    auto oldCosts = oldGraph.getCosts(u);
+    auto newNeighbors = newGraph.getNeighbors(u);
+    auto newCosts = newGraph.getCosts(u);
+
+    size_t i = 0, j = 0;
+    while (i < oldNeighbors.size() || j < newNeighbors.size()) {
+      int32_t v = 0;
+      LinkCost newCost = 0;
+      bool isWorse = false;
+      bool isBetter = false;
+      if (j == newNeighbors.size() || (i < oldNeighbors.size() && oldNeighbors[i] < newNeighbors[j])) {
+        v = oldNeighbors[i++];
+        isWorse = true;
+      }
+      else if (i == oldNeighbors.size() || newNeighbors[j] < oldNeighbors[i]) {
+        v = newNeighbors[j];
+        newCost = newCosts[j++];
+        isBetter = true;
+      }
+      else {
+        v = newNeighbors[j];
+        newCost = newCosts[j];
+        isWorse = newCosts[j] > oldCosts[i];
+        isBetter = newCosts[j] < oldCosts[i];
+        ++i;
+        ++j;
+      }
+
+      if (isWorse && parent[v] == u) {
+        brokenChildren.push_back(v);
+      }
+      else if (isBetter) {
+        improved.push_back({u, v, newCost});
+      }
+    }
+  }
+
+  if (brokenChildren.empty() && improved.empty()) {
+    return 0;
+  }
+
+  // Invalidate every subtree hanging below a worsened tree link.
+  // the inner vectors are given the same memory
+  std::pmr::vector<std::pmr::vector<int32_t>> children(nRouters, scratch);
+  for (size_t v = 0; v < nRouters; ++v) {
+    if (parent[v] != ShortestPathTree::NO_PARENT) {
+      children[parent[v]].push_back(static_cast<int32_t>(v));
+    }
+  }
+
+  std::pmr::vector<bool> isInvalid(nRouters, false, scratch);
+  std::pmr::vector<int32_t> invalid(scratch);
+  for (int32_t child : brokenChildren) {
+    if (isInvalid[child]) {
+      continue;
+    }
+    isInvalid[child] = true;
+    invalid.push_back(child);
+    for (size_t k = invalid.size() - 1; k < invalid.size(); ++k) {
+      for (int32_t grandChild : children[invalid[k]]) {
+        if (!isInvalid[grandChild]) {
+          isInvalid[grandChild] = true;
+          invalid.push_back(grandChild);
+        }
+      }
+    }
+  }
+  for (int32_t v : invalid) {
+    parent[v] = ShortestPathTree::NO_PARENT;
+    distance[v] = ShortestPathTree::INF_DISTANCE;
+  }
+
+  using QueueItem = std::pair<LinkCost, int32_t>;
+  std::priority_queue<QueueItem, std::pmr::vector<QueueItem>, std::greater<QueueItem>>
+    queue{std::greater<QueueItem>(), std::pmr::vector<QueueItem>(scratch)};
+  std::pmr::vector<bool> isTouched(nRouters, false, scratch);
+  size_t nTouched = invalid.size();
+  for (int32_t v : invalid) {
+    isTouched[v] = true;
+  }
+
+  auto relax = [&] (int32_t u, int32_t v, LinkCost cost) {
+    if (v == excluded || v == root || distance[u] == ShortestPathTree::INF_DISTANCE) {
+      return;
+    }
+    LinkCost newDistance = addDistance(distance[u], cost);
+    if (newDistance < distance[v]) {
+      distance[v] = newDistance;
+      queue.emplace(newDistance, v);
+    }
+    else if (newDistance != distance[v] || u >= parent[v]) {
+      return;
+    }
+    // on equal distances, the lower mapping number, as in calculateShortestPathTree()
+    parent[v] = u;
+    if (!isTouched[v]) {
+      isTouched[v] = true;
+      ++nTouched;
+    }
+  };
+
+  // Re-attach invalidated routers to the best remaining valid neighbor.
+  for (int32_t v : invalid) {
+    auto neighbors = newGraph.getNeighbors(v);
+    auto costs = newGraph.getCosts(v);
+    for (size_t k = 0; k < neighbors.size(); ++k) {
+      int32_t u = neighbors[k];
+      if (!isInvalid[u] && u != excluded) {
+        relax(u, v, costs[k]);
+      }
+    }
+  }
+
+  // Links that improved may shorten paths through them.
+  for (const auto& change : improved) {
+    if (change.from != excluded) {
+      relax(change.from, change.to, change.cost);
+    }
+  }
+
+  // Settle the affected routers in distance order.
+  while (!queue.empty()) {
+    auto [d, u] = queue.top();
+    queue.pop();
+    if (d != distance[u]) {
+      continue; // stale queue item
+    }
+    auto neighbors = newGraph.getNeighbors(u);
+    auto costs = newGraph.getCosts(u);
+    for (size_t k = 0; k < neighbors.size(); ++k) {
+      relax(u, neighbors[k], costs[k]);
+    }
+  }
+
+  return nTouched;
+}
+
+} // namespace nlsr
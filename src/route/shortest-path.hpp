@@ -0,0 +1,128 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_SHORTEST_PATH_HPP
+#define NLSR_ROUTE_SHORTEST_PATH_HPP
+
+#include "link-state-graph.hpp"
+
+#include <limits>
+#include <map>
+#include <memory_resource>
+#include <vector>
+
+namespace nlsr {
+
+/**
+ * @brief Shortest-path tree rooted at one router of a LinkStateGraph.
+ *
+ * Both vectors are indexed by mapping number. The root and unreachable routers have
+ * @c NO_PARENT as parent; unreachable routers have @c INF_DISTANCE as distance. Among the
+ * routers that a router is reached through at equal distance, its parent is the one with the
+ * lowest mapping number, so that a tree does not depend on how it was computed.
+ */
+struct ShortestPathTree
+{
+  static constexpr int32_t NO_PARENT = -12345;
+  static constexpr LinkCost INF_DISTANCE = std::numeric_limits<LinkCost>::max();
+  /// Longer distances are saturated to it, so that a router far away is not unreachable.
+  static constexpr LinkCost MAX_DISTANCE = INF_DISTANCE - 1;
+
+  std::vector<int32_t> parent;
+  std::vector<LinkCost> distance;
+};
+
+/**
+ * @brief Add a link cost to a distance, saturating at @c ShortestPathTree::MAX_DISTANCE .
+ */
+inline LinkCost
+addDistance(LinkCost distance, LinkCost cost)
+{
+  constexpr LinkCost MAX = ShortestPathTree::MAX_DISTANCE;
+  return distance < MAX && cost < MAX - distance ? distance + cost : MAX;
+}
+
+/**
+ * @brief Indicates that no router is excluded from a shortest-path computation.
+ */
+constexpr int32_t NO_EXCLUDED_ROUTER = -1;
+
+/**
+ * @brief Compute a shortest-path tree with Dijkstra's algorithm.
+ * @param graph Router graph.
+ * @param root Root of the tree.
+ * @param rootDistance Distance assigned to the root, e.g. the cost of reaching it.
+ * @param excluded Router that paths may not traverse, or @c NO_EXCLUDED_ROUTER .
+ * @param scratch Memory of the temporary arrays, which are not used after returning, such as
+ *                an arena of the calculation; the tree itself is on the heap.
+ *
+ * Among equal-distance routers, the one with the lower mapping number is visited first.
+ */
+ShortestPathTree
+calculateShortestPathTree(const LinkStateGraph& graph, int32_t root, LinkCost rootDistance = 0,
+                          int32_t excluded = NO_EXCLUDED_ROUTER,
+                          std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+/**
+ * @brief Update a shortest-path tree after the graph changed (incremental SPF).
+ * @param tree Tree computed on @p oldGraph with the same @p root , @p rootDistance and
+ *             @p excluded ; it is updated in place to be a shortest-path tree of @p newGraph .
+ * @param oldGraph Graph @p tree was computed on.
+ * @param newGraph New graph; it must have the same routers as @p oldGraph .
+ * @param scratch Memory of the temporary arrays, as for calculateShortestPathTree().
+ * @return Number of routers whose distance or parent was recomputed.
+ *
+ * Only the subtrees hanging below links whose cost increased or that disappeared are
+ * invalidated; they and the endpoints of links whose cost decreased are then re-settled.
+ * The tree is identical to a full computation, parents included.
+ */
+size_t
+updateShortestPathTree(ShortestPathTree& tree, const LinkStateGraph& oldGraph,
+                       const LinkStateGraph& newGraph, int32_t root, LinkCost rootDistance = 0,
+                       int32_t excluded = NO_EXCLUDED_ROUTER,
+                       std::pmr::memory_resource* scratch = std::pmr::get_default_resource());
+
+/**
+ * @brief Results of the previous link-state calculation, kept to allow incremental SPF.
+ */
+struct SpfState
+{
+  struct RootedTree
+  {
+    LinkCost rootDistance;
+    ShortestPathTree tree;
+  };
+
+  /// Router names in mapping number order when the trees were computed.
+  std::vector<ndn::Name> routers;
+  /// Graph the trees were computed on.
+  LinkStateGraph graph;
+  /// Mapping number of the source router.
+  int32_t source = NO_EXCLUDED_ROUTER;
+  /// Whether the trees are per-neighbor multipath trees.
+  bool isMultipath = false;
+  /// Trees keyed by their root.
+  std::map<int32_t, RootedTree> trees;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_SHORTEST_PATH_HPP
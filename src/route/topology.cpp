@@ -3,14 +3,18 @@
 
 #include "logger.hpp" // 用于 NLSR_LOG_ERROR
 #include "conf-parameter.hpp" // 用于获取 state-dir
+#include "route/link-state-graph.hpp"
 #include "route/name-map.hpp" // 用于 NameMap
-#include "adjacent.hpp" // 用于 Adjacent::NON_ADJACENT_COST
+#include "tlv-nlsr.hpp"
 
 #include <ndn-cxx/name.hpp>
 #include "topology.hpp"
+#include <ndn-cxx/encoding/block-helpers.hpp>
+#include <boost/container_hash/hash.hpp>
 #include <fstream>   // 用于 std::ofstream
 #include <sstream>   // 用于 std::ostringstream
 #include <filesystem> // 用于 std::filesystem (C++17, 标准3)
+#include <set>
 #include <stdexcept> // 用于 std::exception
 
 namespace nlsr {
@@ -18,75 +22,387 @@ namespace nlsr {
 INIT_LOGGER(route.TopologyExporter);
 
 void
-exportTopology(const AdjMatrix& matrix, const NameMap& map, 
-               const ConfParameter& confParam)
+TopologyStatus::setTopology(const LinkStateGraph& graph, std::vector<ndn::Name> routers)
+{
+  m_routers = std::move(routers);
+  m_links.clear();
+  m_links.reserve(graph.getNumEdges() / 2);
+  for (size_t i = 0; i < graph.size(); ++i) {
+    auto neighbors = graph.getNeighbors(static_cast<int32_t>(i));
+    auto costs = graph.getCosts(static_cast<int32_t>(i));
+    for (size_t k = 0; k < neighbors.size(); ++k) {
+      if (static_cast<size_t>(neighbors[k]) > i) {
+        m_links.push_back({i, static_cast<uint64_t>(neighbors[k]), fromLinkCost(costs[k])});
+      }
+    }
+  }
+  m_wire.reset();
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+TopologyStatus::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto it = m_links.rbegin(); it != m_links.rend(); ++it) {
+    size_t linkLength = 0;
+    linkLength += prependDoubleBlock(block, nlsr::tlv::Cost, it->cost);
+    linkLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::LinkTarget, it->target);
+    linkLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::LinkSource, it->source);
+    linkLength += block.prependVarNumber(linkLength);
+    linkLength += block.prependVarNumber(nlsr::tlv::TopologyLink);
+    totalLength += linkLength;
+  }
+
+  for (auto it = m_routers.rbegin(); it != m_routers.rend(); ++it) {
+    totalLength += it->wireEncode(block);
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::Topology);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(TopologyStatus);
+
+const ndn::Block&
+TopologyStatus::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  m_wire = buffer.block();
+
+  return m_wire;
+}
+
+void
+TopologyStatus::wireDecode(const ndn::Block& wire)
+{
+  m_routers.clear();
+  m_links.clear();
+
+  m_wire = wire;
+
+  if (m_wire.type() != nlsr::tlv::Topology) {
+    NDN_THROW(Error("Topology", m_wire.type()));
+  }
+
+  m_wire.parse();
+  auto val = m_wire.elements_begin();
+
+  for (; val != m_wire.elements_end() && val->type() == ndn::tlv::Name; ++val) {
+    m_routers.emplace_back(*val);
+  }
+
+  for (; val != m_wire.elements_end() && val->type() == nlsr::tlv::TopologyLink; ++val) {
+    val->parse();
+    const auto& elements = val->elements();
+    if (elements.size() != 3 ||
+        elements[0].type() != nlsr::tlv::LinkSource ||
+        elements[1].type() != nlsr::tlv::LinkTarget ||
+        elements[2].type() != nlsr::tlv::Cost) {
+      NDN_THROW(Error("Malformed TopologyLink"));
+    }
+
+    Link link{ndn::encoding::readNonNegativeInteger(elements[0]),
+              ndn::encoding::readNonNegativeInteger(elements[1]),
+              ndn::encoding::readDouble(elements[2])};
+    if (link.source >= m_routers.size() || link.target >= m_routers.size()) {
+      NDN_THROW(Error("TopologyLink refers to an unknown router"));
+    }
+    m_links.push_back(link);
+  }
+
+  if (val != m_wire.elements_end()) {
+    NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(val->type()) + " in Topology"));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const TopologyStatus& status)
+{
+  const auto& routers = status.getRouters();
+  os << "Topology: " << routers.size() << " routers, " << status.getLinks().size() << " links\n";
+  for (const auto& link : status.getLinks()) {
+    os << "  " << routers[link.source] << " -- " << routers[link.target]
+       << " cost " << link.cost << "\n";
+  }
+  return os;
+}
+
+TopologyExporter::TopologyExporter(const ConfParameter& confParam,
+                                   ndn::time::milliseconds minInterval)
+  : m_confParam(confParam)
+  , m_minInterval(minInterval)
+{
+}
+
+TopologyExporter::~TopologyExporter()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_cv.notify_one();
+  if (m_thread.joinable()) {
+    m_thread.join();
+  }
+}
+
+bool
+TopologyExporter::publish(const LinkStateGraph& graph, const NameMap& map)
+{
+  size_t hash = hashTopology(graph, map);
+  if (m_lastHash == hash) {
+    NLSR_LOG_TRACE("Topology unchanged, not exporting it");
+    return false;
+  }
+  m_lastHash = hash;
+
+  Snapshot snapshot{m_confParam.getStateFileDir(), {}, graph};
+  snapshot.routers.reserve(map.size());
+  for (size_t i = 0; i < map.size(); ++i) {
+    snapshot.routers.push_back(map.getRouterNameByMappingNo(static_cast<int32_t>(i)).value_or(ndn::Name()));
+  }
+
+  m_status.setTopology(graph, snapshot.routers);
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending = std::move(snapshot);
+    if (!m_thread.joinable()) {
+      m_thread = std::thread([this] { run(); });
+    }
+  }
+  m_cv.notify_one();
+  return true;
+}
+
+size_t
+TopologyExporter::hashTopology(const LinkStateGraph& graph, const NameMap& map)
+{
+  size_t seed = map.size();
+  for (size_t i = 0; i < map.size(); ++i) {
+    auto name = map.getRouterNameByMappingNo(static_cast<int32_t>(i));
+    boost::hash_combine(seed, name ? std::hash<ndn::Name>{}(*name) : 0);
+  }
+  for (size_t i = 0; i < graph.size(); ++i) {
+    auto neighbors = graph.getNeighbors(static_cast<int32_t>(i));
+    auto costs = graph.getCosts(static_cast<int32_t>(i));
+    boost::hash_combine(seed, neighbors.size());
+    boost::hash_range(seed, neighbors.begin(), neighbors.end());
+    boost::hash_range(seed, costs.begin(), costs.end());
+  }
+  return seed;
+}
+
+void
+TopologyExporter::run()
+{
+  std::optional<std::chrono::steady_clock::time_point> lastWrite;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cv.wait(lock, [this] { return m_pending || m_isStopping; });
+    // Rate limit; topologies published while waiting replace the pending one.
+    if (lastWrite) {
+      auto nextWrite = *lastWrite + std::chrono::milliseconds(m_minInterval.count());
+      m_cv.wait_until(lock, nextWrite, [this] { return m_isStopping; });
+    }
+    if (m_isStopping) {
+      return;
+    }
+
+    Snapshot snapshot = std::move(*m_pending);
+    m_pending.reset();
+    lock.unlock();
+    writeTopology(std::move(snapshot));
+    lastWrite = std::chrono::steady_clock::now();
+    lock.lock();
+  }
+}
+
+std::string
+TopologyExporter::formatTopology(const Snapshot& snapshot, uint64_t version)
+{
+  std::ostringstream jsonStream;
+  size_t nRouters = snapshot.routers.size();
+
+  // 步骤 2: 构建JSON字符串
+  jsonStream << "{\n  \"version\": " << version << ",\n  \"nodes\": [\n";
+
+  // A. 转换 NameMap (字典) 为 "nodes" 列表
+  for (size_t i = 0; i < nRouters; ++i) {
+    jsonStream << "    {\"id\": " << i << ", \"name\": \"" << snapshot.routers[i].toUri() << "\"}";
+    if (i < nRouters - 1) {
+      jsonStream << ",\n";
+    }
+  }
+  jsonStream << "\n  ],\n";
+
+  // B. 转换 LinkStateGraph (地图) 为 "links" 列表
+  jsonStream << "  \"links\": [\n";
+  bool firstLink = true;
+
+  // 图是无向的：每条链路只输出一次 (target > source)
+  const auto& graph = snapshot.graph;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    auto neighbors = graph.getNeighbors(static_cast<int32_t>(i));
+    auto costs = graph.getCosts(static_cast<int32_t>(i));
+    for (size_t k = 0; k < neighbors.size(); ++k) {
+      size_t j = static_cast<size_t>(neighbors[k]);
+      if (j <= i) {
+        continue;
+      }
+      if (!firstLink) {
+        jsonStream << ",\n";
+      }
+      jsonStream << "    {\"source\": " << i << ", \"target\": " << j << ", \"cost\": " << fromLinkCost(costs[k]) << "}";
+      firstLink = false;
+    }
+  }
+  jsonStream << "\n  ]\n}"; // JSON 结束
+  return jsonStream.str();
+}
+
+TopologyExporter::LinkMap
+TopologyExporter::collectLinks(const Snapshot& snapshot)
+{
+  LinkMap links;
+  const auto& graph = snapshot.graph;
+  for (size_t i = 0; i < graph.size(); ++i) {
+    auto neighbors = graph.getNeighbors(static_cast<int32_t>(i));
+    auto costs = graph.getCosts(static_cast<int32_t>(i));
+    for (size_t k = 0; k < neighbors.size(); ++k) {
+      const auto& a = snapshot.routers[i];
+      const auto& b = snapshot.routers[neighbors[k]];
+      if (a < b) {
+        links.emplace(std::make_pair(a, b), fromLinkCost(costs[k]));
+      }
+    }
+  }
+  return links;
+}
+
+std::vector<std::string>
+TopologyExporter::diffTopology(const Snapshot& from, const Snapshot& to, uint64_t version)
+{
+  std::vector<std::string> lines;
+  auto addLine = [&] (const char* change, const auto&... fields) {
+    std::ostringstream os;
+    os << version << ' ' << change;
+    ((os << ' ' << fields), ...);
+    lines.push_back(os.str());
+  };
+
+  std::set<ndn::Name> oldRouters(from.routers.begin(), from.routers.end());
+  std::set<ndn::Name> newRouters(to.routers.begin(), to.routers.end());
+  for (const auto& router : newRouters) {
+    if (oldRouters.count(router) == 0) {
+      addLine("router-add", router);
+    }
+  }
+
+  auto oldLinks = collectLinks(from);
+  auto newLinks = collectLinks(to);
+  for (const auto& [link, cost] : oldLinks) {
+    auto it = newLinks.find(link);
+    if (it == newLinks.end()) {
+      addLine("link-remove", link.first, link.second);
+    }
+    else if (it->second != cost) {
+      addLine("link-cost", link.first, link.second, it->second);
+    }
+  }
+  for (const auto& [link, cost] : newLinks) {
+    if (oldLinks.count(link) == 0) {
+      addLine("link-add", link.first, link.second, cost);
+    }
+  }
+
+  // Routers are removed last, once their links are gone.
+  for (const auto& router : oldRouters) {
+    if (newRouters.count(router) == 0) {
+      addLine("router-remove", router);
+    }
+  }
+  return lines;
+}
+
+void
+TopologyExporter::writeTopology(Snapshot snapshot)
 {
   // 步骤 1: 确定写入路径 (基于 nlsr.conf 中的 state-dir)
-  std::filesystem::path stateDir = confParam.getStateFileDir();
+  std::filesystem::path stateDir = snapshot.stateDir;
   std::filesystem::path topologyPath = stateDir / "topology.json";
   std::filesystem::path tempPath = stateDir / "topology.json.tmp";
+  std::filesystem::path logPath = stateDir / "topology.log";
 
   try {
-    std::ostringstream jsonStream;
-    size_t nRouters = map.size();
-
-    // 步骤 2: 构建JSON字符串
-    jsonStream << "{\n  \"nodes\": [\n";
-
-    // A. 转换 NameMap (字典) 为 "nodes" 列表
-    for (size_t i = 0; i < nRouters; ++i) {
-      auto nameOpt = map.getRouterNameByMappingNo(static_cast<int32_t>(i));
-      if (nameOpt) {
-        jsonStream << "    {\"id\": " << i << ", \"name\": \"" << nameOpt->toUri() << "\"}";
-        if (i < nRouters - 1) {
-          jsonStream << ",\n";
-        }
+    size_t snapshotSize = snapshot.routers.size() + snapshot.graph.getNumEdges() / 2;
+
+    if (m_lastWritten && m_lastWritten->stateDir == snapshot.stateDir) {
+      auto lines = diffTopology(*m_lastWritten, snapshot, m_version + 1);
+      if (lines.empty()) {
+        // Only the mapping numbers changed
+        return;
       }
-    }
-    jsonStream << "\n  ],\n";
-
-    // B. 转换 AdjMatrix (地图) 为 "links" 列表
-    jsonStream << "  \"links\": [\n";
-    bool firstLink = true;
-
-    // 优化：只遍历上三角 (j = i + 1)，因为矩阵是对称的
-    for (size_t i = 0; i < nRouters; ++i) {
-      for (size_t j = i + 1; j < nRouters; ++j) {
-        
-        double cost = matrix[i][j];
-
-        // 检查链路是否真实存在 (成本不是 "INF")
-        if (cost != Adjacent::NON_ADJACENT_COST) {
-          if (!firstLink) {
-            jsonStream << ",\n";
-          }
-          jsonStream << "    {\"source\": " << i << ", \"target\": " << j << ", \"cost\": " << cost << "}";
-          firstLink = false;
+      if (m_nLogLines + lines.size() < snapshotSize) {
+        ++m_version;
+        std::ofstream logFile(logPath, std::ios::out | std::ios::app);
+        if (!logFile.is_open()) {
+          throw std::runtime_error("Cannot open topology log: " + logPath.string());
+        }
+        for (const auto& line : lines) {
+          logFile << line << '\n';
         }
+        logFile.close();
+        if (!logFile) {
+          throw std::runtime_error("Cannot write topology log: " + logPath.string());
+        }
+        m_nLogLines += lines.size();
+        m_lastWritten = std::move(snapshot);
+        return;
       }
     }
-    jsonStream << "\n  ]\n}"; // JSON 结束
+
+    ++m_version;
 
     // 步骤 3: 原子性写入文件
-    
+
     // A. 写入临时文件
     std::ofstream tempFile(tempPath, std::ios::out | std::ios::trunc);
     if (!tempFile.is_open()) {
         throw std::runtime_error("Cannot open temporary file: " + tempPath.string());
     }
-    tempFile << jsonStream.str();
+    tempFile << formatTopology(snapshot, m_version);
     tempFile.close();
 
     // B. 原子性重命名 (调包)
     std::filesystem::rename(tempPath, topologyPath);
 
+    // The log lines are all older than the new snapshot.
+    std::ofstream(logPath, std::ios::out | std::ios::trunc);
+    m_nLogLines = 0;
+    m_lastWritten = std::move(snapshot);
   }
   catch (const std::exception& e) {
     // 步骤 4: 故障隔离 (标准5)
     // 我们不希望导出失败导致路由计算崩溃。
     NLSR_LOG_ERROR("Failed to export topology: " << e.what());
     // 安静地失败，不抛出异常
+    // The next topology is written in full.
+    m_lastWritten.reset();
   }
 }
 
-} // namespace nlsr
\ No newline at end of file
+} // namespace nlsr
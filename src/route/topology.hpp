@@ -4,10 +4,18 @@
 #define NLSR_TOPOLOGY_HPP
 
 #include "common.hpp"
-#include <boost/multi_array.hpp>
+#include "route/link-state-graph.hpp"
+#include "test-access-control.hpp"
 
-// 运行Dijkstra算法所需的邻接矩阵
-using AdjMatrix = boost::multi_array<double, 2>;
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
 
 namespace nlsr {
 
@@ -16,18 +24,178 @@ class NameMap;
 class ConfParameter;
 
 /**
- * @brief 将当前的网络拓扑（邻接矩阵和名称映射）导出为JSON文件。
+ * @brief Router graph of the last link-state calculation, as served by the topology dataset.
+ *
+ *     Topology = TOPOLOGY-TYPE TLV-LENGTH
+ *                  *Name ; routers, the n-th one has index n
+ *                  *TopologyLink
  *
- * @param matrix 完整的N x N邻接矩阵 (地图)
- * @param map NameMap (字典)
- * @param confParam NLSR配置参数 (用于获取state-dir)
+ *     TopologyLink = TOPOLOGY-LINK-TYPE TLV-LENGTH
+ *                      LinkSource ; router index, NonNegativeInteger
+ *                      LinkTarget ; router index, NonNegativeInteger
+ *                      Cost       ; double
  *
+ * Each link appears once, with its source index lower than its target index.
+ */
+class TopologyStatus
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  struct Link
+  {
+    uint64_t source;
+    uint64_t target;
+    double cost;
+  };
+
+  TopologyStatus() = default;
+
+  explicit
+  TopologyStatus(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  const std::vector<ndn::Name>&
+  getRouters() const
+  {
+    return m_routers;
+  }
+
+  const std::vector<Link>&
+  getLinks() const
+  {
+    return m_links;
+  }
+
+  void
+  setTopology(const LinkStateGraph& graph, std::vector<ndn::Name> routers);
 
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  /**
+   * @brief Return the encoding, which is kept until the topology changes.
+   */
+  const ndn::Block&
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+private:
+  std::vector<ndn::Name> m_routers;
+  std::vector<Link> m_links;
+  mutable ndn::Block m_wire;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const TopologyStatus& status);
+
+/**
+ * @brief 将当前的网络拓扑（路由器图和名称映射）导出为JSON文件 (state-dir/topology.json)。
+ *
+ * Only hashing the topology happens on the calling thread. An unchanged topology is not
+ * written again; otherwise a copy is handed to a background thread, which writes it at most
+ * once per minimum interval. Topologies published meanwhile replace each other, so only the
+ * latest one is written.
+ *
+ * Each written topology gets the next version number. Its differences from the previous one
+ * are appended to state-dir/topology.log, one change per line:
+ *
+ *     <version> router-add <router>
+ *     <version> router-remove <router>
+ *     <version> link-add <router> <router> <cost>
+ *     <version> link-remove <router> <router>
+ *     <version> link-cost <router> <router> <cost>
+ *
+ * The full snapshot in topology.json, which carries its version, is rewritten only once the
+ * log has as many lines as the snapshot has routers and links; the log then restarts empty.
+ * A consumer reads the snapshot, then applies the log lines newer than the snapshot version.
  */
-void
-exportTopology(const AdjMatrix& matrix, const NameMap& map, 
-               const ConfParameter& confParam);
+class TopologyExporter
+{
+public:
+  explicit
+  TopologyExporter(const ConfParameter& confParam,
+                   ndn::time::milliseconds minInterval = ndn::time::seconds(1));
+
+  ~TopologyExporter();
+
+  /**
+   * @brief Queue a write of the topology, unless it is the one published last.
+   * @param graph 由邻接LSA构建的路由器图 (地图)
+   * @param map NameMap (字典)
+   * @return whether a write was queued
+   */
+  bool
+  publish(const LinkStateGraph& graph, const NameMap& map);
+
+  /**
+   * @brief Return the topology published last.
+   */
+  const TopologyStatus&
+  getStatus() const
+  {
+    return m_status;
+  }
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  struct Snapshot
+  {
+    std::string stateDir;
+    std::vector<ndn::Name> routers;
+    LinkStateGraph graph;
+  };
+
+  static std::string
+  formatTopology(const Snapshot& snapshot, uint64_t version);
+
+  /**
+   * @brief Return the log lines turning @p from into @p to .
+   */
+  static std::vector<std::string>
+  diffTopology(const Snapshot& from, const Snapshot& to, uint64_t version);
+
+private:
+  using LinkMap = std::map<std::pair<ndn::Name, ndn::Name>, double>;
+
+  /**
+   * @brief Return the cost of each link, by router names in ascending order.
+   */
+  static LinkMap
+  collectLinks(const Snapshot& snapshot);
+
+  static size_t
+  hashTopology(const LinkStateGraph& graph, const NameMap& map);
+
+  /// Accessed by the exporter thread only.
+  void
+  writeTopology(Snapshot snapshot);
+
+  void
+  run();
+
+private:
+  const ConfParameter& m_confParam;
+  const ndn::time::milliseconds m_minInterval;
+  std::optional<size_t> m_lastHash;
+  TopologyStatus m_status;
+
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  std::optional<Snapshot> m_pending;
+  bool m_isStopping = false;
+  std::thread m_thread;
+
+  // Exporter thread state
+  std::optional<Snapshot> m_lastWritten;
+  uint64_t m_version = 0;
+  size_t m_nLogLines = 0;
+};
 
 } // namespace nlsr
 
-#endif // NLSR_TOPOLOGY_EXPORTER_HPP
\ No newline at end of file
+#endif // NLSR_TOPOLOGY_HPP
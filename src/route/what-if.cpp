@@ -0,0 +1,453 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "what-if.hpp"
+#include "logger.hpp"
+#include "tlv-nlsr.hpp"
+#include "lsa/name-lsa.hpp"
+#include "route/shortest-path.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+
+namespace nlsr {
+
+INIT_LOGGER(route.WhatIf);
+
+namespace {
+
+using RouteMap = std::map<ndn::Name, NexthopList>;
+
+RouteMap
+makeRouteMap(const RouteList& routes)
+{
+  RouteMap table;
+  for (const auto& [destination, nextHop] : routes) {
+    table[destination].addNextHop(nextHop);
+  }
+  return table;
+}
+
+void
+applyChange(LinkStateInput& input, const WhatIfChange& change)
+{
+  auto router = input.map.getMappingNoByRouterName(change.router);
+  if (!router) {
+    return;
+  }
+
+  if (change.type == WhatIfChange::Type::ROUTER_DOWN) {
+    // removing a link modifies the neighbors
+    auto neighbors = input.graph.getNeighbors(*router);
+    std::vector<int32_t> links(neighbors.begin(), neighbors.end());
+    for (auto neighbor : links) {
+      input.graph.removeLink(*router, neighbor);
+    }
+    return;
+  }
+
+  auto neighbor = input.map.getMappingNoByRouterName(change.neighbor);
+  if (!neighbor) {
+    return;
+  }
+
+  // The overlays override the graph for the links of this router.
+  const ndn::Name* other = nullptr;
+  if (change.router == input.routerPrefix) {
+    other = &change.neighbor;
+  }
+  else if (change.neighbor == input.routerPrefix) {
+    other = &change.router;
+  }
+
+  if (change.type == WhatIfChange::Type::LINK_DOWN) {
+    if (other != nullptr) {
+      input.failedNeighbors.push_back(*other);
+    }
+    else {
+      input.graph.removeLink(*router, *neighbor);
+    }
+  }
+  else if (other != nullptr) {
+    auto& costs = input.localCosts;
+    costs.erase(std::remove_if(costs.begin(), costs.end(),
+                               [other] (const auto& cost) { return cost.first == *other; }),
+                costs.end());
+    costs.emplace_back(*other, change.cost);
+  }
+  else {
+    input.graph.setCost(*router, *neighbor, change.cost);
+  }
+}
+
+WhatIfOutcome
+compareRoutes(const RouteMap& before, const RouteMap& after,
+              const std::unordered_map<ndn::Name, size_t>& nPrefixes)
+{
+  auto countPrefixes = [&nPrefixes] (const ndn::Name& router) -> size_t {
+    auto it = nPrefixes.find(router);
+    return it == nPrefixes.end() ? 0 : it->second;
+  };
+
+  WhatIfOutcome outcome;
+  for (const auto& [destination, nexthops] : after) {
+    auto it = before.find(destination);
+    if (it != before.end() && it->second == nexthops) {
+      continue;
+    }
+    RoutingTableEntry entry(destination);
+    entry.getNexthopList() = nexthops;
+    (it == before.end() ? outcome.delta.added : outcome.delta.changed).push_back(entry);
+    outcome.nAffectedPrefixes += countPrefixes(destination);
+  }
+  for (const auto& [destination, nexthops] : before) {
+    if (after.count(destination) == 0) {
+      outcome.delta.removed.push_back(destination);
+      outcome.nAffectedPrefixes += countPrefixes(destination);
+      outcome.nUnreachablePrefixes += countPrefixes(destination);
+    }
+  }
+  return outcome;
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+prependChange(ndn::EncodingImpl<TAG>& block, const WhatIfChange& change)
+{
+  size_t length = 0;
+  if (change.type == WhatIfChange::Type::LINK_COST) {
+    length += prependDoubleBlock(block, nlsr::tlv::Cost, change.cost);
+  }
+  if (change.type != WhatIfChange::Type::ROUTER_DOWN) {
+    length += prependNestedBlock(block, nlsr::tlv::Neighbor, change.neighbor);
+  }
+  length += change.router.wireEncode(block);
+  length += prependNonNegativeIntegerBlock(block, nlsr::tlv::ChangeType,
+                                           static_cast<uint64_t>(change.type));
+  length += block.prependVarNumber(length);
+  length += block.prependVarNumber(nlsr::tlv::WhatIfChange);
+  return length;
+}
+
+WhatIfChange
+decodeChange(const ndn::Block& wire)
+{
+  wire.parse();
+  auto val = wire.elements_begin();
+
+  WhatIfChange change;
+  if (val == wire.elements_end() || val->type() != nlsr::tlv::ChangeType) {
+    NDN_THROW(WhatIfQuery::Error("Missing required ChangeType field"));
+  }
+  auto type = ndn::encoding::readNonNegativeInteger(*val);
+  if (type > static_cast<uint64_t>(WhatIfChange::Type::ROUTER_DOWN)) {
+    NDN_THROW(WhatIfQuery::Error("Unknown ChangeType " + ndn::to_string(type)));
+  }
+  change.type = static_cast<WhatIfChange::Type>(type);
+  ++val;
+
+  if (val == wire.elements_end() || val->type() != ndn::tlv::Name) {
+    NDN_THROW(WhatIfQuery::Error("Missing required Name field"));
+  }
+  change.router.wireDecode(*val);
+  ++val;
+
+  if (change.type != WhatIfChange::Type::ROUTER_DOWN) {
+    if (val == wire.elements_end() || val->type() != nlsr::tlv::Neighbor) {
+      NDN_THROW(WhatIfQuery::Error("Missing required Neighbor field"));
+    }
+    change.neighbor.wireDecode(val->blockFromValue());
+    ++val;
+  }
+  if (change.type == WhatIfChange::Type::LINK_COST) {
+    if (val == wire.elements_end() || val->type() != nlsr::tlv::Cost) {
+      NDN_THROW(WhatIfQuery::Error("Missing required Cost field"));
+    }
+    change.cost = ndn::encoding::readDouble(*val);
+    ++val;
+  }
+
+  if (val != wire.elements_end()) {
+    NDN_THROW(WhatIfQuery::Error("Unrecognized TLV of type " + ndn::to_string(val->type()) +
+                                 " in WhatIfChange"));
+  }
+  return change;
+}
+
+} // namespace
+
+std::ostream&
+operator<<(std::ostream& os, const WhatIfChange& change)
+{
+  switch (change.type) {
+    case WhatIfChange::Type::LINK_DOWN:
+      return os << "link-down " << change.router << " " << change.neighbor;
+    case WhatIfChange::Type::LINK_COST:
+      return os << "link-cost " << change.router << " " << change.neighbor << " " << change.cost;
+    case WhatIfChange::Type::ROUTER_DOWN:
+      return os << "router-down " << change.router;
+  }
+  return os << "unknown change";
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+WhatIfQuery::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto scenario = scenarios.rbegin(); scenario != scenarios.rend(); ++scenario) {
+    size_t scenarioLength = 0;
+    for (auto change = scenario->rbegin(); change != scenario->rend(); ++change) {
+      scenarioLength += prependChange(block, *change);
+    }
+    scenarioLength += block.prependVarNumber(scenarioLength);
+    scenarioLength += block.prependVarNumber(nlsr::tlv::WhatIfScenario);
+    totalLength += scenarioLength;
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::WhatIfQuery);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(WhatIfQuery);
+
+ndn::Block
+WhatIfQuery::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  return buffer.block();
+}
+
+void
+WhatIfQuery::wireDecode(const ndn::Block& wire)
+{
+  *this = {};
+
+  if (wire.type() != nlsr::tlv::WhatIfQuery) {
+    NDN_THROW(Error("WhatIfQuery", wire.type()));
+  }
+
+  wire.parse();
+  for (const auto& element : wire.elements()) {
+    if (element.type() != nlsr::tlv::WhatIfScenario) {
+      NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(element.type()) +
+                      " in WhatIfQuery"));
+    }
+    element.parse();
+    WhatIfScenario scenario;
+    for (const auto& change : element.elements()) {
+      if (change.type() != nlsr::tlv::WhatIfChange) {
+        NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(change.type()) +
+                        " in WhatIfScenario"));
+      }
+      scenario.push_back(decodeChange(change));
+    }
+    if (scenario.empty()) {
+      NDN_THROW(Error("WhatIfScenario without changes"));
+    }
+    scenarios.push_back(std::move(scenario));
+  }
+
+  if (scenarios.empty()) {
+    NDN_THROW(Error("WhatIfQuery without scenarios"));
+  }
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+WhatIfResult::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  for (auto outcome = outcomes.rbegin(); outcome != outcomes.rend(); ++outcome) {
+    const auto& delta = outcome->delta;
+    size_t outcomeLength = 0;
+    for (auto it = delta.removed.rbegin(); it != delta.removed.rend(); ++it) {
+      outcomeLength += prependNestedBlock(block, nlsr::tlv::RemovedDestination, *it);
+    }
+    for (auto it = delta.changed.rbegin(); it != delta.changed.rend(); ++it) {
+      outcomeLength += prependNestedBlock(block, nlsr::tlv::ChangedRoute, *it);
+    }
+    for (auto it = delta.added.rbegin(); it != delta.added.rend(); ++it) {
+      outcomeLength += prependNestedBlock(block, nlsr::tlv::AddedRoute, *it);
+    }
+    outcomeLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::UnreachablePrefixCount,
+                                                    outcome->nUnreachablePrefixes);
+    outcomeLength += prependNonNegativeIntegerBlock(block, nlsr::tlv::AffectedPrefixCount,
+                                                    outcome->nAffectedPrefixes);
+    outcomeLength += block.prependVarNumber(outcomeLength);
+    outcomeLength += block.prependVarNumber(nlsr::tlv::WhatIfOutcome);
+    totalLength += outcomeLength;
+  }
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(nlsr::tlv::WhatIfResult);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(WhatIfResult);
+
+ndn::Block
+WhatIfResult::wireEncode() const
+{
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  return buffer.block();
+}
+
+void
+WhatIfResult::wireDecode(const ndn::Block& wire)
+{
+  *this = {};
+
+  if (wire.type() != nlsr::tlv::WhatIfResult) {
+    NDN_THROW(Error("WhatIfResult", wire.type()));
+  }
+
+  wire.parse();
+  for (const auto& element : wire.elements()) {
+    if (element.type() != nlsr::tlv::WhatIfOutcome) {
+      NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(element.type()) +
+                      " in WhatIfResult"));
+    }
+    element.parse();
+    auto val = element.elements_begin();
+
+    WhatIfOutcome outcome;
+    if (val == element.elements_end() || val->type() != nlsr::tlv::AffectedPrefixCount) {
+      NDN_THROW(Error("Missing required AffectedPrefixCount field"));
+    }
+    outcome.nAffectedPrefixes = ndn::encoding::readNonNegativeInteger(*val);
+    ++val;
+    if (val == element.elements_end() || val->type() != nlsr::tlv::UnreachablePrefixCount) {
+      NDN_THROW(Error("Missing required UnreachablePrefixCount field"));
+    }
+    outcome.nUnreachablePrefixes = ndn::encoding::readNonNegativeInteger(*val);
+    ++val;
+
+    for (; val != element.elements_end() && val->type() == nlsr::tlv::AddedRoute; ++val) {
+      outcome.delta.added.emplace_back(val->blockFromValue());
+    }
+    for (; val != element.elements_end() && val->type() == nlsr::tlv::ChangedRoute; ++val) {
+      outcome.delta.changed.emplace_back(val->blockFromValue());
+    }
+    for (; val != element.elements_end() && val->type() == nlsr::tlv::RemovedDestination; ++val) {
+      outcome.delta.removed.emplace_back(val->blockFromValue());
+    }
+
+    if (val != element.elements_end()) {
+      NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(val->type()) +
+                      " in WhatIfOutcome"));
+    }
+    outcomes.push_back(std::move(outcome));
+  }
+}
+
+std::ostream&
+operator<<(std::ostream& os, const WhatIfOutcome& outcome)
+{
+  const auto& delta = outcome.delta;
+  os << delta.added.size() << " added, " << delta.changed.size() << " changed, "
+     << delta.removed.size() << " removed; " << outcome.nAffectedPrefixes
+     << " prefixes affected, " << outcome.nUnreachablePrefixes << " unreachable\n";
+  if (!delta.added.empty()) {
+    os << "Added:\n";
+    for (const auto& entry : delta.added) {
+      os << entry;
+    }
+  }
+  if (!delta.changed.empty()) {
+    os << "Changed:\n";
+    for (const auto& entry : delta.changed) {
+      os << entry;
+    }
+  }
+  if (!delta.removed.empty()) {
+    os << "Removed:\n";
+    for (const auto& destination : delta.removed) {
+      os << "  Destination: " << destination << "\n";
+    }
+  }
+  return os;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const WhatIfResult& result)
+{
+  for (size_t i = 0; i < result.outcomes.size(); ++i) {
+    os << "Scenario " << i + 1 << ": " << result.outcomes[i];
+  }
+  return os;
+}
+
+WhatIfResult
+calculateWhatIf(LinkStateInput input, const LsdbSnapshot& lsdb, const WhatIfQuery& query)
+{
+  WhatIfResult result;
+  buildLinkStateGraph(input, lsdb);
+  if (input.graph.size() == 0) {
+    NLSR_LOG_DEBUG("Source router is absent, no routes to change");
+    result.outcomes.resize(query.scenarios.size());
+    return result;
+  }
+
+  std::unordered_map<ndn::Name, size_t> nPrefixes;
+  for (const auto& lsa : lsdb.getLsas<NameLsa>()) {
+    nPrefixes[lsa->getOriginRouter()] = static_cast<const NameLsa&>(*lsa).getNpl().size();
+  }
+
+  SpfState baselineState;
+  auto baseline = makeRouteMap(calculateLinkStateRoutes(input, &baselineState).nextHops);
+
+  for (const auto& scenario : query.scenarios) {
+    LinkStateInput changed = input;
+    for (const auto& change : scenario) {
+      applyChange(changed, change);
+    }
+    // the trees of the baseline are only updated where the scenario changed the graph
+    SpfState spfState = baselineState;
+    auto routes = makeRouteMap(calculateLinkStateRoutes(std::move(changed), &spfState).nextHops);
+    result.outcomes.push_back(compareRoutes(baseline, routes, nPrefixes));
+    NLSR_LOG_DEBUG("What-if scenario of " << scenario.size() << " changes: "
+                   << result.outcomes.back().delta.added.size() << " added, "
+                   << result.outcomes.back().delta.changed.size() << " changed, "
+                   << result.outcomes.back().delta.removed.size() << " removed");
+  }
+  return result;
+}
+
+} // namespace nlsr
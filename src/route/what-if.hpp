@@ -0,0 +1,196 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_WHAT_IF_HPP
+#define NLSR_ROUTE_WHAT_IF_HPP
+
+#include "route/routing-calculator.hpp"
+#include "route/routing-table.hpp"
+
+#include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+
+#include <vector>
+
+namespace nlsr {
+
+/**
+ * @brief Hypothetical change of the topology, such as planned maintenance.
+ *
+ *     WhatIfChange = WHAT-IF-CHANGE-TYPE TLV-LENGTH
+ *                      ChangeType
+ *                      Name ; router
+ *                      [Neighbor]
+ *                      [Cost]
+ *
+ *     ChangeType = CHANGE-TYPE-TYPE TLV-LENGTH NonNegativeInteger
+ *     Neighbor = NEIGHBOR-TYPE TLV-LENGTH Name
+ *
+ * Links are changed in both directions, like the link-state graph treats them.
+ */
+struct WhatIfChange
+{
+  enum class Type {
+    /// the link between router and neighbor goes down
+    LINK_DOWN = 0,
+    /// the link between router and neighbor is given cost
+    LINK_COST = 1,
+    /// all the links of router go down
+    ROUTER_DOWN = 2,
+  };
+
+  Type type = Type::LINK_DOWN;
+  ndn::Name router;
+  /// other end of the link; unused by ROUTER_DOWN
+  ndn::Name neighbor;
+  /// LINK_COST only
+  double cost = 0.0;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const WhatIfChange& change);
+
+/**
+ * @brief Changes that are evaluated together.
+ */
+using WhatIfScenario = std::vector<WhatIfChange>;
+
+/**
+ * @brief Scenarios of a what-if request, each evaluated separately against the current
+ *        routes.
+ *
+ *     WhatIfQuery = WHAT-IF-QUERY-TYPE TLV-LENGTH
+ *                     1*WhatIfScenario
+ *
+ *     WhatIfScenario = WHAT-IF-SCENARIO-TYPE TLV-LENGTH
+ *                        1*WhatIfChange
+ */
+class WhatIfQuery
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  WhatIfQuery() = default;
+
+  explicit
+  WhatIfQuery(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+public:
+  std::vector<WhatIfScenario> scenarios;
+};
+
+/**
+ * @brief Effect of a scenario on the routing table.
+ */
+struct WhatIfOutcome
+{
+  /// destinations whose next hops would change, relative to the current routes
+  RoutingTableDelta delta;
+  /// prefixes advertised by the destinations of the delta
+  uint64_t nAffectedPrefixes = 0;
+  /// prefixes advertised by the destinations that would be unreachable
+  uint64_t nUnreachablePrefixes = 0;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const WhatIfOutcome& outcome);
+
+/**
+ * @brief Outcomes of the scenarios of a WhatIfQuery, in the same order.
+ *
+ *     WhatIfResult = WHAT-IF-RESULT-TYPE TLV-LENGTH
+ *                      *WhatIfOutcome
+ *
+ *     WhatIfOutcome = WHAT-IF-OUTCOME-TYPE TLV-LENGTH
+ *                       AffectedPrefixCount
+ *                       UnreachablePrefixCount
+ *                       *AddedRoute
+ *                       *ChangedRoute
+ *                       *RemovedDestination
+ *
+ *     AffectedPrefixCount = AFFECTED-PREFIX-COUNT-TYPE TLV-LENGTH NonNegativeInteger
+ *     UnreachablePrefixCount = UNREACHABLE-PREFIX-COUNT-TYPE TLV-LENGTH NonNegativeInteger
+ *
+ * AddedRoute, ChangedRoute and RemovedDestination are those of RoutingTableChanges.
+ */
+class WhatIfResult
+{
+public:
+  using Error = ndn::tlv::Error;
+
+  WhatIfResult() = default;
+
+  explicit
+  WhatIfResult(const ndn::Block& block)
+  {
+    wireDecode(block);
+  }
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  ndn::Block
+  wireEncode() const;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+public:
+  std::vector<WhatIfOutcome> outcomes;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const WhatIfResult& result);
+
+/**
+ * @brief Calculate the routes of each scenario of @p query , and compare them with the routes
+ *        without the changes.
+ * @param input Settings and cost overlays of the calculation, without its graph, which is
+ *              built from @p lsdb .
+ *
+ * The routes without the changes are calculated once. Each scenario then starts from a copy
+ * of their shortest-path trees, which are updated incrementally for the links it changes, so
+ * that many scenarios cost little more than one calculation each. Changes of this router's
+ * links go through the cost overlay and the failed neighbors of @p input , which override
+ * the graph.
+ *
+ * This only touches its arguments, so it may run outside of the io thread.
+ */
+WhatIfResult
+calculateWhatIf(LinkStateInput input, const LsdbSnapshot& lsdb, const WhatIfQuery& query);
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_WHAT_IF_HPP
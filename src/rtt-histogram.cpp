@@ -0,0 +1,105 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rtt-histogram.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace nlsr {
+
+size_t
+RttHistogram::getBucket(uint64_t value)
+{
+  if (value < SUB_BUCKETS) {
+    return value;
+  }
+
+  size_t magnitude = 63 - __builtin_clzll(value);
+  if (magnitude >= MAX_MAGNITUDE) {
+    return N_BUCKETS - 1;
+  }
+  size_t shift = magnitude - SUB_BUCKET_BITS;
+  size_t subBucket = (value >> shift) & (SUB_BUCKETS - 1);
+  return SUB_BUCKETS + shift * SUB_BUCKETS + subBucket;
+}
+
+uint64_t
+RttHistogram::getBucketMidpoint(size_t bucket)
+{
+  if (bucket < SUB_BUCKETS) {
+    return bucket;
+  }
+
+  size_t shift = (bucket - SUB_BUCKETS) / SUB_BUCKETS;
+  uint64_t subBucket = (bucket - SUB_BUCKETS) % SUB_BUCKETS;
+  uint64_t lower = (SUB_BUCKETS + subBucket) << shift;
+  return lower + ((uint64_t(1) << shift) >> 1);
+}
+
+void
+RttHistogram::add(ndn::time::nanoseconds rtt)
+{
+  auto us = ndn::time::duration_cast<ndn::time::microseconds>(rtt);
+  if (us.count() < 0) {
+    us = ndn::time::microseconds::zero();
+  }
+
+  ++m_buckets[getBucket(static_cast<uint64_t>(us.count()))];
+  ++m_count;
+  m_max = std::max(m_max, us);
+}
+
+void
+RttHistogram::reset()
+{
+  m_buckets.fill(0);
+  m_count = 0;
+  m_max = ndn::time::microseconds::zero();
+}
+
+ndn::time::microseconds
+RttHistogram::getQuantile(double quantile) const
+{
+  if (m_count == 0) {
+    return ndn::time::microseconds::zero();
+  }
+
+  // rank of the sample, from 1 to m_count
+  auto rank = static_cast<uint64_t>(std::ceil(std::clamp(quantile, 0.0, 1.0) * m_count));
+  rank = std::max<uint64_t>(rank, 1);
+  if (rank == m_count) {
+    return m_max;
+  }
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < N_BUCKETS; ++i) {
+    seen += m_buckets[i];
+    if (seen >= rank) {
+      // the last bucket also holds values beyond its range
+      auto midpoint = ndn::time::microseconds(getBucketMidpoint(i));
+      return std::min(midpoint, m_max);
+    }
+  }
+  return m_max;
+}
+
+} // namespace nlsr
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_RTT_HISTOGRAM_HPP
+#define NLSR_RTT_HISTOGRAM_HPP
+
+#include <ndn-cxx/util/time.hpp>
+
+#include <array>
+
+namespace nlsr {
+
+/*! \brief Fixed-memory log-linear histogram of RTT samples, after HdrHistogram.
+ *
+ * Samples are counted in microseconds. Values below SUB_BUCKETS fall into exact buckets; each
+ * larger power of two is split into SUB_BUCKETS linear buckets, so that a recorded value is
+ * within 1/SUB_BUCKETS of the sample. Values beyond the last bucket are counted in it.
+ */
+class RttHistogram
+{
+public:
+  static constexpr size_t SUB_BUCKET_BITS = 3;
+  static constexpr size_t SUB_BUCKETS = size_t(1) << SUB_BUCKET_BITS;
+  /// Largest power of two counted, 2^24 us being about 16.8 s
+  static constexpr size_t MAX_MAGNITUDE = 24;
+  static constexpr size_t N_BUCKETS = SUB_BUCKETS + (MAX_MAGNITUDE - SUB_BUCKET_BITS) * SUB_BUCKETS;
+
+  void
+  add(ndn::time::nanoseconds rtt);
+
+  /*! \brief Forget all the samples.
+   */
+  void
+  reset();
+
+  uint64_t
+  getCount() const
+  {
+    return m_count;
+  }
+
+  /*! \brief Return the RTT below which the fraction \p quantile of the samples fall.
+   *
+   * The midpoint of the bucket holding the quantile is returned, the exact maximum for the
+   * largest sample, or zero without samples.
+   */
+  ndn::time::microseconds
+  getQuantile(double quantile) const;
+
+  /*! \brief Return the exact largest sample.
+   */
+  ndn::time::microseconds
+  getMax() const
+  {
+    return m_max;
+  }
+
+private:
+  static size_t
+  getBucket(uint64_t value);
+
+  static uint64_t
+  getBucketMidpoint(size_t bucket);
+
+private:
+  std::array<uint32_t, N_BUCKETS> m_buckets{};
+  uint64_t m_count = 0;
+  ndn::time::microseconds m_max{0};
+};
+
+} // namespace nlsr
+
+#endif // NLSR_RTT_HISTOGRAM_HPP
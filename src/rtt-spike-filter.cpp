@@ -0,0 +1,107 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rtt-spike-filter.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+
+namespace {
+
+template<size_t N>
+RttSpikeFilter::Duration
+median(std::array<RttSpikeFilter::Duration, N> values, size_t size)
+{
+  auto middle = values.begin() + size / 2;
+  std::nth_element(values.begin(), middle, values.begin() + size);
+  return *middle;
+}
+
+} // namespace
+
+RttSpikeFilter::RttSpikeFilter(size_t shiftSamples)
+  : m_shiftSamples(std::clamp<size_t>(shiftSamples, 2, MAX_SHIFT_SAMPLES))
+{
+}
+
+RttSpikeFilter::Duration
+RttSpikeFilter::getMedian(const State& state)
+{
+  if (state.size == 0) {
+    return Duration::zero();
+  }
+  return median(state.window, state.size);
+}
+
+void
+RttSpikeFilter::push(State& state, Duration rtt)
+{
+  state.window[state.next] = rtt;
+  state.next = (state.next + 1) % WINDOW_SIZE;
+  state.size = std::min(state.size + 1, WINDOW_SIZE);
+}
+
+RttSpikeFilter::Verdict
+RttSpikeFilter::add(State& state, Duration rtt) const
+{
+  if (state.size < MIN_SAMPLES) {
+    push(state, rtt);
+    return Verdict::NORMAL;
+  }
+
+  Duration med = median(state.window, state.size);
+  std::array<Duration, WINDOW_SIZE> deviations{};
+  for (size_t i = 0; i < state.size; ++i) {
+    deviations[i] = state.window[i] > med ? state.window[i] - med : med - state.window[i];
+  }
+  double mad = static_cast<double>(median(deviations, state.size).count());
+  double maxDeviation = std::max(OUTLIER_THRESHOLD * 1.4826 * mad,
+                                 MIN_OUTLIER_RATIO * static_cast<double>(med.count()));
+
+  bool isAbove = rtt > med;
+  double deviation = static_cast<double>((isAbove ? rtt - med : med - rtt).count());
+  if (deviation <= maxDeviation) {
+    state.runSize = 0;
+    push(state, rtt);
+    return Verdict::NORMAL;
+  }
+
+  if (state.runSize == 0 || state.isRunAbove != isAbove) {
+    state.runSize = 0;
+    state.isRunAbove = isAbove;
+  }
+  state.run[state.runSize++] = rtt;
+  if (state.runSize < m_shiftSamples) {
+    return Verdict::SPIKE;
+  }
+
+  // sustained: the run is the new level
+  state.size = 0;
+  state.next = 0;
+  for (size_t i = 0; i < state.runSize; ++i) {
+    push(state, state.run[i]);
+  }
+  state.runSize = 0;
+  return Verdict::LEVEL_SHIFT;
+}
+
+} // namespace nlsr
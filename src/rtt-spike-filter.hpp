@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_RTT_SPIKE_FILTER_HPP
+#define NLSR_RTT_SPIKE_FILTER_HPP
+
+#include <ndn-cxx/util/time.hpp>
+
+#include <array>
+
+namespace nlsr {
+
+/*! \brief Median/MAD filter that separates transient RTT spikes from level shifts.
+ *
+ * A sample is an outlier if it deviates from the median of the recent normal samples by more
+ * than OUTLIER_THRESHOLD robust standard deviations (1.4826 times the median absolute
+ * deviation), and by more than MIN_OUTLIER_RATIO of the median, so that the jitter of a very
+ * stable link is not mistaken for spikes. An isolated outlier is a spike and should be
+ * ignored. A run of the configured number of outliers on the same side of the median is a
+ * level shift; the run then replaces the window, and the new level is accepted.
+ */
+class RttSpikeFilter
+{
+public:
+  using Duration = ndn::time::steady_clock::duration;
+
+  static constexpr size_t WINDOW_SIZE = 9;
+  static constexpr size_t MIN_SAMPLES = 5;
+  static constexpr size_t MAX_SHIFT_SAMPLES = 8;
+  static constexpr double OUTLIER_THRESHOLD = 4.0;
+  static constexpr double MIN_OUTLIER_RATIO = 0.25;
+
+  enum class Verdict {
+    NORMAL,
+    SPIKE,
+    LEVEL_SHIFT,
+  };
+
+  /*! \brief Filter state of one link.
+   */
+  struct State
+  {
+    std::array<Duration, WINDOW_SIZE> window{};
+    size_t next = 0;
+    size_t size = 0;
+    // Current run of outliers on the same side of the median
+    std::array<Duration, MAX_SHIFT_SAMPLES> run{};
+    size_t runSize = 0;
+    bool isRunAbove = false;
+  };
+
+  /*! \param shiftSamples number of consecutive outliers that make a level shift,
+   *         between 2 and MAX_SHIFT_SAMPLES
+   */
+  explicit
+  RttSpikeFilter(size_t shiftSamples);
+
+  /*! \brief Classify an RTT sample and add it to the state of its link.
+   */
+  Verdict
+  add(State& state, Duration rtt) const;
+
+  /*! \brief Return the median of the normal samples in the window, or zero if it is empty.
+   */
+  static Duration
+  getMedian(const State& state);
+
+private:
+  static void
+  push(State& state, Duration rtt);
+
+private:
+  size_t m_shiftSamples;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_RTT_SPIKE_FILTER_HPP
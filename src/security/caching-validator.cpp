@@ -0,0 +1,254 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "caching-validator.hpp"
+#include "logger.hpp"
+
+#include <ndn-cxx/security/verification-helpers.hpp>
+
+#include <boost/asio/post.hpp>
+
+namespace nlsr::security {
+
+INIT_LOGGER(CachingValidator);
+
+using ndn::security::validator_config::ValidationPolicyConfig;
+
+static std::unique_ptr<CachingValidator::ValidationCachePolicy>
+makePolicy(boost::asio::io_context& io, size_t capacity, ndn::time::nanoseconds lifetime)
+{
+  auto policy = std::make_unique<CachingValidator::ValidationCachePolicy>(io, capacity, lifetime);
+  policy->setInnerPolicy(std::make_unique<ValidationPolicyConfig>());
+  return policy;
+}
+
+CachingValidator::CachingValidator(std::unique_ptr<ndn::security::CertificateFetcher> fetcher,
+                                   boost::asio::io_context& io,
+                                   size_t capacity, ndn::time::nanoseconds lifetime)
+  : Validator(makePolicy(io, capacity, lifetime), std::move(fetcher))
+  , m_cachePolicy(static_cast<ValidationCachePolicy&>(getPolicy()))
+  , m_policyConfig(static_cast<ValidationPolicyConfig&>(getPolicy().getInnerPolicy()))
+{
+}
+
+void
+CachingValidator::load(const std::string& filename)
+{
+  m_policyConfig.load(filename);
+}
+
+void
+CachingValidator::load(const std::string& input, const std::string& filename)
+{
+  m_policyConfig.load(input, filename);
+}
+
+void
+CachingValidator::load(std::istream& input, const std::string& filename)
+{
+  m_policyConfig.load(input, filename);
+}
+
+void
+CachingValidator::load(const ndn::security::validator_config::ConfigSection& configSection,
+                       const std::string& filename)
+{
+  m_policyConfig.load(configSection, filename);
+}
+
+void
+CachingValidator::cacheValidated(const ndn::Data& data)
+{
+  m_cachePolicy.insert(data);
+}
+
+void
+CachingValidator::setVerificationThreads(size_t nThreads)
+{
+  m_cachePolicy.setVerificationThreads(nThreads);
+}
+
+size_t
+CachingValidator::getCacheSize() const
+{
+  return m_cachePolicy.size();
+}
+
+uint64_t
+CachingValidator::getNCacheHits() const
+{
+  return m_cachePolicy.getNHits();
+}
+
+CachingValidator::ValidationCachePolicy::ValidationCachePolicy(boost::asio::io_context& io,
+                                                               size_t capacity,
+                                                               ndn::time::nanoseconds lifetime)
+  : m_capacity(capacity)
+  , m_lifetime(lifetime)
+  , m_io(io)
+{
+}
+
+CachingValidator::ValidationCachePolicy::~ValidationCachePolicy()
+{
+  if (m_workers) {
+    // outcomes posted afterwards are dropped, see m_lifetimeToken
+    m_workers->join();
+  }
+}
+
+void
+CachingValidator::ValidationCachePolicy::setVerificationThreads(size_t nThreads)
+{
+  if (m_workers) {
+    m_workers->join();
+    m_workers.reset();
+  }
+  if (nThreads > 0) {
+    m_workers = std::make_unique<boost::asio::thread_pool>(nThreads);
+  }
+}
+
+void
+CachingValidator::ValidationCachePolicy::checkPolicy(const ndn::Data& data,
+  const std::shared_ptr<ndn::security::ValidationState>& state,
+  const ValidationContinuation& continueValidation)
+{
+  if (m_capacity > 0) {
+    auto it = m_entries.find(data.getFullName());
+    if (it != m_entries.end()) {
+      if (it->second.expiration > ndn::time::steady_clock::now()) {
+        ++m_nHits;
+        m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+        NLSR_LOG_TRACE("Already validated: " << data.getName());
+        // no certificate to retrieve; the signature is not verified again
+        continueValidation(nullptr, state);
+        return;
+      }
+      m_lru.erase(it->second.lruPos);
+      m_entries.erase(it);
+    }
+  }
+
+  if (!m_workers) {
+    getInnerPolicy().checkPolicy(data, state, continueValidation);
+    return;
+  }
+
+  getInnerPolicy().checkPolicy(data, state,
+    [this, data, continueValidation] (const auto& certRequest, const auto& state) {
+      // the same lookup as the Validator makes before verifying the signature itself
+      const ndn::security::Certificate* cert = nullptr;
+      if (certRequest != nullptr) {
+        cert = m_validator->findTrustedCert(certRequest->interest);
+      }
+      if (cert == nullptr) {
+        continueValidation(certRequest, state);
+        return;
+      }
+      verifyOnWorker(data, *cert, state, continueValidation);
+    });
+}
+
+void
+CachingValidator::ValidationCachePolicy::verifyOnWorker(const ndn::Data& data,
+  const ndn::security::Certificate& cert,
+  const std::shared_ptr<ndn::security::ValidationState>& state,
+  const ValidationContinuation& continueValidation)
+{
+  // Only copies are handed to the worker, which touches nothing else.
+  boost::asio::post(*m_workers,
+    [this, ticket = m_nextTicket++, data, cert, state, continueValidation,
+     token = std::weak_ptr<int>(m_lifetimeToken)] {
+      bool isValid = ndn::security::verifySignature(data, cert.getPublicKey());
+      boost::asio::post(m_io, [=] {
+        if (token.expired()) {
+          return;
+        }
+        deliver(ticket, [=] {
+          if (isValid) {
+            // the signature is verified; nothing is left for the Validator to do
+            continueValidation(nullptr, state);
+          }
+          else {
+            state->fail({ndn::security::ValidationError::INVALID_SIGNATURE,
+                         "Invalid signature of data `" + data.getName().toUri() + "`"});
+          }
+        });
+      });
+    });
+}
+
+void
+CachingValidator::ValidationCachePolicy::deliver(uint64_t ticket, std::function<void()> report)
+{
+  m_pendingReports.emplace(ticket, std::move(report));
+  while (!m_pendingReports.empty() && m_pendingReports.begin()->first == m_nextDelivery) {
+    auto next = std::move(m_pendingReports.begin()->second);
+    m_pendingReports.erase(m_pendingReports.begin());
+    ++m_nextDelivery;
+    next();
+  }
+}
+
+void
+CachingValidator::ValidationCachePolicy::checkPolicy(const ndn::Interest& interest,
+  const std::shared_ptr<ndn::security::ValidationState>& state,
+  const ValidationContinuation& continueValidation)
+{
+  getInnerPolicy().checkPolicy(interest, state, continueValidation);
+}
+
+void
+CachingValidator::ValidationCachePolicy::checkCertificatePolicy(
+  const ndn::security::Certificate& certificate,
+  const std::shared_ptr<ndn::security::ValidationState>& state,
+  const ValidationContinuation& continueValidation)
+{
+  getInnerPolicy().checkCertificatePolicy(certificate, state, continueValidation);
+}
+
+void
+CachingValidator::ValidationCachePolicy::insert(const ndn::Data& data)
+{
+  if (m_capacity == 0) {
+    return;
+  }
+
+  auto expiration = ndn::time::steady_clock::now() + m_lifetime;
+  const auto& fullName = data.getFullName();
+  auto it = m_entries.find(fullName);
+  if (it != m_entries.end()) {
+    it->second.expiration = expiration;
+    m_lru.splice(m_lru.begin(), m_lru, it->second.lruPos);
+    return;
+  }
+
+  if (m_entries.size() >= m_capacity) {
+    m_entries.erase(m_lru.back());
+    m_lru.pop_back();
+  }
+  m_lru.push_front(fullName);
+  m_entries.emplace(fullName, Entry{expiration, m_lru.begin()});
+}
+
+} // namespace nlsr::security
@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_CACHING_VALIDATOR_HPP
+#define NLSR_CACHING_VALIDATOR_HPP
+
+#include "test-access-control.hpp"
+
+#include <ndn-cxx/security/certificate-fetcher.hpp>
+#include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/security/validator-config/validation-policy-config.hpp>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <list>
+#include <map>
+#include <unordered_map>
+
+namespace nlsr::security {
+
+/*! \brief Validator that lets through Data packets identical to ones it has validated.
+ *
+ * The validation policy is loaded from a configuration section, as with
+ * ndn::security::ValidatorConfig. Packets that passed validation can be recorded with
+ * cacheValidated; a packet with the same implicit digest, which covers its name, content and
+ * signature, including the KeyLocator of the signer, then passes without its signature being
+ * verified again. The cache is bounded by a number of packets, least recently used first out,
+ * and each packet is only remembered for a limited time.
+ *
+ * The certificate chains of the signers are not walked for every packet either way, as
+ * ndn::security::Validator remembers the certificates it has verified.
+ *
+ * With verification threads, the signature of a Data packet whose signer certificate is
+ * already trusted is verified on one of them. The outcomes of these packets are then reported
+ * on the io thread in the order the packets were validated, so that the segments and versions
+ * of an LSA are not handled out of order. Packets that need a certificate to be retrieved are
+ * verified on the io thread, as they are without verification threads.
+ */
+class CachingValidator : public ndn::security::Validator
+{
+public:
+  explicit
+  CachingValidator(std::unique_ptr<ndn::security::CertificateFetcher> fetcher,
+                   boost::asio::io_context& io,
+                   size_t capacity = DEFAULT_CAPACITY,
+                   ndn::time::nanoseconds lifetime = DEFAULT_LIFETIME);
+
+  void
+  load(const std::string& filename);
+
+  void
+  load(const std::string& input, const std::string& filename);
+
+  void
+  load(std::istream& input, const std::string& filename);
+
+  void
+  load(const ndn::security::validator_config::ConfigSection& configSection,
+       const std::string& filename);
+
+  /*! \brief Record a Data packet that has passed validation.
+   */
+  void
+  cacheValidated(const ndn::Data& data);
+
+  /*! \brief Set the number of threads verifying signatures; 0 to verify them on the io thread.
+   *
+   * Verifications already started on the previous threads complete first.
+   */
+  void
+  setVerificationThreads(size_t nThreads);
+
+  size_t
+  getCacheSize() const;
+
+  uint64_t
+  getNCacheHits() const;
+
+public:
+  static constexpr size_t DEFAULT_CAPACITY = 4096;
+  static constexpr ndn::time::nanoseconds DEFAULT_LIFETIME = ndn::time::hours(1);
+
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  class ValidationCachePolicy;
+
+private:
+  ValidationCachePolicy& m_cachePolicy;
+  ndn::security::validator_config::ValidationPolicyConfig& m_policyConfig;
+};
+
+/*! \brief Validation policy that bypasses Data packets recorded as validated, and hands the
+ *  others to its inner policy.
+ */
+class CachingValidator::ValidationCachePolicy : public ndn::security::ValidationPolicy
+{
+public:
+  ValidationCachePolicy(boost::asio::io_context& io, size_t capacity,
+                        ndn::time::nanoseconds lifetime);
+
+  ~ValidationCachePolicy() override;
+
+  void
+  checkPolicy(const ndn::Data& data, const std::shared_ptr<ndn::security::ValidationState>& state,
+              const ValidationContinuation& continueValidation) override;
+
+  void
+  checkPolicy(const ndn::Interest& interest,
+              const std::shared_ptr<ndn::security::ValidationState>& state,
+              const ValidationContinuation& continueValidation) override;
+
+  void
+  checkCertificatePolicy(const ndn::security::Certificate& certificate,
+                         const std::shared_ptr<ndn::security::ValidationState>& state,
+                         const ValidationContinuation& continueValidation) override;
+
+  void
+  insert(const ndn::Data& data);
+
+  void
+  setVerificationThreads(size_t nThreads);
+
+  size_t
+  size() const
+  {
+    return m_entries.size();
+  }
+
+  uint64_t
+  getNHits() const
+  {
+    return m_nHits;
+  }
+
+private:
+  struct Entry
+  {
+    ndn::time::steady_clock::time_point expiration;
+    std::list<ndn::Name>::iterator lruPos;
+  };
+
+  /*! \brief Verify the signature of \p data with \p cert on a verification thread.
+   */
+  void
+  verifyOnWorker(const ndn::Data& data, const ndn::security::Certificate& cert,
+                 const std::shared_ptr<ndn::security::ValidationState>& state,
+                 const ValidationContinuation& continueValidation);
+
+  /*! \brief Report the outcome of verification \p ticket once those before it are reported.
+   */
+  void
+  deliver(uint64_t ticket, std::function<void()> report);
+
+  size_t m_capacity;
+  ndn::time::nanoseconds m_lifetime;
+  // by full name, i.e. name and implicit digest
+  std::unordered_map<ndn::Name, Entry> m_entries;
+  // Most recently used first
+  std::list<ndn::Name> m_lru;
+  uint64_t m_nHits = 0;
+
+  boost::asio::io_context& m_io;
+  std::unique_ptr<boost::asio::thread_pool> m_workers;
+  uint64_t m_nextTicket = 0;
+  uint64_t m_nextDelivery = 0;
+  // outcomes verified ahead of an earlier packet, by ticket
+  std::map<uint64_t, std::function<void()>> m_pendingReports;
+  std::shared_ptr<int> m_lifetimeToken = std::make_shared<int>(0);
+};
+
+} // namespace nlsr::security
+
+#endif // NLSR_CACHING_VALIDATOR_HPP
@@ -24,18 +24,29 @@
 #include "logger.hpp"
 #include "lsdb.hpp"
 
+#include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/util/io.hpp>
+
+#include <cstring>
+#include <filesystem>
 #include <fstream>
+#include <optional>
 
 namespace nlsr {
 namespace security {
 
 INIT_LOGGER(CertificateStore);
 
+constexpr uint32_t CERT_CACHE_FILE_MAGIC = 0x4e4c4343; // "NLCC"
+constexpr uint32_t CERT_CACHE_FILE_VERSION = 1;
+// coalesces the writes of the certificates fetched together at startup
+constexpr ndn::time::seconds CERT_CACHE_FILE_WRITE_DELAY = 5_s;
+
 CertificateStore::CertificateStore(ndn::Face& face, ConfParameter& confParam, Lsdb& lsdb)
   : m_face(face)
   , m_confParam(confParam)
   , m_validator(m_confParam.getValidator())
+  , m_scheduler(face.getIoContext())
 {
   for (const auto& certfile : confParam.getIdCerts()) {
     std::ifstream ifs(certfile);
@@ -57,6 +68,21 @@ CertificateStore::CertificateStore(ndn::Face& face, ConfParameter& confParam, Ls
       NLSR_LOG_TRACE("Certificate is already in the store: " << klName);
     }
   });
+
+  // connected after the Lsdb, so the LSA fetch and the prefetch leave in the same turn
+  m_onNewLsaConn = lsdb.getSync().onNewLsa.connect(
+    [this] (const auto&, uint64_t, const auto& originRouter, uint64_t incomingFaceId) {
+      prefetchCertificates(originRouter, incomingFaceId);
+    });
+
+  if (m_confParam.getCertPrefetch()) {
+    loadCacheFile();
+  }
+}
+
+CertificateStore::~CertificateStore()
+{
+  writeCacheFile();
 }
 
 void
@@ -187,5 +213,216 @@ CertificateStore::publishCertFromCache(const ndn::Name& keyName)
   }
 }
 
+void
+CertificateStore::prefetchCertificates(const ndn::Name& originRouter, uint64_t incomingFaceId)
+{
+  if (!m_confParam.getCertPrefetch() || originRouter == m_confParam.getRouterPrefix() ||
+      !m_prefetchedOrigins.insert(originRouter).second) {
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Prefetching certificates of " << originRouter);
+
+  ndn::Name instanceKey(originRouter);
+  instanceKey.append("nlsr").append(ndn::security::Certificate::KEY_COMPONENT);
+  fetchCertificate(instanceKey, incomingFaceId);
+
+  ndn::Name routerKey(originRouter);
+  routerKey.append(ndn::security::Certificate::KEY_COMPONENT);
+
+  ndn::Name siteKey;
+  for (size_t i = 0; i < originRouter.size(); ++i) {
+    if (originRouter[i].toUri() == "%C1.Router") {
+      break;
+    }
+    siteKey.append(originRouter[i]);
+  }
+  ndn::Name opPrefix(siteKey);
+  siteKey.append(ndn::security::Certificate::KEY_COMPONENT);
+  opPrefix.append(std::string("%C1.Operator"));
+
+  for (const auto& prefix : {routerKey, opPrefix, siteKey}) {
+    if (!isCertificateKnown(prefix)) {
+      fetchCertificate(prefix, incomingFaceId);
+    }
+  }
+}
+
+bool
+CertificateStore::isCertificateKnown(const ndn::Name& prefix) const
+{
+  ndn::Interest interest(prefix);
+  interest.setCanBePrefix(true);
+  return m_validator.getUnverifiedCertCache().find(interest) != nullptr ||
+         m_validator.findTrustedCert(interest) != nullptr;
+}
+
+void
+CertificateStore::fetchCertificate(const ndn::Name& prefix, uint64_t incomingFaceId)
+{
+  // a pending fetch of the site certificate also covers the key locators under it
+  for (size_t i = prefix.size(); i > 0; --i) {
+    if (m_pendingFetches.count(prefix.getPrefix(i)) > 0) {
+      return;
+    }
+  }
+
+  ndn::Interest interest(prefix);
+  interest.setCanBePrefix(true);
+  interest.setInterestLifetime(m_confParam.getLsaInterestLifetime());
+  if (incomingFaceId != 0) {
+    interest.setTag(std::make_shared<ndn::lp::NextHopFaceIdTag>(incomingFaceId));
+  }
+
+  NLSR_LOG_TRACE("Prefetching certificate: " << prefix);
+  m_pendingFetches[prefix] = m_face.expressInterest(interest,
+    [this, prefix, incomingFaceId] (const auto&, const auto& data) {
+      onPrefetchedCertificate(prefix, data, incomingFaceId);
+    },
+    [this, prefix] (const auto&, const auto& nack) {
+      NLSR_LOG_DEBUG("Certificate prefetch " << prefix << " nacked: " << nack.getReason());
+      m_pendingFetches.erase(prefix);
+    },
+    [this, prefix] (const auto&) {
+      NLSR_LOG_DEBUG("Certificate prefetch " << prefix << " timed out");
+      m_pendingFetches.erase(prefix);
+    });
+}
+
+void
+CertificateStore::onPrefetchedCertificate(const ndn::Name& prefix, const ndn::Data& data,
+                                          uint64_t incomingFaceId)
+{
+  m_pendingFetches.erase(prefix);
+
+  std::optional<ndn::security::Certificate> cert;
+  try {
+    cert.emplace(data);
+  }
+  catch (const std::exception& e) {
+    NLSR_LOG_DEBUG("Prefetched " << data.getName() << " is not a certificate: " << e.what());
+    return;
+  }
+
+  NLSR_LOG_TRACE("Prefetched certificate: " << cert->getName());
+  m_validator.cacheUnverifiedCert(ndn::security::Certificate(*cert));
+  m_prefetchedCerts.insert_or_assign(cert->getName(), *cert);
+
+  m_isCacheFileDirty = true;
+  if (!m_cacheFileEvent) {
+    m_cacheFileEvent = m_scheduler.schedule(CERT_CACHE_FILE_WRITE_DELAY, [this] {
+      writeCacheFile();
+    });
+  }
+
+  const auto kl = cert->getKeyLocator();
+  if (kl && kl->getType() == ndn::tlv::Name && kl->getName() != cert->getKeyName() &&
+      !isCertificateKnown(kl->getName())) {
+    fetchCertificate(kl->getName(), incomingFaceId);
+  }
+}
+
+std::string
+CertificateStore::getCacheFilePath() const
+{
+  if (m_confParam.getStateFileDir().empty()) {
+    return "";
+  }
+  return m_confParam.getStateFileDir() + "/" + CERT_CACHE_FILE;
+}
+
+void
+CertificateStore::writeCacheFile()
+{
+  auto path = getCacheFilePath();
+  if (!m_isCacheFileDirty || path.empty()) {
+    return;
+  }
+
+  std::string tempPath = path + ".tmp";
+  size_t nCerts = 0;
+  {
+    std::ofstream os(tempPath, std::ios::binary | std::ios::trunc);
+    os.write(reinterpret_cast<const char*>(&CERT_CACHE_FILE_MAGIC), sizeof(CERT_CACHE_FILE_MAGIC));
+    os.write(reinterpret_cast<const char*>(&CERT_CACHE_FILE_VERSION),
+             sizeof(CERT_CACHE_FILE_VERSION));
+    for (const auto& [name, cert] : m_prefetchedCerts) {
+      if (!cert.isValid()) {
+        continue;
+      }
+      const auto& wire = cert.wireEncode();
+      os.write(reinterpret_cast<const char*>(wire.data()), wire.size());
+      ++nCerts;
+    }
+    if (!os) {
+      NLSR_LOG_WARN("Cannot write certificate cache " << tempPath);
+      return;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tempPath, path, ec);
+  if (ec) {
+    NLSR_LOG_WARN("Cannot write certificate cache " << path << ": " << ec.message());
+    return;
+  }
+  m_isCacheFileDirty = false;
+  NLSR_LOG_DEBUG("Wrote " << nCerts << " certificates to " << path);
+}
+
+size_t
+CertificateStore::loadCacheFile()
+{
+  auto path = getCacheFilePath();
+  if (path.empty()) {
+    return 0;
+  }
+
+  std::ifstream is(path, std::ios::binary);
+  if (!is) {
+    NLSR_LOG_DEBUG("No certificate cache at " << path);
+    return 0;
+  }
+  auto buffer = std::make_shared<ndn::Buffer>(std::istreambuf_iterator<char>(is),
+                                              std::istreambuf_iterator<char>());
+
+  uint32_t magic = 0, version = 0;
+  size_t offset = sizeof(magic) + sizeof(version);
+  if (buffer->size() >= offset) {
+    std::memcpy(&magic, buffer->data(), sizeof(magic));
+    std::memcpy(&version, buffer->data() + sizeof(magic), sizeof(version));
+  }
+  if (magic != CERT_CACHE_FILE_MAGIC || version != CERT_CACHE_FILE_VERSION) {
+    NLSR_LOG_WARN("Ignoring incompatible certificate cache " << path);
+    return 0;
+  }
+
+  size_t nLoaded = 0;
+  while (offset < buffer->size()) {
+    auto [isOk, block] = ndn::Block::fromBuffer(buffer, offset);
+    if (!isOk) {
+      NLSR_LOG_WARN("Ignoring truncated tail of certificate cache " << path);
+      break;
+    }
+    offset += block.size();
+
+    try {
+      ndn::security::Certificate cert(block);
+      if (!cert.isValid()) {
+        continue;
+      }
+      m_validator.cacheUnverifiedCert(ndn::security::Certificate(cert));
+      m_prefetchedCerts.insert_or_assign(cert.getName(), std::move(cert));
+      ++nLoaded;
+    }
+    catch (const std::exception& e) {
+      NLSR_LOG_WARN("Skipping malformed certificate in " << path << ": " << e.what());
+    }
+  }
+
+  NLSR_LOG_INFO("Loaded " << nLoaded << " certificates from " << path);
+  return nLoaded;
+}
+
 } // namespace security
 } // namespace nlsr
@@ -22,12 +22,18 @@
 #ifndef NLSR_CERTIFICATE_STORE_HPP
 #define NLSR_CERTIFICATE_STORE_HPP
 
+#include "test-access-control.hpp"
+
 #include <ndn-cxx/face.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/security/certificate.hpp>
-#include <ndn-cxx/security/validator-config.hpp>
+#include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
 #include <ndn-cxx/util/signal/scoped-connection.hpp>
 
+#include <map>
+#include <set>
+
 namespace nlsr {
 
 class ConfParameter;
@@ -35,18 +41,26 @@ class Lsdb;
 
 namespace security {
 
+/// name of the file in the state directory holding the prefetched certificates
+inline constexpr char CERT_CACHE_FILE[] = "cert-cache";
+
 /*! \brief Store certificates for names.
  *
  * Stores certificates that this router claims to be authoritative
  * for. That is, this stores only the certificates that we will reply
  * to KEY interests with, e.g. when other routers are verifying data
  * we have sent.
+ *
+ * With cert-prefetch on, it also fetches the certificates of other routers ahead of the
+ * validator, see prefetchCertificates().
  */
 class CertificateStore
 {
 public:
   CertificateStore(ndn::Face& face, ConfParameter& confParam, Lsdb& lsdb);
 
+  ~CertificateStore();
+
   void
   insert(const ndn::security::Certificate& certificate);
 
@@ -70,7 +84,51 @@ public:
   void
   publishCertFromCache(const ndn::Name& keyName);
 
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Fetches the certificates of a router that sync reported for the first time.
+   *
+   * The NLSR, router, operator and site certificates of the origin are requested in parallel,
+   * over the face the sync update came from, like the validator does, and each certificate
+   * fetched is followed by the one of its signer. They are put in the validator's cache of
+   * unverified certificates, so that the validation of the LSA finds its certificate chain
+   * there instead of fetching it one certificate at a time. The router, operator and site
+   * certificates are skipped when already cached, the NLSR certificate is not, since its key
+   * is created at each start of the origin.
+   */
+  void
+  prefetchCertificates(const ndn::Name& originRouter, uint64_t incomingFaceId);
+
+  /*! \brief Writes the prefetched certificates to the cache file in the state directory.
+   *
+   * Like the LSDB snapshot, the file is replaced through a temporary file. Nothing is written
+   * if no certificate was fetched since the last write.
+   */
+  void
+  writeCacheFile();
+
+  /*! \brief Puts the unexpired certificates of the cache file in the validator's cache.
+   *
+   * These certificates are not trusted by being loaded: they are verified with the data that
+   * they sign, just like the fetched ones.
+   * \return the number of loaded certificates
+   */
+  size_t
+  loadCacheFile();
+
 private:
+  void
+  fetchCertificate(const ndn::Name& prefix, uint64_t incomingFaceId);
+
+  void
+  onPrefetchedCertificate(const ndn::Name& prefix, const ndn::Data& data,
+                          uint64_t incomingFaceId);
+
+  bool
+  isCertificateKnown(const ndn::Name& prefix) const;
+
+  std::string
+  getCacheFilePath() const;
+
   const ndn::security::Certificate*
   findByKeyName(const ndn::Name& keyName) const;
 
@@ -96,8 +154,18 @@ private:
   std::map<ndn::Name, ndn::security::Certificate> m_certificates;
   ndn::Face& m_face;
   ConfParameter& m_confParam;
-  ndn::security::ValidatorConfig& m_validator;
+  ndn::security::Validator& m_validator;
   ndn::signal::ScopedConnection m_afterSegmentValidatedConn;
+
+  ndn::Scheduler m_scheduler;
+  ndn::signal::ScopedConnection m_onNewLsaConn;
+  std::set<ndn::Name> m_prefetchedOrigins;
+  /// outstanding prefetch Interests, by requested prefix
+  std::map<ndn::Name, ndn::ScopedPendingInterestHandle> m_pendingFetches;
+  /// prefetched certificates, by certificate name
+  std::map<ndn::Name, ndn::security::Certificate> m_prefetchedCerts;
+  bool m_isCacheFileDirty = false;
+  ndn::scheduler::ScopedEventId m_cacheFileEvent;
 };
 
 } // namespace security
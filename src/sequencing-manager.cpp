@@ -22,6 +22,8 @@
 #include "sequencing-manager.hpp"
 #include "logger.hpp"
 
+#include <boost/asio/post.hpp>
+
 #include <string>
 #include <fstream>
 #include <pwd.h>
@@ -39,22 +41,87 @@ SequencingManager::SequencingManager(const std::string& filePath, int hypState)
   initiateSeqNoFromFile();
 }
 
+SequencingManager::~SequencingManager()
+{
+  if (m_writer) {
+    m_writer->join();
+  }
+}
+
 void
-SequencingManager::writeSeqNoToFile() const
+SequencingManager::leaseSeqNo()
 {
   writeLog();
+
+  auto halfway = makeLease(SEQ_NO_LEASE / 2);
+  if (halfway.nameLsaSeq > m_requestedLease.nameLsaSeq ||
+      halfway.adjLsaSeq > m_requestedLease.adjLsaSeq ||
+      halfway.corLsaSeq > m_requestedLease.corLsaSeq) {
+    m_requestedLease = makeLease(SEQ_NO_LEASE);
+    if (!m_writer) {
+      m_writer = std::make_unique<boost::asio::thread_pool>(1);
+    }
+    boost::asio::post(*m_writer, [this, lease = m_requestedLease] {
+      try {
+        writeLease(lease);
+      }
+      catch (const std::exception& e) {
+        // written on the io thread when the lease runs out
+        NLSR_LOG_ERROR("Cannot write " << m_seqFileNameWithPath << ": " << e.what());
+      }
+    });
+  }
+
+  if (m_nameLsaSeq > m_writtenNameLsaSeq || m_adjLsaSeq > m_writtenAdjLsaSeq ||
+      m_corLsaSeq > m_writtenCorLsaSeq) {
+    NLSR_LOG_DEBUG("Sequence number lease ran out before the next one was written");
+    writeLease(m_requestedLease);
+  }
+}
+
+SequencingManager::SeqNoLease
+SequencingManager::makeLease(uint64_t headroom) const
+{
+  SeqNoLease lease{m_nameLsaSeq + headroom, m_adjLsaSeq, m_corLsaSeq};
+  if (m_hyperbolicState != HYPERBOLIC_STATE_ON) {
+    lease.adjLsaSeq += headroom;
+  }
+  if (m_hyperbolicState != HYPERBOLIC_STATE_OFF) {
+    lease.corLsaSeq += headroom;
+  }
+  return lease;
+}
+
+void
+SequencingManager::writeLease(const SeqNoLease& lease)
+{
+  std::lock_guard<std::mutex> lock(m_fileMutex);
+  if (lease.nameLsaSeq <= m_writtenNameLsaSeq && lease.adjLsaSeq <= m_writtenAdjLsaSeq &&
+      lease.corLsaSeq <= m_writtenCorLsaSeq) {
+    return;
+  }
+
   std::string tempPath = m_seqFileNameWithPath + ".tmp";
   std::ofstream outputFile(tempPath.c_str());
-  outputFile << "NameLsaSeq " << m_nameLsaSeq << "\n"
-             << "AdjLsaSeq "  << m_adjLsaSeq  << "\n"
-             << "CorLsaSeq "  << m_corLsaSeq;
+  outputFile << "NameLsaSeqLease " << lease.nameLsaSeq << "\n"
+             << "AdjLsaSeqLease "  << lease.adjLsaSeq  << "\n"
+             << "CorLsaSeqLease "  << lease.corLsaSeq;
   outputFile.close();
   std::filesystem::rename(tempPath, m_seqFileNameWithPath);
+
+  m_writtenNameLsaSeq = lease.nameLsaSeq;
+  m_writtenAdjLsaSeq = lease.adjLsaSeq;
+  m_writtenCorLsaSeq = lease.corLsaSeq;
 }
 
 void
 SequencingManager::initiateSeqNoFromFile()
 {
+  if (m_writer) {
+    m_writer->join();
+    m_writer.reset();
+  }
+
   NLSR_LOG_DEBUG("Seq File Name: " << m_seqFileNameWithPath);
   std::ifstream inputFile(m_seqFileNameWithPath.c_str());
 
@@ -62,14 +129,15 @@ SequencingManager::initiateSeqNoFromFile()
   // Good checks that file is not (bad or eof or fail)
   if (inputFile.good()) {
     inputFile >> seqType >> m_nameLsaSeq;
+    // No number above a lease was handed out. Older versions wrote the numbers themselves,
+    // possibly not the last ones if NLSR crashed.
+    uint64_t increment = seqType == "NameLsaSeqLease" ? 0 : 10;
     inputFile >> seqType >> m_adjLsaSeq;
     inputFile >> seqType >> m_corLsaSeq;
 
     inputFile.close();
 
-    // Increment by 10 in case last run of NLSR was not able to write to file
-    // before crashing
-    m_nameLsaSeq += 10;
+    m_nameLsaSeq += increment;
 
     // Increment the adjacency LSA seq. no. if link-state or dry HR is enabled
     if (m_hyperbolicState != HYPERBOLIC_STATE_ON) {
@@ -78,7 +146,7 @@ SequencingManager::initiateSeqNoFromFile()
                       "routing without clearing the seq. no. file.");
         m_corLsaSeq = 0;
       }
-      m_adjLsaSeq += 10;
+      m_adjLsaSeq += increment;
     }
 
     // Similarly, increment the coordinate LSA seq. no only if link-state is disabled.
@@ -88,9 +156,16 @@ SequencingManager::initiateSeqNoFromFile()
                       "routing without clearing the seq. no. file.");
         m_adjLsaSeq = 0;
       }
-      m_corLsaSeq += 10;
+      m_corLsaSeq += increment;
     }
   }
+
+  // The numbers read are not handed out again, so the first lease starts from them.
+  m_writtenNameLsaSeq = m_nameLsaSeq;
+  m_writtenAdjLsaSeq = m_adjLsaSeq;
+  m_writtenCorLsaSeq = m_corLsaSeq;
+  m_requestedLease = makeLease(SEQ_NO_LEASE);
+  writeLease(m_requestedLease);
   writeLog();
 }
 
@@ -28,16 +28,31 @@
 
 #include <ndn-cxx/face.hpp>
 
+#include <boost/asio/thread_pool.hpp>
+#include <boost/noncopyable.hpp>
+
+#include <atomic>
 #include <list>
+#include <mutex>
 #include <string>
 
 namespace nlsr {
 
-class SequencingManager
+/*! \brief Hands out the sequence numbers of our LSAs.
+ *
+ * Sequence numbers are leased SEQ_NO_LEASE at a time: the sequence file holds, for each type of
+ * LSA, a limit that no number handed out exceeds, so that the numbers used after a restart are
+ * new even if NLSR crashed. The next lease is written on a worker thread once half of the
+ * current one is used. The file is only written on the caller's thread when a lease runs out
+ * before the next one was written.
+ */
+class SequencingManager : boost::noncopyable
 {
 public:
   SequencingManager(const std::string& filePath, int hypState);
 
+  ~SequencingManager();
+
   void
   setLsaSeq(uint64_t seqNo, Lsa::Type lsaType)
   {
@@ -125,14 +140,37 @@ public:
     m_corLsaSeq++;
   }
 
+  /*! \brief Make sure the lease on disk covers the current sequence numbers.
+   *
+   * Called after a sequence number is changed, before it is published.
+   */
   void
-  writeSeqNoToFile() const;
+  leaseSeqNo();
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   initiateSeqNoFromFile();
 
 private:
+  struct SeqNoLease
+  {
+    uint64_t nameLsaSeq = 0;
+    uint64_t adjLsaSeq = 0;
+    uint64_t corLsaSeq = 0;
+  };
+
+  /*! \brief The current sequence numbers plus \p headroom for the types of LSA in use.
+   */
+  SeqNoLease
+  makeLease(uint64_t headroom) const;
+
+  /*! \brief Write \p lease to the sequence file, unless one that covers it was written.
+   *
+   * Can be called from any thread.
+   */
+  void
+  writeLease(const SeqNoLease& lease);
+
   /*! \brief Set the sequence file directory
 
     If the string is empty, home directory is set as sequence file directory
@@ -151,8 +189,21 @@ private:
   uint64_t m_corLsaSeq = 0;
   std::string m_seqFileNameWithPath;
 
+  // the last lease handed to the writer
+  SeqNoLease m_requestedLease;
+  // serializes writes of the sequence file
+  std::mutex m_fileMutex;
+  // the lease in the sequence file
+  std::atomic<uint64_t> m_writtenNameLsaSeq{0};
+  std::atomic<uint64_t> m_writtenAdjLsaSeq{0};
+  std::atomic<uint64_t> m_writtenCorLsaSeq{0};
+  std::unique_ptr<boost::asio::thread_pool> m_writer;
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   int m_hyperbolicState;
+
+public:
+  static constexpr uint64_t SEQ_NO_LEASE = 1000;
 };
 
 } // namespace nlsr
@@ -30,9 +30,11 @@ namespace nlsr {
 
 class RoutingTable;
 class RoutingTableEntry;
+struct RoutingTableDelta;
 class SyncLogicHandler;
 
 using AfterRoutingChange = ndn::signal::Signal<RoutingTable, std::list<RoutingTableEntry>>;
+using AfterRoutingDelta = ndn::signal::Signal<RoutingTable, RoutingTableDelta>;
 using OnNewLsa = ndn::signal::Signal<SyncLogicHandler, ndn::Name, uint64_t, ndn::Name, uint64_t>;
 
 } // namespace nlsr
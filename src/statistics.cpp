@@ -25,30 +25,32 @@
 
 namespace nlsr {
 
-size_t
-Statistics::get(PacketType type) const
+void
+Statistics::resetAll()
 {
-  auto it = m_packetCounter.find(type);
-  if (it != m_packetCounter.end()) {
-    return it->second;
-  }
-  else {
-    return 0;
+  for (auto& counter : m_counters) {
+    counter.store(0, std::memory_order_relaxed);
   }
 }
 
-void
-Statistics::increment(PacketType type)
+Statistics::Snapshot
+Statistics::getSnapshot() const
 {
-  m_packetCounter[type]++;
+  Snapshot snapshot;
+  for (size_t i = 0; i < N_PACKET_TYPES; ++i) {
+    snapshot[i] = m_counters[i].load(std::memory_order_relaxed);
+  }
+  return snapshot;
 }
 
-void
-Statistics::resetAll()
+Statistics::Snapshot
+Statistics::getDelta(const Snapshot& earlier) const
 {
-  for (auto& it : m_packetCounter) {
-    it.second = 0;
+  Snapshot delta = getSnapshot();
+  for (size_t i = 0; i < N_PACKET_TYPES; ++i) {
+    delta[i] = delta[i] >= earlier[i] ? delta[i] - earlier[i] : delta[i];
   }
+  return delta;
 }
 
 std::ostream&
@@ -90,6 +92,9 @@ operator<<(std::ostream& os, const Statistics& stats)
      << "    Received Adjacency LSA Data: "       << stats.get(PacketType::RCV_ADJ_LSA_DATA) << "\n"
      << "    Received Coordinate LSA Data: "      << stats.get(PacketType::RCV_COORD_LSA_DATA) << "\n"
      << "    Received Name LSA Data: "            << stats.get(PacketType::RCV_NAME_LSA_DATA) << "\n"
+     << "\n"
+     << "    Deferred LSAs: "                     << stats.get(PacketType::DEFERRED_LSA) << "\n"
+     << "    Rejected LSAs: "                     << stats.get(PacketType::REJECTED_LSA) << "\n"
      << "++++++++++++++++++++++++++++++++++++++++\n";
 
   return os;
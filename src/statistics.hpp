@@ -22,11 +22,18 @@
 #ifndef NLSR_STATISTICS_HPP
 #define NLSR_STATISTICS_HPP
 
-#include <map>
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <ostream>
 
 namespace nlsr {
 
+/*! \brief Counters of the Hello and LSA packets sent and received, and of the LSAs held back
+ *         by the LSDB admission control.
+ *
+ * The counters are incremented on the io thread, and can be read from any thread.
+ */
 class Statistics
 {
 public:
@@ -50,26 +57,50 @@ public:
     RCV_LSA_DATA,
     RCV_ADJ_LSA_DATA,
     RCV_COORD_LSA_DATA,
-    RCV_NAME_LSA_DATA
+    RCV_NAME_LSA_DATA,
+    /// LSA versions announced sooner than lsa-min-arrival after the previous one
+    DEFERRED_LSA,
+    /// LSAs larger than lsa-max-name-prefixes or lsa-max-adjacencies
+    REJECTED_LSA
   };
 
-  size_t
-  get(PacketType) const;
+  static constexpr size_t N_PACKET_TYPES = static_cast<size_t>(PacketType::REJECTED_LSA) + 1;
+
+  /*! \brief Values of all the counters, indexed by PacketType.
+   */
+  using Snapshot = std::array<uint64_t, N_PACKET_TYPES>;
+
+  uint64_t
+  get(PacketType type) const
+  {
+    return m_counters[static_cast<size_t>(type)].load(std::memory_order_relaxed);
+  }
 
   void
-  increment(PacketType);
+  increment(PacketType type)
+  {
+    m_counters[static_cast<size_t>(type)].fetch_add(1, std::memory_order_relaxed);
+  }
 
   void
   resetAll();
 
-  const std::map<PacketType,int>&
-  getCounter() const
-  {
-    return m_packetCounter;
-  }
+  /*! \brief Read all the counters.
+   *
+   * Counters incremented while they are read may or may not include the increment.
+   */
+  Snapshot
+  getSnapshot() const;
+
+  /*! \brief Packets counted since \p earlier was taken, e.g. to compute rates.
+   *
+   * A counter reset since then counts from 0.
+   */
+  Snapshot
+  getDelta(const Snapshot& earlier) const;
 
 private:
-  std::map<PacketType, int> m_packetCounter;
+  std::array<std::atomic<uint64_t>, N_PACKET_TYPES> m_counters{};
 };
 
 std::ostream&
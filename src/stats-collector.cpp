@@ -27,22 +27,14 @@ StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp)
   : m_lsdb(lsdb)
   , m_hp(hp)
 {
-  m_lsaIncrementConn = m_lsdb.lsaIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
-                                                                   this, _1));
-  m_helloIncrementConn = m_hp.hpIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
-                                                                  this, _1));
+  m_lsdb.setStatistics(&m_stats);
+  m_hp.setStatistics(&m_stats);
 }
 
 StatsCollector::~StatsCollector()
 {
-  m_lsaIncrementConn.disconnect();
-  m_helloIncrementConn.disconnect();
-}
-
-void
-StatsCollector::statsIncrement(Statistics::PacketType pType)
-{
-  m_stats.increment(pType);
+  m_lsdb.setStatistics(nullptr);
+  m_hp.setStatistics(nullptr);
 }
 
 } // namespace nlsr
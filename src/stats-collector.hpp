@@ -24,17 +24,21 @@
 #include "statistics.hpp"
 #include "lsdb.hpp"
 #include "hello-protocol.hpp"
-#include <ndn-cxx/util/signal.hpp>
 
 namespace nlsr {
 
 /**
- * \brief a class designed to handle statistical signals in nlsr
+ * \brief a class designed to count the Hello and LSA packets of nlsr
  */
 class StatsCollector
 {
 public:
 
+  /*!
+   * \brief Counts the packets of \p lsdb and \p hp until destroyed.
+   *
+   * The packets are counted where they are sent or received, rather than through signals.
+   */
   StatsCollector(Lsdb& lsdb, HelloProtocol& hp);
 
   ~StatsCollector();
@@ -45,27 +49,11 @@ public:
     return m_stats;
   }
 
-private:
-
-  /*!
-   * \brief: increments a Statistics::PacketType
-   *
-   * \param: pType is an enum value corresponding to a Statistics::PacketType
-   *
-   * This takes in a Statistics::PacketType emitted by a signal and increments
-   * the value in m_stats.
-   */
-  void
-  statsIncrement(Statistics::PacketType pType);
-
 private:
 
   Lsdb& m_lsdb;
   HelloProtocol& m_hp;
   Statistics m_stats;
-
-  ndn::signal::ScopedConnection m_lsaIncrementConn;
-  ndn::signal::ScopedConnection m_helloIncrementConn;
 };
 
 } // namespace nlsr
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+namespace nlsr {
+
+TimerWheel::TimerWheel(ndn::Scheduler& scheduler, ndn::time::milliseconds tick, size_t nSlots,
+                       Callback callback)
+  : m_scheduler(scheduler)
+  , m_tick(tick)
+  , m_callback(std::move(callback))
+  , m_slots(nSlots)
+{
+}
+
+void
+TimerWheel::schedule(Key key, ndn::time::nanoseconds delay)
+{
+  if (key >= m_timers.size()) {
+    m_timers.resize(key + 1);
+  }
+  if (m_timers[key].isScheduled) {
+    unlink(key);
+  }
+
+  auto now = ndn::time::steady_clock::now();
+  if (!m_isTicking) {
+    m_lastTick = now;
+    scheduleTick();
+  }
+
+  // number of ticks until the first one at or after now + delay
+  auto untilNextTick = m_lastTick + m_tick - now;
+  uint64_t nTicks = 1;
+  if (delay > untilNextTick) {
+    nTicks += (delay - untilNextTick + m_tick - ndn::time::nanoseconds(1)) / m_tick;
+  }
+
+  auto& timer = m_timers[key];
+  timer.expiry = m_nTicks + nTicks;
+  timer.slot = timer.expiry % m_slots.size();
+  timer.pos = m_slots[timer.slot].size();
+  timer.isScheduled = true;
+  m_slots[timer.slot].push_back(key);
+  ++m_nScheduled;
+}
+
+void
+TimerWheel::cancel(Key key)
+{
+  if (isScheduled(key)) {
+    unlink(key);
+  }
+}
+
+void
+TimerWheel::cancelAll()
+{
+  for (auto& slot : m_slots) {
+    for (auto key : slot) {
+      m_timers[key].isScheduled = false;
+    }
+    slot.clear();
+  }
+  m_nScheduled = 0;
+  m_tickEvent.cancel();
+  m_isTicking = false;
+}
+
+void
+TimerWheel::unlink(Key key)
+{
+  auto& timer = m_timers[key];
+  auto& slot = m_slots[timer.slot];
+  Key last = slot.back();
+  slot[timer.pos] = last;
+  m_timers[last].pos = timer.pos;
+  slot.pop_back();
+  timer.isScheduled = false;
+  --m_nScheduled;
+}
+
+void
+TimerWheel::scheduleTick()
+{
+  m_isTicking = true;
+  m_tickEvent = m_scheduler.schedule(m_tick, [this] { onTick(); });
+}
+
+void
+TimerWheel::onTick()
+{
+  m_isTicking = false;
+  ++m_nTicks;
+  m_lastTick = ndn::time::steady_clock::now();
+
+  m_expired.clear();
+  for (auto key : m_slots[m_nTicks % m_slots.size()]) {
+    if (m_timers[key].expiry <= m_nTicks) {
+      m_expired.push_back(key);
+    }
+  }
+
+  // a callback may cancel or reschedule timers that expired in the same tick
+  for (size_t i = 0; i < m_expired.size(); ++i) {
+    Key key = m_expired[i];
+    if (m_timers[key].isScheduled && m_timers[key].expiry <= m_nTicks) {
+      unlink(key);
+      m_callback(key);
+    }
+  }
+
+  if (m_nScheduled > 0 && !m_isTicking) {
+    scheduleTick();
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,112 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_TIMER_WHEEL_HPP
+#define NLSR_TIMER_WHEEL_HPP
+
+#include <ndn-cxx/util/scheduler.hpp>
+
+#include <functional>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Hashed timer wheel for coarse-grained timers keyed by small integers.
+ *
+ * Each key, e.g. a NeighborId, has at most one pending timer, and scheduling a key again
+ * replaces its timer. Timers are bucketed into slots of one tick; a single scheduler event
+ * per tick expires all timers of the current slot together. A timer fires no earlier than
+ * its delay and at most one tick after it. Memory grows only with the largest key and the
+ * number of slots, and no allocation is made per timer once every key has been used.
+ */
+class TimerWheel
+{
+public:
+  using Key = uint32_t;
+  using Callback = std::function<void(Key)>;
+
+  /*! \param tick granularity of the timers
+   *  \param nSlots number of slots; delays longer than one rotation take extra rotations
+   *  \param callback invoked with the key of each expired timer
+   */
+  TimerWheel(ndn::Scheduler& scheduler, ndn::time::milliseconds tick, size_t nSlots,
+             Callback callback);
+
+  /*! \brief Schedule the timer of \p key, replacing its pending timer if any.
+   */
+  void
+  schedule(Key key, ndn::time::nanoseconds delay);
+
+  void
+  cancel(Key key);
+
+  void
+  cancelAll();
+
+  bool
+  isScheduled(Key key) const
+  {
+    return key < m_timers.size() && m_timers[key].isScheduled;
+  }
+
+  /*! \brief Return number of pending timers.
+   */
+  size_t
+  size() const
+  {
+    return m_nScheduled;
+  }
+
+private:
+  void
+  scheduleTick();
+
+  void
+  onTick();
+
+  void
+  unlink(Key key);
+
+private:
+  struct Timer
+  {
+    uint64_t expiry = 0;
+    size_t slot = 0;
+    size_t pos = 0;
+    bool isScheduled = false;
+  };
+
+  ndn::Scheduler& m_scheduler;
+  ndn::time::milliseconds m_tick;
+  Callback m_callback;
+  std::vector<std::vector<Key>> m_slots;
+  std::vector<Timer> m_timers;
+  std::vector<Key> m_expired;
+  uint64_t m_nTicks = 0;
+  size_t m_nScheduled = 0;
+  ndn::time::steady_clock::time_point m_lastTick;
+  ndn::scheduler::ScopedEventId m_tickEvent;
+  bool m_isTicking = false;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_TIMER_WHEEL_HPP
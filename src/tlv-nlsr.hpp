@@ -47,6 +47,56 @@ enum {
   RoutingTable                = 144,
   RoutingTableEntry           = 145,
   PrefixInfo                  = 146,
+  Topology                    = 147,
+  TopologyLink                = 148,
+  LinkSource                  = 149,
+  LinkTarget                  = 150,
+  CalculationProfile          = 151,
+  PhaseTiming                 = 152,
+  PhaseName                   = 153,
+  SampleCount                 = 154,
+  LastDuration                = 155,
+  MedianDuration              = 156,
+  P90Duration                 = 157,
+  MaxDuration                 = 158,
+  AdjacencyLsaDelta           = 159,
+  BaseSequenceNumber          = 160,
+  CompressedPrefixes          = 161,
+  SharedComponents            = 162,
+  InlineData                  = 163,
+  ConvergenceTraceEvent       = 164,
+  TraceId                     = 165,
+  TraceStage                  = 166,
+  Timestamp                   = 167,
+  LatencyStatistics           = 168,
+  StageLatency                = 169,
+  LsdbQuery                   = 170,
+  OriginRouter                = 171,
+  PrefixFilter                = 172,
+  MinSequenceNumber           = 173,
+  MaxSequenceNumber           = 174,
+  PageSize                    = 175,
+  ContinuationToken           = 176,
+  RoutingTableChanges         = 177,
+  RoutingTableVersion         = 178,
+  FullSnapshot                = 179,
+  AddedRoute                  = 180,
+  ChangedRoute                = 181,
+  RemovedDestination          = 182,
+  MemoryUsage                 = 183,
+  MemoryComponent             = 184,
+  ElementCount                = 185,
+  ByteCount                   = 186,
+  AreaSummary                 = 187,
+  WhatIfQuery                 = 188,
+  WhatIfScenario              = 189,
+  WhatIfChange                = 190,
+  ChangeType                  = 191,
+  Neighbor                    = 192,
+  WhatIfResult                = 193,
+  WhatIfOutcome               = 194,
+  AffectedPrefixCount         = 195,
+  UnreachablePrefixCount      = 196,
   
   // Link Cost Manager - External Metrics
   LinkMetricsCommand          = 210,
@@ -55,7 +105,22 @@ enum {
   BandwidthUtilization        = 213,
   PacketLoss                  = 214,
   SpectrumStrength            = 215,
-  MultiDimensionalCost        = 216
+  MultiDimensionalCost        = 216,
+  OriginalCost                = 217,
+  SmoothedRtt                 = 218,
+  LinkCostStatistics          = 219,
+  ProbeCount                  = 220,
+  ProbeTimeoutCount           = 221,
+  CostChangeCount             = 222,
+  P99Duration                 = 223,
+  ControlTraffic              = 224,
+  MessageClass                = 225,
+  InterestsSent               = 226,
+  InterestsReceived           = 227,
+  DataSent                    = 228,
+  DataReceived                = 229,
+  BytesSent                   = 230,
+  BytesReceived               = 231
 };
 
 } // namespace nlsr::tlv
@@ -21,6 +21,7 @@
 
 #include "command-processor.hpp"
 #include "logger.hpp"
+#include "prefix-update-commands.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-response.hpp>
 
@@ -39,6 +40,17 @@ CommandProcessor::CommandProcessor(ndn::mgmt::Dispatcher& dispatcher,
 
 CommandProcessor::~CommandProcessor() = default;
 
+/** \brief reply to a command that saves prefixes once they are saved
+ */
+static CommandProcessor::SaveContinuation
+makeSaveReply(const ndn::nfd::ControlParameters& responseParams,
+              const ndn::mgmt::CommandContinuation& done)
+{
+  return [body = responseParams.wireEncode(), done] (bool isSaved, const std::string& message) {
+    done(ndn::nfd::ControlResponse(isSaved ? 205 : 500, message).setBody(body));
+  };
+}
+
 void
 CommandProcessor::advertiseAndInsertPrefix(const ndn::mgmt::ControlParametersBase& parameters,
                                            const ndn::mgmt::CommandContinuation& done)
@@ -53,17 +65,10 @@ CommandProcessor::advertiseAndInsertPrefix(const ndn::mgmt::ControlParametersBas
   double castParamCost = (castParams.hasCost() ? castParams.getCost() : 0);
   if (m_namePrefixList.insert(castParams.getName(), "", castParamCost)) {
     NLSR_LOG_INFO("Advertising name: " << castParams.getName());
-    m_lsdb.buildAndInstallOwnNameLsa();
+    m_lsdb.scheduleNameLsaBuild(castParams.getName());
     if (castParams.hasFlags() && castParams.getFlags() == PREFIX_FLAG) {
       NLSR_LOG_INFO("Saving name to the configuration file ");
-      auto [afterAdvertiseReturn, afterAdvertiseMessage] = afterAdvertise(castParams.getName());
-      if (afterAdvertiseReturn) {
-        return done(ndn::nfd::ControlResponse(205, afterAdvertiseMessage).setBody(responseParams.wireEncode()));
-      }
-      else {
-        return done(ndn::nfd::ControlResponse(500, afterAdvertiseMessage)
-                    .setBody(responseParams.wireEncode()));
-      }
+      return savePrefixes({castParams.getName()}, true, makeSaveReply(responseParams, done));
     }
     return done(ndn::nfd::ControlResponse(200, "OK").setBody(responseParams.wireEncode()));
   }
@@ -71,14 +76,7 @@ CommandProcessor::advertiseAndInsertPrefix(const ndn::mgmt::ControlParametersBas
     if (castParams.hasFlags() && castParams.getFlags() == PREFIX_FLAG) {
       // Save an already advertised prefix
       NLSR_LOG_INFO("Saving an already advertised name: " << castParams.getName());
-      auto [afterAdvertiseReturn, afterAdvertiseMessage] = afterAdvertise(castParams.getName());
-      if (afterAdvertiseReturn) {
-        return done(ndn::nfd::ControlResponse(205, afterAdvertiseMessage).setBody(responseParams.wireEncode()));
-      }
-      else {
-        return done(ndn::nfd::ControlResponse(500, afterAdvertiseMessage)
-                    .setBody(responseParams.wireEncode()));
-      }
+      return savePrefixes({castParams.getName()}, true, makeSaveReply(responseParams, done));
     }
     return done(ndn::nfd::ControlResponse(204, "Prefix is already advertised/inserted.")
                 .setBody(responseParams.wireEncode()));
@@ -98,16 +96,9 @@ CommandProcessor::withdrawAndRemovePrefix(const ndn::mgmt::ControlParametersBase
   // Only build a Name LSA if the added name is new
   if (m_namePrefixList.erase(castParams.getName())) {
     NLSR_LOG_INFO("Withdrawing/Removing name: " << castParams.getName());
-    m_lsdb.buildAndInstallOwnNameLsa();
+    m_lsdb.scheduleNameLsaBuild(castParams.getName());
     if (castParams.hasFlags() && castParams.getFlags() == PREFIX_FLAG) {
-      auto [afterWithdrawReturn, afterWithdrawMessage] = afterWithdraw(castParams.getName());
-      if (afterWithdrawReturn) {
-        return done(ndn::nfd::ControlResponse(205, afterWithdrawMessage).setBody(responseParams.wireEncode()));
-      }
-      else {
-        return done(ndn::nfd::ControlResponse(500, afterWithdrawMessage)
-                    .setBody(responseParams.wireEncode()));
-      }
+      return savePrefixes({castParams.getName()}, false, makeSaveReply(responseParams, done));
     }
     return done(ndn::nfd::ControlResponse(200, "OK").setBody(responseParams.wireEncode()));
   }
@@ -115,18 +106,106 @@ CommandProcessor::withdrawAndRemovePrefix(const ndn::mgmt::ControlParametersBase
     if (castParams.hasFlags() && castParams.getFlags() == PREFIX_FLAG) {
       // Delete an already withdrawn prefix
       NLSR_LOG_INFO("Deleting an already withdrawn name: " << castParams.getName());
-      auto [afterWithdrawReturn, afterWithdrawMessage] = afterWithdraw(castParams.getName());
-      if (afterWithdrawReturn) {
-        return done(ndn::nfd::ControlResponse(205, afterWithdrawMessage).setBody(responseParams.wireEncode()));
-      }
-      else {
-        return done(ndn::nfd::ControlResponse(500, afterWithdrawMessage)
-                    .setBody(responseParams.wireEncode()));
-      }
+      return savePrefixes({castParams.getName()}, false, makeSaveReply(responseParams, done));
     }
     return done(ndn::nfd::ControlResponse(204, "Prefix is already withdrawn/removed.")
                 .setBody(responseParams.wireEncode()));
   }
 }
 
+std::tuple<bool, std::string>
+CommandProcessor::afterAdvertiseBatch(const std::vector<ndn::Name>& prefixes)
+{
+  std::tuple<bool, std::string> result{true, "OK"};
+  for (const auto& prefix : prefixes) {
+    if (auto prefixResult = afterAdvertise(prefix); !std::get<0>(prefixResult)) {
+      result = prefixResult;
+    }
+  }
+  return result;
+}
+
+std::tuple<bool, std::string>
+CommandProcessor::afterWithdrawBatch(const std::vector<ndn::Name>& prefixes)
+{
+  std::tuple<bool, std::string> result{true, "OK"};
+  for (const auto& prefix : prefixes) {
+    if (auto prefixResult = afterWithdraw(prefix); !std::get<0>(prefixResult)) {
+      result = prefixResult;
+    }
+  }
+  return result;
+}
+
+void
+CommandProcessor::savePrefixes(const std::vector<ndn::Name>& prefixes, bool isAdvertise,
+                               const SaveContinuation& done)
+{
+  auto [isSaved, message] = isAdvertise ? afterAdvertiseBatch(prefixes)
+                                        : afterWithdrawBatch(prefixes);
+  done(isSaved, message);
+}
+
+void
+CommandProcessor::advertisePrefixBatch(const ndn::mgmt::ControlParametersBase& parameters,
+                                       const ndn::mgmt::CommandContinuation& done)
+{
+  applyPrefixBatch(parameters, done, true);
+}
+
+void
+CommandProcessor::withdrawPrefixBatch(const ndn::mgmt::ControlParametersBase& parameters,
+                                      const ndn::mgmt::CommandContinuation& done)
+{
+  applyPrefixBatch(parameters, done, false);
+}
+
+void
+CommandProcessor::applyPrefixBatch(const ndn::mgmt::ControlParametersBase& parameters,
+                                   const ndn::mgmt::CommandContinuation& done, bool isAdvertise)
+{
+  const auto& castParams = static_cast<const ndn::nfd::ControlParameters&>(parameters);
+  ndn::nfd::ControlParameters responseParams(castParams.wireEncode());
+  uint64_t responseFaceId = (castParams.hasFaceId() && castParams.getFaceId() > 0)
+                            ? responseParams.getFaceId() : m_defaultResponseFaceId;
+  responseParams.setFaceId(responseFaceId);
+
+  std::vector<ndn::Name> prefixes;
+  try {
+    prefixes = decodePrefixBatch(castParams.getName());
+  }
+  catch (const ndn::tlv::Error& e) {
+    NLSR_LOG_DEBUG("Malformed prefix batch: " << e.what());
+    return done(ndn::nfd::ControlResponse(400, "Malformed prefix batch")
+                .setBody(responseParams.wireEncode()));
+  }
+
+  size_t nChanged = 0;
+  for (const auto& prefix : prefixes) {
+    bool isChanged = isAdvertise ? m_namePrefixList.insert(prefix, "", 0)
+                                 : m_namePrefixList.erase(prefix);
+    if (isChanged) {
+      NLSR_LOG_DEBUG((isAdvertise ? "Advertising name: " : "Withdrawing name: ") << prefix);
+      ++nChanged;
+    }
+  }
+
+  // Only build a Name LSA if the list of advertised names has changed
+  if (nChanged > 0) {
+    NLSR_LOG_INFO((isAdvertise ? "Advertising " : "Withdrawing ") << nChanged << " of "
+                  << prefixes.size() << " names in batch");
+    m_lsdb.scheduleNameLsaBuild();
+  }
+
+  if (castParams.hasFlags() && castParams.getFlags() == PREFIX_FLAG) {
+    return savePrefixes(prefixes, isAdvertise, makeSaveReply(responseParams, done));
+  }
+  if (nChanged > 0) {
+    return done(ndn::nfd::ControlResponse(200, "OK").setBody(responseParams.wireEncode()));
+  }
+  return done(ndn::nfd::ControlResponse(204, isAdvertise ? "Prefixes are already advertised."
+                                                         : "Prefixes are already withdrawn.")
+              .setBody(responseParams.wireEncode()));
+}
+
 } // namespace nlsr::update
@@ -30,6 +30,7 @@
 
 #include <boost/noncopyable.hpp>
 #include <optional>
+#include <vector>
 
 namespace nlsr::update {
 
@@ -44,6 +45,10 @@ public:
     using std::runtime_error::runtime_error;
   };
 
+  /*! \brief Called once prefixes are saved to, or deleted from, the configuration file.
+   */
+  using SaveContinuation = std::function<void(bool isSaved, const std::string& message)>;
+
   CommandProcessor(ndn::mgmt::Dispatcher& m_dispatcher,
                    NamePrefixList& m_namePrefixList,
                    Lsdb& lsdb);
@@ -65,6 +70,24 @@ public:
   withdrawAndRemovePrefix(const ndn::mgmt::ControlParametersBase& parameters,
                           const ndn::mgmt::CommandContinuation& done);
 
+  /*! \brief Add a batch of name prefixes to the advertised name prefix list.
+   *
+   * The name prefixes are carried by the Name parameter, see encodePrefixBatch. A single
+   * Name LSA is built for all of them, and none if none is new.
+   */
+  void
+  advertisePrefixBatch(const ndn::mgmt::ControlParametersBase& parameters,
+                       const ndn::mgmt::CommandContinuation& done);
+
+  /*! \brief Remove a batch of name prefixes from the advertised name prefix list.
+   *
+   * The name prefixes are carried by the Name parameter, see encodePrefixBatch. A single
+   * Name LSA is built for all of them, and none if none was advertised.
+   */
+  void
+  withdrawPrefixBatch(const ndn::mgmt::ControlParametersBase& parameters,
+                      const ndn::mgmt::CommandContinuation& done);
+
   /*! \brief Processing after advertise command delegated to subclass.
    *         This is always treated as successful if not implemented.
    *  \return tuple {bool indicating success/failure, message string}.
@@ -85,6 +108,34 @@ public:
     return {true, "OK"};
   }
 
+  /*! \brief Processing after batch advertise command delegated to subclass.
+   *         By default, afterAdvertise is called for each prefix.
+   *  \return tuple {bool indicating success/failure, message string}.
+   */
+  virtual std::tuple<bool, std::string>
+  afterAdvertiseBatch(const std::vector<ndn::Name>& prefixes);
+
+  /*! \brief Processing after batch withdraw command delegated to subclass.
+   *         By default, afterWithdraw is called for each prefix.
+   *  \return tuple {bool indicating success/failure, message string}.
+   */
+  virtual std::tuple<bool, std::string>
+  afterWithdrawBatch(const std::vector<ndn::Name>& prefixes);
+
+  /*! \brief Save prefixes to, or delete them from, the configuration file.
+   *
+   * By default, afterAdvertiseBatch or afterWithdrawBatch is called, and \p done right
+   * after it. A subclass may call \p done later, from the io thread.
+   */
+  virtual void
+  savePrefixes(const std::vector<ndn::Name>& prefixes, bool isAdvertise,
+               const SaveContinuation& done);
+
+private:
+  void
+  applyPrefixBatch(const ndn::mgmt::ControlParametersBase& parameters,
+                   const ndn::mgmt::CommandContinuation& done, bool isAdvertise);
+
 protected:
   ndn::mgmt::Dispatcher& m_dispatcher;
   NamePrefixList& m_namePrefixList;
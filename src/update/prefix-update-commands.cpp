@@ -41,4 +41,43 @@ const WithdrawPrefixCommand::ResponseFormat WithdrawPrefixCommand::s_responseFor
     .required(ndn::nfd::CONTROL_PARAMETER_NAME)
     .optional(ndn::nfd::CONTROL_PARAMETER_FLAGS);
 
+const AdvertisePrefixBatchCommand::RequestFormat AdvertisePrefixBatchCommand::s_requestFormat =
+    RequestFormat()
+    .required(ndn::nfd::CONTROL_PARAMETER_NAME)
+    .optional(ndn::nfd::CONTROL_PARAMETER_FLAGS);
+const AdvertisePrefixBatchCommand::ResponseFormat AdvertisePrefixBatchCommand::s_responseFormat =
+    ResponseFormat()
+    .required(ndn::nfd::CONTROL_PARAMETER_NAME)
+    .optional(ndn::nfd::CONTROL_PARAMETER_FLAGS);
+
+const WithdrawPrefixBatchCommand::RequestFormat WithdrawPrefixBatchCommand::s_requestFormat =
+    RequestFormat()
+    .required(ndn::nfd::CONTROL_PARAMETER_NAME)
+    .optional(ndn::nfd::CONTROL_PARAMETER_FLAGS);
+const WithdrawPrefixBatchCommand::ResponseFormat WithdrawPrefixBatchCommand::s_responseFormat =
+    ResponseFormat()
+    .required(ndn::nfd::CONTROL_PARAMETER_NAME)
+    .optional(ndn::nfd::CONTROL_PARAMETER_FLAGS);
+
+ndn::Name
+encodePrefixBatch(const std::vector<ndn::Name>& prefixes)
+{
+  ndn::Name batch;
+  for (const auto& prefix : prefixes) {
+    batch.append(ndn::tlv::GenericNameComponent, prefix.wireEncode());
+  }
+  return batch;
+}
+
+std::vector<ndn::Name>
+decodePrefixBatch(const ndn::Name& batch)
+{
+  std::vector<ndn::Name> prefixes;
+  prefixes.reserve(batch.size());
+  for (const auto& component : batch) {
+    prefixes.emplace_back(component.blockFromValue());
+  }
+  return prefixes;
+}
+
 } // namespace nlsr::update
@@ -36,6 +36,8 @@
 
 #include <ndn-cxx/mgmt/nfd/control-command.hpp>
 
+#include <vector>
+
 namespace nlsr::update {
 
 class AdvertisePrefixCommand : public ndn::nfd::ControlCommand<AdvertisePrefixCommand>
@@ -48,6 +50,37 @@ class WithdrawPrefixCommand : public ndn::nfd::ControlCommand<WithdrawPrefixComm
   NDN_CXX_CONTROL_COMMAND("prefix-update", "withdraw");
 };
 
+/*! \brief Advertises a batch of name prefixes with a single new Name LSA.
+ *
+ * The Name parameter carries the prefixes, see encodePrefixBatch.
+ */
+class AdvertisePrefixBatchCommand : public ndn::nfd::ControlCommand<AdvertisePrefixBatchCommand>
+{
+  NDN_CXX_CONTROL_COMMAND("prefix-update", "advertise-batch");
+};
+
+/*! \brief Withdraws a batch of name prefixes with a single new Name LSA.
+ *
+ * The Name parameter carries the prefixes, see encodePrefixBatch.
+ */
+class WithdrawPrefixBatchCommand : public ndn::nfd::ControlCommand<WithdrawPrefixBatchCommand>
+{
+  NDN_CXX_CONTROL_COMMAND("prefix-update", "withdraw-batch");
+};
+
+/*! \brief Encodes name prefixes into the Name parameter of a batch command.
+ *
+ * Each component of the returned name holds the TLV encoding of one prefix.
+ */
+ndn::Name
+encodePrefixBatch(const std::vector<ndn::Name>& prefixes);
+
+/*! \brief Decodes the name prefixes of the Name parameter of a batch command.
+ * \throw ndn::tlv::Error a component does not hold an encoded name
+ */
+std::vector<ndn::Name>
+decodePrefixBatch(const ndn::Name& batch);
+
 } // namespace nlsr::update
 
 #endif // NLSR_UPDATE_PREFIX_UPDATE_COMMANDS_HPP
@@ -24,7 +24,12 @@
 #include "prefix-update-commands.hpp"
 
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/post.hpp>
+
+#include <algorithm>
+#include <filesystem>
 #include <fstream>
+#include <sstream>
 
 namespace nlsr::update {
 
@@ -65,6 +70,30 @@ PrefixUpdateProcessor::PrefixUpdateProcessor(ndn::mgmt::Dispatcher& dispatcher,
     makeAuthorization(),
     // the first and second arguments are ignored since the handler does not need them
     std::bind(&PrefixUpdateProcessor::withdrawAndRemovePrefix, this, _3, _4));
+
+  m_dispatcher.addControlCommand<AdvertisePrefixBatchCommand>(
+    makeAuthorization(),
+    std::bind(&PrefixUpdateProcessor::advertisePrefixBatch, this, _3, _4));
+
+  m_dispatcher.addControlCommand<WithdrawPrefixBatchCommand>(
+    makeAuthorization(),
+    std::bind(&PrefixUpdateProcessor::withdrawPrefixBatch, this, _3, _4));
+}
+
+PrefixUpdateProcessor::~PrefixUpdateProcessor()
+{
+  if (m_writer) {
+    // pending writes complete; their commands are not answered
+    m_writer->join();
+  }
+}
+
+void
+PrefixUpdateProcessor::enableWriterThread()
+{
+  if (!m_writer) {
+    m_writer = std::make_unique<boost::asio::thread_pool>(1);
+  }
 }
 
 ndn::mgmt::Authorization
@@ -96,78 +125,205 @@ PrefixUpdateProcessor::loadValidator(boost::property_tree::ptree section,
   m_validator.load(section, filename);
 }
 
-bool
-PrefixUpdateProcessor::checkForPrefixInFile(const std::string prefix)
+/** \brief obtain the prefix saved by a line of the advertising section, if any
+ */
+static std::optional<ndn::Name>
+parsePrefixLine(const std::string& line)
 {
-  std::string line;
-  std::fstream fp(m_confFileNameDynamic);
-  if (!fp.good() || !fp.is_open()) {
-    NLSR_LOG_ERROR("Failed to open configuration file for parsing");
-    return true;
+  std::istringstream iss(line);
+  std::string key, uri;
+  if (!(iss >> key >> uri) || key != "prefix") {
+    return std::nullopt;
   }
-  while (!fp.eof()) {
-    getline(fp, line);
-    if (line == prefix) {
-      return true;
-    }
+  try {
+    return ndn::Name(uri);
+  }
+  catch (const std::exception&) {
+    return std::nullopt;
   }
-  return false;
 }
 
-std::tuple<bool, std::string>
-PrefixUpdateProcessor::addOrDeletePrefix(const ndn::Name& prefix, bool addPrefix)
+bool
+PrefixUpdateProcessor::loadConfFile()
 {
-  std::string value = " prefix " + prefix.toUri();
-  std::string fileString;
-  std::string line;
-  std::string trimedLine;
-  std::fstream input(m_confFileNameDynamic, input.in);
+  if (!m_loadedConfFileName.empty() && m_loadedConfFileName == m_confFileNameDynamic) {
+    return true;
+  }
+
+  std::ifstream input(m_confFileNameDynamic);
   if (!input.good() || !input.is_open()) {
     NLSR_LOG_ERROR("Failed to open configuration file for parsing");
-    return {false, "Failed to open configuration file for parsing"};
+    return false;
   }
 
-  if (addPrefix) {
-    //check if prefix already exist in the nlsr configuration file
-    if (checkForPrefixInFile(value)) {
-      NLSR_LOG_ERROR("Prefix already exists in the configuration file");
-      return {false, "Prefix already exists in the configuration file"};
+  m_confFileLines.clear();
+  m_savedPrefixes.clear();
+  m_hasAdvertisingSection = false;
+  bool isInAdvertising = false;
+  std::string line;
+  while (std::getline(input, line)) {
+    if (line.empty()) {
+      continue;
     }
-    while (!input.eof()) {
-      getline(input, line);
+    m_confFileLines.push_back(line);
+    std::string trimmedLine = boost::trim_copy(line);
+
+    if (trimmedLine == "advertising" && !m_hasAdvertisingSection) {
+      // prefixes are inserted after the opening brace on the next line
+      while (std::getline(input, line) && line.empty()) {
+      }
       if (!line.empty()) {
-        fileString.append(line + "\n");
-        if (line == "advertising") {
-          getline(input, line);
-          fileString.append(line + "\n" + value + "\n");
-        }
+        m_confFileLines.push_back(line);
+      }
+      m_advertisingLine = m_confFileLines.size();
+      m_hasAdvertisingSection = true;
+      isInAdvertising = true;
+    }
+    else if (isInAdvertising && boost::starts_with(trimmedLine, "}")) {
+      isInAdvertising = false;
+    }
+    else if (isInAdvertising) {
+      if (auto prefix = parsePrefixLine(trimmedLine); prefix) {
+        m_savedPrefixes.insert(*prefix);
       }
     }
   }
-  else {
-    if (!checkForPrefixInFile(value)) {
-      NLSR_LOG_ERROR("Prefix doesn't exists in the configuration file");
-      return {false, "Prefix doesn't exists in the configuration file"};
+
+  m_loadedConfFileName = m_confFileNameDynamic;
+  NLSR_LOG_DEBUG("Loaded " << m_savedPrefixes.size() << " saved prefixes from "
+                 << m_loadedConfFileName);
+  return true;
+}
+
+bool
+PrefixUpdateProcessor::writeConfFile(const std::string& fileName,
+                                     const std::vector<std::string>& lines)
+{
+  // written next to the configuration file, then moved over it
+  std::string tmpFileName = fileName + ".tmp";
+  {
+    std::ofstream output(tmpFileName);
+    for (const auto& line : lines) {
+      output << line << "\n";
     }
-    boost::trim(value);
-    while (!input.eof()) {
-      getline(input, line);
-      if (!line.empty()) {
-        std::string trimLine = line;
-        boost::trim(trimLine);
-        if (trimLine != value) {
-          fileString.append(line + "\n");
-        }
+    output.flush();
+    if (!output.good()) {
+      NLSR_LOG_ERROR("Failed to write " << tmpFileName);
+      return false;
+    }
+  }
+
+  std::error_code ec;
+  std::filesystem::rename(tmpFileName, fileName, ec);
+  if (ec) {
+    NLSR_LOG_ERROR("Failed to replace " << fileName << ": " << ec.message());
+    return false;
+  }
+  return true;
+}
+
+bool
+PrefixUpdateProcessor::checkForPrefixInFile(const ndn::Name& prefix)
+{
+  if (!loadConfFile()) {
+    return true;
+  }
+  return m_savedPrefixes.count(prefix) > 0;
+}
+
+std::tuple<bool, std::string>
+PrefixUpdateProcessor::editConfFile(const std::vector<ndn::Name>& prefixes, bool addPrefix,
+                                    bool& isChanged)
+{
+  isChanged = false;
+  if (!loadConfFile()) {
+    return {false, "Failed to open configuration file for parsing"};
+  }
+  if (addPrefix && !m_hasAdvertisingSection) {
+    NLSR_LOG_ERROR("No advertising section in the configuration file");
+    return {false, "No advertising section in the configuration file"};
+  }
+
+  std::string error;
+  for (const auto& prefix : prefixes) {
+    if (addPrefix) {
+      //check if prefix already exist in the nlsr configuration file
+      if (!m_savedPrefixes.insert(prefix).second) {
+        NLSR_LOG_ERROR("Prefix already exists in the configuration file");
+        error = "Prefix already exists in the configuration file";
+        continue;
       }
+      m_confFileLines.insert(m_confFileLines.begin() + m_advertisingLine,
+                             " prefix " + prefix.toUri());
     }
+    else {
+      if (m_savedPrefixes.erase(prefix) == 0) {
+        NLSR_LOG_ERROR("Prefix doesn't exists in the configuration file");
+        error = "Prefix doesn't exists in the configuration file";
+        continue;
+      }
+      auto line = std::find_if(m_confFileLines.begin() + m_advertisingLine, m_confFileLines.end(),
+        [&prefix] (const std::string& line) { return parsePrefixLine(line) == prefix; });
+      if (line != m_confFileLines.end()) {
+        m_confFileLines.erase(line);
+      }
+    }
+    isChanged = true;
+  }
+
+  if (!error.empty()) {
+    return {false, error};
   }
-  input.close();
-  std::ofstream output(m_confFileNameDynamic);
-  output << fileString;
-  output.close();
   return {true, "OK"};
 }
 
+std::tuple<bool, std::string>
+PrefixUpdateProcessor::addOrDeletePrefixes(const std::vector<ndn::Name>& prefixes, bool addPrefix)
+{
+  bool isChanged = false;
+  auto result = editConfFile(prefixes, addPrefix, isChanged);
+  if (isChanged && !writeConfFile(m_confFileNameDynamic, m_confFileLines)) {
+    // the file is read again by the next command
+    m_loadedConfFileName.clear();
+    return {false, "Failed to write configuration file"};
+  }
+  return result;
+}
+
+void
+PrefixUpdateProcessor::savePrefixes(const std::vector<ndn::Name>& prefixes, bool isAdvertise,
+                                    const SaveContinuation& done)
+{
+  if (!m_writer) {
+    return CommandProcessor::savePrefixes(prefixes, isAdvertise, done);
+  }
+
+  bool isChanged = false;
+  auto [isSaved, message] = editConfFile(prefixes, isAdvertise, isChanged);
+  if (!isChanged) {
+    return done(isSaved, message);
+  }
+
+  // Only copies are handed to the writer, which touches nothing else.
+  boost::asio::post(*m_writer,
+    [this, fileName = m_confFileNameDynamic, lines = m_confFileLines, isSaved = isSaved,
+     message = message, done, &io = m_lsdb.getIoContext(),
+     token = std::weak_ptr<int>(m_lifetimeToken)] {
+      bool isWritten = writeConfFile(fileName, lines);
+      boost::asio::post(io, [=] {
+        if (token.expired()) {
+          return;
+        }
+        if (!isWritten) {
+          // the file is read again by the next command
+          m_loadedConfFileName.clear();
+          return done(false, "Failed to write configuration file");
+        }
+        done(isSaved, message);
+      });
+    });
+}
+
 std::tuple<bool, std::string>
 PrefixUpdateProcessor::afterAdvertise(const ndn::Name& prefix)
 {
@@ -180,4 +336,16 @@ PrefixUpdateProcessor::afterWithdraw(const ndn::Name& prefix)
   return addOrDeletePrefix(prefix, false);
 }
 
+std::tuple<bool, std::string>
+PrefixUpdateProcessor::afterAdvertiseBatch(const std::vector<ndn::Name>& prefixes)
+{
+  return addOrDeletePrefixes(prefixes, true);
+}
+
+std::tuple<bool, std::string>
+PrefixUpdateProcessor::afterWithdrawBatch(const std::vector<ndn::Name>& prefixes)
+{
+  return addOrDeletePrefixes(prefixes, false);
+}
+
 } // namespace nlsr::update
@@ -26,8 +26,11 @@
 
 #include <ndn-cxx/security/key-chain.hpp>
 
+#include <boost/asio/thread_pool.hpp>
 #include <boost/property_tree/ptree.hpp>
 
+#include <unordered_set>
+
 namespace nlsr::update {
 
 using ConfigSection = boost::property_tree::ptree;
@@ -40,6 +43,19 @@ public:
                         NamePrefixList& namePrefixList,
                         Lsdb& lsdb, const std::string& configFileName);
 
+  ~PrefixUpdateProcessor() override;
+
+  /*! \brief Write the configuration file on a thread of its own.
+   *
+   * Saved prefixes are still looked up and edited in memory on the io thread, and each
+   * command is answered once its edit is written. Writes are made in the order of the
+   * commands.
+   *
+   * \sa nlsr::ConfParameter::getManagementThread
+   */
+  void
+  enableWriterThread();
+
   /*! \brief Load the validator's configuration from a section of a
    * configuration file.
    * \sa ConfFileProcessor::processConfFile
@@ -58,7 +74,20 @@ public:
    * configuration file
    */
   std::tuple<bool, std::string>
-  addOrDeletePrefix(const ndn::Name& prefix, bool addPrefix);
+  addOrDeletePrefix(const ndn::Name& prefix, bool addPrefix)
+  {
+    return addOrDeletePrefixes({prefix}, addPrefix);
+  }
+
+  /*! \brief Add or delete advertised or withdrawn prefixes to the nlsr
+   * configuration file
+   *
+   * The configuration file is read once, and the saved prefixes are then looked up in
+   * memory. The file is rewritten atomically, once for all prefixes, and only if they
+   * change it. Prefixes that are already saved, or not saved, are skipped with an error.
+   */
+  std::tuple<bool, std::string>
+  addOrDeletePrefixes(const std::vector<ndn::Name>& prefixes, bool addPrefix);
 
   /*! \brief Save an advertised prefix to the nlsr configuration file.
    *  \return tuple {bool indicating success/failure, message string}.
@@ -72,9 +101,19 @@ public:
   std::tuple<bool, std::string>
   afterWithdraw(const ndn::Name& prefix) override;
 
+  std::tuple<bool, std::string>
+  afterAdvertiseBatch(const std::vector<ndn::Name>& prefixes) override;
+
+  std::tuple<bool, std::string>
+  afterWithdrawBatch(const std::vector<ndn::Name>& prefixes) override;
+
+  void
+  savePrefixes(const std::vector<ndn::Name>& prefixes, bool isAdvertise,
+               const SaveContinuation& done) override;
+
   /*! \brief Check if a prefix exists in the nlsr configuration file */
   bool
-  checkForPrefixInFile(const std::string prefix);
+  checkForPrefixInFile(const ndn::Name& prefix);
 
   ndn::security::ValidatorConfig&
   getValidator()
@@ -92,9 +131,37 @@ private:
   ndn::mgmt::Authorization
   makeAuthorization();
 
+  /*! \brief Read the configuration file, unless it was already read.
+   */
+  bool
+  loadConfFile();
+
+  /*! \brief Add or delete prefixes in the configuration file read in memory.
+   *  \param[out] isChanged whether the file is to be written
+   */
+  std::tuple<bool, std::string>
+  editConfFile(const std::vector<ndn::Name>& prefixes, bool addPrefix, bool& isChanged);
+
+  /*! \brief Write the lines of a configuration file atomically; called from any thread.
+   */
+  static bool
+  writeConfFile(const std::string& fileName, const std::vector<std::string>& lines);
+
 private:
   ndn::security::ValidatorConfig& m_validator;
   const std::string& m_confFileNameDynamic;
+
+  // non-empty lines of the configuration file, read from m_loadedConfFileName
+  std::vector<std::string> m_confFileLines;
+  std::string m_loadedConfFileName;
+  // first line of the advertising section, where saved prefixes are inserted
+  size_t m_advertisingLine = 0;
+  bool m_hasAdvertisingSection = false;
+  std::unordered_set<ndn::Name> m_savedPrefixes;
+
+  std::unique_ptr<boost::asio::thread_pool> m_writer;
+  // completions of writes posted after destruction are dropped
+  std::shared_ptr<int> m_lifetimeToken = std::make_shared<int>(0);
 };
 
 } // namespace nlsr::update
@@ -27,17 +27,21 @@
 
 namespace nlsr::util {
 
+/*! \brief The LSA component of LSA names and of their sync update names, encoded once to be
+           searched in every received name.
+ */
+inline const ndn::name::Component LSA_COMPONENT{"LSA"};
+
 /*!
    \brief search a name component in ndn::Name and return the position of the component
-   \param name         where to search the searchString
-   \param searchString the string to search in name
-   \return -1 if searchString not found else return the position
+   \param name      where to search the component
+   \param component the component to search in name
+   \return -1 if component not found else return the position
    starting from 0
  */
 inline int32_t
-getNameComponentPosition(const ndn::Name& name, const std::string& searchString)
+getNameComponentPosition(const ndn::Name& name, const ndn::name::Component& component)
 {
-  ndn::name::Component component(searchString);
   size_t nameSize = name.size();
   for (uint32_t i = 0; i < nameSize; i++) {
     if (component == name[i]) {
@@ -47,6 +51,19 @@ getNameComponentPosition(const ndn::Name& name, const std::string& searchString)
   return -1;
 }
 
+/*!
+   \brief search a name component in ndn::Name and return the position of the component
+   \param name         where to search the searchString
+   \param searchString the string to search in name
+   \return -1 if searchString not found else return the position
+   starting from 0
+ */
+inline int32_t
+getNameComponentPosition(const ndn::Name& name, const std::string& searchString)
+{
+  return getNameComponentPosition(name, ndn::name::Component(searchString));
+}
+
 } // namespace nlsr::util
 
 #endif // NLSR_NAME_HELPER_HPP
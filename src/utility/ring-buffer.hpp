@@ -0,0 +1,114 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_UTILITY_RING_BUFFER_HPP
+#define NLSR_UTILITY_RING_BUFFER_HPP
+
+#include <array>
+#include <cstddef>
+
+namespace nlsr::util {
+
+/*! \brief Fixed-capacity FIFO of the last N values pushed.
+ *
+ * The values are stored inline, so pushing never allocates; once full, each push
+ * overwrites the oldest value.
+ */
+template<typename T, size_t N>
+class RingBuffer
+{
+public:
+  static_assert(N > 0);
+
+  /*! \brief Append \p value, evicting the oldest value if the buffer is full.
+   */
+  void
+  push_back(const T& value)
+  {
+    m_values[(m_begin + m_size) % N] = value;
+    if (m_size < N) {
+      ++m_size;
+    }
+    else {
+      m_begin = (m_begin + 1) % N;
+    }
+  }
+
+  /*! \brief Return the \p i -th value, from the oldest one.
+   */
+  const T&
+  operator[](size_t i) const
+  {
+    return m_values[(m_begin + i) % N];
+  }
+
+  const T&
+  front() const
+  {
+    return (*this)[0];
+  }
+
+  const T&
+  back() const
+  {
+    return (*this)[m_size - 1];
+  }
+
+  size_t
+  size() const
+  {
+    return m_size;
+  }
+
+  bool
+  empty() const
+  {
+    return m_size == 0;
+  }
+
+  bool
+  full() const
+  {
+    return m_size == N;
+  }
+
+  static constexpr size_t
+  capacity()
+  {
+    return N;
+  }
+
+  void
+  clear()
+  {
+    m_begin = 0;
+    m_size = 0;
+  }
+
+private:
+  std::array<T, N> m_values{};
+  size_t m_begin = 0;
+  size_t m_size = 0;
+};
+
+} // namespace nlsr::util
+
+#endif // NLSR_UTILITY_RING_BUFFER_HPP
@@ -0,0 +1,303 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file emulation.cpp
+
+  Runs a network of NLSR routers in one process on virtual time (see EmulatedNetwork), and
+  measures how it converges after topology events. The routers first converge from a cold
+  start; then, unless a script is given, random links fail and are restored one at a time.
+  A script has "<seconds> link-down|link-up <router> <router>" lines, with times from the start
+  and routers numbered from 0.
+
+  After each event, the network runs for a fixed window, and the time of the last routing
+  table change is taken as its convergence time.
+ */
+
+#include "tests/benchmarks/topology.hpp"
+#include "tests/emulated-network.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <iostream>
+
+namespace nlsr::bench {
+
+using Clock = std::chrono::steady_clock;
+using tests::EmulatedNetwork;
+
+struct Options
+{
+  std::string topology = "grid";
+  size_t nRouters = 100;
+  unsigned seed = 1;
+  ndn::time::milliseconds delay{10};
+  double lossRate = 0.0;
+  ndn::time::milliseconds tick{10};
+  ndn::time::seconds window{180};
+  size_t nFailures = 3;
+  std::string scriptFile;
+};
+
+struct Event
+{
+  ndn::time::seconds time;
+  bool isUp;
+  size_t a;
+  size_t b;
+};
+
+static std::vector<Event>
+readScript(const std::string& fileName)
+{
+  std::ifstream file(fileName);
+  if (!file) {
+    throw std::runtime_error("Cannot open " + fileName);
+  }
+
+  std::vector<Event> events;
+  uint64_t seconds;
+  std::string action;
+  size_t a, b;
+  while (file >> seconds >> action >> a >> b) {
+    if (action != "link-down" && action != "link-up") {
+      throw std::runtime_error("Unknown action " + action);
+    }
+    events.push_back({ndn::time::seconds(seconds), action == "link-up", a, b});
+  }
+  std::stable_sort(events.begin(), events.end(),
+                   [] (const auto& x, const auto& y) { return x.time < y.time; });
+  return events;
+}
+
+static double
+toSeconds(ndn::time::nanoseconds duration)
+{
+  return static_cast<double>(duration.count()) / 1e9;
+}
+
+class Benchmark
+{
+public:
+  Benchmark(const Options& options, const Topology& topo)
+    : m_options(options)
+    , m_topo(topo)
+    , m_network(options.seed)
+  {
+    for (size_t i = 0; i < topo.nRouters; ++i) {
+      m_network.addRouter();
+    }
+    for (const auto& edge : topo.edges) {
+      m_network.addLink(edge.a, edge.b, edge.cost, options.delay, options.lossRate);
+    }
+  }
+
+  void
+  run()
+  {
+    m_network.start();
+    runWindow("start", m_startTime, m_options.window);
+
+    if (!m_options.scriptFile.empty()) {
+      auto events = readScript(m_options.scriptFile);
+      for (size_t i = 0; i < events.size(); ++i) {
+        const auto& event = events[i];
+        auto now = ndn::time::steady_clock::now();
+        if (m_startTime + event.time > now) {
+          m_network.advanceClocks(m_options.tick, m_startTime + event.time - now);
+          now = ndn::time::steady_clock::now();
+        }
+        // an event is followed by the next one, or by a window if it is the last
+        auto end = i + 1 < events.size() ? m_startTime + events[i + 1].time
+                                         : now + m_options.window;
+        applyEvent(event.a, event.b, event.isUp,
+                   std::max<ndn::time::nanoseconds>(end - now, ndn::time::nanoseconds::zero()));
+      }
+      return;
+    }
+
+    std::mt19937 rng(m_options.seed);
+    for (size_t i = 0; i < m_options.nFailures && !m_topo.edges.empty(); ++i) {
+      const auto& edge = m_topo.edges[std::uniform_int_distribution<size_t>(
+                                        0, m_topo.edges.size() - 1)(rng)];
+      applyEvent(edge.a, edge.b, false, m_options.window);
+      applyEvent(edge.a, edge.b, true, m_options.window);
+    }
+  }
+
+private:
+  void
+  applyEvent(size_t a, size_t b, bool isUp, ndn::time::nanoseconds window)
+  {
+    auto time = ndn::time::steady_clock::now();
+    m_network.setLinkUp(a, b, isUp);
+    runWindow(std::string(isUp ? "link-up " : "link-down ") + std::to_string(a) + " " +
+              std::to_string(b), time, window);
+  }
+
+  /** Runs the network for @p window after an event at @p eventTime, and prints a row. */
+  void
+  runWindow(const std::string& event, ndn::time::steady_clock::time_point eventTime,
+            ndn::time::nanoseconds window)
+  {
+    std::vector<ndn::time::nanoseconds> cpuBefore(m_network.size());
+    for (size_t i = 0; i < m_network.size(); ++i) {
+      cpuBefore[i] = m_network.getCpuTime(i);
+    }
+    m_network.resetStatistics();
+
+    auto wallStart = Clock::now();
+    m_network.advanceClocks(m_options.tick, window);
+    double wallTime = std::chrono::duration<double>(Clock::now() - wallStart).count();
+
+    ndn::time::nanoseconds convergence{0};
+    ndn::time::nanoseconds totalCpu{0};
+    ndn::time::nanoseconds maxCpu{0};
+    for (size_t i = 0; i < m_network.size(); ++i) {
+      convergence = std::max(convergence, m_network.getLastRouteChange(i) - eventTime);
+      auto cpu = m_network.getCpuTime(i) - cpuBefore[i];
+      totalCpu += cpu;
+      maxCpu = std::max(maxCpu, cpu);
+    }
+
+    const auto& stats = m_network.getStatistics();
+    uint64_t nInterests = 0;
+    uint64_t nData = 0;
+    for (size_t c = 0; c < EmulatedNetwork::N_CATEGORIES; ++c) {
+      nInterests += stats.nInterests[c];
+      nData += stats.nData[c];
+    }
+
+    std::cout << toSeconds(eventTime - m_startTime) << '\t'
+              << event << '\t' << m_network.isConverged() << '\t'
+              << toSeconds(convergence) << '\t'
+              << nInterests << '\t' << nData << '\t'
+              << stats.nInterests[EmulatedNetwork::CATEGORY_NEIGHBOR] << '\t'
+              << stats.nInterests[EmulatedNetwork::CATEGORY_SYNC] << '\t'
+              << stats.nInterests[EmulatedNetwork::CATEGORY_LSA] << '\t'
+              << stats.nLost << '\t'
+              << toSeconds(totalCpu) * 1000 << '\t' << toSeconds(maxCpu) * 1000 << '\t'
+              << wallTime << std::endl;
+  }
+
+private:
+  const Options& m_options;
+  const Topology& m_topo;
+  EmulatedNetwork m_network;
+  const ndn::time::steady_clock::time_point m_startTime = ndn::time::steady_clock::now();
+};
+
+static void
+printUsage(const char* programName)
+{
+  std::cerr << "Usage: " << programName << " [-t topology] [-n routers] [-s seed] [-d delay]"
+            << " [-l loss] [-k tick] [-w window] [-e failures] [-f script]\n"
+               "\n"
+               "  -t  grid (default), waxman, scale-free, or file:PATH of 'router router cost' lines\n"
+               "  -n  number of routers of a synthetic topology (default 100)\n"
+               "  -s  random seed (default 1)\n"
+               "  -d  link delay in ms (default 10)\n"
+               "  -l  packet loss rate of each link (default 0)\n"
+               "  -k  virtual clock tick in ms (default 10)\n"
+               "  -w  virtual seconds run after each event (default 180)\n"
+               "  -e  random link failures, each restored after the window (default 3)\n"
+               "  -f  script of link events, instead of random failures\n"
+               "\n"
+               "Output columns: event time s, event, converged, convergence s, Interests, Data,\n"
+               "neighbor Interests, sync Interests, LSA Interests, lost packets,\n"
+               "CPU ms of all routers, max CPU ms of a router, wall-clock s\n";
+}
+
+} // namespace nlsr::bench
+
+int
+main(int argc, char** argv)
+{
+  using namespace nlsr::bench;
+
+  Options options;
+  int opt;
+  while ((opt = ::getopt(argc, argv, "ht:n:s:d:l:k:w:e:f:")) != -1) {
+    switch (opt) {
+    case 't':
+      options.topology = ::optarg;
+      break;
+    case 'n':
+      options.nRouters = std::stoul(::optarg);
+      break;
+    case 's':
+      options.seed = static_cast<unsigned>(std::stoul(::optarg));
+      break;
+    case 'd':
+      options.delay = ndn::time::milliseconds(std::stoul(::optarg));
+      break;
+    case 'l':
+      options.lossRate = std::stod(::optarg);
+      break;
+    case 'k':
+      options.tick = ndn::time::milliseconds(std::max<unsigned long>(1, std::stoul(::optarg)));
+      break;
+    case 'w':
+      options.window = ndn::time::seconds(std::stoul(::optarg));
+      break;
+    case 'e':
+      options.nFailures = std::stoul(::optarg);
+      break;
+    case 'f':
+      options.scriptFile = ::optarg;
+      break;
+    case 'h':
+      printUsage(argv[0]);
+      return 0;
+    default:
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+
+  try {
+    std::mt19937 rng(options.seed);
+    Topology topo;
+    if (options.topology == "grid") {
+      topo = makeGrid(options.nRouters, rng);
+    }
+    else if (options.topology == "waxman") {
+      topo = makeWaxman(options.nRouters, rng);
+    }
+    else if (options.topology == "scale-free") {
+      topo = makeScaleFree(options.nRouters, rng);
+    }
+    else if (options.topology.rfind("file:", 0) == 0) {
+      topo = readTopology(options.topology.substr(5));
+    }
+    else {
+      printUsage(argv[0]);
+      return 2;
+    }
+
+    Benchmark(options, topo).run();
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,445 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file hot-paths.cpp
+
+  Measures the operations that run for every received LSA or route change, each on its own:
+  - lsdb-install, lsdb-remove: Lsdb::installLsa() and removeLsa() of Name LSAs, which also
+    update the NPT;
+  - npt-add: NamePrefixTable::addEntry() of prefixes of known routers;
+  - npt-update: NamePrefixTable::updateWithNewRoute() with a route to every router;
+  - fib-update: Fib::update() of new prefixes, then of the same prefixes with other next hops;
+    the face is a DummyClientFace, so that NFD commands are queued but not answered;
+  - name-lsa-encode, name-lsa-decode, adj-lsa-encode, adj-lsa-decode: LSA TLV encoding;
+  - nexthop-add, nexthop-remove: NexthopList::addNextHop() and removeNextHop();
+  - rtt-sample: LinkCostManager handling Hello RTT samples of active neighbors.
+  Each case is repeated, and the median time per operation is reported.
+ */
+
+#include "nlsr.hpp"
+
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <map>
+
+namespace nlsr::bench {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+  std::string benchCase = "all";
+  size_t scale = 1000;
+  size_t nNeighbors = 8;
+  size_t nRepetitions = 5;
+};
+
+static ndn::Name
+getRouterName(size_t i)
+{
+  return ndn::Name("/ndn/site/%C1.Router").append("r" + std::to_string(i));
+}
+
+static ndn::FaceUri
+getFaceUri(size_t i)
+{
+  return ndn::FaceUri("udp4://10." + std::to_string((i >> 16) & 0xFF) + "." +
+                      std::to_string((i >> 8) & 0xFF) + "." + std::to_string(i & 0xFF) + ":6363");
+}
+
+template<typename F>
+static double
+measure(F&& f)
+{
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+static double
+median(std::vector<double> samples)
+{
+  std::sort(samples.begin(), samples.end());
+  return samples.empty() ? 0.0 : samples[samples.size() / 2];
+}
+
+class Benchmark
+{
+public:
+  explicit
+  Benchmark(const Options& options)
+    : m_options(options)
+    , m_face(m_io, m_keyChain)
+    , m_conf(m_face, m_keyChain)
+  {
+    m_conf.setNetwork("/ndn");
+    m_conf.setSiteName("/site");
+    m_conf.setRouterName(ndn::Name("/%C1.Router").append("r0"));
+    m_conf.buildRouterAndSyncUserPrefix();
+    m_conf.setStateFileDir(std::filesystem::temp_directory_path().string());
+    m_conf.setRttSource(RttSource::HELLO);
+    for (size_t i = 1; i <= options.nNeighbors; ++i) {
+      m_conf.getAdjacencyList().insert(Adjacent(getRouterName(i), getFaceUri(i), 10,
+                                                Adjacent::STATUS_ACTIVE, 0, 0));
+    }
+
+    m_nlsr = std::make_unique<Nlsr>(m_face, m_keyChain, m_conf);
+
+    m_cases = {
+      {"lsdb", [this] { runLsdb(); }},
+      {"npt", [this] { runNpt(); }},
+      {"fib", [this] { runFib(); }},
+      {"lsa", [this] { runLsaEncoding(); }},
+      {"nexthop", [this] { runNexthopList(); }},
+      {"rtt-sample", [this] { runRttSample(); }},
+    };
+  }
+
+  void
+  run()
+  {
+    if (m_options.benchCase == "all") {
+      for (const auto& [name, run] : m_cases) {
+        run();
+      }
+      return;
+    }
+
+    auto it = m_cases.find(m_options.benchCase);
+    if (it == m_cases.end()) {
+      throw std::invalid_argument("Unknown case " + m_options.benchCase);
+    }
+    it->second();
+  }
+
+private:
+  /** Times @p f, which performs @p nOperations operations, after @p setup in each repetition,
+      and prints the median time per operation. */
+  void
+  report(const std::string& name, size_t nOperations, const std::function<void()>& setup,
+         const std::function<void()>& f)
+  {
+    std::vector<double> samples;
+    for (size_t i = 0; i < m_options.nRepetitions; ++i) {
+      setup();
+      samples.push_back(measure(f) / std::max<size_t>(1, nOperations));
+      drainFace();
+    }
+    std::cout << name << '\t' << nOperations << '\t' << median(samples) << std::endl;
+  }
+
+  /** Discards the NFD commands queued by the FIB, outside of the timed section. */
+  void
+  drainFace()
+  {
+    m_io.poll();
+    m_io.restart();
+    m_face.sentInterests.clear();
+  }
+
+  std::vector<std::shared_ptr<NameLsa>>
+  makeNameLsas(uint64_t seqNo) const
+  {
+    std::vector<std::shared_ptr<NameLsa>> lsas;
+    for (size_t i = 1; i <= m_options.scale; ++i) {
+      auto router = getRouterName(i);
+      NamePrefixList prefixes{ndn::Name(router).append("prefix")};
+      lsas.push_back(std::make_shared<NameLsa>(router, seqNo, MAX_TIME, prefixes));
+    }
+    return lsas;
+  }
+
+  void
+  runLsdb()
+  {
+    auto& lsdb = m_nlsr->m_lsdb;
+    uint64_t seqNo = 0;
+    std::vector<std::shared_ptr<NameLsa>> lsas;
+
+    report("lsdb-install", m_options.scale,
+      [&] { lsas = makeNameLsas(++seqNo); },
+      [&] {
+        for (const auto& lsa : lsas) {
+          lsdb.installLsa(lsa);
+        }
+      });
+
+    report("lsdb-remove", m_options.scale,
+      [&] {
+        for (const auto& lsa : makeNameLsas(++seqNo)) {
+          lsdb.installLsa(lsa);
+        }
+      },
+      [&] {
+        for (size_t i = 1; i <= m_options.scale; ++i) {
+          lsdb.removeLsa(getRouterName(i), Lsa::Type::NAME);
+        }
+      });
+  }
+
+  void
+  runNpt()
+  {
+    auto& npt = m_nlsr->m_namePrefixTable;
+    size_t nRouters = std::max<size_t>(1, m_options.scale / 10);
+
+    report("npt-add", m_options.scale,
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          npt.removeEntry(ndn::Name("/npt").appendNumber(i), getRouterName(i % nRouters + 1));
+        }
+      },
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          npt.addEntry(ndn::Name("/npt").appendNumber(i), getRouterName(i % nRouters + 1));
+        }
+      });
+
+    size_t round = 0;
+    std::list<RoutingTableEntry> routes;
+    report("npt-update", nRouters,
+      [&] {
+        // alternate the costs so that every entry changes
+        ++round;
+        routes.clear();
+        for (size_t i = 1; i <= nRouters; ++i) {
+          RoutingTableEntry entry(getRouterName(i));
+          for (size_t j = 1; j <= std::min<size_t>(m_options.nNeighbors, 3); ++j) {
+            entry.getNexthopList().addNextHop(NextHop(getFaceUri(j), double(j + round % 2)));
+          }
+          routes.push_back(std::move(entry));
+        }
+      },
+      [&] { npt.updateWithNewRoute(routes); });
+  }
+
+  void
+  runFib()
+  {
+    auto& fib = m_nlsr->m_fib;
+    auto makeHops = [this] (size_t first) {
+      NexthopList hops;
+      for (size_t j = 0; j < std::min<size_t>(m_options.nNeighbors, 3); ++j) {
+        hops.addNextHop(NextHop(getFaceUri((first + j) % m_options.nNeighbors + 1),
+                                double(10 + j)));
+      }
+      return hops;
+    };
+    NexthopList hops = makeHops(0);
+    NexthopList otherHops = makeHops(1);
+
+    report("fib-add", m_options.scale,
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          fib.remove(ndn::Name("/fib").appendNumber(i));
+        }
+        drainFace();
+      },
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          fib.update(ndn::Name("/fib").appendNumber(i), hops);
+        }
+      });
+
+    size_t round = 0;
+    report("fib-update", m_options.scale,
+      [] {},
+      [&] {
+        const auto& next = ++round % 2 == 1 ? otherHops : hops;
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          fib.update(ndn::Name("/fib").appendNumber(i), next);
+        }
+      });
+  }
+
+  void
+  runLsaEncoding()
+  {
+    NamePrefixList prefixes;
+    AdjacencyList adjacencies;
+    for (size_t i = 1; i <= m_options.nNeighbors; ++i) {
+      prefixes.insert(ndn::Name(getRouterName(0)).append("prefix").appendNumber(i));
+      adjacencies.insert(Adjacent(getRouterName(i), getFaceUri(i), 10,
+                                  Adjacent::STATUS_ACTIVE, 0, 0));
+    }
+    NameLsa nameLsa(getRouterName(0), 1, MAX_TIME, prefixes);
+    AdjLsa adjLsa(getRouterName(0), 1, MAX_TIME, adjacencies);
+
+    // the template wireEncode() does not cache the encoding
+    auto encode = [] (const auto& lsa) {
+      ndn::EncodingEstimator estimator;
+      ndn::EncodingBuffer buffer(lsa.wireEncode(estimator), 0);
+      lsa.wireEncode(buffer);
+      return buffer.block();
+    };
+    ndn::Block nameWire = encode(nameLsa);
+    ndn::Block adjWire = encode(adjLsa);
+
+    report("name-lsa-encode", m_options.scale, [] {},
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          encode(nameLsa);
+        }
+      });
+    report("name-lsa-decode", m_options.scale, [] {},
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          NameLsa lsa(nameWire);
+        }
+      });
+    report("adj-lsa-encode", m_options.scale, [] {},
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          encode(adjLsa);
+        }
+      });
+    report("adj-lsa-decode", m_options.scale, [] {},
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i) {
+          AdjLsa lsa(adjWire);
+        }
+      });
+  }
+
+  void
+  runNexthopList()
+  {
+    std::vector<NextHop> hops;
+    for (size_t i = 0; i < m_options.scale; ++i) {
+      hops.emplace_back(getFaceUri(i), double(i % 100));
+    }
+    NexthopList list;
+
+    report("nexthop-add", hops.size(),
+      [&] { list = NexthopList(); },
+      [&] {
+        for (const auto& hop : hops) {
+          list.addNextHop(hop);
+        }
+      });
+    report("nexthop-remove", hops.size(),
+      [&] {
+        for (const auto& hop : hops) {
+          list.addNextHop(hop);
+        }
+      },
+      [&] {
+        for (const auto& hop : hops) {
+          list.removeNextHop(hop);
+        }
+      });
+  }
+
+  void
+  runRttSample()
+  {
+    auto& manager = m_nlsr->getLinkCostManager();
+    manager.initialize();
+
+    size_t nSamples = 0;
+    report("rtt-sample", m_options.scale, [] {},
+      [&] {
+        for (size_t i = 0; i < m_options.scale; ++i, ++nSamples) {
+          auto rtt = ndn::time::milliseconds(20 + nSamples % 7);
+          manager.onHelloRttMeasured(getRouterName(i % m_options.nNeighbors + 1), rtt);
+        }
+      });
+  }
+
+private:
+  static constexpr ndn::time::system_clock::time_point MAX_TIME =
+    ndn::time::system_clock::time_point::max();
+
+  const Options& m_options;
+  boost::asio::io_context m_io;
+  ndn::KeyChain m_keyChain{"pib-memory:", "tpm-memory:"};
+  ndn::DummyClientFace m_face;
+  ConfParameter m_conf;
+  std::unique_ptr<Nlsr> m_nlsr;
+  std::map<std::string, std::function<void()>> m_cases;
+};
+
+static void
+printUsage(const char* programName)
+{
+  std::cerr << "Usage: " << programName << " [-c case] [-n scale] [-a neighbors]"
+            << " [-r repetitions]\n"
+               "\n"
+               "  -c  all (default), lsdb, npt, fib, lsa, nexthop or rtt-sample\n"
+               "  -n  number of LSAs, prefixes, next hops or samples per repetition"
+               " (default 1000)\n"
+               "  -a  number of neighbors (default 8)\n"
+               "  -r  repetitions, the median is reported (default 5)\n"
+               "\n"
+               "Output columns: operation, operations per repetition, ns per operation\n";
+}
+
+} // namespace nlsr::bench
+
+int
+main(int argc, char** argv)
+{
+  using namespace nlsr::bench;
+
+  Options options;
+  int opt;
+  while ((opt = ::getopt(argc, argv, "hc:n:a:r:")) != -1) {
+    switch (opt) {
+    case 'c':
+      options.benchCase = ::optarg;
+      break;
+    case 'n':
+      options.scale = std::max<size_t>(1, std::stoul(::optarg));
+      break;
+    case 'a':
+      options.nNeighbors = std::max<size_t>(1, std::stoul(::optarg));
+      break;
+    case 'r':
+      options.nRepetitions = std::max<size_t>(1, std::stoul(::optarg));
+      break;
+    case 'h':
+      printUsage(argv[0]);
+      return 0;
+    default:
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+
+  try {
+    Benchmark(options).run();
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
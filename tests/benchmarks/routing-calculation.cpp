@@ -0,0 +1,314 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file routing-calculation.cpp
+
+  Measures the routing calculators on synthetic topologies. Each run builds an LSDB holding
+  one Adjacency, Name and (for hyperbolic routing) Coordinate LSA per router, then times:
+  - spf: route calculation only, from an LSDB snapshot;
+  - calculate: RoutingTable::calculate(), which also updates the NPT and the FIB;
+  - recalculate: RoutingTable::calculate() after one link cost changed.
+  The peak resident set size of the process is reported as well; run one configuration per
+  process to attribute it.
+ */
+
+#include "nlsr.hpp"
+#include "route/routing-calculator.hpp"
+#include "tests/benchmarks/topology.hpp"
+
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <sys/resource.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <iostream>
+#include <random>
+
+namespace nlsr::bench {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+  std::string calculator = "link-state";
+  std::string topology = "grid";
+  size_t nRouters = 100;
+  uint32_t maxFacesPerPrefix = 1;
+  size_t nRepetitions = 5;
+  unsigned seed = 1;
+};
+
+static ndn::Name
+getRouterName(size_t i)
+{
+  return ndn::Name("/ndn/site/%C1.Router").append("r" + std::to_string(i));
+}
+
+static ndn::FaceUri
+getFaceUri(size_t i)
+{
+  return ndn::FaceUri("udp4://10." + std::to_string((i >> 16) & 0xFF) + "." +
+                      std::to_string((i >> 8) & 0xFF) + "." + std::to_string(i & 0xFF) + ":6363");
+}
+
+template<typename F>
+static double
+measure(F&& f)
+{
+  auto start = Clock::now();
+  f();
+  return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+}
+
+static double
+median(std::vector<double> samples)
+{
+  std::sort(samples.begin(), samples.end());
+  return samples.empty() ? 0.0 : samples[samples.size() / 2];
+}
+
+class Benchmark
+{
+public:
+  Benchmark(const Options& options, const Topology& topo)
+    : m_options(options)
+    , m_topo(topo)
+    , m_face(m_io, m_keyChain)
+    , m_conf(m_face, m_keyChain)
+  {
+    m_conf.setNetwork("/ndn");
+    m_conf.setSiteName("/site");
+    m_conf.setRouterName(ndn::Name("/%C1.Router").append("r0"));
+    m_conf.buildRouterAndSyncUserPrefix();
+    m_conf.setMaxFacesPerPrefix(options.maxFacesPerPrefix);
+    m_conf.setStateFileDir(std::filesystem::temp_directory_path().string());
+    if (options.calculator == "hyperbolic") {
+      m_conf.setHyperbolicState(HYPERBOLIC_STATE_ON);
+    }
+    else if (options.calculator == "load-aware") {
+      m_conf.setLoadAwareRouting(true);
+    }
+    else if (options.calculator == "ml-adaptive") {
+      m_conf.setMLAdaptiveRouting(true);
+    }
+    else if (options.calculator != "link-state") {
+      throw std::invalid_argument("Unknown calculator " + options.calculator);
+    }
+
+    m_nlsr = std::make_unique<Nlsr>(m_face, m_keyChain, m_conf);
+  }
+
+  void
+  run()
+  {
+    double setupTime = measure([this] { installLsas(); });
+
+    std::vector<double> spf, calculate, recalculate;
+    for (size_t i = 0; i < m_options.nRepetitions; ++i) {
+      if (m_options.calculator == "link-state") {
+        spf.push_back(measure([this] {
+          calculateLinkStateRoutes(makeLinkStateInput(m_nlsr->m_lsdb.getRouterMap(), m_conf,
+                                                      m_nlsr->m_lsdb));
+        }));
+      }
+      else if (m_options.calculator == "hyperbolic") {
+        spf.push_back(measure([this] {
+          auto lsaRange = m_nlsr->m_lsdb.getLsdbIterator<CoordinateLsa>();
+          auto map = NameMap::createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+          calculateHyperbolicRoutes(map, m_nlsr->m_lsdb, m_conf.getAdjacencyList(),
+                                    m_conf.getRouterPrefix());
+        }));
+      }
+
+      calculate.push_back(measure([this] { m_nlsr->m_routingTable.calculate(); }));
+
+      changeLinkCost(i);
+      recalculate.push_back(measure([this] { m_nlsr->m_routingTable.calculate(); }));
+    }
+
+    rusage usage{};
+    ::getrusage(RUSAGE_SELF, &usage);
+
+    std::cout << m_options.calculator << '\t' << m_options.topology << '\t'
+              << m_topo.nRouters << '\t' << m_topo.edges.size() << '\t'
+              << m_options.maxFacesPerPrefix << '\t' << setupTime << '\t';
+    if (spf.empty()) {
+      std::cout << '-';
+    }
+    else {
+      std::cout << median(spf);
+    }
+    std::cout << '\t' << median(calculate) << '\t' << median(recalculate) << '\t'
+              << usage.ru_maxrss << std::endl;
+  }
+
+private:
+  void
+  installLsas()
+  {
+    m_adjacencies.assign(m_topo.nRouters, {});
+    for (const auto& edge : m_topo.edges) {
+      m_adjacencies[edge.a].insert(Adjacent(getRouterName(edge.b), getFaceUri(edge.b), edge.cost,
+                                            Adjacent::STATUS_ACTIVE, 0, 0));
+      m_adjacencies[edge.b].insert(Adjacent(getRouterName(edge.a), getFaceUri(edge.a), edge.cost,
+                                            Adjacent::STATUS_ACTIVE, 0, 0));
+    }
+    for (const auto& adjacent : m_adjacencies[0].getAdjList()) {
+      m_conf.getAdjacencyList().insert(adjacent);
+    }
+
+    std::mt19937 rng(m_options.seed);
+    std::uniform_real_distribution<double> radius(10.0, 20.0);
+    std::uniform_real_distribution<double> angle(0.0, 2 * M_PI);
+    auto& lsdb = m_nlsr->m_lsdb;
+    for (size_t i = 0; i < m_topo.nRouters; ++i) {
+      auto router = getRouterName(i);
+      lsdb.installLsa(std::make_shared<AdjLsa>(router, 1, MAX_TIME, m_adjacencies[i]));
+      NamePrefixList prefixes{ndn::Name(router).append("prefix")};
+      lsdb.installLsa(std::make_shared<NameLsa>(router, 1, MAX_TIME, prefixes));
+      if (m_options.calculator == "hyperbolic") {
+        lsdb.installLsa(std::make_shared<CoordinateLsa>(router, 1, MAX_TIME, radius(rng),
+                                                        std::vector<double>{angle(rng)}));
+      }
+    }
+  }
+
+  /** Doubles the cost of one link, in both Adjacency LSAs */
+  void
+  changeLinkCost(size_t iteration)
+  {
+    if (m_topo.edges.empty()) {
+      return;
+    }
+    const auto& edge = m_topo.edges[(iteration * 7919) % m_topo.edges.size()];
+    for (auto [from, to] : {std::pair{edge.a, edge.b}, std::pair{edge.b, edge.a}}) {
+      auto adjacent = m_adjacencies[from].findAdjacent(getRouterName(to));
+      adjacent->setLinkCost(adjacent->getLinkCost() * 2);
+      m_nlsr->m_lsdb.installLsa(std::make_shared<AdjLsa>(getRouterName(from), ++m_seqNo,
+                                                         MAX_TIME, m_adjacencies[from]));
+    }
+  }
+
+private:
+  static constexpr ndn::time::system_clock::time_point MAX_TIME =
+    ndn::time::system_clock::time_point::max();
+
+  const Options& m_options;
+  const Topology& m_topo;
+  boost::asio::io_context m_io;
+  ndn::KeyChain m_keyChain{"pib-memory:", "tpm-memory:"};
+  ndn::DummyClientFace m_face;
+  ConfParameter m_conf;
+  std::unique_ptr<Nlsr> m_nlsr;
+  std::vector<AdjacencyList> m_adjacencies;
+  uint64_t m_seqNo = 1;
+};
+
+static void
+printUsage(const char* programName)
+{
+  std::cerr << "Usage: " << programName << " [-c calculator] [-t topology] [-n routers]"
+            << " [-m faces] [-r repetitions] [-s seed]\n"
+               "\n"
+               "  -c  link-state (default), hyperbolic, load-aware or ml-adaptive\n"
+               "  -t  grid (default), waxman, scale-free, or file:PATH of 'router router cost' lines\n"
+               "  -n  number of routers of a synthetic topology (default 100)\n"
+               "  -m  max-faces-per-prefix, 1 for single path (default); 0 for all\n"
+               "  -r  repetitions, the median is reported (default 5)\n"
+               "  -s  random seed (default 1)\n"
+               "\n"
+               "Output columns: calculator, topology, routers, links, faces, setup ms, spf ms,\n"
+               "calculate ms, recalculate ms, peak RSS KiB\n";
+}
+
+} // namespace nlsr::bench
+
+int
+main(int argc, char** argv)
+{
+  using namespace nlsr::bench;
+
+  Options options;
+  int opt;
+  while ((opt = ::getopt(argc, argv, "hc:t:n:m:r:s:")) != -1) {
+    switch (opt) {
+    case 'c':
+      options.calculator = ::optarg;
+      break;
+    case 't':
+      options.topology = ::optarg;
+      break;
+    case 'n':
+      options.nRouters = std::stoul(::optarg);
+      break;
+    case 'm':
+      options.maxFacesPerPrefix = static_cast<uint32_t>(std::stoul(::optarg));
+      break;
+    case 'r':
+      options.nRepetitions = std::max<size_t>(1, std::stoul(::optarg));
+      break;
+    case 's':
+      options.seed = static_cast<unsigned>(std::stoul(::optarg));
+      break;
+    case 'h':
+      printUsage(argv[0]);
+      return 0;
+    default:
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+
+  try {
+    std::mt19937 rng(options.seed);
+    Topology topo;
+    if (options.topology == "grid") {
+      topo = makeGrid(options.nRouters, rng);
+    }
+    else if (options.topology == "waxman") {
+      topo = makeWaxman(options.nRouters, rng);
+    }
+    else if (options.topology == "scale-free") {
+      topo = makeScaleFree(options.nRouters, rng);
+    }
+    else if (options.topology.rfind("file:", 0) == 0) {
+      topo = readTopology(options.topology.substr(5));
+    }
+    else {
+      printUsage(argv[0]);
+      return 2;
+    }
+
+    Benchmark(options, topo).run();
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
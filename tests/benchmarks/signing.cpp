@@ -0,0 +1,164 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file signing.cpp
+
+  Measures how fast NLSR can sign its routing data, and how fast neighbors can verify it, for
+  each type of signing key. Each run signs and then verifies Data packets the size of our LSA
+  segments, which are segmented at MAX_NDN_PACKET_SIZE / 2, with:
+  - ecdsa: an ECDSA P-256 key, see signing-key-type;
+  - rsa: a 2048-bit RSA key, see signing-key-type;
+  - sha256: a DigestSha256, as used by liveness probe replies, for reference.
+ */
+
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+#include <ndn-cxx/security/verification-helpers.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+namespace nlsr::bench {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options
+{
+  std::vector<std::string> keyTypes{"ecdsa", "rsa", "sha256"};
+  size_t segmentSize = ndn::MAX_NDN_PACKET_SIZE / 2;
+  size_t nPackets = 1000;
+};
+
+static double
+perSecond(size_t count, Clock::duration elapsed)
+{
+  return count / std::chrono::duration<double>(elapsed).count();
+}
+
+static void
+run(ndn::KeyChain& keyChain, const std::string& keyType, const Options& options)
+{
+  ndn::security::SigningInfo signingInfo = ndn::security::signingWithSha256();
+  std::optional<ndn::security::Certificate> cert;
+  if (keyType != "sha256") {
+    ndn::Name identityName("/ndn/site/%C1.Router/bench-" + keyType);
+    auto identity = keyType == "rsa" ? keyChain.createIdentity(identityName, ndn::RsaKeyParams())
+                                     : keyChain.createIdentity(identityName, ndn::EcKeyParams());
+    cert = identity.getDefaultKey().getDefaultCertificate();
+    signingInfo = ndn::security::signingByCertificate(*cert);
+  }
+
+  std::vector<uint8_t> content(options.segmentSize, 0xA5);
+  std::vector<ndn::Data> packets;
+  packets.reserve(options.nPackets);
+  for (size_t i = 0; i < options.nPackets; ++i) {
+    packets.emplace_back(ndn::Name("/localhop/ndn/nlsr/LSA/site/%C1.Router/bench/ADJACENCY")
+                           .appendNumber(1).appendVersion().appendSegment(i));
+    packets.back().setContent(content);
+  }
+
+  auto start = Clock::now();
+  for (auto& data : packets) {
+    keyChain.sign(data, signingInfo);
+  }
+  double signRate = perSecond(packets.size(), Clock::now() - start);
+
+  size_t nValid = 0;
+  start = Clock::now();
+  for (const auto& data : packets) {
+    nValid += ndn::security::verifySignature(data, cert);
+  }
+  double verifyRate = perSecond(packets.size(), Clock::now() - start);
+  if (nValid != packets.size()) {
+    throw std::runtime_error(keyType + ": " + std::to_string(packets.size() - nValid) +
+                             " signatures failed to verify");
+  }
+
+  std::cout << keyType << '\t' << options.segmentSize << '\t' << packets.size() << '\t'
+            << static_cast<uint64_t>(signRate) << '\t' << static_cast<uint64_t>(verifyRate)
+            << std::endl;
+}
+
+static void
+printUsage(const char* programName)
+{
+  std::cerr << "Usage: " << programName << " [-k key-type] [-s size] [-n packets]\n"
+               "\n"
+               "  -k  ecdsa, rsa or sha256 (default: each of them)\n"
+               "  -s  content bytes per packet (default " << ndn::MAX_NDN_PACKET_SIZE / 2 << ")\n"
+               "  -n  packets signed and verified (default 1000)\n"
+               "\n"
+               "Output columns: key type, content bytes, packets, signed/s, verified/s\n";
+}
+
+} // namespace nlsr::bench
+
+int
+main(int argc, char** argv)
+{
+  using namespace nlsr::bench;
+
+  Options options;
+  int opt;
+  while ((opt = ::getopt(argc, argv, "hk:s:n:")) != -1) {
+    switch (opt) {
+    case 'k':
+      options.keyTypes = {::optarg};
+      break;
+    case 's':
+      options.segmentSize = std::stoul(::optarg);
+      break;
+    case 'n':
+      options.nPackets = std::max<size_t>(1, std::stoul(::optarg));
+      break;
+    case 'h':
+      printUsage(argv[0]);
+      return 0;
+    default:
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+
+  for (const auto& keyType : options.keyTypes) {
+    if (keyType != "ecdsa" && keyType != "rsa" && keyType != "sha256") {
+      printUsage(argv[0]);
+      return 2;
+    }
+  }
+
+  try {
+    ndn::KeyChain keyChain("pib-memory:", "tpm-memory:");
+    for (const auto& keyType : options.keyTypes) {
+      run(keyChain, keyType, options);
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_TESTS_BENCHMARKS_TOPOLOGY_HPP
+#define NLSR_TESTS_BENCHMARKS_TOPOLOGY_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <map>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace nlsr::bench {
+
+/** A link between routers numbered from 0, with the same cost in both directions. */
+struct Edge
+{
+  size_t a;
+  size_t b;
+  double cost;
+};
+
+struct Topology
+{
+  size_t nRouters = 0;
+  std::vector<Edge> edges;
+};
+
+inline Topology
+makeGrid(size_t nRouters, std::mt19937& rng)
+{
+  std::uniform_int_distribution<int> cost(1, 100);
+  size_t side = static_cast<size_t>(std::ceil(std::sqrt(nRouters)));
+  Topology topo{nRouters, {}};
+  for (size_t i = 0; i < nRouters; ++i) {
+    if ((i + 1) % side != 0 && i + 1 < nRouters) {
+      topo.edges.push_back({i, i + 1, double(cost(rng))});
+    }
+    if (i + side < nRouters) {
+      topo.edges.push_back({i, i + side, double(cost(rng))});
+    }
+  }
+  return topo;
+}
+
+/** Waxman graph: routers in the unit square, P(link) = alpha * exp(-d / (beta * sqrt(2))).
+    Each router is also linked to a random earlier router, so that the graph is connected. */
+inline Topology
+makeWaxman(size_t nRouters, std::mt19937& rng, double alpha = 0.4, double beta = 0.1)
+{
+  std::uniform_real_distribution<double> unit(0.0, 1.0);
+  std::vector<std::pair<double, double>> points(nRouters);
+  for (auto& point : points) {
+    point = {unit(rng), unit(rng)};
+  }
+  auto distance = [&] (size_t i, size_t j) {
+    return std::hypot(points[i].first - points[j].first, points[i].second - points[j].second);
+  };
+  auto cost = [&] (size_t i, size_t j) { return std::max(1.0, std::round(distance(i, j) * 1000)); };
+
+  Topology topo{nRouters, {}};
+  std::set<std::pair<size_t, size_t>> linked;
+  for (size_t i = 1; i < nRouters; ++i) {
+    size_t j = std::uniform_int_distribution<size_t>(0, i - 1)(rng);
+    linked.emplace(j, i);
+    topo.edges.push_back({j, i, cost(i, j)});
+  }
+  for (size_t i = 0; i < nRouters; ++i) {
+    for (size_t j = i + 1; j < nRouters; ++j) {
+      if (unit(rng) < alpha * std::exp(-distance(i, j) / (beta * std::sqrt(2.0))) &&
+          linked.emplace(i, j).second) {
+        topo.edges.push_back({i, j, cost(i, j)});
+      }
+    }
+  }
+  return topo;
+}
+
+/** Barabasi-Albert graph: each new router links to @p m existing ones, by preferential
+    attachment. */
+inline Topology
+makeScaleFree(size_t nRouters, std::mt19937& rng, size_t m = 2)
+{
+  std::uniform_int_distribution<int> cost(1, 100);
+  Topology topo{nRouters, {}};
+  std::vector<size_t> endpoints; // each router appears once per link
+  for (size_t i = 1; i < nRouters; ++i) {
+    std::set<size_t> targets;
+    while (targets.size() < std::min(m, i)) {
+      if (endpoints.empty()) {
+        targets.insert(0);
+      }
+      else {
+        targets.insert(endpoints[std::uniform_int_distribution<size_t>(0, endpoints.size() - 1)(rng)]);
+      }
+    }
+    for (size_t j : targets) {
+      topo.edges.push_back({j, i, double(cost(rng))});
+      endpoints.push_back(i);
+      endpoints.push_back(j);
+    }
+  }
+  return topo;
+}
+
+/** Reads "router router cost" lines, e.g. converted from a measured ISP topology. */
+inline Topology
+readTopology(const std::string& fileName)
+{
+  std::ifstream file(fileName);
+  if (!file) {
+    throw std::runtime_error("Cannot open " + fileName);
+  }
+
+  Topology topo;
+  std::map<std::string, size_t> ids;
+  auto getId = [&] (const std::string& router) {
+    return ids.try_emplace(router, ids.size()).first->second;
+  };
+  std::string a, b;
+  double cost;
+  while (file >> a >> b >> cost) {
+    topo.edges.push_back({getId(a), getId(b), cost});
+  }
+  topo.nRouters = ids.size();
+  return topo;
+}
+
+} // namespace nlsr::bench
+
+#endif // NLSR_TESTS_BENCHMARKS_TOPOLOGY_HPP
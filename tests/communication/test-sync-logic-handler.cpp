@@ -245,6 +245,67 @@ BOOST_AUTO_TEST_CASE(UpdatePrefix)
                     ndn::Name(opts.userPrefix).append(boost::lexical_cast<std::string>(Lsa::Type::COORDINATE)));
 }
 
+BOOST_AUTO_TEST_CASE(UpdateBatch)
+{
+  ndn::Name otherRouter2 = "/localhop/ndn/nlsr/LSA/site/%C1.Router/another-router";
+  std::vector<std::pair<ndn::Name, uint64_t>> emitted;
+  ndn::signal::ScopedConnection connection = getSync().onNewLsa.connect(
+    [&] (const auto& updateName, uint64_t sequenceNumber, const auto&, uint64_t) {
+      emitted.emplace_back(updateName, sequenceNumber);
+    });
+
+  auto name1 = makeLsaUserPrefix(otherRouter, Lsa::Type::NAME);
+  auto adj1 = makeLsaUserPrefix(otherRouter, Lsa::Type::ADJACENCY);
+  auto adj2 = makeLsaUserPrefix(otherRouter2, Lsa::Type::ADJACENCY);
+  getSync().processUpdates({
+    {name1, 3, 0},
+    {adj1, 5, 0},
+    {adj2, 2, 0},
+    {name1, 4, 0},
+    {adj1, 4, 0},
+    {"/malformed/update", 1, 0},
+  });
+
+  // Superseded updates are dropped, and Adjacency LSAs come first, in canonical order of routers
+  BOOST_REQUIRE_EQUAL(emitted.size(), 3);
+  BOOST_CHECK_EQUAL(emitted[0].first, adj1);
+  BOOST_CHECK_EQUAL(emitted[0].second, 5);
+  BOOST_CHECK_EQUAL(emitted[1].first, adj2);
+  BOOST_CHECK_EQUAL(emitted[1].second, 2);
+  BOOST_CHECK_EQUAL(emitted[2].first, name1);
+  BOOST_CHECK_EQUAL(emitted[2].second, 4);
+}
+
+BOOST_AUTO_TEST_CASE(PublishHoldDown)
+{
+  opts.publishHoldDown = 100_ms;
+  auto& state = getSync().m_publishStates[static_cast<size_t>(Lsa::Type::ADJACENCY)];
+
+  // The first publication is immediate
+  getSync().publishRoutingUpdate(Lsa::Type::ADJACENCY, 1);
+  BOOST_CHECK_EQUAL(state.publishedSeqNo, 1);
+
+  // Then a burst within the hold-down is published once, with the newest sequence number
+  this->advanceClocks(10_ms);
+  getSync().publishRoutingUpdate(Lsa::Type::ADJACENCY, 2);
+  getSync().publishRoutingUpdate(Lsa::Type::ADJACENCY, 3);
+  this->advanceClocks(10_ms);
+  getSync().publishRoutingUpdate(Lsa::Type::ADJACENCY, 4);
+  BOOST_CHECK_EQUAL(state.publishedSeqNo, 1);
+
+  // Other LSA types have their own hold-down
+  getSync().publishRoutingUpdate(Lsa::Type::NAME, 7);
+  BOOST_CHECK_EQUAL(getSync().m_publishStates[static_cast<size_t>(Lsa::Type::NAME)].publishedSeqNo, 7);
+
+  this->advanceClocks(10_ms, 8);
+  BOOST_CHECK_EQUAL(state.publishedSeqNo, 4);
+
+  // An update after the hold-down is published right away
+  this->advanceClocks(100_ms, 2);
+  getSync().publishRoutingUpdate(Lsa::Type::ADJACENCY, 5);
+  BOOST_CHECK_EQUAL(state.publishedSeqNo, 5);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
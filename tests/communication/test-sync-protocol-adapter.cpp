@@ -50,8 +50,10 @@ public:
       nodes[i] = std::make_shared<SyncProtocolAdapter>(
         *faces[i], m_keyChain, SyncProtocol::PSYNC, syncPrefix, userPrefixes[i],
         syncInterestLifetime,
-        [i, this] (const Name& updateName, uint64_t highSeq, uint64_t incomingFaceId) {
-          prefixToSeq[i].emplace(updateName, highSeq);
+        [i, this] (const std::vector<SyncUpdate>& updates) {
+          for (const auto& update : updates) {
+            prefixToSeq[i][update.updateName] = update.seqNo;
+          }
         });
     }
 
@@ -103,6 +105,69 @@ BOOST_FIXTURE_TEST_CASE(Basic, SyncProtocolAdapterFixture)
   BOOST_CHECK_EQUAL(it->second, 10);
 }
 
+BOOST_AUTO_TEST_CASE(ComputeIbfCount)
+{
+  // default size
+  BOOST_CHECK_EQUAL(SyncProtocolAdapter::computeIbfCount(0, 80), 80);
+  // 1.5 cells per user node, whatever the default
+  BOOST_CHECK_EQUAL(SyncProtocolAdapter::computeIbfCount(20, 80), 30);
+  BOOST_CHECK_EQUAL(SyncProtocolAdapter::computeIbfCount(61, 80), 92);
+  BOOST_CHECK_EQUAL(SyncProtocolAdapter::computeIbfCount(200, 40), 300);
+  // capped
+  BOOST_CHECK_EQUAL(SyncProtocolAdapter::computeIbfCount(1000, 80),
+                    SyncProtocolAdapter::MAX_IBF_COUNT);
+}
+
+BOOST_FIXTURE_TEST_CASE(ExpectedUserNodes, SyncProtocolAdapterFixture)
+{
+  addNodes();
+  nodes[0]->publishUpdate(userPrefixes[0], 10);
+  advanceClocks(1_s, 100);
+  BOOST_REQUIRE_EQUAL(prefixToSeq[1].count(userPrefixes[0]), 1);
+
+  size_t ibfCount = nodes[0]->getIbfCount();
+  BOOST_CHECK_GT(ibfCount, 0);
+  nodes[0]->setExpectedUserNodes(0);
+  BOOST_CHECK_EQUAL(nodes[0]->getIbfCount(), ibfCount);
+  BOOST_CHECK_EQUAL(nodes[0]->getIbfResizeCount(), 0);
+
+  for (auto& node : nodes) {
+    node->setExpectedUserNodes(2 * ibfCount);
+    BOOST_CHECK_EQUAL(node->getIbfCount(), 3 * ibfCount);
+    BOOST_CHECK_EQUAL(node->getIbfResizeCount(), 1);
+  }
+  advanceClocks(10_ms, 10);
+
+  // the recreated producers carry on from our sequence numbers
+  nodes[0]->publishUpdate(userPrefixes[0], 11);
+  nodes[1]->publishUpdate(userPrefixes[1], 20);
+  advanceClocks(1_s, 100);
+  BOOST_CHECK_EQUAL(prefixToSeq[1][userPrefixes[0]], 11);
+  BOOST_CHECK_EQUAL(prefixToSeq[0][userPrefixes[1]], 20);
+}
+
+BOOST_FIXTURE_TEST_CASE(ExpectedUserNodesHistory, SyncProtocolAdapterFixture)
+{
+  addNodes();
+
+  // the two nodes reach the same number of user nodes through different histories
+  nodes[0]->setExpectedUserNodes(100);
+  nodes[0]->setExpectedUserNodes(200);
+  nodes[0]->setExpectedUserNodes(120);
+  nodes[1]->setExpectedUserNodes(30);
+  nodes[1]->setExpectedUserNodes(120);
+  BOOST_CHECK_EQUAL(nodes[0]->getIbfCount(), SyncProtocolAdapter::computeIbfCount(120, 0));
+  BOOST_CHECK_EQUAL(nodes[1]->getIbfCount(), nodes[0]->getIbfCount());
+  advanceClocks(10_ms, 10);
+
+  // and still sync with each other
+  nodes[0]->publishUpdate(userPrefixes[0], 5);
+  nodes[1]->publishUpdate(userPrefixes[1], 7);
+  advanceClocks(1_s, 100);
+  BOOST_CHECK_EQUAL(prefixToSeq[1][userPrefixes[0]], 5);
+  BOOST_CHECK_EQUAL(prefixToSeq[0][userPrefixes[1]], 7);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -0,0 +1,385 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests/emulated-network.hpp"
+
+#include <ndn-cxx/lp/tags.hpp>
+#include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
+#include <ndn-cxx/mgmt/nfd/control-response.hpp>
+#include <ndn-cxx/mgmt/nfd/face-status.hpp>
+#include <ndn-cxx/security/signing-helpers.hpp>
+
+#include <boost/assert.hpp>
+
+#include <time.h>
+#include <unistd.h>
+
+#include <filesystem>
+
+namespace nlsr::tests {
+
+static ndn::FaceUri
+getFaceUri(size_t id)
+{
+  return ndn::FaceUri("udp4://10." + std::to_string((id >> 16) & 0xFF) + "." +
+                      std::to_string((id >> 8) & 0xFF) + "." + std::to_string(id & 0xFF) + ":6363");
+}
+
+static ndn::time::nanoseconds
+getThreadCpuTime()
+{
+  timespec ts{};
+  ::clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ndn::time::seconds(ts.tv_sec) + ndn::time::nanoseconds(ts.tv_nsec);
+}
+
+EmulatedNetwork::Router::Router(size_t id, ndn::KeyChain& keyChain)
+  : id(id)
+  // packets are not logged, as they would pile up over a long run
+  , face(io, keyChain, {false, true})
+  , conf(face, keyChain)
+{
+}
+
+EmulatedNetwork::EmulatedNetwork(unsigned seed)
+  : m_rng(seed)
+{
+  auto dir = std::filesystem::temp_directory_path() /
+             ("nlsr-emulation-" + std::to_string(::getpid()) + "-" + std::to_string(seed));
+  std::filesystem::create_directories(dir);
+  m_stateDir = dir.string();
+}
+
+EmulatedNetwork::~EmulatedNetwork()
+{
+  // Nlsr instances are destroyed before the faces and io_contexts they use
+  for (auto& router : m_routers) {
+    router->connections.clear();
+    router->nlsr.reset();
+  }
+  m_routers.clear();
+
+  std::error_code ec;
+  std::filesystem::remove_all(m_stateDir, ec);
+}
+
+ndn::Name
+EmulatedNetwork::getRouterName(size_t id)
+{
+  return ndn::Name("/ndn/site/%C1.Router").append("r" + std::to_string(id));
+}
+
+size_t
+EmulatedNetwork::addRouter(const Configure& configure)
+{
+  size_t id = m_routers.size();
+  auto& router = *m_routers.emplace_back(std::make_unique<Router>(id, m_keyChain));
+  m_neighbors.emplace_back();
+
+  auto& conf = router.conf;
+  conf.setNetwork("/ndn");
+  conf.setSiteName("/site");
+  conf.setRouterName(ndn::Name("/%C1.Router").append("r" + std::to_string(id)));
+  conf.buildRouterAndSyncUserPrefix();
+  auto stateDir = std::filesystem::path(m_stateDir) / std::to_string(id);
+  std::filesystem::create_directories(stateDir);
+  conf.setStateFileDir(stateDir.string());
+  conf.getValidator().load(R"CONF(
+      trust-anchor
+      {
+        type any
+      }
+    )CONF", "emulated-network");
+  if (configure) {
+    configure(conf);
+  }
+  return id;
+}
+
+void
+EmulatedNetwork::addLink(size_t a, size_t b, double cost, ndn::time::nanoseconds delay,
+                         double lossRate)
+{
+  BOOST_ASSERT(a != b && m_routers.at(a)->nlsr == nullptr && m_routers.at(b)->nlsr == nullptr);
+
+  if (!m_links.try_emplace(std::minmax(a, b), Link{delay, lossRate}).second) {
+    return;
+  }
+  m_neighbors[a].push_back(b);
+  m_neighbors[b].push_back(a);
+  for (auto [from, to] : {std::pair{a, b}, std::pair{b, a}}) {
+    m_routers[from]->conf.getAdjacencyList().insert(
+      Adjacent(getRouterName(to), getFaceUri(to), cost, Adjacent::STATUS_INACTIVE, 0, 0));
+  }
+}
+
+void
+EmulatedNetwork::start()
+{
+  for (auto& routerPtr : m_routers) {
+    auto& router = *routerPtr;
+    router.connections.emplace_back(router.face.onSendInterest.connect(
+      [this, &router] (const auto& interest) { onSendInterest(router, interest); }));
+    router.connections.emplace_back(router.face.onSendData.connect(
+      [this, &router] (const auto& data) { onSendData(router, data); }));
+
+    runOnRouter(router, [&] {
+      router.nlsr = std::make_unique<Nlsr>(router.face, m_keyChain, router.conf);
+    });
+    router.connections.emplace_back(router.nlsr->m_routingTable.afterRoutingDelta.connect(
+      [&router] (const auto&) { router.lastRouteChange = ndn::time::steady_clock::now(); }));
+  }
+}
+
+void
+EmulatedNetwork::setLinkUp(size_t a, size_t b, bool isUp)
+{
+  m_links.at(std::minmax(a, b)).isUp = isUp;
+}
+
+EmulatedNetwork::Link*
+EmulatedNetwork::findLink(size_t a, size_t b)
+{
+  auto it = m_links.find(std::minmax(a, b));
+  return it == m_links.end() ? nullptr : &it->second;
+}
+
+template<typename F>
+void
+EmulatedNetwork::runOnRouter(Router& router, F&& f)
+{
+  auto start = getThreadCpuTime();
+  f();
+  router.cpuTime += getThreadCpuTime() - start;
+}
+
+void
+EmulatedNetwork::afterTick()
+{
+  auto now = ndn::time::steady_clock::now();
+  while (!m_deliveries.empty() && m_deliveries.top().time <= now) {
+    auto delivery = m_deliveries.top();
+    m_deliveries.pop();
+    deliver(delivery);
+  }
+
+  for (auto& router : m_routers) {
+    runOnRouter(*router, [&] {
+      if (router->io.stopped()) {
+        router->io.restart();
+      }
+      router->io.poll();
+    });
+  }
+}
+
+void
+EmulatedNetwork::onSendInterest(Router& router, const ndn::Interest& interest)
+{
+  static const ndn::Name LOCALHOST("/localhost");
+  static const ndn::Name LOCALHOP("/localhop");
+
+  const auto& name = interest.getName();
+  if (LOCALHOST.isPrefixOf(name)) {
+    processNfdCommand(router, interest);
+  }
+  else if (LOCALHOP.isPrefixOf(name)) {
+    for (size_t neighbor : m_neighbors[router.id]) {
+      send(router.id, neighbor, interest);
+    }
+  }
+  else {
+    for (size_t neighbor : m_neighbors[router.id]) {
+      if (m_routers[neighbor]->conf.getRouterPrefix().isPrefixOf(name)) {
+        send(router.id, neighbor, interest);
+      }
+    }
+  }
+}
+
+void
+EmulatedNetwork::onSendData(Router& router, const ndn::Data& data)
+{
+  auto now = ndn::time::steady_clock::now();
+  auto& pit = router.pit;
+  for (auto it = pit.begin(); it != pit.end();) {
+    if (it->expiry < now) {
+      it = pit.erase(it);
+    }
+    else if (it->interest.matchesData(data)) {
+      send(router.id, it->downstream, data);
+      it = pit.erase(it);
+    }
+    else {
+      ++it;
+    }
+  }
+}
+
+void
+EmulatedNetwork::send(size_t from, size_t to, Packet packet)
+{
+  auto now = ndn::time::steady_clock::now();
+  if (from == to) {
+    // a reply of the emulated NFD
+    m_deliveries.push({now, m_nextSeq++, from, to, std::move(packet)});
+    return;
+  }
+
+  const auto& name = std::visit([] (const auto& p) -> const ndn::Name& { return p.getName(); },
+                                packet);
+  auto category = getCategory(*m_routers[from], name);
+  if (std::holds_alternative<ndn::Interest>(packet)) {
+    ++m_statistics.nInterests[category];
+  }
+  else {
+    ++m_statistics.nData[category];
+  }
+
+  auto* link = findLink(from, to);
+  if (!link->isUp || std::uniform_real_distribution<double>(0.0, 1.0)(m_rng) < link->lossRate) {
+    ++m_statistics.nLost;
+    return;
+  }
+  m_deliveries.push({now + link->delay, m_nextSeq++, from, to, std::move(packet)});
+}
+
+void
+EmulatedNetwork::deliver(Delivery& delivery)
+{
+  auto& router = *m_routers[delivery.to];
+  if (delivery.from != delivery.to && !findLink(delivery.from, delivery.to)->isUp) {
+    ++m_statistics.nLost;
+    return;
+  }
+
+  runOnRouter(router, [&] {
+    if (auto* interest = std::get_if<ndn::Interest>(&delivery.packet)) {
+      interest->setTag(std::make_shared<ndn::lp::IncomingFaceIdTag>(getFaceId(delivery.from)));
+      router.pit.push_back({delivery.from, *interest,
+                            ndn::time::steady_clock::now() + interest->getInterestLifetime()});
+      router.face.receive(*interest);
+    }
+    else {
+      auto& data = std::get<ndn::Data>(delivery.packet);
+      if (delivery.from != delivery.to) {
+        data.setTag(std::make_shared<ndn::lp::IncomingFaceIdTag>(getFaceId(delivery.from)));
+      }
+      router.face.receive(data);
+    }
+  });
+}
+
+void
+EmulatedNetwork::processNfdCommand(Router& router, const ndn::Interest& interest)
+{
+  // /localhost/nfd/<module>/<verb>[/<parameters>]
+  const auto& name = interest.getName();
+  if (name.size() < 4) {
+    return;
+  }
+  auto module = name[2].toUri();
+  auto verb = name[3].toUri();
+
+  if (module == "rib" || (module == "faces" && verb == "events")) {
+    // rib commands are answered by the DummyClientFace; no Face events are ever emitted
+    return;
+  }
+
+  auto data = std::make_shared<ndn::Data>(name);
+  if (module == "faces" && verb == "list") {
+    ndn::encoding::EncodingBuffer buffer;
+    const auto& neighbors = m_neighbors[router.id];
+    // the dataset is encoded back to front
+    for (auto it = neighbors.rbegin(); it != neighbors.rend(); ++it) {
+      ndn::nfd::FaceStatus status;
+      status.setFaceId(getFaceId(*it))
+            .setRemoteUri(getFaceUri(*it).toString())
+            .setLocalUri(getFaceUri(router.id).toString());
+      status.wireEncode(buffer);
+    }
+    data->setName(ndn::Name(name).appendVersion().appendSegment(0));
+    data->setFinalBlock(data->getName()[-1]);
+    data->setContent(buffer);
+  }
+  else {
+    ndn::nfd::ControlResponse response(200, "OK");
+    if (name.size() > 4) {
+      try {
+        response.setBody(ndn::nfd::ControlParameters(name[4].blockFromValue()).wireEncode());
+      }
+      catch (const ndn::tlv::Error&) {
+      }
+    }
+    data->setContent(response.wireEncode());
+  }
+
+  data->setFreshnessPeriod(ndn::time::seconds(1));
+  m_keyChain.sign(*data, ndn::security::signingWithSha256());
+  send(router.id, router.id, *data);
+}
+
+EmulatedNetwork::Category
+EmulatedNetwork::getCategory(const Router& router, const ndn::Name& name) const
+{
+  if (router.conf.getSyncPrefix().isPrefixOf(name)) {
+    return CATEGORY_SYNC;
+  }
+  if (router.conf.getLsaPrefix().isPrefixOf(name)) {
+    return CATEGORY_LSA;
+  }
+  return CATEGORY_NEIGHBOR;
+}
+
+size_t
+EmulatedNetwork::getNReachable(size_t id) const
+{
+  std::vector<bool> isReached(m_routers.size());
+  std::vector<size_t> stack{id};
+  isReached[id] = true;
+  size_t nReached = 0;
+  while (!stack.empty()) {
+    size_t router = stack.back();
+    stack.pop_back();
+    for (size_t neighbor : m_neighbors[router]) {
+      if (!isReached[neighbor] && m_links.at(std::minmax(router, neighbor)).isUp) {
+        isReached[neighbor] = true;
+        ++nReached;
+        stack.push_back(neighbor);
+      }
+    }
+  }
+  return nReached;
+}
+
+bool
+EmulatedNetwork::isConverged() const
+{
+  for (const auto& router : m_routers) {
+    if (router->nlsr == nullptr ||
+        router->nlsr->m_routingTable.getRoutingTableEntry().size() != getNReachable(router->id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace nlsr::tests
@@ -0,0 +1,266 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_TESTS_EMULATED_NETWORK_HPP
+#define NLSR_TESTS_EMULATED_NETWORK_HPP
+
+#include "nlsr.hpp"
+
+#include "tests/clock-fixture.hpp"
+
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <array>
+#include <functional>
+#include <map>
+#include <queue>
+#include <random>
+#include <tuple>
+#include <variant>
+
+namespace nlsr::tests {
+
+/** \brief Runs many Nlsr instances in one process, on the virtual clock of ClockFixture.
+ *
+ *  Each router has its own io_context and DummyClientFace, and the packets they send are
+ *  carried by emulated links with a delay and a loss rate. NLSR only talks to its direct
+ *  neighbors: an Interest is delivered to the neighbor whose router prefix it is under, or to
+ *  every neighbor for a /localhop name, and Data returns on the link of the Interest it
+ *  satisfies. Commands to /localhost/nfd are answered by a minimal NFD, which lists one Face
+ *  per link. The routers are not signed for; they sign with DigestSha256 and accept any Data.
+ *
+ *  The CPU time spent by each router is measured while its packets are delivered and its
+ *  io_context runs.
+ */
+class EmulatedNetwork : public ClockFixture
+{
+public:
+  /** \brief Traffic categories, by the name of the packets.
+   */
+  enum Category {
+    CATEGORY_NEIGHBOR, ///< under the router prefix of the neighbor: Hello and probes
+    CATEGORY_SYNC,     ///< under the sync prefix
+    CATEGORY_LSA,      ///< under the LSA prefix
+    N_CATEGORIES
+  };
+
+  struct Statistics
+  {
+    std::array<uint64_t, N_CATEGORIES> nInterests{};
+    std::array<uint64_t, N_CATEGORIES> nData{};
+    /// packets dropped by the loss rate of their link, or because it went down
+    uint64_t nLost = 0;
+  };
+
+  using Configure = std::function<void(ConfParameter&)>;
+
+  explicit
+  EmulatedNetwork(unsigned seed = 1);
+
+  ~EmulatedNetwork() override;
+
+  /** \brief Add a router named /ndn/site/%C1.Router/r<id>, and return its id.
+   *  \param configure changes its configuration before Nlsr is started
+   */
+  size_t
+  addRouter(const Configure& configure = nullptr);
+
+  /** \brief Link two routers, each with the other as a neighbor of cost \p cost.
+   *  \pre start() has not been called
+   */
+  void
+  addLink(size_t a, size_t b, double cost,
+          ndn::time::nanoseconds delay = ndn::time::milliseconds(10), double lossRate = 0.0);
+
+  /** \brief Create the Nlsr instance of every router.
+   */
+  void
+  start();
+
+  /** \brief Bring a link down or up; packets in flight on a link that is down are lost.
+   *  \throw std::out_of_range the routers are not linked
+   */
+  void
+  setLinkUp(size_t a, size_t b, bool isUp);
+
+  static ndn::Name
+  getRouterName(size_t id);
+
+  size_t
+  size() const
+  {
+    return m_routers.size();
+  }
+
+  Nlsr&
+  getNlsr(size_t id)
+  {
+    return *m_routers.at(id)->nlsr;
+  }
+
+  /** \brief Whether each router has a route to every other router it can reach over the links
+   *         that are up, and to no other.
+   */
+  bool
+  isConverged() const;
+
+  /** \brief The last time the routing table of \p id changed.
+   */
+  ndn::time::steady_clock::time_point
+  getLastRouteChange(size_t id) const
+  {
+    return m_routers.at(id)->lastRouteChange;
+  }
+
+  /** \brief The CPU time spent by \p id since it was added.
+   */
+  ndn::time::nanoseconds
+  getCpuTime(size_t id) const
+  {
+    return m_routers.at(id)->cpuTime;
+  }
+
+  const Statistics&
+  getStatistics() const
+  {
+    return m_statistics;
+  }
+
+  void
+  resetStatistics()
+  {
+    m_statistics = {};
+  }
+
+private:
+  void
+  afterTick() final;
+
+  using Packet = std::variant<ndn::Interest, ndn::Data>;
+
+  struct Link
+  {
+    ndn::time::nanoseconds delay;
+    double lossRate;
+    bool isUp = true;
+  };
+
+  struct PendingInterest
+  {
+    size_t downstream;
+    ndn::Interest interest;
+    ndn::time::steady_clock::time_point expiry;
+  };
+
+  struct Router
+  {
+    Router(size_t id, ndn::KeyChain& keyChain);
+
+    size_t id;
+    boost::asio::io_context io;
+    ndn::DummyClientFace face;
+    ConfParameter conf;
+    std::unique_ptr<Nlsr> nlsr;
+    /// the Interests this router has been sent by its neighbors and not answered yet
+    std::vector<PendingInterest> pit;
+    ndn::time::steady_clock::time_point lastRouteChange;
+    ndn::time::nanoseconds cpuTime{0};
+    std::vector<ndn::signal::ScopedConnection> connections;
+  };
+
+  struct Delivery
+  {
+    ndn::time::steady_clock::time_point time;
+    /// delivered in the order they were sent when due at the same time
+    uint64_t seq;
+    size_t from;
+    size_t to;
+    Packet packet;
+
+    bool
+    operator>(const Delivery& other) const
+    {
+      return std::tie(time, seq) > std::tie(other.time, other.seq);
+    }
+  };
+
+  static uint64_t
+  getFaceId(size_t neighbor)
+  {
+    return FACE_ID_BASE + neighbor;
+  }
+
+  Link*
+  findLink(size_t a, size_t b);
+
+  /** \brief Measure the CPU time of \p f, and charge it to \p router.
+   */
+  template<typename F>
+  void
+  runOnRouter(Router& router, F&& f);
+
+  void
+  onSendInterest(Router& router, const ndn::Interest& interest);
+
+  void
+  onSendData(Router& router, const ndn::Data& data);
+
+  void
+  send(size_t from, size_t to, Packet packet);
+
+  void
+  deliver(Delivery& delivery);
+
+  /** \brief Answer the NFD management commands of \p router.
+   */
+  void
+  processNfdCommand(Router& router, const ndn::Interest& interest);
+
+  Category
+  getCategory(const Router& router, const ndn::Name& name) const;
+
+  /** \brief The number of routers that \p id can reach over the links that are up, itself
+   *         excluded.
+   */
+  size_t
+  getNReachable(size_t id) const;
+
+private:
+  static constexpr uint64_t FACE_ID_BASE = 256;
+
+  std::string m_stateDir;
+  ndn::KeyChain m_keyChain{"pib-memory:", "tpm-memory:"};
+  std::vector<std::unique_ptr<Router>> m_routers;
+  /// links by (lower id, higher id)
+  std::map<std::pair<size_t, size_t>, Link> m_links;
+  std::vector<std::vector<size_t>> m_neighbors;
+  std::priority_queue<Delivery, std::vector<Delivery>, std::greater<>> m_deliveries;
+  uint64_t m_nextSeq = 0;
+  std::mt19937 m_rng;
+  Statistics m_statistics;
+};
+
+} // namespace nlsr::tests
+
+#endif // NLSR_TESTS_EMULATED_NETWORK_HPP
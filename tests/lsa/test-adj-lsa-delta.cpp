@@ -0,0 +1,96 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "lsa/adj-lsa-delta.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestAdjLsaDelta)
+
+static AdjLsa
+makeAdjLsa(uint64_t seqNo, const std::vector<std::pair<std::string, double>>& adjacencies)
+{
+  AdjacencyList noAdjacencies;
+  AdjLsa lsa("/ndn/site/router", seqNo,
+             ndn::time::fromUnixTimestamp(ndn::time::milliseconds(1585196014000 + seqNo)),
+             noAdjacencies);
+  for (const auto& [name, cost] : adjacencies) {
+    lsa.addAdjacent(Adjacent(name, ndn::FaceUri("udp4://10.0.0.1:6363"), cost,
+                             Adjacent::STATUS_ACTIVE, 0, 0));
+  }
+  return lsa;
+}
+
+BOOST_AUTO_TEST_CASE(ComputeAndApply)
+{
+  auto base = makeAdjLsa(7, {{"/ndn/site/a", 10}, {"/ndn/site/b", 10}, {"/ndn/site/c", 10}});
+  auto lsa = makeAdjLsa(8, {{"/ndn/site/a", 25}, {"/ndn/site/b", 10}, {"/ndn/site/d", 10}});
+
+  AdjLsaDelta delta(&base, lsa);
+  BOOST_CHECK_EQUAL(delta.getSeqNo(), 8);
+  BOOST_CHECK_EQUAL(delta.getBaseSeqNo(), 7);
+  BOOST_REQUIRE_EQUAL(delta.getChangedAdjacencies().size(), 2);
+  BOOST_CHECK_EQUAL(delta.getChangedAdjacencies()[0].getName(), "/ndn/site/a");
+  BOOST_CHECK_EQUAL(delta.getChangedAdjacencies()[0].getLinkCost(), 25);
+  BOOST_CHECK_EQUAL(delta.getChangedAdjacencies()[1].getName(), "/ndn/site/d");
+  BOOST_REQUIRE_EQUAL(delta.getRemovedNeighbors().size(), 1);
+  BOOST_CHECK_EQUAL(delta.getRemovedNeighbors()[0], "/ndn/site/c");
+
+  AdjLsaDelta decoded(delta.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.wireEncode(), delta.wireEncode());
+  BOOST_CHECK_LT(decoded.wireEncode().size(), lsa.wireEncode().size());
+
+  auto applied = decoded.apply(&base);
+  BOOST_CHECK(applied == lsa);
+  BOOST_CHECK_EQUAL(applied.getOriginRouter(), lsa.getOriginRouter());
+  BOOST_CHECK_EQUAL(applied.getSeqNo(), 8);
+  BOOST_CHECK_EQUAL(applied.getExpirationTimePoint(), lsa.getExpirationTimePoint());
+
+  // only applies to its base
+  BOOST_CHECK_THROW(decoded.apply(&lsa), AdjLsaDelta::Error);
+  BOOST_CHECK_THROW(decoded.apply(nullptr), AdjLsaDelta::Error);
+}
+
+BOOST_AUTO_TEST_CASE(WithoutBase)
+{
+  auto lsa = makeAdjLsa(3, {{"/ndn/site/a", 10}, {"/ndn/site/b", 12}});
+
+  AdjLsaDelta delta(nullptr, lsa);
+  BOOST_CHECK_EQUAL(delta.getBaseSeqNo(), 0);
+  BOOST_CHECK_EQUAL(delta.getChangedAdjacencies().size(), 2);
+  BOOST_CHECK(delta.getRemovedNeighbors().empty());
+
+  AdjLsaDelta decoded(delta.wireEncode());
+  BOOST_CHECK(decoded.apply(nullptr) == lsa);
+  BOOST_CHECK_THROW(decoded.apply(&lsa), AdjLsaDelta::Error);
+
+  LsaHeader header(delta.wireEncode());
+  BOOST_CHECK(header.getType() == Lsa::Type::ADJACENCY);
+  BOOST_CHECK_EQUAL(header.getSeqNo(), 3);
+
+  BOOST_CHECK_THROW(AdjLsaDelta(lsa.wireEncode()), AdjLsaDelta::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -182,6 +182,44 @@ BOOST_AUTO_TEST_CASE(InitializeFromContent)
   BOOST_CHECK_EQUAL(adjlsa1, adjlsa2);
 }
 
+BOOST_AUTO_TEST_CASE(Diff)
+{
+  AdjacencyList oldAdl;
+  oldAdl.insert(Adjacent("/ndn/site/%C1.Router/a", ndn::FaceUri("udp4://10.0.0.1"), 10,
+                         Adjacent::STATUS_ACTIVE, 0, 0));
+  oldAdl.insert(Adjacent("/ndn/site/%C1.Router/b", ndn::FaceUri("udp4://10.0.0.2"), 10,
+                         Adjacent::STATUS_ACTIVE, 0, 0));
+  oldAdl.insert(Adjacent("/ndn/site/%C1.Router/c", ndn::FaceUri("udp4://10.0.0.3"), 10,
+                         Adjacent::STATUS_ACTIVE, 0, 0));
+
+  AdjacencyList newAdl;
+  newAdl.insert(Adjacent("/ndn/site/%C1.Router/d", ndn::FaceUri("udp4://10.0.0.4"), 5,
+                         Adjacent::STATUS_ACTIVE, 0, 0));
+  newAdl.insert(Adjacent("/ndn/site/%C1.Router/c", ndn::FaceUri("udp4://10.0.0.3"), 10,
+                         Adjacent::STATUS_ACTIVE, 0, 0));
+  newAdl.insert(Adjacent("/ndn/site/%C1.Router/a", ndn::FaceUri("udp4://10.0.0.1"), 25,
+                         Adjacent::STATUS_ACTIVE, 0, 0));
+
+  auto now = ndn::time::system_clock::now();
+  AdjLsa oldLsa("/ndn/site/%C1.Router/router", 1, now, oldAdl);
+  AdjLsa newLsa("/ndn/site/%C1.Router/router", 2, now, newAdl);
+
+  auto diff = oldLsa.diff(newLsa);
+  BOOST_CHECK(!diff.empty());
+  BOOST_REQUIRE_EQUAL(diff.added.size(), 1);
+  BOOST_CHECK_EQUAL(diff.added[0].neighbor, "/ndn/site/%C1.Router/d");
+  BOOST_CHECK_EQUAL(diff.added[0].newCost, 5);
+  BOOST_REQUIRE_EQUAL(diff.removed.size(), 1);
+  BOOST_CHECK_EQUAL(diff.removed[0].neighbor, "/ndn/site/%C1.Router/b");
+  BOOST_CHECK_EQUAL(diff.removed[0].oldCost, 10);
+  BOOST_REQUIRE_EQUAL(diff.costChanged.size(), 1);
+  BOOST_CHECK_EQUAL(diff.costChanged[0].neighbor, "/ndn/site/%C1.Router/a");
+  BOOST_CHECK_EQUAL(diff.costChanged[0].oldCost, 10);
+  BOOST_CHECK_EQUAL(diff.costChanged[0].newCost, 25);
+
+  BOOST_CHECK(newLsa.diff(newLsa).empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -165,6 +165,82 @@ BOOST_AUTO_TEST_CASE(InitializeFromContent)
   NameLsa nlsa1("router1", 1, testTimePoint, npl1);
   NameLsa nlsa2(nlsa1.wireEncode());
   BOOST_CHECK_EQUAL(nlsa1.wireEncode(), nlsa2.wireEncode());
+  BOOST_CHECK_EQUAL(nlsa2.getOriginRouterHash(), std::hash<ndn::Name>{}("router1"));
+  BOOST_CHECK_EQUAL(NameLsa(nlsa2).getOriginRouterHash(), nlsa1.getOriginRouterHash());
+}
+
+BOOST_AUTO_TEST_CASE(Header)
+{
+  NameLsa nlsa1("router1", 12, ndn::time::system_clock::now(), NamePrefixList{"name1"});
+  const auto& wire = nlsa1.wireEncode();
+
+  LsaHeader header(wire);
+  BOOST_CHECK(header.getType() == Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(header.getOriginRouter(), "router1");
+  BOOST_CHECK_EQUAL(header.getSeqNo(), 12);
+  BOOST_CHECK(header.getExpirationTimePoint() == NameLsa(wire).getExpirationTimePoint());
+
+  BOOST_CHECK_THROW(LsaHeader(ndn::Name("router1").wireEncode()), Lsa::Error);
+
+  BOOST_CHECK(parseLsaType(ndn::name::Component("NAME")) == Lsa::Type::NAME);
+  BOOST_CHECK(parseLsaType(ndn::name::Component("ADJACENCY")) == Lsa::Type::ADJACENCY);
+  BOOST_CHECK(parseLsaType(ndn::name::Component("name")) == Lsa::Type::BASE);
+}
+
+BOOST_AUTO_TEST_CASE(Compressed)
+{
+  NamePrefixList npl;
+  for (int i = 0; i < 20; ++i) {
+    npl.insert(PrefixInfo(ndn::Name("/ndn/edu/memphis/netlab/service").appendNumber(i), i));
+  }
+  npl.insert(PrefixInfo("/ndn/edu/ucla", 3.5));
+  npl.insert(PrefixInfo("/ndn/edu/ucla/cs", 1));
+
+  NameLsa nlsa("router1", 12, ndn::time::system_clock::now(), npl);
+  size_t plainSize = nlsa.wireEncode().size();
+
+  nlsa.setCompressed(true);
+  BOOST_CHECK(nlsa.isCompressed());
+  const auto& wire = nlsa.wireEncode();
+  BOOST_CHECK_LT(wire.size(), plainSize);
+
+  NameLsa decoded(wire);
+  BOOST_CHECK(decoded.isCompressed());
+  BOOST_CHECK_EQUAL(decoded.getNpl(), npl);
+  BOOST_CHECK_EQUAL(decoded, nlsa);
+
+  decoded.setCompressed(false);
+  BOOST_CHECK(!NameLsa(decoded.wireEncode()).isCompressed());
+  BOOST_CHECK_EQUAL(NameLsa(decoded.wireEncode()).getNpl(), npl);
+}
+
+BOOST_AUTO_TEST_CASE(AreaSummaries)
+{
+  NamePrefixList npl{ndn::Name("/ndn/site1/abr")};
+  NameLsa nlsa("/ndn/site1/%C1.Router/abr", 12, ndn::time::system_clock::now(), npl);
+  std::vector<AreaSummary> summaries{
+    {"/ndn/site1", {PrefixInfo("/ndn/site2/%C1.Router/r2", 10), PrefixInfo("/ndn/site2/r2", 12)}},
+    {"/ndn/site2", {PrefixInfo("/ndn/site1/%C1.Router/r1", 5)}},
+  };
+  nlsa.setAreaSummaries(summaries);
+
+  NameLsa decoded(nlsa.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.getNpl(), npl);
+  BOOST_CHECK(decoded.getAreaSummaries() == summaries);
+  BOOST_CHECK_EQUAL(decoded, nlsa);
+
+  nlsa.setCompressed(true);
+  BOOST_CHECK(NameLsa(nlsa.wireEncode()).getAreaSummaries() == summaries);
+
+  // a change of the summaries alone updates the LSA
+  auto rcvdLsa = std::make_shared<NameLsa>(decoded);
+  rcvdLsa->setAreaSummaries({summaries.front()});
+  BOOST_CHECK_NE(*rcvdLsa, decoded);
+  auto [updated, namesToAdd, namesToRemove] = decoded.update(rcvdLsa);
+  BOOST_CHECK_EQUAL(updated, true);
+  BOOST_CHECK(namesToAdd.empty());
+  BOOST_CHECK(namesToRemove.empty());
+  BOOST_CHECK_EQUAL(decoded.getAreaSummaries().size(), 1);
 }
 
 BOOST_AUTO_TEST_CASE(OperatorEquals)
@@ -231,6 +307,21 @@ BOOST_AUTO_TEST_CASE(Update)
   BOOST_CHECK(it != namesToAdd.end());
   it = std::find(namesToAdd.begin(), namesToAdd.end(), addedName2);
   BOOST_CHECK(it != namesToAdd.end());
+
+  // Removed names are reported, and names advertised by both versions keep their cost
+  auto rcvdLsa2 = std::make_shared<NameLsa>(ndn::Name("/yoursunny/_/%C1.Router/dal"), 3,
+                                            ndn::time::system_clock::now() + 3600_ms,
+                                            NamePrefixList{});
+  rcvdLsa2->addName(PrefixInfo(ndn::Name("/ndn"), 5));
+  rcvdLsa2->addName(addedName2);
+  std::tie(updated, namesToAdd, namesToRemove) = knownNameLsa.update(rcvdLsa2);
+  BOOST_CHECK_EQUAL(updated, true);
+  BOOST_CHECK_EQUAL(namesToAdd.size(), 0);
+  BOOST_REQUIRE_EQUAL(namesToRemove.size(), 2);
+  BOOST_CHECK_EQUAL(namesToRemove[0].getName(), "/yoursunny/_/dal");
+  BOOST_CHECK_EQUAL(namesToRemove[1], addedName1);
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl().size(), 2);
+  BOOST_CHECK_EQUAL(knownNameLsa.getNpl().getPrefixInfoForName("/ndn").getCost(), 0);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -67,6 +67,43 @@ BOOST_AUTO_TEST_CASE(Localhost)
   // Request Routing Table
   face.receive(ndn::Interest("/localhost/nlsr/routing-table").setCanBePrefix(true));
   processDatasetInterest([] (const ndn::Block& block) { return block.type() == nlsr::tlv::RoutingTable; });
+
+  // Request Topology
+  face.receive(ndn::Interest("/localhost/nlsr/topology").setCanBePrefix(true));
+  processDatasetInterest([] (const ndn::Block& block) { return block.type() == nlsr::tlv::Topology; });
+
+  // Request calculation profile
+  face.receive(ndn::Interest("/localhost/nlsr/routing-calc-profile").setCanBePrefix(true));
+  processDatasetInterest([] (const ndn::Block& block) {
+    return block.type() == nlsr::tlv::CalculationProfile;
+  });
+
+  // Request link metrics, one entry per neighbor
+  conf.getAdjacencyList().insert(Adjacent("/RouterB", ndn::FaceUri("udp://face-2"), 10,
+                                          Adjacent::STATUS_ACTIVE, 0, 0));
+  face.receive(ndn::Interest("/localhost/nlsr/link-metrics").setCanBePrefix(true));
+  processDatasetInterest([] (const ndn::Block& block) {
+    return block.type() == nlsr::tlv::ExternalMetrics;
+  });
+
+  // Request link cost statistics of the same neighbor
+  nlsr.getLinkCostManager().initialize();
+  face.receive(ndn::Interest("/localhost/nlsr/link-cost").setCanBePrefix(true));
+  processDatasetInterest([] (const ndn::Block& block) {
+    return block.type() == nlsr::tlv::LinkCostStatistics;
+  });
+
+  // Request latency histograms
+  face.receive(ndn::Interest("/localhost/nlsr/latency/list").setCanBePrefix(true));
+  processDatasetInterest([] (const ndn::Block& block) {
+    return block.type() == nlsr::tlv::LatencyStatistics;
+  });
+
+  // Request memory usage
+  face.receive(ndn::Interest("/localhost/nlsr/memory").setCanBePrefix(true));
+  processDatasetInterest([] (const ndn::Block& block) {
+    return block.type() == nlsr::tlv::MemoryUsage;
+  });
 }
 
 BOOST_AUTO_TEST_CASE(RouterName)
@@ -113,6 +150,137 @@ BOOST_AUTO_TEST_CASE(RouterName)
   // Request Routing Table
   face.receive(ndn::Interest(ndn::Name(routerName).append("routing-table")).setCanBePrefix(true));
   processDatasetInterest([] (const auto& block) { return block.type() == nlsr::tlv::RoutingTable; });
+
+  // Request Topology
+  face.receive(ndn::Interest(ndn::Name(routerName).append("topology")).setCanBePrefix(true));
+  processDatasetInterest([] (const auto& block) { return block.type() == nlsr::tlv::Topology; });
+}
+
+BOOST_AUTO_TEST_CASE(LsaDatasetCache)
+{
+  auto countAdjacencyLsas = [this] (const ndn::Name& name) {
+    face.receive(ndn::Interest(name).setCanBePrefix(true).setMustBeFresh(true));
+    advanceClocks(30_ms);
+    BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+    ndn::Block content(face.sentData[0].getContent());
+    content.parse();
+    face.sentData.clear();
+    return content.elements().size();
+  };
+  ndn::Name routerName(conf.getRouterPrefix());
+  routerName.append("nlsr");
+  const auto& cached =
+    nlsr.m_datasetHandler.m_encodedLsas[static_cast<size_t>(Lsa::Type::ADJACENCY)];
+
+  AdjLsa adjLsa;
+  adjLsa.m_originRouter = "/RouterA";
+  addAdjacency(adjLsa, "/RouterA/adjacency1", "udp://face-1", 10);
+  lsdb.installLsa(std::make_shared<AdjLsa>(adjLsa));
+  BOOST_CHECK_EQUAL(countAdjacencyLsas("/localhost/nlsr/lsdb/adjacencies"), 1);
+  auto wire = cached.wire;
+
+  // served again without encoding the LSAs again
+  BOOST_CHECK_EQUAL(countAdjacencyLsas(ndn::Name(routerName).append("lsdb/adjacencies")), 1);
+  BOOST_CHECK(cached.wire == wire);
+
+  // encoded again once the LSDB has changed, and the segments served before are stale
+  adjLsa.m_originRouter = "/RouterB";
+  lsdb.installLsa(std::make_shared<AdjLsa>(adjLsa));
+  advanceClocks(1_s, 2);
+  BOOST_CHECK_EQUAL(countAdjacencyLsas("/localhost/nlsr/lsdb/adjacencies"), 2);
+  BOOST_CHECK(cached.wire != wire);
+}
+
+BOOST_AUTO_TEST_CASE(LsaDatasetQuery)
+{
+  for (const auto& router : {"/RouterC", "/RouterA", "/RouterB"}) {
+    NameLsa nameLsa(router, 1, ndn::time::system_clock::now() + 3600_s,
+                    NamePrefixList{ndn::Name(router).append("app"), "/shared"});
+    lsdb.installLsa(std::make_shared<NameLsa>(nameLsa));
+  }
+  auto queryNameLsas = [this] (const LsdbQuery& query) {
+    ndn::Name name("/localhost/nlsr/lsdb/names");
+    name.append(ndn::tlv::GenericNameComponent, query.wireEncode());
+    face.receive(ndn::Interest(name).setCanBePrefix(true));
+    advanceClocks(30_ms);
+    BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+    ndn::Block content(face.sentData[0].getContent());
+    content.parse();
+    face.sentData.clear();
+    return content.elements();
+  };
+
+  // one router, with the prefixes under the filter only
+  LsdbQuery query;
+  query.originRouter = ndn::Name("/RouterB");
+  query.prefix = ndn::Name("/shared");
+  auto blocks = queryNameLsas(query);
+  BOOST_REQUIRE_EQUAL(blocks.size(), 1);
+  NameLsa lsa(blocks[0]);
+  BOOST_CHECK_EQUAL(lsa.getOriginRouter(), "/RouterB");
+  BOOST_CHECK_EQUAL(lsa.getNpl().size(), 1);
+
+  // pages of two LSAs, in the order of the origin routers
+  query = {};
+  query.prefix = ndn::Name("/shared");
+  query.pageSize = 2;
+  blocks = queryNameLsas(query);
+  BOOST_REQUIRE_EQUAL(blocks.size(), 3);
+  BOOST_CHECK_EQUAL(NameLsa(blocks[0]).getOriginRouter(), "/RouterA");
+  BOOST_CHECK_EQUAL(NameLsa(blocks[1]).getOriginRouter(), "/RouterB");
+  BOOST_REQUIRE_EQUAL(blocks[2].type(), nlsr::tlv::ContinuationToken);
+
+  query.continuation = ndn::Name(blocks[2].blockFromValue());
+  blocks = queryNameLsas(query);
+  BOOST_REQUIRE_EQUAL(blocks.size(), 1);
+  BOOST_CHECK_EQUAL(NameLsa(blocks[0]).getOriginRouter(), "/RouterC");
+
+  // a malformed query is rejected
+  face.receive(ndn::Interest("/localhost/nlsr/lsdb/names/malformed").setCanBePrefix(true));
+  advanceClocks(30_ms);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(ndn::mgmt::ControlResponse(face.sentData[0].getContent().blockFromValue())
+                      .getCode(), 400);
+}
+
+BOOST_AUTO_TEST_CASE(RoutingTableChangesDataset)
+{
+  NextHop hop(ndn::FaceUri("udp4://10.0.0.1:6363"), 10);
+  rt1.addNextHop("/RouterB", hop);
+  rt1.publishRoutingChange();
+
+  auto getChanges = [this] (const ndn::Name& name) {
+    face.receive(ndn::Interest(name).setCanBePrefix(true));
+    advanceClocks(30_ms);
+    BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+    ndn::Block content(face.sentData[0].getContent());
+    content.parse();
+    face.sentData.clear();
+    BOOST_REQUIRE_EQUAL(content.elements().size(), 1);
+    return RoutingTableChanges(content.elements().front());
+  };
+
+  // whole table without a version
+  auto changes = getChanges("/localhost/nlsr/routing-table-changes");
+  BOOST_CHECK(changes.isSnapshot);
+  BOOST_CHECK_EQUAL(changes.version, 1);
+  BOOST_CHECK_EQUAL(changes.delta.added.size(), 1);
+
+  changes = getChanges(ndn::Name("/localhost/nlsr/routing-table-changes").appendNumber(0));
+  BOOST_CHECK(!changes.isSnapshot);
+  BOOST_REQUIRE_EQUAL(changes.delta.added.size(), 1);
+  BOOST_CHECK_EQUAL(changes.delta.added.front().getDestination(), "/RouterB");
+
+  changes = getChanges(ndn::Name("/localhost/nlsr/routing-table-changes").appendNumber(1));
+  BOOST_CHECK_EQUAL(changes.version, 1);
+  BOOST_CHECK(changes.delta.empty());
+
+  // a malformed version is rejected
+  face.receive(ndn::Interest("/localhost/nlsr/routing-table-changes/latest").setCanBePrefix(true));
+  advanceClocks(30_ms);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(ndn::mgmt::ControlResponse(face.sentData[0].getContent().blockFromValue())
+                      .getCode(), 400);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
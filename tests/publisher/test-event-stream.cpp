@@ -0,0 +1,138 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/event-stream.hpp"
+
+#include "tests/publisher/publisher-fixture.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+
+#include <unistd.h>
+
+namespace nlsr::tests {
+
+class EventStreamFixture : public PublisherFixture
+{
+public:
+  EventStreamFixture()
+    : path("/tmp/nlsr-test-event-stream-" + std::to_string(::getpid()) + ".sock")
+    , client(m_io)
+  {
+  }
+
+  void
+  connect(EventStream& stream)
+  {
+    stream.listen(path);
+    client.connect(boost::asio::local::stream_protocol::endpoint(path));
+    advanceClocks(1_ms, 5);
+    BOOST_REQUIRE_EQUAL(stream.getClientCount(), 1);
+  }
+
+  /** \brief Reads the complete lines written to the client socket.
+   */
+  std::vector<std::string>
+  readLines()
+  {
+    advanceClocks(1_ms, 5);
+    while (client.available() > 0) {
+      std::array<char, 4096> buffer;
+      size_t nBytes = client.read_some(boost::asio::buffer(buffer));
+      received.append(buffer.data(), nBytes);
+    }
+
+    std::vector<std::string> lines;
+    for (auto newline = received.find('\n'); newline != std::string::npos;
+         newline = received.find('\n')) {
+      lines.push_back(received.substr(0, newline));
+      received.erase(0, newline + 1);
+    }
+    return lines;
+  }
+
+public:
+  const std::string path;
+  boost::asio::local::stream_protocol::socket client;
+  std::string received;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestEventStream, EventStreamFixture)
+
+BOOST_AUTO_TEST_CASE(StreamEvents)
+{
+  EventStream stream(m_io, conf.getAdjacencyList(), nlsr.m_lsdb, nlsr.m_routingTable, nlsr.m_fib,
+                     nlsr.getLinkCostManager());
+  // nothing is formatted without clients
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(createCoordinateLsa("/RouterA", 10.0, {2.0})));
+  BOOST_CHECK_EQUAL(stream.getLastSeqNo(), 0);
+
+  connect(stream);
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(createCoordinateLsa("/RouterB", 10.0, {2.0})));
+  nlsr.m_fib.afterEntryChanged("/prefix", NextHopsUriSortedSet());
+
+  auto lines = readLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 2);
+  BOOST_CHECK(boost::algorithm::starts_with(lines[0], "{\"seq\":1,"));
+  BOOST_CHECK(lines[0].find("\"type\":\"lsa\",\"origin\":\"/RouterB\",\"lsaType\":\"COORDINATE\","
+                            "\"seqNo\":1,\"update\":\"installed\"}") != std::string::npos);
+  BOOST_CHECK(boost::algorithm::starts_with(lines[1], "{\"seq\":2,"));
+  BOOST_CHECK(boost::algorithm::ends_with(lines[1],
+                                          "\"type\":\"fib\",\"name\":\"/prefix\",\"nexthops\":[]}"));
+
+  RoutingTableDelta delta;
+  delta.added.emplace_back(ndn::Name("/RouterB"));
+  delta.added.back().getNexthopList().addNextHop(createNextHop("udp4://10.0.0.2:6363", 12));
+  delta.removed.emplace_back("/RouterC");
+  nlsr.m_routingTable.afterRoutingDelta(delta);
+
+  lines = readLines();
+  BOOST_REQUIRE_EQUAL(lines.size(), 1);
+  BOOST_CHECK(boost::algorithm::ends_with(lines[0],
+    "\"type\":\"routing\",\"added\":[{\"destination\":\"/RouterB\",\"nexthops\":"
+    "[{\"faceUri\":\"udp4://10.0.0.2:6363\",\"cost\":12}]}],\"changed\":[],"
+    "\"removed\":[\"/RouterC\"]}"));
+  BOOST_CHECK_EQUAL(stream.getLastSeqNo(), 3);
+
+  stream.close();
+  BOOST_CHECK_NE(::access(path.data(), F_OK), 0);
+}
+
+BOOST_AUTO_TEST_CASE(DropSlowClient)
+{
+  EventStream stream(m_io, conf.getAdjacencyList(), nlsr.m_lsdb, nlsr.m_routingTable, nlsr.m_fib,
+                     nlsr.getLinkCostManager(), 400);
+  connect(stream);
+
+  // the first event is being written while the next ones are queued; each takes ~160 bytes
+  std::string members = "\"padding\":\"" + std::string(100, 'x') + "\"";
+  stream.publish("test", members);
+  stream.publish("test", members);
+  BOOST_CHECK_EQUAL(stream.getDroppedClientCount(), 0);
+  stream.publish("test", members);
+  BOOST_CHECK_EQUAL(stream.getDroppedClientCount(), 1);
+
+  advanceClocks(1_ms, 5);
+  BOOST_CHECK(!stream.hasClients());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
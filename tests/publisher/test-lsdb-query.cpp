@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/lsdb-query.hpp"
+#include "lsa/adj-lsa.hpp"
+#include "tlv-nlsr.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestLsdbQuery)
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  LsdbQuery empty(LsdbQuery().wireEncode());
+  BOOST_CHECK(!empty.originRouter);
+  BOOST_CHECK(!empty.prefix);
+  BOOST_CHECK_EQUAL(empty.minSeqNo, 0);
+  BOOST_CHECK_EQUAL(empty.maxSeqNo, std::numeric_limits<uint64_t>::max());
+  BOOST_CHECK_EQUAL(empty.pageSize, 0);
+  BOOST_CHECK(!empty.continuation);
+
+  LsdbQuery query;
+  query.originRouter = ndn::Name("/ndn/site/%C1.Router/router1");
+  query.prefix = ndn::Name("/ndn/app");
+  query.minSeqNo = 5;
+  query.maxSeqNo = 10;
+  query.pageSize = 100;
+  query.continuation = ndn::Name("/ndn/site/%C1.Router/router0");
+
+  LsdbQuery decoded(query.wireEncode());
+  BOOST_CHECK_EQUAL(*decoded.originRouter, *query.originRouter);
+  BOOST_CHECK_EQUAL(*decoded.prefix, *query.prefix);
+  BOOST_CHECK_EQUAL(decoded.minSeqNo, 5);
+  BOOST_CHECK_EQUAL(decoded.maxSeqNo, 10);
+  BOOST_CHECK_EQUAL(decoded.pageSize, 100);
+  BOOST_CHECK_EQUAL(*decoded.continuation, *query.continuation);
+
+  BOOST_CHECK_THROW(LsdbQuery(ndn::Block(nlsr::tlv::NameLsa)), LsdbQuery::Error);
+}
+
+BOOST_AUTO_TEST_CASE(Matches)
+{
+  auto expiration = ndn::time::system_clock::now();
+  NameLsa nameLsa("/router1", 7, expiration, NamePrefixList{"/app/a", "/app/b", "/other"});
+  AdjacencyList adjacencies;
+  AdjLsa adjLsa("/router1", 7, expiration, adjacencies);
+
+  LsdbQuery query;
+  BOOST_CHECK(query.matches(nameLsa));
+  BOOST_CHECK_EQUAL(query.getMatchingPrefixes(nameLsa).size(), 3);
+
+  query.originRouter = ndn::Name("/router2");
+  BOOST_CHECK(!query.matches(nameLsa));
+  query.originRouter = ndn::Name("/router1");
+  BOOST_CHECK(query.matches(nameLsa));
+
+  query.minSeqNo = 8;
+  BOOST_CHECK(!query.matches(nameLsa));
+  query.minSeqNo = 7;
+  query.maxSeqNo = 7;
+  BOOST_CHECK(query.matches(nameLsa));
+
+  // the LSAs after the previous page
+  query.continuation = ndn::Name("/router1");
+  BOOST_CHECK(!query.matches(nameLsa));
+  query.continuation = ndn::Name("/router0");
+  BOOST_CHECK(query.matches(nameLsa));
+
+  query.prefix = ndn::Name("/app");
+  BOOST_CHECK(query.matches(nameLsa));
+  auto prefixes = query.getMatchingPrefixes(nameLsa);
+  BOOST_REQUIRE_EQUAL(prefixes.size(), 2);
+  BOOST_CHECK_EQUAL(prefixes[0].getName(), "/app/a");
+  BOOST_CHECK_EQUAL(prefixes[1].getName(), "/app/b");
+  // only Name LSAs have prefixes
+  BOOST_CHECK(!query.matches(adjLsa));
+
+  query.prefix = ndn::Name("/none");
+  BOOST_CHECK(!query.matches(nameLsa));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,157 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/metrics-exporter.hpp"
+
+#include "tests/publisher/publisher-fixture.hpp"
+
+#include <boost/algorithm/string/predicate.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+
+#include <unistd.h>
+
+namespace nlsr::tests {
+
+class MetricsExporterFixture : public PublisherFixture
+{
+public:
+  MetricsExporterFixture()
+    : path("/tmp/nlsr-test-metrics-export-" + std::to_string(::getpid()) + ".sock")
+    , exporter(m_io, nlsr.m_lsdb, nlsr.m_routingTable, nlsr.m_namePrefixTable, nlsr.m_fib,
+               nlsr.m_statsCollector.getStatistics(), nlsr.getLinkCostManager(),
+               conf.getAdjacencyList())
+  {
+  }
+
+  std::string
+  request(const std::string& text)
+  {
+    boost::asio::local::stream_protocol::socket client(m_io);
+    client.connect(boost::asio::local::stream_protocol::endpoint(path));
+    boost::asio::write(client, boost::asio::buffer(text));
+    advanceClocks(1_ms, 5);
+
+    std::string response;
+    boost::system::error_code error;
+    boost::asio::read(client, boost::asio::dynamic_buffer(response), error);
+    BOOST_CHECK(error == boost::asio::error::eof);
+    return response;
+  }
+
+public:
+  const std::string path;
+  MetricsExporter exporter;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestMetricsExporter, MetricsExporterFixture)
+
+BOOST_AUTO_TEST_CASE(Collect)
+{
+  auto before = exporter.collect();
+
+  CoordinateLsa coordinateLsa = createCoordinateLsa("/RouterA", 10.0, {20.0, 30.0});
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(coordinateLsa));
+  NextHop nh = createNextHop("udp://face-test1", 10);
+  rt1.addNextHop("/RouterA", nh);
+  nlsr.m_statsCollector.getStatistics().increment(Statistics::PacketType::SENT_HELLO_INTEREST);
+
+  auto after = exporter.collect();
+  size_t coordinate = static_cast<size_t>(Lsa::Type::COORDINATE);
+  BOOST_CHECK_EQUAL(after.lsas[coordinate], before.lsas[coordinate] + 1);
+  BOOST_CHECK_EQUAL(after.routingTableEntries, before.routingTableEntries + 1);
+  size_t sentHelloInterest = static_cast<size_t>(Statistics::PacketType::SENT_HELLO_INTEREST);
+  BOOST_CHECK_EQUAL(after.packets[sentHelloInterest], before.packets[sentHelloInterest] + 1);
+  // no ML-adaptive calculation
+  BOOST_CHECK(!after.ml);
+}
+
+BOOST_AUTO_TEST_CASE(Render)
+{
+  MetricsExporter::Snapshot snapshot;
+  snapshot.packets[static_cast<size_t>(Statistics::PacketType::RCV_HELLO_DATA)] = 7;
+  snapshot.lsas[static_cast<size_t>(Lsa::Type::NAME)] = 3;
+  snapshot.ownLsaSegments[static_cast<size_t>(Lsa::Type::NAME)] = 2;
+  snapshot.fibEntries = 2;
+  CalculationProfileStatus::PhaseTiming timing;
+  timing.phase = "spf";
+  timing.count = 4;
+  timing.median = 1500_us;
+  timing.max = 2_ms;
+  snapshot.calculationProfile.addPhase(timing);
+  LinkCostStatistics link;
+  link.neighbor = "/RouterB";
+  link.nProbes = 10;
+  link.nSamples = 9;
+  link.rttP50 = 12_ms;
+  snapshot.links.push_back(link);
+  snapshot.linkCosts.emplace_back("/RouterB", 25);
+  snapshot.ml.emplace();
+  snapshot.ml->predictionCount = 5;
+  snapshot.syncIbfCells = 160;
+  snapshot.syncIbfResizes = 1;
+
+  std::string text = MetricsExporter::render(snapshot);
+  BOOST_CHECK(text.find("# TYPE nlsr_packets counter\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_packets_total{type=\"rcv_hello_data\"} 7\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_lsdb_lsas{type=\"name\"} 3\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_own_lsa_segments{type=\"name\"} 2\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_fib_entries 2\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_calculation_phase_seconds{phase=\"spf\",quantile=\"0.5\"} "
+                        "0.001500\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_calculation_phase_seconds_count{phase=\"spf\"} 4\n") !=
+              std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_link_rtt_seconds{neighbor=\"/RouterB\",quantile=\"0.5\"} "
+                        "0.012000\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_link_probes_total{neighbor=\"/RouterB\"} 10\n") !=
+              std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_link_cost{neighbor=\"/RouterB\"} 25.000000\n") !=
+              std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_ml_predictions_total 5\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_sync_ibf_cells 160\n") != std::string::npos);
+  BOOST_CHECK(text.find("\nnlsr_sync_ibf_resizes_total 1\n") != std::string::npos);
+  BOOST_CHECK(boost::algorithm::ends_with(text, "\n# EOF\n"));
+
+  snapshot.ml.reset();
+  BOOST_CHECK(MetricsExporter::render(snapshot).find("nlsr_ml_") == std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(Serve)
+{
+  exporter.listen(path);
+
+  std::string response = request("GET /metrics HTTP/1.1\r\nHost: localhost\r\n\r\n");
+  BOOST_CHECK(boost::algorithm::starts_with(response, "HTTP/1.0 200 OK\r\n"));
+  BOOST_CHECK(response.find("Content-Type: application/openmetrics-text") != std::string::npos);
+  BOOST_CHECK(boost::algorithm::ends_with(response, "\n# EOF\n"));
+  BOOST_CHECK_EQUAL(exporter.getScrapeCount(), 1);
+
+  response = request("POST /metrics HTTP/1.1\r\n\r\n");
+  BOOST_CHECK(boost::algorithm::starts_with(response, "HTTP/1.0 405 "));
+  BOOST_CHECK_EQUAL(exporter.getScrapeCount(), 1);
+
+  exporter.close();
+  BOOST_CHECK_NE(::access(path.data(), F_OK), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
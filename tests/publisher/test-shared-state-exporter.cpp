@@ -0,0 +1,127 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "publisher/shared-state-exporter.hpp"
+
+#include "tests/publisher/publisher-fixture.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace nlsr::tests {
+
+using namespace shared_state;
+
+class SharedStateExporterFixture : public PublisherFixture
+{
+public:
+  SharedStateExporterFixture()
+    : path("/tmp/nlsr-test-shared-state-" + std::to_string(::getpid()) + ".shm")
+    , scheduler(m_io)
+  {
+  }
+
+  std::string_view
+  getString(const uint8_t* region, const String& string)
+  {
+    return {reinterpret_cast<const char*>(region) + string.offset, string.length};
+  }
+
+  template<typename T>
+  const T&
+  getRecord(const uint8_t* region, uint32_t offset, size_t index)
+  {
+    return reinterpret_cast<const T*>(region + offset)[index];
+  }
+
+public:
+  const std::string path;
+  ndn::Scheduler scheduler;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestSharedStateExporter, SharedStateExporterFixture)
+
+BOOST_AUTO_TEST_CASE(Publish)
+{
+  SharedStateExporter exporter(scheduler, path, rt1, nlsr.getLinkCostManager());
+  BOOST_CHECK_EQUAL(exporter.getSeqNo(), 2);
+
+  NextHop hop1 = createNextHop("udp4://10.0.0.2:6363", 12);
+  NextHop hop2 = createNextHop("udp4://10.0.0.3:6363", 15);
+  rt1.addNextHop("/RouterB", hop1);
+  rt1.addNextHop("/RouterB", hop2);
+  rt1.afterRoutingChange(rt1.getRoutingTableEntry());
+  BOOST_CHECK_EQUAL(exporter.getSeqNo(), 4);
+
+  // read through a separate read-only mapping, as an agent would
+  int fd = ::open(path.data(), O_RDONLY);
+  BOOST_REQUIRE_GE(fd, 0);
+  auto size = static_cast<size_t>(::lseek(fd, 0, SEEK_END));
+  void* mapping = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd);
+  BOOST_REQUIRE(mapping != MAP_FAILED);
+  const auto* region = static_cast<const uint8_t*>(mapping);
+  const auto* header = reinterpret_cast<const Header*>(region);
+
+  BOOST_CHECK_EQUAL(header->magic, MAGIC);
+  BOOST_CHECK_EQUAL(header->layoutVersion, LAYOUT_VERSION);
+  BOOST_CHECK_EQUAL(header->seq.load(std::memory_order_acquire), 4);
+  BOOST_CHECK_EQUAL(header->size, size);
+  BOOST_REQUIRE_EQUAL(header->nRoutes, 1);
+  BOOST_REQUIRE_EQUAL(header->nNextHops, 2);
+  const auto& route = getRecord<Route>(region, header->routesOffset, 0);
+  BOOST_CHECK_EQUAL(getString(region, route.destination), "/RouterB");
+  BOOST_CHECK_EQUAL(route.firstNextHop, 0);
+  BOOST_CHECK_EQUAL(route.nNextHops, 2);
+  const auto& hop = getRecord<NextHop>(region, header->nextHopsOffset, 0);
+  BOOST_CHECK_EQUAL(getString(region, hop.faceUri), "udp4://10.0.0.2:6363");
+  BOOST_CHECK_EQUAL(hop.cost, 12);
+  BOOST_CHECK_EQUAL(getRecord<NextHop>(region, header->nextHopsOffset, 1).cost, 15);
+  ::munmap(mapping, size);
+
+  // the link metrics are refreshed periodically
+  advanceClocks(1_s);
+  BOOST_CHECK_GE(exporter.getSeqNo(), 6);
+}
+
+BOOST_AUTO_TEST_CASE(Grow)
+{
+  SharedStateExporter exporter(scheduler, path, rt1, nlsr.getLinkCostManager());
+  size_t initialSize = reinterpret_cast<const Header*>(exporter.getRegion())->size;
+
+  NextHop hop = createNextHop("udp4://10.0.0.2:6363", 12);
+  for (int i = 0; i < 2000; ++i) {
+    rt1.addNextHop(ndn::Name("/Router").appendNumber(i), hop);
+  }
+  exporter.write();
+
+  const auto* header = reinterpret_cast<const Header*>(exporter.getRegion());
+  BOOST_CHECK_GT(header->size, initialSize);
+  BOOST_CHECK_EQUAL(header->nRoutes, 2000);
+  const auto& last = getRecord<Route>(exporter.getRegion(), header->routesOffset, 1999);
+  BOOST_CHECK_EQUAL(getString(exporter.getRegion(), last.destination),
+                    ndn::Name("/Router").appendNumber(1999).toUri());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
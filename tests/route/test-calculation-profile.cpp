@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/calculation-profile.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+using namespace ndn::time_literals;
+
+BOOST_AUTO_TEST_SUITE(TestCalculationProfile)
+
+BOOST_AUTO_TEST_CASE(RollingStatistics)
+{
+  CalculationProfile profile;
+  BOOST_CHECK(profile.getStatus().getPhases().empty());
+
+  // The first samples fall out of the window
+  for (int i = 0; i < 50; ++i) {
+    profile.record(CalculationProfile::PHASE_SPF, 1_s);
+  }
+  for (int i = 1; i <= 100; ++i) {
+    profile.record(CalculationProfile::PHASE_SPF, ndn::time::milliseconds(i));
+  }
+  profile.record(CalculationProfile::PHASE_PUBLISH, 3_ms);
+
+  auto phases = profile.getStatus().getPhases();
+  BOOST_REQUIRE_EQUAL(phases.size(), 2);
+  BOOST_CHECK_EQUAL(phases[0].phase, "spf");
+  BOOST_CHECK_EQUAL(phases[0].count, 150);
+  BOOST_CHECK_EQUAL(phases[0].last, 100_ms);
+  BOOST_CHECK_EQUAL(phases[0].max, 1_s);
+  BOOST_CHECK_EQUAL(phases[1].phase, "publish");
+  BOOST_CHECK_EQUAL(phases[1].median, 3_ms);
+
+  for (int i = 0; i < 28; ++i) {
+    profile.record(CalculationProfile::PHASE_SPF, 1_ms);
+  }
+  phases = profile.getStatus().getPhases();
+  BOOST_CHECK_EQUAL(phases[0].max, 100_ms);
+  BOOST_CHECK_EQUAL(phases[0].p90, 88_ms);
+}
+
+BOOST_AUTO_TEST_CASE(Encoding)
+{
+  CalculationProfile profile;
+  profile.record(CalculationProfile::PHASE_GRAPH, 1500_us);
+  profile.record(CalculationProfile::PHASE_TOTAL, 2_ms);
+
+  CalculationProfileStatus decoded(profile.getStatus().wireEncode());
+  BOOST_REQUIRE_EQUAL(decoded.getPhases().size(), 2);
+  BOOST_CHECK_EQUAL(decoded.getPhases()[0].phase, "graph");
+  BOOST_CHECK_EQUAL(decoded.getPhases()[0].last, 1500_us);
+  BOOST_CHECK_EQUAL(decoded.getPhases()[1].phase, "total");
+  BOOST_CHECK_EQUAL(decoded.getPhases()[1].count, 1);
+  BOOST_CHECK_EQUAL(decoded.getPhases()[1].p90, 2_ms);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -26,6 +26,7 @@
 #include "tests/io-key-chain-fixture.hpp"
 
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
+#include <ndn-cxx/mgmt/nfd/rib-entry.hpp>
 #include <ndn-cxx/util/dummy-client-face.hpp>
 
 namespace nlsr::tests {
@@ -145,7 +146,14 @@ BOOST_AUTO_TEST_CASE(NextHopsNoChange)
   fib.update("/ndn/name", oldHops);
   face.processEvents(ndn::time::milliseconds(-1));
 
-  // Should register face 1 and 2 for /ndn/name
+  // Nothing changed, so nothing is sent to NFD
+  BOOST_CHECK_EQUAL(interests.size(), 0);
+
+  // A recreated face has lost its routes, so they are registered again
+  adjacencies.setFaceId(router2Name, 22);
+  fib.update("/ndn/name", oldHops);
+  face.processEvents(ndn::time::milliseconds(-1));
+
   BOOST_REQUIRE_EQUAL(interests.size(), 2);
 
   ndn::nfd::ControlParameters extractedParameters;
@@ -162,10 +170,39 @@ BOOST_AUTO_TEST_CASE(NextHopsNoChange)
   extractRibCommandParameters(*it, verb, extractedParameters);
 
   BOOST_CHECK(extractedParameters.getName() == "/ndn/name" &&
-              extractedParameters.getFaceId() == router2FaceId &&
+              extractedParameters.getFaceId() == 22 &&
               verb == ndn::Name::Component("register"));
 }
 
+BOOST_AUTO_TEST_CASE(NextHopsCostChange)
+{
+  NexthopList hops;
+  hops.addNextHop(NextHop(router1FaceUri, 10));
+  fib.update("/ndn/name", hops);
+  face.processEvents(ndn::time::milliseconds(-1));
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  interests.clear();
+
+  NexthopList newHops;
+  newHops.addNextHop(NextHop(router1FaceUri, 15));
+  fib.update("/ndn/name", newHops);
+  face.processEvents(ndn::time::milliseconds(-1));
+
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  ndn::nfd::ControlParameters extractedParameters;
+  ndn::Name::Component verb;
+  extractRibCommandParameters(interests.front(), verb, extractedParameters);
+  BOOST_CHECK_EQUAL(verb, ndn::Name::Component("register"));
+  BOOST_CHECK_EQUAL(extractedParameters.getCost(), 15);
+  interests.clear();
+
+  // the entry holds the new cost, so the same update again changes nothing
+  fib.update("/ndn/name", newHops);
+  face.processEvents(ndn::time::milliseconds(-1));
+  BOOST_CHECK_EQUAL(interests.size(), 0);
+  BOOST_CHECK_EQUAL(fib.m_table.at("/ndn/name").nexthopSet.begin()->getRouteCost(), 15);
+}
+
 BOOST_AUTO_TEST_CASE(NextHopsRemoveAll)
 {
   NextHop hop1(router1FaceUri, 10);
@@ -307,13 +344,42 @@ BOOST_FIXTURE_TEST_CASE(ScheduleFibEntryRefresh, FibFixture)
   FibEntry fe;
   fe.name = name1;
   int origSeqNo = fe.seqNo;
-  fib.m_table.emplace(name1, std::move(fe));
+  auto& entry = fib.m_table.emplace(name1, std::move(fe)).first->second;
+
+  fib.scheduleEntryRefresh(entry);
+  this->advanceClocks(ndn::time::milliseconds(10), 100);
+  BOOST_CHECK_EQUAL(entry.seqNo, origSeqNo + 1);
+}
+
+BOOST_AUTO_TEST_CASE(RefreshSweep)
+{
+  fib.setEntryRefreshTime(10);
 
-  fib.scheduleEntryRefresh(fe, [&] (auto& entry) { BOOST_CHECK_EQUAL(origSeqNo + 1, entry.seqNo); });
-  this->advanceClocks(ndn::time::milliseconds(10), 1);
+  NexthopList hops;
+  hops.addNextHop(NextHop(router1FaceUri, 10));
+  for (int i = 0; i < 10; ++i) {
+    fib.update(ndn::Name("/prefix").appendNumber(i), hops);
+  }
+  advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(interests.size(), 10);
+  interests.clear();
 
-  // avoid "test case [...] did not check any assertions" message from Boost.Test
-  BOOST_CHECK(true);
+  // Not before half of the refresh time, then one per second, and all before the refresh time
+  advanceClocks(1_s, 4);
+  BOOST_CHECK_EQUAL(interests.size(), 0);
+  for (int i = 1; i <= 4; ++i) {
+    advanceClocks(1_s);
+    BOOST_CHECK_EQUAL(interests.size(), i);
+  }
+  advanceClocks(1_s);
+  BOOST_CHECK_EQUAL(interests.size(), 10);
+
+  // A removed entry is no longer refreshed
+  fib.remove(ndn::Name("/prefix").appendNumber(0));
+  advanceClocks(10_ms);
+  interests.clear();
+  advanceClocks(1_s, 9);
+  BOOST_CHECK_EQUAL(interests.size(), 9);
 }
 
 BOOST_AUTO_TEST_CASE(ShouldNotRefreshNeighborRoute) // #4799
@@ -385,6 +451,116 @@ BOOST_AUTO_TEST_CASE(PrefixWithdrawalFibUpdateBug) // #5179
   BOOST_CHECK_EQUAL(numRegister, 3);
 }
 
+BOOST_AUTO_TEST_CASE(LongestPrefixMatch)
+{
+  NexthopList hops;
+  hops.addNextHop(NextHop(router1FaceUri, 10));
+  fib.update("/ndn", hops);
+  fib.update("/ndn/edu/site", hops);
+
+  BOOST_REQUIRE(fib.findLongestPrefixMatch("/ndn/edu/site/host") != nullptr);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/ndn/edu/site/host")->name, "/ndn/edu/site");
+  BOOST_REQUIRE(fib.findLongestPrefixMatch("/ndn/edu") != nullptr);
+  BOOST_CHECK_EQUAL(fib.findLongestPrefixMatch("/ndn/edu")->name, "/ndn");
+  BOOST_CHECK(fib.findLongestPrefixMatch("/other") == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(CommandWindow)
+{
+  conf.setFibCommandWindow(1);
+
+  fib.registerPrefix("/a", router1FaceUri, 10, 1_h, ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+  fib.registerPrefix("/b", router1FaceUri, 10, 1_h, ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+  fib.registerPrefix("/c", router2FaceUri, 10, 1_h, ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+  // replaces the queued command for /b on face 1
+  fib.registerPrefix("/b", router1FaceUri, 20, 1_h, ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+
+  BOOST_CHECK_EQUAL(fib.m_nInFlightRibCommands, 1);
+  BOOST_CHECK_EQUAL(fib.m_queuedRibCommands.size(), 2);
+
+  advanceClocks(10_ms, 10);
+  BOOST_CHECK_EQUAL(fib.m_nInFlightRibCommands, 0);
+  BOOST_CHECK(fib.m_queuedRibCommands.empty());
+
+  BOOST_REQUIRE_EQUAL(interests.size(), 3);
+  ndn::nfd::ControlParameters extractedParameters;
+  ndn::Name::Component verb;
+  extractRibCommandParameters(interests[0], verb, extractedParameters);
+  BOOST_CHECK_EQUAL(extractedParameters.getName(), "/a");
+  extractRibCommandParameters(interests[1], verb, extractedParameters);
+  BOOST_CHECK_EQUAL(extractedParameters.getName(), "/b");
+  BOOST_CHECK_EQUAL(extractedParameters.getCost(), 20);
+  extractRibCommandParameters(interests[2], verb, extractedParameters);
+  BOOST_CHECK_EQUAL(extractedParameters.getName(), "/c");
+}
+
+BOOST_AUTO_TEST_CASE(ReconcileWithRib)
+{
+  fib.setEntryRefreshTime(3600);
+
+  auto makeRibEntry = [] (const ndn::Name& name, uint64_t faceId, uint64_t cost,
+                          ndn::time::milliseconds expiration,
+                          ndn::nfd::RouteOrigin origin = ndn::nfd::ROUTE_ORIGIN_NLSR) {
+    ndn::nfd::RibEntry entry;
+    entry.setName(name);
+    entry.addRoute(ndn::nfd::Route()
+                     .setFaceId(faceId)
+                     .setOrigin(origin)
+                     .setCost(cost)
+                     .setFlags(ndn::nfd::ROUTE_FLAG_CAPTURE)
+                     .setExpirationPeriod(expiration));
+    return entry;
+  };
+
+  std::vector<ndn::nfd::RibEntry> ribEntries{
+    makeRibEntry("/ndn/name", router1FaceId, 10, 1_h),
+    makeRibEntry("/ndn/name", router2FaceId, 30, 1_h),
+    makeRibEntry("/ndn/soon", router1FaceId, 10, 30_s),
+    makeRibEntry("/ndn/gone", router3FaceId, 10, 1_h),
+    makeRibEntry("/ndn/app", router3FaceId, 10, 1_h, ndn::nfd::ROUTE_ORIGIN_APP),
+  };
+  fib.processRibDataset(ribEntries, 60_s);
+  BOOST_CHECK_EQUAL(fib.m_staleRoutes.size(), 4);
+
+  NexthopList hops;
+  hops.addNextHop(NextHop(router1FaceUri, 10));
+  hops.addNextHop(NextHop(router2FaceUri, 20));
+  fib.update("/ndn/name", hops);
+
+  NexthopList soonHops;
+  soonHops.addNextHop(NextHop(router1FaceUri, 10));
+  fib.update("/ndn/soon", soonHops);
+  advanceClocks(10_ms);
+
+  // Only the route whose cost changed is registered
+  ndn::nfd::ControlParameters extractedParameters;
+  ndn::Name::Component verb;
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  extractRibCommandParameters(interests.back(), verb, extractedParameters);
+  BOOST_CHECK_EQUAL(verb, ndn::Name::Component("register"));
+  BOOST_CHECK_EQUAL(extractedParameters.getName(), "/ndn/name");
+  BOOST_CHECK_EQUAL(extractedParameters.getFaceId(), router2FaceId);
+  BOOST_CHECK_EQUAL(fib.m_staleRoutes.size(), 1);
+  interests.clear();
+
+  // A claimed route is registered again before it expires
+  advanceClocks(1_s, 20);
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  extractRibCommandParameters(interests.back(), verb, extractedParameters);
+  BOOST_CHECK_EQUAL(verb, ndn::Name::Component("register"));
+  BOOST_CHECK_EQUAL(extractedParameters.getName(), "/ndn/soon");
+  interests.clear();
+
+  // The route that was not computed again is removed after the grace period
+  advanceClocks(1_s, 40);
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  extractRibCommandParameters(interests.back(), verb, extractedParameters);
+  BOOST_CHECK_EQUAL(verb, ndn::Name::Component("unregister"));
+  BOOST_CHECK_EQUAL(extractedParameters.getName(), "/ndn/gone");
+  BOOST_CHECK_EQUAL(extractedParameters.getFaceId(), router3FaceId);
+  BOOST_CHECK(fib.m_staleRoutes.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
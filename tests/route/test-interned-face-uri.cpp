@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "route/interned-face-uri.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <vector>
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestInternedFaceUri)
+
+BOOST_AUTO_TEST_CASE(Identity)
+{
+  InternedFaceUri uri1(ndn::FaceUri("udp4://192.168.3.1:6363"));
+  InternedFaceUri uri2(ndn::FaceUri("udp4://192.168.3.1:6363"));
+  InternedFaceUri uri3(ndn::FaceUri("udp4://192.168.3.2:6363"));
+
+  BOOST_CHECK(uri1 == uri2);
+  BOOST_CHECK(&uri1.get() == &uri2.get());
+  BOOST_CHECK(uri1 != uri3);
+  BOOST_CHECK_EQUAL(uri3.get(), ndn::FaceUri("udp4://192.168.3.2:6363"));
+
+  BOOST_CHECK(InternedFaceUri() == InternedFaceUri(ndn::FaceUri()));
+}
+
+BOOST_AUTO_TEST_CASE(Order)
+{
+  // interned in increasing, then decreasing, then alternating order
+  std::vector<ndn::FaceUri> uris;
+  for (int i = 100; i < 200; ++i) {
+    uris.emplace_back("udp4://10.0.1." + std::to_string(i) + ":6363");
+  }
+  for (int i = 199; i >= 100; --i) {
+    uris.emplace_back("udp4://10.0.0." + std::to_string(i) + ":6363");
+  }
+  for (int i = 0; i < 100; ++i) {
+    uris.emplace_back("udp4://10.0.2." + std::to_string(i % 2 ? 199 - i / 2 : 100 + i / 2) +
+                      ":6363");
+  }
+
+  std::vector<InternedFaceUri> interned;
+  for (const auto& uri : uris) {
+    interned.emplace_back(uri);
+  }
+
+  for (size_t i = 0; i < uris.size(); ++i) {
+    for (size_t j = 0; j < uris.size(); ++j) {
+      BOOST_TEST_CONTEXT(uris[i] << " and " << uris[j]) {
+        BOOST_CHECK_EQUAL(interned[i] < interned[j], uris[i] < uris[j]);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
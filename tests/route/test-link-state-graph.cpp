@@ -0,0 +1,134 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/link-state-graph.hpp"
+
+#include "adjacent.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestLinkStateGraph)
+
+BOOST_AUTO_TEST_CASE(Symmetric)
+{
+  auto graph = LinkStateGraph::createFromEdges(3, {
+    {2, 0, 10.0}, {0, 1, 5.0}, {1, 0, 5.0}, {0, 2, 10.0},
+  });
+
+  BOOST_CHECK_EQUAL(graph.size(), 3);
+  BOOST_CHECK_EQUAL(graph.getNumEdges(), 4);
+
+  auto neighbors = graph.getNeighbors(0);
+  BOOST_REQUIRE_EQUAL(neighbors.size(), 2);
+  BOOST_CHECK_EQUAL(neighbors[0], 1);
+  BOOST_CHECK_EQUAL(neighbors[1], 2);
+  BOOST_CHECK_EQUAL(graph.getCosts(0)[0], 5 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(graph.getCosts(0)[1], 10 * LINK_COST_SCALE);
+
+  BOOST_CHECK_EQUAL(graph.getCost(1, 0), 5.0);
+  BOOST_CHECK_EQUAL(graph.getCost(2, 0), 10.0);
+  BOOST_CHECK_EQUAL(graph.getCost(1, 2), Adjacent::NON_ADJACENT_COST);
+}
+
+BOOST_AUTO_TEST_CASE(AsymmetricUsesHigherCost)
+{
+  auto graph = LinkStateGraph::createFromEdges(2, {{0, 1, 5.0}, {1, 0, 8.0}});
+
+  BOOST_CHECK_EQUAL(graph.getCost(0, 1), 8.0);
+  BOOST_CHECK_EQUAL(graph.getCost(1, 0), 8.0);
+}
+
+BOOST_AUTO_TEST_CASE(OneSidedOrBrokenLinkIsDropped)
+{
+  auto graph = LinkStateGraph::createFromEdges(3, {
+    {0, 1, 5.0},                                              // not advertised by 1
+    {0, 2, 10.0}, {2, 0, Adjacent::NON_ADJACENT_COST},       // broken on one side
+  });
+
+  BOOST_CHECK_EQUAL(graph.getNumEdges(), 0);
+  BOOST_CHECK_EQUAL(graph.getNeighbors(0).size(), 0);
+  BOOST_CHECK_EQUAL(graph.getCost(0, 1), Adjacent::NON_ADJACENT_COST);
+  BOOST_CHECK_EQUAL(graph.getCost(2, 0), Adjacent::NON_ADJACENT_COST);
+}
+
+BOOST_AUTO_TEST_CASE(LaterAdvertisementWins)
+{
+  auto graph = LinkStateGraph::createFromEdges(2, {{0, 1, 5.0}, {1, 0, 3.0}, {0, 1, 3.0}});
+
+  BOOST_CHECK_EQUAL(graph.getNumEdges(), 2);
+  BOOST_CHECK_EQUAL(graph.getCost(0, 1), 3.0);
+}
+
+BOOST_AUTO_TEST_CASE(SetCost)
+{
+  auto graph = LinkStateGraph::createFromEdges(3, {{0, 1, 5.0}, {1, 0, 5.0}});
+
+  graph.setCost(0, 1, 7.0);
+  BOOST_CHECK_EQUAL(graph.getCost(0, 1), 7.0);
+  BOOST_CHECK_EQUAL(graph.getCost(1, 0), 7.0);
+
+  // no link is added
+  graph.setCost(0, 2, 7.0);
+  BOOST_CHECK_EQUAL(graph.getNumEdges(), 2);
+  BOOST_CHECK_EQUAL(graph.getCost(0, 2), Adjacent::NON_ADJACENT_COST);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveLink)
+{
+  auto graph = LinkStateGraph::createFromEdges(3, {{0, 1, 5.0}, {1, 0, 5.0}, {1, 2, 3.0},
+                                                   {2, 1, 3.0}, {0, 2, 4.0}, {2, 0, 4.0}});
+
+  graph.removeLink(1, 0);
+  BOOST_CHECK_EQUAL(graph.getNumEdges(), 4);
+  BOOST_CHECK_EQUAL(graph.getCost(0, 1), Adjacent::NON_ADJACENT_COST);
+  BOOST_CHECK_EQUAL(graph.getCost(1, 0), Adjacent::NON_ADJACENT_COST);
+  BOOST_CHECK_EQUAL(graph.getCost(0, 2), 4.0);
+  BOOST_CHECK_EQUAL(graph.getCost(2, 1), 3.0);
+
+  // nothing to remove
+  graph.removeLink(0, 1);
+  BOOST_CHECK_EQUAL(graph.getNumEdges(), 4);
+}
+
+BOOST_AUTO_TEST_CASE(FixedPointCosts)
+{
+  BOOST_CHECK_EQUAL(toLinkCost(7.4), 7400);
+  BOOST_CHECK_EQUAL(toLinkCost(0.0074), 7);
+  BOOST_CHECK_EQUAL(toLinkCost(0.0076), 8);
+  // a positive cost is never free
+  BOOST_CHECK_EQUAL(toLinkCost(0.0001), 1);
+  BOOST_CHECK_EQUAL(toLinkCost(0.0), 0);
+  BOOST_CHECK_EQUAL(toLinkCost(-1.0), 0);
+  BOOST_CHECK_EQUAL(toLinkCost(1e12), MAX_LINK_COST);
+  BOOST_CHECK_EQUAL(fromLinkCost(7400), 7.4);
+
+  auto graph = LinkStateGraph::createFromEdges(2, {{0, 1, 2.4}, {1, 0, 2.4}});
+  BOOST_CHECK_EQUAL(graph.getCosts(0)[0], 2400);
+  BOOST_CHECK_EQUAL(graph.getCost(0, 1), 2.4);
+  graph.setCost(0, 1, 3.6004);
+  BOOST_CHECK_EQUAL(graph.getCosts(1)[0], 3600);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,174 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/ml-adaptive-calculator.hpp"
+#include "nlsr.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <system_error>
+#include <thread>
+
+namespace nlsr::tests {
+
+class MLAdaptiveCalculatorFixture : public IoKeyChainFixture
+{
+public:
+  MLAdaptiveCalculatorFixture()
+    : face(m_io, m_keyChain, {true, true})
+    , conf(face, m_keyChain)
+    , confProcessor(conf)
+    , nlsr(face, m_keyChain, conf)
+    , linkCostManager(nlsr.getLinkCostManager())
+  {
+    conf.getAdjacencyList().insert(Adjacent(NEIGHBOR, ndn::FaceUri("udp4://10.0.0.1:6363"), 10,
+                                            Adjacent::STATUS_ACTIVE, 0, 300));
+    linkCostManager.initialize();
+    this->advanceClocks(10_ms);
+  }
+
+  ~MLAdaptiveCalculatorFixture()
+  {
+    std::error_code ec;
+    std::filesystem::remove(checkpoint, ec); // ignore error
+  }
+
+  /// Let the training worker publish the model to the io_context.
+  void
+  waitForModel(const MLAdaptiveCalculator& calculator)
+  {
+    for (int i = 0; i < 1000 && !calculator.isModelReady(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      advanceClocks(1_ms);
+    }
+  }
+
+public:
+  const ndn::Name NEIGHBOR = "/ndn/site/%C1.Router/router-b";
+  const std::string stateDir = "/tmp";
+  const std::filesystem::path checkpoint{"/tmp/nlsrMlModel.bin"};
+
+  ndn::DummyClientFace face;
+  ConfParameter conf;
+  DummyConfFileProcessor confProcessor;
+  Nlsr nlsr;
+  LinkCostManager& linkCostManager;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestMLAdaptiveCalculator, MLAdaptiveCalculatorFixture)
+
+BOOST_AUTO_TEST_CASE(Checkpoint)
+{
+  {
+    MLAdaptiveCalculator calculator(linkCostManager, stateDir);
+    BOOST_CHECK(!calculator.isModelReady());
+    // the prediction error is large enough to trigger a model update
+    calculator.reportPathPerformance(NEIGHBOR, 0.0);
+    waitForModel(calculator);
+    BOOST_CHECK(calculator.isModelReady());
+  }
+  BOOST_CHECK(std::filesystem::exists(checkpoint));
+
+  {
+    MLAdaptiveCalculator calculator(linkCostManager, stateDir);
+    BOOST_CHECK(calculator.isModelReady());
+  }
+
+  // a truncated checkpoint is ignored
+  std::filesystem::resize_file(checkpoint, 20);
+  MLAdaptiveCalculator calculator(linkCostManager, stateDir);
+  BOOST_CHECK(!calculator.isModelReady());
+}
+
+BOOST_AUTO_TEST_CASE(NoCheckpoint)
+{
+  {
+    MLAdaptiveCalculator calculator(linkCostManager);
+    calculator.reportPathPerformance(NEIGHBOR, 0.0);
+  }
+  BOOST_CHECK(!std::filesystem::exists(checkpoint));
+}
+
+BOOST_AUTO_TEST_CASE(TrainOnWorker)
+{
+  MLAdaptiveCalculator calculator(linkCostManager);
+  calculator.reportPathPerformance(NEIGHBOR, 0.0);
+  // the trained model is only installed by the io_context
+  BOOST_CHECK(!calculator.isModelReady());
+  BOOST_CHECK_EQUAL(calculator.getStatistics().modelUpdateCount, 0);
+
+  waitForModel(calculator);
+  BOOST_CHECK(calculator.isModelReady());
+  BOOST_CHECK_EQUAL(calculator.getStatistics().modelUpdateCount, 1);
+}
+
+BOOST_AUTO_TEST_CASE(RttWindowSums)
+{
+  MLAdaptiveCalculator::RttWindow window;
+  BOOST_CHECK(window.empty());
+  BOOST_CHECK_EQUAL(window.getMean(), 0.0);
+
+  for (int i = 0; i < 25; ++i) {
+    window.add(i < 5 ? 1000.0 : 100.0);
+  }
+  // the five slow samples were evicted
+  BOOST_CHECK_EQUAL(window.size(), MLAdaptiveCalculator::RttWindow::CAPACITY);
+  BOOST_CHECK_EQUAL(window.getSuccessCount(), MLAdaptiveCalculator::RttWindow::CAPACITY);
+  BOOST_CHECK_CLOSE(window.getMean(), 100.0, 1e-9);
+  BOOST_CHECK_SMALL(window.getVariance(), 1e-6);
+
+  window.add(300.0);
+  BOOST_CHECK_EQUAL(window.getSamples().front(), 100.0);
+  BOOST_CHECK_EQUAL(window.getSamples().back(), 300.0);
+  BOOST_CHECK_CLOSE(window.getMean(), 110.0, 1e-9);
+  BOOST_CHECK_CLOSE(window.getVariance(), 1900.0, 1e-6);
+
+  window.clear();
+  BOOST_CHECK(window.empty());
+  BOOST_CHECK_EQUAL(window.getSuccessCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NextSlotForecast)
+{
+  using Learner = MLAdaptiveCalculator::TemporalPatternLearner;
+  Learner learner;
+  auto now = std::chrono::system_clock::now();
+  auto next = learner.getNextSlotStart(now);
+  BOOST_CHECK(next > now);
+  BOOST_CHECK(next - now <= std::chrono::minutes(Learner::SLOT_MINUTES));
+  BOOST_CHECK(learner.getNextSlotStart(next) - next == std::chrono::minutes(Learner::SLOT_MINUTES));
+  BOOST_CHECK_EQUAL(learner.getSlot(next), (learner.getSlot(now) + 1) % Learner::SLOTS_PER_DAY);
+
+  learner.updatePattern(0, 0.9);
+  BOOST_CHECK_CLOSE(learner.getTimeFeature(0), 0.9, 1e-4);
+  BOOST_CHECK_EQUAL(learner.getTimeFeature(0, learner.getSlot(next)), 0.5);
+
+  // no link has RTT history yet, so there is nothing to forecast
+  MLAdaptiveCalculator calculator(linkCostManager);
+  BOOST_CHECK(!calculator.forecastNextSlot());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMLAdaptiveCalculator
+
+} // namespace nlsr::tests
@@ -0,0 +1,77 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/multipath-weights.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestMultipathWeights)
+
+BOOST_AUTO_TEST_CASE(UnknownCapacities)
+{
+  std::vector<double> routeCosts{10, 20};
+  auto weights = computeSplitWeights(routeCosts, {std::nullopt, std::nullopt});
+  BOOST_REQUIRE_EQUAL(weights.size(), 2);
+  BOOST_CHECK_CLOSE(weights[0], 2.0 / 3, 1e-6);
+  BOOST_CHECK_CLOSE(weights[1], 1.0 / 3, 1e-6);
+
+  auto costs = getWeightedCosts(routeCosts, weights);
+  BOOST_CHECK_EQUAL(costs[0], 10);
+  BOOST_CHECK_EQUAL(costs[1], 20);
+}
+
+BOOST_AUTO_TEST_CASE(SpareCapacity)
+{
+  std::vector<double> routeCosts{10, 10, 10};
+  auto weights = computeSplitWeights(routeCosts, {100.0, 50.0, std::nullopt});
+  BOOST_REQUIRE_EQUAL(weights.size(), 3);
+  BOOST_CHECK_CLOSE(weights[0] + weights[1] + weights[2], 1.0, 1e-6);
+  BOOST_CHECK_CLOSE(weights[0], 2 * weights[1], 1e-6);
+  // the unknown capacity is taken as the mean of the known ones
+  BOOST_CHECK_CLOSE(weights[2], 1.5 * weights[1], 1e-6);
+
+  auto costs = getWeightedCosts(routeCosts, weights);
+  BOOST_CHECK_EQUAL(costs[0], 10);
+  BOOST_CHECK_EQUAL(costs[1], 20);
+  BOOST_CHECK_EQUAL(costs[2], 13);
+}
+
+BOOST_AUTO_TEST_CASE(SaturatedLink)
+{
+  std::vector<double> routeCosts{10, 10};
+  auto weights = computeSplitWeights(routeCosts, {100.0, 0.0});
+  BOOST_CHECK_CLOSE(weights[1], weights[0] * MIN_RELATIVE_WEIGHT, 1e-6);
+
+  auto costs = getWeightedCosts(routeCosts, weights);
+  BOOST_CHECK_EQUAL(costs[0], 10);
+  BOOST_CHECK_EQUAL(costs[1], 1000);
+
+  // without any spare capacity, the split is by route cost
+  weights = computeSplitWeights(routeCosts, {0.0, 0.0});
+  BOOST_CHECK_CLOSE(weights[0], 0.5, 1e-6);
+  BOOST_CHECK_CLOSE(weights[1], 0.5, 1e-6);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestMultipathWeights
+
+} // namespace nlsr::tests
@@ -39,33 +39,70 @@ BOOST_AUTO_TEST_CASE(AddRoutingTableEntry)
 {
   NamePrefixTableEntry npte1("/ndn/memphis/rtr1");
   RoutingTablePoolEntry rtpe1("/ndn/memphis/rtr2", 0);
-  auto rtpePtr = std::make_shared<RoutingTablePoolEntry>(rtpe1);
 
   BOOST_CHECK_EQUAL(npte1.m_rteList.size(), 0);
-  npte1.addRoutingTableEntry(rtpePtr);
+  npte1.addRoutingTableEntry(rtpe1);
   BOOST_CHECK_EQUAL(npte1.m_rteList.size(), 1);
 
-  auto itr = std::find(npte1.m_rteList.begin(), npte1.m_rteList.end(), rtpePtr);
-  BOOST_CHECK_EQUAL(rtpePtr, *itr);
+  auto itr = std::find(npte1.m_rteList.begin(), npte1.m_rteList.end(), &rtpe1);
+  BOOST_CHECK(itr != npte1.m_rteList.end());
+  BOOST_CHECK_EQUAL(rtpe1.getUseCount(), 1);
+  BOOST_CHECK_EQUAL(rtpe1.namePrefixTableEntries.count(&npte1), 1);
+
+  // adding it again changes nothing
+  npte1.addRoutingTableEntry(rtpe1);
+  BOOST_CHECK_EQUAL(npte1.m_rteList.size(), 1);
+  BOOST_CHECK_EQUAL(rtpe1.getUseCount(), 1);
 }
 
 BOOST_AUTO_TEST_CASE(RemoveRoutingTableEntry)
 {
   NamePrefixTableEntry npte1("/ndn/memphis/rtr1");
   RoutingTablePoolEntry rtpe1("/ndn/memphis/rtr2", 0);
-  auto rtpePtr = std::make_shared<RoutingTablePoolEntry>(rtpe1);
 
-  npte1.addRoutingTableEntry(rtpePtr);
-  npte1.removeRoutingTableEntry(rtpePtr);
+  npte1.addRoutingTableEntry(rtpe1);
+  BOOST_CHECK_EQUAL(npte1.removeRoutingTableEntry(rtpe1), 0);
 
   int count = 0;
-  for (auto&& rte : npte1.m_rteList) {
+  for (auto* rte : npte1.m_rteList) {
     if (*rte == rtpe1) {
       count++;
     }
   }
 
   BOOST_CHECK_EQUAL(count, 0);
+  BOOST_CHECK(rtpe1.namePrefixTableEntries.empty());
+}
+
+BOOST_AUTO_TEST_CASE(GenerateNhlReportsChange)
+{
+  NamePrefixTableEntry npte("/ndn/memphis/prefix");
+  RoutingTablePoolEntry rtpe1("/ndn/memphis/rtr1", 0);
+  RoutingTablePoolEntry rtpe2("/ndn/memphis/rtr2", 0);
+  ndn::FaceUri faceUri1("udp4://10.0.0.1:6363");
+  ndn::FaceUri faceUri2("udp4://10.0.0.2:6363");
+
+  NexthopList nhl1;
+  nhl1.addNextHop(NextHop(faceUri1, 10));
+  nhl1.addNextHop(NextHop(faceUri2, 20));
+  rtpe1.setNexthopList(nhl1);
+  npte.addRoutingTableEntry(rtpe1);
+  BOOST_CHECK(npte.generateNhlfromRteList());
+  BOOST_CHECK_EQUAL(npte.getNexthopList(), nhl1);
+  BOOST_CHECK(!npte.generateNhlfromRteList());
+
+  // a farther destination on the same faces does not change the next hops
+  NexthopList nhl2;
+  nhl2.addNextHop(NextHop(faceUri1, 30));
+  rtpe2.setNexthopList(nhl2);
+  npte.addRoutingTableEntry(rtpe2);
+  BOOST_CHECK(!npte.generateNhlfromRteList());
+
+  nhl2.addNextHop(NextHop(faceUri2, 15));
+  rtpe2.setNexthopList(nhl2);
+  BOOST_CHECK(npte.generateNhlfromRteList());
+  BOOST_REQUIRE_EQUAL(npte.getNexthopList().size(), 2);
+  BOOST_CHECK_EQUAL(npte.getNexthopList().getNextHops().back().getRouteCost(), 15);
 }
 
 BOOST_AUTO_TEST_CASE(EqualsOperatorTwoObj)
@@ -37,7 +37,7 @@ public:
     : lsdb(face, m_keyChain, conf)
     , fib(face, m_scheduler, conf.getAdjacencyList(), conf, m_keyChain)
     , rt(m_scheduler, lsdb, conf)
-    , npt(conf.getRouterPrefix(), fib, rt, rt.afterRoutingChange, lsdb.onLsdbModified)
+    , npt(conf.getRouterPrefix(), fib, rt, rt.afterRoutingDelta, lsdb.onLsdbModified)
   {
   }
 
@@ -45,7 +45,7 @@ public:
   isNameInNpt(const ndn::Name& name)
   {
     auto it = std::find_if(npt.begin(), npt.end(),
-                           [&] (const auto& entry) { return name == entry->getNamePrefix(); });
+                           [&] (const auto& entry) { return name == entry.getNamePrefix(); });
     return it != npt.end();
   }
 
@@ -67,7 +67,7 @@ BOOST_AUTO_TEST_SUITE(TestNamePrefixTable)
 
 BOOST_FIXTURE_TEST_CASE(Bupt, NamePrefixTableFixture)
 {
-  rt.m_routingCalcInterval = 0_s;
+  conf.setRoutingCalcInterval(0);
 
   Adjacent thisRouter(conf.getRouterPrefix(), ndn::FaceUri("udp4://10.0.0.1"), 0, Adjacent::STATUS_ACTIVE, 0, 0);
 
@@ -112,14 +112,14 @@ BOOST_FIXTURE_TEST_CASE(Bupt, NamePrefixTableFixture)
 
   // Each NPT entry should have a destination router
   it = npt.begin();
-  BOOST_REQUIRE_EQUAL((*it)->getNamePrefix(), buptRouterName);
-  BOOST_REQUIRE_EQUAL((*it)->getRteList().size(), 1);
-  BOOST_CHECK_EQUAL((*(*it)->getRteList().begin())->getDestination(), buptRouterName);
+  BOOST_REQUIRE_EQUAL(it->getNamePrefix(), buptRouterName);
+  BOOST_REQUIRE_EQUAL(it->getRteList().size(), 1);
+  BOOST_CHECK_EQUAL(it->getRteList().front()->getDestination(), buptRouterName);
 
   ++it;
-  BOOST_REQUIRE_EQUAL((*it)->getNamePrefix(), buptAdvertisedName);
-  BOOST_REQUIRE_EQUAL((*it)->getRteList().size(), 1);
-  BOOST_CHECK_EQUAL((*(*it)->getRteList().begin())->getDestination(), buptRouterName);
+  BOOST_REQUIRE_EQUAL(it->getNamePrefix(), buptAdvertisedName);
+  BOOST_REQUIRE_EQUAL(it->getRteList().size(), 1);
+  BOOST_CHECK_EQUAL(it->getRteList().front()->getDestination(), buptRouterName);
 }
 
 BOOST_FIXTURE_TEST_CASE(AddEntryToPool, NamePrefixTableFixture)
@@ -129,17 +129,17 @@ BOOST_FIXTURE_TEST_CASE(AddEntryToPool, NamePrefixTableFixture)
   npt.addRtpeToPool(rtpe1);
 
   BOOST_CHECK_EQUAL(npt.m_rtpool.size(), 1);
-  BOOST_CHECK_EQUAL(*(npt.m_rtpool.find("router1")->second), rtpe1);
+  BOOST_CHECK_EQUAL(npt.m_rtpool.find("router1")->second, rtpe1);
 }
 
 BOOST_FIXTURE_TEST_CASE(RemoveEntryFromPool, NamePrefixTableFixture)
 {
   RoutingTablePoolEntry rtpe1("router1", 0);
-  std::shared_ptr<RoutingTablePoolEntry> rtpePtr = npt.addRtpeToPool(rtpe1);
+  RoutingTablePoolEntry& pooled = npt.addRtpeToPool(rtpe1);
 
-  npt.addRtpeToPool(rtpe1);
+  BOOST_CHECK_EQUAL(&npt.addRtpeToPool(rtpe1), &pooled);
 
-  npt.deleteRtpeFromPool(rtpePtr);
+  npt.deleteRtpeFromPool(pooled);
 
   BOOST_CHECK_EQUAL(npt.m_rtpool.size(), 0);
   BOOST_CHECK_EQUAL(npt.m_rtpool.count("router1"), 0);
@@ -148,7 +148,7 @@ BOOST_FIXTURE_TEST_CASE(RemoveEntryFromPool, NamePrefixTableFixture)
 BOOST_FIXTURE_TEST_CASE(AddRoutingEntryToNptEntry, NamePrefixTableFixture)
 {
   RoutingTablePoolEntry rtpe1("/ndn/memphis/rtr1", 0);
-  std::shared_ptr<RoutingTablePoolEntry> rtpePtr = npt.addRtpeToPool(rtpe1);
+  RoutingTablePoolEntry& pooled = npt.addRtpeToPool(rtpe1);
   NamePrefixTableEntry npte1("/ndn/memphis/rtr2");
 
   npt.addEntry("/ndn/memphis/rtr2", "/ndn/memphis/rtr1");
@@ -156,12 +156,13 @@ BOOST_FIXTURE_TEST_CASE(AddRoutingEntryToNptEntry, NamePrefixTableFixture)
   auto nItr = std::find_if(npt.m_table.begin(),
                            npt.m_table.end(),
                            [&] (const auto& entry) {
-                             return entry->getNamePrefix() == npte1.getNamePrefix();
+                             return entry.getNamePrefix() == npte1.getNamePrefix();
                            });
 
-  std::list<std::shared_ptr<RoutingTablePoolEntry>> rtpeList = (*nItr)->getRteList();
-  auto rItr = std::find(rtpeList.begin(), rtpeList.end(), rtpePtr);
-  BOOST_CHECK_EQUAL(**rItr, *rtpePtr);
+  const auto& rtpeList = nItr->getRteList();
+  auto rItr = std::find(rtpeList.begin(), rtpeList.end(), &pooled);
+  BOOST_REQUIRE(rItr != rtpeList.end());
+  BOOST_CHECK_EQUAL(pooled.getUseCount(), 1);
 }
 
 BOOST_FIXTURE_TEST_CASE(RemoveRoutingEntryFromNptEntry, NamePrefixTableFixture)
@@ -169,7 +170,6 @@ BOOST_FIXTURE_TEST_CASE(RemoveRoutingEntryFromNptEntry, NamePrefixTableFixture)
   RoutingTablePoolEntry rtpe1("/ndn/memphis/rtr1", 0);
 
   NamePrefixTableEntry npte1("/ndn/memphis/rtr2");
-  npt.m_table.push_back(std::make_shared<NamePrefixTableEntry>(npte1));
 
   npt.addEntry("/ndn/memphis/rtr2", "/ndn/memphis/rtr1");
   npt.addEntry("/ndn/memphis/rtr2", "/ndn/memphis/altrtr");
@@ -179,10 +179,10 @@ BOOST_FIXTURE_TEST_CASE(RemoveRoutingEntryFromNptEntry, NamePrefixTableFixture)
   auto nItr = std::find_if(npt.m_table.begin(),
                            npt.m_table.end(),
                            [&] (const auto& entry) {
-                             return entry->getNamePrefix() == npte1.getNamePrefix();
+                             return entry.getNamePrefix() == npte1.getNamePrefix();
                            });
 
-  std::list<std::shared_ptr<RoutingTablePoolEntry>> rtpeList = (*nItr)->getRteList();
+  const auto& rtpeList = nItr->getRteList();
 
   BOOST_CHECK_EQUAL(rtpeList.size(), 1);
   BOOST_CHECK_EQUAL(npt.m_rtpool.size(), 1);
@@ -191,26 +191,24 @@ BOOST_FIXTURE_TEST_CASE(RemoveRoutingEntryFromNptEntry, NamePrefixTableFixture)
 BOOST_FIXTURE_TEST_CASE(AddNptEntryPtrToRoutingEntry, NamePrefixTableFixture)
 {
   NamePrefixTableEntry npte1("/ndn/memphis/rtr2");
-  npt.m_table.push_back(std::make_shared<NamePrefixTableEntry>(npte1));
 
   npt.addEntry("/ndn/memphis/rtr2", "/ndn/memphis/rtr1");
 
   auto nItr = std::find_if(npt.m_table.begin(),
                            npt.m_table.end(),
                            [&] (const auto& entry) {
-                             return entry->getNamePrefix() == npte1.getNamePrefix();
+                             return entry.getNamePrefix() == npte1.getNamePrefix();
                            });
 
-  std::list<std::shared_ptr<RoutingTablePoolEntry>> rtpeList = (*nItr)->getRteList();
+  const auto& rtpeList = nItr->getRteList();
 
   BOOST_CHECK_EQUAL(rtpeList.size(), 1);
 
   auto& namePrefixPtrs = rtpeList.front()->namePrefixTableEntries;
 
-  auto nptIterator = namePrefixPtrs.find(npte1.getNamePrefix());
-  BOOST_REQUIRE(nptIterator != namePrefixPtrs.end());
-  auto nptSharedPtr = nptIterator->second.lock();
-  BOOST_CHECK_EQUAL(*nptSharedPtr, npte1);
+  BOOST_REQUIRE_EQUAL(namePrefixPtrs.size(), 1);
+  BOOST_CHECK_EQUAL(namePrefixPtrs.count(&*nItr), 1);
+  BOOST_CHECK_EQUAL(**namePrefixPtrs.begin(), npte1);
 }
 
 BOOST_FIXTURE_TEST_CASE(RemoveNptEntryPtrFromRoutingEntry, NamePrefixTableFixture)
@@ -218,8 +216,6 @@ BOOST_FIXTURE_TEST_CASE(RemoveNptEntryPtrFromRoutingEntry, NamePrefixTableFixtur
   NamePrefixTableEntry npte1("/ndn/memphis/rtr1");
   NamePrefixTableEntry npte2("/ndn/memphis/rtr2");
   RoutingTableEntry rte1("/ndn/memphis/destination1");
-  npt.m_table.push_back(std::make_shared<NamePrefixTableEntry>(npte1));
-  npt.m_table.push_back(std::make_shared<NamePrefixTableEntry>(npte2));
 
   npt.addEntry(npte1.getNamePrefix(), rte1.getDestination());
   // We have to add two entries, otherwise the routing pool entry will be deleted.
@@ -229,10 +225,10 @@ BOOST_FIXTURE_TEST_CASE(RemoveNptEntryPtrFromRoutingEntry, NamePrefixTableFixtur
   auto nItr = std::find_if(npt.m_table.begin(),
                            npt.m_table.end(),
                            [&] (const auto& entry) {
-                             return entry->getNamePrefix() == npte1.getNamePrefix();
+                             return entry.getNamePrefix() == npte1.getNamePrefix();
                            });
 
-  std::list<std::shared_ptr<RoutingTablePoolEntry>> rtpeList = (*nItr)->getRteList();
+  const auto& rtpeList = nItr->getRteList();
 
   BOOST_CHECK_EQUAL(rtpeList.size(), 1);
 
@@ -241,11 +237,8 @@ BOOST_FIXTURE_TEST_CASE(RemoveNptEntryPtrFromRoutingEntry, NamePrefixTableFixtur
   // We should have removed the second one
   BOOST_CHECK_EQUAL(namePrefixPtrs.size(), 1);
 
-  auto nptIterator = namePrefixPtrs.find(npte1.getNamePrefix());
-
-  BOOST_REQUIRE(nptIterator != namePrefixPtrs.end());
-  auto nptSharedPtr = nptIterator->second.lock();
-  BOOST_CHECK_EQUAL(*nptSharedPtr, npte1);
+  BOOST_REQUIRE_EQUAL(namePrefixPtrs.count(&*nItr), 1);
+  BOOST_CHECK_EQUAL(**namePrefixPtrs.begin(), npte1);
 }
 
 BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
@@ -264,14 +257,14 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
 
   // At this point the NamePrefixTableEntry should have two NextHops.
   auto nameIterator = std::find_if(npt.begin(), npt.end(),
-                                   [&] (const std::shared_ptr<NamePrefixTableEntry>& entry) {
-                                     return entry1.getNamePrefix() == entry->getNamePrefix();
+                                   [&] (const NamePrefixTableEntry& entry) {
+                                     return entry1.getNamePrefix() == entry.getNamePrefix();
                                    });
   BOOST_REQUIRE(nameIterator != npt.end());
 
   auto iterator = npt.m_rtpool.find(destination);
   BOOST_REQUIRE(iterator != npt.m_rtpool.end());
-  auto nextHops = (iterator->second)->getNexthopList();
+  auto nextHops = iterator->second.getNexthopList();
   BOOST_CHECK_EQUAL(nextHops.size(), 2);
 
   // Add the other NextHop
@@ -280,16 +273,71 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
 
   // At this point the NamePrefixTableEntry should have three NextHops.
   nameIterator = std::find_if(npt.begin(), npt.end(),
-                              [&] (const std::shared_ptr<NamePrefixTableEntry>& entry) {
-                                return entry1.getNamePrefix() == entry->getNamePrefix();
+                              [&] (const NamePrefixTableEntry& entry) {
+                                return entry1.getNamePrefix() == entry.getNamePrefix();
                               });
   BOOST_REQUIRE(nameIterator != npt.end());
   iterator = npt.m_rtpool.find(destination);
   BOOST_REQUIRE(iterator != npt.m_rtpool.end());
-  nextHops = (iterator->second)->getNexthopList();
+  nextHops = iterator->second.getNexthopList();
   BOOST_CHECK_EQUAL(nextHops.size(), 3);
 }
 
+BOOST_FIXTURE_TEST_CASE(NameIndex, NamePrefixTableFixture)
+{
+  for (int i = 0; i < 10; ++i) {
+    npt.addEntry(ndn::Name("/prefix").appendNumber(i), "/ndn/router1");
+    npt.addEntry(ndn::Name("/prefix").appendNumber(i), "/ndn/router2");
+  }
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 10);
+  BOOST_CHECK_EQUAL(npt.m_nameIndex.size(), 10);
+
+  npt.removeEntry(ndn::Name("/prefix").appendNumber(3), "/ndn/router1");
+  npt.removeEntry(ndn::Name("/prefix").appendNumber(3), "/ndn/router2");
+  BOOST_CHECK(!isNameInNpt(ndn::Name("/prefix").appendNumber(3)));
+  BOOST_CHECK_EQUAL(npt.m_nameIndex.count(ndn::Name("/prefix").appendNumber(3)), 0);
+
+  // the remaining entries stay in insertion order
+  std::vector<ndn::Name> names;
+  for (const auto& entry : npt) {
+    names.push_back(entry.getNamePrefix());
+  }
+  BOOST_REQUIRE_EQUAL(names.size(), 9);
+  BOOST_CHECK_EQUAL(names[2], ndn::Name("/prefix").appendNumber(2));
+  BOOST_CHECK_EQUAL(names[3], ndn::Name("/prefix").appendNumber(4));
+
+  for (const auto& [name, it] : npt.m_nameIndex) {
+    BOOST_CHECK_EQUAL(it->getNamePrefix(), name);
+  }
+}
+
+BOOST_FIXTURE_TEST_CASE(AddEntries, NamePrefixTableFixture)
+{
+  const ndn::Name router1("/ndn/router1");
+  std::vector<PrefixInfo> prefixes;
+  for (int i = 0; i < 20; ++i) {
+    prefixes.emplace_back(ndn::Name("/prefix").appendNumber(i), i);
+  }
+  prefixes.emplace_back(conf.getRouterPrefix(), 0);
+  npt.addEntry(ndn::Name("/prefix").appendNumber(0), "/ndn/router2");
+
+  npt.addEntries(prefixes, router1);
+
+  // the own router prefix is skipped
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 20);
+  BOOST_CHECK(!isNameInNpt(conf.getRouterPrefix()));
+
+  // all prefixes share a single pool entry
+  BOOST_REQUIRE_EQUAL(npt.m_rtpool.size(), 2);
+  const auto& rtpe = npt.m_rtpool.at(router1);
+  BOOST_CHECK_EQUAL(rtpe.getUseCount(), 20);
+  BOOST_CHECK_EQUAL(rtpe.namePrefixTableEntries.size(), 20);
+  BOOST_CHECK_EQUAL(npt.m_table.front().getRteList().size(), 2);
+
+  NamePrefixTable::DestNameKey key(router1, ndn::Name("/prefix").appendNumber(7));
+  BOOST_CHECK_EQUAL(npt.m_nexthopCost.at(key), 7);
+}
+
 BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, NamePrefixTableFixture)
 {
   auto testTimePoint = time::system_clock::now();
@@ -352,6 +400,66 @@ BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, NamePrefixTableFixture)
   BOOST_CHECK_EQUAL(npt.m_table.size(), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(AdvertisedPrefixCost, NamePrefixTableFixture)
+{
+  ndn::Name router1("/router1/1");
+  NamePrefixList npl;
+  npl.insert(PrefixInfo("/name1", 5));
+  npl.insert(PrefixInfo("/name2", 0));
+  auto lsa = std::make_shared<NameLsa>(router1, 12, time::system_clock::now(), npl);
+  npt.updateFromLsdb(lsa, LsdbUpdate::INSTALLED, {}, {});
+  BOOST_CHECK_EQUAL(npt.m_nexthopCost.size(), 2);
+
+  NexthopList hops;
+  hops.addNextHop(NextHop(ndn::FaceUri("udp4://10.0.0.1:6363"), 10));
+  BOOST_CHECK_EQUAL(npt.adjustNexthopCosts(hops, "/name1", router1).begin()->getRouteCost(), 15);
+  BOOST_CHECK_EQUAL(npt.adjustNexthopCosts(hops, "/name2", router1).begin()->getRouteCost(), 10);
+
+  // a miss does not add a cost
+  BOOST_CHECK_EQUAL(npt.adjustNexthopCosts(hops, "/name3", router1).begin()->getRouteCost(), 10);
+  BOOST_CHECK_EQUAL(npt.m_nexthopCost.size(), 2);
+
+  npt.updateFromLsdb(lsa, LsdbUpdate::REMOVED, {}, {});
+  BOOST_CHECK(npt.m_nexthopCost.empty());
+}
+
+BOOST_FIXTURE_TEST_CASE(AreaSummaries, NamePrefixTableFixture)
+{
+  npt.setAreas({"/ndn/site1"});
+
+  ndn::Name abr("/ndn/site1/%C1.Router/abr");
+  NamePrefixList npl;
+  npl.insert(PrefixInfo("/ndn/site1/abr", 0));
+  auto lsa = std::make_shared<NameLsa>(abr, 12, time::system_clock::now(), npl);
+  lsa->setAreaSummaries({
+    {"/ndn/site1", {PrefixInfo("/ndn/site2/%C1.Router/r2", 10), PrefixInfo("/ndn/site2/r2", 12),
+                    PrefixInfo("/ndn/site1/abr", 3), PrefixInfo(conf.getRouterPrefix(), 4)}},
+    {"/ndn/site2", {PrefixInfo("/ndn/site3/r3", 20)}},
+  });
+  npt.updateFromLsdb(lsa, LsdbUpdate::INSTALLED, {}, {});
+
+  // summaries into other areas, our own router name, and the prefixes advertised by the
+  // border router itself are ignored
+  BOOST_CHECK(isNameInNpt("/ndn/site2/%C1.Router/r2"));
+  BOOST_CHECK(isNameInNpt("/ndn/site2/r2"));
+  BOOST_CHECK(!isNameInNpt("/ndn/site3/r3"));
+  BOOST_CHECK(!isNameInNpt(conf.getRouterPrefix()));
+  BOOST_CHECK_EQUAL(npt.m_nexthopCost.at({abr, "/ndn/site2/r2"}), 12);
+  BOOST_CHECK_EQUAL(npt.m_nexthopCost.at({abr, "/ndn/site1/abr"}), 0);
+
+  // a changed cost is updated, and a prefix no longer summarized is removed
+  lsa->setAreaSummaries({{"/ndn/site1", {PrefixInfo("/ndn/site2/%C1.Router/r2", 15)}}});
+  npt.updateFromLsdb(lsa, LsdbUpdate::UPDATED, {}, {});
+  BOOST_CHECK(isNameInNpt("/ndn/site2/%C1.Router/r2"));
+  BOOST_CHECK(!isNameInNpt("/ndn/site2/r2"));
+  BOOST_CHECK_EQUAL(npt.m_nexthopCost.at({abr, "/ndn/site2/%C1.Router/r2"}), 15);
+
+  npt.updateFromLsdb(lsa, LsdbUpdate::REMOVED, {}, {});
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 0);
+  BOOST_CHECK(npt.m_summarizedPrefixes.empty());
+  BOOST_CHECK(npt.m_nexthopCost.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
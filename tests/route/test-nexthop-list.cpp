@@ -142,6 +142,28 @@ BOOST_AUTO_TEST_CASE(SortOnAddAndRemove)
   }
 }
 
+BOOST_AUTO_TEST_CASE(SortBeyondInlineCapacity)
+{
+  NexthopList list;
+  NextHopsUriSortedSet uriSorted;
+  for (int i = 9; i >= 1; --i) {
+    NextHop hop(ndn::FaceUri("udp4://192.168.3." + std::to_string(i) + ":6363"), 10 * (i % 3));
+    list.addNextHop(hop);
+    uriSorted.addNextHop(hop);
+  }
+  BOOST_REQUIRE_EQUAL(list.size(), 9);
+  BOOST_REQUIRE_EQUAL(uriSorted.size(), 9);
+
+  BOOST_CHECK(std::is_sorted(list.begin(), list.end()));
+  BOOST_CHECK(std::is_sorted(uriSorted.begin(), uriSorted.end(), NextHopUriSortedComparator()));
+
+  // a cheaper next hop through the same face replaces the other one
+  list.addNextHop(NextHop(ndn::FaceUri("udp4://192.168.3.5:6363"), 0));
+  BOOST_CHECK_EQUAL(list.size(), 9);
+  BOOST_CHECK(std::is_sorted(list.begin(), list.end()));
+  BOOST_CHECK_EQUAL(list.begin()->getRouteCost(), 0);
+}
+
 /* If there are two NextHops going to the same neighbor, then the list
    should always select the one with the cheaper cost. This would be
    caused by a Name being advertised by two different routers, which
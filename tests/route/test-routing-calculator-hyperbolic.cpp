@@ -178,6 +178,27 @@ BOOST_AUTO_TEST_CASE(BasicMultipleAngles)
   runTest(30.655296361);
 }
 
+BOOST_AUTO_TEST_CASE(DistanceCache)
+{
+  setUpTopology({2.97}, {3.0}, {2.99});
+
+  HyperbolicDistanceCache cache;
+  auto expected = calculateHyperbolicRoutes(map, lsdb, adjacencies, ROUTER_A_NAME);
+  BOOST_CHECK(calculateHyperbolicRoutes(map, lsdb, adjacencies, ROUTER_A_NAME, &cache) == expected);
+  // Served from the cache
+  BOOST_CHECK(calculateHyperbolicRoutes(map, lsdb, adjacencies, ROUTER_A_NAME, &cache) == expected);
+
+  CoordinateLsa coordC(ROUTER_C_NAME, 2, MAX_TIME, 14.11, {1.5});
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(coordC));
+  auto updated = calculateHyperbolicRoutes(map, lsdb, adjacencies, ROUTER_A_NAME);
+  BOOST_CHECK(updated != expected);
+
+  // Stale until the router is invalidated
+  BOOST_CHECK(calculateHyperbolicRoutes(map, lsdb, adjacencies, ROUTER_A_NAME, &cache) == expected);
+  cache.invalidate(ROUTER_C_NAME);
+  BOOST_CHECK(calculateHyperbolicRoutes(map, lsdb, adjacencies, ROUTER_A_NAME, &cache) == updated);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -31,18 +31,23 @@
 #include "tests/io-key-chain-fixture.hpp"
 #include "tests/test-common.hpp"
 
+#include <thread>
+
 namespace nlsr::tests {
 
 constexpr time::system_clock::time_point MAX_TIME = time::system_clock::time_point::max();
 static const ndn::Name ROUTER_A_NAME = "/ndn/site/%C1.Router/this-router";
 static const ndn::Name ROUTER_B_NAME = "/ndn/site/%C1.Router/b";
 static const ndn::Name ROUTER_C_NAME = "/ndn/site/%C1.Router/c";
+static const ndn::Name ROUTER_D_NAME = "/ndn/site/%C1.Router/d";
 static const ndn::FaceUri ROUTER_A_FACE("udp4://10.0.0.1:6363");
 static const ndn::FaceUri ROUTER_B_FACE("udp4://10.0.0.2:6363");
 static const ndn::FaceUri ROUTER_C_FACE("udp4://10.0.0.3:6363");
+static const ndn::FaceUri ROUTER_D_FACE("udp4://10.0.0.4:6363");
 constexpr double LINK_AB_COST = 5.0;
 constexpr double LINK_AC_COST = 10.0;
 constexpr double LINK_BC_COST = 17.0;
+constexpr double LINK_BD_COST = 3.0;
 
 /**
  * @brief Provide a topology for link-state routing calculator testing.
@@ -121,6 +126,28 @@ public:
     lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_C_NAME, 1, MAX_TIME, adjList));
   }
 
+  /**
+   * @brief Replace Adjacency LSA of router B with one that also lists router D, which is only
+   *        connected to B, and insert Adjacency LSA of router D into LSDB.
+   */
+  void
+  setupStubRouterD()
+  {
+    AdjacencyList adjListB;
+    adjListB.insert(Adjacent(ROUTER_A_NAME, ROUTER_A_FACE, LINK_AB_COST, Adjacent::STATUS_ACTIVE,
+                             0, 0));
+    adjListB.insert(Adjacent(ROUTER_C_NAME, ROUTER_C_FACE, LINK_BC_COST, Adjacent::STATUS_ACTIVE,
+                             0, 0));
+    adjListB.insert(Adjacent(ROUTER_D_NAME, ROUTER_D_FACE, LINK_BD_COST, Adjacent::STATUS_ACTIVE,
+                             0, 0));
+    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_B_NAME, 2, MAX_TIME, adjListB));
+
+    AdjacencyList adjListD;
+    adjListD.insert(Adjacent(ROUTER_B_NAME, ROUTER_B_FACE, LINK_BD_COST, Adjacent::STATUS_ACTIVE,
+                             0, 0));
+    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_D_NAME, 1, MAX_TIME, adjListD));
+  }
+
   /**
    * @brief Run link-state routing calculator.
    */
@@ -189,6 +216,55 @@ BOOST_AUTO_TEST_CASE(Basic)
   });
 }
 
+BOOST_AUTO_TEST_CASE(Threads)
+{
+  setupRouterA();
+  setupRouterB();
+  setupRouterC();
+
+  // Per-neighbor paths are computed on several threads; the result must be the same.
+  conf.setRoutingCalcThreads(4);
+  calculatePath();
+
+  checkRoutingTableEntry(ROUTER_B_NAME, {
+    {ROUTER_B_FACE, LINK_AB_COST},
+    {ROUTER_C_FACE, LINK_AC_COST + LINK_BC_COST},
+  });
+
+  checkRoutingTableEntry(ROUTER_C_NAME, {
+    {ROUTER_C_FACE, LINK_AC_COST},
+    {ROUTER_B_FACE, LINK_AB_COST + LINK_BC_COST},
+  });
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  setupRouterA();
+  setupRouterB();
+  setupRouterC();
+
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  NameMap map = NameMap::createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  auto input = makeLinkStateInput(map, conf, lsdb);
+
+  // The snapshot is self-contained, so it can be calculated on another thread.
+  LinkStateRoutes routes;
+  std::thread worker([&] { routes = calculateLinkStateRoutes(std::move(input)); });
+  worker.join();
+  BOOST_CHECK_EQUAL(routes.nextHops.size(), 4);
+  BOOST_CHECK(routes.alternates.empty());
+
+  routingTable.addLinkStateRoutes(routes);
+  checkRoutingTableEntry(ROUTER_B_NAME, {
+    {ROUTER_B_FACE, LINK_AB_COST},
+    {ROUTER_C_FACE, LINK_AC_COST + LINK_BC_COST},
+  });
+  checkRoutingTableEntry(ROUTER_C_NAME, {
+    {ROUTER_C_FACE, LINK_AC_COST},
+    {ROUTER_B_FACE, LINK_AB_COST + LINK_BC_COST},
+  });
+}
+
 BOOST_AUTO_TEST_CASE(Asymmetric)
 {
   // Asymmetric link cost between B and C
@@ -292,6 +368,112 @@ BOOST_AUTO_TEST_CASE(OnePath)
   });
 }
 
+BOOST_AUTO_TEST_CASE(LoopFreeAlternates)
+{
+  double costBC = 2.0;
+  setupRouterA();
+  setupRouterB(
+    costBC // B to C
+  );
+  setupRouterC(
+    LINK_AC_COST, // C to A
+    costBC // C to B
+  );
+
+  conf.setMaxFacesPerPrefix(1);
+  conf.setLoopFreeAlternates(true);
+  calculatePath();
+
+  // Alternates are not installed as routes.
+  checkRoutingTableEntry(ROUTER_B_NAME, {
+    {ROUTER_B_FACE, LINK_AB_COST},
+  });
+  checkRoutingTableEntry(ROUTER_C_NAME, {
+    {ROUTER_B_FACE, LINK_AB_COST + costBC},
+  });
+
+  // When B goes down, both destinations switch to their alternate through C.
+  BOOST_CHECK_EQUAL(routingTable.repairRoutesThrough(ROUTER_B_NAME), 2);
+  checkRoutingTableEntry(ROUTER_B_NAME, {
+    {ROUTER_C_FACE, LINK_AC_COST + costBC},
+  });
+  checkRoutingTableEntry(ROUTER_C_NAME, {
+    {ROUTER_C_FACE, LINK_AC_COST},
+  });
+
+  // There is nothing left to repair when C goes down as well.
+  BOOST_CHECK_EQUAL(routingTable.repairRoutesThrough(ROUTER_C_NAME), 0);
+}
+
+BOOST_AUTO_TEST_CASE(NoLoopFreeAlternate)
+{
+  setupRouterA();
+  setupRouterB();
+  setupRouterC();
+
+  // C reaches B directly at 17, more than through A (10 + 5): C would send traffic back.
+  conf.setMaxFacesPerPrefix(1);
+  conf.setLoopFreeAlternates(true);
+  calculatePath();
+
+  BOOST_CHECK_EQUAL(routingTable.repairRoutesThrough(ROUTER_B_NAME), 0);
+  checkRoutingTableEntry(ROUTER_B_NAME, {
+    {ROUTER_B_FACE, LINK_AB_COST},
+  });
+}
+
+BOOST_AUTO_TEST_CASE(DisjointLinks)
+{
+  setupRouterA();
+  setupRouterB();
+  setupRouterC();
+  setupStubRouterD();
+
+  conf.setDisjointPaths(DisjointPaths::LINK);
+  conf.setLoopFreeAlternates(true);
+  calculatePath();
+
+  // The paths to B and C through either neighbor share no link.
+  checkRoutingTableEntry(ROUTER_B_NAME, {
+    {ROUTER_B_FACE, LINK_AB_COST},
+    {ROUTER_C_FACE, LINK_AC_COST + LINK_BC_COST},
+  });
+  checkRoutingTableEntry(ROUTER_C_NAME, {
+    {ROUTER_C_FACE, LINK_AC_COST},
+    {ROUTER_B_FACE, LINK_AB_COST + LINK_BC_COST},
+  });
+  // The path to D through C shares link B-D with the cheaper one through B.
+  checkRoutingTableEntry(ROUTER_D_NAME, {
+    {ROUTER_B_FACE, LINK_AB_COST + LINK_BD_COST},
+  });
+
+  // It is kept as an alternate.
+  BOOST_CHECK_EQUAL(routingTable.repairRoutesThrough(ROUTER_B_NAME), 3);
+  checkRoutingTableEntry(ROUTER_D_NAME, {
+    {ROUTER_C_FACE, LINK_AC_COST + LINK_BC_COST + LINK_BD_COST},
+  });
+}
+
+BOOST_AUTO_TEST_CASE(DisjointNodes)
+{
+  setupRouterA();
+  setupRouterB();
+  setupRouterC();
+  setupStubRouterD();
+
+  conf.setDisjointPaths(DisjointPaths::NODE);
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  NameMap map = NameMap::createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  auto routes = calculateLinkStateRoutes(makeLinkStateInput(map, conf, lsdb));
+
+  // Two next hops to each of B and C, one to D, which is only reached through B.
+  BOOST_CHECK_EQUAL(routes.nextHops.size(), 5);
+  BOOST_REQUIRE_EQUAL(routes.alternates.size(), 1);
+  BOOST_CHECK_EQUAL(routes.alternates.front().first, ROUTER_D_NAME);
+  BOOST_CHECK_EQUAL(routes.alternates.front().second,
+                    NextHop(ROUTER_C_FACE, LINK_AC_COST + LINK_BC_COST + LINK_BD_COST));
+}
+
 BOOST_AUTO_TEST_CASE(SourceRouterAbsent)
 {
   // RouterA does not exist in the LSDB.
@@ -0,0 +1,153 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/routing-change-feed.hpp"
+#include "route/nexthop.hpp"
+#include "nlsr.hpp"
+#include "tlv-nlsr.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/encoding/block-helpers.hpp>
+
+namespace nlsr::tests {
+
+class RoutingChangeFeedFixture : public IoKeyChainFixture
+{
+public:
+  /*! \brief Replaces the next hops of \p destination, or removes it without \p cost ,
+   *         and publishes the routing table.
+   */
+  void
+  setRoute(const ndn::Name& destination, std::optional<uint64_t> cost)
+  {
+    rt.m_rTable.remove_if([&] (const auto& entry) {
+      return entry.getDestination() == destination;
+    });
+    if (cost) {
+      NextHop hop(ndn::FaceUri("udp4://10.0.0.1:6363"), *cost);
+      rt.addNextHop(destination, hop);
+    }
+    rt.publishRoutingChange();
+  }
+
+private:
+  ndn::Scheduler m_scheduler{m_io};
+
+public:
+  ndn::DummyClientFace face{m_io, m_keyChain, {true, true}};
+  ConfParameter conf{face, m_keyChain};
+  DummyConfFileProcessor confProcessor{conf};
+
+  Lsdb lsdb{face, m_keyChain, conf};
+  RoutingTable rt{m_scheduler, lsdb, conf};
+  RoutingChangeFeed feed{rt, rt.afterRoutingDelta, 3};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestRoutingChangeFeed, RoutingChangeFeedFixture)
+
+BOOST_AUTO_TEST_CASE(MergeChanges)
+{
+  BOOST_CHECK_EQUAL(feed.getVersion(), 0);
+  setRoute("/a", 10);
+  setRoute("/b", 10);
+  BOOST_CHECK_EQUAL(feed.getVersion(), 2);
+
+  // /a changed then removed, /b changed, /c added then changed
+  setRoute("/a", 20);
+  setRoute("/a", std::nullopt);
+  setRoute("/b", 20);
+  // history of 3 destinations, back to version 2
+  BOOST_CHECK_EQUAL(feed.getVersion(), 5);
+  auto changes = feed.getChangesSince(2);
+  BOOST_CHECK_EQUAL(changes.version, 5);
+  BOOST_CHECK(!changes.isSnapshot);
+  BOOST_CHECK(changes.delta.added.empty());
+  BOOST_REQUIRE_EQUAL(changes.delta.changed.size(), 1);
+  BOOST_CHECK_EQUAL(changes.delta.changed.front().getDestination(), "/b");
+  BOOST_CHECK_EQUAL(changes.delta.changed.front().getNexthopList().begin()->getRouteCost(), 20);
+  BOOST_REQUIRE_EQUAL(changes.delta.removed.size(), 1);
+  BOOST_CHECK_EQUAL(changes.delta.removed.front(), "/a");
+
+  setRoute("/c", 10);
+  changes = feed.getChangesSince(4);
+  BOOST_CHECK(changes.delta.removed.empty());
+  BOOST_REQUIRE_EQUAL(changes.delta.changed.size(), 1);
+  BOOST_REQUIRE_EQUAL(changes.delta.added.size(), 1);
+  BOOST_CHECK_EQUAL(changes.delta.added.front().getDestination(), "/c");
+
+  // up to date
+  changes = feed.getChangesSince(6);
+  BOOST_CHECK_EQUAL(changes.version, 6);
+  BOOST_CHECK(!changes.isSnapshot);
+  BOOST_CHECK(changes.delta.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  setRoute("/a", 10);
+  setRoute("/b", 10);
+  setRoute("/c", 10);
+  setRoute("/d", 10);
+
+  // the first delta was dropped from the history
+  for (uint64_t version : {0, 7}) {
+    auto changes = feed.getChangesSince(version);
+    BOOST_CHECK_EQUAL(changes.version, 4);
+    BOOST_CHECK(changes.isSnapshot);
+    BOOST_CHECK_EQUAL(changes.delta.added.size(), 4);
+    BOOST_CHECK(changes.delta.changed.empty());
+    BOOST_CHECK(changes.delta.removed.empty());
+  }
+  BOOST_CHECK(!feed.getChangesSince(1).isSnapshot);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  setRoute("/a", 10);
+  setRoute("/b", 10);
+  setRoute("/a", std::nullopt);
+  setRoute("/b", 20);
+  setRoute("/c", 10);
+
+  auto changes = feed.getChangesSince(2);
+  RoutingTableChanges decoded(changes.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.version, 5);
+  BOOST_CHECK(!decoded.isSnapshot);
+  BOOST_REQUIRE_EQUAL(decoded.delta.added.size(), 1);
+  BOOST_CHECK_EQUAL(decoded.delta.added.front().getDestination(), "/c");
+  BOOST_REQUIRE_EQUAL(decoded.delta.changed.size(), 1);
+  BOOST_CHECK_EQUAL(decoded.delta.changed.front().getDestination(), "/b");
+  BOOST_REQUIRE_EQUAL(decoded.delta.removed.size(), 1);
+  BOOST_CHECK_EQUAL(decoded.delta.removed.front(), "/a");
+
+  RoutingTableChanges snapshot(feed.getSnapshot().wireEncode());
+  BOOST_CHECK(snapshot.isSnapshot);
+  BOOST_CHECK_EQUAL(snapshot.delta.added.size(), 2);
+
+  BOOST_CHECK_THROW(RoutingTableChanges(ndn::makeEmptyBlock(tlv::RoutingTableChanges)),
+                    RoutingTableChanges::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
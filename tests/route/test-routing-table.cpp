@@ -53,6 +53,96 @@ BOOST_FIXTURE_TEST_CASE(AddNextHop, RoutingTableFixture)
   BOOST_CHECK_EQUAL(rt.findRoutingTableEntry(DEST_ROUTER)->getDestination(), DEST_ROUTER);
 }
 
+BOOST_FIXTURE_TEST_CASE(AddNextHopOrder, RoutingTableFixture)
+{
+  NextHop hopA(ndn::FaceUri("udp4://10.0.0.1:6363"), 10);
+  NextHop hopB(ndn::FaceUri("udp4://10.0.0.2:6363"), 20);
+  rt.addNextHop("/dest2", hopA);
+  rt.addNextHop("/dest1", hopA);
+  rt.addNextHop("/dest2", hopB);
+
+  // Entries keep their insertion order, and next hops accumulate on the existing entry.
+  BOOST_REQUIRE_EQUAL(rt.m_rTable.size(), 2);
+  BOOST_CHECK_EQUAL(rt.m_rTable.front().getDestination(), "/dest2");
+  BOOST_CHECK_EQUAL(rt.m_rTable.back().getDestination(), "/dest1");
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry("/dest2")->getNexthopList().size(), 2);
+  BOOST_CHECK(rt.findRoutingTableEntry("/dest3") == nullptr);
+
+  rt.clearRoutingTable();
+  BOOST_CHECK(rt.findRoutingTableEntry("/dest1") == nullptr);
+  BOOST_CHECK(rt.findRoutingTableEntry("/dest2") == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(PublishDelta, RoutingTableFixture)
+{
+  std::vector<RoutingTableDelta> deltas;
+  rt.afterRoutingDelta.connect([&] (const RoutingTableDelta& delta) { deltas.push_back(delta); });
+
+  NextHop hopA(ndn::FaceUri("udp4://10.0.0.1:6363"), 10);
+  NextHop hopB(ndn::FaceUri("udp4://10.0.0.2:6363"), 20);
+  rt.addNextHop("/dest1", hopA);
+  rt.addNextHop("/dest2", hopA);
+  rt.publishRoutingChange();
+  BOOST_REQUIRE_EQUAL(deltas.size(), 1);
+  BOOST_CHECK_EQUAL(deltas.back().added.size(), 2);
+  BOOST_CHECK(deltas.back().changed.empty());
+  BOOST_CHECK(deltas.back().removed.empty());
+
+  // Republishing the same table emits nothing.
+  rt.publishRoutingChange();
+  BOOST_CHECK_EQUAL(deltas.size(), 1);
+
+  // dest1 changes, dest2 disappears, dest3 appears.
+  rt.clearRoutingTable();
+  rt.addNextHop("/dest1", hopB);
+  rt.addNextHop("/dest3", hopA);
+  rt.publishRoutingChange();
+  BOOST_REQUIRE_EQUAL(deltas.size(), 2);
+  const auto& delta = deltas.back();
+  BOOST_REQUIRE_EQUAL(delta.added.size(), 1);
+  BOOST_CHECK_EQUAL(delta.added.front().getDestination(), "/dest3");
+  BOOST_REQUIRE_EQUAL(delta.changed.size(), 1);
+  BOOST_CHECK_EQUAL(delta.changed.front().getDestination(), "/dest1");
+  BOOST_CHECK(delta.changed.front().getNexthopList() == rt.findRoutingTableEntry("/dest1")->getNexthopList());
+  BOOST_REQUIRE_EQUAL(delta.removed.size(), 1);
+  BOOST_CHECK_EQUAL(delta.removed.front(), "/dest2");
+}
+
+BOOST_FIXTURE_TEST_CASE(CalculationThrottle, RoutingTableFixture)
+{
+  // Without the throttle, every calculation waits routing-calc-interval.
+  BOOST_CHECK_EQUAL(rt.getRoutingCalcDelay(), 15_s);
+
+  conf.setRoutingCalcThrottle(true);
+  conf.setRoutingCalcInitialDelay(50);
+  conf.setRoutingCalcHoldTime(200);
+
+  // A lone change is handled quickly.
+  BOOST_CHECK_EQUAL(rt.getRoutingCalcDelay(), 50_ms);
+  rt.calculate();
+
+  // Later calculations wait for the rest of a hold time that doubles each time.
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(rt.getRoutingCalcDelay(), 190_ms);
+  rt.calculate();
+  BOOST_CHECK_EQUAL(rt.getRoutingCalcDelay(), 400_ms);
+  rt.calculate();
+  BOOST_CHECK_EQUAL(rt.getRoutingCalcDelay(), 800_ms);
+
+  // The hold time is bounded by routing-calc-interval.
+  for (int i = 0; i < 5; ++i) {
+    rt.calculate();
+    rt.getRoutingCalcDelay();
+  }
+  rt.calculate();
+  BOOST_CHECK_EQUAL(rt.getRoutingCalcDelay(), 15_s);
+
+  // After a quiet period, the back-off starts over.
+  rt.calculate();
+  advanceClocks(1_s, 30_s);
+  BOOST_CHECK_EQUAL(rt.getRoutingCalcDelay(), 50_ms);
+}
+
 const uint8_t RoutingTableData1[] = {
   // Header
   0x90, 0x30,
@@ -196,6 +286,83 @@ BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, RoutingTableFixture)
   BOOST_CHECK(!rt.m_wire.isValid());
 }
 
+BOOST_FIXTURE_TEST_CASE(CalculateWithoutNeighbor, RoutingTableFixture)
+{
+  ndn::Name routerB("/ndn/site/%C1.Router/b");
+  ndn::Name routerC("/ndn/site/%C1.Router/c");
+  auto& adjacencies = conf.getAdjacencyList();
+  adjacencies.insert(Adjacent(routerB, ndn::FaceUri("udp4://10.0.0.2:6363"), 10,
+                              Adjacent::STATUS_ACTIVE, 0, 0));
+  adjacencies.insert(Adjacent(routerC, ndn::FaceUri("udp4://10.0.0.3:6363"), 10,
+                              Adjacent::STATUS_ACTIVE, 0, 0));
+
+  auto expiration = time::system_clock::now() + 3600_s;
+  AdjacencyList adjB;
+  adjB.insert(Adjacent(conf.getRouterPrefix(), ndn::FaceUri("udp4://10.0.0.1:6363"), 10,
+                       Adjacent::STATUS_ACTIVE, 0, 0));
+  adjB.insert(Adjacent(routerC, ndn::FaceUri("udp4://10.0.0.3:6363"), 10,
+                       Adjacent::STATUS_ACTIVE, 0, 0));
+  lsdb.installLsa(std::make_shared<AdjLsa>(routerB, 1, expiration, adjB));
+  AdjacencyList adjC;
+  adjC.insert(Adjacent(conf.getRouterPrefix(), ndn::FaceUri("udp4://10.0.0.1:6363"), 10,
+                       Adjacent::STATUS_ACTIVE, 0, 0));
+  adjC.insert(Adjacent(routerB, ndn::FaceUri("udp4://10.0.0.2:6363"), 10,
+                       Adjacent::STATUS_ACTIVE, 0, 0));
+  lsdb.installLsa(std::make_shared<AdjLsa>(routerC, 1, expiration, adjC));
+  lsdb.buildAndInstallOwnAdjLsa();
+  advanceClocks(15_s);
+  BOOST_REQUIRE(rt.findRoutingTableEntry(routerB) != nullptr);
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry(routerB)->getNexthopList().size(), 2);
+
+  // the routes move off B at once, while the Adjacency LSA build is still pending
+  adjacencies.setStatusOfNeighbor(routerB, Adjacent::STATUS_INACTIVE);
+  adjacencies.setTimedOutInterestCount(routerB, HELLO_RETRIES_MAX);
+  lsdb.scheduleAdjLsaBuild();
+  rt.calculateWithoutNeighbor(routerB);
+  BOOST_CHECK(lsdb.getIsBuildAdjLsaScheduled());
+  BOOST_CHECK_EQUAL(rt.getFailedNeighbors().size(), 1);
+  BOOST_REQUIRE(rt.findRoutingTableEntry(routerB) != nullptr);
+  const auto& nexthops = rt.findRoutingTableEntry(routerB)->getNexthopList();
+  BOOST_REQUIRE_EQUAL(nexthops.size(), 1);
+  BOOST_CHECK_EQUAL(nexthops.begin()->getConnectingFaceUri().toString(), "udp4://10.0.0.3:6363");
+
+  // our new Adjacency LSA no longer lists B
+  advanceClocks(15_s);
+  BOOST_CHECK(rt.getFailedNeighbors().empty());
+  BOOST_CHECK_EQUAL(rt.findRoutingTableEntry(routerB)->getNexthopList().size(), 1);
+}
+
+BOOST_FIXTURE_TEST_CASE(CostModeChangeDuringAsyncCalculation, RoutingTableFixture)
+{
+  ndn::Name routerB("/ndn/site/%C1.Router/b");
+  conf.getAdjacencyList().insert(Adjacent(routerB, ndn::FaceUri("udp4://10.0.0.2:6363"), 10,
+                                          Adjacent::STATUS_ACTIVE, 0, 0));
+  AdjacencyList adjB;
+  adjB.insert(Adjacent(conf.getRouterPrefix(), ndn::FaceUri("udp4://10.0.0.1:6363"), 10,
+                       Adjacent::STATUS_ACTIVE, 0, 0));
+  lsdb.installLsa(std::make_shared<AdjLsa>(routerB, 1, time::system_clock::now() + 3600_s, adjB));
+  lsdb.buildAndInstallOwnAdjLsa();
+  advanceClocks(15_s);
+  BOOST_REQUIRE(rt.findRoutingTableEntry(routerB) != nullptr);
+
+  // a link-state calculation is running on the worker thread when load-aware routing is enabled
+  rt.m_isAsyncCalculationRunning = true;
+  conf.setLoadAwareRouting(true);
+  rt.updateCostCalculators();
+  BOOST_CHECK(rt.m_isAsyncCalculationPending);
+
+  // the load-aware calculation waits for the worker to release the SPF state
+  rt.calculate();
+  BOOST_CHECK(rt.m_isAsyncCalculationPending);
+  BOOST_CHECK(rt.findRoutingTableEntry(routerB) != nullptr);
+
+  // the late link-state routes are dropped, and the table is calculated in the new mode
+  rt.onAsyncCalculationDone(LinkStateRoutes{});
+  BOOST_CHECK(!rt.m_isAsyncCalculationRunning);
+  BOOST_CHECK(!rt.m_isAsyncCalculationPending);
+  BOOST_CHECK(rt.findRoutingTableEntry(routerB) != nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
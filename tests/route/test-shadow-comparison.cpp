@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/shadow-comparison.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestShadowComparison)
+
+BOOST_AUTO_TEST_CASE(Compare)
+{
+  const ndn::Name A("/ndn/site/%C1.Router/a");
+  const ndn::Name B("/ndn/site/%C1.Router/b");
+  const ndn::FaceUri F1("udp4://10.0.0.1:6363");
+  const ndn::FaceUri F2("udp4://10.0.0.2:6363");
+
+  RouteList reference{{A, NextHop(F1, 10)}, {A, NextHop(F2, 15)},
+                      {B, NextHop(F1, 20)}, {B, NextHop(F2, 20)}};
+  RouteList live{{A, NextHop(F1, 10)}, {B, NextHop(F1, 20)}};
+
+  ShadowComparison comparison;
+  comparison.compare("live", live, live, reference);
+  // A through the longer path, and B unreached
+  comparison.compare("local", {{A, NextHop(F2, 8)}, {A, NextHop(F1, 9)}}, live, reference);
+
+  BOOST_REQUIRE_EQUAL(comparison.getStatus().size(), 2);
+  const auto& liveStatus = comparison.getStatus()[0];
+  BOOST_CHECK_EQUAL(liveStatus.calculator, "live");
+  BOOST_CHECK_EQUAL(liveStatus.nDestinations, 2);
+  BOOST_CHECK_EQUAL(liveStatus.nNextHopDisagreements, 0);
+  BOOST_CHECK_EQUAL(liveStatus.meanStretch, 1.0);
+  BOOST_CHECK_EQUAL(liveStatus.nNextHopChanges, 2);
+
+  const auto& status = comparison.getStatus()[1];
+  BOOST_CHECK_EQUAL(status.calculator, "local");
+  BOOST_CHECK_EQUAL(status.nCalculations, 1);
+  BOOST_CHECK_EQUAL(status.nNextHopDisagreements, 2);
+  BOOST_CHECK_CLOSE(status.meanStretch, 1.5, 0.001);
+  BOOST_CHECK_CLOSE(status.maxStretch, 1.5, 0.001);
+  BOOST_CHECK_EQUAL(status.nNextHopChanges, 2);
+
+  // the next hops the calculator would change in the FIB are counted
+  comparison.compare("local", {{A, NextHop(F1, 9)}, {B, NextHop(F1, 20)}}, live, reference);
+  BOOST_CHECK_EQUAL(status.nCalculations, 2);
+  BOOST_CHECK_EQUAL(status.nNextHopDisagreements, 0);
+  BOOST_CHECK_EQUAL(status.maxStretch, 1.0);
+  BOOST_CHECK_EQUAL(status.nNextHopChanges, 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
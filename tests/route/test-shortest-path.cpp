@@ -0,0 +1,237 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/shortest-path.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <array>
+#include <memory_resource>
+#include <random>
+
+namespace nlsr::tests {
+
+using Link = std::tuple<int32_t, int32_t, double>;
+
+static LinkStateGraph
+makeGraph(size_t nRouters, const std::vector<Link>& links)
+{
+  std::vector<LinkStateGraph::DirectedEdge> edges;
+  for (const auto& [a, b, cost] : links) {
+    edges.push_back({a, b, cost});
+    edges.push_back({b, a, cost});
+  }
+  return LinkStateGraph::createFromEdges(nRouters, std::move(edges));
+}
+
+BOOST_AUTO_TEST_SUITE(TestShortestPath)
+
+BOOST_AUTO_TEST_CASE(Dijkstra)
+{
+  //   0 --5-- 1 --2-- 2
+  //    \             /
+  //     ----10------
+  //   3 (isolated)
+  auto graph = makeGraph(4, {{0, 1, 5.0}, {1, 2, 2.0}, {0, 2, 10.0}});
+  auto tree = calculateShortestPathTree(graph, 0);
+
+  BOOST_CHECK_EQUAL(tree.distance[0], 0);
+  BOOST_CHECK_EQUAL(tree.distance[1], 5 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(tree.distance[2], 7 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(tree.distance[3], ShortestPathTree::INF_DISTANCE);
+  BOOST_CHECK_EQUAL(tree.parent[0], ShortestPathTree::NO_PARENT);
+  BOOST_CHECK_EQUAL(tree.parent[1], 0);
+  BOOST_CHECK_EQUAL(tree.parent[2], 1);
+  BOOST_CHECK_EQUAL(tree.parent[3], ShortestPathTree::NO_PARENT);
+
+  // Rooted at router 1 at distance 5, never traversing router 0.
+  auto viaNeighbor = calculateShortestPathTree(graph, 1, 5 * LINK_COST_SCALE, 0);
+  BOOST_CHECK_EQUAL(viaNeighbor.distance[1], 5 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(viaNeighbor.distance[2], 7 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(viaNeighbor.distance[0], ShortestPathTree::INF_DISTANCE);
+}
+
+BOOST_AUTO_TEST_CASE(SaturatedDistance)
+{
+  auto graph = makeGraph(4, {{0, 1, 1e12}, {1, 2, 1e12}, {2, 3, 1e12}});
+  auto tree = calculateShortestPathTree(graph, 0);
+
+  BOOST_CHECK_EQUAL(tree.distance[1], MAX_LINK_COST);
+  BOOST_CHECK_EQUAL(tree.distance[2], 2 * MAX_LINK_COST);
+  // too far to be counted, but still reachable
+  BOOST_CHECK_EQUAL(tree.distance[3], ShortestPathTree::MAX_DISTANCE);
+  BOOST_CHECK_EQUAL(tree.parent[3], 2);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalNoChange)
+{
+  auto graph = makeGraph(3, {{0, 1, 5.0}, {1, 2, 2.0}});
+  auto tree = calculateShortestPathTree(graph, 0);
+  BOOST_CHECK_EQUAL(updateShortestPathTree(tree, graph, graph, 0), 0);
+  BOOST_CHECK_EQUAL(tree.distance[2], 7 * LINK_COST_SCALE);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalCostIncreaseAndLinkLoss)
+{
+  auto oldGraph = makeGraph(4, {{0, 1, 5.0}, {1, 2, 2.0}, {0, 2, 10.0}, {2, 3, 1.0}});
+  auto tree = calculateShortestPathTree(oldGraph, 0);
+  BOOST_CHECK_EQUAL(tree.distance[3], 8 * LINK_COST_SCALE);
+
+  // Link 1-2 gets more expensive: subtree {2, 3} moves below the direct link 0-2.
+  auto newGraph = makeGraph(4, {{0, 1, 5.0}, {1, 2, 20.0}, {0, 2, 10.0}, {2, 3, 1.0}});
+  BOOST_CHECK_EQUAL(updateShortestPathTree(tree, oldGraph, newGraph, 0), 2);
+  BOOST_CHECK_EQUAL(tree.distance[2], 10 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(tree.parent[2], 0);
+  BOOST_CHECK_EQUAL(tree.distance[3], 11 * LINK_COST_SCALE);
+
+  // Link 2-3 disappears: router 3 becomes unreachable.
+  auto lastGraph = makeGraph(4, {{0, 1, 5.0}, {1, 2, 20.0}, {0, 2, 10.0}});
+  updateShortestPathTree(tree, newGraph, lastGraph, 0);
+  BOOST_CHECK_EQUAL(tree.distance[3], ShortestPathTree::INF_DISTANCE);
+  BOOST_CHECK_EQUAL(tree.parent[3], ShortestPathTree::NO_PARENT);
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalCostDecrease)
+{
+  auto oldGraph = makeGraph(3, {{0, 1, 5.0}, {1, 2, 2.0}, {0, 2, 10.0}});
+  auto tree = calculateShortestPathTree(oldGraph, 0);
+
+  auto newGraph = makeGraph(3, {{0, 1, 5.0}, {1, 2, 2.0}, {0, 2, 1.0}});
+  updateShortestPathTree(tree, oldGraph, newGraph, 0);
+  BOOST_CHECK_EQUAL(tree.distance[2], 1 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(tree.parent[2], 0);
+  BOOST_CHECK_EQUAL(tree.distance[1], 3 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(tree.parent[1], 2);
+}
+
+BOOST_AUTO_TEST_CASE(EqualCostDiamond)
+{
+  //     1
+  //   /   \
+  //  0     3
+  //   \   /
+  //     2
+  auto diamond = makeGraph(4, {{0, 1, 1.0}, {0, 2, 1.0}, {1, 3, 1.0}, {2, 3, 1.0}});
+  auto full = calculateShortestPathTree(diamond, 0);
+  BOOST_CHECK_EQUAL(full.distance[3], 2 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(full.parent[3], 1);
+
+  // the path through 1 becomes as short as the one through 2, as either of its links gets cheaper
+  std::vector<Link> viaLink13{{0, 1, 1.0}, {0, 2, 1.0}, {1, 3, 5.0}, {2, 3, 1.0}};
+  std::vector<Link> viaLink01{{0, 1, 5.0}, {0, 2, 1.0}, {1, 3, 1.0}, {2, 3, 1.0}};
+  for (const auto& oldLinks : {viaLink13, viaLink01}) {
+    auto oldGraph = makeGraph(4, oldLinks);
+    auto tree = calculateShortestPathTree(oldGraph, 0);
+    BOOST_CHECK_EQUAL(tree.parent[3], 2);
+
+    updateShortestPathTree(tree, oldGraph, diamond, 0);
+    BOOST_TEST(tree.distance == full.distance, boost::test_tools::per_element());
+    BOOST_TEST(tree.parent == full.parent, boost::test_tools::per_element());
+  }
+}
+
+BOOST_AUTO_TEST_CASE(IncrementalMatchesFull)
+{
+  constexpr size_t N_ROUTERS = 40;
+  std::mt19937 rng(42);
+  std::uniform_int_distribution<int32_t> pickRouter(0, N_ROUTERS - 1);
+  std::uniform_int_distribution<int> pickCost(1, 30);
+
+  std::map<std::pair<int32_t, int32_t>, double> links;
+  for (int i = 0; i < 100; ++i) {
+    int32_t a = pickRouter(rng);
+    int32_t b = pickRouter(rng);
+    if (a != b) {
+      links[{std::min(a, b), std::max(a, b)}] = pickCost(rng);
+    }
+  }
+  auto toGraph = [&] {
+    std::vector<Link> list;
+    for (const auto& [ends, cost] : links) {
+      list.emplace_back(ends.first, ends.second, cost);
+    }
+    return makeGraph(N_ROUTERS, list);
+  };
+
+  auto graph = toGraph();
+  auto tree = calculateShortestPathTree(graph, 0);
+  auto neighborTree = calculateShortestPathTree(graph, 1, 3 * LINK_COST_SCALE, 0);
+
+  for (int round = 0; round < 50; ++round) {
+    // Change, remove or add a random link.
+    auto it = std::next(links.begin(), rng() % links.size());
+    switch (rng() % 3) {
+      case 0:
+        it->second = pickCost(rng);
+        break;
+      case 1:
+        links.erase(it);
+        break;
+      default: {
+        int32_t a = pickRouter(rng);
+        int32_t b = pickRouter(rng);
+        if (a != b) {
+          links[{std::min(a, b), std::max(a, b)}] = pickCost(rng);
+        }
+      }
+    }
+
+    auto newGraph = toGraph();
+    updateShortestPathTree(tree, graph, newGraph, 0);
+    updateShortestPathTree(neighborTree, graph, newGraph, 1, 3 * LINK_COST_SCALE, 0);
+    graph = std::move(newGraph);
+
+    BOOST_TEST_CONTEXT("Round " << round) {
+      auto fullTree = calculateShortestPathTree(graph, 0);
+      auto fullNeighborTree = calculateShortestPathTree(graph, 1, 3 * LINK_COST_SCALE, 0);
+      BOOST_TEST(tree.distance == fullTree.distance, boost::test_tools::per_element());
+      BOOST_TEST(tree.parent == fullTree.parent, boost::test_tools::per_element());
+      BOOST_TEST(neighborTree.distance == fullNeighborTree.distance,
+                 boost::test_tools::per_element());
+      BOOST_TEST(neighborTree.parent == fullNeighborTree.parent,
+                 boost::test_tools::per_element());
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ScratchMemory)
+{
+  auto oldGraph = makeGraph(4, {{0, 1, 5.0}, {1, 2, 2.0}, {0, 2, 10.0}, {2, 3, 1.0}});
+  auto newGraph = makeGraph(4, {{0, 1, 5.0}, {1, 2, 20.0}, {0, 2, 10.0}, {2, 3, 1.0}});
+
+  // the temporary arrays fit in the buffer, and nothing else is taken from it
+  std::array<std::byte, 4096> buffer;
+  std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(),
+                                            std::pmr::null_memory_resource());
+  auto tree = calculateShortestPathTree(oldGraph, 0, 0, NO_EXCLUDED_ROUTER, &arena);
+  BOOST_CHECK_EQUAL(tree.distance[3], 8 * LINK_COST_SCALE);
+  BOOST_CHECK_EQUAL(updateShortestPathTree(tree, oldGraph, newGraph, 0, 0,
+                                           NO_EXCLUDED_ROUTER, &arena), 2);
+  BOOST_CHECK_EQUAL(tree.distance[3], 11 * LINK_COST_SCALE);
+
+  arena.release();
+  auto fullTree = calculateShortestPathTree(newGraph, 0);
+  BOOST_TEST(tree.distance == fullTree.distance, boost::test_tools::per_element());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,137 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/topology.hpp"
+
+#include "conf-parameter.hpp"
+#include "route/name-map.hpp"
+#include "tlv-nlsr.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+#include <filesystem>
+
+namespace nlsr::tests {
+
+class TopologyExporterFixture : public IoKeyChainFixture
+{
+public:
+  TopologyExporterFixture()
+    : face(m_io, m_keyChain)
+    , conf(face, m_keyChain)
+  {
+    conf.setStateFileDir(std::filesystem::temp_directory_path().string());
+    map.addEntry("/ndn/router/a");
+    map.addEntry("/ndn/router/b");
+    map.addEntry("/ndn/router/c");
+  }
+
+public:
+  ndn::DummyClientFace face;
+  ConfParameter conf;
+  NameMap map;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTopologyExporter, TopologyExporterFixture)
+
+BOOST_AUTO_TEST_CASE(SkipUnchanged)
+{
+  TopologyExporter exporter(conf);
+  auto graph = LinkStateGraph::createFromEdges(3, {{0, 1, 5.0}, {1, 0, 5.0}});
+
+  BOOST_CHECK_EQUAL(exporter.publish(graph, map), true);
+  BOOST_CHECK_EQUAL(exporter.publish(graph, map), false);
+
+  auto changed = LinkStateGraph::createFromEdges(3, {{0, 1, 7.0}, {1, 0, 7.0}});
+  BOOST_CHECK_EQUAL(exporter.publish(changed, map), true);
+  BOOST_CHECK_EQUAL(exporter.publish(graph, map), true);
+
+  map.addEntry("/ndn/router/d");
+  BOOST_CHECK_EQUAL(exporter.publish(graph, map), true);
+}
+
+BOOST_AUTO_TEST_CASE(Format)
+{
+  TopologyExporter::Snapshot snapshot{"", {"/a", "/b", "/c"},
+    LinkStateGraph::createFromEdges(3, {{0, 1, 5.0}, {1, 0, 5.0}, {1, 2, 3.0}, {2, 1, 3.0}})};
+
+  BOOST_CHECK_EQUAL(TopologyExporter::formatTopology(snapshot, 4),
+                    "{\n  \"version\": 4,\n  \"nodes\": [\n"
+                    "    {\"id\": 0, \"name\": \"/a\"},\n"
+                    "    {\"id\": 1, \"name\": \"/b\"},\n"
+                    "    {\"id\": 2, \"name\": \"/c\"}\n"
+                    "  ],\n"
+                    "  \"links\": [\n"
+                    "    {\"source\": 0, \"target\": 1, \"cost\": 5},\n"
+                    "    {\"source\": 1, \"target\": 2, \"cost\": 3}\n"
+                    "  ]\n}");
+}
+
+BOOST_AUTO_TEST_CASE(Diff)
+{
+  TopologyExporter::Snapshot from{"", {"/a", "/b", "/c"},
+    LinkStateGraph::createFromEdges(3, {{0, 1, 5.0}, {1, 0, 5.0}, {1, 2, 3.0}, {2, 1, 3.0}})};
+  // Mapping numbers differ; /c is gone, /d is new
+  TopologyExporter::Snapshot to{"", {"/d", "/b", "/a"},
+    LinkStateGraph::createFromEdges(3, {{2, 1, 7.0}, {1, 2, 7.0}, {0, 2, 1.0}, {2, 0, 1.0}})};
+
+  std::vector<std::string> expected{
+    "5 router-add /d",
+    "5 link-cost /a /b 7",
+    "5 link-remove /b /c",
+    "5 link-add /a /d 1",
+    "5 router-remove /c",
+  };
+  auto lines = TopologyExporter::diffTopology(from, to, 5);
+  BOOST_CHECK_EQUAL_COLLECTIONS(lines.begin(), lines.end(), expected.begin(), expected.end());
+
+  BOOST_CHECK(TopologyExporter::diffTopology(to, to, 6).empty());
+}
+
+BOOST_AUTO_TEST_CASE(StatusEncoding)
+{
+  TopologyExporter exporter(conf);
+  BOOST_CHECK(exporter.getStatus().getRouters().empty());
+
+  auto graph = LinkStateGraph::createFromEdges(3, {{0, 1, 5.0}, {1, 0, 5.0},
+                                                   {1, 2, 3.5004}, {2, 1, 3.5004}});
+  exporter.publish(graph, map);
+  const auto& wire = exporter.getStatus().wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), nlsr::tlv::Topology);
+
+  TopologyStatus decoded(wire);
+  BOOST_CHECK_EQUAL_COLLECTIONS(decoded.getRouters().begin(), decoded.getRouters().end(),
+                                exporter.getStatus().getRouters().begin(),
+                                exporter.getStatus().getRouters().end());
+  BOOST_REQUIRE_EQUAL(decoded.getLinks().size(), 2);
+  BOOST_CHECK_EQUAL(decoded.getLinks()[1].source, 1);
+  BOOST_CHECK_EQUAL(decoded.getLinks()[1].target, 2);
+  // as rounded to the fixed point of the SPF
+  BOOST_CHECK_EQUAL(decoded.getLinks()[1].cost, 3.5);
+
+  exporter.publish(LinkStateGraph::createFromEdges(3, {}), map);
+  BOOST_CHECK_EQUAL(TopologyStatus(exporter.getStatus().wireEncode()).getLinks().size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
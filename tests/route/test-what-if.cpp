@@ -0,0 +1,195 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/what-if.hpp"
+
+#include "adjacency-list.hpp"
+#include "lsdb.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+namespace nlsr::tests {
+
+constexpr time::system_clock::time_point MAX_TIME = time::system_clock::time_point::max();
+static const ndn::Name ROUTER_A_NAME = "/ndn/site/%C1.Router/this-router";
+static const ndn::Name ROUTER_B_NAME = "/ndn/site/%C1.Router/b";
+static const ndn::Name ROUTER_C_NAME = "/ndn/site/%C1.Router/c";
+static const ndn::FaceUri ROUTER_A_FACE("udp4://10.0.0.1:6363");
+static const ndn::FaceUri ROUTER_B_FACE("udp4://10.0.0.2:6363");
+static const ndn::FaceUri ROUTER_C_FACE("udp4://10.0.0.3:6363");
+
+/**
+ * @brief Triangle of routers A, B, C, where A is this router, and the links cost
+ *        A-B 5, A-C 10 and B-C 17. B advertises one prefix, and C two.
+ */
+class WhatIfFixture : public IoKeyChainFixture
+{
+public:
+  WhatIfFixture()
+    : face(m_io, m_keyChain)
+    , conf(face, m_keyChain)
+    , confProcessor(conf)
+    , lsdb(face, m_keyChain, conf)
+  {
+    auto& adjList = conf.getAdjacencyList();
+    adjList.insert(Adjacent(ROUTER_B_NAME, ROUTER_B_FACE, 5, Adjacent::STATUS_ACTIVE, 0, 0));
+    adjList.insert(Adjacent(ROUTER_C_NAME, ROUTER_C_FACE, 10, Adjacent::STATUS_ACTIVE, 0, 0));
+    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_A_NAME, 1, MAX_TIME, adjList));
+
+    AdjacencyList adjListB;
+    adjListB.insert(Adjacent(ROUTER_A_NAME, ROUTER_A_FACE, 5, Adjacent::STATUS_ACTIVE, 0, 0));
+    adjListB.insert(Adjacent(ROUTER_C_NAME, ROUTER_C_FACE, 17, Adjacent::STATUS_ACTIVE, 0, 0));
+    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_B_NAME, 1, MAX_TIME, adjListB));
+
+    AdjacencyList adjListC;
+    adjListC.insert(Adjacent(ROUTER_A_NAME, ROUTER_A_FACE, 10, Adjacent::STATUS_ACTIVE, 0, 0));
+    adjListC.insert(Adjacent(ROUTER_B_NAME, ROUTER_B_FACE, 17, Adjacent::STATUS_ACTIVE, 0, 0));
+    lsdb.installLsa(std::make_shared<AdjLsa>(ROUTER_C_NAME, 1, MAX_TIME, adjListC));
+
+    lsdb.installLsa(std::make_shared<NameLsa>(ROUTER_B_NAME, 1, MAX_TIME,
+                                              NamePrefixList{"/b/1"}));
+    lsdb.installLsa(std::make_shared<NameLsa>(ROUTER_C_NAME, 1, MAX_TIME,
+                                              NamePrefixList{"/c/1", "/c/2"}));
+  }
+
+  WhatIfResult
+  calculate(const WhatIfQuery& query)
+  {
+    auto input = makeLinkStateInput(lsdb.getRouterMap(), conf);
+    return calculateWhatIf(std::move(input), *lsdb.getSnapshot(), query);
+  }
+
+  static std::map<ndn::FaceUri, double>
+  getCosts(const RoutingTableEntry& entry)
+  {
+    std::map<ndn::FaceUri, double> costs;
+    for (const auto& nh : entry.getNexthopList()) {
+      costs.emplace(nh.getConnectingFaceUri(), nh.getRouteCost());
+    }
+    return costs;
+  }
+
+public:
+  ndn::DummyClientFace face;
+  ConfParameter conf;
+  DummyConfFileProcessor confProcessor;
+  Lsdb lsdb;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestWhatIf, WhatIfFixture)
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  WhatIfQuery query;
+  query.scenarios.push_back({
+    {WhatIfChange::Type::LINK_DOWN, ROUTER_A_NAME, ROUTER_B_NAME},
+    {WhatIfChange::Type::LINK_COST, ROUTER_B_NAME, ROUTER_C_NAME, 2.5},
+  });
+  query.scenarios.push_back({{WhatIfChange::Type::ROUTER_DOWN, ROUTER_C_NAME}});
+
+  WhatIfQuery decodedQuery(query.wireEncode());
+  BOOST_REQUIRE_EQUAL(decodedQuery.scenarios.size(), 2);
+  BOOST_REQUIRE_EQUAL(decodedQuery.scenarios[0].size(), 2);
+  BOOST_CHECK(decodedQuery.scenarios[0][0].type == WhatIfChange::Type::LINK_DOWN);
+  BOOST_CHECK_EQUAL(decodedQuery.scenarios[0][0].neighbor, ROUTER_B_NAME);
+  BOOST_CHECK(decodedQuery.scenarios[0][1].type == WhatIfChange::Type::LINK_COST);
+  BOOST_CHECK_EQUAL(decodedQuery.scenarios[0][1].router, ROUTER_B_NAME);
+  BOOST_CHECK_EQUAL(decodedQuery.scenarios[0][1].cost, 2.5);
+  BOOST_REQUIRE_EQUAL(decodedQuery.scenarios[1].size(), 1);
+  BOOST_CHECK(decodedQuery.scenarios[1][0].type == WhatIfChange::Type::ROUTER_DOWN);
+  BOOST_CHECK_EQUAL(decodedQuery.scenarios[1][0].router, ROUTER_C_NAME);
+
+  BOOST_CHECK_THROW(WhatIfQuery(WhatIfQuery().wireEncode()), WhatIfQuery::Error);
+
+  WhatIfOutcome outcome;
+  RoutingTableEntry entry(ROUTER_B_NAME);
+  entry.getNexthopList().addNextHop(NextHop(ROUTER_C_FACE, 27));
+  outcome.delta.changed.push_back(entry);
+  outcome.delta.removed.push_back(ROUTER_C_NAME);
+  outcome.nAffectedPrefixes = 3;
+  outcome.nUnreachablePrefixes = 2;
+  WhatIfResult result;
+  result.outcomes = {WhatIfOutcome{}, outcome};
+
+  WhatIfResult decodedResult(result.wireEncode());
+  BOOST_REQUIRE_EQUAL(decodedResult.outcomes.size(), 2);
+  BOOST_CHECK(decodedResult.outcomes[0].delta.empty());
+  const auto& decoded = decodedResult.outcomes[1];
+  BOOST_CHECK(decoded.delta.added.empty());
+  BOOST_REQUIRE_EQUAL(decoded.delta.changed.size(), 1);
+  BOOST_CHECK_EQUAL(decoded.delta.changed.front().getDestination(), ROUTER_B_NAME);
+  BOOST_REQUIRE_EQUAL(decoded.delta.removed.size(), 1);
+  BOOST_CHECK_EQUAL(decoded.delta.removed.front(), ROUTER_C_NAME);
+  BOOST_CHECK_EQUAL(decoded.nAffectedPrefixes, 3);
+  BOOST_CHECK_EQUAL(decoded.nUnreachablePrefixes, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Scenarios)
+{
+  WhatIfQuery query;
+  // this router's link goes down
+  query.scenarios.push_back({{WhatIfChange::Type::LINK_DOWN, ROUTER_B_NAME, ROUTER_A_NAME}});
+  // another router goes down
+  query.scenarios.push_back({{WhatIfChange::Type::ROUTER_DOWN, ROUTER_C_NAME}});
+  // a remote link becomes cheap
+  query.scenarios.push_back({{WhatIfChange::Type::LINK_COST, ROUTER_B_NAME, ROUTER_C_NAME, 1}});
+  // nothing changes
+  query.scenarios.push_back({{WhatIfChange::Type::LINK_COST, ROUTER_A_NAME, ROUTER_B_NAME, 5}});
+
+  auto result = calculate(query);
+  BOOST_REQUIRE_EQUAL(result.outcomes.size(), 4);
+
+  const auto& linkDown = result.outcomes[0];
+  BOOST_CHECK(linkDown.delta.added.empty());
+  BOOST_CHECK(linkDown.delta.removed.empty());
+  BOOST_REQUIRE_EQUAL(linkDown.delta.changed.size(), 2);
+  BOOST_CHECK_EQUAL(linkDown.delta.changed.front().getDestination(), ROUTER_B_NAME);
+  BOOST_CHECK((getCosts(linkDown.delta.changed.front()) ==
+               std::map<ndn::FaceUri, double>{{ROUTER_C_FACE, 27}}));
+  BOOST_CHECK((getCosts(linkDown.delta.changed.back()) ==
+               std::map<ndn::FaceUri, double>{{ROUTER_C_FACE, 10}}));
+  BOOST_CHECK_EQUAL(linkDown.nAffectedPrefixes, 3);
+  BOOST_CHECK_EQUAL(linkDown.nUnreachablePrefixes, 0);
+
+  const auto& routerDown = result.outcomes[1];
+  BOOST_REQUIRE_EQUAL(routerDown.delta.changed.size(), 1);
+  BOOST_CHECK((getCosts(routerDown.delta.changed.front()) ==
+               std::map<ndn::FaceUri, double>{{ROUTER_B_FACE, 5}}));
+  BOOST_REQUIRE_EQUAL(routerDown.delta.removed.size(), 1);
+  BOOST_CHECK_EQUAL(routerDown.delta.removed.front(), ROUTER_C_NAME);
+  BOOST_CHECK_EQUAL(routerDown.nAffectedPrefixes, 3);
+  BOOST_CHECK_EQUAL(routerDown.nUnreachablePrefixes, 2);
+
+  const auto& linkCost = result.outcomes[2];
+  BOOST_REQUIRE_EQUAL(linkCost.delta.changed.size(), 2);
+  BOOST_CHECK((getCosts(linkCost.delta.changed.front()) ==
+               std::map<ndn::FaceUri, double>{{ROUTER_B_FACE, 5}, {ROUTER_C_FACE, 11}}));
+  BOOST_CHECK((getCosts(linkCost.delta.changed.back()) ==
+               std::map<ndn::FaceUri, double>{{ROUTER_B_FACE, 6}, {ROUTER_C_FACE, 10}}));
+
+  BOOST_CHECK(result.outcomes[3].delta.empty());
+  BOOST_CHECK_EQUAL(result.outcomes[3].nAffectedPrefixes, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
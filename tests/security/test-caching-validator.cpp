@@ -0,0 +1,183 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include "security/caching-validator.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/security/certificate-fetcher-offline.hpp>
+
+#include <thread>
+
+namespace nlsr::tests {
+
+using security::CachingValidator;
+
+class CachingValidatorFixture : public IoKeyChainFixture
+{
+public:
+  CachingValidatorFixture()
+  {
+    // only the Data packets under /signed have a rule
+    validator.load(R"CONF(
+      rule
+      {
+        id "signed"
+        for data
+        filter
+        {
+          type name
+          name /signed
+          relation is-prefix-of
+        }
+        checker
+        {
+          type customized
+          sig-type ecdsa-sha256
+          key-locator
+          {
+            type name
+            name /ndn/site
+            relation is-prefix-of
+          }
+        }
+      }
+    )CONF", "test-config");
+    validator.loadAnchor("test", identity.getDefaultKey().getDefaultCertificate());
+  }
+
+  ndn::Data
+  makeData(const ndn::Name& name, std::string_view content)
+  {
+    ndn::Data data(name);
+    data.setContent(ndn::makeStringBlock(ndn::tlv::Content, content));
+    m_keyChain.sign(data, ndn::signingByIdentity(identity));
+    return data;
+  }
+
+  bool
+  validate(const ndn::Data& data)
+  {
+    bool isValid = false;
+    validator.validate(data,
+                       [&] (const ndn::Data&) { isValid = true; },
+                       [] (const ndn::Data&, const ndn::security::ValidationError&) {});
+    advanceClocks(1_ms);
+    return isValid;
+  }
+
+public:
+  ndn::security::Identity identity = m_keyChain.createIdentity("/ndn/site/%C1.Router/router1");
+  CachingValidator validator{std::make_unique<ndn::security::CertificateFetcherOffline>(), m_io,
+                             2, 10_s};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestCachingValidator, CachingValidatorFixture)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  auto data = makeData("/localhop/ndn/nlsr/LSA/site/%C1.Router/router1/NAME/%01/%00", "lsa");
+  BOOST_CHECK(!validate(data));
+
+  validator.cacheValidated(data);
+  BOOST_CHECK_EQUAL(validator.getCacheSize(), 1);
+  BOOST_CHECK(validate(data));
+  BOOST_CHECK_EQUAL(validator.getNCacheHits(), 1);
+
+  // a packet with the same name but other content or signature is checked against the policy
+  auto forged = makeData(data.getName(), "forged");
+  BOOST_CHECK(!validate(forged));
+  ndn::Data resigned(data);
+  m_keyChain.sign(resigned, ndn::signingWithSha256());
+  BOOST_CHECK(!validate(resigned));
+  BOOST_CHECK_EQUAL(validator.getNCacheHits(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Eviction)
+{
+  auto data1 = makeData("/test/1", "1");
+  auto data2 = makeData("/test/2", "2");
+  auto data3 = makeData("/test/3", "3");
+
+  validator.cacheValidated(data1);
+  validator.cacheValidated(data2);
+  // data1 becomes the most recently used
+  BOOST_CHECK(validate(data1));
+  validator.cacheValidated(data3);
+  BOOST_CHECK_EQUAL(validator.getCacheSize(), 2);
+
+  BOOST_CHECK(validate(data1));
+  BOOST_CHECK(!validate(data2));
+  BOOST_CHECK(validate(data3));
+}
+
+BOOST_AUTO_TEST_CASE(Expiration)
+{
+  auto data = makeData("/test/1", "1");
+  validator.cacheValidated(data);
+  advanceClocks(1_s, 5);
+  BOOST_CHECK(validate(data));
+
+  advanceClocks(1_s, 5);
+  BOOST_CHECK(!validate(data));
+  BOOST_CHECK_EQUAL(validator.getCacheSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(VerificationThreads)
+{
+  validator.setVerificationThreads(2);
+
+  std::vector<ndn::Data> packets;
+  for (int i = 0; i < 20; ++i) {
+    packets.push_back(makeData(ndn::Name("/signed").appendNumber(i), std::to_string(i)));
+  }
+  auto forged = packets[10];
+  forged.setContent(ndn::makeStringBlock(ndn::tlv::Content, "forged"));
+  packets.push_back(forged);
+
+  std::vector<ndn::Name> outcomes;
+  size_t nInvalid = 0;
+  for (const auto& data : packets) {
+    validator.validate(data,
+                       [&] (const ndn::Data& valid) { outcomes.push_back(valid.getName()); },
+                       [&] (const ndn::Data& invalid, const ndn::security::ValidationError&) {
+                         outcomes.push_back(invalid.getName());
+                         ++nInvalid;
+                       });
+  }
+  for (int i = 0; i < 1000 && outcomes.size() < packets.size(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    advanceClocks(1_ms);
+  }
+
+  // reported in the order the packets were validated
+  BOOST_REQUIRE_EQUAL(outcomes.size(), packets.size());
+  for (size_t i = 0; i < packets.size(); ++i) {
+    BOOST_CHECK_EQUAL(outcomes[i], packets[i].getName());
+  }
+  BOOST_CHECK_EQUAL(nInvalid, 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -29,6 +29,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/property_tree/info_parser.hpp>
 
+#include <algorithm>
 #include <filesystem>
 
 namespace nlsr::tests {
@@ -241,6 +242,54 @@ BOOST_AUTO_TEST_CASE(SegmentValidatedSignal)
   BOOST_CHECK(certStore.find(keyName) != nullptr);
 }
 
+BOOST_AUTO_TEST_CASE(PrefetchCertificates)
+{
+  auto stateDir = std::filesystem::temp_directory_path() / "nlsr-test-cert-cache";
+  std::filesystem::remove_all(stateDir);
+  std::filesystem::create_directories(stateDir);
+  conf.setStateFileDir(stateDir.string());
+  conf.setCertPrefetch(true);
+
+  ndn::Name otherRouter(siteIdentityName);
+  otherRouter.append(ndn::Name("%C1.Router")).append("router2");
+  auto otherId = addSubCertificate(otherRouter, siteIdentity);
+  auto otherCert = otherId.getDefaultKey().getDefaultCertificate();
+
+  auto countInterests = [this] (const ndn::Name& name) {
+    return std::count_if(face.sentInterests.begin(), face.sentInterests.end(),
+                         [&] (const auto& interest) { return interest.getName() == name; });
+  };
+  ndn::Name instanceKey(otherRouter);
+  instanceKey.append("nlsr").append(ndn::security::Certificate::KEY_COMPONENT);
+  ndn::Name routerKey(otherRouter);
+  routerKey.append(ndn::security::Certificate::KEY_COMPONENT);
+  ndn::Name siteKey(siteIdentityName);
+  siteKey.append(ndn::security::Certificate::KEY_COMPONENT);
+
+  face.sentInterests.clear();
+  certStore.prefetchCertificates(otherRouter, 0);
+  // only the first update of a router starts a prefetch
+  certStore.prefetchCertificates(otherRouter, 0);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(countInterests(instanceKey), 1);
+  BOOST_CHECK_EQUAL(countInterests(routerKey), 1);
+  // the site certificate is already trusted
+  BOOST_CHECK_EQUAL(countInterests(siteKey), 0);
+
+  face.receive(otherCert);
+  advanceClocks(10_ms);
+  BOOST_CHECK(conf.getValidator().getUnverifiedCertCache().find(otherCert.getName()) != nullptr);
+
+  advanceClocks(1_s, 5);
+  BOOST_CHECK(std::filesystem::exists(stateDir / security::CERT_CACHE_FILE));
+  {
+    security::CertificateStore nextRun(face, conf, lsdb);
+    BOOST_CHECK_EQUAL(nextRun.loadCacheFile(), 1);
+  }
+
+  std::filesystem::remove_all(stateDir);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
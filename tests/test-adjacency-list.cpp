@@ -74,6 +74,148 @@ BOOST_AUTO_TEST_CASE(FindAdjacentByFaceUri)
   BOOST_CHECK(adjIter != adjList.end());
 }
 
+BOOST_AUTO_TEST_CASE(FindAdjacentByFaceId)
+{
+  AdjacencyList adjList;
+  adjList.insert(Adjacent("/ndn/test/1", ndn::FaceUri("udp4://10.0.0.1:6363"), 10,
+                          Adjacent::STATUS_INACTIVE, 0, 257));
+  adjList.insert(Adjacent("/ndn/test/2", ndn::FaceUri("udp4://10.0.0.2:6363"), 10,
+                          Adjacent::STATUS_INACTIVE, 0, 0));
+
+  BOOST_CHECK_EQUAL(adjList.findAdjacent(257)->getName(), "/ndn/test/1");
+  BOOST_CHECK(adjList.findAdjacent(258) == adjList.end());
+  BOOST_CHECK(adjList.findAdjacent(0) == adjList.end());
+
+  adjList.setFaceId("/ndn/test/2", 258);
+  BOOST_CHECK_EQUAL(adjList.findAdjacent(258)->getName(), "/ndn/test/2");
+  BOOST_CHECK_EQUAL(adjList.getFaceId(ndn::FaceUri("udp4://10.0.0.2:6363")), 258);
+
+  adjList.setFaceId("/ndn/test/1", 0);
+  BOOST_CHECK(adjList.findAdjacent(257) == adjList.end());
+
+  // a copy indexes its own entries
+  AdjacencyList copy(adjList);
+  adjList.reset();
+  BOOST_CHECK(adjList.findAdjacent(258) == adjList.end());
+  BOOST_CHECK_EQUAL(copy.findAdjacent(258)->getName(), "/ndn/test/2");
+}
+
+BOOST_AUTO_TEST_CASE(ControlTrafficCounters)
+{
+  using MessageClass = ControlTraffic::MessageClass;
+
+  AdjacencyList adjList;
+  adjList.insert(Adjacent("/ndn/test/1", ndn::FaceUri("udp4://10.0.0.1:6363"), 10,
+                          Adjacent::STATUS_ACTIVE, 0, 257));
+  BOOST_CHECK(adjList.getControlTraffic(0) == nullptr);
+  BOOST_CHECK(adjList.findControlTraffic("/ndn/test/2") == nullptr);
+  BOOST_CHECK(adjList.findControlTraffic(uint64_t{258}) == nullptr);
+  BOOST_CHECK(adjList.findControlTraffic(uint64_t{0}) == nullptr);
+
+  ndn::Interest interest("/ndn/test/1/NLSR/INFO");
+  adjList.findControlTraffic("/ndn/test/1")->countInterestSent(MessageClass::HELLO, interest);
+  adjList.findControlTraffic(uint64_t{257})->countInterestReceived(MessageClass::PROBE, interest);
+  BOOST_REQUIRE(adjList.getControlTraffic(0) != nullptr);
+  const auto& hello = adjList.getControlTraffic(0)->get(MessageClass::HELLO);
+  BOOST_CHECK_EQUAL(hello.nInterestsSent, 1);
+  BOOST_CHECK_EQUAL(hello.nBytesSent, interest.wireEncode().size());
+  BOOST_CHECK_EQUAL(hello.nInterestsReceived, 0);
+  const auto& probe = adjList.getControlTraffic(0)->get(MessageClass::PROBE);
+  BOOST_CHECK_EQUAL(probe.nInterestsReceived, 1);
+  BOOST_CHECK(adjList.getControlTraffic(0)->get(MessageClass::LSA_FETCH).empty());
+
+  // the counters belong to the list, not to its copies
+  AdjacencyList copy(adjList);
+  BOOST_CHECK(copy.getControlTraffic(0) == nullptr);
+  adjList.reset();
+  BOOST_CHECK(adjList.getControlTraffic(0) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(StatusCounters)
+{
+  AdjacencyList adjList;
+  adjList.insert(Adjacent("/router/A"));
+  adjList.insert(Adjacent("/router/B"));
+
+  std::vector<std::pair<ndn::Name, Adjacent::Status>> changes;
+  adjList.onStatusChanged.connect([&] (const Adjacent& adjacent, Adjacent::Status oldStatus) {
+    changes.emplace_back(adjacent.getName(), oldStatus);
+  });
+
+  BOOST_CHECK_EQUAL(adjList.getNumOfActiveNeighbor(), 0);
+  BOOST_CHECK_EQUAL(adjList.isAdjLsaBuildable(HELLO_RETRIES_DEFAULT), false);
+
+  adjList.setStatusOfNeighbor("/router/A", Adjacent::STATUS_ACTIVE);
+  adjList.setStatusOfNeighbor("/router/A", Adjacent::STATUS_ACTIVE);
+  BOOST_CHECK_EQUAL(adjList.getNumOfActiveNeighbor(), 1);
+  BOOST_CHECK(adjList.isAdjLsaBuildable(HELLO_RETRIES_DEFAULT));
+  BOOST_REQUIRE_EQUAL(changes.size(), 1);
+  BOOST_CHECK_EQUAL(changes.back().first, "/router/A");
+  BOOST_CHECK_EQUAL(changes.back().second, Adjacent::STATUS_INACTIVE);
+
+  adjList.setStatusOfNeighbor("/router/A", Adjacent::STATUS_INACTIVE);
+  BOOST_CHECK_EQUAL(adjList.getNumOfActiveNeighbor(), 0);
+  BOOST_CHECK_EQUAL(changes.size(), 2);
+
+  for (int i = 0; i < HELLO_RETRIES_DEFAULT; ++i) {
+    adjList.incrementTimedOutInterestCount("/router/A");
+  }
+  BOOST_CHECK_EQUAL(adjList.isAdjLsaBuildable(HELLO_RETRIES_DEFAULT), false);
+  adjList.setTimedOutInterestCount("/router/B", HELLO_RETRIES_DEFAULT + 1);
+  BOOST_CHECK(adjList.isAdjLsaBuildable(HELLO_RETRIES_DEFAULT));
+
+  // a copy counts its own entries
+  AdjacencyList copy(adjList);
+  adjList.setTimedOutInterestCount("/router/B", 0);
+  BOOST_CHECK_EQUAL(adjList.isAdjLsaBuildable(HELLO_RETRIES_DEFAULT), false);
+  BOOST_CHECK(copy.isAdjLsaBuildable(HELLO_RETRIES_DEFAULT));
+}
+
+BOOST_AUTO_TEST_CASE(NeighborIds)
+{
+  AdjacencyList adjList;
+  adjList.insert(Adjacent("/router/A"));
+  adjList.insert(Adjacent("/router/B"));
+  BOOST_CHECK_EQUAL(adjList.insert(Adjacent("/router/A")), false);
+
+  BOOST_CHECK_EQUAL(adjList.getNeighborId("/router/A").value_or(99), 0);
+  BOOST_CHECK_EQUAL(adjList.getNeighborId("/router/B").value_or(99), 1);
+  BOOST_CHECK(!adjList.getNeighborId("/router/C"));
+
+  // a copy has its own index, referring to its own entries
+  AdjacencyList copy(adjList);
+  adjList.reset();
+  BOOST_CHECK(!adjList.getNeighborId("/router/A"));
+  BOOST_CHECK_EQUAL(copy.getNeighborId("/router/B").value_or(99), 1);
+  BOOST_CHECK(copy.findAdjacent(ndn::Name("/router/B")) != copy.end());
+  BOOST_CHECK(copy.isNeighbor("/router/A"));
+}
+
+BOOST_AUTO_TEST_CASE(Erase)
+{
+  ndn::FaceUri faceUri("udp4://10.0.0.1:6363");
+  AdjacencyList adjList;
+  adjList.insert(Adjacent("/router/A", faceUri, 10, Adjacent::STATUS_ACTIVE, 0, 1));
+  adjList.insert(Adjacent("/router/B", faceUri, 10, Adjacent::STATUS_INACTIVE, 0, 1));
+  adjList.insert(Adjacent("/router/C"));
+
+  BOOST_CHECK(adjList.erase("/router/A"));
+  BOOST_CHECK(!adjList.erase("/router/A"));
+  BOOST_CHECK_EQUAL(adjList.size(), 2);
+  BOOST_CHECK_EQUAL(adjList.getNumOfActiveNeighbor(), 0);
+  BOOST_CHECK(!adjList.getNeighborId("/router/A"));
+  BOOST_CHECK(adjList.findById(0) == adjList.getAdjList().end());
+
+  // the Face ID and FaceUri now lead to the other neighbor on the same Face
+  BOOST_CHECK_EQUAL(adjList.findAdjacent(uint64_t{1})->getName(), "/router/B");
+  BOOST_CHECK_EQUAL(adjList.findAdjacent(faceUri)->getName(), "/router/B");
+
+  // the ID of the erased neighbor is not reused
+  adjList.insert(Adjacent("/router/A"));
+  BOOST_CHECK_EQUAL(adjList.getNeighborId("/router/A").value_or(99), 3);
+  BOOST_CHECK_EQUAL(adjList.getNeighborId("/router/C").value_or(99), 2);
+}
+
 BOOST_AUTO_TEST_CASE(AdjLsaIsBuildableWithOneNodeActive)
 {
   Adjacent adjacencyA("/router/A");
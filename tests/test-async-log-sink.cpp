@@ -0,0 +1,62 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "async-log-sink.hpp"
+#include "logger.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <ndn-cxx/util/logging.hpp>
+
+#include <sstream>
+
+namespace nlsr::tests {
+
+INIT_LOGGER(tests.AsyncLogSink);
+
+BOOST_AUTO_TEST_SUITE(TestAsyncLogSink)
+
+BOOST_AUTO_TEST_CASE(WriteRecords)
+{
+  ndn::util::Logging::setLevel("nlsr.tests.AsyncLogSink", ndn::util::LogLevel::INFO);
+  std::ostringstream os;
+  {
+    AsyncLogSink sink(os);
+    NLSR_LOG_INFO("first record");
+    NLSR_LOG_DEBUG("filtered record");
+    NLSR_LOG_WARN("second record");
+  }
+  ndn::util::Logging::setLevel("nlsr.tests.AsyncLogSink", ndn::util::LogLevel::NONE);
+
+  // the queued records are written when the sink is destroyed
+  auto output = os.str();
+  auto first = output.find(" INFO: [nlsr.tests.AsyncLogSink] first record\n");
+  auto second = output.find(" WARN: [nlsr.tests.AsyncLogSink] second record\n");
+  BOOST_CHECK_NE(first, std::string::npos);
+  BOOST_CHECK_NE(second, std::string::npos);
+  BOOST_CHECK_LT(first, second);
+  BOOST_CHECK_EQUAL(output.find("filtered record"), std::string::npos);
+  BOOST_CHECK_EQUAL(AsyncLogSink::getDroppedRecords(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -37,12 +37,39 @@ const std::string SECTION_GENERAL =
   "  network /ndn\n"
   "  site /memphis.edu\n"
   "  router /cs/pollux\n"
+  "  area-depth 1\n"
+  "  backbone-area /ndn/memphis.edu\n"
   "  lsa-refresh-time 1800\n"
   "  lsa-interest-lifetime 3\n"
   "  router-dead-interval 86400\n"
   "  sync-protocol psync\n"
   "  sync-interest-lifetime 10000\n"
   "  state-dir /tmp\n"
+  "  ml-weekly-patterns on\n"
+  "  ml-route-precompute on\n"
+  "  lsa-fetch-window 4\n"
+  "  lsa-fetch-rate 50\n"
+  "  adj-lsa-delta on\n"
+  "  name-lsa-compression on\n"
+  "  management-thread on\n"
+  "  async-logging on\n"
+  "  lsa-segment-storage-limit 1024\n"
+  "  name-lsa-build-interval 300\n"
+  "  sync-publish-hold-down 200\n"
+  "  sync-inline-lsa-size 1500\n"
+  "  sync-expected-routers 500\n"
+  "  lsa-min-arrival 500\n"
+  "  lsa-max-name-prefixes 10000\n"
+  "  lsa-max-adjacencies 200\n"
+  "  lsdb-snapshot-interval 300\n"
+  "  lsa-segment-size 8000\n"
+  "  verification-threads 2\n"
+  "  signing-key-type rsa\n"
+  "  metrics-export-socket /tmp/nlsr-metrics-export.sock\n"
+  "  metrics-export-port 9464\n"
+  "  event-stream-socket /tmp/nlsr-events.sock\n"
+  "  shared-state-export on\n"
+  "  cert-prefetch on\n"
   "}\n\n";
 
 const std::string SECTION_GENERAL_SVS =
@@ -60,7 +87,28 @@ const std::string SECTION_NEIGHBORS =
   "{\n"
   "  hello-retries 3\n"
   "  hello-timeout 1\n"
-  "  hello-interval  60\n\n"
+  "  hello-interval  60\n"
+  "  hello-interval-cap 600\n"
+  "  hello-signature-reuse 30\n"
+  "  liveness-interval 100\n"
+  "  liveness-multiplier 4\n\n"
+  "  rtt-source hybrid\n"
+  "  rtt-probe-interval-min 250\n"
+  "  rtt-probe-interval-max 20000\n"
+  "  cost-update-window 200\n"
+  "  cost-damping on\n"
+  "  cost-damping-half-life 30\n"
+  "  cost-damping-suppress 2500\n"
+  "  cost-damping-reuse 500\n"
+  "  rtt-spike-filter 3\n"
+  "  cost-buckets 16\n"
+  "  cost-advertise-threshold 50\n"
+  "  cost-advertise-hold 60\n"
+  "  cost-metric multi-dimensional\n"
+  "  metrics-socket /tmp/nlsr-metrics.sock\n"
+  "  link-sample-trace /tmp/nlsr-link-samples.trace\n"
+  "  face-counter-interval 5\n"
+  "  link-bandwidth 100\n"
   "  adj-lsa-build-interval 10\n"
   "  neighbor\n"
   "  {\n"
@@ -105,6 +153,17 @@ const std::string SECTION_FIB =
   "{\n"
   "   max-faces-per-prefix 3\n"
   "   routing-calc-interval 9\n"
+  "   routing-calc-threads 4\n"
+  "   routing-calc-async on\n"
+  "   routing-calc-shadow on\n"
+  "   loop-free-alternates on\n"
+  "   disjoint-multipath node\n"
+  "   weighted-multipath on\n"
+  "   routing-calc-throttle on\n"
+  "   routing-calc-initial-delay 20\n"
+  "   routing-calc-hold-time 500\n"
+  "   routing-calc-neighbor-down on\n"
+  "   fib-command-window 64\n"
   "}\n\n";
 
 const std::string SECTION_ADVERTISING =
@@ -112,6 +171,7 @@ const std::string SECTION_ADVERTISING =
   "{\n"
   "  prefix /ndn/edu/memphis/cs/netlab\n"
   "  prefix /ndn/edu/memphis/sports/basketball\n"
+  "  aggregate /ndn/edu/memphis/sports\n"
   "}\n";
 
 // NEED TO TEST SECURITY SECTION SUCH AS LOADING CERTIFICATE
@@ -185,11 +245,60 @@ BOOST_AUTO_TEST_CASE(LinkState)
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), 86400);
   BOOST_CHECK_EQUAL(conf.getSyncInterestLifetime(), ndn::time::milliseconds(10000));
   BOOST_CHECK_EQUAL(conf.getStateFileDir(), "/tmp");
+  BOOST_CHECK_EQUAL(conf.getMLWeeklyPatterns(), true);
+  BOOST_CHECK_EQUAL(conf.getMLRoutePrecompute(), true);
+  BOOST_CHECK_EQUAL(conf.getLsaFetchWindow(), 4);
+  BOOST_CHECK_EQUAL(conf.getLsaFetchRate(), 50);
+  BOOST_CHECK_EQUAL(conf.getAdjLsaDelta(), true);
+  BOOST_CHECK_EQUAL(conf.getNameLsaCompression(), true);
+  BOOST_CHECK_EQUAL(conf.getManagementThread(), true);
+  BOOST_CHECK_EQUAL(conf.getAsyncLogging(), true);
+  BOOST_CHECK_EQUAL(conf.getLsaSegmentStorageLimit(), 1024);
+  BOOST_CHECK_EQUAL(conf.getNameLsaBuildInterval(), ndn::time::milliseconds(300));
+  BOOST_CHECK_EQUAL(conf.getSyncPublishHoldDown(), ndn::time::milliseconds(200));
+  BOOST_CHECK_EQUAL(conf.getSyncInlineLsaSize(), 1500);
+  BOOST_CHECK_EQUAL(conf.getSyncExpectedRouters(), 500);
+  BOOST_CHECK_EQUAL(conf.getLsaMinArrival(), ndn::time::milliseconds(500));
+  BOOST_CHECK_EQUAL(conf.getLsaMaxNamePrefixes(), 10000);
+  BOOST_CHECK_EQUAL(conf.getLsaMaxAdjacencies(), 200);
+  BOOST_CHECK_EQUAL(conf.getLsdbSnapshotInterval(), 300);
+  BOOST_CHECK_EQUAL(conf.getLsaSegmentSize(), 8000);
+  BOOST_CHECK_EQUAL(conf.getVerificationThreads(), 2);
+  BOOST_CHECK(conf.getSigningKeyType() == SigningKeyType::RSA);
+  BOOST_CHECK_EQUAL(conf.getMetricsExportSocketPath(), "/tmp/nlsr-metrics-export.sock");
+  BOOST_CHECK_EQUAL(conf.getMetricsExportPort(), 9464);
+  BOOST_CHECK_EQUAL(conf.getEventStreamSocketPath(), "/tmp/nlsr-events.sock");
+  BOOST_CHECK_EQUAL(conf.getSharedStateExport(), true);
+  BOOST_CHECK_EQUAL(conf.getCertPrefetch(), true);
+  BOOST_CHECK_EQUAL(conf.getAreaDepth(), 1);
+  BOOST_CHECK_EQUAL(conf.getBackboneArea(), "/ndn/memphis.edu");
+  BOOST_CHECK_EQUAL(conf.getArea(), "/ndn/memphis.edu");
 
   // Neighbors
   BOOST_CHECK_EQUAL(conf.getInterestRetryNumber(), 3);
   BOOST_CHECK_EQUAL(conf.getInterestResendTime(), 1);
   BOOST_CHECK_EQUAL(conf.getInfoInterestInterval(), 60);
+  BOOST_CHECK_EQUAL(conf.getHelloIntervalCap(), 600);
+  BOOST_CHECK_EQUAL(conf.getHelloSignatureReuse(), ndn::time::seconds(30));
+  BOOST_CHECK_EQUAL(conf.getLivenessInterval(), ndn::time::milliseconds(100));
+  BOOST_CHECK_EQUAL(conf.getLivenessMultiplier(), 4);
+  BOOST_CHECK(conf.getRttSource() == RttSource::HYBRID);
+  BOOST_CHECK_EQUAL(conf.getRttProbeIntervalMin(), 250);
+  BOOST_CHECK_EQUAL(conf.getRttProbeIntervalMax(), 20000);
+  BOOST_CHECK_EQUAL(conf.getCostUpdateWindow(), 200);
+  BOOST_CHECK_EQUAL(conf.getCostDamping(), true);
+  BOOST_CHECK_EQUAL(conf.getCostDampingHalfLife(), 30);
+  BOOST_CHECK_EQUAL(conf.getCostDampingSuppress(), 2500);
+  BOOST_CHECK_EQUAL(conf.getCostDampingReuse(), 500);
+  BOOST_CHECK_EQUAL(conf.getRttSpikeFilter(), 3);
+  BOOST_CHECK_EQUAL(conf.getCostBuckets(), 16);
+  BOOST_CHECK_EQUAL(conf.getCostAdvertiseThreshold(), 50);
+  BOOST_CHECK_EQUAL(conf.getCostAdvertiseHold(), 60);
+  BOOST_CHECK(conf.getCostMetric() == CostMetric::MULTI_DIMENSIONAL);
+  BOOST_CHECK_EQUAL(conf.getMetricsSocketPath(), "/tmp/nlsr-metrics.sock");
+  BOOST_CHECK_EQUAL(conf.getLinkSampleTracePath(), "/tmp/nlsr-link-samples.trace");
+  BOOST_CHECK_EQUAL(conf.getFaceCounterInterval(), 5);
+  BOOST_CHECK_EQUAL(conf.getLinkBandwidth(), 100);
 
   BOOST_CHECK_EQUAL(conf.getAdjLsaBuildInterval(), 10);
 
@@ -213,9 +322,22 @@ BOOST_AUTO_TEST_CASE(LinkState)
   // FIB
   BOOST_CHECK_EQUAL(conf.getMaxFacesPerPrefix(), 3);
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(), 9);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcThreads(), 4);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcAsync(), true);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcShadow(), true);
+  BOOST_CHECK_EQUAL(conf.getLoopFreeAlternates(), true);
+  BOOST_CHECK(conf.getDisjointPaths() == DisjointPaths::NODE);
+  BOOST_CHECK_EQUAL(conf.getWeightedMultipath(), true);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcThrottle(), true);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialDelay(), 20);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcHoldTime(), 500);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcNeighborDown(), true);
+  BOOST_CHECK_EQUAL(conf.getFibCommandWindow(), 64);
 
   // Advertising
   BOOST_CHECK_EQUAL(conf.getNamePrefixList().size(), 2);
+  BOOST_REQUIRE_EQUAL(conf.getAggregatePrefixes().size(), 1);
+  BOOST_CHECK_EQUAL(conf.getAggregatePrefixes().front(), "/ndn/edu/memphis/sports");
 }
 
 BOOST_AUTO_TEST_CASE(SvsPrefix)
@@ -279,6 +401,33 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   commentOut("lsa-refresh-time", config);
   commentOut("lsa-interest-lifetime", config);
   commentOut("router-dead-interval", config);
+  commentOut("ml-weekly-patterns", config);
+  commentOut("ml-route-precompute", config);
+  commentOut("lsa-fetch-window", config);
+  commentOut("lsa-fetch-rate", config);
+  commentOut("adj-lsa-delta", config);
+  commentOut("name-lsa-compression", config);
+  commentOut("management-thread", config);
+  commentOut("async-logging", config);
+  commentOut("lsa-segment-storage-limit", config);
+  commentOut("name-lsa-build-interval", config);
+  commentOut("sync-publish-hold-down", config);
+  commentOut("sync-inline-lsa-size", config);
+  commentOut("sync-expected-routers", config);
+  commentOut("lsa-min-arrival", config);
+  commentOut("lsa-max-name-prefixes", config);
+  commentOut("lsa-max-adjacencies", config);
+  commentOut("lsdb-snapshot-interval", config);
+  commentOut("lsa-segment-size", config);
+  commentOut("verification-threads", config);
+  commentOut("signing-key-type", config);
+  commentOut("metrics-export-socket", config);
+  commentOut("metrics-export-port", config);
+  commentOut("event-stream-socket", config);
+  commentOut("shared-state-export", config);
+  commentOut("cert-prefetch", config);
+  commentOut("area-depth", config);
+  commentOut("backbone-area", config);
 
   BOOST_REQUIRE(processConfigurationString(config));
 
@@ -286,6 +435,41 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   BOOST_CHECK_EQUAL(conf.getLsaInterestLifetime(),
                     static_cast<ndn::time::seconds>(LSA_INTEREST_LIFETIME_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), (2 * conf.getLsaRefreshTime()));
+  BOOST_CHECK_EQUAL(conf.getMLWeeklyPatterns(), false);
+  BOOST_CHECK_EQUAL(conf.getMLRoutePrecompute(), false);
+  BOOST_CHECK_EQUAL(conf.getLsaFetchWindow(), static_cast<uint32_t>(LSA_FETCH_WINDOW_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLsaFetchRate(), static_cast<uint32_t>(LSA_FETCH_RATE_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getAdjLsaDelta(), false);
+  BOOST_CHECK_EQUAL(conf.getNameLsaCompression(), false);
+  BOOST_CHECK_EQUAL(conf.getManagementThread(), false);
+  BOOST_CHECK_EQUAL(conf.getAsyncLogging(), false);
+  BOOST_CHECK_EQUAL(conf.getLsaSegmentStorageLimit(),
+                    static_cast<uint32_t>(LSA_SEGMENT_STORAGE_LIMIT_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getNameLsaBuildInterval(),
+                    ndn::time::milliseconds(NAME_LSA_BUILD_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getSyncPublishHoldDown(),
+                    ndn::time::milliseconds(SYNC_PUBLISH_HOLD_DOWN_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getSyncInlineLsaSize(),
+                    static_cast<uint32_t>(SYNC_INLINE_LSA_SIZE_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getSyncExpectedRouters(),
+                    static_cast<uint32_t>(SYNC_EXPECTED_ROUTERS_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLsaMinArrival(), ndn::time::milliseconds(LSA_MIN_ARRIVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLsaMaxNamePrefixes(), static_cast<uint32_t>(LSA_MAX_ENTRIES_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLsaMaxAdjacencies(), static_cast<uint32_t>(LSA_MAX_ENTRIES_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLsdbSnapshotInterval(),
+                    static_cast<uint32_t>(LSDB_SNAPSHOT_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLsaSegmentSize(), static_cast<uint32_t>(LSA_SEGMENT_SIZE_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getVerificationThreads(),
+                    static_cast<uint32_t>(VERIFICATION_THREADS_DEFAULT));
+  BOOST_CHECK(conf.getSigningKeyType() == SigningKeyType::ECDSA);
+  BOOST_CHECK_EQUAL(conf.getMetricsExportSocketPath(), "");
+  BOOST_CHECK_EQUAL(conf.getMetricsExportPort(), METRICS_EXPORT_PORT_DEFAULT);
+  BOOST_CHECK_EQUAL(conf.getEventStreamSocketPath(), "");
+  BOOST_CHECK_EQUAL(conf.getSharedStateExport(), false);
+  BOOST_CHECK_EQUAL(conf.getCertPrefetch(), false);
+  BOOST_CHECK_EQUAL(conf.getAreaDepth(), 0);
+  BOOST_CHECK(conf.getBackboneArea().empty());
+  BOOST_CHECK(conf.getArea().empty());
 
   BOOST_CHECK_NE(conf.m_confFileName, conf.getConfFileNameDynamic());
   conf.m_confFileName = "/tmp/nlsr.conf";
@@ -301,6 +485,27 @@ BOOST_AUTO_TEST_CASE(DefaultValuesNeighbors)
   commentOut("hello-timeout", config);
   commentOut("hello-interval", config);
   commentOut("first-hello-interval", config);
+  commentOut("rtt-source", config);
+  commentOut("rtt-probe-interval-min", config);
+  commentOut("rtt-probe-interval-max", config);
+  commentOut("cost-update-window", config);
+  commentOut("cost-damping", config);
+  commentOut("cost-damping-half-life", config);
+  commentOut("cost-damping-suppress", config);
+  commentOut("cost-damping-reuse", config);
+  commentOut("rtt-spike-filter", config);
+  commentOut("cost-buckets", config);
+  commentOut("cost-advertise-threshold", config);
+  commentOut("cost-advertise-hold", config);
+  commentOut("cost-metric", config);
+  commentOut("metrics-socket", config);
+  commentOut("link-sample-trace", config);
+  commentOut("face-counter-interval", config);
+  commentOut("link-bandwidth", config);
+  commentOut("hello-interval-cap", config);
+  commentOut("hello-signature-reuse", config);
+  commentOut("liveness-interval", config);
+  commentOut("liveness-multiplier", config);
   commentOut("adj-lsa-build-interval", config);
 
   BOOST_REQUIRE(processConfigurationString(config));
@@ -308,6 +513,35 @@ BOOST_AUTO_TEST_CASE(DefaultValuesNeighbors)
   BOOST_CHECK_EQUAL(conf.getInterestRetryNumber(), static_cast<uint32_t>(HELLO_RETRIES_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getInterestResendTime(), static_cast<uint32_t>(HELLO_TIMEOUT_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getInfoInterestInterval(), static_cast<uint32_t>(HELLO_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getHelloIntervalCap(), static_cast<uint32_t>(HELLO_INTERVAL_CAP_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getHelloSignatureReuse(),
+                    ndn::time::seconds(HELLO_SIGNATURE_REUSE_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLivenessInterval(), ndn::time::milliseconds(LIVENESS_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLivenessMultiplier(),
+                    static_cast<uint32_t>(LIVENESS_MULTIPLIER_DEFAULT));
+  BOOST_CHECK(conf.getRttSource() == RttSource::PROBE);
+  BOOST_CHECK_EQUAL(conf.getRttProbeIntervalMin(),
+                    static_cast<uint32_t>(RTT_PROBE_INTERVAL_MIN_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRttProbeIntervalMax(),
+                    static_cast<uint32_t>(RTT_PROBE_INTERVAL_MAX_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getCostUpdateWindow(), static_cast<uint32_t>(COST_UPDATE_WINDOW_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getCostDamping(), false);
+  BOOST_CHECK_EQUAL(conf.getCostDampingHalfLife(),
+                    static_cast<uint32_t>(COST_DAMPING_HALF_LIFE_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getCostDampingSuppress(),
+                    static_cast<uint32_t>(COST_DAMPING_SUPPRESS_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getCostDampingReuse(), static_cast<uint32_t>(COST_DAMPING_REUSE_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRttSpikeFilter(), static_cast<uint32_t>(RTT_SPIKE_FILTER_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getCostBuckets(), static_cast<uint32_t>(COST_BUCKETS_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getCostAdvertiseThreshold(),
+                    static_cast<uint32_t>(COST_ADVERTISE_THRESHOLD_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getCostAdvertiseHold(), static_cast<uint32_t>(COST_ADVERTISE_HOLD_DEFAULT));
+  BOOST_CHECK(conf.getCostMetric() == CostMetric::RTT);
+  BOOST_CHECK_EQUAL(conf.getMetricsSocketPath(), "");
+  BOOST_CHECK_EQUAL(conf.getLinkSampleTracePath(), "");
+  BOOST_CHECK_EQUAL(conf.getFaceCounterInterval(),
+                    static_cast<uint32_t>(FACE_COUNTER_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getLinkBandwidth(), static_cast<uint32_t>(LINK_BANDWIDTH_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getAdjLsaBuildInterval(),
                     static_cast<uint32_t>(ADJ_LSA_BUILD_INTERVAL_DEFAULT));
 }
@@ -344,6 +578,17 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
 
   commentOut("max-faces-per-prefix", config);
   commentOut("routing-calc-interval", config);
+  commentOut("routing-calc-threads", config);
+  commentOut("routing-calc-async", config);
+  commentOut("routing-calc-shadow", config);
+  commentOut("loop-free-alternates", config);
+  commentOut("disjoint-multipath", config);
+  commentOut("weighted-multipath", config);
+  commentOut("routing-calc-throttle", config);
+  commentOut("routing-calc-initial-delay", config);
+  commentOut("routing-calc-hold-time", config);
+  commentOut("routing-calc-neighbor-down", config);
+  commentOut("fib-command-window", config);
 
   BOOST_REQUIRE(processConfigurationString(config));
 
@@ -351,6 +596,21 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
                     static_cast<uint32_t>(MAX_FACES_PER_PREFIX_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(),
                     static_cast<uint32_t>(ROUTING_CALC_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcThreads(),
+                    static_cast<uint32_t>(ROUTING_CALC_THREADS_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcAsync(), false);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcShadow(), false);
+  BOOST_CHECK_EQUAL(conf.getLoopFreeAlternates(), false);
+  BOOST_CHECK(conf.getDisjointPaths() == DisjointPaths::NONE);
+  BOOST_CHECK_EQUAL(conf.getWeightedMultipath(), false);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcThrottle(), false);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialDelay(),
+                    static_cast<uint32_t>(ROUTING_CALC_INITIAL_DELAY_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcHoldTime(),
+                    static_cast<uint32_t>(ROUTING_CALC_HOLD_TIME_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcNeighborDown(), false);
+  BOOST_CHECK_EQUAL(conf.getFibCommandWindow(),
+                    static_cast<uint32_t>(FIB_COMMAND_WINDOW_DEFAULT));
 }
 
 BOOST_AUTO_TEST_CASE(DefaultValuesHyperbolic)
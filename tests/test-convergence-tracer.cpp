@@ -0,0 +1,185 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "convergence-tracer.hpp"
+#include "tlv-nlsr.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/clock-fixture.hpp"
+
+#include <sstream>
+
+namespace nlsr::tests {
+
+using Stage = ConvergenceStage;
+
+class ConvergenceTracerFixture : public ClockFixture
+{
+public:
+  std::vector<Stage>
+  getStages(uint64_t traceId) const
+  {
+    std::vector<Stage> stages;
+    for (const auto& event : tracer.getEvents()) {
+      if (event.traceId == traceId) {
+        stages.push_back(event.stage);
+      }
+    }
+    return stages;
+  }
+
+public:
+  ConvergenceTracer tracer;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestConvergenceTracer, ConvergenceTracerFixture)
+
+BOOST_AUTO_TEST_CASE(LocalAdjacencyChange)
+{
+  auto traceId = tracer.begin(Stage::HELLO_TIMEOUT, "/ndn/site/%C1.Router/b",
+                              ConvergenceTracer::LOCAL_ADJACENCY_PATH);
+  BOOST_CHECK_EQUAL(tracer.getOpenTraceCount(), 1);
+
+  // a calculation before the Adj LSA build is not part of the trace
+  tracer.record(Stage::CALCULATION);
+  tracer.record(Stage::ADJ_LSA_BUILD);
+  advanceClocks(10_ms);
+  tracer.record(Stage::SYNC_PUBLISH, "/localhop/ndn/nlsr/LSA/site/%C1.Router/a/ADJACENCY/%02");
+  tracer.record(Stage::CALCULATION);
+
+  std::shared_ptr<void> ribCommand;
+  {
+    ConvergenceTracer::NptUpdateScope scope(&tracer);
+    ribCommand = tracer.getFibInstall();
+    BOOST_CHECK(ribCommand != nullptr);
+  }
+  BOOST_CHECK(tracer.getFibInstall() == nullptr);
+  BOOST_CHECK_EQUAL(tracer.getOpenTraceCount(), 0);
+  BOOST_CHECK_EQUAL(getStages(traceId).back(), Stage::NPT_UPDATE);
+
+  // recorded once NFD answers the last command
+  ribCommand.reset();
+  std::vector<Stage> expected{Stage::HELLO_TIMEOUT, Stage::ADJ_LSA_BUILD, Stage::SYNC_PUBLISH,
+                              Stage::CALCULATION, Stage::NPT_UPDATE, Stage::FIB_INSTALL};
+  auto stages = getStages(traceId);
+  BOOST_CHECK_EQUAL_COLLECTIONS(stages.begin(), stages.end(), expected.begin(), expected.end());
+
+  const auto& events = tracer.getEvents();
+  BOOST_CHECK_EQUAL(events.front().subject, "/ndn/site/%C1.Router/b");
+  BOOST_CHECK_EQUAL(events[2].time - events[1].time, 10_ms);
+}
+
+BOOST_AUTO_TEST_CASE(RemotePrefixChange)
+{
+  auto traceId = tracer.begin(Stage::LSA_RECEIVED,
+                              "/localhop/ndn/nlsr/LSA/site/%C1.Router/b/NAME/%05",
+                              ConvergenceTracer::REMOTE_PREFIX_PATH);
+  tracer.record(Stage::LSA_INSTALL);
+  {
+    // no RIB command: the FIB install is recorded at the end of the update
+    ConvergenceTracer::NptUpdateScope scope(&tracer);
+    BOOST_CHECK_EQUAL(getStages(traceId).size(), 3);
+  }
+  BOOST_CHECK_EQUAL(getStages(traceId).size(), 4);
+  BOOST_CHECK_EQUAL(getStages(traceId).back(), Stage::FIB_INSTALL);
+
+  // a scope without tracer does nothing
+  ConvergenceTracer::NptUpdateScope scope(nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(Reroute)
+{
+  auto local = tracer.begin(Stage::COST_CHANGE, "/ndn/site/%C1.Router/b",
+                            ConvergenceTracer::LOCAL_ADJACENCY_PATH);
+  auto unchanged = tracer.begin(Stage::COST_CHANGE, "/ndn/site/%C1.Router/c",
+                                ConvergenceTracer::LOCAL_ADJACENCY_PATH);
+  tracer.reroute(local, ConvergenceTracer::LOCAL_ROUTING_PATH);
+  tracer.reroute(unchanged, 0);
+  BOOST_CHECK_EQUAL(tracer.getOpenTraceCount(), 1);
+
+  tracer.record(Stage::CALCULATION);
+  BOOST_CHECK_EQUAL(getStages(local).size(), 2);
+  BOOST_CHECK_EQUAL(getStages(unchanged).size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Expiration)
+{
+  tracer.begin(Stage::PREFIX_COMMAND, "/ndn/app", ConvergenceTracer::LOCAL_PREFIX_PATH);
+  advanceClocks(ConvergenceTracer::TRACE_TIMEOUT + 1_s);
+  tracer.record(Stage::NAME_LSA_BUILD);
+  BOOST_CHECK_EQUAL(tracer.getOpenTraceCount(), 0);
+  BOOST_CHECK_EQUAL(tracer.getEvents().size(), 1);
+
+  for (size_t i = 0; i < ConvergenceTracer::MAX_OPEN_TRACES + 10; ++i) {
+    tracer.begin(Stage::PREFIX_COMMAND, "/ndn/app", ConvergenceTracer::LOCAL_PREFIX_PATH);
+  }
+  tracer.record(Stage::NAME_LSA_BUILD);
+  BOOST_CHECK_EQUAL(tracer.getOpenTraceCount(), ConvergenceTracer::MAX_OPEN_TRACES);
+}
+
+BOOST_AUTO_TEST_CASE(BoundedRing)
+{
+  for (size_t i = 0; i < ConvergenceTracer::MAX_EVENTS + 5; ++i) {
+    tracer.begin(Stage::HELLO_TIMEOUT, "/ndn/site/%C1.Router/b", 0);
+  }
+  BOOST_CHECK_EQUAL(tracer.getEvents().size(), ConvergenceTracer::MAX_EVENTS);
+  BOOST_CHECK_EQUAL(tracer.getEvents().front().traceId, 6);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  auto time = ndn::time::fromUnixTimestamp(1700000000123_ms);
+  ConvergenceTraceEvent event(42, Stage::SYNC_PUBLISH, time, "/localhop/ndn/nlsr/LSA/a/NAME/%03");
+  ConvergenceTraceEvent decoded(event.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.traceId, 42);
+  BOOST_CHECK_EQUAL(decoded.stage, Stage::SYNC_PUBLISH);
+  BOOST_CHECK(decoded.time == time);
+  BOOST_CHECK_EQUAL(decoded.subject, "/localhop/ndn/nlsr/LSA/a/NAME/%03");
+
+  ConvergenceTraceEvent noSubject(7, Stage::FIB_INSTALL, time, {});
+  noSubject = ConvergenceTraceEvent(noSubject.wireEncode());
+  BOOST_CHECK(noSubject.subject.empty());
+
+  BOOST_CHECK_THROW(ConvergenceTraceEvent(ndn::Block(nlsr::tlv::ConvergenceTraceEvent)),
+                    ConvergenceTraceEvent::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ChromeTrace)
+{
+  auto time = ndn::time::fromUnixTimestamp(1700000000000_ms);
+  std::vector<ConvergenceTraceEvent> events{
+    {3, Stage::LSA_RECEIVED, time, "/a/b c"},
+    {3, Stage::LSA_INSTALL, time + 250_us, {}},
+  };
+  std::ostringstream os;
+  ConvergenceTracer::writeChromeTrace(os, events);
+  BOOST_CHECK_EQUAL(os.str(),
+    "{\"traceEvents\":[\n"
+    "{\"name\":\"lsa-received\",\"ph\":\"i\",\"s\":\"t\",\"ts\":1700000000000000,\"pid\":1,"
+    "\"tid\":3,\"args\":{\"subject\":\"/a/b%20c\"}},\n"
+    "{\"name\":\"lsa-install\",\"ph\":\"X\",\"ts\":1700000000000000,\"dur\":250,\"pid\":1,"
+    "\"tid\":3}\n"
+    "]}\n");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cost-flap-damping.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+using namespace ndn::time_literals;
+
+BOOST_AUTO_TEST_SUITE(TestCostFlapDamping)
+
+BOOST_AUTO_TEST_CASE(SuppressAndReuse)
+{
+  CostFlapDamping damping(60_s, 3000, 750);
+  CostFlapDamping::State state;
+  ndn::time::steady_clock::time_point now;
+
+  // three changes within seconds decay to just below the suppress threshold
+  BOOST_CHECK(!damping.recordChange(state, now));
+  BOOST_CHECK(!damping.recordChange(state, now + 1_s));
+  BOOST_CHECK(!damping.recordChange(state, now + 2_s));
+  BOOST_CHECK(damping.recordChange(state, now + 3_s));
+  BOOST_CHECK_GT(state.penalty, 3000);
+
+  // the penalty halves every minute; suppression ends below the reuse threshold
+  BOOST_CHECK(damping.update(state, now + 60_s));
+  BOOST_CHECK(damping.update(state, now + 120_s));
+  BOOST_CHECK(!damping.update(state, now + 150_s));
+  BOOST_CHECK_LT(state.penalty, 750);
+}
+
+BOOST_AUTO_TEST_CASE(MaxPenalty)
+{
+  CostFlapDamping damping(60_s, 3000, 750);
+  CostFlapDamping::State state;
+  ndn::time::steady_clock::time_point now;
+
+  for (int i = 0; i < 100; ++i) {
+    damping.recordChange(state, now);
+  }
+  BOOST_CHECK_CLOSE(state.penalty, 750.0 * 16, 0.001);
+
+  // released after MAX_SUPPRESS_HALF_LIVES half-lives
+  BOOST_CHECK(damping.update(state, now + 239_s));
+  BOOST_CHECK(!damping.update(state, now + 241_s));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "cost-quantizer.hpp"
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestCostQuantizer)
+
+BOOST_AUTO_TEST_CASE(Levels)
+{
+  CostQuantizer quantizer(16, 2.0);
+
+  BOOST_CHECK_EQUAL(quantizer.getCost(100, 0), 100);
+  BOOST_CHECK_EQUAL(quantizer.getCost(100, 5), 126);
+  BOOST_CHECK_EQUAL(quantizer.getCost(100, 15), 200);
+  BOOST_CHECK_EQUAL(quantizer.getCost(100, 20), 200);
+
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 100, std::nullopt), 0);
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 80, std::nullopt), 0);
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 126, std::nullopt), 5);
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 200, std::nullopt), 15);
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 500, std::nullopt), 15);
+}
+
+BOOST_AUTO_TEST_CASE(Hysteresis)
+{
+  CostQuantizer quantizer(16, 2.0);
+
+  // 129.5 lies past the midpoint between levels 5 and 6
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 129.5, std::nullopt), 6);
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 129.5, 5), 5);
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 131, 5), 6);
+
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 122, 5), 5);
+  BOOST_CHECK_EQUAL(quantizer.getLevel(100, 120, 5), 4);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,65 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "tests/emulated-network.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_FIXTURE_TEST_SUITE(TestEmulatedNetwork, EmulatedNetwork)
+
+BOOST_AUTO_TEST_CASE(ConvergeAndPartition)
+{
+  auto configure = [] (ConfParameter& conf) {
+    conf.setInfoInterestInterval(30);
+    conf.setAdjLsaBuildInterval(1);
+    conf.setRoutingCalcInterval(1);
+  };
+  for (int i = 0; i < 3; ++i) {
+    addRouter(configure);
+  }
+  addLink(0, 1, 10);
+  addLink(1, 2, 10);
+  start();
+
+  advanceClocks(10_ms, 120_s);
+  BOOST_CHECK(isConverged());
+  BOOST_CHECK_EQUAL(getNlsr(0).m_routingTable.getRoutingTableEntry().size(), 2);
+  BOOST_CHECK_GT(getStatistics().nInterests[CATEGORY_NEIGHBOR], 0);
+  BOOST_CHECK_GT(getStatistics().nData[CATEGORY_LSA], 0);
+  BOOST_CHECK_EQUAL(getStatistics().nLost, 0);
+  BOOST_CHECK_GT(getCpuTime(0).count(), 0);
+
+  auto failure = ndn::time::steady_clock::now();
+  resetStatistics();
+  setLinkUp(1, 2, false);
+  advanceClocks(10_ms, 120_s);
+  BOOST_CHECK(isConverged());
+  BOOST_CHECK_EQUAL(getNlsr(0).m_routingTable.getRoutingTableEntry().size(), 1);
+  BOOST_CHECK(getNlsr(2).m_routingTable.getRoutingTableEntry().empty());
+  BOOST_CHECK(getLastRouteChange(0) > failure);
+  BOOST_CHECK_GT(getStatistics().nLost, 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,102 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "face-counter-collector.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/boost-test.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+namespace nlsr::tests {
+
+class FaceCounterCollectorFixture : public IoKeyChainFixture
+{
+public:
+  FaceCounterCollectorFixture()
+    : face(m_io, m_keyChain)
+    , collector(face, m_keyChain, 5_s,
+                [] (uint64_t faceId) { return faceId != 999; },
+                [] (const auto&) {})
+  {
+  }
+
+  static ndn::nfd::FaceStatus
+  makeFaceStatus(uint64_t faceId, uint64_t nOutBytes, uint64_t nOutInterests, uint64_t nInData)
+  {
+    ndn::nfd::FaceStatus status;
+    status.setFaceId(faceId)
+          .setNOutBytes(nOutBytes)
+          .setNOutInterests(nOutInterests)
+          .setNInData(nInData);
+    return status;
+  }
+
+public:
+  ndn::DummyClientFace face;
+  FaceCounterCollector collector;
+  FaceCounterCollector::TimePoint start = ndn::time::steady_clock::now();
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestFaceCounterCollector, FaceCounterCollectorFixture)
+
+BOOST_AUTO_TEST_CASE(Rates)
+{
+  // the first dataset only sets the baseline
+  auto loads = collector.processDataset({makeFaceStatus(300, 1000, 100, 100),
+                                         makeFaceStatus(999, 0, 0, 0)}, start);
+  BOOST_CHECK(loads.empty());
+
+  loads = collector.processDataset({makeFaceStatus(300, 126000, 200, 180),
+                                    makeFaceStatus(999, 1000, 100, 0)}, start + 5_s);
+  BOOST_REQUIRE_EQUAL(loads.size(), 1);
+  BOOST_CHECK_EQUAL(loads[0].faceId, 300);
+  BOOST_CHECK_CLOSE(loads[0].outBitRate, 200000, 1e-6);
+  BOOST_REQUIRE(loads[0].lossRate.has_value());
+  BOOST_CHECK_CLOSE(*loads[0].lossRate, 0.2, 1e-6);
+
+  // too few Interests for a loss rate
+  loads = collector.processDataset({makeFaceStatus(300, 126000, 205, 185)}, start + 10_s);
+  BOOST_REQUIRE_EQUAL(loads.size(), 1);
+  BOOST_CHECK_EQUAL(loads[0].outBitRate, 0);
+  BOOST_CHECK(!loads[0].lossRate);
+}
+
+BOOST_AUTO_TEST_CASE(Reset)
+{
+  collector.processDataset({makeFaceStatus(300, 5000, 100, 100)}, start);
+
+  // counters went backwards, e.g. the face was recreated with the same ID
+  auto loads = collector.processDataset({makeFaceStatus(300, 1000, 10, 10)}, start + 5_s);
+  BOOST_CHECK(loads.empty());
+  loads = collector.processDataset({makeFaceStatus(300, 2000, 10, 10)}, start + 10_s);
+  BOOST_REQUIRE_EQUAL(loads.size(), 1);
+  BOOST_CHECK_CLOSE(loads[0].outBitRate, 1600, 1e-6);
+
+  // a face that disappeared from the dataset is forgotten
+  collector.processDataset({}, start + 15_s);
+  loads = collector.processDataset({makeFaceStatus(300, 3000, 10, 10)}, start + 20_s);
+  BOOST_CHECK(loads.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestFaceCounterCollector
+
+} // namespace nlsr::tests
@@ -148,6 +148,93 @@ BOOST_AUTO_TEST_CASE(CheckHelloDataValidatedSignal) // # 5157
   BOOST_CHECK_EQUAL(adjList.getStatusOfNeighbor(adj1.getName()), Adjacent::STATUS_ACTIVE);
 }
 
+BOOST_AUTO_TEST_CASE(CountControlTraffic)
+{
+  helloProtocol.sendHelloInterest(ndn::Name(ACTIVE_NEIGHBOR));
+  this->advanceClocks(10_ms);
+  BOOST_REQUIRE_EQUAL(checkHelloInterests(ACTIVE_NEIGHBOR), 1);
+
+  auto id = *adjList.getNeighborId(ACTIVE_NEIGHBOR);
+  BOOST_REQUIRE(adjList.getControlTraffic(id) != nullptr);
+  const auto& hello = adjList.getControlTraffic(id)->get(ControlTraffic::MessageClass::HELLO);
+  BOOST_CHECK_EQUAL(hello.nInterestsSent, 1);
+  BOOST_CHECK_GT(hello.nBytesSent, 0);
+}
+
+BOOST_AUTO_TEST_CASE(HelloInterestName)
+{
+  auto makeInterestName = [&] (const ndn::Name& neighbor) {
+    ndn::Name name(neighbor);
+    name.append(HelloProtocol::NLSR_COMPONENT);
+    name.append(HelloProtocol::INFO_COMPONENT);
+    name.append(ndn::tlv::GenericNameComponent, conf.getRouterPrefix().wireEncode());
+    return name;
+  };
+
+  auto id = *adjList.getNeighborId(ACTIVE_NEIGHBOR);
+  BOOST_CHECK_EQUAL(helloProtocol.getHelloInterestName(id, ACTIVE_NEIGHBOR),
+                    makeInterestName(ACTIVE_NEIGHBOR));
+
+  // A neighbor that gets the ID of a former one after a reset gets its own name
+  adjList.reset();
+  ndn::Name other("/ndn/site/%C1.Router/router-other");
+  adjList.insert(Adjacent(other, ndn::FaceUri("udp4://10.0.0.2:6363"), 10,
+                          Adjacent::STATUS_ACTIVE, 0, 301));
+  BOOST_REQUIRE_EQUAL(*adjList.getNeighborId(other), id);
+  BOOST_CHECK_EQUAL(helloProtocol.getHelloInterestName(id, other), makeInterestName(other));
+}
+
+BOOST_AUTO_TEST_CASE(HelloSignatureReuse)
+{
+  ndn::Name interestName(conf.getRouterPrefix());
+  interestName.append(HelloProtocol::NLSR_COMPONENT);
+  interestName.append(HelloProtocol::INFO_COMPONENT);
+  interestName.append(ndn::tlv::GenericNameComponent, ndn::Name(ACTIVE_NEIGHBOR).wireEncode());
+
+  // Each reply is signed by default
+  auto reply1 = helloProtocol.makeHelloReply(interestName, ACTIVE_NEIGHBOR);
+  this->advanceClocks(10_ms);
+  auto reply2 = helloProtocol.makeHelloReply(interestName, ACTIVE_NEIGHBOR);
+  BOOST_CHECK(reply1 != reply2);
+
+  conf.setHelloSignatureReuse(60);
+  auto reply3 = helloProtocol.makeHelloReply(interestName, ACTIVE_NEIGHBOR);
+  this->advanceClocks(30_s);
+  BOOST_CHECK(helloProtocol.makeHelloReply(interestName, ACTIVE_NEIGHBOR) == reply3);
+
+  this->advanceClocks(30_s);
+  auto reply4 = helloProtocol.makeHelloReply(interestName, ACTIVE_NEIGHBOR);
+  BOOST_CHECK(reply4 != reply3);
+  BOOST_CHECK_EQUAL(reply4->getName().getPrefix(-1), interestName);
+}
+
+BOOST_AUTO_TEST_CASE(AdaptiveHelloInterval)
+{
+  auto helloData = [&] {
+    ndn::Name name(ACTIVE_NEIGHBOR);
+    name.append(HelloProtocol::NLSR_COMPONENT);
+    name.append(HelloProtocol::INFO_COMPONENT);
+    name.append(ndn::tlv::GenericNameComponent, conf.getRouterPrefix().wireEncode());
+    return ndn::Data(name.appendVersion());
+  };
+  auto id = *adjList.getNeighborId(ACTIVE_NEIGHBOR);
+
+  // No back-off without a cap
+  helloProtocol.onContentValidated(helloData());
+  BOOST_CHECK_EQUAL(helloProtocol.getHelloInterval(id), 60_s);
+
+  conf.setHelloIntervalCap(200);
+  helloProtocol.onContentValidated(helloData());
+  BOOST_CHECK_EQUAL(helloProtocol.getHelloInterval(id), 120_s);
+  helloProtocol.onContentValidated(helloData());
+  BOOST_CHECK_EQUAL(helloProtocol.getHelloInterval(id), 200_s);
+
+  // A timeout brings the neighbor back to the fast rate at once
+  helloProtocol.sendHelloInterest(ndn::Name(ACTIVE_NEIGHBOR));
+  this->advanceClocks(10_ms, 200);
+  BOOST_CHECK_EQUAL(helloProtocol.getHelloInterval(id), 60_s);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -0,0 +1,82 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "latency-statistics.hpp"
+#include "tlv-nlsr.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+using namespace ndn::time_literals;
+
+BOOST_AUTO_TEST_SUITE(TestLatencyStatistics)
+
+BOOST_AUTO_TEST_CASE(RecordAndReset)
+{
+  LatencyStatistics latency;
+  BOOST_CHECK(latency.getStatus().getStages().empty());
+
+  for (int i = 0; i < 99; ++i) {
+    latency.record(LatencyStatistics::STAGE_FETCH_ADJACENCY_LSA, 10_ms);
+  }
+  latency.record(LatencyStatistics::STAGE_FETCH_ADJACENCY_LSA, 200_ms);
+  latency.record(LatencyStatistics::STAGE_RIB_REGISTER, 2_ms);
+
+  auto status = latency.getStatus();
+  // only the stages with samples, in the order of the stages
+  BOOST_REQUIRE_EQUAL(status.getStages().size(), 2);
+  const auto& fetch = status.getStages()[0];
+  BOOST_CHECK_EQUAL(fetch.stage, "fetch-adjacency-lsa");
+  BOOST_CHECK_EQUAL(fetch.count, 100);
+  BOOST_CHECK_GE(fetch.p99.count(), 10000 * 7 / 8);
+  BOOST_CHECK_LE(fetch.p99.count(), 10000 * 9 / 8);
+  BOOST_CHECK_EQUAL(fetch.max.count(), 200000);
+  BOOST_CHECK_EQUAL(status.getStages()[1].stage, "rib-register");
+
+  latency.resetAll();
+  BOOST_CHECK_EQUAL(latency.get(LatencyStatistics::STAGE_FETCH_ADJACENCY_LSA).getCount(), 0);
+  BOOST_CHECK(latency.getStatus().getStages().empty());
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  LatencyStatus status;
+  status.addStage({"validate-segment", 7, 300_us, 900_us, 1200_us, 1500_us});
+  status.addStage({"sync-to-install", 3, 20_ms, 40_ms, 45_ms, 50_ms});
+
+  LatencyStatus decoded(status.wireEncode());
+  BOOST_REQUIRE_EQUAL(decoded.getStages().size(), 2);
+  const auto& validation = decoded.getStages()[0];
+  BOOST_CHECK_EQUAL(validation.stage, "validate-segment");
+  BOOST_CHECK_EQUAL(validation.count, 7);
+  BOOST_CHECK_EQUAL(validation.median.count(), 300);
+  BOOST_CHECK_EQUAL(validation.p90.count(), 900);
+  BOOST_CHECK_EQUAL(validation.p99.count(), 1200);
+  BOOST_CHECK_EQUAL(validation.max.count(), 1500);
+  BOOST_CHECK_EQUAL(decoded.getStages()[1].max.count(), 50000);
+
+  BOOST_CHECK_THROW(LatencyStatus(ndn::Block(nlsr::tlv::CalculationProfile)), LatencyStatus::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
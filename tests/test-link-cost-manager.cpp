@@ -0,0 +1,449 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "link-cost-manager.hpp"
+#include "nlsr.hpp"
+#include "route/load-aware-routing-calculator.hpp"
+#include "route/ml-adaptive-calculator.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/mgmt/control-response.hpp>
+
+#include <cmath>
+
+namespace nlsr::tests {
+
+class LinkCostManagerFixture : public IoKeyChainFixture
+{
+public:
+  LinkCostManagerFixture()
+    : face(m_io, m_keyChain, {true, true})
+    , conf(face, m_keyChain)
+    , confProcessor(conf)
+    , adjList(conf.getAdjacencyList())
+    , nlsr(face, m_keyChain, conf)
+    , linkCostManager(nlsr.getLinkCostManager())
+  {
+    ndn::FaceUri faceUri("udp4://10.0.0.1:6363");
+    Adjacent adj1(ACTIVE_NEIGHBOR, faceUri, 10, Adjacent::STATUS_ACTIVE, 0, 300);
+    adjList.insert(adj1);
+
+    this->advanceClocks(10_ms);
+    face.sentData.clear();
+  }
+
+public:
+  const ndn::Name ACTIVE_NEIGHBOR = "/ndn/site/%C1.Router/router-active";
+
+  ndn::DummyClientFace face;
+  ConfParameter conf;
+  DummyConfFileProcessor confProcessor;
+  AdjacencyList& adjList;
+  Nlsr nlsr;
+  LinkCostManager& linkCostManager;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestLinkCostManager, LinkCostManagerFixture)
+
+BOOST_AUTO_TEST_CASE(RttProbeReply)
+{
+  ndn::Name probeName(conf.getRouterPrefix());
+  probeName.append("link-cost").append("rtt-probe");
+
+  for (int seq = 1; seq <= 2; ++seq) {
+    face.receive(ndn::Interest(ndn::Name(probeName).append(std::to_string(seq))));
+    this->advanceClocks(10_ms);
+  }
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  for (int seq = 1; seq <= 2; ++seq) {
+    const auto& data = face.sentData.at(seq - 1);
+    BOOST_CHECK_EQUAL(data.getName(), ndn::Name(probeName).append(std::to_string(seq)));
+    BOOST_CHECK_EQUAL(data.getSignatureType(), ndn::tlv::DigestSha256);
+    BOOST_CHECK_EQUAL(data.getFreshnessPeriod(), 1_s);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(HelloRttSamples)
+{
+  linkCostManager.initialize();
+  linkCostManager.start();
+
+  // Hello round trips are ignored while probes are the RTT source
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 20_ms);
+  BOOST_REQUIRE(linkCostManager.getRttEstimator(ACTIVE_NEIGHBOR) != nullptr);
+  BOOST_CHECK_EQUAL(linkCostManager.getRttEstimator(ACTIVE_NEIGHBOR)->getSampleCount(), 0);
+
+  conf.setRttSource(RttSource::HELLO);
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 20_ms);
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 30_ms);
+  BOOST_CHECK_EQUAL(linkCostManager.getRttEstimator(ACTIVE_NEIGHBOR)->getSampleCount(), 2);
+
+  // no probe is sent when Hello round trips are the only RTT source
+  this->advanceClocks(1_s, 40);
+  for (const auto& interest : face.sentInterests) {
+    BOOST_CHECK(interest.getName().toUri().find("rtt-probe") == std::string::npos);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CoalescedCostUpdates)
+{
+  const ndn::Name OTHER_NEIGHBOR = "/ndn/site/%C1.Router/router-other";
+  Adjacent adj2(OTHER_NEIGHBOR, ndn::FaceUri("udp4://10.0.0.2:6363"), 10,
+                Adjacent::STATUS_ACTIVE, 0, 301);
+  adjList.insert(adj2);
+
+  conf.setRttSource(RttSource::HELLO);
+  conf.setCostUpdateWindow(500);
+  linkCostManager.initialize();
+  linkCostManager.start();
+  auto adjBuildCount = nlsr.m_lsdb.m_adjBuildCount;
+
+  for (const auto& neighbor : {ACTIVE_NEIGHBOR, OTHER_NEIGHBOR}) {
+    linkCostManager.onHelloRttMeasured(neighbor, 200_ms);
+    linkCostManager.onHelloRttMeasured(neighbor, 200_ms);
+  }
+
+  // both changes wait for the end of the window
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 10);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(OTHER_NEIGHBOR).getLinkCost(), 10);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_adjBuildCount, adjBuildCount);
+
+  this->advanceClocks(100_ms, 5);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 20);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(OTHER_NEIGHBOR).getLinkCost(), 20);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_adjBuildCount, adjBuildCount + 1);
+  BOOST_CHECK(nlsr.m_lsdb.getIsBuildAdjLsaScheduled());
+}
+
+BOOST_AUTO_TEST_CASE(CostBuckets)
+{
+  const ndn::Name OTHER_NEIGHBOR = "/ndn/site/%C1.Router/router-other";
+  Adjacent adj2(OTHER_NEIGHBOR, ndn::FaceUri("udp4://10.0.0.2:6363"), 100,
+                Adjacent::STATUS_ACTIVE, 0, 301);
+  adjList.insert(adj2);
+
+  conf.setRttSource(RttSource::HELLO);
+  conf.setCostUpdateWindow(0);
+  conf.setCostBuckets(16);
+  linkCostManager.initialize();
+  linkCostManager.start();
+
+  // RTT-based cost 118 lies closest to level 4, i.e. 100 * 2^(4/15)
+  linkCostManager.onHelloRttMeasured(OTHER_NEIGHBOR, 20_ms);
+  linkCostManager.onHelloRttMeasured(OTHER_NEIGHBOR, 20_ms);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(OTHER_NEIGHBOR).getLinkCost(), 120);
+
+  // 117 would be rounded to level 3, but does not leave level 4 by more than the hysteresis
+  linkCostManager.onHelloRttMeasured(OTHER_NEIGHBOR, 10_ms);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(OTHER_NEIGHBOR).getLinkCost(), 120);
+
+  for (int i = 0; i < 20; ++i) {
+    linkCostManager.onHelloRttMeasured(OTHER_NEIGHBOR, 60_ms);
+  }
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(OTHER_NEIGHBOR).getLinkCost(), 145);
+}
+
+BOOST_AUTO_TEST_CASE(RttSpikes)
+{
+  conf.setRttSource(RttSource::HELLO);
+  conf.setCostUpdateWindow(0);
+  conf.setRttSpikeFilter(3);
+  linkCostManager.initialize();
+  linkCostManager.start();
+
+  for (int i = 0; i < 6; ++i) {
+    linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 20_ms);
+  }
+  const auto* estimator = linkCostManager.getRttEstimator(ACTIVE_NEIGHBOR);
+  BOOST_REQUIRE(estimator != nullptr);
+  BOOST_CHECK_EQUAL(estimator->getSampleCount(), 6);
+  auto cost = adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost();
+
+  // a single spike changes neither the RTT estimate nor the cost
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 2000_ms);
+  BOOST_CHECK_EQUAL(estimator->getSampleCount(), 6);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), cost);
+
+  // a sustained shift passes with its third sample
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 200_ms);
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 200_ms);
+  BOOST_CHECK_EQUAL(estimator->getSampleCount(), 6);
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 200_ms);
+  BOOST_CHECK_EQUAL(estimator->getSampleCount(), 7);
+  BOOST_CHECK_EQUAL(estimator->getHistory().back(), 200_ms);
+}
+
+BOOST_AUTO_TEST_CASE(AdaptiveProbeInterval)
+{
+  conf.setRttSource(RttSource::HELLO);
+  linkCostManager.initialize();
+  linkCostManager.start();
+  BOOST_CHECK(linkCostManager.getProbeInterval(ACTIVE_NEIGHBOR) == 2_s);
+
+  // the RTT variation is high while the estimator converges
+  for (int i = 0; i < 3; ++i) {
+    linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 20_ms);
+  }
+  BOOST_CHECK(linkCostManager.getProbeInterval(ACTIVE_NEIGHBOR) == 500_ms);
+
+  // a steady RTT backs off to rtt-probe-interval-max
+  for (int i = 0; i < 20; ++i) {
+    linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 20_ms);
+  }
+  BOOST_CHECK(linkCostManager.getProbeInterval(ACTIVE_NEIGHBOR) == 30_s);
+
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 200_ms);
+  BOOST_CHECK(linkCostManager.getProbeInterval(ACTIVE_NEIGHBOR) == 15_s);
+}
+
+BOOST_AUTO_TEST_CASE(LocalCostOverlay)
+{
+  conf.setRttSource(RttSource::HELLO);
+  conf.setCostUpdateWindow(0);
+  conf.setCostAdvertiseThreshold(50);
+  conf.setCostAdvertiseHold(10);
+  linkCostManager.initialize();
+  linkCostManager.start();
+  auto adjBuildCount = nlsr.m_lsdb.m_adjBuildCount;
+
+  // RTT-based cost 17 is used locally until it has persisted for cost-advertise-hold
+  for (int i = 0; i < 2; ++i) {
+    linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 100_ms);
+  }
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 10);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_adjBuildCount, adjBuildCount);
+  auto overlay = linkCostManager.getLocalCostOverlay();
+  BOOST_REQUIRE_EQUAL(overlay.size(), 1);
+  BOOST_CHECK_EQUAL(overlay[0].first, ACTIVE_NEIGHBOR);
+  BOOST_CHECK_EQUAL(overlay[0].second, 17);
+
+  this->advanceClocks(1_s, 11);
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 100_ms);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 17);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_adjBuildCount, adjBuildCount + 1);
+  BOOST_CHECK(linkCostManager.getLocalCostOverlay().empty());
+}
+
+BOOST_AUTO_TEST_CASE(MultiDimensionalCost)
+{
+  conf.setRttSource(RttSource::HELLO);
+  conf.setCostUpdateWindow(0);
+  conf.setCostMetric(CostMetric::MULTI_DIMENSIONAL);
+  linkCostManager.initialize();
+  linkCostManager.start();
+
+  // a saturated, lossy and weak link: 0.4 * 1.1 + 0.3 * 2 + 0.2 * 2 + 0.1 * 2
+  LinkCostManager::ExternalMetrics metrics;
+  metrics.bandwidthUtil = 1.0;
+  metrics.packetLoss = 0.5;
+  metrics.spectrumStrength = -80;
+  linkCostManager.setExternalMetrics(ACTIVE_NEIGHBOR, metrics);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 16);
+  BOOST_CHECK_EQUAL(linkCostManager.calculateMultiDimensionalCostPreview(ACTIVE_NEIGHBOR), 16);
+
+  // the link recovers
+  metrics.bandwidthUtil = 0.0;
+  metrics.packetLoss = 0.0;
+  metrics.spectrumStrength = -30;
+  linkCostManager.setExternalMetrics(ACTIVE_NEIGHBOR, metrics);
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 10);
+}
+
+BOOST_AUTO_TEST_CASE(FaceLoads)
+{
+  linkCostManager.initialize();
+
+  // without a known bandwidth only the loss rate is stored
+  linkCostManager.applyFaceLoads({{300, 50e6, 0.1}, {301, 50e6, 0.5}});
+  auto metrics = linkCostManager.getMetricsSnapshot(ACTIVE_NEIGHBOR);
+  BOOST_REQUIRE(metrics.has_value());
+  BOOST_CHECK(!metrics->bandwidthUtil);
+  BOOST_CHECK_EQUAL(metrics->packetLoss.value_or(0), 0.1);
+
+  conf.setLinkBandwidth(100);
+  linkCostManager.applyFaceLoads({{300, 50e6, std::nullopt}});
+  metrics = linkCostManager.getMetricsSnapshot(ACTIVE_NEIGHBOR);
+  BOOST_CHECK_EQUAL(metrics->bandwidthUtil.value_or(0), 0.5);
+  BOOST_CHECK_EQUAL(metrics->packetLoss.value_or(0), 0.1);
+
+  // a bandwidth set by an external agent takes precedence
+  LinkCostManager::ExternalMetrics external;
+  external.bandwidth = 1000;
+  linkCostManager.setExternalMetrics(ACTIVE_NEIGHBOR, external);
+  linkCostManager.applyFaceLoads({{300, 50e6, 0.0}});
+  metrics = linkCostManager.getMetricsSnapshot(ACTIVE_NEIGHBOR);
+  BOOST_CHECK_EQUAL(metrics->bandwidth.value_or(0), 1000);
+  BOOST_CHECK_CLOSE(metrics->bandwidthUtil.value_or(0), 0.05, 1e-6);
+  BOOST_CHECK_EQUAL(metrics->packetLoss.value_or(1), 0);
+}
+
+BOOST_AUTO_TEST_CASE(SeedLsaFetches)
+{
+  conf.setRttSource(RttSource::HELLO);
+  linkCostManager.initialize();
+  linkCostManager.start();
+  const auto& lsdb = nlsr.getLsdb();
+  const ndn::SegmentFetcher::Options defaults;
+
+  // without an RTT sample, fetches start from the defaults
+  ndn::SegmentFetcher::Options options;
+  lsdb.seedFetcherOptions(options, 300);
+  BOOST_CHECK_EQUAL(options.initCwnd, defaults.initCwnd);
+  BOOST_CHECK(options.rttOptions.initialRto == defaults.rttOptions.initialRto);
+
+  // SRTT 100 ms and RTTVAR 50 ms
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 100_ms);
+  options = {};
+  lsdb.seedFetcherOptions(options, 300);
+  BOOST_CHECK(options.rttOptions.initialRto == 300_ms);
+  BOOST_CHECK_EQUAL(options.initCwnd, 8.0);
+
+  // a lossy link
+  linkCostManager.applyFaceLoads({{300, 50e6, 0.1}});
+  options = {};
+  lsdb.seedFetcherOptions(options, 300);
+  BOOST_CHECK(options.rttOptions.initialRto == 300_ms);
+  BOOST_CHECK_EQUAL(options.initCwnd, 1.0);
+  BOOST_CHECK_EQUAL(options.initSsthresh, 1.0);
+
+  // not a neighbor's Face
+  options = {};
+  lsdb.seedFetcherOptions(options, 301);
+  BOOST_CHECK_EQUAL(options.initCwnd, defaults.initCwnd);
+}
+
+BOOST_AUTO_TEST_CASE(CostPolicy)
+{
+  conf.setRttSource(RttSource::HELLO);
+  conf.setCostUpdateWindow(0);
+  linkCostManager.initialize();
+  linkCostManager.start();
+  BOOST_CHECK(!linkCostManager.isLoadAwareModeEnabled());
+
+  {
+    LoadAwareRoutingCalculator calculator(linkCostManager);
+    BOOST_CHECK(linkCostManager.isLoadAwareModeEnabled());
+
+    for (int i = 0; i < 2; ++i) {
+      linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 300_ms);
+    }
+    // the RTT-based cost 20 is raised by the load-aware policy, up to 3 times the configured one
+    BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 30);
+  }
+  BOOST_CHECK(!linkCostManager.isLoadAwareModeEnabled());
+}
+
+BOOST_AUTO_TEST_CASE(LocalMLCostPolicy)
+{
+  conf.setRttSource(RttSource::HELLO);
+  conf.setCostUpdateWindow(0);
+  linkCostManager.initialize();
+  linkCostManager.start();
+  MLAdaptiveCalculator calculator(linkCostManager);
+  BOOST_CHECK(linkCostManager.isLoadAwareModeEnabled());
+
+  for (int i = 0; i < 2; ++i) {
+    linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 300_ms);
+  }
+  // the ML cost is only used locally, the RTT-based cost is advertised
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 20);
+  BOOST_CHECK(!calculator.getRttHistory(*adjList.getNeighborId(ACTIVE_NEIGHBOR)).empty());
+}
+
+BOOST_AUTO_TEST_CASE(CongestionMarks)
+{
+  conf.setRttSource(RttSource::HELLO);
+  conf.setCostUpdateWindow(0);
+  linkCostManager.initialize();
+  linkCostManager.start();
+  LoadAwareRoutingCalculator calculator(linkCostManager);
+
+  for (int i = 0; i < 2; ++i) {
+    linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 5_ms);
+  }
+  BOOST_CHECK_EQUAL(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 10);
+
+  // the link is congested before its RTT rises
+  for (int i = 0; i < 8; ++i) {
+    linkCostManager.onCongestionSample(ACTIVE_NEIGHBOR, true);
+  }
+  auto metrics = linkCostManager.getLinkMetrics(ACTIVE_NEIGHBOR);
+  BOOST_REQUIRE(metrics.has_value());
+  BOOST_CHECK_CLOSE(metrics->congestionMarkRate, 1 - std::pow(0.875, 8), 1e-6);
+
+  linkCostManager.onHelloRttMeasured(ACTIVE_NEIGHBOR, 5_ms);
+  BOOST_CHECK_GT(adjList.getAdjacent(ACTIVE_NEIGHBOR).getLinkCost(), 10);
+
+  linkCostManager.onCongestionSample(ACTIVE_NEIGHBOR, false);
+  BOOST_CHECK_LT(linkCostManager.getLinkMetrics(ACTIVE_NEIGHBOR)->congestionMarkRate,
+                 metrics->congestionMarkRate);
+}
+
+BOOST_AUTO_TEST_CASE(SetMetricsBatch)
+{
+  LinkMetricsCommand command;
+  LinkMetricsEntry entry;
+  entry.neighbor = ACTIVE_NEIGHBOR;
+  entry.bandwidthUtil = 0.5;
+  entry.packetLoss = 0.01;
+  command.addEntry(entry);
+  entry.neighbor = "/ndn/site/%C1.Router/router-unknown";
+  command.addEntry(entry);
+
+  ndn::Interest interest("/localhost/nlsr/link-cost-manager/set-metrics");
+  interest.setApplicationParameters(command.wireEncode());
+  face.receive(interest);
+  this->advanceClocks(10_ms);
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  ndn::mgmt::ControlResponse response(face.sentData.back().getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(response.getCode(), 200);
+
+  auto metrics = linkCostManager.getMetricsSnapshot(ACTIVE_NEIGHBOR);
+  BOOST_REQUIRE(metrics.has_value());
+  BOOST_CHECK_EQUAL(metrics->bandwidthUtil.value_or(0), 0.5);
+  BOOST_CHECK_EQUAL(metrics->packetLoss.value_or(0), 0.01);
+  BOOST_CHECK(!metrics->bandwidth);
+
+  auto entries = linkCostManager.getLinkMetricsEntries();
+  BOOST_REQUIRE_EQUAL(entries.size(), 1);
+  BOOST_CHECK_EQUAL(entries[0].neighbor, ACTIVE_NEIGHBOR);
+  BOOST_CHECK_EQUAL(entries[0].currentCost.value_or(0), 10);
+  BOOST_CHECK_EQUAL(entries[0].bandwidthUtil.value_or(0), 0.5);
+
+  // a malformed command is rejected
+  face.sentData.clear();
+  ndn::Interest malformed("/localhost/nlsr/link-cost-manager/set-metrics");
+  malformed.setApplicationParameters(ndn::makeStringBlock(ndn::tlv::ApplicationParameters, "x"));
+  face.receive(malformed);
+  this->advanceClocks(10_ms);
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  response.wireDecode(face.sentData.back().getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(response.getCode(), 400);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,133 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "link-metrics-status.hpp"
+#include "tlv-nlsr.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestLinkMetricsStatus)
+
+BOOST_AUTO_TEST_CASE(EntryEncodeDecode)
+{
+  LinkMetricsEntry entry;
+  entry.neighbor = "/ndn/site/router";
+  entry.bandwidthUtil = 0.25;
+  entry.currentCost = 12;
+  entry.smoothedRtt = ndn::time::microseconds(1500);
+
+  LinkMetricsEntry decoded(entry.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.neighbor, entry.neighbor);
+  BOOST_CHECK(!decoded.bandwidth);
+  BOOST_CHECK_EQUAL(decoded.bandwidthUtil.value_or(0), 0.25);
+  BOOST_CHECK(!decoded.originalCost);
+  BOOST_CHECK_EQUAL(decoded.currentCost.value_or(0), 12);
+  BOOST_REQUIRE(decoded.smoothedRtt.has_value());
+  BOOST_CHECK_EQUAL(decoded.smoothedRtt->count(), 1500);
+  BOOST_CHECK(!decoded.multiDimensionalCostPreview);
+
+  // the neighbor is required
+  ndn::Block noName(nlsr::tlv::ExternalMetrics);
+  noName.encode();
+  BOOST_CHECK_THROW(LinkMetricsEntry{noName}, LinkMetricsEntry::Error);
+}
+
+BOOST_AUTO_TEST_CASE(StatisticsEncodeDecode)
+{
+  LinkCostStatistics stats;
+  stats.neighbor = "/ndn/site/router";
+  stats.nProbes = 40;
+  stats.nProbeTimeouts = 2;
+  stats.nCostChanges = 3;
+
+  // the percentiles are omitted without samples
+  LinkCostStatistics decoded(stats.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.neighbor, stats.neighbor);
+  BOOST_CHECK_EQUAL(decoded.nProbes, 40);
+  BOOST_CHECK_EQUAL(decoded.nProbeTimeouts, 2);
+  BOOST_CHECK_EQUAL(decoded.nCostChanges, 3);
+  BOOST_CHECK_EQUAL(decoded.nSamples, 0);
+  BOOST_CHECK_EQUAL(decoded.getProbeLossRate(), 0.05);
+
+  stats.nSamples = 38;
+  stats.rttP50 = ndn::time::microseconds(1500);
+  stats.rttP90 = ndn::time::microseconds(2000);
+  stats.rttP99 = ndn::time::microseconds(4000);
+  stats.rttMax = ndn::time::microseconds(4100);
+  decoded.wireDecode(stats.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.nSamples, 38);
+  BOOST_CHECK_EQUAL(decoded.rttP50.count(), 1500);
+  BOOST_CHECK_EQUAL(decoded.rttP90.count(), 2000);
+  BOOST_CHECK_EQUAL(decoded.rttP99.count(), 4000);
+  BOOST_CHECK_EQUAL(decoded.rttMax.count(), 4100);
+  BOOST_CHECK(decoded.controlTraffic.get(ControlTraffic::MessageClass::HELLO).empty());
+
+  // only the message classes with traffic are encoded
+  ControlTraffic::Counters retransmissions;
+  retransmissions.nInterestsSent = 4;
+  retransmissions.nDataReceived = 1;
+  retransmissions.nBytesSent = 400;
+  retransmissions.nBytesReceived = 1200;
+  stats.controlTraffic.set(ControlTraffic::MessageClass::LSA_RETRANSMISSION, retransmissions);
+  decoded.wireDecode(stats.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.rttMax.count(), 4100);
+  BOOST_CHECK(decoded.controlTraffic.get(ControlTraffic::MessageClass::LSA_FETCH).empty());
+  const auto& counters =
+    decoded.controlTraffic.get(ControlTraffic::MessageClass::LSA_RETRANSMISSION);
+  BOOST_CHECK_EQUAL(counters.nInterestsSent, 4);
+  BOOST_CHECK_EQUAL(counters.nInterestsReceived, 0);
+  BOOST_CHECK_EQUAL(counters.nDataReceived, 1);
+  BOOST_CHECK_EQUAL(counters.nBytesSent, 400);
+  BOOST_CHECK_EQUAL(counters.nBytesReceived, 1200);
+
+  // the control traffic does not need RTT samples
+  stats.nSamples = 0;
+  decoded.wireDecode(stats.wireEncode());
+  BOOST_CHECK_EQUAL(decoded.rttMax.count(), 0);
+  BOOST_CHECK_EQUAL(
+    decoded.controlTraffic.get(ControlTraffic::MessageClass::LSA_RETRANSMISSION).nInterestsSent, 4);
+}
+
+BOOST_AUTO_TEST_CASE(CommandEncodeDecode)
+{
+  LinkMetricsCommand command;
+  for (const auto& name : {"/ndn/site/router1", "/ndn/site/router2"}) {
+    LinkMetricsEntry entry;
+    entry.neighbor = name;
+    entry.packetLoss = 0.1;
+    command.addEntry(entry);
+  }
+
+  ndn::Block wire = command.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), nlsr::tlv::LinkMetricsCommand);
+
+  LinkMetricsCommand decoded(wire);
+  BOOST_REQUIRE_EQUAL(decoded.getEntries().size(), 2);
+  BOOST_CHECK_EQUAL(decoded.getEntries()[0].neighbor, "/ndn/site/router1");
+  BOOST_CHECK_EQUAL(decoded.getEntries()[1].neighbor, "/ndn/site/router2");
+  BOOST_CHECK_EQUAL(decoded.getEntries()[1].packetLoss.value_or(0), 0.1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "link-rtt-estimator.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+using namespace ndn::time_literals;
+
+BOOST_AUTO_TEST_SUITE(TestLinkRttEstimator)
+
+BOOST_AUTO_TEST_CASE(Smoothing)
+{
+  LinkRttEstimator estimator;
+  ndn::time::steady_clock::time_point now;
+  BOOST_CHECK(!estimator.hasSamples());
+
+  estimator.addSample(80_ms, now);
+  BOOST_CHECK_EQUAL(estimator.getSrtt(), 80_ms);
+  BOOST_CHECK_EQUAL(estimator.getRttVar(), 40_ms);
+  BOOST_CHECK_EQUAL(estimator.getMinRtt(), 80_ms);
+
+  // rttvar = (3 * 40 + |80 - 40|) / 4, srtt = (7 * 80 + 40) / 8
+  estimator.addSample(40_ms, now + 1_s);
+  BOOST_CHECK_EQUAL(estimator.getRttVar(), 40_ms);
+  BOOST_CHECK_EQUAL(estimator.getSrtt(), 75_ms);
+  BOOST_CHECK_EQUAL(estimator.getMinRtt(), 40_ms);
+  BOOST_CHECK_EQUAL(estimator.getSampleCount(), 2);
+  BOOST_CHECK(estimator.getLastSampleTime() == now + 1_s);
+
+  estimator.reset();
+  BOOST_CHECK(!estimator.hasSamples());
+  BOOST_CHECK(estimator.getHistory().empty());
+}
+
+BOOST_AUTO_TEST_CASE(History)
+{
+  LinkRttEstimator estimator;
+  ndn::time::steady_clock::time_point now;
+
+  for (size_t i = 1; i <= LinkRttEstimator::HISTORY_SIZE + 3; ++i) {
+    estimator.addSample(ndn::time::milliseconds(i), now);
+  }
+
+  auto history = estimator.getHistory();
+  BOOST_REQUIRE_EQUAL(history.size(), LinkRttEstimator::HISTORY_SIZE);
+  for (size_t i = 0; i < history.size(); ++i) {
+    BOOST_CHECK_EQUAL(history[i], ndn::time::milliseconds(i + 4));
+  }
+  BOOST_CHECK_EQUAL(history.back(), ndn::time::milliseconds(LinkRttEstimator::HISTORY_SIZE + 3));
+  BOOST_CHECK_EQUAL(estimator.getSampleCount(), LinkRttEstimator::HISTORY_SIZE + 3);
+}
+
+BOOST_AUTO_TEST_CASE(MinRttWindow)
+{
+  LinkRttEstimator estimator;
+  ndn::time::steady_clock::time_point now;
+
+  estimator.addSample(10_ms, now);
+  estimator.addSample(30_ms, now + 30_s);
+  estimator.addSample(50_ms, now + 40_s);
+  BOOST_CHECK_EQUAL(estimator.getMinRtt(), 10_ms);
+
+  // the 10 ms sample leaves the window; the best remaining sample takes over
+  estimator.addSample(40_ms, now + 61_s);
+  BOOST_CHECK_EQUAL(estimator.getMinRtt(), 30_ms);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
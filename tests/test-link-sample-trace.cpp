@@ -0,0 +1,144 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "link-sample-trace.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/clock-fixture.hpp"
+
+#include <boost/filesystem/operations.hpp>
+
+#include <sstream>
+
+namespace nlsr::tests {
+
+class LinkSampleTraceFixture : public ClockFixture
+{
+public:
+  ~LinkSampleTraceFixture() override
+  {
+    boost::filesystem::remove(TRACE_PATH);
+  }
+
+public:
+  const std::string TRACE_PATH = "/tmp/nlsr-test-link-samples.trace";
+  const ndn::Name NEIGHBOR_A{"/ndn/site/%C1.Router/router-a"};
+  const ndn::Name NEIGHBOR_B{"/ndn/site/%C1.Router/router-b"};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestLinkSampleTrace, LinkSampleTraceFixture)
+
+BOOST_AUTO_TEST_CASE(RoundTrip)
+{
+  {
+    LinkSampleRecorder recorder(TRACE_PATH);
+
+    LinkSample rtt;
+    rtt.type = LinkSample::Type::RTT;
+    rtt.neighbor = NEIGHBOR_A;
+    rtt.rtt = time::microseconds(12345);
+    recorder.record(rtt);
+
+    advanceClocks(time::milliseconds(250));
+    LinkSample timeout;
+    timeout.type = LinkSample::Type::HELLO_TIMEOUT;
+    timeout.neighbor = NEIGHBOR_B;
+    timeout.value = 3;
+    recorder.record(timeout);
+
+    advanceClocks(time::seconds(2));
+    LinkSample metrics;
+    metrics.type = LinkSample::Type::EXTERNAL_METRICS;
+    metrics.neighbor = NEIGHBOR_A;
+    metrics.bandwidth = 100.0;
+    metrics.packetLoss = 0.25;
+    recorder.record(metrics);
+
+    LinkSample congestion;
+    congestion.type = LinkSample::Type::CONGESTION;
+    congestion.neighbor = NEIGHBOR_B;
+    congestion.value = 1;
+    recorder.record(congestion);
+
+    BOOST_CHECK_EQUAL(recorder.getRecordCount(), 4);
+  }
+
+  std::ifstream trace(TRACE_PATH, std::ios::binary);
+  LinkSampleReader reader(trace);
+
+  auto sample = reader.next();
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK(sample->type == LinkSample::Type::RTT);
+  BOOST_CHECK_EQUAL(sample->neighbor, NEIGHBOR_A);
+  BOOST_CHECK_EQUAL(sample->time, time::microseconds(0));
+  BOOST_CHECK_EQUAL(sample->rtt, time::microseconds(12345));
+
+  sample = reader.next();
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK(sample->type == LinkSample::Type::HELLO_TIMEOUT);
+  BOOST_CHECK_EQUAL(sample->neighbor, NEIGHBOR_B);
+  BOOST_CHECK_EQUAL(sample->time, time::milliseconds(250));
+  BOOST_CHECK_EQUAL(sample->value, 3);
+
+  sample = reader.next();
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK(sample->type == LinkSample::Type::EXTERNAL_METRICS);
+  BOOST_CHECK_EQUAL(sample->neighbor, NEIGHBOR_A);
+  BOOST_CHECK_EQUAL(sample->time, time::milliseconds(2250));
+  BOOST_CHECK(sample->bandwidth == 100.0);
+  BOOST_CHECK(!sample->bandwidthUtil);
+  BOOST_CHECK(sample->packetLoss == 0.25);
+  BOOST_CHECK(!sample->spectrumStrength);
+
+  sample = reader.next();
+  BOOST_REQUIRE(sample);
+  BOOST_CHECK(sample->type == LinkSample::Type::CONGESTION);
+  BOOST_CHECK_EQUAL(sample->neighbor, NEIGHBOR_B);
+  BOOST_CHECK_EQUAL(sample->value, 1);
+
+  BOOST_CHECK(!reader.next());
+}
+
+BOOST_AUTO_TEST_CASE(Malformed)
+{
+  std::istringstream empty;
+  BOOST_CHECK_THROW(LinkSampleReader{empty}, LinkSampleReader::Error);
+
+  std::istringstream badMagic(std::string("NOT A TRACE"));
+  BOOST_CHECK_THROW(LinkSampleReader{badMagic}, LinkSampleReader::Error);
+
+  {
+    LinkSampleRecorder recorder(TRACE_PATH);
+    LinkSample rtt;
+    rtt.neighbor = NEIGHBOR_A;
+    recorder.record(rtt);
+  }
+  std::ifstream file(TRACE_PATH, std::ios::binary);
+  std::string wire((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  // drop the RTT of the only record
+  std::istringstream truncated(wire.substr(0, wire.size() - 1));
+  LinkSampleReader reader(truncated);
+  BOOST_CHECK_THROW(reader.next(), LinkSampleReader::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestLinkSampleTrace
+
+} // namespace nlsr::tests
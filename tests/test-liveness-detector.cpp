@@ -0,0 +1,131 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "liveness-detector.hpp"
+
+#include "tests/io-key-chain-fixture.hpp"
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/security/signing-helpers.hpp>
+
+namespace nlsr::tests {
+
+class LivenessDetectorFixture : public IoKeyChainFixture
+{
+public:
+  LivenessDetectorFixture()
+    : face(m_io, m_keyChain, {true, true})
+    , conf(face, m_keyChain)
+    , confProcessor(conf)
+  {
+    conf.setLivenessInterval(100);
+    conf.setLivenessMultiplier(3);
+    Adjacent adj(NEIGHBOR, ndn::FaceUri("udp4://10.0.0.1:6363"), 10, Adjacent::STATUS_ACTIVE, 0, 300);
+    conf.getAdjacencyList().insert(adj);
+
+    detector = std::make_unique<LivenessDetector>(face, m_keyChain, conf);
+    detector->onNeighborDown.connect([this] (const auto& neighbor) { down.push_back(neighbor); });
+    advanceClocks(10_ms);
+    face.sentInterests.clear();
+  }
+
+  void
+  replyToProbes()
+  {
+    for (const auto& interest : face.sentInterests) {
+      ndn::Data data(interest.getName());
+      m_keyChain.sign(data, ndn::security::signingWithSha256());
+      face.receive(data);
+    }
+    face.sentInterests.clear();
+    advanceClocks(1_ms);
+  }
+
+public:
+  const ndn::Name NEIGHBOR{"/ndn/site/%C1.Router/router-active"};
+  ndn::DummyClientFace face;
+  ConfParameter conf;
+  DummyConfFileProcessor confProcessor;
+  std::unique_ptr<LivenessDetector> detector;
+  std::vector<ndn::Name> down;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestLivenessDetector, LivenessDetectorFixture)
+
+BOOST_AUTO_TEST_CASE(NeverArmed)
+{
+  advanceClocks(100_ms, 10);
+  BOOST_CHECK_EQUAL(face.sentInterests.size(), 10);
+  BOOST_CHECK(ndn::Name(NEIGHBOR).append("nlsr").append(LivenessDetector::LIVENESS_COMPONENT)
+                .isPrefixOf(face.sentInterests.front().getName()));
+  // a neighbor that never answered is left to the Hello protocol
+  BOOST_CHECK(down.empty());
+}
+
+BOOST_AUTO_TEST_CASE(DetectDown)
+{
+  advanceClocks(100_ms);
+  BOOST_REQUIRE_EQUAL(face.sentInterests.size(), 1);
+  replyToProbes();
+
+  advanceClocks(100_ms, 3);
+  BOOST_CHECK(down.empty());
+  advanceClocks(100_ms);
+  BOOST_REQUIRE_EQUAL(down.size(), 1);
+  BOOST_CHECK_EQUAL(down.front(), NEIGHBOR);
+
+  // not declared down again until it answers again
+  advanceClocks(100_ms, 10);
+  BOOST_CHECK_EQUAL(down.size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(InactiveNeighbor)
+{
+  advanceClocks(100_ms);
+  replyToProbes();
+  conf.getAdjacencyList().setStatusOfNeighbor(NEIGHBOR, Adjacent::STATUS_INACTIVE);
+
+  advanceClocks(100_ms, 10);
+  BOOST_CHECK(face.sentInterests.empty());
+  BOOST_CHECK(down.empty());
+}
+
+BOOST_AUTO_TEST_CASE(AnswerProbes)
+{
+  auto probeFrom = [this] (const ndn::Name& router) {
+    ndn::Name name(conf.getRouterPrefix());
+    name.append("nlsr").append(LivenessDetector::LIVENESS_COMPONENT)
+        .append(ndn::tlv::GenericNameComponent, router.wireEncode())
+        .appendNumber(1);
+    return name;
+  };
+
+  detector->processProbe(ndn::Interest(probeFrom(NEIGHBOR)));
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentData.front().getSignatureType(), ndn::tlv::DigestSha256);
+
+  detector->processProbe(ndn::Interest(probeFrom("/ndn/site/%C1.Router/stranger")));
+  BOOST_CHECK_EQUAL(face.sentData.size(), 1);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
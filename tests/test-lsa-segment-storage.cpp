@@ -144,6 +144,54 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK_EQUAL(lsdb.m_lsaStorage.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(ByteBudget)
+{
+  auto makeSegment = [] (const ndn::Name& name) {
+    auto data = std::make_shared<ndn::Data>(name);
+    data->setFreshnessPeriod(ndn::time::seconds(10));
+    return signData(data);
+  };
+  auto seg1 = makeSegment("/ndn/NLSR/LSA/site/%C1.Router/router1/NAME/1/v/0");
+  auto seg2 = makeSegment("/ndn/NLSR/LSA/site/%C1.Router/router2/NAME/1/v/0");
+  auto seg3 = makeSegment("/ndn/NLSR/LSA/site/%C1.Router/router3/NAME/1/v/0");
+  size_t segSize = seg1->wireEncode().size();
+
+  LsaSegmentStorage storage(2 * segSize + segSize / 2);
+  storage.insert(*seg1);
+  storage.insert(*seg2);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK_EQUAL(storage.getSizeInBytes(), 2 * segSize);
+
+  // seg1 becomes the most recently used, so seg2 is evicted to make room for seg3
+  BOOST_CHECK(storage.find(ndn::Interest(seg1->getName())) != nullptr);
+  storage.insert(*seg3);
+  BOOST_CHECK_EQUAL(storage.size(), 2);
+  BOOST_CHECK_EQUAL(storage.getNEvictions(), 1);
+  BOOST_CHECK(storage.find(ndn::Interest(seg2->getName())) == nullptr);
+  BOOST_CHECK(storage.find(ndn::Interest(seg3->getName())) != nullptr);
+  BOOST_CHECK_EQUAL(storage.getNHits(), 2);
+  BOOST_CHECK_EQUAL(storage.getNMisses(), 1);
+
+  // Discovery Interests need a fresh segment
+  ndn::Interest discovery(ndn::Name("/ndn/NLSR/LSA/site/%C1.Router/router1/NAME/1"));
+  discovery.setCanBePrefix(true);
+  discovery.setMustBeFresh(true);
+  BOOST_CHECK(storage.find(discovery) != nullptr);
+  advanceClocks(ndn::time::seconds(11));
+  BOOST_CHECK(storage.find(discovery) == nullptr);
+  discovery.setMustBeFresh(false);
+  BOOST_CHECK(storage.find(discovery) != nullptr);
+
+  storage.erase("/ndn/NLSR/LSA/site/%C1.Router/router1");
+  BOOST_CHECK_EQUAL(storage.size(), 1);
+  BOOST_CHECK_EQUAL(storage.getSizeInBytes(), segSize);
+
+  storage.setCapacity(segSize / 2);
+  BOOST_CHECK_EQUAL(storage.size(), 0);
+  storage.insert(*seg1);
+  BOOST_CHECK_EQUAL(storage.size(), 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLsaSegmentStorage
 
 } // namespace nlsr::tests
@@ -26,10 +26,15 @@
 #include "tests/io-key-chain-fixture.hpp"
 #include "tests/test-common.hpp"
 
+#include <ndn-cxx/lp/tags.hpp>
 #include <ndn-cxx/mgmt/nfd/control-parameters.hpp>
 #include <ndn-cxx/security/validator-null.hpp>
 #include <ndn-cxx/util/segment-fetcher.hpp>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+
 #include <unistd.h>
 
 namespace nlsr::tests {
@@ -67,8 +72,8 @@ public:
   void
   checkSignalResult(LsdbUpdate updateType,
                     const std::shared_ptr<Lsa>& lsaPtr,
-                    const std::list<PrefixInfo>& namesToAdd,
-                    const std::list<PrefixInfo>& namesToRemove)
+                    const std::vector<PrefixInfo>& namesToAdd,
+                    const std::vector<PrefixInfo>& namesToRemove)
   {
     BOOST_CHECK(updateHappened);
     BOOST_CHECK_EQUAL(lsaPtrCheck->getOriginRouter(), lsaPtr->getOriginRouter());
@@ -84,7 +89,7 @@ public:
   {
     lsdb.onLsdbModified.connect(
       [&] (std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
-           const auto& namesToAdd, const auto& namesToRemove) {
+           const auto& namesToAdd, const auto& namesToRemove, const auto&) {
         lsaPtrCheck = lsa;
         updateTypeCheck = updateType;
         namesToAddCheck = namesToAdd;
@@ -101,8 +106,8 @@ public:
   Lsdb lsdb;
 
   LsdbUpdate updateTypeCheck = LsdbUpdate::INSTALLED;
-  std::list<PrefixInfo> namesToAddCheck;
-  std::list<PrefixInfo> namesToRemoveCheck;
+  std::vector<PrefixInfo> namesToAddCheck;
+  std::vector<PrefixInfo> namesToRemoveCheck;
   std::shared_ptr<Lsa> lsaPtrCheck = nullptr;
   bool updateHappened = false;
 };
@@ -177,6 +182,176 @@ BOOST_AUTO_TEST_CASE(LsdbSync)
   BOOST_CHECK_EQUAL(interests.size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(FetchWindow)
+{
+  conf.setLsaFetchWindow(2);
+  ndn::Name lsaPrefix("/ndn/NLSR/LSA/cs/%C1.Router");
+  auto makeInterestName = [&] (const std::string& router, const std::string& type, uint64_t seqNo) {
+    return ndn::Name(lsaPrefix).append(router).append(type).appendNumber(seqNo);
+  };
+  auto findSent = [&] (const ndn::Name& name) {
+    return std::find_if(face.sentInterests.begin(), face.sentInterests.end(),
+                        [&] (const auto& interest) { return interest.getName() == name; });
+  };
+  auto wasSent = [&] (const ndn::Name& name) {
+    return findSent(name) != face.sentInterests.end();
+  };
+
+  lsdb.expressInterest(makeInterestName("router1", "NAME", 1), 0, 0);
+  lsdb.expressInterest(makeInterestName("router2", "NAME", 1), 0, 0);
+  lsdb.expressInterest(makeInterestName("router3", "NAME", 1), 0, 0);
+  lsdb.expressInterest(makeInterestName("router4", "ADJACENCY", 1), 0, 0);
+  lsdb.expressInterest(makeInterestName("router3", "NAME", 2), 0, 0);
+  advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(lsdb.getLsaFetchesInFlight(), 2);
+  BOOST_CHECK_EQUAL(lsdb.getLsaFetchQueueSize(), 2);
+  BOOST_CHECK(wasSent(makeInterestName("router1", "NAME", 1)));
+  BOOST_CHECK(wasSent(makeInterestName("router2", "NAME", 1)));
+  BOOST_CHECK(!wasSent(makeInterestName("router4", "ADJACENCY", 1)));
+
+  // the two fetches time out and make room for the queued ones; the Adjacency LSA goes first
+  // and the superseded Name LSA is never fetched
+  face.sentInterests.clear();
+  advanceClocks(100_ms, 50);
+  BOOST_REQUIRE(wasSent(makeInterestName("router4", "ADJACENCY", 1)));
+  BOOST_REQUIRE(wasSent(makeInterestName("router3", "NAME", 2)));
+  BOOST_CHECK(findSent(makeInterestName("router4", "ADJACENCY", 1)) <
+              findSent(makeInterestName("router3", "NAME", 2)));
+  BOOST_CHECK(!wasSent(makeInterestName("router3", "NAME", 1)));
+  BOOST_CHECK_LE(lsdb.getLsaFetchesInFlight(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(SupersedeFetchInFlight)
+{
+  conf.setLsaFetchWindow(1);
+  ndn::Name lsaName("/ndn/NLSR/LSA/cs/%C1.Router/router1/NAME");
+  auto nSent = [&] (uint64_t seqNo) {
+    return std::count_if(face.sentInterests.begin(), face.sentInterests.end(),
+                         [&] (const auto& interest) {
+                           return interest.getName() == ndn::Name(lsaName).appendNumber(seqNo);
+                         });
+  };
+
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(1), 0, 0);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nSent(1), 1);
+
+  // a version already in flight is not fetched again
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(1), 0, 0);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nSent(1), 1);
+
+  // a newer version takes the place of the fetch in flight, instead of waiting for it
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(2), 0, 0);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nSent(2), 1);
+  BOOST_CHECK_EQUAL(lsdb.getLsaFetchesInFlight(), 1);
+  BOOST_CHECK_EQUAL(lsdb.getLsaFetchQueueSize(), 0);
+
+  // the cancelled fetch is not retried
+  face.sentInterests.clear();
+  advanceClocks(100_ms, 100);
+  BOOST_CHECK_EQUAL(nSent(1), 0);
+  BOOST_CHECK_GT(nSent(2), 0);
+}
+
+BOOST_AUTO_TEST_CASE(FetchRate)
+{
+  conf.setLsaFetchWindow(0);
+  conf.setLsaFetchRate(2);
+  ndn::Name lsaPrefix("/ndn/NLSR/LSA/cs/%C1.Router");
+  auto makeInterestName = [&] (const std::string& router, uint64_t seqNo) {
+    return ndn::Name(lsaPrefix).append(router).append("NAME").appendNumber(seqNo);
+  };
+  auto nSent = [&] (uint64_t faceId) {
+    return std::count_if(face.sentInterests.begin(), face.sentInterests.end(),
+                         [&] (const auto& interest) {
+                           auto tag = interest.template getTag<ndn::lp::NextHopFaceIdTag>();
+                           return (tag == nullptr ? 0 : tag->get()) == faceId;
+                         });
+  };
+
+  // A burst through one neighbor is limited to its bucket, without holding back the others
+  for (int i = 0; i < 4; ++i) {
+    lsdb.expressInterest(makeInterestName("router" + std::to_string(i), 1), 0, 256);
+  }
+  lsdb.expressInterest(makeInterestName("router4", 1), 0, 257);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(nSent(256), 2);
+  BOOST_CHECK_EQUAL(nSent(257), 1);
+  BOOST_CHECK_EQUAL(lsdb.getLsaFetchQueueSize(), 2);
+
+  // The queued ones start as the bucket refills
+  face.sentInterests.clear();
+  advanceClocks(100_ms, 5);
+  BOOST_CHECK_EQUAL(nSent(256), 1);
+  advanceClocks(100_ms, 5);
+  BOOST_CHECK_EQUAL(nSent(256), 2);
+  BOOST_CHECK_EQUAL(lsdb.getLsaFetchQueueSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(AdmissionControl)
+{
+  conf.setLsaMinArrival(1000);
+  conf.setLsaMaxNamePrefixes(2);
+  Statistics stats;
+  lsdb.setStatistics(&stats);
+
+  ndn::Name otherRouter("/ndn/site/%C1.Router/other-router");
+  ndn::Name lsaName("/ndn/NLSR/LSA/site/%C1.Router/other-router/NAME");
+  const auto MAX_TIME = ndn::time::system_clock::time_point::max();
+  auto makeNameLsa = [&] (uint64_t seqNo, std::initializer_list<ndn::Name> names) {
+    NamePrefixList npl;
+    for (const auto& name : names) {
+      npl.insert(name);
+    }
+    return std::make_shared<NameLsa>(otherRouter, seqNo, MAX_TIME, npl);
+  };
+  auto nSent = [&] (uint64_t seqNo) {
+    return std::count_if(face.sentInterests.begin(), face.sentInterests.end(),
+                         [&] (const auto& interest) {
+                           return interest.getName() == ndn::Name(lsaName).appendNumber(seqNo);
+                         });
+  };
+
+  // the first version of an LSA is never held back
+  BOOST_CHECK(!lsdb.deferLsaFetch(lsaName, 1, 0));
+  lsdb.installFetchedLsa(makeNameLsa(1, {"/ndn/name1", "/ndn/name2"}),
+                         ndn::Name(lsaName).appendNumber(1));
+  BOOST_CHECK(lsdb.doesLsaExist(otherRouter, Lsa::Type::NAME));
+
+  // versions announced too soon are fetched once, at the newest, when lsa-min-arrival is over
+  BOOST_CHECK(lsdb.deferLsaFetch(lsaName, 2, 0));
+  BOOST_CHECK(lsdb.deferLsaFetch(lsaName, 3, 0));
+  advanceClocks(100_ms, 5);
+  BOOST_CHECK_EQUAL(nSent(2) + nSent(3), 0);
+  BOOST_CHECK_EQUAL(stats.get(Statistics::PacketType::DEFERRED_LSA), 2);
+  advanceClocks(100_ms, 6);
+  BOOST_CHECK_EQUAL(nSent(2), 0);
+  BOOST_CHECK_EQUAL(nSent(3), 1);
+
+  // an LSA over lsa-max-name-prefixes is not installed
+  lsdb.installFetchedLsa(makeNameLsa(3, {"/ndn/name1", "/ndn/name2", "/ndn/name3"}),
+                         ndn::Name(lsaName).appendNumber(3));
+  BOOST_CHECK_EQUAL(lsdb.findLsa(otherRouter, Lsa::Type::NAME)->getSeqNo(), 1);
+  BOOST_CHECK_EQUAL(stats.get(Statistics::PacketType::REJECTED_LSA), 1);
+
+  // nor does it restart lsa-min-arrival
+  BOOST_CHECK(!lsdb.deferLsaFetch(lsaName, 4, 0));
+
+  // the arrival time goes with the LSA
+  BOOST_CHECK_EQUAL(lsdb.m_lsaArrivals.count(lsaName), 1);
+  lsdb.removeLsa(otherRouter, Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(lsdb.m_lsaArrivals.count(lsaName), 0);
+
+  // and is not recorded without lsa-min-arrival
+  conf.setLsaMinArrival(0);
+  lsdb.installFetchedLsa(makeNameLsa(5, {"/ndn/name1"}), ndn::Name(lsaName).appendNumber(5));
+  BOOST_CHECK(lsdb.doesLsaExist(otherRouter, Lsa::Type::NAME));
+  BOOST_CHECK(lsdb.m_lsaArrivals.empty());
+}
+
 BOOST_AUTO_TEST_CASE(LsdbSegmentedData)
 {
   // Add a lot of NameLSAs to exceed max packet size
@@ -255,6 +430,179 @@ BOOST_AUTO_TEST_CASE(SegmentLsaData)
   fetcher->stop();
 }
 
+BOOST_AUTO_TEST_CASE(OwnLsaSegmentsSignedOnce)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  ndn::Name lsaName("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router/NAME");
+  auto requestOwnNameLsa = [&] {
+    auto seqNo = lsdb.findLsa<NameLsa>(originRouter)->getSeqNo();
+    face.receive(ndn::Interest(ndn::Name(lsaName).appendNumber(seqNo)).setCanBePrefix(true));
+    advanceClocks(10_ms);
+  };
+
+  requestOwnNameLsa();
+  requestOwnNameLsa();
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 2);
+  // the second neighbor gets the very same signed segment
+  BOOST_CHECK_EQUAL(face.sentData[0].wireEncode(), face.sentData[1].wireEncode());
+
+  lsdb.buildAndInstallOwnNameLsa();
+  requestOwnNameLsa();
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 3);
+  BOOST_CHECK_NE(face.sentData[2].getName().getPrefix(-2), face.sentData[0].getName().getPrefix(-2));
+}
+
+BOOST_AUTO_TEST_CASE(OwnLsaSegmentSize)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  auto lsa = lsdb.findLsa<NameLsa>(originRouter);
+  ndn::Name prefix("/ndn/edu/memphis/netlab/research/nlsr/test/prefix/");
+  int nPrefixes = 0;
+  while (lsa->wireEncode().size() < 4000) {
+    lsa->addName(PrefixInfo(ndn::Name(prefix).appendNumber(++nPrefixes), 0));
+  }
+  lsdb.installLsa(lsa);
+  size_t wireSize = lsa->wireEncode().size();
+
+  conf.setLsaSegmentSize(1000);
+  BOOST_CHECK_EQUAL(lsdb.getOwnLsaSegmentCount(Lsa::Type::NAME), 0);
+
+  ndn::Name lsaName("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router/NAME");
+  lsaName.appendNumber(lsa->getSeqNo());
+  face.receive(ndn::Interest(lsaName).setCanBePrefix(true));
+  advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(lsdb.getOwnLsaSegmentCount(Lsa::Type::NAME), (wireSize + 999) / 1000);
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  BOOST_CHECK_EQUAL(face.sentData[0].getContent().value_size(), 1000);
+}
+
+BOOST_AUTO_TEST_CASE(HighestSeqNoLifetime)
+{
+  ndn::Name router("/ndn/site/%C1.Router/other-router");
+  ndn::Name lsaName("/localhop/ndn/nlsr/LSA/site/%C1.Router/other-router/NAME");
+
+  BOOST_CHECK(lsdb.updateHighestSeqNo(lsaName, 5));
+  BOOST_CHECK(!lsdb.updateHighestSeqNo(lsaName, 4));
+  BOOST_CHECK_EQUAL(lsdb.getHighestSeqNo(lsaName), 5);
+
+  // an announcement older than the highest known one is not fetched
+  face.sentInterests.clear();
+  lsdb.expressInterest(ndn::Name(lsaName).appendNumber(4), 0, 0);
+  advanceClocks(10_ms);
+  BOOST_CHECK(face.sentInterests.empty());
+
+  // the record goes with the LSA
+  lsdb.installLsa(std::make_shared<NameLsa>(router, 5, ndn::time::system_clock::now() + 10_s,
+                                            NamePrefixList{}));
+  advanceClocks(1_s, 25);
+  BOOST_CHECK(lsdb.findLsa<NameLsa>(router) == nullptr);
+  BOOST_CHECK_EQUAL(lsdb.getHighestSeqNo(lsaName), 0);
+
+  // a record without an LSA lives as long as the longest LSA lifetime
+  lsdb.updateHighestSeqNo(lsaName, 6);
+  advanceClocks(10_s, LSA_REFRESH_TIME_MAX / 10);
+  BOOST_CHECK_EQUAL(lsdb.getHighestSeqNo(lsaName), 6);
+  advanceClocks(10_s, 3);
+  BOOST_CHECK_EQUAL(lsdb.getHighestSeqNo(lsaName), 0);
+}
+
+BOOST_AUTO_TEST_CASE(CoalescedNameLsaBuild)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  auto seqNo = lsdb.m_sequencingManager.getNameLsaSeq();
+
+  conf.setNameLsaBuildInterval(100);
+  for (int i = 0; i < 10; ++i) {
+    conf.getNamePrefixList().insert(ndn::Name("/prefix").appendNumber(i));
+    lsdb.scheduleNameLsaBuild();
+    advanceClocks(5_ms);
+  }
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo);
+
+  // built once, from the first change on, with all the changes
+  advanceClocks(50_ms);
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo + 1);
+  BOOST_CHECK_EQUAL(lsdb.findLsa<NameLsa>(originRouter)->getNpl().size(), 10);
+  advanceClocks(100_ms, 5);
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo + 1);
+
+  // a direct build covers a scheduled one
+  lsdb.scheduleNameLsaBuild();
+  lsdb.buildAndInstallOwnNameLsa();
+  advanceClocks(100_ms, 2);
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo + 2);
+
+  conf.setNameLsaBuildInterval(0);
+  lsdb.scheduleNameLsaBuild();
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo + 3);
+}
+
+BOOST_AUTO_TEST_CASE(AggregatePrefixes)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  conf.setNameLsaBuildInterval(0);
+  conf.addAggregatePrefix("/org/site/svc");
+  auto& npl = conf.getNamePrefixList();
+  for (int i = 0; i < 100; ++i) {
+    npl.insert(ndn::Name("/org/site/svc").appendNumber(i), "", 10 - i % 3);
+  }
+  npl.insert("/org/site/other", "", 1);
+
+  auto advertised = lsdb.getAdvertisedPrefixes();
+  BOOST_CHECK_EQUAL(advertised.size(), 2);
+  BOOST_CHECK_EQUAL(advertised.getPrefixInfoForName("/org/site/svc").getCost(), 8);
+  BOOST_CHECK_EQUAL(advertised.getPrefixInfoForName("/org/site/other").getCost(), 1);
+
+  // a prefix that another router originates too, or under a prefix it originates, is listed
+  ndn::Name otherRouter("/ndn/site/%C1.Router/other-router");
+  NamePrefixList otherNpl{ndn::Name("/org/site/svc").appendNumber(7), "/org/site/unrelated"};
+  auto seqNo = lsdb.m_sequencingManager.getNameLsaSeq();
+  lsdb.installLsa(std::make_shared<NameLsa>(otherRouter, 1, time::system_clock::now() + 3600_s,
+                                            otherNpl));
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo + 1);
+  auto ownLsa = lsdb.findLsa<NameLsa>(originRouter);
+  BOOST_CHECK_EQUAL(ownLsa->getNpl().size(), 3);
+  auto exception = ndn::Name("/org/site/svc").appendNumber(7);
+  BOOST_CHECK_EQUAL(ownLsa->getNpl().getPrefixInfoForName(exception).getCost(), 9);
+
+  // changes of prefixes that do not decide our aggregation leave our Name LSA alone
+  NamePrefixList unrelatedNpl{ndn::Name("/org/site/svc").appendNumber(7), "/org/site/more"};
+  lsdb.installLsa(std::make_shared<NameLsa>(otherRouter, 2, time::system_clock::now() + 3600_s,
+                                            unrelatedNpl));
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo + 1);
+
+  lsdb.removeLsa(otherRouter, Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo + 2);
+  BOOST_CHECK_EQUAL(lsdb.findLsa<NameLsa>(originRouter)->getNpl().size(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(AdjLsaDeltaServed)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  ndn::Name neighbor("/ndn/site/%C1.Router/neighbor");
+  auto& adjacencies = conf.getAdjacencyList();
+  adjacencies.insert(Adjacent(neighbor, ndn::FaceUri("udp4://10.0.0.2:6363"), 10,
+                              Adjacent::STATUS_ACTIVE, 0, 0));
+  lsdb.buildAndInstallOwnAdjLsa();
+  adjacencies.findAdjacent(neighbor)->setLinkCost(20);
+  lsdb.buildAndInstallOwnAdjLsa();
+  uint64_t seqNo = lsdb.findLsa<AdjLsa>(originRouter)->getSeqNo();
+
+  ndn::Name deltaName("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router");
+  deltaName.append(ADJ_LSA_DELTA_COMPONENT).appendNumber(seqNo);
+  face.receive(ndn::Interest(deltaName).setCanBePrefix(true));
+  advanceClocks(10_ms);
+
+  BOOST_REQUIRE_EQUAL(face.sentData.size(), 1);
+  AdjLsaDelta delta(face.sentData[0].getContent().blockFromValue());
+  BOOST_CHECK_EQUAL(delta.getSeqNo(), seqNo);
+  BOOST_CHECK_EQUAL(delta.getBaseSeqNo(), seqNo - 1);
+  BOOST_REQUIRE_EQUAL(delta.getChangedAdjacencies().size(), 1);
+  BOOST_CHECK_EQUAL(delta.getChangedAdjacencies()[0].getLinkCost(), 20);
+  BOOST_CHECK(delta.getRemovedNeighbors().empty());
+}
+
 BOOST_AUTO_TEST_CASE(ReceiveSegmentedLsaData)
 {
   ndn::Name router("/ndn/cs/%C1.Router/router1");
@@ -281,6 +629,55 @@ BOOST_AUTO_TEST_CASE(ReceiveSegmentedLsaData)
   BOOST_CHECK_EQUAL(foundLsa->wireEncode(), lsa.wireEncode());
 }
 
+BOOST_AUTO_TEST_CASE(InlineLsa)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  uint64_t seqNo = lsdb.findLsa<NameLsa>(originRouter)->getSeqNo();
+
+  conf.setSyncInlineLsaSize(SYNC_INLINE_LSA_SIZE_MAX);
+  auto inlineLsas = lsdb.getInlineLsas();
+  BOOST_REQUIRE_EQUAL(inlineLsas.size(), 1);
+  BOOST_CHECK_EQUAL(inlineLsas[0]->getName().getPrefix(-2),
+                    ndn::Name("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router/NAME")
+                      .appendNumber(seqNo));
+
+  ndn::DummyClientFace face2(m_io, m_keyChain, {true, true});
+  ConfParameter conf2(face2, m_keyChain);
+  DummyConfFileProcessor confProcessor2(conf2, SyncProtocol::PSYNC, HYPERBOLIC_STATE_OFF,
+                                        "/ndn", "/site", "/%C1.Router/other-router");
+  conf2.getValidator().load(R"CONF(
+              trust-anchor
+                {
+                  type any
+                }
+            )CONF", "config-file-from-string");
+  conf2.setSyncInlineLsaSize(SYNC_INLINE_LSA_SIZE_MAX);
+  Lsdb lsdb2(face2, m_keyChain, conf2);
+  advanceClocks(10_ms);
+
+  lsdb2.onInlineLsa(*inlineLsas[0]);
+  advanceClocks(10_ms);
+  auto installed = lsdb2.findLsa<NameLsa>(originRouter);
+  BOOST_REQUIRE(installed != nullptr);
+  BOOST_CHECK_EQUAL(installed->getSeqNo(), seqNo);
+  // So the sync update that follows does not fetch it
+  BOOST_CHECK(!lsdb2.isLsaNew(originRouter, Lsa::Type::NAME, seqNo));
+
+  // It is relayed after the own LSAs of the receiving router
+  auto relayed = lsdb2.getInlineLsas();
+  BOOST_REQUIRE_EQUAL(relayed.size(), 2);
+  BOOST_CHECK_EQUAL(relayed[1]->getName(), inlineLsas[0]->getName());
+
+  // Until it is superseded
+  lsdb.buildAndInstallOwnNameLsa();
+  lsdb2.installLsa(std::make_shared<NameLsa>(*lsdb.findLsa<NameLsa>(originRouter)));
+  BOOST_CHECK_EQUAL(lsdb2.getInlineLsas().size(), 1);
+
+  // Nothing is carried when the LSAs do not fit
+  conf.setSyncInlineLsaSize(10);
+  BOOST_CHECK(lsdb.getInlineLsas().empty());
+}
+
 BOOST_AUTO_TEST_CASE(LsdbRemoveAndExists)
 {
   auto testTimePoint = ndn::time::system_clock::now();
@@ -461,6 +858,170 @@ BOOST_AUTO_TEST_CASE(LsdbSignals)
   checkSignalResult(LsdbUpdate::REMOVED, lsaPtr, {}, {});
 }
 
+BOOST_AUTO_TEST_CASE(RouterMap)
+{
+  auto testTimePoint = ndn::time::system_clock::now() + 3600_s;
+  ndn::Name routerA("/routerA");
+  ndn::Name routerB("/routerB");
+  ndn::Name routerC("/routerC");
+
+  AdjacencyList adjA;
+  adjA.insert(Adjacent(routerB));
+  lsdb.installLsa(std::make_shared<AdjLsa>(routerA, 1, testTimePoint, adjA));
+
+  AdjacencyList adjC;
+  adjC.insert(Adjacent(routerB));
+  lsdb.installLsa(std::make_shared<AdjLsa>(routerC, 1, testTimePoint, adjC));
+
+  const NameMap& map = lsdb.getRouterMap();
+  BOOST_CHECK_EQUAL(map.size(), 3);
+  auto mappingNoC = map.getMappingNoByRouterName(routerC);
+  BOOST_REQUIRE(mappingNoC.has_value());
+
+  // Mapping numbers survive the departure of another router...
+  lsdb.removeLsa(routerA, Lsa::Type::ADJACENCY);
+  BOOST_CHECK_EQUAL(map.size(), 3);
+  BOOST_CHECK(map.getMappingNoByRouterName(routerC) == mappingNoC);
+
+  // ...until most of the registry is stale.
+  lsdb.removeLsa(routerC, Lsa::Type::ADJACENCY);
+  BOOST_CHECK_EQUAL(map.size(), 0);
+  BOOST_CHECK(lsdb.m_routerRefs.empty());
+
+  // Routers dropped from an updated LSA are released too
+  ndn::Name routerD("/routerD");
+  lsdb.installLsa(std::make_shared<AdjLsa>(routerA, 2, testTimePoint, adjA));
+  AdjacencyList adjAD;
+  adjAD.insert(Adjacent(routerD));
+  lsdb.installLsa(std::make_shared<AdjLsa>(routerA, 3, testTimePoint, adjAD));
+  BOOST_CHECK_EQUAL(map.size(), 3);
+  BOOST_CHECK_EQUAL(lsdb.m_routerRefs.size(), 2);
+  BOOST_CHECK_EQUAL(lsdb.m_routerRefs.count(routerB), 0);
+}
+
+BOOST_AUTO_TEST_CASE(BatchedExpiration)
+{
+  ndn::Name routerA("/routerA");
+  ndn::Name routerB("/routerB");
+  ndn::Name routerC("/routerC");
+  NamePrefixList npl{ndn::Name("/prefix")};
+
+  int nRemoved = 0;
+  lsdb.onLsdbModified.connect([&] (auto&&, LsdbUpdate updateType, auto&&, auto&&, auto&&) {
+    if (updateType == LsdbUpdate::REMOVED) {
+      ++nRemoved;
+    }
+  });
+
+  auto now = ndn::time::system_clock::now();
+  lsdb.installLsa(std::make_shared<NameLsa>(routerA, 1, now + 5_s, npl));
+  lsdb.installLsa(std::make_shared<NameLsa>(routerB, 1, now + 5_s, npl));
+  lsdb.installLsa(std::make_shared<NameLsa>(routerC, 1, now + 60_s, npl));
+  BOOST_CHECK_EQUAL(lsdb.m_lsdb.get<Lsdb::byExpiration>().size(), 3);
+
+  // an update moves the deadline of A
+  this->advanceClocks(1_s, 10);
+  lsdb.installLsa(std::make_shared<NameLsa>(routerA, 2, ndn::time::system_clock::now() + 20_s, npl));
+
+  // B expires after its lifetime and the grace period
+  this->advanceClocks(1_s, 4);
+  BOOST_CHECK(lsdb.doesLsaExist(routerB, Lsa::Type::NAME));
+  this->advanceClocks(1_s);
+  BOOST_CHECK(!lsdb.doesLsaExist(routerB, Lsa::Type::NAME));
+  BOOST_CHECK(lsdb.doesLsaExist(routerA, Lsa::Type::NAME));
+  BOOST_CHECK_EQUAL(nRemoved, 1);
+
+  this->advanceClocks(1_s, 25);
+  BOOST_CHECK(!lsdb.doesLsaExist(routerA, Lsa::Type::NAME));
+  BOOST_CHECK(lsdb.doesLsaExist(routerC, Lsa::Type::NAME));
+  BOOST_CHECK_EQUAL(nRemoved, 2);
+}
+
+BOOST_AUTO_TEST_CASE(Snapshots)
+{
+  ndn::Name routerA("/routerA");
+  ndn::Name routerB("/routerB");
+  auto expiration = ndn::time::system_clock::now() + 3600_s;
+
+  lsdb.installLsa(std::make_shared<NameLsa>(routerA, 1, expiration,
+                                            NamePrefixList{ndn::Name("/prefix1")}));
+  auto snapshot = lsdb.getSnapshot();
+  BOOST_CHECK_EQUAL(snapshot->getVersion(), lsdb.getVersion());
+  BOOST_CHECK_EQUAL(snapshot->size(), 1);
+  // shared until the LSDB changes
+  BOOST_CHECK_EQUAL(lsdb.getSnapshot(), snapshot);
+
+  // the update is applied to a copy, the snapshot keeps the old LSA
+  lsdb.installLsa(std::make_shared<NameLsa>(routerA, 2, expiration,
+                                            NamePrefixList{ndn::Name("/prefix2")}));
+  lsdb.installLsa(std::make_shared<NameLsa>(routerB, 1, expiration,
+                                            NamePrefixList{ndn::Name("/prefix3")}));
+  BOOST_REQUIRE_EQUAL(snapshot->getLsas<NameLsa>().size(), 1);
+  auto oldLsa = std::static_pointer_cast<const NameLsa>(snapshot->getLsas<NameLsa>().front());
+  BOOST_CHECK_EQUAL(oldLsa->getSeqNo(), 1);
+  BOOST_CHECK_EQUAL(oldLsa->getNpl(), NamePrefixList{ndn::Name("/prefix1")});
+  BOOST_CHECK_EQUAL(lsdb.findLsa<NameLsa>(routerA)->getSeqNo(), 2);
+  BOOST_CHECK_EQUAL(lsdb.findLsa<NameLsa>(routerA)->getNpl(), NamePrefixList{ndn::Name("/prefix2")});
+
+  auto newSnapshot = lsdb.getSnapshot();
+  BOOST_CHECK_GT(newSnapshot->getVersion(), snapshot->getVersion());
+  BOOST_CHECK_EQUAL(newSnapshot->getLsas<NameLsa>().size(), 2);
+  BOOST_CHECK_EQUAL(newSnapshot->getLsas<AdjLsa>().size(), 0);
+
+  lsdb.removeLsa(routerB, Lsa::Type::NAME);
+  BOOST_CHECK_EQUAL(newSnapshot->size(), 2);
+  BOOST_CHECK_EQUAL(lsdb.getSnapshot()->size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(SnapshotFile)
+{
+  auto stateDir = std::filesystem::temp_directory_path() / "nlsr-test-lsdb-snapshot";
+  std::filesystem::remove_all(stateDir);
+  std::filesystem::create_directories(stateDir);
+  conf.setStateFileDir(stateDir.string());
+  conf.setLsdbSnapshotInterval(60);
+
+  ndn::Name routerA("/routerA");
+  ndn::Name routerB("/routerB");
+  auto expiration = ndn::time::system_clock::now() + 3600_s;
+  {
+    Lsdb previousRun(face, m_keyChain, conf);
+    previousRun.installLsa(std::make_shared<NameLsa>(routerA, 5, expiration,
+                                                     NamePrefixList{ndn::Name("/prefix1")}));
+    previousRun.installLsa(std::make_shared<AdjLsa>(routerB, 7, expiration,
+                                                    conf.getAdjacencyList()));
+    // written at shutdown
+  }
+  BOOST_CHECK(std::filesystem::exists(stateDir / LSDB_SNAPSHOT_FILE));
+
+  {
+    Lsdb restarted(face, m_keyChain, conf);
+    // this router's own Name LSA is not restored
+    BOOST_CHECK_EQUAL(restarted.loadSnapshotFile(), 2);
+    auto nameLsa = restarted.findLsa<NameLsa>(routerA);
+    BOOST_REQUIRE(nameLsa != nullptr);
+    BOOST_CHECK_EQUAL(nameLsa->getSeqNo(), 5);
+    BOOST_CHECK_EQUAL(nameLsa->getNpl(), NamePrefixList{ndn::Name("/prefix1")});
+    BOOST_REQUIRE(restarted.findLsa<AdjLsa>(routerB) != nullptr);
+
+    // sync supersedes the restored LSAs
+    BOOST_CHECK(!restarted.isLsaNew(routerA, Lsa::Type::NAME, 5));
+    BOOST_CHECK(restarted.isLsaNew(routerA, Lsa::Type::NAME, 6));
+    restarted.installLsa(std::make_shared<NameLsa>(routerA, 6, expiration,
+                                                   NamePrefixList{ndn::Name("/prefix2")}));
+    BOOST_CHECK_EQUAL(restarted.findLsa<NameLsa>(routerA)->getNpl(),
+                      NamePrefixList{ndn::Name("/prefix2")});
+  }
+
+  std::ofstream(stateDir / LSDB_SNAPSHOT_FILE, std::ios::binary | std::ios::trunc) << "garbage";
+  {
+    Lsdb restarted(face, m_keyChain, conf);
+    BOOST_CHECK_EQUAL(restarted.loadSnapshotFile(), 0);
+  }
+
+  std::filesystem::remove_all(stateDir);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // TestLsdb
 
 } // namespace nlsr::tests
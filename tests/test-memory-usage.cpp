@@ -0,0 +1,58 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2025,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "memory-usage.hpp"
+#include "tlv-nlsr.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestMemoryUsage)
+
+BOOST_AUTO_TEST_CASE(NameMemory)
+{
+  BOOST_CHECK_EQUAL(getNameMemory(ndn::Name()), 0);
+  BOOST_CHECK_EQUAL(getNameMemory("/ndn/router1"),
+                    2 * sizeof(ndn::name::Component) + 3 + 7);
+}
+
+BOOST_AUTO_TEST_CASE(EncodeDecode)
+{
+  MemoryStatus status;
+  status.addComponent("lsdb", {12, 4096});
+  status.addComponent("fib", {0, 0});
+
+  MemoryStatus decoded(status.wireEncode());
+  BOOST_REQUIRE_EQUAL(decoded.getComponents().size(), 2);
+  const auto& lsdb = decoded.getComponents()[0];
+  BOOST_CHECK_EQUAL(lsdb.name, "lsdb");
+  BOOST_CHECK_EQUAL(lsdb.usage.nElements, 12);
+  BOOST_CHECK_EQUAL(lsdb.usage.nBytes, 4096);
+  BOOST_CHECK_EQUAL(decoded.getComponents()[1].name, "fib");
+  BOOST_CHECK_EQUAL(decoded.getComponents()[1].usage.nBytes, 0);
+
+  BOOST_CHECK_THROW(MemoryStatus(ndn::Block(nlsr::tlv::LatencyStatistics)), MemoryStatus::Error);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "metrics-ingestor.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/io-fixture.hpp"
+
+#include <boost/asio/write.hpp>
+
+#include <unistd.h>
+
+namespace nlsr::tests {
+
+class MetricsIngestorFixture : public IoFixture
+{
+public:
+  MetricsIngestorFixture()
+    : path("/tmp/nlsr-test-metrics-" + std::to_string(::getpid()) + ".sock")
+    , ingestor(m_io, [this] (const auto& entries) { batches.push_back(entries); })
+    , client(m_io)
+  {
+    ingestor.listen(path);
+    client.connect(boost::asio::local::stream_protocol::endpoint(path));
+    advanceClocks(1_ms, 5);
+  }
+
+  void
+  send(const uint8_t* data, size_t size)
+  {
+    boost::asio::write(client, boost::asio::buffer(data, size));
+    advanceClocks(1_ms, 5);
+  }
+
+  void
+  send(const ndn::Block& block)
+  {
+    send(block.data(), block.size());
+  }
+
+  static LinkMetricsEntry
+  makeEntry(const ndn::Name& neighbor, double packetLoss)
+  {
+    LinkMetricsEntry entry;
+    entry.neighbor = neighbor;
+    entry.packetLoss = packetLoss;
+    return entry;
+  }
+
+public:
+  const std::string path;
+  std::vector<std::vector<LinkMetricsEntry>> batches;
+  MetricsIngestor ingestor;
+  boost::asio::local::stream_protocol::socket client;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestMetricsIngestor, MetricsIngestorFixture)
+
+BOOST_AUTO_TEST_CASE(Records)
+{
+  ndn::Block first = makeEntry("/router1", 0.1).wireEncode();
+  ndn::Block second = makeEntry("/router2", 0.2).wireEncode();
+  ndn::Block third = makeEntry("/router3", 0.3).wireEncode();
+
+  // two complete records and the beginning of a third one
+  std::vector<uint8_t> wire(first.begin(), first.end());
+  wire.insert(wire.end(), second.begin(), second.end());
+  wire.insert(wire.end(), third.begin(), third.begin() + 4);
+  send(wire.data(), wire.size());
+
+  BOOST_REQUIRE_EQUAL(batches.size(), 1);
+  BOOST_REQUIRE_EQUAL(batches[0].size(), 2);
+  BOOST_CHECK_EQUAL(batches[0][0].neighbor, "/router1");
+  BOOST_CHECK_EQUAL(batches[0][1].packetLoss.value_or(0), 0.2);
+
+  send(third.data() + 4, third.size() - 4);
+  BOOST_REQUIRE_EQUAL(batches.size(), 2);
+  BOOST_REQUIRE_EQUAL(batches[1].size(), 1);
+  BOOST_CHECK_EQUAL(batches[1][0].neighbor, "/router3");
+  BOOST_CHECK_EQUAL(ingestor.getRecordCount(), 3);
+}
+
+BOOST_AUTO_TEST_CASE(MalformedRecord)
+{
+  send(ndn::Name("/not-metrics").wireEncode());
+  BOOST_CHECK_EQUAL(batches.size(), 0);
+
+  // the connection was closed, so later records are not read
+  boost::system::error_code error;
+  ndn::Block entry = makeEntry("/router1", 0.1).wireEncode();
+  boost::asio::write(client, boost::asio::buffer(entry.data(), entry.size()), error);
+  advanceClocks(1_ms, 5);
+  BOOST_CHECK_EQUAL(batches.size(), 0);
+  BOOST_CHECK_EQUAL(ingestor.getRecordCount(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -0,0 +1,117 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "name-interner.hpp"
+#include "lsa/adj-lsa.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <thread>
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestNameInterner)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  auto& interner = NameInterner::get();
+  size_t nNames = interner.size();
+
+  {
+    InternedName a(ndn::Name("/ndn/site/%C1.Router/router1"));
+    InternedName b(ndn::Name("/ndn/site/%C1.Router/router1"));
+    InternedName c(ndn::Name("/ndn/site/%C1.Router/router2"));
+    BOOST_CHECK_EQUAL(interner.size(), nNames + 2);
+
+    BOOST_CHECK(a == b);
+    BOOST_CHECK(&a.getName() == &b.getName());
+    BOOST_CHECK(a != c);
+    BOOST_CHECK(a < c);
+    BOOST_CHECK(!(c < a));
+    BOOST_CHECK(!(a < b));
+    BOOST_CHECK_EQUAL(std::hash<InternedName>{}(a),
+                      std::hash<ndn::Name>{}(ndn::Name("/ndn/site/%C1.Router/router1")));
+
+    b = ndn::Name("/ndn/site/%C1.Router/router2");
+    BOOST_CHECK(b == c);
+    BOOST_CHECK_EQUAL(interner.size(), nNames + 2);
+  }
+
+  // The names leave the table with their last handle
+  BOOST_CHECK_EQUAL(interner.size(), nNames);
+}
+
+BOOST_AUTO_TEST_CASE(Threads)
+{
+  auto& interner = NameInterner::get();
+  size_t nNames = interner.size();
+
+  // handles are interned and released by several threads at once, as by the calculation jobs
+  std::vector<std::thread> workers;
+  for (int i = 0; i < 4; ++i) {
+    workers.emplace_back([] {
+      for (int j = 0; j < 1000; ++j) {
+        InternedName a(ndn::Name("/ndn/site/%C1.Router/router").appendNumber(j % 10));
+        InternedName b = a;
+      }
+    });
+  }
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  BOOST_CHECK_EQUAL(interner.size(), nNames);
+}
+
+BOOST_AUTO_TEST_CASE(AdjLsdbSavings)
+{
+  // A full mesh of routers, where each router appears in the Adjacency LSAs of all the others
+  const int nRouters = 20;
+  auto routerName = [] (int i) {
+    return ndn::Name("/ndn/site/%C1.Router").append("router" + std::to_string(i));
+  };
+
+  auto before = NameInterner::get().getMemoryReport();
+
+  std::vector<AdjLsa> lsdb;
+  for (int i = 0; i < nRouters; ++i) {
+    AdjacencyList adjacencies;
+    for (int j = 0; j < nRouters; ++j) {
+      if (j != i) {
+        adjacencies.insert(Adjacent(routerName(j)));
+      }
+    }
+    AdjLsa lsa(routerName(i), 1, ndn::time::system_clock::now(), adjacencies);
+    // Without interning, every decoded LSA would hold its own copies of the names
+    lsdb.emplace_back(lsa.wireEncode());
+  }
+
+  auto after = NameInterner::get().getMemoryReport();
+  BOOST_CHECK_EQUAL(after.nNames - before.nNames, static_cast<size_t>(nRouters));
+  BOOST_CHECK_GE(after.nHandles - before.nHandles, static_cast<size_t>(nRouters * nRouters));
+  size_t nameSize = routerName(0).wireEncode().size();
+  BOOST_CHECK_GE(after.nBytesSaved - before.nBytesSaved,
+                 static_cast<size_t>(nRouters * (nRouters - 1)) * nameSize);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
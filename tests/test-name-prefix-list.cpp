@@ -106,6 +106,27 @@ BOOST_AUTO_TEST_CASE(Insert_Erase)
   BOOST_CHECK_EQUAL(list.getSources(name1).size(), 0);
 }
 
+BOOST_AUTO_TEST_CASE(CanonicalOrder)
+{
+  NamePrefixList list;
+  list.insert("/ndn/c", "", 3);
+  list.insert("/ndn/a", "", 1);
+  list.insert("/ndn/b/x", "", 2);
+  list.insert("/ndn/b", "", 4);
+
+  auto prefixes = list.getPrefixes();
+  BOOST_REQUIRE_EQUAL(prefixes.size(), 4);
+  BOOST_CHECK_EQUAL(prefixes[0].getName(), "/ndn/a");
+  BOOST_CHECK_EQUAL(prefixes[1].getName(), "/ndn/b");
+  BOOST_CHECK_EQUAL(prefixes[2].getName(), "/ndn/b/x");
+  BOOST_CHECK_EQUAL(prefixes[3].getName(), "/ndn/c");
+  BOOST_CHECK_EQUAL(list.getPrefixInfoForName("/ndn/b/x").getCost(), 2);
+
+  list.erase("/ndn/b");
+  BOOST_REQUIRE_EQUAL(list.getPrefixes().size(), 3);
+  BOOST_CHECK_EQUAL(list.getPrefixes()[1].getName(), "/ndn/b/x");
+}
+
 /*
   Two NamePrefixLists will be considered equal if they contain the
   same names with the same costs. Sources for names are ignored.
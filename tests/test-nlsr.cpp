@@ -197,10 +197,10 @@ BOOST_AUTO_TEST_CASE(SetEventIntervals)
   Nlsr nlsr2(m_face, m_keyChain, conf);
 
   const Lsdb& lsdb = nlsr2.m_lsdb;
-  const RoutingTable& rt = nlsr2.m_routingTable;
+  RoutingTable& rt = nlsr2.m_routingTable;
 
   BOOST_CHECK_EQUAL(lsdb.m_adjLsaBuildInterval, 3_s);
-  BOOST_CHECK_EQUAL(rt.m_routingCalcInterval, 9_s);
+  BOOST_CHECK_EQUAL(rt.getRoutingCalcDelay(), 9_s);
 }
 
 BOOST_AUTO_TEST_CASE(FaceCreateEvent)
@@ -451,9 +451,9 @@ BOOST_AUTO_TEST_CASE(BuildAdjLsaAfterHelloResponse)
   receiveHelloData(neighborBName, conf.getRouterPrefix());
 
   // Both routers become INACTIVE and HELLO Interests have timed out
-  for (Adjacent& adjacency : neighbors.getAdjList()) {
-    adjacency.setStatus(Adjacent::STATUS_INACTIVE);
-    adjacency.setInterestTimedOutNo(HELLO_RETRIES_DEFAULT);
+  for (const Adjacent& adjacency : neighbors) {
+    neighbors.setStatusOfNeighbor(adjacency.getName(), Adjacent::STATUS_INACTIVE);
+    neighbors.setTimedOutInterestCount(adjacency.getName(), HELLO_RETRIES_DEFAULT);
   }
 
   this->advanceClocks(1_s, 10);
@@ -540,6 +540,41 @@ BOOST_AUTO_TEST_CASE(FaceDatasetProcess)
   BOOST_CHECK_EQUAL(adjList.getAdjacent("/ndn/neighborB").getFaceId(), payload2.getFaceId());
 }
 
+BOOST_AUTO_TEST_CASE(FaceDatasetRegistrationOrder)
+{
+  neighbors.insert(Adjacent("/ndn/neighborA", ndn::FaceUri("udp4://192.168.0.100:6363"),
+                            25, Adjacent::STATUS_INACTIVE, 0, 0));
+  neighbors.insert(Adjacent("/ndn/neighborB", ndn::FaceUri("udp4://192.168.0.101:6363"),
+                            10, Adjacent::STATUS_INACTIVE, 0, 0));
+
+  ndn::nfd::FaceStatus faceA;
+  faceA.setFaceId(1).setRemoteUri("udp4://192.168.0.100:6363");
+  ndn::nfd::FaceStatus faceB;
+  faceB.setFaceId(2).setRemoteUri("udp4://192.168.0.101:6363");
+  ndn::nfd::FaceStatus duplicateA;
+  duplicateA.setFaceId(3).setRemoteUri("udp4://192.168.0.100:6363");
+
+  m_face.sentInterests.clear();
+  nlsr.processFaceDataset({faceA, faceB, duplicateA});
+  this->advanceClocks(10_ms);
+
+  // the first Face with the FaceUri of a neighbor is taken
+  BOOST_CHECK_EQUAL(conf.getAdjacencyList().getAdjacent("/ndn/neighborA").getFaceId(), 1);
+
+  std::vector<ndn::Name> registered;
+  for (const auto& interest : m_face.sentInterests) {
+    if (ndn::Name("/localhost/nfd/rib/register").isPrefixOf(interest.getName())) {
+      ndn::nfd::ControlParameters parameters(interest.getName().get(4).blockFromValue());
+      registered.push_back(parameters.getName());
+    }
+  }
+  // the neighbor prefixes go out ahead of the LSA prefix
+  std::vector<ndn::Name> expected{"/ndn/neighborA", "/ndn/neighborB",
+                                  conf.getLsaPrefix(), conf.getLsaPrefix()};
+  BOOST_CHECK_EQUAL_COLLECTIONS(registered.begin(), registered.end(),
+                                expected.begin(), expected.end());
+}
+
 BOOST_AUTO_TEST_CASE(UnconfiguredNeighbor)
 {
   Adjacent neighborA("/ndn/neighborA", ndn::FaceUri("udp4://192.168.0.100:6363"), 25, Adjacent::STATUS_INACTIVE, 0, 0);
@@ -595,6 +630,117 @@ BOOST_AUTO_TEST_CASE(FaceDatasetPeriodicFetch)
   BOOST_CHECK_EQUAL(nNameMatches, 2);
 }
 
+BOOST_AUTO_TEST_CASE(FaceDatasetFollowEvents)
+{
+  ndn::Name datasetPrefix("/localhost/nfd/faces/list");
+  auto countFetches = [&] {
+    return std::count_if(m_face.sentInterests.begin(), m_face.sentInterests.end(),
+                         [&] (const auto& interest) {
+                           return datasetPrefix.isPrefixOf(interest.getName());
+                         });
+  };
+
+  conf.setFaceDatasetFetchInterval(1);
+  nlsr.processFaceDataset({});
+  m_face.sentInterests.clear();
+
+  // the Face events are followed, so the dataset is only fetched again to check the adjacencies
+  this->advanceClocks(1_s, 5);
+  BOOST_CHECK_EQUAL(countFetches(), 0);
+  this->advanceClocks(1_s);
+  BOOST_CHECK_EQUAL(countFetches(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(ReloadConfChanges)
+{
+  neighbors.insert(Adjacent("/ndn/neighborA", ndn::FaceUri("udp4://192.168.0.100:6363"),
+                            25, Adjacent::STATUS_INACTIVE, 0, 0));
+  neighbors.insert(Adjacent("/ndn/neighborB", ndn::FaceUri("udp4://192.168.0.101:6363"),
+                            10, Adjacent::STATUS_INACTIVE, 0, 0));
+  neighbors.setFaceId("/ndn/neighborB", 2);
+  this->advanceClocks(10_ms);
+  m_face.sentInterests.clear();
+
+  ConfParameter reloaded(m_face, m_keyChain);
+  DummyConfFileProcessor reloadedProcessor(reloaded);
+  reloaded.getAdjacencyList().insert(Adjacent("/ndn/neighborA",
+    ndn::FaceUri("udp4://192.168.0.100:6363"), 30, Adjacent::STATUS_INACTIVE, 0, 0));
+  reloaded.getAdjacencyList().insert(Adjacent("/ndn/neighborC",
+    ndn::FaceUri("udp4://192.168.0.102:6363"), 15, Adjacent::STATUS_INACTIVE, 0, 0));
+  reloaded.setInfoInterestInterval(30);
+  reloaded.setMaxFacesPerPrefix(2);
+  reloaded.setMLAdaptiveRouting(true);
+
+  nlsr.applyConfChanges(reloaded);
+  this->advanceClocks(10_ms);
+
+  BOOST_CHECK_EQUAL(conf.getInfoInterestInterval(), 30);
+  BOOST_CHECK_EQUAL(conf.getMaxFacesPerPrefix(), 2);
+  BOOST_CHECK(conf.getMLAdaptiveRouting());
+
+  BOOST_CHECK_EQUAL(neighbors.size(), 2);
+  BOOST_CHECK(!neighbors.isNeighbor("/ndn/neighborB"));
+  auto neighborA = neighbors.getAdjacent("/ndn/neighborA");
+  BOOST_CHECK_EQUAL(neighborA.getOriginalLinkCost(), 30);
+  BOOST_CHECK_EQUAL(neighborA.getLinkCost(), 30);
+  BOOST_CHECK_EQUAL(neighbors.getStatusOfNeighbor("/ndn/neighborC"), Adjacent::STATUS_INACTIVE);
+
+  // the removed neighbor's prefixes are unregistered, and the new one is matched to its Face
+  bool isUnregistered = false;
+  bool isDatasetFetched = false;
+  for (const auto& interest : m_face.sentInterests) {
+    if (ndn::Name("/localhost/nfd/rib/unregister").isPrefixOf(interest.getName())) {
+      ndn::nfd::ControlParameters parameters(interest.getName().get(4).blockFromValue());
+      isUnregistered |= parameters.getName() == "/ndn/neighborB";
+    }
+    isDatasetFetched |= ndn::Name("/localhost/nfd/faces/list").isPrefixOf(interest.getName());
+  }
+  BOOST_CHECK(isUnregistered);
+  BOOST_CHECK(isDatasetFetched);
+
+  ndn::nfd::FaceStatus faceC;
+  faceC.setFaceId(3).setRemoteUri("udp4://192.168.0.102:6363");
+  nlsr.matchFacesToAdjacencies({faceC});
+  BOOST_CHECK_EQUAL(neighbors.getAdjacent("/ndn/neighborC").getFaceId(), 3);
+
+  // the cost policy follows the routing mode, and is dropped with it
+  auto& linkCostManager = nlsr.getLinkCostManager();
+  const auto& routingTable = nlsr.m_routingTable;
+  using MLPolicy = MLAdaptiveCalculator*;
+  using LoadAwarePolicy = LoadAwareRoutingCalculator*;
+  BOOST_REQUIRE(routingTable.getMLAdaptiveCalculator() != nullptr);
+  BOOST_CHECK(std::get<MLPolicy>(linkCostManager.getCostPolicy()) ==
+              routingTable.getMLAdaptiveCalculator());
+  BOOST_CHECK(linkCostManager.isMLFeedbackEnabled());
+
+  reloaded.setMLAdaptiveRouting(false);
+  nlsr.applyConfChanges(reloaded);
+  BOOST_CHECK(routingTable.getMLAdaptiveCalculator() == nullptr);
+  BOOST_CHECK(std::holds_alternative<std::monostate>(linkCostManager.getCostPolicy()));
+  BOOST_CHECK(!linkCostManager.isMLFeedbackEnabled());
+
+  reloaded.setLoadAwareRouting(true);
+  nlsr.applyConfChanges(reloaded);
+  BOOST_CHECK(std::holds_alternative<LoadAwarePolicy>(linkCostManager.getCostPolicy()));
+  BOOST_CHECK(!linkCostManager.isMLFeedbackEnabled());
+
+  // ML takes over from load-aware, and leaves no load-aware policy behind when disabled
+  reloaded.setMLAdaptiveRouting(true);
+  nlsr.applyConfChanges(reloaded);
+  BOOST_REQUIRE(routingTable.getMLAdaptiveCalculator() != nullptr);
+  BOOST_CHECK(std::get<MLPolicy>(linkCostManager.getCostPolicy()) ==
+              routingTable.getMLAdaptiveCalculator());
+
+  reloaded.setLoadAwareRouting(false);
+  nlsr.applyConfChanges(reloaded);
+  BOOST_CHECK(std::holds_alternative<MLPolicy>(linkCostManager.getCostPolicy()));
+
+  reloaded.setMLAdaptiveRouting(false);
+  nlsr.applyConfChanges(reloaded);
+  BOOST_CHECK(std::holds_alternative<std::monostate>(linkCostManager.getCostPolicy()));
+  BOOST_CHECK(!linkCostManager.isMLFeedbackEnabled());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -0,0 +1,60 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utility/ring-buffer.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+BOOST_AUTO_TEST_SUITE(TestRingBuffer)
+
+BOOST_AUTO_TEST_CASE(PushAndEvict)
+{
+  util::RingBuffer<int, 3> buffer;
+  BOOST_CHECK(buffer.empty());
+  BOOST_CHECK_EQUAL(buffer.capacity(), 3);
+
+  buffer.push_back(1);
+  buffer.push_back(2);
+  BOOST_CHECK_EQUAL(buffer.size(), 2);
+  BOOST_CHECK(!buffer.full());
+  BOOST_CHECK_EQUAL(buffer.front(), 1);
+  BOOST_CHECK_EQUAL(buffer.back(), 2);
+
+  buffer.push_back(3);
+  buffer.push_back(4);
+  BOOST_CHECK(buffer.full());
+  BOOST_CHECK_EQUAL(buffer.size(), 3);
+  BOOST_CHECK_EQUAL(buffer[0], 2);
+  BOOST_CHECK_EQUAL(buffer[1], 3);
+  BOOST_CHECK_EQUAL(buffer[2], 4);
+
+  buffer.clear();
+  BOOST_CHECK(buffer.empty());
+  buffer.push_back(5);
+  BOOST_CHECK_EQUAL(buffer.front(), 5);
+  BOOST_CHECK_EQUAL(buffer.back(), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END() // TestRingBuffer
+
+} // namespace nlsr::tests
@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rtt-histogram.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+using namespace ndn::time_literals;
+
+BOOST_AUTO_TEST_SUITE(TestRttHistogram)
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  RttHistogram histogram;
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5).count(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMax().count(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Quantiles)
+{
+  RttHistogram histogram;
+  // 90 samples of 10 ms, 9 of 20 ms and one of 100 ms
+  for (int i = 0; i < 90; ++i) {
+    histogram.add(10_ms);
+  }
+  for (int i = 0; i < 9; ++i) {
+    histogram.add(20_ms);
+  }
+  histogram.add(100_ms);
+
+  BOOST_CHECK_EQUAL(histogram.getCount(), 100);
+  BOOST_CHECK_EQUAL(histogram.getMax().count(), 100000);
+
+  // each value is recorded within 1/8 of itself
+  auto p50 = histogram.getQuantile(0.5).count();
+  BOOST_CHECK_GE(p50, 10000 * 7 / 8);
+  BOOST_CHECK_LE(p50, 10000 * 9 / 8);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.9).count(), p50);
+  auto p99 = histogram.getQuantile(0.99).count();
+  BOOST_CHECK_GE(p99, 20000 * 7 / 8);
+  BOOST_CHECK_LE(p99, 20000 * 9 / 8);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1.0).count(), 100000);
+}
+
+BOOST_AUTO_TEST_CASE(SmallAndLargeValues)
+{
+  RttHistogram histogram;
+  histogram.add(5_us);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(0.5).count(), 5);
+
+  // values beyond the last bucket are counted in it
+  histogram.add(60_s);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1.0).count(), 60000000);
+  BOOST_CHECK_EQUAL(histogram.getCount(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Reset)
+{
+  RttHistogram histogram;
+  histogram.add(10_ms);
+  histogram.reset();
+  BOOST_CHECK_EQUAL(histogram.getCount(), 0);
+  BOOST_CHECK_EQUAL(histogram.getMax().count(), 0);
+
+  histogram.add(5_us);
+  BOOST_CHECK_EQUAL(histogram.getQuantile(1.0).count(), 5);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
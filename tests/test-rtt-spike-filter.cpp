@@ -0,0 +1,76 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "rtt-spike-filter.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr::tests {
+
+using namespace ndn::time_literals;
+
+BOOST_AUTO_TEST_SUITE(TestRttSpikeFilter)
+
+BOOST_AUTO_TEST_CASE(Spikes)
+{
+  RttSpikeFilter filter(3);
+  RttSpikeFilter::State state;
+
+  for (auto rtt : {20_ms, 21_ms, 19_ms, 20_ms, 22_ms}) {
+    BOOST_CHECK(filter.add(state, rtt) == RttSpikeFilter::Verdict::NORMAL);
+  }
+  BOOST_CHECK_EQUAL(RttSpikeFilter::getMedian(state), 20_ms);
+
+  // jitter within MIN_OUTLIER_RATIO of the median is normal
+  BOOST_CHECK(filter.add(state, 24_ms) == RttSpikeFilter::Verdict::NORMAL);
+
+  // isolated spikes, even two in a row on different sides
+  BOOST_CHECK(filter.add(state, 200_ms) == RttSpikeFilter::Verdict::SPIKE);
+  BOOST_CHECK(filter.add(state, 20_ms) == RttSpikeFilter::Verdict::NORMAL);
+  BOOST_CHECK(filter.add(state, 200_ms) == RttSpikeFilter::Verdict::SPIKE);
+  BOOST_CHECK(filter.add(state, 200_ms) == RttSpikeFilter::Verdict::SPIKE);
+  BOOST_CHECK(filter.add(state, 2_ms) == RttSpikeFilter::Verdict::SPIKE);
+  BOOST_CHECK(filter.add(state, 200_ms) == RttSpikeFilter::Verdict::SPIKE);
+  BOOST_CHECK_EQUAL(RttSpikeFilter::getMedian(state), 20_ms);
+}
+
+BOOST_AUTO_TEST_CASE(LevelShift)
+{
+  RttSpikeFilter filter(3);
+  RttSpikeFilter::State state;
+
+  for (int i = 0; i < 9; ++i) {
+    filter.add(state, 20_ms);
+  }
+  BOOST_CHECK(filter.add(state, 100_ms) == RttSpikeFilter::Verdict::SPIKE);
+  BOOST_CHECK(filter.add(state, 110_ms) == RttSpikeFilter::Verdict::SPIKE);
+  BOOST_CHECK(filter.add(state, 105_ms) == RttSpikeFilter::Verdict::LEVEL_SHIFT);
+  BOOST_CHECK_EQUAL(RttSpikeFilter::getMedian(state), 105_ms);
+
+  // the new level is the reference from now on
+  BOOST_CHECK(filter.add(state, 100_ms) == RttSpikeFilter::Verdict::NORMAL);
+  BOOST_CHECK(filter.add(state, 102_ms) == RttSpikeFilter::Verdict::NORMAL);
+  BOOST_CHECK(filter.add(state, 20_ms) == RttSpikeFilter::Verdict::SPIKE);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
@@ -25,6 +25,7 @@
 
 #include <filesystem>
 #include <fstream>
+#include <iterator>
 #include <system_error>
 
 namespace nlsr::tests {
@@ -40,6 +41,19 @@ public:
     std::filesystem::remove(m_seqFile, ec); // ignore error
   }
 
+  void
+  removeFile()
+  {
+    std::filesystem::remove(m_seqFile);
+  }
+
+  std::string
+  readFile()
+  {
+    std::ifstream inputFile(m_seqFile);
+    return std::string(std::istreambuf_iterator<char>(inputFile), {});
+  }
+
   void
   writeToFile(const std::string& testSeq)
   {
@@ -72,6 +86,7 @@ BOOST_FIXTURE_TEST_SUITE(TestSequencingManager, SequencingManagerFixture)
 
 BOOST_AUTO_TEST_CASE(SeparateSeqNumber)
 {
+  removeFile();
   initiateFromFile();
   checkSeqNumbers(0, 0, 0);
 
@@ -96,6 +111,34 @@ BOOST_AUTO_TEST_CASE(CorruptFile)
   checkSeqNumbers(10, 10, 0);
 }
 
+BOOST_AUTO_TEST_CASE(Lease)
+{
+  removeFile();
+  initiateFromFile();
+  checkSeqNumbers(0, 0, 0);
+  BOOST_CHECK_EQUAL(readFile(), "NameLsaSeqLease 1000\nAdjLsaSeqLease 1000\nCorLsaSeqLease 0");
+
+  for (int i = 0; i < 2500; ++i) {
+    m_seqManager.increaseAdjLsaSeq();
+    m_seqManager.leaseSeqNo();
+  }
+  m_seqManager.increaseNameLsaSeq();
+  m_seqManager.leaseSeqNo();
+
+  // as after a crash, no number handed out is used again
+  initiateFromFile();
+  BOOST_CHECK_GT(m_seqManager.getNameLsaSeq(), 1);
+  BOOST_CHECK_LE(m_seqManager.getNameLsaSeq(), 1 + SequencingManager::SEQ_NO_LEASE);
+  BOOST_CHECK_GT(m_seqManager.getAdjLsaSeq(), 2500);
+  BOOST_CHECK_LE(m_seqManager.getAdjLsaSeq(), 2500 + SequencingManager::SEQ_NO_LEASE);
+  BOOST_CHECK_EQUAL(m_seqManager.getCorLsaSeq(), 0);
+
+  // a lease is not incremented like the numbers written by older versions
+  writeToFile("NameLsaSeqLease 100\nAdjLsaSeqLease 200\nCorLsaSeqLease 0");
+  initiateFromFile();
+  checkSeqNumbers(100, 200, 0);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
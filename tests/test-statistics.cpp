@@ -327,6 +327,30 @@ BOOST_AUTO_TEST_CASE(LsdbReceiveData)
   BOOST_CHECK_EQUAL(collector.getStatistics().get(Statistics::PacketType::RCV_LSA_DATA), 3);
 }
 
+BOOST_AUTO_TEST_CASE(SnapshotDelta)
+{
+  using PacketType = Statistics::PacketType;
+  Statistics stats;
+  stats.increment(PacketType::SENT_HELLO_INTEREST);
+  stats.increment(PacketType::RCV_NAME_LSA_DATA);
+
+  auto earlier = stats.getSnapshot();
+  BOOST_CHECK_EQUAL(earlier[static_cast<size_t>(PacketType::SENT_HELLO_INTEREST)], 1);
+  BOOST_CHECK_EQUAL(earlier[static_cast<size_t>(PacketType::RCV_NAME_LSA_DATA)], 1);
+
+  stats.increment(PacketType::SENT_HELLO_INTEREST);
+  stats.increment(PacketType::SENT_HELLO_INTEREST);
+  auto delta = stats.getDelta(earlier);
+  BOOST_CHECK_EQUAL(delta[static_cast<size_t>(PacketType::SENT_HELLO_INTEREST)], 2);
+  BOOST_CHECK_EQUAL(delta[static_cast<size_t>(PacketType::RCV_NAME_LSA_DATA)], 0);
+
+  stats.resetAll();
+  stats.increment(PacketType::RCV_NAME_LSA_DATA);
+  delta = stats.getDelta(earlier);
+  BOOST_CHECK_EQUAL(delta[static_cast<size_t>(PacketType::SENT_HELLO_INTEREST)], 0);
+  BOOST_CHECK_EQUAL(delta[static_cast<size_t>(PacketType::RCV_NAME_LSA_DATA)], 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -0,0 +1,95 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "timer-wheel.hpp"
+
+#include "tests/boost-test.hpp"
+#include "tests/io-fixture.hpp"
+
+namespace nlsr::tests {
+
+using namespace ndn::time_literals;
+
+class TimerWheelFixture : public IoFixture
+{
+public:
+  TimerWheelFixture()
+    : scheduler(m_io)
+    , wheel(scheduler, 100_ms, 4, [this] (TimerWheel::Key key) { fired.push_back(key); })
+  {
+  }
+
+public:
+  ndn::Scheduler scheduler;
+  TimerWheel wheel;
+  std::vector<TimerWheel::Key> fired;
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTimerWheel, TimerWheelFixture)
+
+BOOST_AUTO_TEST_CASE(Expiration)
+{
+  wheel.schedule(0, 250_ms);
+  wheel.schedule(3, 1_s); // more than one rotation
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  advanceClocks(10_ms, 24);
+  BOOST_CHECK(fired.empty());
+  advanceClocks(10_ms, 8);
+  BOOST_REQUIRE_EQUAL(fired.size(), 1);
+  BOOST_CHECK_EQUAL(fired[0], 0);
+  BOOST_CHECK(!wheel.isScheduled(0));
+  BOOST_CHECK(wheel.isScheduled(3));
+
+  advanceClocks(10_ms, 66);
+  BOOST_CHECK_EQUAL(fired.size(), 1);
+  advanceClocks(10_ms, 12);
+  BOOST_REQUIRE_EQUAL(fired.size(), 2);
+  BOOST_CHECK_EQUAL(fired[1], 3);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(RescheduleAndCancel)
+{
+  wheel.schedule(0, 200_ms);
+  wheel.schedule(1, 200_ms);
+  wheel.schedule(2, 200_ms);
+  wheel.schedule(0, 500_ms); // replaces the first timer of key 0
+  wheel.cancel(1);
+  BOOST_CHECK_EQUAL(wheel.size(), 2);
+
+  advanceClocks(10_ms, 40);
+  BOOST_REQUIRE_EQUAL(fired.size(), 1);
+  BOOST_CHECK_EQUAL(fired[0], 2);
+  advanceClocks(10_ms, 20);
+  BOOST_REQUIRE_EQUAL(fired.size(), 2);
+  BOOST_CHECK_EQUAL(fired[1], 0);
+
+  wheel.schedule(1, 100_ms);
+  wheel.cancelAll();
+  advanceClocks(10_ms, 30);
+  BOOST_CHECK_EQUAL(fired.size(), 2);
+  BOOST_CHECK_EQUAL(wheel.size(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace nlsr::tests
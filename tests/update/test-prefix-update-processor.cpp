@@ -20,6 +20,7 @@
  */
 
 #include "update/prefix-update-processor.hpp"
+#include "update/prefix-update-commands.hpp"
 #include "nlsr.hpp"
 
 #include "tests/io-key-chain-fixture.hpp"
@@ -169,7 +170,8 @@ BOOST_AUTO_TEST_CASE(Basic)
 
   face.receive(advertiseInterest);
 
-  this->advanceClocks(ndn::time::milliseconds(10));
+  // the Name LSA is built after name-lsa-build-interval
+  this->advanceClocks(ndn::time::milliseconds(10), 10);
 
   NamePrefixList& namePrefixList = conf.getNamePrefixList();
 
@@ -189,7 +191,7 @@ BOOST_AUTO_TEST_CASE(Basic)
                                                     ndn::security::signingByIdentity(opIdentity));
 
   face.receive(withdrawInterest);
-  this->advanceClocks(ndn::time::milliseconds(10));
+  this->advanceClocks(ndn::time::milliseconds(10), 10);
 
   BOOST_CHECK_EQUAL(namePrefixList.size(), 0);
 
@@ -197,6 +199,46 @@ BOOST_AUTO_TEST_CASE(Basic)
   BOOST_CHECK(nameLsaSeqNoBeforeInterest < nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq());
 }
 
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  ndn::security::InterestSigner signer(m_keyChain);
+  auto sendBatch = [&] (const std::string& verb, const ndn::Name& batch) {
+    ndn::nfd::ControlParameters parameters;
+    parameters.setName(batch);
+    ndn::Name command("/localhost/nlsr/prefix-update");
+    command.append(verb).append(ndn::tlv::GenericNameComponent, parameters.wireEncode());
+    face.receive(signer.makeCommandInterest(command, ndn::security::signingByIdentity(opIdentity)));
+    this->advanceClocks(ndn::time::milliseconds(10), 10);
+  };
+
+  std::vector<ndn::Name> prefixes;
+  for (int i = 0; i < 100; ++i) {
+    prefixes.push_back(ndn::Name("/prefix").appendNumber(i));
+  }
+  auto decoded = update::decodePrefixBatch(update::encodePrefixBatch(prefixes));
+  BOOST_CHECK_EQUAL_COLLECTIONS(decoded.begin(), decoded.end(), prefixes.begin(), prefixes.end());
+
+  // a single Name LSA for all prefixes
+  uint64_t nameLsaSeqNo = nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq();
+  sendBatch("advertise-batch", update::encodePrefixBatch(prefixes));
+  BOOST_CHECK_EQUAL(namePrefixList.size(), 100);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNo + 1);
+  BOOST_CHECK(wasRoutingUpdatePublished());
+
+  // none when nothing changes
+  sendBatch("advertise-batch", update::encodePrefixBatch({prefixes.begin(), prefixes.begin() + 10}));
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNo + 1);
+
+  sendBatch("withdraw-batch", update::encodePrefixBatch({prefixes.begin() + 10, prefixes.end()}));
+  BOOST_CHECK_EQUAL(namePrefixList.size(), 10);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNo + 2);
+
+  // a malformed batch is rejected as a whole
+  sendBatch("withdraw-batch", "/prefix/10");
+  BOOST_CHECK_EQUAL(namePrefixList.size(), 10);
+  BOOST_CHECK_EQUAL(nlsr.m_lsdb.m_sequencingManager.getNameLsaSeq(), nameLsaSeqNo + 2);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -20,6 +20,7 @@
  */
 
 #include "update/prefix-update-processor.hpp"
+#include "update/prefix-update-commands.hpp"
 #include "conf-parameter.hpp"
 #include "nlsr.hpp"
 
@@ -33,6 +34,7 @@
 #include <boost/property_tree/info_parser.hpp>
 
 #include <filesystem>
+#include <thread>
 
 namespace nlsr::tests {
 
@@ -230,6 +232,75 @@ BOOST_AUTO_TEST_CASE(PrefixStillSavedAfterJustWithdrawn)
   BOOST_CHECK_EQUAL(checkPrefix("/prefix/to/save"), false);
 }
 
+BOOST_AUTO_TEST_CASE(SaveBatch)
+{
+  auto& processor = nlsr.m_prefixUpdateProcessor;
+  // prefixes of the original configuration are known as saved
+  BOOST_CHECK(processor.checkForPrefixInFile("/ndn/edu/memphis/cs/netlab"));
+  BOOST_CHECK(!processor.checkForPrefixInFile("/prefix/0"));
+
+  std::vector<ndn::Name> prefixes;
+  for (int i = 0; i < 50; ++i) {
+    prefixes.push_back(ndn::Name("/prefix").appendNumber(i));
+  }
+  ndn::nfd::ControlParameters parameters;
+  parameters.setName(update::encodePrefixBatch(prefixes));
+  parameters.setFlags(update::PREFIX_FLAG);
+  ndn::Name command("/localhost/nlsr/prefix-update/advertise-batch");
+  command.append(ndn::tlv::GenericNameComponent, parameters.wireEncode());
+  ndn::security::InterestSigner signer(m_keyChain);
+  face.receive(signer.makeCommandInterest(command, ndn::security::signingByIdentity(opIdentity)));
+  this->advanceClocks(ndn::time::milliseconds(10));
+
+  BOOST_CHECK_EQUAL(getResponseCode(), 205);
+  BOOST_CHECK(checkPrefix("/prefix/%00"));
+  BOOST_CHECK(checkPrefix(ndn::Name("/prefix").appendNumber(49).toUri()));
+  BOOST_CHECK(checkPrefix("/ndn/edu/memphis/cs/netlab"));
+  BOOST_CHECK(!std::filesystem::exists(testConfFile + ".tmp"));
+
+  auto [isDeleted, message] = processor.addOrDeletePrefixes({prefixes.begin(), prefixes.begin() + 49},
+                                                           false);
+  BOOST_CHECK(isDeleted);
+  BOOST_CHECK(!checkPrefix("/prefix/%00"));
+  BOOST_CHECK(checkPrefix(ndn::Name("/prefix").appendNumber(49).toUri()));
+
+  // the remaining prefixes are still applied when one is not saved
+  std::tie(isDeleted, message) = processor.addOrDeletePrefixes({prefixes[0], prefixes[49]}, false);
+  BOOST_CHECK(!isDeleted);
+  BOOST_CHECK(!checkPrefix(ndn::Name("/prefix").appendNumber(49).toUri()));
+  BOOST_CHECK(checkPrefix("/ndn/edu/memphis/cs/netlab"));
+}
+
+BOOST_AUTO_TEST_CASE(SaveOnWriterThread)
+{
+  nlsr.m_prefixUpdateProcessor.enableWriterThread();
+  auto waitForResponse = [this] {
+    for (int i = 0; i < 1000 && face.sentData.empty(); ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      advanceClocks(1_ms);
+    }
+    BOOST_REQUIRE(!face.sentData.empty());
+  };
+
+  face.receive(advertiseWithdraw("/prefix/to/save", "advertise", true));
+  waitForResponse();
+  BOOST_CHECK_EQUAL(getResponseCode(), 205);
+  BOOST_CHECK(checkPrefix("/prefix/to/save"));
+  face.sentData.clear();
+
+  // answered right away when the file is unchanged
+  face.receive(advertiseWithdraw("/prefix/to/save", "advertise", true));
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(getResponseCode(), 500);
+  face.sentData.clear();
+
+  face.receive(advertiseWithdraw("/prefix/to/save", "withdraw", true));
+  waitForResponse();
+  BOOST_CHECK_EQUAL(getResponseCode(), 205);
+  BOOST_CHECK(!checkPrefix("/prefix/to/save"));
+  BOOST_CHECK(checkPrefix("/ndn/edu/memphis/cs/netlab"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace nlsr::tests
@@ -0,0 +1,345 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2024,  The University of Memphis,
+ *                           Regents of the University of California,
+ *                           Arizona Board of Regents.
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file nlsr-replay.cpp
+
+  Plays a link sample trace, recorded by NLSR with link-sample-trace, back through a
+  LinkCostManager and one cost calculator, on a virtual clock. The neighbors and the cost
+  settings come from an NLSR configuration file; samples of neighbors it does not list are
+  skipped. The virtual clock is advanced in ticks between samples, so that cost update
+  windows, flap damping and routing calculation throttling behave as they did live, but the
+  replay runs as fast as the samples can be processed.
+
+  Reported are the cost changes of each link, the routing calculations triggered, and for the
+  ML-adaptive calculator its prediction error. The ML time patterns follow the wall clock,
+  not the virtual clock.
+ */
+
+#include "conf-file-processor.hpp"
+#include "link-cost-manager.hpp"
+#include "link-sample-trace.hpp"
+#include "route/load-aware-routing-calculator.hpp"
+#include "route/ml-adaptive-calculator.hpp"
+
+#include <ndn-cxx/security/key-chain.hpp>
+#include <ndn-cxx/util/dummy-client-face.hpp>
+#include <ndn-cxx/util/time-unit-test-clock.hpp>
+
+#include <boost/asio/io_context.hpp>
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+
+namespace nlsr::replay {
+
+namespace time = ndn::time;
+
+static void
+printUsage(std::ostream& os, const std::string& programName)
+{
+  os << "Usage: " << programName << " [OPTIONS...] TRACE\n"
+     << "\n"
+     << "Options:\n"
+     << "    -f <FILE>   Path to configuration file (default: nlsr.conf)\n"
+     << "    -c <NAME>   Cost calculator: ml, load-aware or rtt (default: ml)\n"
+     << "    -t <MS>     Virtual clock tick in milliseconds (default: 10)\n"
+     << "    -h          Display this help message\n"
+     << std::endl;
+}
+
+/*! \brief Installs virtual clocks for the lifetime of the object.
+ *
+ *  A base class of Replay, so that the clocks are installed before the face and the
+ *  scheduler are created.
+ */
+class VirtualClocks
+{
+protected:
+  VirtualClocks()
+    : m_steadyClock(std::make_shared<time::UnitTestSteadyClock>())
+    , m_systemClock(std::make_shared<time::UnitTestSystemClock>())
+  {
+    time::setCustomClocks(m_steadyClock, m_systemClock);
+  }
+
+  ~VirtualClocks()
+  {
+    time::setCustomClocks(nullptr, nullptr);
+  }
+
+  void
+  advanceClocks(time::nanoseconds t)
+  {
+    m_steadyClock->advance(t);
+    m_systemClock->advance(t);
+  }
+
+private:
+  std::shared_ptr<time::UnitTestSteadyClock> m_steadyClock;
+  std::shared_ptr<time::UnitTestSystemClock> m_systemClock;
+};
+
+class Replay : private VirtualClocks
+{
+public:
+  Replay(const std::string& configFileName, time::milliseconds tick)
+    : m_keyChain("pib-memory:", "tpm-memory:")
+    , m_face(m_io, m_keyChain, {true, true})
+    , m_scheduler(m_io)
+    , m_conf(m_face, m_keyChain, configFileName)
+    , m_tick(tick)
+  {
+  }
+
+  bool
+  loadConfiguration()
+  {
+    ConfFileProcessor processor(m_conf);
+    if (!processor.processConfFile()) {
+      return false;
+    }
+    // samples come from the trace only
+    m_conf.setRttSource(RttSource::HELLO);
+    m_conf.setLinkSampleTracePath("");
+    m_conf.setMetricsSocketPath("");
+    m_conf.setFaceCounterInterval(0);
+    // the calculator of the replay is the cost policy, not one created by the routing table
+    m_conf.setLoadAwareRouting(false);
+    m_conf.setMLAdaptiveRouting(false);
+
+    m_fib = std::make_unique<Fib>(m_face, m_scheduler, m_conf.getAdjacencyList(), m_conf, m_keyChain);
+    m_lsdb = std::make_unique<Lsdb>(m_face, m_keyChain, m_conf);
+    m_routingTable = std::make_unique<RoutingTable>(m_scheduler, *m_lsdb, m_conf);
+    m_linkCostManager = std::make_unique<LinkCostManager>(m_face, m_keyChain, m_conf,
+                                                          m_conf.getAdjacencyList(), *m_lsdb,
+                                                          *m_routingTable, *m_fib);
+    m_linkCostManager->initialize();
+    m_linkCostManager->start();
+    return true;
+  }
+
+  void
+  run(LinkSampleReader& reader, const std::string& calculatorName)
+  {
+    std::unique_ptr<LoadAwareRoutingCalculator> loadAware;
+    std::unique_ptr<MLAdaptiveCalculator> ml;
+    if (calculatorName == "load-aware") {
+      loadAware = std::make_unique<LoadAwareRoutingCalculator>(*m_linkCostManager);
+    }
+    else if (calculatorName == "ml") {
+      ml = std::make_unique<MLAdaptiveCalculator>(*m_linkCostManager);
+    }
+
+    auto wallStart = std::chrono::steady_clock::now();
+    auto start = time::steady_clock::now();
+    while (auto sample = reader.next()) {
+      advance(start + sample->time - time::steady_clock::now());
+      apply(*sample);
+    }
+    // let pending cost updates and calculations run
+    advance(time::seconds(m_conf.getRoutingCalcInterval()) + time::seconds(1));
+    auto wallTime = std::chrono::steady_clock::now() - wallStart;
+
+    printReport(time::steady_clock::now() - start, wallTime, ml.get());
+  }
+
+private:
+  void
+  advance(time::nanoseconds total)
+  {
+    while (total > time::nanoseconds::zero()) {
+      auto t = std::min<time::nanoseconds>(m_tick, total);
+      advanceClocks(t);
+      total -= t;
+      if (m_io.stopped()) {
+        m_io.restart();
+      }
+      m_io.poll();
+    }
+  }
+
+  void
+  apply(const LinkSample& sample)
+  {
+    auto& adjacencies = m_conf.getAdjacencyList();
+    auto adjacent = adjacencies.findAdjacent(sample.neighbor);
+    if (adjacent == adjacencies.end()) {
+      ++m_nUnknown;
+      return;
+    }
+
+    switch (sample.type) {
+      case LinkSample::Type::RTT:
+        ++m_nRtt;
+        m_linkCostManager->onHelloRttMeasured(sample.neighbor, sample.rtt);
+        break;
+      case LinkSample::Type::HELLO_TIMEOUT:
+        ++m_nTimeouts;
+        m_linkCostManager->onHelloTimeout(sample.neighbor, sample.value);
+        break;
+      case LinkSample::Type::STATUS: {
+        ++m_nStatus;
+        // as HelloProtocol does before notifying LinkCostManager
+        auto status = static_cast<Adjacent::Status>(sample.value);
+        adjacent->setStatus(status);
+        m_linkCostManager->onNeighborStatusChanged(sample.neighbor, status);
+        break;
+      }
+      case LinkSample::Type::CONGESTION:
+        ++m_nCongestion;
+        m_linkCostManager->onCongestionSample(sample.neighbor, sample.value != 0);
+        break;
+      case LinkSample::Type::EXTERNAL_METRICS: {
+        ++m_nMetrics;
+        LinkCostManager::ExternalMetrics metrics;
+        metrics.bandwidth = sample.bandwidth;
+        metrics.bandwidthUtil = sample.bandwidthUtil;
+        metrics.packetLoss = sample.packetLoss;
+        metrics.spectrumStrength = sample.spectrumStrength;
+        m_linkCostManager->setExternalMetrics(sample.neighbor, metrics);
+        break;
+      }
+    }
+  }
+
+  void
+  printReport(time::nanoseconds virtualTime, std::chrono::steady_clock::duration wallTime,
+              const MLAdaptiveCalculator* ml) const
+  {
+    using namespace std::chrono;
+    std::cout << "Samples: " << m_nRtt << " RTT, " << m_nTimeouts << " Hello timeout, "
+              << m_nStatus << " status, " << m_nCongestion << " congestion, "
+              << m_nMetrics << " external metrics; " << m_nUnknown << " of unknown neighbors\n"
+              << "Virtual time: " << time::duration_cast<time::seconds>(virtualTime).count()
+              << " s, replayed in " << duration_cast<milliseconds>(wallTime).count() << " ms\n";
+
+    uint64_t nRoutingCalculations = 0;
+    for (const auto& phase : m_routingTable->getCalculationProfile().getStatus().getPhases()) {
+      if (phase.phase == CalculationProfile::getPhaseName(CalculationProfile::PHASE_TOTAL)) {
+        nRoutingCalculations = phase.count;
+      }
+    }
+    std::cout << "Routing calculations: " << nRoutingCalculations << "\n";
+
+    uint64_t nCostChanges = 0;
+    std::cout << "Links:\n";
+    for (const auto& stats : m_linkCostManager->getLinkCostStatistics()) {
+      nCostChanges += stats.nCostChanges;
+      std::cout << "  " << stats.neighbor << ": " << stats.nSamples << " samples, "
+                << stats.nCostChanges << " cost changes, final cost "
+                << m_linkCostManager->getLinkCost(stats.neighbor).value_or(0) << "\n";
+    }
+    std::cout << "Cost changes: " << nCostChanges << "\n";
+
+    if (ml != nullptr) {
+      const auto& mlStats = ml->getStatistics();
+      std::cout << "ML predictions: " << mlStats.predictionCount
+                << ", model updates: " << mlStats.modelUpdateCount
+                << ", average prediction error: " << std::fixed << std::setprecision(4)
+                << mlStats.averagePredictionError << "\n";
+    }
+  }
+
+private:
+  boost::asio::io_context m_io;
+  ndn::KeyChain m_keyChain;
+  ndn::DummyClientFace m_face;
+  ndn::Scheduler m_scheduler;
+  ConfParameter m_conf;
+  time::milliseconds m_tick;
+
+  std::unique_ptr<Fib> m_fib;
+  std::unique_ptr<Lsdb> m_lsdb;
+  std::unique_ptr<RoutingTable> m_routingTable;
+  std::unique_ptr<LinkCostManager> m_linkCostManager;
+
+  uint64_t m_nRtt = 0;
+  uint64_t m_nTimeouts = 0;
+  uint64_t m_nStatus = 0;
+  uint64_t m_nCongestion = 0;
+  uint64_t m_nMetrics = 0;
+  uint64_t m_nUnknown = 0;
+};
+
+} // namespace nlsr::replay
+
+int
+main(int argc, char** argv)
+{
+  std::string programName(argv[0]);
+  std::string configFileName("nlsr.conf");
+  std::string calculator("ml");
+  long tickMs = 10;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "hf:c:t:")) != -1) {
+    switch (opt) {
+    case 'h':
+      nlsr::replay::printUsage(std::cout, programName);
+      return 0;
+    case 'f':
+      configFileName = optarg;
+      break;
+    case 'c':
+      calculator = optarg;
+      break;
+    case 't':
+      tickMs = std::strtol(optarg, nullptr, 10);
+      break;
+    default:
+      nlsr::replay::printUsage(std::cerr, programName);
+      return 2;
+    }
+  }
+  if (optind != argc - 1 || tickMs <= 0 ||
+      (calculator != "ml" && calculator != "load-aware" && calculator != "rtt")) {
+    nlsr::replay::printUsage(std::cerr, programName);
+    return 2;
+  }
+
+  std::ifstream trace(argv[optind], std::ios::binary);
+  if (!trace) {
+    std::cerr << "Cannot open " << argv[optind] << std::endl;
+    return 1;
+  }
+
+  try {
+    nlsr::LinkSampleReader reader(trace);
+    nlsr::replay::Replay replay(configFileName, ndn::time::milliseconds(tickMs));
+    if (!replay.loadConfiguration()) {
+      std::cerr << "Error in configuration file processing" << std::endl;
+      return 2;
+    }
+    replay.run(reader, calculator);
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: " << e.what() << std::endl;
+    return 1;
+  }
+  return 0;
+}
@@ -24,6 +24,8 @@
 #include "config.hpp"
 #include "version.hpp"
 #include "src/publisher/dataset-interest-handler.hpp"
+#include "src/tlv-nlsr.hpp"
+#include "src/update/prefix-update-commands.hpp"
 
 #include <ndn-cxx/data.hpp>
 #include <ndn-cxx/encoding/block.hpp>
@@ -41,7 +43,13 @@
 #include <boost/algorithm/string/replace.hpp>
 #include <boost/property_tree/info_parser.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
+#include <set>
+#include <sstream>
 
 namespace nlsrc {
 
@@ -49,16 +57,37 @@ const ndn::Name LOCALHOST_PREFIX("/localhost");
 const ndn::PartialName LSDB_SUFFIX("nlsr/lsdb");
 const ndn::PartialName NAME_UPDATE_SUFFIX("nlsr/prefix-update");
 const ndn::PartialName RT_SUFFIX("nlsr/routing-table");
+const ndn::PartialName RT_CHANGES_SUFFIX("nlsr/routing-table-changes");
+const ndn::PartialName CALC_PROFILE_SUFFIX("nlsr/routing-calc-profile");
+const ndn::PartialName TOPOLOGY_SUFFIX("nlsr/topology");
+const ndn::PartialName LINK_METRICS_SUFFIX("nlsr/link-metrics");
+const ndn::PartialName LINK_COST_SUFFIX("nlsr/link-cost");
+const ndn::PartialName CONVERGENCE_TRACE_SUFFIX("nlsr/convergence-trace");
+const ndn::PartialName LATENCY_SUFFIX("nlsr/latency/list");
+const ndn::PartialName LATENCY_RESET_SUFFIX("nlsr/latency/reset");
+const ndn::PartialName CONFIG_RELOAD_SUFFIX("nlsr/config/reload");
+const ndn::PartialName MEMORY_SUFFIX("nlsr/memory");
+const ndn::PartialName SET_METRICS_SUFFIX("nlsr/link-cost-manager/set-metrics");
+const ndn::PartialName WHAT_IF_SUFFIX("nlsr/what-if");
 
 const uint32_t ERROR_CODE_TIMEOUT = 10060;
 const uint32_t RESPONSE_CODE_SUCCESS = 200;
 const uint32_t RESPONSE_CODE_NO_EFFECT = 204;
 const uint32_t RESPONSE_CODE_SAVE_OR_DELETE = 205;
+// time allowed to the concurrent dataset fetches of a command, together
+const ndn::time::seconds FETCH_DEADLINE{30};
+// LSAs per page of a filtered lsdb command
+const uint64_t LSDB_PAGE_SIZE = 100;
+// size of the prefixes in a batch command, leaving room for the rest of the command Interest
+const size_t MAX_PREFIX_BATCH_SIZE = 4096;
+// what-if queries take a routing calculation per scenario
+const ndn::time::seconds WHAT_IF_LIFETIME{30};
 
 Nlsrc::Nlsrc(std::string programName, ndn::Face& face)
   : m_programName(std::move(programName))
   , m_routerPrefix(LOCALHOST_PREFIX)
   , m_face(face)
+  , m_scheduler(face.getIoContext())
 {
   disableValidator();
 }
@@ -76,12 +105,50 @@ Nlsrc::printUsage() const
        -k do not verify response (insecure)
 
    COMMAND can be one of the following:
-       lsdb
-           display NLSR lsdb status
+       lsdb [router <name>] [prefix <name>] [type adjacency|coordinate|name] [seq <min>[-<max>]]
+           display NLSR lsdb status; with filters, only the LSAs of the router, the Name LSAs
+           and their prefixes under the prefix, the LSAs of the type, or those in the range of
+           sequence numbers are retrieved, page by page
        routing
            display routing table status
+       routing changes [<version>]
+           display the changes of the routing table since the version, or the whole table when
+           the version is omitted or too old, followed by the current version
        status
-           display all NLSR status (lsdb & routingtable)
+           display all NLSR status (lsdb, routingtable & latency)
+       calc-profile
+           display durations of the routing calculation phases
+       topology
+           display the router graph of the last link-state calculation
+       link-cost
+           display RTT percentiles, probe losses and cost changes of the links to all neighbors
+       convergence-trace [chrome]
+           display the stages reached by the recent routing changes, from the triggering event
+           to the FIB; chrome writes them as Chrome trace JSON, for chrome://tracing or Perfetto
+       latency
+           display latency percentiles of LSA fetches, segment validations, installations
+           of LSAs announced by Sync, and RIB commands
+       latency reset
+           restart the latency histograms
+       config reload
+           parse the configuration file again and apply the changes without a restart
+       whatif CHANGE... [or CHANGE...]...
+           display how the routing table would change, and how many prefixes would be
+           affected, after the changes; scenarios separated by or are evaluated separately
+           CHANGE:
+             link-down <router> <neighbor>           the link goes down
+             link-cost <router> <neighbor> <cost>    the link gets the cost
+             router-down <router>                    all the links of the router go down
+       memory
+           display the approximate memory and element counts of the LSDB, NPT, FIB, link
+           costs and other major data structures
+       watch lsdb|routing|link-cost|latency [interval <seconds>]
+           print what changes in the dataset, with timestamps, every 5 seconds or the
+           interval, until interrupted
+       bench prefix-update|set-metrics <neighbor>|dataset <name> [count <n>] [concurrency <n>]
+           send n requests (1000), n at a time (10), and report the throughput and latency
+           percentiles: advertise and withdraw commands of /nlsrc-bench prefixes, link metrics
+           updates of the neighbor, or fetches of a dataset such as routing-table or lsdb/names
        advertise <name>
            advertise a name prefix through NLSR
        advertise <name> save
@@ -90,6 +157,12 @@ Nlsrc::printUsage() const
            remove a name prefix advertised through NLSR
        withdraw <name> delete
            withdraw and delete the name prefix from the conf file
+       advertise --file <file> [save]
+           advertise the name prefixes listed in a file, one per line, with as few
+           Name LSA updates as possible; save also saves them to the conf file
+       withdraw --file <file> [delete]
+           withdraw the name prefixes listed in a file, one per line, with as few
+           Name LSA updates as possible; delete also deletes them from the conf file
        link-metrics set <neighbor-name> [OPTIONS]
            set external metrics for a neighbor link
            OPTIONS:
@@ -99,6 +172,11 @@ Nlsrc::printUsage() const
              --spectrum <dBm>          spectrum strength in dBm
        link-metrics show <neighbor-name>
            display multi-dimensional cost calculation for a neighbor
+       link-metrics list
+           display the metrics of the links to all neighbors
+       link-metrics load <file>
+           set external metrics for many neighbors in one command; each line of the
+           file is <neighbor-name> [OPTIONS], with the OPTIONS of link-metrics set
 )EOT");
   boost::algorithm::replace_all_copy(std::ostream_iterator<char>(std::cout),
                                      help, "@NLSRC@", m_programName);
@@ -149,21 +227,70 @@ Nlsrc::enableValidator(const std::string& filename)
 void
 Nlsrc::getStatus(const std::string& command)
 {
-  if (command == "lsdb") {
-    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchAdjacencyLsas, this));
-    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchCoordinateLsas, this));
-    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchNameLsas, this));
+  if (command == "lsdb" && m_lsdbQuery) {
+    auto wants = [this] (nlsr::Lsa::Type type) { return !m_lsdbType || *m_lsdbType == type; };
+    m_fetchSteps.push_back([this, wants] {
+      if (wants(nlsr::Lsa::Type::ADJACENCY)) {
+        fetchLsdbPage<nlsr::AdjLsa>(nlsr::dataset::ADJACENCY_COMPONENT, *m_lsdbQuery);
+      }
+      if (wants(nlsr::Lsa::Type::COORDINATE)) {
+        fetchLsdbPage<nlsr::CoordinateLsa>(nlsr::dataset::COORDINATE_COMPONENT, *m_lsdbQuery);
+      }
+      if (wants(nlsr::Lsa::Type::NAME)) {
+        fetchLsdbPage<nlsr::NameLsa>(nlsr::dataset::NAME_COMPONENT, *m_lsdbQuery);
+      }
+    });
+    m_fetchSteps.push_back(std::bind(&Nlsrc::printLsdb, this));
+  }
+  else if (command == "lsdb") {
+    // the datasets are independent, and fetched concurrently
+    m_fetchSteps.push_back([this] {
+      fetchAdjacencyLsas();
+      fetchCoordinateLsas();
+      fetchNameLsas();
+    });
     m_fetchSteps.push_back(std::bind(&Nlsrc::printLsdb, this));
   }
   else if (command == "routing") {
     m_fetchSteps.push_back(std::bind(&Nlsrc::fetchRtables, this));
     m_fetchSteps.push_back(std::bind(&Nlsrc::printRT, this));
   }
+  else if (command == "routing-changes") {
+    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchRtChanges, this));
+    m_fetchSteps.push_back(std::bind(&Nlsrc::printRtChanges, this));
+  }
+  else if (command == "calc-profile") {
+    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchCalculationProfile, this));
+    m_fetchSteps.push_back(std::bind(&Nlsrc::printCalculationProfile, this));
+  }
+  else if (command == "topology") {
+    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchTopology, this));
+    m_fetchSteps.push_back(std::bind(&Nlsrc::printTopology, this));
+  }
+  else if (command == "link-cost") {
+    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchLinkCost, this));
+    m_fetchSteps.push_back(std::bind(&Nlsrc::printLinkCost, this));
+  }
+  else if (command == "convergence-trace") {
+    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchConvergenceTrace, this));
+    m_fetchSteps.push_back(std::bind(&Nlsrc::printConvergenceTrace, this));
+  }
+  else if (command == "latency") {
+    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchLatency, this));
+    m_fetchSteps.push_back(std::bind(&Nlsrc::printLatency, this));
+  }
+  else if (command == "memory") {
+    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchMemory, this));
+    m_fetchSteps.push_back(std::bind(&Nlsrc::printMemory, this));
+  }
   else if (command == "status") {
-    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchAdjacencyLsas, this));
-    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchCoordinateLsas, this));
-    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchNameLsas, this));
-    m_fetchSteps.push_back(std::bind(&Nlsrc::fetchRtables, this));
+    m_fetchSteps.push_back([this] {
+      fetchAdjacencyLsas();
+      fetchCoordinateLsas();
+      fetchNameLsas();
+      fetchRtables();
+      fetchLatency();
+    });
     m_fetchSteps.push_back(std::bind(&Nlsrc::printAll, this));
   }
   runNextStep();
@@ -176,6 +303,23 @@ Nlsrc::dispatch(ndn::span<std::string> subcommand)
     return false;
   }
 
+  if ((subcommand[0] == "advertise" || subcommand[0] == "withdraw") &&
+      subcommand.size() >= 3 && subcommand[1] == "--file") {
+    bool isAdvertise = subcommand[0] == "advertise";
+    switch (subcommand.size()) {
+      case 3:
+        updatePrefixesFromFile(subcommand[2], isAdvertise, false);
+        return true;
+      case 4:
+        if (subcommand[3] != (isAdvertise ? "save" : "delete")) {
+          return false;
+        }
+        updatePrefixesFromFile(subcommand[2], isAdvertise, true);
+        return true;
+    }
+    return false;
+  }
+
   if (subcommand[0] == "advertise") {
     switch (subcommand.size()) {
       case 2:
@@ -207,9 +351,22 @@ Nlsrc::dispatch(ndn::span<std::string> subcommand)
   }
 
   if (subcommand[0] == "link-metrics") {
+    if (subcommand.size() == 2 && subcommand[1] == "list") {
+      m_fetchSteps.push_back(std::bind(&Nlsrc::fetchLinkMetrics, this));
+      m_fetchSteps.push_back(std::bind(&Nlsrc::printLinkMetrics, this));
+      runNextStep();
+      return true;
+    }
     if (subcommand.size() < 3) {
       return false;
     }
+    if (subcommand[1] == "load") {
+      if (subcommand.size() != 3) {
+        return false;
+      }
+      loadLinkMetrics(subcommand[2]);
+      return true;
+    }
     
     if (subcommand[1] == "set") {
       // link-metrics set <neighbor-name> [--bandwidth X] [--bandwidth-util X] ...
@@ -235,7 +392,107 @@ Nlsrc::dispatch(ndn::span<std::string> subcommand)
     return false;
   }
 
-  if (subcommand[0] == "lsdb" || subcommand[0] == "routing" || subcommand[0] == "status") {
+  if (subcommand[0] == "routing" && subcommand.size() > 1) {
+    if (subcommand[1] != "changes" || subcommand.size() > 3) {
+      return false;
+    }
+    if (subcommand.size() == 3) {
+      try {
+        m_rtChangesVersion = std::stoull(subcommand[2]);
+      }
+      catch (const std::exception& e) {
+        std::cerr << "ERROR: Invalid routing table version: " << e.what() << std::endl;
+        return false;
+      }
+    }
+    getStatus("routing-changes");
+    return true;
+  }
+
+  if (subcommand[0] == "bench") {
+    if (!parseBench(subcommand.subspan(1))) {
+      return false;
+    }
+    startBench();
+    return true;
+  }
+
+  if (subcommand[0] == "watch") {
+    static const std::set<std::string> targets{"lsdb", "routing", "link-cost", "latency"};
+    if ((subcommand.size() != 2 && subcommand.size() != 4) || targets.count(subcommand[1]) == 0) {
+      return false;
+    }
+    if (subcommand.size() == 4) {
+      if (subcommand[2] != "interval") {
+        return false;
+      }
+      try {
+        m_watchInterval = ndn::time::seconds(std::stoul(subcommand[3]));
+      }
+      catch (const std::exception& e) {
+        std::cerr << "ERROR: Invalid watch interval: " << e.what() << std::endl;
+        return false;
+      }
+      if (m_watchInterval.count() == 0) {
+        return false;
+      }
+    }
+    watch(subcommand[1]);
+    return true;
+  }
+
+  if (subcommand[0] == "lsdb" && subcommand.size() > 1) {
+    if (!parseLsdbQuery(subcommand.subspan(1))) {
+      return false;
+    }
+    getStatus(subcommand[0]);
+    return true;
+  }
+
+  if (subcommand[0] == "lsdb" || subcommand[0] == "routing" || subcommand[0] == "status" ||
+      subcommand[0] == "calc-profile" || subcommand[0] == "topology" ||
+      subcommand[0] == "link-cost" || subcommand[0] == "memory") {
+    if (subcommand.size() != 1) {
+      return false;
+    }
+    getStatus(subcommand[0]);
+    return true;
+  }
+
+  if (subcommand[0] == "convergence-trace") {
+    if (subcommand.size() == 2 && subcommand[1] == "chrome") {
+      m_wantsChromeTrace = true;
+    }
+    else if (subcommand.size() != 1) {
+      return false;
+    }
+    getStatus(subcommand[0]);
+    return true;
+  }
+
+  if (subcommand[0] == "config") {
+    if (subcommand.size() != 2 || subcommand[1] != "reload") {
+      return false;
+    }
+    sendLocalCommand(CONFIG_RELOAD_SUFFIX, "reload the configuration", "Configuration reloaded");
+    return true;
+  }
+
+  if (subcommand[0] == "whatif") {
+    auto query = parseWhatIf(subcommand.subspan(1));
+    if (!query) {
+      return false;
+    }
+    sendWhatIfQuery(*query);
+    return true;
+  }
+
+  if (subcommand[0] == "latency") {
+    if (subcommand.size() == 2 && subcommand[1] == "reset") {
+      sendLocalCommand(LATENCY_RESET_SUFFIX, "reset the latency histograms",
+                       "Latency histograms reset");
+      return true;
+    }
     if (subcommand.size() != 1) {
       return false;
     }
@@ -245,6 +502,162 @@ Nlsrc::dispatch(ndn::span<std::string> subcommand)
   return false;
 }
 
+bool
+Nlsrc::parseLsdbQuery(ndn::span<std::string> filters)
+{
+  if (filters.size() % 2 != 0) {
+    return false;
+  }
+
+  nlsr::LsdbQuery query;
+  query.pageSize = LSDB_PAGE_SIZE;
+  try {
+    for (size_t i = 0; i < filters.size(); i += 2) {
+      const auto& key = filters[i];
+      const auto& value = filters[i + 1];
+      if (key == "router") {
+        query.originRouter = ndn::Name(value);
+      }
+      else if (key == "prefix") {
+        query.prefix = ndn::Name(value);
+      }
+      else if (key == "type") {
+        static const std::map<std::string, nlsr::Lsa::Type> types{
+          {"adjacency", nlsr::Lsa::Type::ADJACENCY},
+          {"coordinate", nlsr::Lsa::Type::COORDINATE},
+          {"name", nlsr::Lsa::Type::NAME},
+        };
+        auto type = types.find(value);
+        if (type == types.end()) {
+          return false;
+        }
+        m_lsdbType = type->second;
+      }
+      else if (key == "seq") {
+        auto dash = value.find('-');
+        query.minSeqNo = std::stoull(value.substr(0, dash));
+        if (dash != std::string::npos) {
+          query.maxSeqNo = std::stoull(value.substr(dash + 1));
+        }
+      }
+      else {
+        return false;
+      }
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: Invalid lsdb filter: " << e.what() << std::endl;
+    return false;
+  }
+
+  m_lsdbQuery = query;
+  return true;
+}
+
+std::optional<nlsr::WhatIfQuery>
+Nlsrc::parseWhatIf(ndn::span<std::string> args)
+{
+  using Type = nlsr::WhatIfChange::Type;
+
+  nlsr::WhatIfQuery query;
+  query.scenarios.emplace_back();
+  try {
+    for (size_t i = 0; i < args.size();) {
+      if (args[i] == "or") {
+        if (query.scenarios.back().empty()) {
+          return std::nullopt;
+        }
+        query.scenarios.emplace_back();
+        ++i;
+        continue;
+      }
+
+      nlsr::WhatIfChange change;
+      if (args[i] == "link-down" && i + 2 < args.size()) {
+        change.type = Type::LINK_DOWN;
+        change.router = args[i + 1];
+        change.neighbor = args[i + 2];
+        i += 3;
+      }
+      else if (args[i] == "link-cost" && i + 3 < args.size()) {
+        change.type = Type::LINK_COST;
+        change.router = args[i + 1];
+        change.neighbor = args[i + 2];
+        change.cost = std::stod(args[i + 3]);
+        if (!(change.cost >= 0)) {
+          std::cerr << "ERROR: Invalid link cost: " << args[i + 3] << std::endl;
+          return std::nullopt;
+        }
+        i += 4;
+      }
+      else if (args[i] == "router-down" && i + 1 < args.size()) {
+        change.type = Type::ROUTER_DOWN;
+        change.router = args[i + 1];
+        i += 2;
+      }
+      else {
+        return std::nullopt;
+      }
+      query.scenarios.back().push_back(std::move(change));
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: Invalid whatif change: " << e.what() << std::endl;
+    return std::nullopt;
+  }
+
+  if (query.scenarios.back().empty()) {
+    return std::nullopt;
+  }
+  return query;
+}
+
+void
+Nlsrc::sendWhatIfQuery(const nlsr::WhatIfQuery& query)
+{
+  ndn::Name interestName = m_routerPrefix;
+  interestName.append(WHAT_IF_SUFFIX);
+
+  ndn::Interest interest(interestName);
+  interest.setApplicationParameters(query.wireEncode());
+  interest.setMustBeFresh(true);
+  interest.setInterestLifetime(WHAT_IF_LIFETIME);
+
+  m_face.expressInterest(interest,
+    [this, query] (const ndn::Interest&, const ndn::Data& data) {
+      ndn::nfd::ControlResponse response;
+      nlsr::WhatIfResult result;
+      try {
+        response.wireDecode(data.getContent().blockFromValue());
+        if (response.getCode() == RESPONSE_CODE_SUCCESS) {
+          result.wireDecode(response.getBody());
+        }
+      }
+      catch (const std::exception& e) {
+        std::cerr << "ERROR: What-if response decoding error: " << e.what() << std::endl;
+        m_exitCode = 1;
+        return;
+      }
+
+      if (response.getCode() != RESPONSE_CODE_SUCCESS) {
+        std::cerr << "ERROR: " << response.getText() << " (code: " << response.getCode() << ")"
+                  << std::endl;
+        m_exitCode = 1;
+        return;
+      }
+      for (size_t i = 0; i < result.outcomes.size() && i < query.scenarios.size(); ++i) {
+        std::cout << "Scenario " << i + 1 << ":";
+        for (const auto& change : query.scenarios[i]) {
+          std::cout << " " << change << ";";
+        }
+        std::cout << "\n" << result.outcomes[i];
+      }
+      m_exitCode = 0;
+    },
+    std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Nack"),
+    std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Timeout"));
+}
+
 void
 Nlsrc::runNextStep()
 {
@@ -258,6 +671,304 @@ Nlsrc::runNextStep()
   nextStep();
 }
 
+void
+Nlsrc::watch(const std::string& target)
+{
+  m_isWatching = true;
+  m_fetchSteps.push_back([this, target] {
+    if (target == "lsdb") {
+      m_routers.clear();
+      fetchAdjacencyLsas();
+      fetchCoordinateLsas();
+      fetchNameLsas();
+    }
+    else if (target == "routing") {
+      // the first round retrieves the whole table, and the following ones its changes
+      fetchRtChanges();
+    }
+    else if (target == "link-cost") {
+      fetchDataset<nlsr::LinkCostStatistics>(LINK_COST_SUFFIX, [this] (const auto& stats) {
+        m_watchEntries[stats.neighbor.toUri()] = boost::lexical_cast<std::string>(stats);
+      });
+    }
+    else if (target == "latency") {
+      fetchDataset<nlsr::LatencyStatus>(LATENCY_SUFFIX, [this] (const auto& status) {
+        m_watchEntries["latency"] = boost::lexical_cast<std::string>(status);
+      });
+    }
+  });
+  m_fetchSteps.push_back([this, target] {
+    if (target == "lsdb") {
+      for (const auto& [originRouter, router] : m_routers) {
+        auto key = originRouter.toUri();
+        auto addEntry = [&] (const std::string& type, const std::string& lsaString) {
+          if (!lsaString.empty()) {
+            m_watchEntries[key + " " + type] = lsaString;
+          }
+        };
+        addEntry("adjacency", router.adjacencyLsaString);
+        addEntry("coordinate", router.coordinateLsaString);
+        addEntry("name", router.nameLsaString);
+      }
+    }
+    printWatchChanges();
+    m_watchEvent = m_scheduler.schedule(m_watchInterval, [this, target] { watch(target); });
+  });
+  runNextStep();
+}
+
+void
+Nlsrc::printWatchChanges()
+{
+  auto timestamp = "[" + ndn::time::toIsoExtendedString(ndn::time::system_clock::now()) + "] ";
+  auto printEntry = [] (const std::string& entry) {
+    std::cout << entry;
+    if (!entry.empty() && entry.back() != '\n') {
+      std::cout << '\n';
+    }
+  };
+
+  if (!m_rtChangesString.empty()) {
+    std::cout << timestamp;
+    printEntry(m_rtChangesString);
+    m_rtChangesString.clear();
+  }
+
+  for (const auto& [key, entry] : m_watchEntries) {
+    auto previous = m_watchedEntries.find(key);
+    if (previous == m_watchedEntries.end()) {
+      std::cout << timestamp << "Added " << key << ":\n";
+      printEntry(entry);
+    }
+    else if (previous->second != entry) {
+      std::cout << timestamp << "Changed " << key << ":\n";
+      printEntry(entry);
+    }
+  }
+  for (const auto& [key, entry] : m_watchedEntries) {
+    if (m_watchEntries.count(key) == 0) {
+      std::cout << timestamp << "Removed " << key << "\n";
+    }
+  }
+  std::cout << std::flush;
+
+  m_watchedEntries = std::move(m_watchEntries);
+  m_watchEntries.clear();
+}
+
+bool
+Nlsrc::parseBench(ndn::span<std::string> args)
+{
+  if (args.empty()) {
+    return false;
+  }
+  m_bench.target = args[0];
+  size_t nextArg = 1;
+  if (m_bench.target == "set-metrics" || m_bench.target == "dataset") {
+    if (args.size() < 2) {
+      return false;
+    }
+    m_bench.argument = args[1];
+    nextArg = 2;
+  }
+  else if (m_bench.target != "prefix-update") {
+    return false;
+  }
+
+  if ((args.size() - nextArg) % 2 != 0) {
+    return false;
+  }
+  try {
+    for (size_t i = nextArg; i < args.size(); i += 2) {
+      if (args[i] == "count") {
+        m_bench.count = std::stoull(args[i + 1]);
+      }
+      else if (args[i] == "concurrency") {
+        m_bench.concurrency = std::stoull(args[i + 1]);
+      }
+      else {
+        return false;
+      }
+    }
+  }
+  catch (const std::exception& e) {
+    std::cerr << "ERROR: Invalid bench option: " << e.what() << std::endl;
+    return false;
+  }
+  return m_bench.count > 0 && m_bench.concurrency > 0;
+}
+
+void
+Nlsrc::startBench()
+{
+  m_bench.latencies.reserve(m_bench.count);
+  m_bench.startTime = ndn::time::steady_clock::now();
+  for (uint64_t i = 0; i < std::min(m_bench.concurrency, m_bench.count); ++i) {
+    sendBenchRequest();
+  }
+}
+
+void
+Nlsrc::sendBenchRequest()
+{
+  uint64_t seq = m_bench.nSent++;
+  auto sendTime = ndn::time::steady_clock::now();
+  auto onData = [this, sendTime] (const ndn::Interest&, const ndn::Data& data) {
+    onBenchReply(sendTime, data.getContentType() != ndn::tlv::ContentType_Nack);
+  };
+  auto onNack = [this, sendTime] (const ndn::Interest&, const ndn::lp::Nack&) {
+    onBenchReply(sendTime, false);
+  };
+  auto onTimeout = [this, sendTime] (const ndn::Interest&) {
+    onBenchReply(sendTime, false);
+  };
+
+  if (m_bench.target == "prefix-update") {
+    // each prefix is advertised, then withdrawn by the next request
+    ndn::Name prefix("/nlsrc-bench");
+    prefix.appendNumber(seq / 2);
+    ndn::Name::Component verb(seq % 2 == 0 ? "advertise" : "withdraw");
+    m_face.expressInterest(makeNamePrefixUpdate(prefix, verb, false),
+      [this, sendTime] (const ndn::Interest&, const ndn::Data& data) {
+        bool isOk = false;
+        try {
+          ndn::nfd::ControlResponse response(data.getContent().blockFromValue());
+          isOk = response.getCode() == RESPONSE_CODE_SUCCESS ||
+                 response.getCode() == RESPONSE_CODE_NO_EFFECT;
+        }
+        catch (const ndn::tlv::Error&) {
+        }
+        onBenchReply(sendTime, isOk);
+      },
+      onNack, onTimeout);
+  }
+  else if (m_bench.target == "set-metrics") {
+    // alternate between two values, so that every update changes the metrics
+    ndn::Name name = m_routerPrefix;
+    name.append(SET_METRICS_SUFFIX)
+        .append(m_bench.argument)
+        .append("--packet-loss").append(seq % 2 == 0 ? "0" : "0.01");
+    ndn::Interest interest(name);
+    interest.setMustBeFresh(true);
+    m_face.expressInterest(interest, onData, onNack, onTimeout);
+  }
+  else {
+    ndn::Name name = m_routerPrefix;
+    name.append("nlsr").append(ndn::Name(m_bench.argument));
+    auto fetcher = ndn::SegmentFetcher::start(m_face, ndn::Interest(name), *m_validator);
+    fetcher->onComplete.connect([this, sendTime] (const ndn::ConstBufferPtr&) {
+      onBenchReply(sendTime, true);
+    });
+    fetcher->onError.connect([this, sendTime] (uint32_t, const std::string&) {
+      onBenchReply(sendTime, false);
+    });
+  }
+}
+
+void
+Nlsrc::onBenchReply(ndn::time::steady_clock::time_point sendTime, bool isOk)
+{
+  ++m_bench.nReplied;
+  if (isOk) {
+    m_bench.latencies.push_back(ndn::time::steady_clock::now() - sendTime);
+  }
+  else {
+    ++m_bench.nFailed;
+  }
+
+  if (m_bench.nSent < m_bench.count) {
+    sendBenchRequest();
+  }
+  else if (m_bench.nReplied == m_bench.count) {
+    printBenchReport();
+  }
+}
+
+void
+Nlsrc::printBenchReport()
+{
+  using ndn::time::duration_cast;
+  using ndn::time::microseconds;
+
+  auto elapsed = duration_cast<microseconds>(ndn::time::steady_clock::now() - m_bench.startTime);
+  double seconds = std::max<double>(elapsed.count(), 1) / 1e6;
+  auto& latencies = m_bench.latencies;
+  std::sort(latencies.begin(), latencies.end());
+  // nearest-rank percentile, in milliseconds
+  auto percentile = [&latencies] (double p) {
+    if (latencies.empty()) {
+      return 0.0;
+    }
+    auto rank = static_cast<size_t>(std::ceil(p * latencies.size()));
+    return duration_cast<microseconds>(latencies[std::max<size_t>(rank, 1) - 1]).count() / 1e3;
+  };
+
+  std::cout << "Benchmark of " << m_bench.target
+            << (m_bench.argument.empty() ? "" : " " + m_bench.argument) << ": "
+            << m_bench.count << " requests, " << m_bench.concurrency << " at a time\n"
+            << std::fixed << std::setprecision(3)
+            << "  Completed in " << seconds << " s, " << m_bench.nFailed << " failed\n"
+            << std::setprecision(1)
+            << "  Throughput: " << latencies.size() / seconds << " requests/s\n"
+            << std::setprecision(3)
+            << "  Latency (ms): median " << percentile(0.5) << ", 90th " << percentile(0.9)
+            << ", 99th " << percentile(0.99) << ", max " << percentile(1.0) << std::endl;
+
+  if (m_bench.nFailed > 0) {
+    m_exitCode = 1;
+  }
+}
+
+void
+Nlsrc::startFetch(const ndn::Interest& interest,
+                  const std::function<void(const ndn::ConstBufferPtr&)>& onComplete)
+{
+  if (m_nPendingFetches == 0) {
+    m_fetchDeadline = m_scheduler.schedule(FETCH_DEADLINE, [this] {
+      std::cerr << "Request timed out (datasets not retrieved within " << FETCH_DEADLINE
+                << ")" << std::endl;
+      m_exitCode = 1;
+      stopFetches();
+    });
+  }
+  ++m_nPendingFetches;
+
+  auto fetcher = ndn::SegmentFetcher::start(m_face, interest, *m_validator);
+  fetcher->onComplete.connect([this, onComplete] (const ndn::ConstBufferPtr& buf) {
+    onComplete(buf);
+    finishFetch();
+  });
+  fetcher->onError.connect([this] (uint32_t errorCode, const std::string& error) {
+    onTimeout(errorCode, error);
+    // the results would be incomplete
+    stopFetches();
+  });
+  m_fetchers.push_back(std::move(fetcher));
+}
+
+void
+Nlsrc::finishFetch()
+{
+  if (--m_nPendingFetches > 0) {
+    return;
+  }
+  m_fetchers.clear();
+  m_fetchDeadline.cancel();
+  runNextStep();
+}
+
+void
+Nlsrc::stopFetches()
+{
+  for (const auto& fetcher : m_fetchers) {
+    fetcher->stop();
+  }
+  m_fetchers.clear();
+  m_nPendingFetches = 0;
+  m_fetchDeadline.cancel();
+  m_fetchSteps.clear();
+}
+
 void
 Nlsrc::advertiseName(ndn::Name name, bool wantSave)
 {
@@ -274,6 +985,66 @@ Nlsrc::withdrawName(ndn::Name name, bool wantDelete)
   sendNamePrefixUpdate(name, verb, info, wantDelete);
 }
 
+void
+Nlsrc::updatePrefixesFromFile(const std::string& filename, bool isAdvertise, bool flag)
+{
+  std::ifstream input(filename);
+  if (!input) {
+    std::cerr << "ERROR: Cannot open " << filename << std::endl;
+    m_exitCode = 1;
+    return;
+  }
+
+  std::vector<std::vector<ndn::Name>> batches(1);
+  size_t batchSize = 0;
+  std::string line;
+  for (size_t lineNo = 1; std::getline(input, line); ++lineNo) {
+    std::istringstream iss(line);
+    std::string uri;
+    if (!(iss >> uri) || uri[0] == ';' || uri[0] == '#') {
+      continue;
+    }
+
+    ndn::Name prefix;
+    try {
+      prefix = ndn::Name(uri);
+    }
+    catch (const std::exception&) {
+      std::cerr << "ERROR: Invalid name " << uri << " on line " << lineNo << std::endl;
+      m_exitCode = 1;
+      return;
+    }
+
+    // each prefix takes its encoding plus the TLV header of the name component holding it
+    size_t prefixSize = prefix.wireEncode().size() + 4;
+    if (batchSize + prefixSize > MAX_PREFIX_BATCH_SIZE && !batches.back().empty()) {
+      batches.emplace_back();
+      batchSize = 0;
+    }
+    batches.back().push_back(std::move(prefix));
+    batchSize += prefixSize;
+  }
+
+  if (batches.back().empty()) {
+    std::cerr << "ERROR: No name prefixes in " << filename << std::endl;
+    m_exitCode = 1;
+    return;
+  }
+
+  // The batches are sent one after the other, each once the previous one is answered
+  ndn::Name::Component verb(isAdvertise ? "advertise-batch" : "withdraw-batch");
+  for (const auto& prefixes : batches) {
+    std::string info = std::string(isAdvertise ? (flag ? "(Save: " : "(Advertise: ")
+                                               : (flag ? "(Delete: " : "(Withdraw: ")) +
+                       std::to_string(prefixes.size()) + " prefixes from " + filename + ")";
+    auto batch = nlsr::update::encodePrefixBatch(prefixes);
+    m_fetchSteps.push_back([this, batch, verb, info, flag] {
+      sendNamePrefixUpdate(batch, verb, info, flag);
+    });
+  }
+  runNextStep();
+}
+
 void
 Nlsrc::setLinkMetrics(const std::string& neighborName,
                      const std::map<std::string, std::string>& options)
@@ -343,6 +1114,95 @@ Nlsrc::setLinkMetrics(const std::string& neighborName,
     });
 }
 
+void
+Nlsrc::loadLinkMetrics(const std::string& filename)
+{
+  std::ifstream input(filename);
+  if (!input) {
+    std::cerr << "ERROR: Cannot open " << filename << std::endl;
+    m_exitCode = 1;
+    return;
+  }
+
+  nlsr::LinkMetricsCommand command;
+  std::string line;
+  for (size_t lineNo = 1; std::getline(input, line); ++lineNo) {
+    std::istringstream iss(line);
+    std::string neighborName;
+    if (!(iss >> neighborName) || neighborName[0] == ';' || neighborName[0] == '#') {
+      continue;
+    }
+
+    nlsr::LinkMetricsEntry entry;
+    entry.neighbor = neighborName;
+    std::string option, value;
+    while (iss >> option >> value) {
+      try {
+        if (option == "--bandwidth") {
+          entry.bandwidth = std::stod(value);
+        }
+        else if (option == "--bandwidth-util") {
+          entry.bandwidthUtil = std::stod(value);
+        }
+        else if (option == "--packet-loss") {
+          entry.packetLoss = std::stod(value);
+        }
+        else if (option == "--spectrum") {
+          entry.spectrumStrength = std::stod(value);
+        }
+        else {
+          std::cerr << "Warning: Unknown option " << option << " on line " << lineNo << std::endl;
+        }
+      }
+      catch (const std::exception&) {
+        std::cerr << "ERROR: Invalid value " << value << " for " << option
+                  << " on line " << lineNo << std::endl;
+        m_exitCode = 1;
+        return;
+      }
+    }
+    command.addEntry(std::move(entry));
+  }
+
+  if (command.getEntries().empty()) {
+    std::cerr << "ERROR: No neighbors in " << filename << std::endl;
+    m_exitCode = 1;
+    return;
+  }
+
+  ndn::Name interestName = m_routerPrefix;
+  interestName.append(SET_METRICS_SUFFIX);
+
+  ndn::Interest interest(interestName);
+  interest.setApplicationParameters(command.wireEncode());
+  interest.setMustBeFresh(true);
+  interest.setInterestLifetime(ndn::time::seconds(4));
+
+  m_face.expressInterest(interest,
+    [this] (const ndn::Interest&, const ndn::Data& data) {
+      ndn::nfd::ControlResponse response;
+      try {
+        response.wireDecode(data.getContent().blockFromValue());
+      }
+      catch (const std::exception& e) {
+        std::cerr << "ERROR: Control response decoding error" << std::endl;
+        m_exitCode = 1;
+        return;
+      }
+
+      if (response.getCode() != RESPONSE_CODE_SUCCESS) {
+        std::cerr << "ERROR: " << response.getText() << " (code: " << response.getCode() << ")"
+                  << std::endl;
+        m_exitCode = 1;
+        return;
+      }
+      std::cout << response.getText() << std::endl;
+      m_exitCode = 0;
+    },
+    std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Nack"),
+    std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Timeout"));
+}
+
 void
 Nlsrc::showLinkMetrics(const std::string& neighborName)
 {
@@ -520,6 +1380,15 @@ Nlsrc::sendNamePrefixUpdate(const ndn::Name& name,
                             const ndn::Name::Component& verb,
                             const std::string& info,
                             bool flag)
+{
+  m_face.expressInterest(makeNamePrefixUpdate(name, verb, flag),
+                         std::bind(&Nlsrc::onControlResponse, this, info, _2),
+                         std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Nack"),
+                         std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Timeout"));
+}
+
+ndn::Interest
+Nlsrc::makeNamePrefixUpdate(const ndn::Name& name, const ndn::Name::Component& verb, bool flag)
 {
   ndn::nfd::ControlParameters parameters;
   parameters.setName(name);
@@ -533,15 +1402,47 @@ Nlsrc::sendNamePrefixUpdate(const ndn::Name& name,
   commandName.append(verb);
   commandName.append(paramWire.begin(), paramWire.end());
 
+  // one signer, so that the timestamps of consecutive commands increase
+  auto commandInterest = m_signer.makeCommandInterest(commandName,
+                           ndn::security::signingByIdentity(m_keyChain.getPib().getDefaultIdentity()));
+  commandInterest.setMustBeFresh(true);
+  return commandInterest;
+}
+
+void
+Nlsrc::sendLocalCommand(const ndn::PartialName& suffix, const std::string& action,
+                        const std::string& doneMessage)
+{
+  auto paramWire = ndn::nfd::ControlParameters().wireEncode();
+  ndn::Name commandName = m_routerPrefix;
+  commandName.append(suffix);
+  commandName.append(paramWire.begin(), paramWire.end());
+
   ndn::security::InterestSigner signer(m_keyChain);
   auto commandInterest = signer.makeCommandInterest(commandName,
                            ndn::security::signingByIdentity(m_keyChain.getPib().getDefaultIdentity()));
   commandInterest.setMustBeFresh(true);
 
   m_face.expressInterest(commandInterest,
-                         std::bind(&Nlsrc::onControlResponse, this, info, _2),
-                         std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Nack"),
-                         std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Timeout"));
+    [this, action, doneMessage] (const ndn::Interest&, const ndn::Data& data) {
+      try {
+        ndn::nfd::ControlResponse response(data.getContent().blockFromValue());
+        if (response.getCode() != RESPONSE_CODE_SUCCESS) {
+          std::cerr << "ERROR: Cannot " << action << ": " << response.getText()
+                    << " (code: " << response.getCode() << ")" << std::endl;
+          m_exitCode = 1;
+          return;
+        }
+      }
+      catch (const std::exception& e) {
+        std::cerr << "ERROR: Control response decoding error" << std::endl;
+        m_exitCode = 1;
+        return;
+      }
+      std::cout << doneMessage << std::endl;
+    },
+    std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Nack"),
+    std::bind(&Nlsrc::onTimeout, this, ERROR_CODE_TIMEOUT, "Timeout"));
 }
 
 void
@@ -568,12 +1469,19 @@ Nlsrc::onControlResponse(const std::string& info, const ndn::Data& data)
   if (code != RESPONSE_CODE_SUCCESS && code != RESPONSE_CODE_SAVE_OR_DELETE) {
     std::cerr << response.getText() << std::endl;
     std::cerr << "Name prefix update error (code: " << code << ")" << std::endl;
-    m_exitCode = code == RESPONSE_CODE_NO_EFFECT ? 0 : 1;
+    if (code != RESPONSE_CODE_NO_EFFECT) {
+      m_exitCode = 1;
+      return;
+    }
+    m_exitCode = 0;
+    runNextStep();
     return;
   }
 
   std::cout << "Applied Name prefix update successfully: " << info << std::endl;
   m_exitCode = 0;
+  // the next batch of a prefix file, if any
+  runNextStep();
 }
 
 void
@@ -611,11 +1519,39 @@ Nlsrc::fetchFromLsdb(const ndn::Name::Component& datasetType,
   auto name = m_routerPrefix;
   name.append(LSDB_SUFFIX);
   name.append(datasetType);
-  ndn::Interest interest(name);
 
-  auto fetcher = ndn::SegmentFetcher::start(m_face, interest, *m_validator);
-  fetcher->onComplete.connect(std::bind(&Nlsrc::onFetchSuccess<T>, this, _1, recordLsa));
-  fetcher->onError.connect(std::bind(&Nlsrc::onTimeout, this, _1, _2));
+  startFetch(ndn::Interest(name), std::bind(&Nlsrc::onFetchSuccess<T>, this, _1, recordLsa));
+}
+
+template<class T>
+void
+Nlsrc::fetchLsdbPage(const ndn::Name::Component& datasetType, const nlsr::LsdbQuery& query)
+{
+  auto name = m_routerPrefix;
+  name.append(LSDB_SUFFIX);
+  name.append(datasetType);
+  name.append(ndn::tlv::GenericNameComponent, query.wireEncode());
+
+  startFetch(ndn::Interest(name), [this, datasetType, query] (const ndn::ConstBufferPtr& buf) {
+    size_t offset = 0;
+    while (offset < buf->size()) {
+      auto [isOk, block] = ndn::Block::fromBuffer(buf, offset);
+      if (!isOk) {
+        std::cerr << "ERROR: cannot decode LSA TLV" << std::endl;
+        break;
+      }
+      offset += block.size();
+
+      if (block.type() == nlsr::tlv::ContinuationToken) {
+        auto next = query;
+        next.continuation = ndn::Name(block.blockFromValue());
+        // within the same step, which ends after the last page
+        fetchLsdbPage<T>(datasetType, next);
+        continue;
+      }
+      recordLsa(T(block));
+    }
+  });
 }
 
 void
@@ -635,17 +1571,108 @@ Nlsrc::recordLsa(const nlsr::Lsa& lsa)
   }
 }
 
+void
+Nlsrc::fetchCalculationProfile()
+{
+  fetchDataset<nlsr::CalculationProfileStatus>(CALC_PROFILE_SUFFIX, [this] (const auto& status) {
+    std::ostringstream os;
+    os << status;
+    m_calcProfileString = os.str();
+  });
+}
+
+void
+Nlsrc::fetchTopology()
+{
+  fetchDataset<nlsr::TopologyStatus>(TOPOLOGY_SUFFIX, [this] (const auto& status) {
+    std::ostringstream os;
+    os << status;
+    m_topologyString = os.str();
+  });
+}
+
+void
+Nlsrc::fetchLinkMetrics()
+{
+  fetchDataset<nlsr::LinkMetricsEntry>(LINK_METRICS_SUFFIX, [this] (const auto& entry) {
+    std::ostringstream os;
+    os << entry;
+    m_linkMetricsString += os.str();
+  });
+}
+
+void
+Nlsrc::fetchLinkCost()
+{
+  fetchDataset<nlsr::LinkCostStatistics>(LINK_COST_SUFFIX, [this] (const auto& stats) {
+    std::ostringstream os;
+    os << stats;
+    m_linkCostString += os.str();
+  });
+}
+
+void
+Nlsrc::fetchConvergenceTrace()
+{
+  fetchDataset<nlsr::ConvergenceTraceEvent>(CONVERGENCE_TRACE_SUFFIX, [this] (const auto& event) {
+    m_convergenceTrace.push_back(event);
+  });
+}
+
+void
+Nlsrc::fetchLatency()
+{
+  fetchDataset<nlsr::LatencyStatus>(LATENCY_SUFFIX, [this] (const auto& status) {
+    std::ostringstream os;
+    os << status;
+    m_latencyString = os.str();
+  });
+}
+
+void
+Nlsrc::fetchMemory()
+{
+  fetchDataset<nlsr::MemoryStatus>(MEMORY_SUFFIX, [this] (const auto& status) {
+    std::ostringstream os;
+    os << status;
+    m_memoryString = os.str();
+  });
+}
+
+void
+Nlsrc::fetchRtChanges()
+{
+  auto suffix = RT_CHANGES_SUFFIX;
+  if (m_rtChangesVersion) {
+    suffix.appendNumber(*m_rtChangesVersion);
+  }
+  fetchDataset<nlsr::RoutingTableChanges>(suffix, [this] (const auto& changes) {
+    // the next fetch, when watching, asks for the changes since this version
+    m_rtChangesVersion = changes.version;
+    if (m_isWatching && !changes.isSnapshot && changes.delta.empty()) {
+      return;
+    }
+    std::ostringstream os;
+    os << changes;
+    m_rtChangesString = os.str();
+  });
+}
+
 template<class T>
 void
 Nlsrc::fetchFromRt(const std::function<void(const T&)>& recordDataset)
+{
+  fetchDataset<T>(RT_SUFFIX, recordDataset);
+}
+
+template<class T>
+void
+Nlsrc::fetchDataset(const ndn::PartialName& suffix, const std::function<void(const T&)>& recordDataset)
 {
   auto name = m_routerPrefix;
-  name.append(RT_SUFFIX);
-  ndn::Interest interest(name);
+  name.append(suffix);
 
-  auto fetcher = ndn::SegmentFetcher::start(m_face, interest, *m_validator);
-  fetcher->onComplete.connect(std::bind(&Nlsrc::onFetchSuccess<T>, this, _1, recordDataset));
-  fetcher->onError.connect(std::bind(&Nlsrc::onTimeout, this, _1, _2));
+  startFetch(ndn::Interest(name), std::bind(&Nlsrc::onFetchSuccess<T>, this, _1, recordDataset));
 }
 
 template<class T>
@@ -667,8 +1694,6 @@ Nlsrc::onFetchSuccess(const ndn::ConstBufferPtr& buf,
     T dataset(block);
     recordDataset(dataset);
   }
-
-  runNextStep();
 }
 
 void
@@ -723,12 +1748,92 @@ Nlsrc::printRT()
   }
 }
 
+void
+Nlsrc::printCalculationProfile()
+{
+  if (!m_calcProfileString.empty()) {
+    std::cout << m_calcProfileString;
+  }
+  else {
+    std::cout << "Routing Table is not calculated yet" << std::endl;
+  }
+}
+
+void
+Nlsrc::printTopology()
+{
+  if (!m_topologyString.empty()) {
+    std::cout << m_topologyString;
+  }
+  else {
+    std::cout << "Routing Table is not calculated yet" << std::endl;
+  }
+}
+
+void
+Nlsrc::printLinkMetrics()
+{
+  if (!m_linkMetricsString.empty()) {
+    std::cout << "Link Metrics:\n" << m_linkMetricsString;
+  }
+  else {
+    std::cout << "No neighbors configured" << std::endl;
+  }
+}
+
+void
+Nlsrc::printLinkCost()
+{
+  if (!m_linkCostString.empty()) {
+    std::cout << "Link Cost Statistics:\n" << m_linkCostString;
+  }
+  else {
+    std::cout << "No neighbors configured" << std::endl;
+  }
+}
+
+void
+Nlsrc::printConvergenceTrace()
+{
+  if (m_wantsChromeTrace) {
+    nlsr::ConvergenceTracer::writeChromeTrace(std::cout, m_convergenceTrace);
+  }
+  else if (!m_convergenceTrace.empty()) {
+    std::cout << "Convergence Trace:\n";
+    for (const auto& event : m_convergenceTrace) {
+      std::cout << "  " << event << "\n";
+    }
+  }
+  else {
+    std::cout << "No routing change traced yet" << std::endl;
+  }
+}
+
+void
+Nlsrc::printRtChanges()
+{
+  std::cout << m_rtChangesString;
+}
+
+void
+Nlsrc::printLatency()
+{
+  std::cout << m_latencyString;
+}
+
+void
+Nlsrc::printMemory()
+{
+  std::cout << m_memoryString;
+}
+
 void
 Nlsrc::printAll()
 {
   std::cout << "NLSR Status" << std::endl;
   printLsdb();
   printRT();
+  printLatency();
 }
 
 } // namespace nlsrc
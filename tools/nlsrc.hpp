@@ -19,19 +19,31 @@
  * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include "convergence-tracer.hpp"
+#include "latency-statistics.hpp"
 #include "lsa/adj-lsa.hpp"
 #include "lsa/coordinate-lsa.hpp"
 #include "lsa/name-lsa.hpp"
+#include "link-metrics-status.hpp"
+#include "memory-usage.hpp"
+#include "publisher/lsdb-query.hpp"
+#include "route/routing-change-feed.hpp"
+#include "route/what-if.hpp"
 #include "route/routing-table.hpp"
 
 #include <boost/noncopyable.hpp>
 #include <ndn-cxx/face.hpp>
+#include <ndn-cxx/security/interest-signer.hpp>
 #include <ndn-cxx/security/key-chain.hpp>
 #include <ndn-cxx/security/validator.hpp>
+#include <ndn-cxx/util/scheduler.hpp>
+#include <ndn-cxx/util/segment-fetcher.hpp>
 
 #include <deque>
 #include <map>
+#include <optional>
 #include <stdexcept>
+#include <vector>
 
 #ifndef NLSR_TOOLS_NLSRC_HPP
 #define NLSR_TOOLS_NLSRC_HPP
@@ -78,6 +90,22 @@ private:
   void
   runNextStep();
 
+  /**
+   * \brief Starts fetching the dataset named by \p interest
+   *
+   * The fetches started by a step run concurrently, under a shared deadline. The next step
+   * runs once they have all completed.
+   */
+  void
+  startFetch(const ndn::Interest& interest,
+             const std::function<void(const ndn::ConstBufferPtr&)>& onComplete);
+
+  void
+  finishFetch();
+
+  void
+  stopFetches();
+
   /**
    * \brief Adds a name prefix to be advertised in NLSR's Name LSA
    *
@@ -98,6 +126,20 @@ private:
   void
   withdrawName(ndn::Name name, bool wantDelete);
 
+  /**
+   * \brief Advertises or withdraws the name prefixes listed in a file
+   *
+   * The prefixes are sent in as few batch commands as fit in Interests, each of which
+   * makes NLSR build a single Name LSA.
+   *
+   * cmd format:
+   *  advertise --file <file> [save]
+   *  withdraw --file <file> [delete]
+   *
+   */
+  void
+  updatePrefixesFromFile(const std::string& filename, bool isAdvertise, bool flag);
+
   /**
    * \brief Sets external metrics for a neighbor
    *
@@ -119,6 +161,94 @@ private:
   void
   showLinkMetrics(const std::string& neighborName);
 
+  /**
+   * \brief Sets external metrics for all neighbors listed in a file, in one command
+   *
+   * cmd format:
+   *  link-metrics load <file>
+   *
+   */
+  void
+  loadLinkMetrics(const std::string& filename);
+
+  /**
+   * \brief Follows a dataset, printing what changed in it at every interval
+   *
+   * The routing table is followed through its change feed; the LSDB, the link costs and the
+   * latency percentiles are fetched again and compared with the previous round.
+   *
+   * cmd format:
+   *  watch lsdb|routing|link-cost|latency [interval <seconds>]
+   *
+   */
+  void
+  watch(const std::string& target);
+
+  /**
+   * \brief Prints the entries of the watched dataset that were added, changed or removed
+   *         since the previous round
+   */
+  void
+  printWatchChanges();
+
+  /**
+   * \brief Parses the target and options of the bench command into m_bench
+   *
+   * cmd format:
+   *  bench prefix-update|set-metrics <neighbor>|dataset <name> [count <n>] [concurrency <n>]
+   *
+   */
+  bool
+  parseBench(ndn::span<std::string> args);
+
+  /**
+   * \brief Sends the requests of the benchmark, keeping the configured number outstanding,
+   *         then reports the throughput and the latency percentiles
+   */
+  void
+  startBench();
+
+  void
+  sendBenchRequest();
+
+  void
+  onBenchReply(ndn::time::steady_clock::time_point sendTime, bool isOk);
+
+  void
+  printBenchReport();
+
+  /**
+   * \brief Parses the changes of the whatif command into scenarios, separated by "or"
+   *
+   * cmd format:
+   *  whatif link-down <router> <neighbor> | link-cost <router> <neighbor> <cost> |
+   *         router-down <router> ... [or ...]
+   *
+   */
+  static std::optional<nlsr::WhatIfQuery>
+  parseWhatIf(ndn::span<std::string> args);
+
+  /**
+   * \brief Sends a what-if query to the local NLSR, and prints the changes of each scenario
+   */
+  void
+  sendWhatIfQuery(const nlsr::WhatIfQuery& query);
+
+  /**
+   * \brief Sends a command without parameters to the local NLSR, and reports its outcome
+   *
+   * cmd format:
+   *  latency reset
+   *  config reload
+   *
+   */
+  void
+  sendLocalCommand(const ndn::PartialName& suffix, const std::string& action,
+                   const std::string& doneMessage);
+
+  ndn::Interest
+  makeNamePrefixUpdate(const ndn::Name& name, const ndn::Name::Component& verb, bool flag);
+
   void
   sendNamePrefixUpdate(const ndn::Name& name,
                        const ndn::Name::Component& verb,
@@ -143,6 +273,23 @@ private:
   fetchFromLsdb(const ndn::Name::Component& datasetType,
                 const std::function<void(const T&)>& recordLsa);
 
+  /**
+   * \brief Parses the filters of the lsdb command into m_lsdbQuery
+   *
+   * cmd format:
+   *  lsdb [router <name>] [prefix <name>] [type adjacency|coordinate|name] [seq <min>[-<max>]]
+   *
+   */
+  bool
+  parseLsdbQuery(ndn::span<std::string> filters);
+
+  /**
+   * \brief Fetches a page of the LSAs selected by \p query , then the following pages
+   */
+  template<class T>
+  void
+  fetchLsdbPage(const ndn::Name::Component& datasetType, const nlsr::LsdbQuery& query);
+
   void
   recordLsa(const nlsr::Lsa& lsa);
 
@@ -153,6 +300,34 @@ private:
   void
   fetchFromRt(const std::function<void(const T&)>& recordLsa);
 
+  void
+  fetchCalculationProfile();
+
+  void
+  fetchTopology();
+
+  void
+  fetchLinkMetrics();
+
+  void
+  fetchLinkCost();
+
+  void
+  fetchConvergenceTrace();
+
+  void
+  fetchLatency();
+
+  void
+  fetchMemory();
+
+  void
+  fetchRtChanges();
+
+  template<class T>
+  void
+  fetchDataset(const ndn::PartialName& suffix, const std::function<void(const T&)>& recordDataset);
+
   template<class T>
   void
   onFetchSuccess(const ndn::ConstBufferPtr& data,
@@ -170,6 +345,30 @@ private:
   void
   printRT();
 
+  void
+  printCalculationProfile();
+
+  void
+  printTopology();
+
+  void
+  printLinkMetrics();
+
+  void
+  printLinkCost();
+
+  void
+  printConvergenceTrace();
+
+  void
+  printLatency();
+
+  void
+  printMemory();
+
+  void
+  printRtChanges();
+
   void
   printAll();
 
@@ -178,7 +377,9 @@ private:
   ndn::Name m_routerPrefix;
   std::unique_ptr<ndn::security::Validator> m_validator;
   ndn::KeyChain m_keyChain;
+  ndn::security::InterestSigner m_signer{m_keyChain};
   ndn::Face& m_face;
+  ndn::Scheduler m_scheduler;
 
   struct Router
   {
@@ -187,9 +388,47 @@ private:
     std::string nameLsaString;
   };
   std::map<ndn::Name, Router> m_routers;
+  std::optional<nlsr::LsdbQuery> m_lsdbQuery;
+  std::optional<nlsr::Lsa::Type> m_lsdbType;
   std::string m_rtString;
+  std::string m_calcProfileString;
+  std::string m_topologyString;
+  std::string m_linkMetricsString;
+  std::string m_linkCostString;
+  std::vector<nlsr::ConvergenceTraceEvent> m_convergenceTrace;
+  bool m_wantsChromeTrace = false;
+  std::string m_latencyString;
+  std::string m_memoryString;
+  std::optional<uint64_t> m_rtChangesVersion;
+  std::string m_rtChangesString;
+  // entries of the watched dataset by key, fetched in the current and in the previous round
+  std::map<std::string, std::string> m_watchEntries;
+  std::map<std::string, std::string> m_watchedEntries;
+  bool m_isWatching = false;
+  ndn::time::seconds m_watchInterval{5};
+  ndn::scheduler::ScopedEventId m_watchEvent;
   std::deque<std::function<void()>> m_fetchSteps;
 
+  struct Bench
+  {
+    std::string target;
+    // neighbor of set-metrics, or name of the dataset
+    std::string argument;
+    uint64_t count = 1000;
+    uint64_t concurrency = 10;
+    uint64_t nSent = 0;
+    uint64_t nReplied = 0;
+    uint64_t nFailed = 0;
+    ndn::time::steady_clock::time_point startTime;
+    // of the successful requests
+    std::vector<ndn::time::nanoseconds> latencies;
+  };
+  Bench m_bench;
+  // fetches of the current step, and those that have not completed
+  std::vector<std::shared_ptr<ndn::SegmentFetcher>> m_fetchers;
+  size_t m_nPendingFetches = 0;
+  ndn::scheduler::ScopedEventId m_fetchDeadline;
+
   int m_exitCode = 0;
 };
 
@@ -4,6 +4,8 @@ import sys
 import os
 from pathlib import Path
 import re
+import socket
+import threading
 import time
 from flask import Flask, render_template, send_from_directory, abort, jsonify
 
@@ -11,13 +13,16 @@ from flask import Flask, render_template, send_from_directory, abort, jsonify
 DEFAULT_CONF_FILE = "/usr/local/etc/ndn/nlsr.conf"
 DEFAULT_STATE_DIR = "/var/lib/nlsr"
 TOPOLOGY_FILE_NAME = "topology.json"
+TOPOLOGY_LOG_NAME = "topology.log"
 POLL_TIMEOUT_SEC = 30  # 长轮询超时时间
 POLL_INTERVAL_SEC = 0.5 # 检查文件变化的间隔
+EVENT_RECONNECT_SEC = 5 # 事件流断开后重连的间隔
+# 可能改变拓扑的事件类型 (见 nlsr.conf 中的 event-stream-socket)
+TOPOLOGY_EVENT_TYPES = {'adjacency', 'link-cost', 'lsa', 'routing'}
 
 # 全局变量
 topology_json_path = None
-# 用于存储 topology.json 的最后修改时间
-g_last_mod_time = 0.0 
+g_events = None
 
 # --- Flask Web 应用 ---
 app = Flask(__name__,
@@ -49,11 +54,58 @@ def find_state_dir(conf_file_path):
     print(f"Info: 未在配置文件中找到 'state-dir'，使用默认值: {DEFAULT_STATE_DIR}", file=sys.stderr)
     return DEFAULT_STATE_DIR
 
+def find_event_socket(conf_file_path):
+    """
+    在 nlsr.conf 中查找 event-stream-socket，未配置时返回 None。
+    """
+    try:
+        with open(conf_file_path, 'r') as f:
+            for line in f:
+                line = line.split(';', 1)[0].strip()
+                match = re.match(r'^event-stream-socket\s+(\S+)', line)
+                if match:
+                    return match.group(1)
+    except OSError:
+        pass
+    return None
+
+class EventListener(threading.Thread):
+    """
+    读取NLSR的事件流 (每行一个JSON事件)，在拓扑可能改变时唤醒等待的长轮询。
+    """
+
+    def __init__(self, path):
+        super().__init__(daemon=True)
+        self.path = path
+        self.condition = threading.Condition()
+        self.last_seq = 0
+
+    def run(self):
+        while True:
+            try:
+                with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as sock:
+                    sock.connect(self.path)
+                    print(f"Info: 已连接事件流 {self.path}", file=sys.stderr)
+                    for line in sock.makefile('r'):
+                        event = json.loads(line)
+                        if event['type'] in TOPOLOGY_EVENT_TYPES:
+                            with self.condition:
+                                self.last_seq = event['seq']
+                                self.condition.notify_all()
+                print(f"Warning: 事件流已断开 (NLSR重启或客户端过慢)", file=sys.stderr)
+            except (OSError, ValueError) as e:
+                print(f"Warning: 无法读取事件流 {self.path}: {e}", file=sys.stderr)
+            time.sleep(EVENT_RECONNECT_SEC)
+
+    def wait(self, timeout):
+        with self.condition:
+            self.condition.wait(timeout)
+
 def initialize_paths():
     """
     在服务器启动时初始化所有文件路径。
     """
-    global topology_json_path, g_last_mod_time
+    global topology_json_path
     
     # 1. 查找 nlsr.conf
     conf_locations = [DEFAULT_CONF_FILE, './nlsr.conf']
@@ -70,15 +122,19 @@ def initialize_paths():
     
     # 2. 查找 state-dir
     state_dir = find_state_dir(conf_path)
+
+    # 事件流可用时，拓扑一变化就检查文件，而不必等待下一次轮询
+    global g_events
+    event_socket = find_event_socket(conf_path)
+    if event_socket:
+        g_events = EventListener(event_socket)
+        g_events.start()
     
     # 3. 确定 topology.json 的最终路径
     topology_json_path = Path(state_dir) / TOPOLOGY_FILE_NAME
     
-    # 4. 初始化文件修改时间
-    try:
-        g_last_mod_time = os.path.getmtime(topology_json_path)
-    except FileNotFoundError:
-        g_last_mod_time = 0.0
+    # 4. 检查文件是否存在
+    if not topology_json_path.exists():
         print(f"Warning: 拓扑文件尚未找到。", file=sys.stderr)
         print(f"         (路径: {topology_json_path})", file=sys.stderr)
         print(f"Info:    请确保NLSR (nlsr.service) 正在运行。脚本将等待文件创建...", file=sys.stderr)
@@ -94,50 +150,131 @@ def index():
     print("Info: 浏览器已连接，正在提供 index.html", file=sys.stderr)
     return render_template('index.html')
 
+class TopologyState:
+    """
+    由 topology.json (快照) 和 topology.log (增量日志) 重建的拓扑。
+
+    快照只在变化较多时才被NLSR重写；平时只需读取日志新增的行。
+    """
+
+    def __init__(self):
+        self.version = 0
+        self.snapshot_version = 0
+        self.routers = set()
+        self.links = {}  # (router, router) -> cost
+        self.snapshot_mtime = None
+        self.log_offset = 0
+
+    def load_snapshot(self):
+        with open(topology_json_path, 'r') as f:
+            data = json.load(f)
+        names = {node['id']: node['name'] for node in data['nodes']}
+        self.version = data.get('version', 0)
+        self.snapshot_version = self.version
+        self.routers = set(names.values())
+        self.links = {}
+        for link in data['links']:
+            a, b = sorted((names[link['source']], names[link['target']]))
+            self.links[(a, b)] = link['cost']
+        self.log_offset = 0
+
+    def apply_log(self, log_path):
+        """
+        应用日志中比当前版本新的行，返回是否有变化。
+        """
+        try:
+            size = os.path.getsize(log_path)
+        except FileNotFoundError:
+            return False
+        if size < self.log_offset:
+            # 日志被截断 (NLSR写了新快照)
+            self.log_offset = 0
+        if size == self.log_offset:
+            return False
+
+        changed = False
+        with open(log_path, 'r') as f:
+            f.seek(self.log_offset)
+            for line in f:
+                if not line.endswith('\n'):
+                    break  # 不完整的行，下次再读
+                self.log_offset += len(line.encode())
+                fields = line.split()
+                version, change = int(fields[0]), fields[1]
+                if version <= self.snapshot_version:
+                    continue  # 已包含在快照中
+                self.version = version
+                if change == 'router-add':
+                    self.routers.add(fields[2])
+                elif change == 'router-remove':
+                    self.routers.discard(fields[2])
+                elif change in ('link-add', 'link-cost'):
+                    self.links[(fields[2], fields[3])] = float(fields[4])
+                elif change == 'link-remove':
+                    self.links.pop((fields[2], fields[3]), None)
+                changed = True
+        return changed
+
+    def update(self):
+        """
+        读取文件变化，返回拓扑是否改变。
+        """
+        mtime = os.path.getmtime(topology_json_path)
+        changed = False
+        if mtime != self.snapshot_mtime:
+            self.snapshot_mtime = mtime
+            self.load_snapshot()
+            changed = True
+        log_path = topology_json_path.with_name(TOPOLOGY_LOG_NAME)
+        return self.apply_log(log_path) or changed
+
+    def to_json(self):
+        ids = {name: i for i, name in enumerate(sorted(self.routers))}
+        return {
+            "version": self.version,
+            "nodes": [{"id": i, "name": name} for name, i in ids.items()],
+            "links": [{"source": ids[a], "target": ids[b], "cost": cost}
+                      for (a, b), cost in sorted(self.links.items())
+                      if a in ids and b in ids],
+        }
+
+g_topology = TopologyState()
+
 @app.route('/api/topology')
 def get_topology_long_poll():
     """
     路由 2: 'http://127.0.0.1:8080/api/topology' (长轮询)
-    监视 topology.json 文件的变化。
+    监视 topology.json 及 topology.log 的变化。
     """
-    global g_last_mod_time
-    
+    global g_topology
+
     start_time = time.time()
-    
+
     while time.time() - start_time < POLL_TIMEOUT_SEC:
         try:
-            # 检查文件的当前修改时间
-            current_mod_time = os.path.getmtime(topology_json_path)
-            
-            # (关键逻辑) 如果文件时间戳已更新 (C++端已重写文件)
-            if current_mod_time > g_last_mod_time:
-                g_last_mod_time = current_mod_time
-                
-                # 读取并返回新数据
-                with open(topology_json_path, 'r') as f:
-                    data = f.read()
-                
-                print(f"Info: 检测到文件更新，正在向浏览器发送新拓扑。", file=sys.stderr)
-                return app.response_class(
-                    response=data,
-                    status=200, # 200 OK
-                    mimetype='application/json'
-                )
-        
+            # (关键逻辑) 快照被重写，或日志有新增的行
+            if g_topology.update():
+                print(f"Info: 检测到拓扑更新 (版本 {g_topology.version})，正在向浏览器发送新拓扑。", file=sys.stderr)
+                return jsonify(g_topology.to_json())
+
         except FileNotFoundError:
             # 如果文件被删除了（例如NLSR重启了），也算是一种“变化”
-            if g_last_mod_time != 0.0:
+            if g_topology.snapshot_mtime is not None:
                 print(f"Info: 检测到文件被删除，发送空拓扑。", file=sys.stderr)
-                g_last_mod_time = 0.0
+                g_topology = TopologyState()
                 return jsonify({"nodes": [], "links": []}) # 返回空拓扑
-        
+
         except Exception as e:
             print(f"Error: /api/topology: 检查文件时出错: {e}", file=sys.stderr)
             return abort(500)
-            
-        # 暂停 0.5 秒再检查
-        time.sleep(POLL_INTERVAL_SEC)
-    
+
+        # 等待下一个拓扑事件，或暂停 0.5 秒再检查
+        # (拓扑文件可能在事件之后才写入，所以仍按间隔检查)
+        if g_events is not None:
+            g_events.wait(POLL_INTERVAL_SEC)
+        else:
+            time.sleep(POLL_INTERVAL_SEC)
+
     # (超时) 在 POLL_TIMEOUT_SEC 秒内文件没有变化
     print(f"Info: 文件未变化，长轮询超时。", file=sys.stderr)
     return app.response_class(status=304) # 304 Not Modified